@@ -10,7 +10,7 @@
 typedef unsigned __int64 QWORD;
 #endif
 
-#include "../libAudio/WMA_HuffTables.h"
+#include "WMA_HuffTables.h"
 
 typedef struct FileInfo
 {
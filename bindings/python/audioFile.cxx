@@ -1,6 +1,9 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2020-2023 Rachel Mant <git@dragonmux.network>
+#include <chrono>
 #include <exception>
+#include <algorithm>
+#include <limits>
 #include <substrate/utility>
 #include <libAudio.h>
 #include "audioFile.hxx"
@@ -20,6 +23,19 @@ constexpr static auto playbackVolumeKeywords{substrate::make_array<const char *>
 	"level", static_cast<const char *>(nullptr)
 })};
 
+constexpr static auto readKeywords{substrate::make_array<const char *>(
+{
+	"frames", static_cast<const char *>(nullptr)
+})};
+
+constexpr static auto readintoKeywords{substrate::make_array<const char *>(
+{
+	"buffer", static_cast<const char *>(nullptr)
+})};
+
+// How much read() grows its result by at a time when asked to decode the rest of the file
+constexpr static Py_ssize_t readAllFrames{65536};
+
 pyAudioFile_t::pyAudioFile_t(const char *const fileName) : PyObject{},
 	audioFile{static_cast<audioFile_t*>(audioOpenR(fileName))}, playbackFinished{} { }
 
@@ -49,7 +65,7 @@ PyObject *pyAudioFile_t::play(PyObject *args, PyObject *kwargs) noexcept
 		PyErr_SetString(PyExc_ValueError, "AudioFile in invalid state - audioFile is null");
 		return nullptr;
 	}
-	else if (playbackFinished.valid())
+	else if (playing())
 	{
 		PyErr_SetString(PyExc_ValueError, "AudioFile already playing");
 		return nullptr;
@@ -142,3 +158,312 @@ PyObject *pyAudioFile_t::playbackVolume(PyObject *args, PyObject *kwargs) noexce
 	audioFile->playbackVolume(level);
 	return Py_None;
 }
+
+// Checks whether playback is still in progress, reaping it if it has run to completion
+bool pyAudioFile_t::playing() noexcept
+{
+	if (!playbackFinished.valid())
+		return false;
+	if (playbackFinished.wait_for(std::chrono::seconds{0}) != std::future_status::ready)
+		return true;
+	playbackFinished.get();
+	return false;
+}
+
+bool pyAudioFile_t::canDecode() noexcept
+{
+	if (!audioFile)
+	{
+		PyErr_SetString(PyExc_ValueError, "AudioFile in invalid state - audioFile is null");
+		return false;
+	}
+	else if (playing())
+	{
+		PyErr_SetString(PyExc_ValueError, "AudioFile is being played back and cannot also be read from");
+		return false;
+	}
+	return true;
+}
+
+size_t pyAudioFile_t::frameBytes() const noexcept
+{
+	const auto &info{audioFile->fileInfo()};
+	return size_t{info.bytesPerSample()} * info.channels();
+}
+
+// Decodes until either the buffer is full or the file ends, returning how many bytes were decoded or -1 on error
+int64_t pyAudioFile_t::decode(void *const buffer, const size_t length) noexcept
+{
+	auto *const data{static_cast<uint8_t *>(buffer)};
+	int64_t offset{0};
+	// Decoding touches no Python objects, so let other threads run while it happens
+	auto *const threadState{PyEval_SaveThread()};
+	{
+		std::lock_guard<std::mutex> lock{decodeMutex};
+		// A finished playback can leave its decoder thread running ahead, which must not race the reads here
+		audioFile->flushPlayback();
+		while (static_cast<size_t>(offset) < length)
+		{
+			const auto count{static_cast<uint32_t>(std::min<size_t>(length - static_cast<size_t>(offset),
+				std::numeric_limits<uint32_t>::max()))};
+			const auto result{audioFile->fillBuffer(data + offset, count)};
+			// -1 indicates a decoding error, while 0 and -2 both indicate the end of the file
+			if (result == -1)
+			{
+				offset = -1;
+				break;
+			}
+			if (result <= 0)
+				break;
+			offset += result;
+		}
+	}
+	PyEval_RestoreThread(threadState);
+	if (offset == -1)
+		PyErr_SetString(PyExc_IOError, "Error while decoding audio");
+	return offset;
+}
+
+PyObject *pyAudioFile_t::read(PyObject *args, PyObject *kwargs) noexcept
+{
+	Py_ssize_t frames{-1};
+	if (!canDecode() ||
+		!PyArg_ParseTupleAndKeywords(args, kwargs, "|n:read", const_cast<char **>(readKeywords.data()), &frames))
+		return nullptr;
+	const auto frameLength{static_cast<Py_ssize_t>(frameBytes())};
+	if (!frameLength)
+	{
+		PyErr_SetString(PyExc_ValueError, "AudioFile has no sample format information");
+		return nullptr;
+	}
+	// With no frame count given, decode the rest of the file, growing the result as we go
+	const bool readAll{frames < 0};
+	if (readAll)
+		frames = readAllFrames;
+	if (frames > PY_SSIZE_T_MAX / frameLength)
+		return PyErr_NoMemory();
+	auto length{frames * frameLength};
+	// Decode straight into the storage of the bytes object we return, so the samples are never copied
+	PyObject *result{PyBytes_FromStringAndSize(nullptr, length)};
+	if (!result)
+		return nullptr;
+	Py_ssize_t offset{0};
+	while (true)
+	{
+		const auto count{decode(PyBytes_AS_STRING(result) + offset, static_cast<size_t>(length - offset))};
+		if (count == -1)
+		{
+			Py_DECREF(result);
+			return nullptr;
+		}
+		offset += static_cast<Py_ssize_t>(count);
+		if (!readAll || offset < length)
+			break;
+		if (length > PY_SSIZE_T_MAX - (readAllFrames * frameLength))
+		{
+			Py_DECREF(result);
+			return PyErr_NoMemory();
+		}
+		length += readAllFrames * frameLength;
+		// On failure this releases the object and sets result to null
+		if (_PyBytes_Resize(&result, length))
+			return nullptr;
+	}
+	if (offset != length && _PyBytes_Resize(&result, offset))
+		return nullptr;
+	return result;
+}
+
+// Checks a buffer's struct module style format describes the samples being decoded, or plain bytes
+static bool formatMatches(const char *format, const size_t itemSize, const fileInfo_t &info) noexcept
+{
+	// No format at all means unsigned bytes
+	if (!format)
+		return itemSize == 1U;
+	// A byte order is fine so long as it's the native one
+	if (*format == '@' || *format == '=' || *format == (PY_LITTLE_ENDIAN ? '<' : '>'))
+		++format;
+	if (!format[0] || format[1])
+		return false;
+	const char type{format[0]};
+	if (type == 'B' || type == 'c')
+		return itemSize == 1U;
+	if (itemSize != info.bytesPerSample())
+		return false;
+	switch (info.sampleFormat())
+	{
+		case sampleFormat_t::int8:
+			return type == 'b';
+		case sampleFormat_t::int16:
+			return type == 'h';
+		// 24-bit samples come sign extended in 32-bit containers
+		case sampleFormat_t::int24:
+		case sampleFormat_t::int32:
+			return type == 'i' || type == 'l';
+		case sampleFormat_t::float32:
+			return type == 'f';
+	}
+	return false;
+}
+
+PyObject *pyAudioFile_t::readinto(PyObject *args, PyObject *kwargs) noexcept
+{
+	PyObject *target{nullptr};
+	if (!canDecode() ||
+		!PyArg_ParseTupleAndKeywords(args, kwargs, "O:readinto", const_cast<char **>(readintoKeywords.data()),
+			&target))
+		return nullptr;
+	Py_buffer buffer{};
+	if (PyObject_GetBuffer(target, &buffer, PyBUF_WRITABLE | PyBUF_FORMAT | PyBUF_C_CONTIGUOUS))
+		return nullptr;
+	const auto frameLength{frameBytes()};
+	// Typed buffers (such as NumPy arrays) must hold the same type of samples as are being decoded
+	if (!frameLength || !formatMatches(buffer.format, static_cast<size_t>(buffer.itemsize), audioFile->fileInfo()))
+	{
+		PyBuffer_Release(&buffer);
+		PyErr_SetString(PyExc_TypeError, "buffer format does not match the AudioFile's sample format");
+		return nullptr;
+	}
+	// Only decode whole frames into the buffer
+	const auto length{static_cast<size_t>(buffer.len) - (static_cast<size_t>(buffer.len) % frameLength)};
+	const auto count{decode(buffer.buf, length)};
+	PyBuffer_Release(&buffer);
+	if (count == -1)
+		return nullptr;
+	return PyLong_FromSize_t(static_cast<size_t>(count) / frameLength);
+}
+
+// Reads the next block for an iterator made by blocks(), whose state is an (AudioFile, frames) tuple
+static PyObject *readBlock(PyObject *state, PyObject *) noexcept
+{
+	PyObject *const args{PyTuple_GetSlice(state, 1, 2)};
+	if (!args)
+		return nullptr;
+	PyObject *const result{pyAudioFile_t::read(PyTuple_GET_ITEM(state, 0), args, nullptr)};
+	Py_DECREF(args);
+	return result;
+}
+
+static PyMethodDef readBlockMethod{"readBlock", readBlock, METH_NOARGS, ""};
+
+PyObject *pyAudioFile_t::blocks(PyObject *args, PyObject *kwargs) noexcept
+{
+	Py_ssize_t frames{0};
+	if (!canDecode() ||
+		!PyArg_ParseTupleAndKeywords(args, kwargs, "n:blocks", const_cast<char **>(readKeywords.data()), &frames))
+		return nullptr;
+	if (frames <= 0)
+	{
+		PyErr_SetString(PyExc_ValueError, "Block size must be a positive number of frames");
+		return nullptr;
+	}
+	// Build an iterator that calls read(frames) until it gets back an empty block at the end of the file
+	PyObject *const state{Py_BuildValue("(On)", static_cast<PyObject *>(this), frames)};
+	if (!state)
+		return nullptr;
+	PyObject *const reader{PyCFunction_New(&readBlockMethod, state)};
+	Py_DECREF(state);
+	if (!reader)
+		return nullptr;
+	PyObject *const sentinel{PyBytes_FromStringAndSize(nullptr, 0)};
+	if (!sentinel)
+	{
+		Py_DECREF(reader);
+		return nullptr;
+	}
+	PyObject *const iterator{PyCallIter_New(reader, sentinel)};
+	Py_DECREF(reader);
+	Py_DECREF(sentinel);
+	return iterator;
+}
+
+static PyObject *stringOrNone(const char *const value) noexcept
+{
+	if (!value)
+		Py_RETURN_NONE;
+	return PyUnicode_FromString(value);
+}
+
+PyObject *pyAudioFile_t::fileInfo(const fileInfoField_t field) const noexcept
+{
+	if (!audioFile)
+	{
+		PyErr_SetString(PyExc_ValueError, "AudioFile in invalid state - audioFile is null");
+		return nullptr;
+	}
+	const auto &info{audioFile->fileInfo()};
+	switch (field)
+	{
+		case fileInfoField_t::totalTime:
+			return PyLong_FromUnsignedLongLong(info.totalTime());
+		case fileInfoField_t::bitRate:
+			return PyLong_FromUnsignedLong(info.bitRate());
+		case fileInfoField_t::bitsPerSample:
+			return PyLong_FromUnsignedLong(info.bitsPerSample());
+		case fileInfoField_t::channels:
+			return PyLong_FromUnsignedLong(info.channels());
+		case fileInfoField_t::sampleFormat:
+			return PyLong_FromUnsignedLong(static_cast<uint8_t>(info.sampleFormat()));
+		case fileInfoField_t::title:
+			return stringOrNone(info.title());
+		case fileInfoField_t::artist:
+			return stringOrNone(info.artist());
+		case fileInfoField_t::album:
+			return stringOrNone(info.album());
+		case fileInfoField_t::otherComments:
+		{
+			PyObject *const result{PyTuple_New(static_cast<Py_ssize_t>(info.otherCommentsCount()))};
+			if (!result)
+				return nullptr;
+			for (size_t index{0}; index < info.otherCommentsCount(); ++index)
+			{
+				PyObject *const comment{PyUnicode_FromString(info.otherComment(index))};
+				if (!comment)
+				{
+					Py_DECREF(result);
+					return nullptr;
+				}
+				PyTuple_SET_ITEM(result, static_cast<Py_ssize_t>(index), comment);
+			}
+			return result;
+		}
+	}
+	PyErr_SetString(PyExc_AttributeError, "Unknown fileInfo field");
+	return nullptr;
+}
+
+int pyAudioFile_t::sampleFormat(PyObject *const value) noexcept
+{
+	if (!audioFile)
+	{
+		PyErr_SetString(PyExc_ValueError, "AudioFile in invalid state - audioFile is null");
+		return -1;
+	}
+	else if (!value)
+	{
+		PyErr_SetString(PyExc_AttributeError, "sampleFormat cannot be deleted");
+		return -1;
+	}
+	const auto format{PyLong_AsLong(value)};
+	if (format == -1 && PyErr_Occurred())
+		return -1;
+	if (format < AUDIO_SAMPLE_INT8 || format > AUDIO_SAMPLE_FLOAT32)
+	{
+		PyErr_SetString(PyExc_ValueError, "Invalid sample format");
+		return -1;
+	}
+	// The decoder can't change format under a read in progress on another thread
+	auto *const threadState{PyEval_SaveThread()};
+	bool result{};
+	{
+		std::lock_guard<std::mutex> lock{decodeMutex};
+		result = audioFile->outputFormat(static_cast<sampleFormat_t>(format));
+	}
+	PyEval_RestoreThread(threadState);
+	if (!result)
+	{
+		PyErr_SetString(PyExc_ValueError, "Sample format not supported for this AudioFile");
+		return -1;
+	}
+	return 0;
+}
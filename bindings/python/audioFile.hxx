@@ -4,26 +4,52 @@
 #define AUDIO_FILE__HXX
 
 #include <future>
+#include <mutex>
 #include <libAudio.hxx>
 #include "interface.hxx"
 
+// The fileInfo_t fields exposed as attributes of an AudioFile
+enum class fileInfoField_t : uintptr_t
+{
+	totalTime,
+	bitRate,
+	bitsPerSample,
+	channels,
+	sampleFormat,
+	title,
+	artist,
+	album,
+	otherComments,
+};
+
 struct pyAudioFile_t final : public PyObject
 {
 private:
 	std::unique_ptr<audioFile_t> audioFile;
 	std::future<bool> playbackFinished;
+	// Serialises decoding, which runs with the GIL released
+	std::mutex decodeMutex;
 
 	static pyAudioFile_t *atAddress(void *self, PyObject *args, PyObject *kwargs);
 	PyObject *repr() const noexcept;
+	[[nodiscard]] bool playing() noexcept;
+	[[nodiscard]] bool canDecode() noexcept;
+	[[nodiscard]] size_t frameBytes() const noexcept;
+	[[nodiscard]] int64_t decode(void *buffer, size_t length) noexcept;
 
 	PyObject *play(PyObject *args, PyObject *kwargs) noexcept;
 	PyObject *pause(PyObject *args) noexcept;
 	PyObject *stop(PyObject *args) noexcept;
 	PyObject *mode(PyObject *args, PyObject *kwargs) noexcept;
 	PyObject *playbackVolume(PyObject *args, PyObject *kwargs) noexcept;
+	PyObject *read(PyObject *args, PyObject *kwargs) noexcept;
+	PyObject *readinto(PyObject *args, PyObject *kwargs) noexcept;
+	PyObject *blocks(PyObject *args, PyObject *kwargs) noexcept;
+	PyObject *fileInfo(fileInfoField_t field) const noexcept;
+	int sampleFormat(PyObject *value) noexcept;
 
 public:
-	pyAudioFile_t() noexcept : PyObject{}, audioFile{}, playbackFinished{} { }
+	pyAudioFile_t() noexcept : PyObject{}, audioFile{}, playbackFinished{}, decodeMutex{} { }
 	pyAudioFile_t(const char *const fileName);
 	~pyAudioFile_t() noexcept;
 
@@ -42,6 +68,19 @@ public:
 		{ return static_cast<pyAudioFile_t *>(self)->mode(args, kwargs); }
 	static PyObject *playbackVolume(PyObject *self, PyObject *args, PyObject *kwargs) noexcept
 		{ return static_cast<pyAudioFile_t *>(self)->playbackVolume(args, kwargs); }
+	static PyObject *read(PyObject *self, PyObject *args, PyObject *kwargs) noexcept
+		{ return static_cast<pyAudioFile_t *>(self)->read(args, kwargs); }
+	static PyObject *readinto(PyObject *self, PyObject *args, PyObject *kwargs) noexcept
+		{ return static_cast<pyAudioFile_t *>(self)->readinto(args, kwargs); }
+	static PyObject *blocks(PyObject *self, PyObject *args, PyObject *kwargs) noexcept
+		{ return static_cast<pyAudioFile_t *>(self)->blocks(args, kwargs); }
+	static PyObject *fileInfo(PyObject *self, void *field) noexcept
+	{
+		return static_cast<pyAudioFile_t *>(self)->fileInfo(
+			static_cast<fileInfoField_t>(reinterpret_cast<uintptr_t>(field)));
+	}
+	static int sampleFormat(PyObject *self, PyObject *value, void *) noexcept
+		{ return static_cast<pyAudioFile_t *>(self)->sampleFormat(value); }
 
 	operator const audioFile_t *() const noexcept { return audioFile.get(); }
 };
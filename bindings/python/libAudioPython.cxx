@@ -132,6 +132,9 @@ void cppTypeDealloc(PyObject *self) noexcept
 const static PyCFunctionWithKeywords pyAudioFilePlay = pyAudioFile_t::play;
 // const static PyCFunctionWithKeywords pyAudioFileMode = pyAudioFile_t::mode;
 const static PyCFunctionWithKeywords pyAudioFilePlaybackVolume = pyAudioFile_t::playbackVolume;
+const static PyCFunctionWithKeywords pyAudioFileRead = pyAudioFile_t::read;
+const static PyCFunctionWithKeywords pyAudioFileReadinto = pyAudioFile_t::readinto;
+const static PyCFunctionWithKeywords pyAudioFileBlocks = pyAudioFile_t::blocks;
 static auto pyAudioFileFuncs{substrate::make_array<PyMethodDef>(
 {
 	{"play", asFuncType<PyCFunction>(pyAudioFilePlay), METH_VARARGS | METH_KEYWORDS, ""},
@@ -139,9 +142,37 @@ static auto pyAudioFileFuncs{substrate::make_array<PyMethodDef>(
 	{"stop", pyAudioFile_t::stop, METH_VARARGS, ""},
 	//{"mode", asFuncType<PyCFunction>(ppyAudioFileMode), METH_VARARGS, ""},
 	{"playbackVolume", asFuncType<PyCFunction>(pyAudioFilePlaybackVolume), METH_VARARGS | METH_KEYWORDS, ""},
+	{"read", asFuncType<PyCFunction>(pyAudioFileRead), METH_VARARGS | METH_KEYWORDS,
+		"read(frames=-1) -> bytes\n\nDecodes up to frames sample frames (or the rest of the file if negative) "
+		"into a new bytes object, which is empty at the end of the file"},
+	{"readinto", asFuncType<PyCFunction>(pyAudioFileReadinto), METH_VARARGS | METH_KEYWORDS,
+		"readinto(buffer) -> int\n\nDecodes as many whole sample frames as fit straight into the writable "
+		"buffer given, such as a NumPy array, returning how many frames were decoded. The buffer must either "
+		"be plain bytes or have items of the same type as the AudioFile's sample format"},
+	{"blocks", asFuncType<PyCFunction>(pyAudioFileBlocks), METH_VARARGS | METH_KEYWORDS,
+		"blocks(frames) -> iterator\n\nIterates over the rest of the file frames sample frames at a time, "
+		"as bytes objects, the last of which may be short"},
 	{nullptr, nullptr, 0, nullptr} // Sentinel
 })};
 
+static PyGetSetDef fileInfoAttribute(const char *const name, const fileInfoField_t field,
+	const setter set = nullptr) noexcept
+	{ return {name, pyAudioFile_t::fileInfo, set, nullptr, reinterpret_cast<void *>(static_cast<uintptr_t>(field))}; }
+
+static auto pyAudioFileAttributes{substrate::make_array<PyGetSetDef>(
+{
+	fileInfoAttribute("totalTime", fileInfoField_t::totalTime),
+	fileInfoAttribute("bitRate", fileInfoField_t::bitRate),
+	fileInfoAttribute("bitsPerSample", fileInfoField_t::bitsPerSample),
+	fileInfoAttribute("channels", fileInfoField_t::channels),
+	fileInfoAttribute("sampleFormat", fileInfoField_t::sampleFormat, pyAudioFile_t::sampleFormat),
+	fileInfoAttribute("title", fileInfoField_t::title),
+	fileInfoAttribute("artist", fileInfoField_t::artist),
+	fileInfoAttribute("album", fileInfoField_t::album),
+	fileInfoAttribute("otherComments", fileInfoField_t::otherComments),
+	{nullptr, nullptr, nullptr, nullptr, nullptr} // Sentinel
+})};
+
 PyObject *pyAudioFileNew(PyTypeObject *subtype, PyObject *args, PyObject *kwargs) noexcept try
 {
 	std::unique_ptr<PyObject, cppObjDelete_t> self(subtype->tp_alloc(subtype, 0));
@@ -199,7 +230,7 @@ static PyTypeObject pyAudioFileType
 	nullptr, /*tp_iternext*/
 	pyAudioFileFuncs.data(), /*tp_methods*/
 	nullptr, /* tp_members */
-	nullptr, /*tp_getset*/
+	pyAudioFileAttributes.data(), /*tp_getset*/
 	nullptr, /*tp_base*/
 	nullptr, /*tp_dict*/
 	nullptr, /*tp_descr_get*/
@@ -245,7 +276,13 @@ EXPORT PyObject *PyInit_libAudio();
 PyObject *PyInit_libAudio()
 {
 	PyObject *const module = PyModule_Create(&libAudioPython);
-	if (!registerType(module, pyAudioFileType, "AudioFile"))
+	if (!registerType(module, pyAudioFileType, "AudioFile") ||
+		// The values AudioFile.sampleFormat can take
+		PyModule_AddIntConstant(module, "SAMPLE_INT8", AUDIO_SAMPLE_INT8) ||
+		PyModule_AddIntConstant(module, "SAMPLE_INT16", AUDIO_SAMPLE_INT16) ||
+		PyModule_AddIntConstant(module, "SAMPLE_INT24", AUDIO_SAMPLE_INT24) ||
+		PyModule_AddIntConstant(module, "SAMPLE_INT32", AUDIO_SAMPLE_INT32) ||
+		PyModule_AddIntConstant(module, "SAMPLE_FLOAT32", AUDIO_SAMPLE_FLOAT32))
 		return nullptr;
 	return module;
 }
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <array>
+#include <algorithm>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+
+#include <libAudio.h>
+#include "../libAudio/libAudio.hxx"
+#include "../libAudio/console.hxx"
+
+/*
+ * Renders a module once per thread count from 1 to N using the multi-threaded mixer,
+ * reporting how long each render took and checking that every render is bit-identical
+ * to the serial (1 thread) result.
+ *
+ * Usage: mixerBench module.it [maxThreads]
+ */
+
+using audioFilePtr_t = std::unique_ptr<audioFile_t, int (*)(void *)>;
+
+static std::vector<uint8_t> render(const char *const fileName, const uint32_t threads, double &seconds)
+{
+	audioFilePtr_t file{static_cast<audioFile_t *>(audioOpenR(fileName)), audioCloseFile};
+	if (!file)
+		return {};
+	const auto type{file->type()};
+	if (type != audioType_t::moduleIT && type != audioType_t::moduleMOD && type != audioType_t::moduleS3M &&
+		type != audioType_t::moduleSTM)
+		return {};
+	auto &module{static_cast<moduleFile_t &>(*file)};
+	if (!module.mixerThreads(threads))
+		return {};
+
+	std::vector<uint8_t> result{};
+	std::array<uint8_t, 8192> buffer{};
+	const auto start{std::chrono::steady_clock::now()};
+	int64_t count{};
+	while ((count = audioFillBuffer(file.get(), buffer.data(), buffer.size())) > 0)
+		result.insert(result.end(), buffer.begin(), buffer.begin() + count);
+	const auto end{std::chrono::steady_clock::now()};
+	seconds = std::chrono::duration<double>{end - start}.count();
+	return result;
+}
+
+int main(int32_t argc, char **argv)
+{
+	if (argc < 2)
+	{
+		fprintf(stderr, "Usage: %s module.it [maxThreads]\n", argv[0]);
+		return 1;
+	}
+	console = {stdout, stderr};
+	const uint32_t maxThreads
+	{
+		argc > 2 ? static_cast<uint32_t>(std::strtoul(argv[2], nullptr, 10)) :
+			std::max(std::thread::hardware_concurrency(), 1U)
+	};
+
+	double serialTime{};
+	const auto reference{render(argv[1], 1U, serialTime)};
+	if (reference.empty())
+	{
+		fprintf(stderr, "Could not render %s as a module\n", argv[1]);
+		return 1;
+	}
+	printf("threads  time (s)  speedup  identical\n");
+	printf("%7u  %8.3f  %7.2f  %9s\n", 1U, serialTime, 1.0, "yes");
+
+	bool identical{true};
+	for (uint32_t threads{2U}; threads <= maxThreads; ++threads)
+	{
+		double time{};
+		const auto result{render(argv[1], threads, time)};
+		const bool matches{result == reference};
+		identical &= matches;
+		printf("%7u  %8.3f  %7.2f  %9s\n", threads, time, serialTime / time, matches ? "yes" : "NO");
+	}
+	return identical ? 0 : 2;
+}
@@ -0,0 +1,67 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include "cpuFeatures.hxx"
+
+#if defined(_MSC_VER) && defined(CPU_FEATURES_X86)
+#include <array>
+#include <intrin.h>
+#include <immintrin.h>
+#endif
+
+/*!
+ * @internal
+ * @file cpuFeatures.cxx
+ * @brief The runtime CPU feature detection shared by all the vectorised kernels
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+#ifdef CPU_FEATURES_X86
+namespace
+{
+#ifdef _MSC_VER
+	bool cpuHasSSE2() noexcept
+	{
+		std::array<int, 4> registers{};
+		__cpuid(registers.data(), 1);
+		return registers[3] & (1 << 26);
+	}
+
+	bool cpuHasAVX2() noexcept
+	{
+		std::array<int, 4> registers{};
+		__cpuid(registers.data(), 0);
+		if (registers[0] < 7)
+			return false;
+		__cpuid(registers.data(), 1);
+		// Check the OS saves the AVX register state across context switches (OSXSAVE + AVX)
+		constexpr int osxsaveAVX{(1 << 27) | (1 << 28)};
+		if ((registers[2] & osxsaveAVX) != osxsaveAVX || (_xgetbv(0) & 0x6U) != 0x6U)
+			return false;
+		__cpuidex(registers.data(), 7, 0);
+		return registers[1] & (1 << 5);
+	}
+#else
+	bool cpuHasSSE2() noexcept { return __builtin_cpu_supports("sse2"); }
+	// This also checks the OS has enabled the AVX register state for us
+	bool cpuHasAVX2() noexcept { return __builtin_cpu_supports("avx2"); }
+#endif
+} // namespace
+#endif
+
+/*!
+ * @internal
+ * Determines the best vector instruction set this machine supports out of those the kernels are built for
+ */
+cpuISA_t cpuISA() noexcept
+{
+#if defined(CPU_FEATURES_X86)
+	if (cpuHasAVX2())
+		return cpuISA_t::avx2;
+	if (cpuHasSSE2())
+		return cpuISA_t::sse2;
+#elif defined(CPU_FEATURES_NEON)
+	return cpuISA_t::neon;
+#endif
+	return cpuISA_t::scalar;
+}
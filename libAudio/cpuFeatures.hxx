@@ -0,0 +1,29 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef CPU_FEATURES_HXX
+#define CPU_FEATURES_HXX
+
+#include <cstdint>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define CPU_FEATURES_X86 1
+#elif defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#define CPU_FEATURES_NEON 1
+#endif
+
+/*!
+ * @internal
+ * The vector instruction sets the vectorised kernels (mixing, WMA DSP and spectrum FFT) are built for,
+ * in the order of preference for each architecture
+ */
+enum class cpuISA_t : uint8_t
+{
+	scalar,
+	sse2,
+	avx2,
+	neon
+};
+
+[[nodiscard]] cpuISA_t cpuISA() noexcept;
+
+#endif /*CPU_FEATURES_HXX*/
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
 #include <string_view>
 #include <type_traits>
 #include <substrate/index_sequence>
@@ -16,8 +17,6 @@
 using namespace std::literals::string_view_literals;
 using namespace libAudio::console;
 
-using stRAM_t = ram_t<uint32_t, 8_MiB>;
-
 template<typename T> struct isUniquePtr : std::false_type { };
 template<typename T> struct isUniquePtr<std::unique_ptr<T>> : std::true_type { };
 template<typename T> constexpr inline bool isUniquePtr_v = isUniquePtr<T>::value;
@@ -52,7 +51,7 @@ constexpr static uint32_t stackTop{stackBase + stackSize};
 constexpr static uint32_t heapBase{0x700000U};
 constexpr static uint32_t heapSize{0x100000U};
 
-atariSTe_t::atariSTe_t() noexcept
+atariSTe_t::atariSTe_t()
 {
 	const auto addClockedPeripheral
 	{
@@ -61,25 +60,19 @@ atariSTe_t::atariSTe_t() noexcept
 			// Make sure we're invoked only with a std::unique_ptr<> of some kind of clockedPeripheral_t
 			static_assert(isUniquePtr_v<decltype(peripheral)> && isClockedPeripheral_v<decltype(peripheral)>);
 
-			// Extract a pointer to the device
-			auto *const ptr{peripheral.get()};
-
-			// Add the device to the clocking map according to the clocking ratio set up
-			clockedPeripherals[ptr] = {systemClockFrequency, peripheral->clockFrequency()};
-			// Add the device to the address map
-			addressMap[addressRange] = std::move(peripheral);
-
-			// Return that pointer for use externally
-			return ptr;
+			// Add the device to the clocking set according to the clocking ratio set up
+			clockedPeripherals.push_back({peripheral.get(), {systemClockFrequency, peripheral->clockFrequency()}});
+			// Add the device to the address map, returning the pointer to it for use externally
+			return &mapPeripheral(addressRange, std::move(peripheral));
 		}
 	};
 
 	// Build the system memory map
-	addressMap[{0x000000U, 0x800000U}] = std::make_unique<stRAM_t>();
-	addressMap[{0xe00000U, 0xf00000U}] = std::make_unique<atariSTeROMs_t>
+	systemRAM = &mapPeripheral({0x000000U, 0x800000U}, std::make_unique<stRAM_t>());
+	mapPeripheral({0xe00000U, 0xf00000U}, std::make_unique<atariSTeROMs_t>
 	(
 		cpu, static_cast<memoryMap_t<uint32_t, 0x00ffffffU> &>(*this), heapBase, heapSize
-	);
+	));
 	// Cartridge ROM at 0xfa0000, 128KiB
 	// pre-TOS 2.0 OS ROMs at 0xfc0000, 128KiB
 	psg = addClockedPeripheral({0xff8800U, 0xff8804U}, std::make_unique<ym2149_t>(static_cast<uint32_t>(2_MHz), sampleRate));
@@ -244,10 +237,9 @@ void atariSTe_t::configureTimer(const char timer, const uint16_t timerFrequency)
 // Copy the contents of a decrunched SNDH into the ST's RAM
 bool atariSTe_t::copyToRAM(sndhDecruncher_t &data) noexcept
 {
-	stRAM_t &systemRAM{*dynamic_cast<stRAM_t *>(addressMap[{0x000000U, 0x800000U}].get())};
 	// Get a span that's past the end of the system variables space, and the length of the decrunched SNDH file
 	// But that also excludes the heap and stack spaces
-	auto destination{systemRAM.subspan(0U, stackBase).subspan(0x010000U, data.length())};
+	auto destination{systemRAM->subspan(0U, stackBase).subspan(0x010000U, data.length())};
 	// Now make sure we're at the start of the data and copy it all in
 	return data.head() && data.read(destination);
 }
@@ -276,10 +268,32 @@ bool atariSTe_t::exit() noexcept
 
 bool atariSTe_t::advanceClock() noexcept
 {
-	// The machine runs on a 32MHz (ish) clock, advance a cycle and run
-	// any events on any hardware that needs it
+	// The machine runs on a 32MHz (ish) clock, advance to the next cycle in which something happens and run
+	// any events on any hardware that needs it. Something happening is either the CPU starting a new instruction,
+	// or a peripheral doing something visible outside itself (raising an IRQ, making a sample ready, etc)
+	const bool cpuRunning{cpu.readProgramCounter() != 0xffffffffU || cpu.hasPendingInterrupts()};
+	uint32_t cycles{cpuRunning ? cpu.cyclesUntilStep() : UINT32_MAX};
+	for (const auto &[peripheral, clockManager] : clockedPeripherals)
+	{
+		const auto peripheralCycles{peripheral->cyclesUntilEvent()};
+		if (peripheralCycles != UINT32_MAX)
+			cycles = std::min(cycles, clockManager.cyclesUntil(peripheralCycles));
+	}
+
+	// Nothing can interact in the cycles leading up to that one, so catch everything up through them in bulk
+	if (const auto quietCycles{cycles - 1U}; quietCycles != 0U)
+	{
+		for (auto &[peripheral, clockManager] : clockedPeripherals)
+		{
+			const auto peripheralCycles{clockManager.advanceCycles(quietCycles)};
+			if (peripheralCycles != 0U && !peripheral->clockCycles(peripheralCycles))
+				return false;
+		}
+		if (cpuRunning)
+			cpu.skipCycles(quietCycles);
+	}
 
-	// For each peripheral in the clocked set, see if that peripheral should have a cycle run
+	// Now run the cycle itself. For each peripheral in the clocked set, see if that peripheral should have a cycle run
 	for (auto &[peripheral, clockManager] : clockedPeripherals)
 	{
 		if (clockManager.advanceCycle())
@@ -316,6 +330,30 @@ int16_t atariSTe_t::readSample() noexcept
 	const auto psgSample{psg->sample()};
 	// Extract the sample from the STe DMA DAC engine
 	const auto dmaSample{dac->sample(*this)};
+	return mixSample(psgSample, dmaSample);
+}
+
+// Run the machine until the buffer is full of samples, returning false if something goes wrong doing so
+bool atariSTe_t::render(const substrate::span<int16_t> buffer) noexcept
+{
+	// Sound DMA can only fetch from ST RAM, so let the DAC read its samples straight out of that
+	const auto memory{systemRAM->directMemory()};
+	for (auto &sample : buffer)
+	{
+		// Advance the emulator state till we get a new sample out
+		while (!psg->sampleReady())
+		{
+			if (!advanceClock())
+				return false;
+		}
+		const auto psgSample{psg->sample()};
+		sample = mixSample(psgSample, dac->sample(memory));
+	}
+	return true;
+}
+
+int16_t atariSTe_t::mixSample(const int16_t psgSample, const int16_t dmaSample) const noexcept
+{
 	// Combine the samples to generate the input to the scaling
 	const auto sample
 	{
@@ -3,8 +3,9 @@
 #ifndef EMULATOR_ATARI_STE_HXX
 #define EMULATOR_ATARI_STE_HXX
 
-#include <map>
+#include <vector>
 #include "memoryMap.hxx"
+#include "ram.hxx"
 #include "cpu/m68k.hxx"
 #include "sound/ym2149.hxx"
 #include "sound/steDAC.hxx"
@@ -12,10 +13,18 @@
 #include "unitsHelpers.hxx"
 #include "sndh/iceDecrunch.hxx"
 
+using stRAM_t = ram_t<uint32_t, 8_MiB>;
+
 // M68k has a 24-bit address bus, but we can't directly represent that, so use a 32-bit address value instead.
 struct atariSTe_t : protected memoryMap_t<uint32_t, 0x00ffffffU>
 {
 private:
+	struct clockedDevice_t final
+	{
+		clockedPeripheral_t<uint32_t> *peripheral;
+		clockManager_t clockManager;
+	};
+
 	// To save emulation cycles, use the CPU clock frequency rather than the machine clock frequency
 	// as the system clock frequency
 	constexpr static auto systemClockFrequency{8_MHz};
@@ -23,13 +32,16 @@ private:
 	ym2149_t *psg{nullptr};
 	steDAC_t *dac{nullptr};
 	mc68901_t *mfp{nullptr};
+	stRAM_t *systemRAM{nullptr};
+
+	std::vector<clockedDevice_t> clockedPeripherals{};
 
-	std::map<clockedPeripheral_t<uint32_t> *, clockManager_t> clockedPeripherals{};
+	[[nodiscard]] int16_t mixSample(int16_t psgSample, int16_t dmaSample) const noexcept;
 
 public:
 	constexpr static auto sampleRate{static_cast<uint32_t>(48_kHz)};
 
-	atariSTe_t() noexcept;
+	atariSTe_t();
 
 	void configureTimer(char timer, uint16_t timerFrequency) noexcept;
 	[[nodiscard]] bool copyToRAM(sndhDecruncher_t &data) noexcept;
@@ -39,6 +51,7 @@ public:
 	[[nodiscard]] bool advanceClock() noexcept;
 	[[nodiscard]] bool sampleReady() const noexcept;
 	[[nodiscard]] int16_t readSample() noexcept;
+	[[nodiscard]] bool render(substrate::span<int16_t> buffer) noexcept;
 
 	void displayCPUState() const noexcept;
 };
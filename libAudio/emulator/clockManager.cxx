@@ -2,6 +2,7 @@
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
 #include <cstdint>
 #include <cmath>
+#include <algorithm>
 #include <tuple>
 #include "memoryMap.hxx"
 
@@ -22,3 +23,34 @@ bool clockManager_t::advanceCycle() noexcept
 	}
 	return false;
 }
+
+/*
+ * The cycle counter is really a signed quantity in the range (-targetFrequency, baseFrequency - targetFrequency],
+ * kept in an unsigned value so the above can wrap it around freely. Each target cycle is issued on the base cycle
+ * that takes the counter over baseFrequency - targetFrequency, which lets these compute the effect of many calls
+ * to advanceCycle() in one go. Like advanceCycle(), they assume the target frequency is at most the base one.
+ */
+uint32_t clockManager_t::cyclesUntil(const uint32_t targetCycles) const noexcept
+{
+	if (targetFrequency == 0U)
+		return UINT32_MAX;
+	if (targetCycles == 0U)
+		return 0U;
+	const auto counter{static_cast<int64_t>(static_cast<int32_t>(cycleCounter))};
+	// Find the smallest count of base cycles that takes the counter to targetCycles * baseFrequency - targetFrequency
+	const auto threshold{(int64_t{targetCycles} * baseFrequency) - counter - targetFrequency + 1};
+	const auto cycles{(threshold + targetFrequency - 1) / targetFrequency};
+	return static_cast<uint32_t>(std::min<int64_t>(cycles, UINT32_MAX));
+}
+
+uint32_t clockManager_t::advanceCycles(const uint32_t cycles) noexcept
+{
+	if (baseFrequency == 0U || targetFrequency == 0U)
+		return 0U;
+	const auto counter
+		{static_cast<int64_t>(static_cast<int32_t>(cycleCounter)) + (int64_t{cycles} * targetFrequency)};
+	// Work out how many times the counter crossed the threshold, and take that many base periods off it
+	const auto targetCycles{(counter + targetFrequency - 1) / baseFrequency};
+	cycleCounter = static_cast<uint32_t>(counter - (targetCycles * baseFrequency));
+	return static_cast<uint32_t>(targetCycles);
+}
@@ -0,0 +1,285 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <array>
+#include <string_view>
+#include <substrate/indexed_iterator>
+#include "commodore64.hxx"
+#include "ram.hxx"
+#include "sound/mos6581.hxx"
+#include "timing/mos6526.hxx"
+#include "unitsHelpers.hxx"
+#include "console.hxx"
+
+using namespace std::literals::string_view_literals;
+using namespace libAudio::console;
+
+constexpr static uint32_t palFrameCycles{19656U};
+constexpr static uint32_t ntscFrameCycles{17045U};
+// The values the KERNAL programs into CIA 1's timer A for its 60Hz interrupt
+constexpr static uint16_t palTimerReload{0x4025U};
+constexpr static uint16_t ntscTimerReload{0x4295U};
+// Allow init routines around 20 seconds of run time before deciding they've gone wrong
+constexpr static uint32_t initTimeLimit{20U};
+
+// Processor port data direction and value, for RAM, I/O and the KERNAL being visible
+constexpr static std::array<uint8_t, 2U> processorPort{{0x2fU, 0x37U}};
+// IRQ entry ($FF48): save the registers and dispatch through the vector at $0314
+constexpr static std::array<uint8_t, 8U> irqEntry{{0x48U, 0x8aU, 0x48U, 0x98U, 0x48U, 0x6cU, 0x14U, 0x03U}};
+// Default IRQ handler ($EA31): acknowledge CIA 1's interrupt then fall into the exit path
+constexpr static std::array<uint8_t, 6U> irqHandler{{0xadU, 0x0dU, 0xdcU, 0x4cU, 0x81U, 0xeaU}};
+// IRQ exit ($EA81): restore the registers and return
+constexpr static std::array<uint8_t, 6U> irqExit{{0x68U, 0xa8U, 0x68U, 0xaaU, 0x68U, 0x40U}};
+// NMI entry ($FE43) dispatching through the vector at $0318, and the default handler ($FE47) that just returns
+constexpr static std::array<uint8_t, 5U> nmiEntry{{0x78U, 0x6cU, 0x18U, 0x03U, 0x40U}};
+constexpr static std::array<uint8_t, 4U> softVectors{{0x31U, 0xeaU, 0x47U, 0xfeU}};
+constexpr static std::array<uint8_t, 6U> hardVectors{{0x43U, 0xfeU, 0xe2U, 0xfcU, 0x48U, 0xffU}};
+
+/*
+ * Sits between the memory map and one of the chips, so the chips are always caught up with the CPU before it
+ * accesses them, and so the machine knows to check when their next event is after the CPU writes to them
+ */
+struct commodore64_t::ioDevice_t final : public peripheral_t<uint32_t>
+{
+private:
+	commodore64_t &machine;
+	std::unique_ptr<clockedPeripheral_t<uint32_t>> chip;
+
+public:
+	ioDevice_t(commodore64_t &owner, std::unique_ptr<clockedPeripheral_t<uint32_t>> &&device) noexcept :
+		machine{owner}, chip{std::move(device)} { }
+
+	void readAddress(const uint32_t address, substrate::span<uint8_t> data) const noexcept final
+	{
+		machine.syncPeripherals();
+		chip->readAddress(address, data);
+	}
+
+	void writeAddress(const uint32_t address, const substrate::span<uint8_t> &data) noexcept final
+	{
+		machine.syncPeripherals();
+		chip->writeAddress(address, data);
+		machine.ioWritten = true;
+	}
+};
+
+commodore64_t::commodore64_t(const sidModel_t sidModel, const bool ntsc) :
+	systemClockFrequency{ntsc ? ntscClockFrequency : palClockFrequency},
+	frameCycles{ntsc ? ntscFrameCycles : palFrameCycles}
+{
+	const auto addClockedPeripheral
+	{
+		[this](const memoryRange_t<uint32_t> addressRange, auto peripheral)
+		{
+			auto *const chip{peripheral.get()};
+			clockedPeripherals.push_back(chip);
+			mapPeripheral(addressRange, std::make_unique<ioDevice_t>(*this, std::move(peripheral)));
+			return chip;
+		}
+	};
+
+	// Build the system memory map
+	mapPeripheral({0x0000U, 0xd000U}, std::make_unique<ram_t<uint32_t, 52_KiB>>());
+	// The VIC-II is not emulated, so just give writes to its registers somewhere to go
+	mapPeripheral({0xd000U, 0xd400U}, std::make_unique<ram_t<uint32_t, 1_KiB>>());
+	sid = addClockedPeripheral({0xd400U, 0xd800U},
+		std::make_unique<mos6581_t>(systemClockFrequency, sampleRate, sidModel));
+	// Colour RAM
+	mapPeripheral({0xd800U, 0xdc00U}, std::make_unique<ram_t<uint32_t, 1_KiB>>());
+	cia1 = addClockedPeripheral({0xdc00U, 0xdd00U}, std::make_unique<mos6526_t>(systemClockFrequency));
+	cia2 = addClockedPeripheral({0xdd00U, 0xde00U}, std::make_unique<mos6526_t>(systemClockFrequency));
+	// I/O areas 1 and 2 ($DE00-$DFFF) have no cartridge attached, and the KERNAL ROM is replaced by RAM
+	mapPeripheral({0xe000U, 0x10000U}, std::make_unique<ram_t<uint32_t, 8_KiB>>());
+
+	// CIA 1 drives the IRQ line and CIA 2 the NMI line
+	cpu.registerInterruptRequester(*cia1);
+	cpu.registerNMIRequester(*cia2);
+
+	// Set CIA 1 timer A running as the KERNAL would, with its interrupt enabled
+	const auto timerReload{ntsc ? ntscTimerReload : palTimerReload};
+	writeAddress<uint8_t>(0xdc04U, static_cast<uint8_t>(timerReload));
+	writeAddress<uint8_t>(0xdc05U, static_cast<uint8_t>(timerReload >> 8U));
+	writeAddress<uint8_t>(0xdc0dU, 0x81U);
+	writeAddress<uint8_t>(0xdc0eU, 0x11U);
+}
+
+// Writes a stub routine (or vector) into memory, except where that would overwrite the tune
+void commodore64_t::writeStub(const uint16_t address, const substrate::span<const uint8_t> code) noexcept
+{
+	for (const auto &[offset, byte] : substrate::indexedIterator_t{code})
+	{
+		const auto stubAddress{static_cast<uint32_t>(address + offset)};
+		if (stubAddress >= loadBegin && stubAddress < loadEnd)
+			continue;
+		writeAddress<uint8_t>(stubAddress, byte);
+	}
+}
+
+bool commodore64_t::copyToRAM(const uint16_t loadAddress, const substrate::span<const uint8_t> data) noexcept
+{
+	const auto loadLimit{static_cast<uint32_t>(loadAddress + data.size())};
+	// The tune has to fit in memory, and must not overlap the I/O area as there's no way to bank it out
+	if (data.size() > 0x10000U || loadLimit > 0x10000U || (loadAddress < 0xe000U && loadLimit > 0xd000U))
+		return false;
+	for (const auto &[offset, byte] : substrate::indexedIterator_t{data})
+		writeAddress<uint8_t>(static_cast<uint32_t>(loadAddress + offset), byte);
+	loadBegin = loadAddress;
+	loadEnd = loadLimit;
+	return true;
+}
+
+bool commodore64_t::init(const uint16_t initAddress, const uint16_t playRoutine, const uint8_t subtune,
+	const bool useCIATiming) noexcept
+{
+	// Put in place the bits of the KERNAL's interrupt handling that tunes rely on
+	writeStub(0x0000U, processorPort);
+	writeStub(0xff48U, irqEntry);
+	writeStub(0xea31U, irqHandler);
+	writeStub(0xea81U, irqExit);
+	writeStub(0xfe43U, nmiEntry);
+	writeStub(0x0314U, softVectors);
+	writeStub(0xfffaU, hardVectors);
+
+	// Run the tune's initialisation routine with the (0-based) subtune to play in A
+	cpu.writeAccumulator(subtune);
+	if (!cpu.executeToReturn(initAddress, systemClockFrequency * initTimeLimit))
+	{
+		console.error("Tune initialisation failed at "sv, asHex_t<4U, '0'>{cpu.readProgramCounter()});
+		return false;
+	}
+
+	playAddress = playRoutine;
+	ciaSpeed = useCIATiming;
+	frameCountdown = frameCycles;
+	// Tunes without a play routine drive themselves from the interrupts they've set up, so let those through
+	if (!playAddress)
+		cpu.writeStatus(cpu.readStatus() & 0xfbU);
+	static_cast<void>(cia1->consumeTimerAUnderflow());
+	return true;
+}
+
+// Catch the chips up on the cycles the CPU has run since they were last clocked, which are all before their next event
+void commodore64_t::syncPeripherals() noexcept
+{
+	if (!pendingCycles)
+		return;
+	for (auto *const peripheral : clockedPeripherals)
+		static_cast<void>(peripheral->clockCycles(pendingCycles));
+	if (cyclesUntilChipEvent != UINT32_MAX)
+		cyclesUntilChipEvent -= pendingCycles;
+	pendingCycles = 0U;
+}
+
+void commodore64_t::updateCyclesUntilEvent() noexcept
+{
+	cyclesUntilChipEvent = UINT32_MAX;
+	for (const auto *const peripheral : clockedPeripherals)
+		cyclesUntilChipEvent = std::min(cyclesUntilChipEvent, peripheral->cyclesUntilEvent());
+}
+
+bool commodore64_t::advanceClock() noexcept
+{
+	// Advance to the next cycle in which something happens and run any events on any hardware that needs it.
+	// Something happening is either the CPU starting a new instruction, the play routine being due, or a
+	// chip doing something visible outside itself (underflowing a timer, filling its output buffer, etc)
+	const bool cpuRunning{cpu.running() || cpu.hasPendingInterrupts()};
+	uint32_t cycles{cpuRunning ? cpu.cyclesUntilStep() : UINT32_MAX};
+	// A play call held back by the previous one still running gets made as soon as the CPU's free
+	if (playPending && !cpu.running())
+		cycles = 1U;
+	if (playAddress && !ciaSpeed)
+		cycles = std::min(cycles, frameCountdown);
+	const auto chipCycles
+		{cyclesUntilChipEvent == UINT32_MAX ? UINT32_MAX : cyclesUntilChipEvent - pendingCycles};
+	cycles = std::min(cycles, chipCycles);
+	// If nothing at all is going to happen, run a frame's worth of cycles at a time
+	if (cycles == UINT32_MAX)
+		cycles = frameCycles;
+
+	// Nothing can interact in the cycles leading up to that one, so skip the CPU through them in bulk
+	if (const auto quietCycles{cycles - 1U}; quietCycles != 0U)
+	{
+		if (cpuRunning)
+			cpu.skipCycles(quietCycles);
+		if (playAddress && !ciaSpeed)
+			frameCountdown -= quietCycles;
+	}
+
+	if (cycles == chipCycles)
+	{
+		// One of the chips has an event this cycle, so catch them all up to it and then run it
+		if (const auto quietCycles{pendingCycles + cycles - 1U}; quietCycles != 0U)
+		{
+			for (auto *const peripheral : clockedPeripherals)
+			{
+				if (!peripheral->clockCycles(quietCycles))
+					return false;
+			}
+		}
+		for (auto *const peripheral : clockedPeripherals)
+		{
+			if (!peripheral->clockCycle())
+				return false;
+		}
+		pendingCycles = 0U;
+		updateCyclesUntilEvent();
+	}
+	else
+		// Otherwise leave the chips to be caught up later
+		pendingCycles += cycles;
+
+	// Work out if the play routine is due, either from the frame timing or CIA 1 timer A
+	if (playAddress)
+	{
+		if (ciaSpeed)
+			playPending |= cia1->consumeTimerAUnderflow();
+		else if (--frameCountdown == 0U)
+		{
+			frameCountdown = frameCycles;
+			playPending = true;
+		}
+		// If the previous call is still running, this one has to wait for it to finish
+		if (playPending && !cpu.running())
+		{
+			playPending = false;
+			cpu.call(playAddress);
+		}
+	}
+
+	// If the CPU has anything to do, run another instruction
+	if (cpu.running() || cpu.hasPendingInterrupts())
+	{
+		const auto programCounter{cpu.readProgramCounter()};
+		if (!cpu.advanceClock())
+		{
+			// Something bad happened, so display the program counter at the faulting instruction
+			console.debug("Bad instruction at "sv, asHex_t<4U, '0'>{programCounter});
+			return false;
+		}
+		// If the instruction wrote to one of the chips, that may have changed when its next event is
+		if (ioWritten)
+		{
+			ioWritten = false;
+			updateCyclesUntilEvent();
+		}
+	}
+
+	return true;
+}
+
+// Run the machine until the buffer is full of samples, returning false if something goes wrong doing so
+bool commodore64_t::render(const substrate::span<int16_t> buffer) noexcept
+{
+	syncPeripherals();
+	sid->outputTo(buffer);
+	updateCyclesUntilEvent();
+	while (!sid->outputFull())
+	{
+		if (!advanceClock())
+			return false;
+	}
+	return true;
+}
+
+void commodore64_t::displayCPUState() const noexcept
+	{ cpu.displayRegs(); }
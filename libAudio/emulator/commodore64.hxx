@@ -0,0 +1,72 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef EMULATOR_COMMODORE_64_HXX
+#define EMULATOR_COMMODORE_64_HXX
+
+#include <cstdint>
+#include <vector>
+#include <substrate/span>
+#include "memoryMap.hxx"
+#include "ram.hxx"
+#include "cpu/mos6502.hxx"
+#include "sound/mos6581.hxx"
+#include "timing/mos6526.hxx"
+#include "unitsHelpers.hxx"
+
+/*
+ * Just enough of a C64 to play PSID tunes: the 6510, a SID, the two CIAs and RAM everywhere else. There's no
+ * KERNAL or BASIC ROM - instead a handful of stub routines provide the interrupt entry and exit paths tunes
+ * expect to find, and the player calls the tune's play routine itself, once a frame or each time CIA 1's
+ * timer A fires. Everything runs off the one system clock, so there's no need for any clock managers.
+ *
+ * The chips are clocked lazily: while the CPU runs, the cycles it takes are only totted up, and the chips get
+ * caught up on them when either the CPU accesses one of them or the next of their events comes due. As nothing
+ * else can observe them in between, this behaves exactly as clocking them every instruction would.
+ */
+struct commodore64_t : protected mos6502MemoryMap_t
+{
+private:
+	struct ioDevice_t;
+
+	uint32_t systemClockFrequency;
+	uint32_t frameCycles;
+	mos6502_t cpu{*this};
+	mos6581_t *sid{nullptr};
+	mos6526_t *cia1{nullptr};
+	mos6526_t *cia2{nullptr};
+
+	std::vector<clockedPeripheral_t<uint32_t> *> clockedPeripherals{};
+	// Cycles run by the CPU that the chips have yet to be clocked for, and how long it is till the next chip event
+	uint32_t pendingCycles{0U};
+	uint32_t cyclesUntilChipEvent{UINT32_MAX};
+	bool ioWritten{false};
+
+	// The region the tune got loaded into, which the stub routines must stay out of
+	uint16_t loadBegin{0U};
+	uint32_t loadEnd{0U};
+	uint16_t playAddress{0U};
+	bool ciaSpeed{false};
+	uint32_t frameCountdown{0U};
+	bool playPending{false};
+
+	void writeStub(uint16_t address, substrate::span<const uint8_t> code) noexcept;
+	void syncPeripherals() noexcept;
+	void updateCyclesUntilEvent() noexcept;
+
+public:
+	constexpr static auto sampleRate{static_cast<uint32_t>(48_kHz)};
+	constexpr static uint32_t palClockFrequency{985248U};
+	constexpr static uint32_t ntscClockFrequency{1022727U};
+
+	commodore64_t(sidModel_t sidModel, bool ntsc);
+
+	[[nodiscard]] bool copyToRAM(uint16_t loadAddress, substrate::span<const uint8_t> data) noexcept;
+	[[nodiscard]] bool init(uint16_t initAddress, uint16_t playRoutine, uint8_t subtune, bool useCIATiming) noexcept;
+
+	[[nodiscard]] bool advanceClock() noexcept;
+	[[nodiscard]] bool render(substrate::span<int16_t> buffer) noexcept;
+
+	void displayCPUState() const noexcept;
+};
+
+#endif /*EMULATOR_COMMODORE_64_HXX*/
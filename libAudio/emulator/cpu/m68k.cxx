@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
+#include <memory>
 #include <string_view>
 #include <substrate/index_sequence>
 #include "m68k.hxx"
@@ -29,11 +30,27 @@ constexpr static uint16_t vectorMask{0x0007U};
 constexpr static uint16_t displacementMask{0x00ffU};
 
 motorola68000_t::motorola68000_t(memoryMap_t<uint32_t, 0x00ffffffU> &peripherals, const uint32_t clockFreq) noexcept :
-	_peripherals{peripherals}, clockFrequency{clockFreq}
+	_peripherals{peripherals}, decodeTable{decodedOperations()}, clockFrequency{clockFreq}
 {
 }
 
-decodedOperation_t motorola68000_t::decodeInstruction(const uint16_t insn) const noexcept
+// Decode every possible instruction word once, the first time any CPU needs the table
+const m68kDecodeTable_t &motorola68000_t::decodedOperations() noexcept
+{
+	static const auto table
+	{
+		[]() noexcept
+		{
+			auto result{std::make_unique<m68kDecodeTable_t>()};
+			for (const auto insn : substrate::indexSequence_t{result->size()})
+				(*result)[insn] = decodeInstruction(static_cast<uint16_t>(insn));
+			return result;
+		}()
+	};
+	return *table;
+}
+
+decodedOperation_t motorola68000_t::decodeInstruction(const uint16_t insn) noexcept
 {
 
 	// Extract out the effecetive addressing mode
@@ -2569,14 +2586,25 @@ uint32_t motorola68000_t::readProgramCounter() const noexcept { return programCo
 uint16_t motorola68000_t::readStatus() const noexcept { return status.toRaw(); }
 void motorola68000_t::writeStatus(const uint16_t value) noexcept { status.fromRaw(value); }
 
+const decodedOperation_t &motorola68000_t::fetchInstruction() noexcept
+{
+	// Look up where the instruction at the program counter would be in the cache
+	auto &entry{decodeCache[(programCounter >> 1U) % decodeCache.size()]};
+	const auto generation{_peripherals.writeGeneration(programCounter)};
+	// If it's not there, or its page has been written to since it was cached, fetch the instruction word again
+	if (entry.address != programCounter || entry.generation != generation || !entry.operation)
+		entry = {programCounter, generation, &decodeTable[_peripherals.readAddress<uint16_t>(programCounter)]};
+	return *entry.operation;
+}
+
 stepResult_t motorola68000_t::step() noexcept
 {
 	// See if there are any pending interrupt requests
 	if (checkPendingIRQs())
 		// There was, so return a step result indicating we "executed" a 2 cycle "instruction"
 		return {true, false, 2U};
-	// Start by fetching a uint16_t for the instruction and trying to decode it
-	auto instruction{decodeInstruction(_peripherals.readAddress<uint16_t>(programCounter))};
+	// Start by fetching the decoded form of the instruction
+	const auto &instruction{fetchInstruction()};
 	programCounter += 2U;
 	// Now we have an instruction to run, try to dispatch it
 	switch (instruction.operation)
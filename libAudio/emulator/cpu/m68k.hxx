@@ -44,10 +44,23 @@ namespace m68k
 	struct irqRequester_t;
 }
 
+// The decoded form of every possible instruction word, indexed by that instruction word
+using m68kDecodeTable_t = std::array<decodedOperation_t, 65536U>;
+
 struct motorola68000_t final
 {
 private:
+	// An entry in the decoded instruction cache, valid while its page has seen no further writes
+	struct decodeCacheEntry_t
+	{
+		uint32_t address{UINT32_MAX};
+		uint32_t generation{0U};
+		const decodedOperation_t *operation{nullptr};
+	};
+
 	memoryMap_t<uint32_t, 0x00ffffffU> &_peripherals;
+	const m68kDecodeTable_t &decodeTable;
+	std::array<decodeCacheEntry_t, 2048U> decodeCache{};
 	std::array<m68k::irqRequester_t *, 7U> interruptRequesters{};
 	uint32_t clockFrequency;
 	uint32_t waitCycles{0U};
@@ -76,6 +89,8 @@ private:
 
 	bool trapState{false};
 
+	[[nodiscard]] const decodedOperation_t &fetchInstruction() noexcept;
+
 	// Instruction dispatch/execution functions
 	[[nodiscard]] int32_t readIndex(uint16_t extension) const noexcept;
 	[[nodiscard]] int32_t readExtraDisplacement(uint8_t displacementSize) noexcept;
@@ -203,12 +218,17 @@ public:
 	void writeStatus(uint16_t value) noexcept;
 	[[nodiscard]] stepResult_t step() noexcept;
 	[[nodiscard]] bool advanceClock() noexcept;
+	// How many clock cycles it is until (and including) the one on which the next instruction runs
+	[[nodiscard]] uint32_t cyclesUntilStep() const noexcept { return waitCycles + 1U; }
+	// Skip clock cycles the current instruction is still taking, which must be fewer than cyclesUntilStep()
+	void skipCycles(const uint32_t cycles) noexcept { waitCycles -= cycles; }
 	[[nodiscard]] bool trapped() const noexcept { return trapState; }
 
 	void displayRegs() const noexcept;
 
 	// Not actually part of the public interface, just necessary to be exposed for testing
-	decodedOperation_t decodeInstruction(uint16_t insn) const noexcept;
+	[[nodiscard]] static decodedOperation_t decodeInstruction(uint16_t insn) noexcept;
+	[[nodiscard]] static const m68kDecodeTable_t &decodedOperations() noexcept;
 };
 
 extern template uint8_t motorola68000_t::readValue<uint8_t>(uint8_t mode, uint8_t reg, uint32_t address) noexcept;
@@ -0,0 +1,796 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <string_view>
+#include "mos6502.hxx"
+#include "console.hxx"
+
+using namespace std::literals::string_view_literals;
+using namespace libAudio::console;
+using mos6502::stepResult_t;
+
+// The address RTS lands on when a call() completes, which the CPU then idles at
+constexpr static uint16_t returnAddress{0x0000U};
+constexpr static uint16_t stackBase{0x0100U};
+
+// Base cycle counts for each opcode, with the JAMs given as 0
+constexpr static std::array<uint8_t, 256U> cycleCounts
+{{
+	7U, 6U, 0U, 8U, 3U, 3U, 5U, 5U, 3U, 2U, 2U, 2U, 4U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+	6U, 6U, 0U, 8U, 3U, 3U, 5U, 5U, 4U, 2U, 2U, 2U, 4U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+	6U, 6U, 0U, 8U, 3U, 3U, 5U, 5U, 3U, 2U, 2U, 2U, 3U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+	6U, 6U, 0U, 8U, 3U, 3U, 5U, 5U, 4U, 2U, 2U, 2U, 5U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+	2U, 6U, 2U, 6U, 3U, 3U, 3U, 3U, 2U, 2U, 2U, 2U, 4U, 4U, 4U, 4U,
+	2U, 6U, 0U, 6U, 4U, 4U, 4U, 4U, 2U, 5U, 2U, 5U, 5U, 5U, 5U, 5U,
+	2U, 6U, 2U, 6U, 3U, 3U, 3U, 3U, 2U, 2U, 2U, 2U, 4U, 4U, 4U, 4U,
+	2U, 5U, 0U, 5U, 4U, 4U, 4U, 4U, 2U, 4U, 2U, 4U, 4U, 4U, 4U, 4U,
+	2U, 6U, 2U, 8U, 3U, 3U, 5U, 5U, 2U, 2U, 2U, 2U, 4U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+	2U, 6U, 2U, 8U, 3U, 3U, 5U, 5U, 2U, 2U, 2U, 2U, 4U, 4U, 6U, 6U,
+	2U, 5U, 0U, 8U, 4U, 4U, 6U, 6U, 2U, 4U, 2U, 7U, 4U, 4U, 7U, 7U,
+}};
+
+// The read instructions using indexed addressing, which take an extra cycle when the index crosses a page
+constexpr static auto pageCrossPenalty{[]() noexcept
+{
+	std::array<bool, 256U> result{};
+	for (const auto opcode : {0x11U, 0x19U, 0x1dU, 0x31U, 0x39U, 0x3dU, 0x51U, 0x59U, 0x5dU, 0x71U, 0x79U, 0x7dU,
+		0xb1U, 0xb3U, 0xb9U, 0xbbU, 0xbcU, 0xbdU, 0xbeU, 0xbfU, 0xd1U, 0xd9U, 0xddU, 0xf1U, 0xf9U, 0xfdU,
+		0x1cU, 0x3cU, 0x5cU, 0x7cU, 0xdcU, 0xfcU})
+		result[opcode] = true;
+	return result;
+}()};
+
+mos6502_t::mos6502_t(mos6502MemoryMap_t &peripherals) noexcept : _peripherals{peripherals} { }
+
+uint16_t mos6502_t::readWord(const uint16_t address) const noexcept
+	{ return static_cast<uint16_t>(readByte(address) | (readByte(static_cast<uint16_t>(address + 1U)) << 8U)); }
+
+// Pointers in the zero page wrap around within it
+uint16_t mos6502_t::readWordZeroPage(const uint8_t address) const noexcept
+	{ return static_cast<uint16_t>(readByte(address) | (readByte(uint8_t(address + 1U)) << 8U)); }
+
+uint16_t mos6502_t::fetchWord() noexcept
+{
+	const auto value{readWord(programCounter)};
+	programCounter += 2U;
+	return value;
+}
+
+void mos6502_t::push(const uint8_t value) noexcept
+	{ writeByte(stackBase | stackPointer--, value); }
+
+uint8_t mos6502_t::pop() noexcept
+	{ return readByte(stackBase | ++stackPointer); }
+
+uint16_t mos6502_t::absoluteX() noexcept
+{
+	const auto base{fetchWord()};
+	const auto address{static_cast<uint16_t>(base + x)};
+	pageCrossed = (base ^ address) & 0xff00U;
+	return address;
+}
+
+uint16_t mos6502_t::absoluteY() noexcept
+{
+	const auto base{fetchWord()};
+	const auto address{static_cast<uint16_t>(base + y)};
+	pageCrossed = (base ^ address) & 0xff00U;
+	return address;
+}
+
+uint16_t mos6502_t::indirectX() noexcept
+	{ return readWordZeroPage(uint8_t(fetchByte() + x)); }
+
+uint16_t mos6502_t::indirectY() noexcept
+{
+	const auto base{readWordZeroPage(fetchByte())};
+	const auto address{static_cast<uint16_t>(base + y)};
+	pageCrossed = (base ^ address) & 0xff00U;
+	return address;
+}
+
+uint8_t mos6502_t::packStatus(const bool breakFlag) const noexcept
+{
+	return static_cast<uint8_t>((negative ? 0x80U : 0U) | (overflow ? 0x40U : 0U) | 0x20U |
+		(breakFlag ? 0x10U : 0U) | (decimal ? 0x08U : 0U) | (interruptDisable ? 0x04U : 0U) |
+		(zero ? 0x02U : 0U) | (carry ? 0x01U : 0U));
+}
+
+void mos6502_t::unpackStatus(const uint8_t status) noexcept
+{
+	negative = status & 0x80U;
+	overflow = status & 0x40U;
+	decimal = status & 0x08U;
+	interruptDisable = status & 0x04U;
+	zero = status & 0x02U;
+	carry = status & 0x01U;
+}
+
+void mos6502_t::adc(const uint8_t value) noexcept
+{
+	const uint16_t carryIn(carry ? 1U : 0U);
+	if (!decimal)
+	{
+		const auto sum{static_cast<uint16_t>(a + value + carryIn)};
+		overflow = ~(a ^ value) & (a ^ sum) & 0x80U;
+		carry = sum > 0xffU;
+		a = static_cast<uint8_t>(sum);
+		setNZ(a);
+		return;
+	}
+
+	// NMOS decimal mode, which computes Z from the binary sum and N and V from the partially adjusted one
+	auto sum{static_cast<uint16_t>((a & 0x0fU) + (value & 0x0fU) + carryIn)};
+	if (sum > 0x09U)
+		sum += 0x06U;
+	sum = static_cast<uint16_t>((sum & 0x0fU) + (a & 0xf0U) + (value & 0xf0U) + (sum > 0x0fU ? 0x10U : 0U));
+	zero = ((a + value + carryIn) & 0xffU) == 0U;
+	negative = sum & 0x80U;
+	overflow = ((a ^ sum) & 0x80U) && !((a ^ value) & 0x80U);
+	if ((sum & 0x1f0U) > 0x90U)
+		sum += 0x60U;
+	carry = (sum & 0xff0U) > 0xf0U;
+	a = static_cast<uint8_t>(sum);
+}
+
+void mos6502_t::sbc(const uint8_t value) noexcept
+{
+	const uint16_t borrow(carry ? 0U : 1U);
+	const auto difference{static_cast<uint16_t>(a - value - borrow)};
+	// In both modes the flags come from the binary result
+	overflow = ((a ^ difference) & 0x80U) && ((a ^ value) & 0x80U);
+	setNZ(static_cast<uint8_t>(difference));
+	if (decimal)
+	{
+		auto result{static_cast<uint16_t>((a & 0x0fU) - (value & 0x0fU) - borrow)};
+		if (result & 0x10U)
+			result = static_cast<uint16_t>(((result - 0x06U) & 0x0fU) | ((a & 0xf0U) - (value & 0xf0U) - 0x10U));
+		else
+			result = static_cast<uint16_t>((result & 0x0fU) | ((a & 0xf0U) - (value & 0xf0U)));
+		if (result & 0x100U)
+			result -= 0x60U;
+		a = static_cast<uint8_t>(result);
+	}
+	else
+		a = static_cast<uint8_t>(difference);
+	carry = difference < 0x100U;
+}
+
+void mos6502_t::compare(const uint8_t lhs, const uint8_t rhs) noexcept
+{
+	carry = lhs >= rhs;
+	setNZ(static_cast<uint8_t>(lhs - rhs));
+}
+
+uint8_t mos6502_t::asl(const uint8_t value) noexcept
+{
+	carry = value & 0x80U;
+	const auto result{static_cast<uint8_t>(value << 1U)};
+	setNZ(result);
+	return result;
+}
+
+uint8_t mos6502_t::lsr(const uint8_t value) noexcept
+{
+	carry = value & 0x01U;
+	const auto result{static_cast<uint8_t>(value >> 1U)};
+	setNZ(result);
+	return result;
+}
+
+uint8_t mos6502_t::rol(const uint8_t value) noexcept
+{
+	const auto result{static_cast<uint8_t>((value << 1U) | (carry ? 0x01U : 0U))};
+	carry = value & 0x80U;
+	setNZ(result);
+	return result;
+}
+
+uint8_t mos6502_t::ror(const uint8_t value) noexcept
+{
+	const auto result{static_cast<uint8_t>((value >> 1U) | (carry ? 0x80U : 0U))};
+	carry = value & 0x01U;
+	setNZ(result);
+	return result;
+}
+
+// Runs a conditional branch, returning how many extra cycles it took
+uint8_t mos6502_t::branch(const bool condition) noexcept
+{
+	const auto offset{static_cast<int8_t>(fetchByte())};
+	if (!condition)
+		return 0U;
+	const auto origin{programCounter};
+	programCounter = static_cast<uint16_t>(programCounter + offset);
+	return (origin ^ programCounter) & 0xff00U ? 2U : 1U;
+}
+
+void mos6502_t::serviceInterrupt(const uint16_t vectorAddress) noexcept
+{
+	push(static_cast<uint8_t>(programCounter >> 8U));
+	push(static_cast<uint8_t>(programCounter));
+	push(packStatus(false));
+	interruptDisable = true;
+	programCounter = readWord(vectorAddress);
+	idle = false;
+}
+
+// If a return just brought us back out of the outermost call, go idle
+void mos6502_t::checkReturned() noexcept
+{
+	if (programCounter == returnAddress && stackPointer == idleStackPointer)
+		idle = true;
+}
+
+bool mos6502_t::irqAsserted() const noexcept
+{
+	for (const auto *const requester : irqRequesters)
+	{
+		if (requester->irqAsserted())
+			return true;
+	}
+	return false;
+}
+
+void mos6502_t::call(const uint16_t entryAddress) noexcept
+{
+	idleStackPointer = stackPointer;
+	// Stack a return address that RTS will turn into the idle address
+	const auto returnTo{static_cast<uint16_t>(returnAddress - 1U)};
+	push(static_cast<uint8_t>(returnTo >> 8U));
+	push(static_cast<uint8_t>(returnTo));
+	programCounter = entryAddress;
+	interruptDisable = true;
+	idle = false;
+}
+
+bool mos6502_t::executeToReturn(const uint16_t entryAddress, const uint32_t cycleLimit) noexcept
+{
+	call(entryAddress);
+	uint32_t cycles{0U};
+	while (!idle)
+	{
+		const auto result{step()};
+		cycles += result.cyclesTaken;
+		if (!result.validInsn || cycles > cycleLimit)
+			return false;
+	}
+	return true;
+}
+
+void mos6502_t::registerInterruptRequester(mos6502::irqRequester_t &requester) noexcept
+	{ irqRequesters.push_back(&requester); }
+
+void mos6502_t::registerNMIRequester(mos6502::irqRequester_t &requester) noexcept
+	{ nmiRequesters.push_back(&requester); }
+
+bool mos6502_t::hasPendingInterrupts() const noexcept
+{
+	if (nmiPending)
+		return true;
+	// NMI is edge triggered, so only a newly asserted line counts
+	if (!nmiLine)
+	{
+		for (const auto *const requester : nmiRequesters)
+		{
+			if (requester->irqAsserted())
+				return true;
+		}
+	}
+	return !interruptDisable && irqAsserted();
+}
+
+stepResult_t mos6502_t::step() noexcept
+{
+	bool nmiState{false};
+	for (const auto *const requester : nmiRequesters)
+		nmiState |= requester->irqAsserted();
+	if (nmiState && !nmiLine)
+		nmiPending = true;
+	nmiLine = nmiState;
+
+	if (nmiPending)
+	{
+		nmiPending = false;
+		serviceInterrupt(mos6502::nmiVectorAddress);
+		return {true, 7U};
+	}
+	if (!interruptDisable && irqAsserted())
+	{
+		serviceInterrupt(mos6502::irqVectorAddress);
+		return {true, 7U};
+	}
+	// With nothing to run, burn a cycle
+	if (idle)
+		return {true, 1U};
+	return dispatch(fetchByte());
+}
+
+stepResult_t mos6502_t::dispatch(const uint8_t opcode) noexcept
+{
+	pageCrossed = false;
+	uint8_t extraCycles{0U};
+
+	const auto load{[this](uint8_t &reg, const uint16_t address) noexcept
+	{
+		reg = readByte(address);
+		setNZ(reg);
+	}};
+	const auto ora{[this](const uint16_t address) noexcept
+	{
+		a |= readByte(address);
+		setNZ(a);
+	}};
+	const auto _and{[this](const uint16_t address) noexcept
+	{
+		a &= readByte(address);
+		setNZ(a);
+	}};
+	const auto eor{[this](const uint16_t address) noexcept
+	{
+		a ^= readByte(address);
+		setNZ(a);
+	}};
+	const auto bit{[this](const uint16_t address) noexcept
+	{
+		const auto value{readByte(address)};
+		zero = !(a & value);
+		negative = value & 0x80U;
+		overflow = value & 0x40U;
+	}};
+	const auto lax{[this](const uint16_t address) noexcept
+	{
+		a = x = readByte(address);
+		setNZ(a);
+	}};
+	// Runs a read-modify-write operation on memory, returning the value written back
+	const auto modify{[this](const uint16_t address, const auto operation) noexcept
+	{
+		const uint8_t result{operation(readByte(address))};
+		writeByte(address, result);
+		return result;
+	}};
+	const auto aslOp{[this](const uint8_t value) noexcept { return asl(value); }};
+	const auto lsrOp{[this](const uint8_t value) noexcept { return lsr(value); }};
+	const auto rolOp{[this](const uint8_t value) noexcept { return rol(value); }};
+	const auto rorOp{[this](const uint8_t value) noexcept { return ror(value); }};
+	const auto decOp{[this](const uint8_t value) noexcept
+	{
+		const auto result{static_cast<uint8_t>(value - 1U)};
+		setNZ(result);
+		return result;
+	}};
+	const auto incOp{[this](const uint8_t value) noexcept
+	{
+		const auto result{static_cast<uint8_t>(value + 1U)};
+		setNZ(result);
+		return result;
+	}};
+	const auto slo{[&](const uint16_t address) noexcept
+	{
+		a |= modify(address, aslOp);
+		setNZ(a);
+	}};
+	const auto rla{[&](const uint16_t address) noexcept
+	{
+		a &= modify(address, rolOp);
+		setNZ(a);
+	}};
+	const auto sre{[&](const uint16_t address) noexcept
+	{
+		a ^= modify(address, lsrOp);
+		setNZ(a);
+	}};
+	const auto rra{[&](const uint16_t address) noexcept { adc(modify(address, rorOp)); }};
+	const auto dcp{[&](const uint16_t address) noexcept
+		{ compare(a, modify(address, [](const uint8_t value) noexcept { return uint8_t(value - 1U); })); }};
+	const auto isc{[&](const uint16_t address) noexcept
+		{ sbc(modify(address, [](const uint8_t value) noexcept { return uint8_t(value + 1U); })); }};
+	// The unstable stores AND the value with the high byte of the target address plus one
+	const auto storeHigh{[this](const uint16_t address, const uint8_t value) noexcept
+		{ writeByte(address, static_cast<uint8_t>(value & ((address >> 8U) + 1U))); }};
+
+	switch (opcode)
+	{
+		// ORA
+		case 0x09U: ora(immediate()); break;
+		case 0x05U: ora(zeroPage()); break;
+		case 0x15U: ora(zeroPageX()); break;
+		case 0x0dU: ora(absolute()); break;
+		case 0x1dU: ora(absoluteX()); break;
+		case 0x19U: ora(absoluteY()); break;
+		case 0x01U: ora(indirectX()); break;
+		case 0x11U: ora(indirectY()); break;
+		// AND
+		case 0x29U: _and(immediate()); break;
+		case 0x25U: _and(zeroPage()); break;
+		case 0x35U: _and(zeroPageX()); break;
+		case 0x2dU: _and(absolute()); break;
+		case 0x3dU: _and(absoluteX()); break;
+		case 0x39U: _and(absoluteY()); break;
+		case 0x21U: _and(indirectX()); break;
+		case 0x31U: _and(indirectY()); break;
+		// EOR
+		case 0x49U: eor(immediate()); break;
+		case 0x45U: eor(zeroPage()); break;
+		case 0x55U: eor(zeroPageX()); break;
+		case 0x4dU: eor(absolute()); break;
+		case 0x5dU: eor(absoluteX()); break;
+		case 0x59U: eor(absoluteY()); break;
+		case 0x41U: eor(indirectX()); break;
+		case 0x51U: eor(indirectY()); break;
+		// ADC
+		case 0x69U: adc(readByte(immediate())); break;
+		case 0x65U: adc(readByte(zeroPage())); break;
+		case 0x75U: adc(readByte(zeroPageX())); break;
+		case 0x6dU: adc(readByte(absolute())); break;
+		case 0x7dU: adc(readByte(absoluteX())); break;
+		case 0x79U: adc(readByte(absoluteY())); break;
+		case 0x61U: adc(readByte(indirectX())); break;
+		case 0x71U: adc(readByte(indirectY())); break;
+		// SBC (0xeb being the undocumented duplicate)
+		case 0xe9U:
+		case 0xebU: sbc(readByte(immediate())); break;
+		case 0xe5U: sbc(readByte(zeroPage())); break;
+		case 0xf5U: sbc(readByte(zeroPageX())); break;
+		case 0xedU: sbc(readByte(absolute())); break;
+		case 0xfdU: sbc(readByte(absoluteX())); break;
+		case 0xf9U: sbc(readByte(absoluteY())); break;
+		case 0xe1U: sbc(readByte(indirectX())); break;
+		case 0xf1U: sbc(readByte(indirectY())); break;
+		// CMP
+		case 0xc9U: compare(a, readByte(immediate())); break;
+		case 0xc5U: compare(a, readByte(zeroPage())); break;
+		case 0xd5U: compare(a, readByte(zeroPageX())); break;
+		case 0xcdU: compare(a, readByte(absolute())); break;
+		case 0xddU: compare(a, readByte(absoluteX())); break;
+		case 0xd9U: compare(a, readByte(absoluteY())); break;
+		case 0xc1U: compare(a, readByte(indirectX())); break;
+		case 0xd1U: compare(a, readByte(indirectY())); break;
+		// CPX and CPY
+		case 0xe0U: compare(x, readByte(immediate())); break;
+		case 0xe4U: compare(x, readByte(zeroPage())); break;
+		case 0xecU: compare(x, readByte(absolute())); break;
+		case 0xc0U: compare(y, readByte(immediate())); break;
+		case 0xc4U: compare(y, readByte(zeroPage())); break;
+		case 0xccU: compare(y, readByte(absolute())); break;
+		// BIT
+		case 0x24U: bit(zeroPage()); break;
+		case 0x2cU: bit(absolute()); break;
+		// LDA
+		case 0xa9U: load(a, immediate()); break;
+		case 0xa5U: load(a, zeroPage()); break;
+		case 0xb5U: load(a, zeroPageX()); break;
+		case 0xadU: load(a, absolute()); break;
+		case 0xbdU: load(a, absoluteX()); break;
+		case 0xb9U: load(a, absoluteY()); break;
+		case 0xa1U: load(a, indirectX()); break;
+		case 0xb1U: load(a, indirectY()); break;
+		// LDX
+		case 0xa2U: load(x, immediate()); break;
+		case 0xa6U: load(x, zeroPage()); break;
+		case 0xb6U: load(x, zeroPageY()); break;
+		case 0xaeU: load(x, absolute()); break;
+		case 0xbeU: load(x, absoluteY()); break;
+		// LDY
+		case 0xa0U: load(y, immediate()); break;
+		case 0xa4U: load(y, zeroPage()); break;
+		case 0xb4U: load(y, zeroPageX()); break;
+		case 0xacU: load(y, absolute()); break;
+		case 0xbcU: load(y, absoluteX()); break;
+		// STA
+		case 0x85U: writeByte(zeroPage(), a); break;
+		case 0x95U: writeByte(zeroPageX(), a); break;
+		case 0x8dU: writeByte(absolute(), a); break;
+		case 0x9dU: writeByte(absoluteX(), a); break;
+		case 0x99U: writeByte(absoluteY(), a); break;
+		case 0x81U: writeByte(indirectX(), a); break;
+		case 0x91U: writeByte(indirectY(), a); break;
+		// STX and STY
+		case 0x86U: writeByte(zeroPage(), x); break;
+		case 0x96U: writeByte(zeroPageY(), x); break;
+		case 0x8eU: writeByte(absolute(), x); break;
+		case 0x84U: writeByte(zeroPage(), y); break;
+		case 0x94U: writeByte(zeroPageX(), y); break;
+		case 0x8cU: writeByte(absolute(), y); break;
+		// ASL
+		case 0x0aU: a = asl(a); break;
+		case 0x06U: modify(zeroPage(), aslOp); break;
+		case 0x16U: modify(zeroPageX(), aslOp); break;
+		case 0x0eU: modify(absolute(), aslOp); break;
+		case 0x1eU: modify(absoluteX(), aslOp); break;
+		// LSR
+		case 0x4aU: a = lsr(a); break;
+		case 0x46U: modify(zeroPage(), lsrOp); break;
+		case 0x56U: modify(zeroPageX(), lsrOp); break;
+		case 0x4eU: modify(absolute(), lsrOp); break;
+		case 0x5eU: modify(absoluteX(), lsrOp); break;
+		// ROL
+		case 0x2aU: a = rol(a); break;
+		case 0x26U: modify(zeroPage(), rolOp); break;
+		case 0x36U: modify(zeroPageX(), rolOp); break;
+		case 0x2eU: modify(absolute(), rolOp); break;
+		case 0x3eU: modify(absoluteX(), rolOp); break;
+		// ROR
+		case 0x6aU: a = ror(a); break;
+		case 0x66U: modify(zeroPage(), rorOp); break;
+		case 0x76U: modify(zeroPageX(), rorOp); break;
+		case 0x6eU: modify(absolute(), rorOp); break;
+		case 0x7eU: modify(absoluteX(), rorOp); break;
+		// DEC and INC
+		case 0xc6U: modify(zeroPage(), decOp); break;
+		case 0xd6U: modify(zeroPageX(), decOp); break;
+		case 0xceU: modify(absolute(), decOp); break;
+		case 0xdeU: modify(absoluteX(), decOp); break;
+		case 0xe6U: modify(zeroPage(), incOp); break;
+		case 0xf6U: modify(zeroPageX(), incOp); break;
+		case 0xeeU: modify(absolute(), incOp); break;
+		case 0xfeU: modify(absoluteX(), incOp); break;
+		// Register increments, decrements and transfers
+		case 0xcaU: setNZ(--x); break;
+		case 0x88U: setNZ(--y); break;
+		case 0xe8U: setNZ(++x); break;
+		case 0xc8U: setNZ(++y); break;
+		case 0xaaU: setNZ(x = a); break;
+		case 0x8aU: setNZ(a = x); break;
+		case 0xa8U: setNZ(y = a); break;
+		case 0x98U: setNZ(a = y); break;
+		case 0xbaU: setNZ(x = stackPointer); break;
+		case 0x9aU: stackPointer = x; break;
+		// Stack operations
+		case 0x48U: push(a); break;
+		case 0x68U: setNZ(a = pop()); break;
+		case 0x08U: push(packStatus(true)); break;
+		case 0x28U: unpackStatus(pop()); break;
+		// Flag manipulation
+		case 0x18U: carry = false; break;
+		case 0x38U: carry = true; break;
+		case 0x58U: interruptDisable = false; break;
+		case 0x78U: interruptDisable = true; break;
+		case 0xb8U: overflow = false; break;
+		case 0xd8U: decimal = false; break;
+		case 0xf8U: decimal = true; break;
+		// Branches
+		case 0x10U: extraCycles = branch(!negative); break;
+		case 0x30U: extraCycles = branch(negative); break;
+		case 0x50U: extraCycles = branch(!overflow); break;
+		case 0x70U: extraCycles = branch(overflow); break;
+		case 0x90U: extraCycles = branch(!carry); break;
+		case 0xb0U: extraCycles = branch(carry); break;
+		case 0xd0U: extraCycles = branch(!zero); break;
+		case 0xf0U: extraCycles = branch(zero); break;
+		// Jumps, calls and returns
+		case 0x4cU: programCounter = fetchWord(); break;
+		case 0x6cU:
+		{
+			// The pointer's high byte is fetched without carrying into the next page
+			const auto pointer{fetchWord()};
+			const auto pointerHigh{static_cast<uint16_t>((pointer & 0xff00U) | ((pointer + 1U) & 0x00ffU))};
+			programCounter = static_cast<uint16_t>(readByte(pointer) | (readByte(pointerHigh) << 8U));
+			break;
+		}
+		case 0x20U:
+		{
+			const auto target{fetchWord()};
+			const auto returnTo{static_cast<uint16_t>(programCounter - 1U)};
+			push(static_cast<uint8_t>(returnTo >> 8U));
+			push(static_cast<uint8_t>(returnTo));
+			programCounter = target;
+			break;
+		}
+		case 0x60U:
+		{
+			const uint8_t low{pop()};
+			const uint8_t high{pop()};
+			programCounter = static_cast<uint16_t>(((high << 8U) | low) + 1U);
+			checkReturned();
+			break;
+		}
+		case 0x40U:
+		{
+			unpackStatus(pop());
+			const uint8_t low{pop()};
+			const uint8_t high{pop()};
+			programCounter = static_cast<uint16_t>((high << 8U) | low);
+			checkReturned();
+			break;
+		}
+		case 0x00U:
+			// BRK skips a padding byte, which the return address accounts for
+			++programCounter;
+			push(static_cast<uint8_t>(programCounter >> 8U));
+			push(static_cast<uint8_t>(programCounter));
+			push(packStatus(true));
+			interruptDisable = true;
+			programCounter = readWord(mos6502::irqVectorAddress);
+			break;
+		// NOPs, including the undocumented ones that read an operand
+		case 0xeaU:
+		case 0x1aU:
+		case 0x3aU:
+		case 0x5aU:
+		case 0x7aU:
+		case 0xdaU:
+		case 0xfaU:
+			break;
+		case 0x80U:
+		case 0x82U:
+		case 0x89U:
+		case 0xc2U:
+		case 0xe2U:
+			static_cast<void>(immediate());
+			break;
+		case 0x04U:
+		case 0x44U:
+		case 0x64U:
+			static_cast<void>(readByte(zeroPage()));
+			break;
+		case 0x14U:
+		case 0x34U:
+		case 0x54U:
+		case 0x74U:
+		case 0xd4U:
+		case 0xf4U:
+			static_cast<void>(readByte(zeroPageX()));
+			break;
+		case 0x0cU:
+			static_cast<void>(readByte(absolute()));
+			break;
+		case 0x1cU:
+		case 0x3cU:
+		case 0x5cU:
+		case 0x7cU:
+		case 0xdcU:
+		case 0xfcU:
+			static_cast<void>(readByte(absoluteX()));
+			break;
+		// SLO (ASL + ORA)
+		case 0x07U: slo(zeroPage()); break;
+		case 0x17U: slo(zeroPageX()); break;
+		case 0x0fU: slo(absolute()); break;
+		case 0x1fU: slo(absoluteX()); break;
+		case 0x1bU: slo(absoluteY()); break;
+		case 0x03U: slo(indirectX()); break;
+		case 0x13U: slo(indirectY()); break;
+		// RLA (ROL + AND)
+		case 0x27U: rla(zeroPage()); break;
+		case 0x37U: rla(zeroPageX()); break;
+		case 0x2fU: rla(absolute()); break;
+		case 0x3fU: rla(absoluteX()); break;
+		case 0x3bU: rla(absoluteY()); break;
+		case 0x23U: rla(indirectX()); break;
+		case 0x33U: rla(indirectY()); break;
+		// SRE (LSR + EOR)
+		case 0x47U: sre(zeroPage()); break;
+		case 0x57U: sre(zeroPageX()); break;
+		case 0x4fU: sre(absolute()); break;
+		case 0x5fU: sre(absoluteX()); break;
+		case 0x5bU: sre(absoluteY()); break;
+		case 0x43U: sre(indirectX()); break;
+		case 0x53U: sre(indirectY()); break;
+		// RRA (ROR + ADC)
+		case 0x67U: rra(zeroPage()); break;
+		case 0x77U: rra(zeroPageX()); break;
+		case 0x6fU: rra(absolute()); break;
+		case 0x7fU: rra(absoluteX()); break;
+		case 0x7bU: rra(absoluteY()); break;
+		case 0x63U: rra(indirectX()); break;
+		case 0x73U: rra(indirectY()); break;
+		// SAX
+		case 0x87U: writeByte(zeroPage(), a & x); break;
+		case 0x97U: writeByte(zeroPageY(), a & x); break;
+		case 0x8fU: writeByte(absolute(), a & x); break;
+		case 0x83U: writeByte(indirectX(), a & x); break;
+		// LAX
+		case 0xa7U: lax(zeroPage()); break;
+		case 0xb7U: lax(zeroPageY()); break;
+		case 0xafU: lax(absolute()); break;
+		case 0xbfU: lax(absoluteY()); break;
+		case 0xa3U: lax(indirectX()); break;
+		case 0xb3U: lax(indirectY()); break;
+		// DCP (DEC + CMP)
+		case 0xc7U: dcp(zeroPage()); break;
+		case 0xd7U: dcp(zeroPageX()); break;
+		case 0xcfU: dcp(absolute()); break;
+		case 0xdfU: dcp(absoluteX()); break;
+		case 0xdbU: dcp(absoluteY()); break;
+		case 0xc3U: dcp(indirectX()); break;
+		case 0xd3U: dcp(indirectY()); break;
+		// ISC (INC + SBC)
+		case 0xe7U: isc(zeroPage()); break;
+		case 0xf7U: isc(zeroPageX()); break;
+		case 0xefU: isc(absolute()); break;
+		case 0xffU: isc(absoluteX()); break;
+		case 0xfbU: isc(absoluteY()); break;
+		case 0xe3U: isc(indirectX()); break;
+		case 0xf3U: isc(indirectY()); break;
+		// The immediate mode undocumented operations
+		case 0x0bU:
+		case 0x2bU:
+			_and(immediate());
+			carry = negative;
+			break;
+		case 0x4bU:
+			_and(immediate());
+			a = lsr(a);
+			break;
+		case 0x6bU:
+			_and(immediate());
+			a = static_cast<uint8_t>((a >> 1U) | (carry ? 0x80U : 0U));
+			setNZ(a);
+			carry = a & 0x40U;
+			overflow = ((a >> 6U) ^ (a >> 5U)) & 1U;
+			break;
+		case 0xcbU:
+		{
+			const auto value{readByte(immediate())};
+			const auto masked{static_cast<uint8_t>(a & x)};
+			carry = masked >= value;
+			setNZ(x = static_cast<uint8_t>(masked - value));
+			break;
+		}
+		case 0x8bU:
+			a = static_cast<uint8_t>((a | 0xeeU) & x & readByte(immediate()));
+			setNZ(a);
+			break;
+		case 0xabU:
+			a = x = static_cast<uint8_t>((a | 0xeeU) & readByte(immediate()));
+			setNZ(a);
+			break;
+		case 0xbbU:
+			a = x = stackPointer = readByte(absoluteY()) & stackPointer;
+			setNZ(a);
+			break;
+		// The unstable stores
+		case 0x93U: storeHigh(indirectY(), a & x); break;
+		case 0x9fU: storeHigh(absoluteY(), a & x); break;
+		case 0x9eU: storeHigh(absoluteY(), x); break;
+		case 0x9cU: storeHigh(absoluteX(), y); break;
+		case 0x9bU:
+			stackPointer = a & x;
+			storeHigh(absoluteY(), stackPointer);
+			break;
+		// Anything else is one of the JAMs, which lock the CPU up
+		default:
+			--programCounter;
+			return {false, 0U};
+	}
+
+	const auto penalty{pageCrossPenalty[opcode] && pageCrossed ? 1U : 0U};
+	return {true, static_cast<uint8_t>(cycleCounts[opcode] + extraCycles + penalty)};
+}
+
+bool mos6502_t::advanceClock() noexcept
+{
+	// Check to see if this cycle we should actually run the core, or just fake it
+	if (waitCycles == 0U)
+	{
+		if (idle && !hasPendingInterrupts())
+			return true;
+		// We should actually run the core, okay.. let's run an instruction then
+		const auto result{step()};
+		// Unpack how many cycles the instruction took and skip one of them for this cycle
+		waitCycles = result.cyclesTaken;
+		if (waitCycles)
+			--waitCycles;
+		return result.validInsn;
+	}
+	// We should not actually do anything, waste a cycle and get done
+	--waitCycles;
+	return true;
+}
+
+void mos6502_t::displayRegs() const noexcept
+{
+	console.debug
+	(
+		"  a: "sv, asHex_t<2U, '0'>{a}, "  x: "sv, asHex_t<2U, '0'>{x}, "  y: "sv, asHex_t<2U, '0'>{y},
+		"  sp: "sv, asHex_t<2U, '0'>{stackPointer}, "  pc: "sv, asHex_t<4U, '0'>{programCounter},
+		"  p: "sv, asHex_t<2U, '0'>{packStatus(false)}
+	);
+}
@@ -0,0 +1,154 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef EMULATOR_CPU_MOS6502_HXX
+#define EMULATOR_CPU_MOS6502_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <vector>
+#include "../memoryMap.hxx"
+
+// The 6502 has a 16-bit address bus, but we use a 32-bit address value so ranges may end at the top of memory
+using mos6502MemoryMap_t = memoryMap_t<uint32_t, 0x0000ffffU>;
+
+namespace mos6502
+{
+	struct stepResult_t final
+	{
+		bool validInsn;
+		uint8_t cyclesTaken;
+	};
+
+	// Something able to pull the (level triggered) IRQ or (edge triggered) NMI line of the CPU low
+	struct irqRequester_t
+	{
+	protected:
+		irqRequester_t() noexcept = default;
+		~irqRequester_t() noexcept = default;
+
+	public:
+		irqRequester_t(const irqRequester_t &) = delete;
+		irqRequester_t(irqRequester_t &&) = delete;
+		irqRequester_t &operator =(const irqRequester_t &) = delete;
+		irqRequester_t &operator =(irqRequester_t &&) = delete;
+
+		[[nodiscard]] virtual bool irqAsserted() const noexcept = 0;
+	};
+
+	constexpr static uint16_t nmiVectorAddress{0xfffaU};
+	constexpr static uint16_t resetVectorAddress{0xfffcU};
+	constexpr static uint16_t irqVectorAddress{0xfffeU};
+} // namespace mos6502
+
+/*
+ * An NMOS 6502 (as found in the 6510 of the C64), including the stable undocumented opcodes that
+ * music routines are fond of. Rather than running from reset, the core is driven a subroutine at a time:
+ * call() sets up a return into a sentinel address, and when the matching RTS lands there the CPU goes
+ * idle until the next call or an interrupt.
+ */
+struct mos6502_t final
+{
+private:
+	mos6502MemoryMap_t &_peripherals;
+	std::vector<mos6502::irqRequester_t *> irqRequesters{};
+	std::vector<mos6502::irqRequester_t *> nmiRequesters{};
+	uint32_t waitCycles{0U};
+
+	uint8_t a{0U};
+	uint8_t x{0U};
+	uint8_t y{0U};
+	uint8_t stackPointer{0xffU};
+	uint16_t programCounter{0U};
+	bool carry{false};
+	bool zero{false};
+	bool interruptDisable{true};
+	bool decimal{false};
+	bool overflow{false};
+	bool negative{false};
+
+	// Where the CPU idles between calls, and the stack pointer it has while doing so
+	bool idle{true};
+	uint8_t idleStackPointer{0xffU};
+	bool nmiLine{false};
+	bool nmiPending{false};
+	// Set when an addressing mode crossed a page boundary, for the instructions that take a cycle to fix that up
+	bool pageCrossed{false};
+
+	[[nodiscard]] uint8_t readByte(const uint16_t address) const noexcept
+		{ return _peripherals.readAddress<uint8_t>(address); }
+	void writeByte(const uint16_t address, const uint8_t value) noexcept
+		{ _peripherals.writeAddress(address, value); }
+	[[nodiscard]] uint16_t readWord(uint16_t address) const noexcept;
+	[[nodiscard]] uint16_t readWordZeroPage(uint8_t address) const noexcept;
+	[[nodiscard]] uint8_t fetchByte() noexcept { return readByte(programCounter++); }
+	[[nodiscard]] uint16_t fetchWord() noexcept;
+	void push(uint8_t value) noexcept;
+	[[nodiscard]] uint8_t pop() noexcept;
+
+	// Addressing modes, each returning the effective address of the operand
+	[[nodiscard]] uint16_t immediate() noexcept { return programCounter++; }
+	[[nodiscard]] uint16_t zeroPage() noexcept { return fetchByte(); }
+	[[nodiscard]] uint16_t zeroPageX() noexcept { return uint8_t(fetchByte() + x); }
+	[[nodiscard]] uint16_t zeroPageY() noexcept { return uint8_t(fetchByte() + y); }
+	[[nodiscard]] uint16_t absolute() noexcept { return fetchWord(); }
+	[[nodiscard]] uint16_t absoluteX() noexcept;
+	[[nodiscard]] uint16_t absoluteY() noexcept;
+	[[nodiscard]] uint16_t indirectX() noexcept;
+	[[nodiscard]] uint16_t indirectY() noexcept;
+
+	[[nodiscard]] uint8_t packStatus(bool breakFlag) const noexcept;
+	void unpackStatus(uint8_t status) noexcept;
+	void setNZ(const uint8_t value) noexcept
+	{
+		zero = value == 0U;
+		negative = value & 0x80U;
+	}
+
+	void adc(uint8_t value) noexcept;
+	void sbc(uint8_t value) noexcept;
+	void compare(uint8_t lhs, uint8_t rhs) noexcept;
+	[[nodiscard]] uint8_t asl(uint8_t value) noexcept;
+	[[nodiscard]] uint8_t lsr(uint8_t value) noexcept;
+	[[nodiscard]] uint8_t rol(uint8_t value) noexcept;
+	[[nodiscard]] uint8_t ror(uint8_t value) noexcept;
+	[[nodiscard]] uint8_t branch(bool condition) noexcept;
+	void serviceInterrupt(uint16_t vectorAddress) noexcept;
+	void checkReturned() noexcept;
+	[[nodiscard]] bool irqAsserted() const noexcept;
+	[[nodiscard]] mos6502::stepResult_t dispatch(uint8_t opcode) noexcept;
+
+public:
+	mos6502_t(mos6502MemoryMap_t &peripherals) noexcept;
+
+	// Begins running the subroutine at entryAddress, with interrupts disabled as if called from an IRQ handler
+	void call(uint16_t entryAddress) noexcept;
+	// Runs the subroutine at entryAddress to completion, failing if it runs for more than cycleLimit cycles
+	[[nodiscard]] bool executeToReturn(uint16_t entryAddress, uint32_t cycleLimit) noexcept;
+	void registerInterruptRequester(mos6502::irqRequester_t &requester) noexcept;
+	void registerNMIRequester(mos6502::irqRequester_t &requester) noexcept;
+	[[nodiscard]] bool hasPendingInterrupts() const noexcept;
+	// Whether the CPU has work to do - either it's inside a call or is finishing off its last instruction
+	[[nodiscard]] bool running() const noexcept { return !idle || waitCycles != 0U; }
+
+	[[nodiscard]] uint8_t readAccumulator() const noexcept { return a; }
+	void writeAccumulator(const uint8_t value) noexcept { a = value; }
+	[[nodiscard]] uint8_t readIndexX() const noexcept { return x; }
+	void writeIndexX(const uint8_t value) noexcept { x = value; }
+	[[nodiscard]] uint8_t readIndexY() const noexcept { return y; }
+	void writeIndexY(const uint8_t value) noexcept { y = value; }
+	[[nodiscard]] uint8_t readStackPointer() const noexcept { return stackPointer; }
+	[[nodiscard]] uint16_t readProgramCounter() const noexcept { return programCounter; }
+	[[nodiscard]] uint8_t readStatus() const noexcept { return packStatus(false); }
+	void writeStatus(const uint8_t value) noexcept { unpackStatus(value); }
+
+	[[nodiscard]] mos6502::stepResult_t step() noexcept;
+	[[nodiscard]] bool advanceClock() noexcept;
+	// How many clock cycles it is until (and including) the one on which the next instruction runs
+	[[nodiscard]] uint32_t cyclesUntilStep() const noexcept { return waitCycles + 1U; }
+	// Skip clock cycles the current instruction is still taking, which must be fewer than cyclesUntilStep()
+	void skipCycles(const uint32_t cycles) noexcept { waitCycles -= cycles; }
+
+	void displayRegs() const noexcept;
+};
+
+#endif /*EMULATOR_CPU_MOS6502_HXX*/
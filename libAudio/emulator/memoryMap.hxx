@@ -3,9 +3,13 @@
 #ifndef EMULATOR_MEMORY_MAP_HXX
 #define EMULATOR_MEMORY_MAP_HXX
 
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
 #include <memory>
-#include <unordered_map>
+#include <vector>
 #include <limits>
+#include <type_traits>
 #include <substrate/span>
 #include <substrate/buffer_utils>
 
@@ -39,17 +43,6 @@ public:
 		{ return _begin == other._begin && _end == other._end; }
 };
 
-namespace std
-{
-	template<typename address_t> struct hash<memoryRange_t<address_t>>
-	{
-		size_t operator ()(const memoryRange_t<address_t> &range) const noexcept
-		{
-			return static_cast<size_t>(range.begin());
-		}
-	};
-}
-
 // A generic clockless peripheral
 template<typename address_t> struct peripheral_t
 {
@@ -67,6 +60,9 @@ public:
 
 	virtual void readAddress(address_t address, substrate::span<uint8_t> data) const noexcept = 0;
 	virtual void writeAddress(address_t address, const substrate::span<uint8_t> &data) noexcept = 0;
+
+	// Peripherals that are plain memory can expose it here so the memory map may access it directly
+	[[nodiscard]] virtual substrate::span<uint8_t> directMemory() noexcept { return {}; }
 };
 
 // A peripheral that requires clocking at some frequency
@@ -89,65 +85,186 @@ public:
 
 	[[nodiscard]] uint32_t clockFrequency() const noexcept { return _clockFrequency; }
 	[[nodiscard]] virtual bool clockCycle() noexcept = 0;
+
+	// Returns how many clock cycles it will be until (and including) the next one in which the peripheral does
+	// something visible outside itself, such as raising an interrupt - UINT32_MAX if it has nothing pending
+	[[nodiscard]] virtual uint32_t cyclesUntilEvent() const noexcept { return 1U; }
+
+	// Runs a number of clock cycles in one go, which must all be before the next event cycle
+	[[nodiscard]] virtual bool clockCycles(const uint32_t cycles) noexcept
+	{
+		for (uint32_t cycle{0U}; cycle < cycles; ++cycle)
+		{
+			if (!clockCycle())
+				return false;
+		}
+		return true;
+	}
 };
 
+/*
+ * Decodes addresses to the peripherals mapped at them using a page table, so that finding the peripheral
+ * for an access takes constant time no matter how many are mapped. Each page records the one mapping that
+ * covers it, or that several do - in which case the (short) list of mappings gets searched. Peripherals
+ * that expose their backing memory via directMemory() are then read and written without going through
+ * their virtual accessors at all. Every page also counts the writes made to it, which lets anything caching
+ * what it read from a page (such as decoded instructions) cheaply check that its copy is still current.
+ */
 template<typename address_t, address_t validAddressMask = std::numeric_limits<address_t>::max()> struct memoryMap_t
 {
+private:
+	struct mapping_t final
+	{
+		memoryRange_t<address_t> range;
+		std::unique_ptr<peripheral_t<address_t>> peripheral;
+		uint8_t *memory;
+		size_t memoryLength;
+
+		mapping_t(const memoryRange_t<address_t> mappedRange, std::unique_ptr<peripheral_t<address_t>> &&device) noexcept :
+			range{mappedRange}, peripheral{std::move(device)}, memory{nullptr}, memoryLength{0U}
+		{
+			const auto directMemory{peripheral->directMemory()};
+			memory = directMemory.data();
+			// Only allow direct access to the part of the memory that's actually mapped
+			memoryLength = std::min<size_t>(directMemory.size(), range.end() - range.begin());
+		}
+	};
+
+	constexpr static size_t addressBits{[]() noexcept
+	{
+		size_t bits{0U};
+		for (auto mask{validAddressMask}; mask; mask >>= 1U)
+			++bits;
+		return bits;
+	}()};
+	// Use 256 byte pages for buses up to 24 bits wide, and at most 64Ki pages for wider ones
+	constexpr static size_t pageShift{addressBits > 24U ? addressBits - 16U : 8U};
+	constexpr static size_t pageCount{(static_cast<size_t>(validAddressMask) >> pageShift) + 1U};
+
+	// Page table entries are 1 + the index of the mapping covering the page, or one of these two
+	constexpr static uint16_t unmappedPage{0U};
+	constexpr static uint16_t sharedPage{UINT16_MAX};
+
+	std::vector<mapping_t> mappings{};
+	std::unique_ptr<uint16_t []> pages{std::make_unique<uint16_t []>(pageCount)};
+	std::unique_ptr<uint32_t []> pageWrites{std::make_unique<uint32_t []>(pageCount)};
+
+	[[nodiscard]] const mapping_t *lookup(const address_t address) const noexcept
+	{
+		const auto page{pages[address >> pageShift]};
+		if (page == unmappedPage)
+			return nullptr;
+		if (page != sharedPage)
+		{
+			const auto &mapping{mappings[page - 1U]};
+			return mapping.range.inRange(address) ? &mapping : nullptr;
+		}
+		// Several peripherals share this page, so look for the one that maps the address
+		for (const auto &mapping : mappings)
+		{
+			if (mapping.range.inRange(address))
+				return &mapping;
+		}
+		return nullptr;
+	}
+
 protected:
-	// Use 16 buckets at minimum.
-	std::unordered_map<memoryRange_t<address_t>, std::unique_ptr<peripheral_t<address_t>>> addressMap{16U};
+	/*
+	 * Maps a peripheral into the address space over the given range, returning a reference to it for further
+	 * use. Ranges must not overlap any peripheral that's already mapped. Throws if the mapping can't be allocated.
+	 */
+	template<typename peripheralT> peripheralT &mapPeripheral(const memoryRange_t<address_t> range,
+		std::unique_ptr<peripheralT> peripheral)
+	{
+		auto &device{*peripheral};
+		mappings.emplace_back(range, std::move(peripheral));
+		const auto mappingIndex{static_cast<uint16_t>(mappings.size())};
+		// Mark all the pages the range touches as belonging to this mapping, or shared if already taken
+		const auto firstPage{static_cast<size_t>(range.begin() & validAddressMask) >> pageShift};
+		const auto lastPage{static_cast<size_t>((range.end() - 1U) & validAddressMask) >> pageShift};
+		for (size_t page{firstPage}; page <= lastPage; ++page)
+			pages[page] = pages[page] == unmappedPage ? mappingIndex : sharedPage;
+		return device;
+	}
 
 public:
+	// Returns the number of writes made to the page containing the given address so far
+	[[nodiscard]] uint32_t writeGeneration(const address_t address) const noexcept
+		{ return pageWrites[static_cast<size_t>(address & validAddressMask) >> pageShift]; }
+
 	template<typename value_t> value_t readAddress(const address_t address) const noexcept
 	{
-		const auto adjustedAddres{address & validAddressMask};
+		const auto adjustedAddress{static_cast<address_t>(address & validAddressMask)};
 		// Try to find a peripheral mapped for the address
-		for (const auto &[mapping, peripheral] : addressMap)
+		const auto *const mapping{lookup(adjustedAddress)};
+		// If we couldn't find the address in any known peripheral, synthesise a value
+		if (!mapping)
+			return {};
+
+		// Convert the address to a relative one
+		const auto relativeAddress{mapping->range.relative(adjustedAddress)};
+		// If the peripheral is plain memory and the access fits inside it, assemble the value straight from it
+		if (mapping->memory && relativeAddress < mapping->memoryLength &&
+			sizeof(value_t) <= mapping->memoryLength - relativeAddress)
 		{
-			// If the peripheral's mapping contains this address
-			if (mapping.inRange(adjustedAddres))
-			{
-				// Convert the address to a relative one
-				const auto relativeAddress{mapping.relative(adjustedAddres)};
-				std::array<uint8_t, sizeof(value_t)> value{};
-				// Read the data associated with that address in the peripheral
-				peripheral->readAddress(relativeAddress, value);
-
-				// Now we have data, convert it endian-appropriately to a value_t
-				if constexpr (sizeof(value_t) == 1U)
-					return static_cast<value_t>(value[0]);
-				else
-					return readBE<value_t>(value);
-			}
+			std::make_unsigned_t<value_t> value{};
+			for (size_t offset{0U}; offset < sizeof(value_t); ++offset)
+				value = static_cast<decltype(value)>((value << 8U) | mapping->memory[relativeAddress + offset]);
+			return static_cast<value_t>(value);
 		}
 
-		// If we couldn't find the address in any known peripheral, synthesise a value
-		return {};
+		std::array<uint8_t, sizeof(value_t)> value{};
+		// Read the data associated with that address in the peripheral
+		mapping->peripheral->readAddress(relativeAddress, value);
+
+		// Now we have data, convert it endian-appropriately to a value_t
+		if constexpr (sizeof(value_t) == 1U)
+			return static_cast<value_t>(value[0]);
+		else
+			return readBE<value_t>(value);
 	}
 
 	template<typename value_t> void writeAddress(const address_t address, const value_t data) noexcept
 	{
-		const auto adjustedAddres{address & validAddressMask};
+		const auto adjustedAddress{static_cast<address_t>(address & validAddressMask)};
+		// Mark the page(s) the write touches as having been written to
+		++pageWrites[static_cast<size_t>(adjustedAddress) >> pageShift];
+		if constexpr (sizeof(value_t) > 1U)
+		{
+			const auto lastAddress{static_cast<size_t>((adjustedAddress + sizeof(value_t) - 1U) & validAddressMask)};
+			const auto lastPage{lastAddress >> pageShift};
+			if (lastPage != static_cast<size_t>(adjustedAddress) >> pageShift)
+				++pageWrites[lastPage];
+		}
 		// Try to find a peripheral to write the value to
-		for (auto &[mapping, peripheral] : addressMap)
+		const auto *const mapping{lookup(adjustedAddress)};
+		if (!mapping)
+			return;
+
+		// Convert the address to a relative one
+		const auto relativeAddress{mapping->range.relative(adjustedAddress)};
+		// If the peripheral is plain memory and the access fits inside it, store the value straight into it
+		if (mapping->memory && relativeAddress < mapping->memoryLength &&
+			sizeof(value_t) <= mapping->memoryLength - relativeAddress)
 		{
-			// If the peripheral's mapping contains this address
-			if (mapping.inRange(adjustedAddres))
+			auto value{static_cast<std::make_unsigned_t<value_t>>(data)};
+			for (size_t offset{sizeof(value_t)}; offset-- > 0U; )
 			{
-				// Convert the address to a relative one
-				const auto relativeAddress{mapping.relative(adjustedAddres)};
-				std::array<uint8_t, sizeof(value_t)> value{};
-				// Convert the data to write in an endian-appropriate manner from a value_t
-				if constexpr (sizeof(value_t) == 1U)
-					value[0] = static_cast<uint8_t>(data);
-				else
-					writeBE(data, value);
-
-				// Now write the data to the peripheral and get done
-				peripheral->writeAddress(relativeAddress, value);
-				break;
+				mapping->memory[relativeAddress + offset] = static_cast<uint8_t>(value);
+				value = static_cast<decltype(value)>(value >> 8U);
 			}
+			return;
 		}
+
+		std::array<uint8_t, sizeof(value_t)> value{};
+		// Convert the data to write in an endian-appropriate manner from a value_t
+		if constexpr (sizeof(value_t) == 1U)
+			value[0] = static_cast<uint8_t>(data);
+		else
+			writeBE(data, value);
+
+		// Now write the data to the peripheral and get done
+		mapping->peripheral->writeAddress(relativeAddress, value);
 	}
 };
 
@@ -165,6 +282,10 @@ public:
 	clockManager_t(uint32_t baseClockFrequency, uint32_t targetClockFrequency) noexcept;
 	// Returns true if the clock being managed by this should advance a cycle, false otherwise
 	bool advanceCycle() noexcept;
+	// Returns how many base clock cycles it will take for the target clock to advance the given number of cycles
+	[[nodiscard]] uint32_t cyclesUntil(uint32_t targetCycles) const noexcept;
+	// Advances the given number of base clock cycles in one go, returning how many target clock cycles that made
+	uint32_t advanceCycles(uint32_t cycles) noexcept;
 };
 
 #endif /*EMULATOR_MEMORY_MAP_HXX*/
@@ -35,6 +35,8 @@ public:
 	ram_t &operator =(ram_t &&) = default;
 	~ram_t() noexcept override = default;
 
+	[[nodiscard]] substrate::span<uint8_t> directMemory() noexcept override { return memory; }
+
 	substrate::span<uint8_t> subspan(const size_t offset = 0U, const size_t length = SIZE_MAX) noexcept
 		{ return substrate::span{memory}.subspan(offset, length); }
 };
@@ -0,0 +1,461 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <substrate/span>
+#include <substrate/indexed_iterator>
+#include "mos6581.hxx"
+
+using mos6581::voice_t;
+using mos6581::envelopeState_t;
+
+constexpr static float pi{3.14159265358979F};
+
+// The level the waveform DAC outputs for silence, and the offset the voice DACs add to their output
+constexpr static int32_t waveZero6581{0x380};
+constexpr static int32_t waveZero8580{0x800};
+constexpr static int32_t voiceDC6581{0x800 * 0xff};
+// The DC level the 6581's mixer adds, which is what makes writing samples to the volume register work
+constexpr static float mixerDC6581{-(0xfff * 0xff) / 18.0F};
+// Scale the output so 3 voices at full amplitude and volume use the full sample range
+constexpr static float outputScale{65535.0F / (3.0F * 0xfff * 0xff * 15.0F)};
+
+mos6581_t::mos6581_t(const uint32_t clockFrequency, const uint32_t sampleFrequency,
+	const sidModel_t chipModel) noexcept : clockedPeripheral_t<uint32_t>{clockFrequency}, model{chipModel},
+	dcBlockCoefficient{1.0F - (2.0F * pi * 20.0F / static_cast<float>(sampleFrequency))},
+	sampleRate{sampleFrequency}, clockManager{clockFrequency, sampleFrequency},
+	samplePeriod{clockManager.cyclesUntil(1U)}
+	{ updateFilter(); }
+
+void mos6581_t::readAddress(const uint32_t address, substrate::span<uint8_t> data) const noexcept
+{
+	for (auto [idx, value] : substrate::indexedIterator_t{data})
+	{
+		// The 32 registers repeat through the whole of the chip's address range
+		switch ((address + idx) & 0x1fU)
+		{
+			// Paddle inputs, with nothing attached
+			case 0x19U:
+			case 0x1aU:
+				value = 0xffU;
+				break;
+			// The upper bits of voice 3's waveform generator
+			case 0x1bU:
+				value = static_cast<uint8_t>(voices[2].waveform(voices[1]) >> 4U);
+				break;
+			// Voice 3's envelope level
+			case 0x1cU:
+				value = voices[2].envelope.level();
+				break;
+			// Everything else is write-only
+			default:
+				value = 0U;
+		}
+	}
+}
+
+void mos6581_t::writeAddress(const uint32_t address, const substrate::span<uint8_t> &data) noexcept
+{
+	// The cycles up to this write ran with the old register values, so get the voices through them first
+	catchUpVoices();
+	for (const auto &[idx, value] : substrate::indexedIterator_t{data})
+	{
+		const auto reg{(address + idx) & 0x1fU};
+		// The first 21 registers are 7 per voice
+		if (reg < 0x15U)
+		{
+			auto &voice{voices[reg / 7U]};
+			switch (reg % 7U)
+			{
+				case 0U:
+					voice.frequency = static_cast<uint16_t>((voice.frequency & 0xff00U) | value);
+					break;
+				case 1U:
+					voice.frequency = static_cast<uint16_t>((voice.frequency & 0x00ffU) | (value << 8U));
+					break;
+				case 2U:
+					voice.pulseWidth = static_cast<uint16_t>((voice.pulseWidth & 0x0f00U) | value);
+					break;
+				case 3U:
+					// Only the bottom 4 bits of the pulse width's upper half exist
+					voice.pulseWidth = static_cast<uint16_t>((voice.pulseWidth & 0x00ffU) | ((value & 0x0fU) << 8U));
+					break;
+				case 4U:
+					voice.writeControl(value);
+					break;
+				case 5U:
+					voice.envelope.writeAttackDecay(value);
+					break;
+				case 6U:
+					voice.envelope.writeSustainRelease(value);
+					break;
+			}
+			continue;
+		}
+		switch (reg)
+		{
+			case 0x15U:
+				// Only the bottom 3 bits of the cutoff's lower half exist
+				filterCutoff = static_cast<uint16_t>((filterCutoff & 0x7f8U) | (value & 0x07U));
+				updateFilter();
+				break;
+			case 0x16U:
+				filterCutoff = static_cast<uint16_t>((filterCutoff & 0x007U) | (value << 3U));
+				updateFilter();
+				break;
+			case 0x17U:
+				filterResonance = value >> 4U;
+				filterRouting = value & 0x0fU;
+				updateFilter();
+				break;
+			case 0x18U:
+				modeVolume = value;
+				break;
+		}
+	}
+}
+
+void mos6581_t::updateFilter() noexcept
+{
+	const auto cutoff{static_cast<float>(filterCutoff)};
+	// Work out the cutoff frequency in Hz - the 8580's is (near enough) linear in the register value, while
+	// the 6581's is a curve that flattens off at the bottom and jumps down part way through its range
+	const auto frequency
+	{
+		[&]() noexcept -> float
+		{
+			if (model == sidModel_t::mos8580)
+				return 30.0F + (cutoff * 12500.0F / 2048.0F);
+			if (filterCutoff < 1024U)
+				return 220.0F + (cutoff * 2.2F);
+			return 2000.0F + ((cutoff - 1024.0F) * 9.5F);
+		}()
+	};
+	// The filter is run twice per sample to keep it stable up at the top of the cutoff range
+	const auto nyquistLimit{static_cast<float>(sampleRate) * 0.9F};
+	filterFrequency = 2.0F * std::sin(pi * std::min(frequency, nyquistLimit) / (2.0F * static_cast<float>(sampleRate)));
+	filterDamping = 1.414F - (0.0733F * static_cast<float>(filterResonance));
+}
+
+void mos6581_t::advanceVoices(const uint32_t cycles) noexcept
+{
+	std::array<uint32_t, 3U> totals{};
+	for (const auto &[idx, voice] : substrate::indexedIterator_t{voices})
+		totals[idx] = voice.advance(cycles);
+
+	// Hard sync resets a voice's oscillator each time the previous voice's MSB goes high
+	for (const auto &[idx, voice] : substrate::indexedIterator_t{voices})
+	{
+		const auto &source{voices[(idx + 2U) % 3U]};
+		if (!(voice.control & 0x02U) || (source.control & 0x08U))
+			continue;
+		const auto total{totals[(idx + 2U) % 3U]};
+		const auto previous{total - (uint32_t{source.frequency} * cycles)};
+		// MSB rising edges happen as the accumulator passes odd multiples of 0x800000
+		const auto edges{((total + 0x800000U) >> 24U) - ((previous + 0x800000U) >> 24U)};
+		if (!edges)
+			continue;
+		// Work out how long ago the last one was, and where this voice will have got to since
+		const auto lastEdge{(((total + 0x800000U) >> 24U) << 24U) - 0x800000U};
+		const auto cyclesSince{(total - lastEdge) / source.frequency};
+		voice.accumulator = (uint32_t{voice.frequency} * cyclesSince) & 0xffffffU;
+	}
+
+	for (auto &voice : voices)
+		voice.envelope.clockCycles(cycles);
+}
+
+void mos6581_t::catchUpVoices() noexcept
+{
+	if (sampleCycles == voiceCycles)
+		return;
+	advanceVoices(sampleCycles - voiceCycles);
+	voiceCycles = sampleCycles;
+}
+
+int16_t mos6581_t::generateSample() noexcept
+{
+	const auto waveZero{model == sidModel_t::mos6581 ? waveZero6581 : waveZero8580};
+	const auto voiceDC{model == sidModel_t::mos6581 ? voiceDC6581 : 0};
+
+	float filterInput{0.0F};
+	float directOutput{model == sidModel_t::mos6581 ? mixerDC6581 : 0.0F};
+	for (const auto &[idx, voice] : substrate::indexedIterator_t{voices})
+	{
+		const auto wave{static_cast<int32_t>(voice.waveform(voices[(idx + 2U) % 3U]))};
+		const auto level{static_cast<float>(((wave - waveZero) * voice.envelope.level()) + voiceDC)};
+		if (filterRouting & (1U << idx))
+			filterInput += level;
+		// The 3OFF bit disconnects voice 3 from the output, unless it's routed through the filter
+		else if (idx != 2U || !(modeVolume & 0x80U))
+			directOutput += level;
+	}
+
+	// Run the state variable filter over the filtered voices
+	for (size_t iteration{0U}; iteration < 2U; ++iteration)
+	{
+		const auto highPass{filterInput - filterLowPass - (filterDamping * filterBandPass)};
+		filterBandPass += filterFrequency * highPass;
+		filterLowPass += filterFrequency * filterBandPass;
+		if (iteration == 1U)
+		{
+			if (modeVolume & 0x10U)
+				directOutput += filterLowPass;
+			if (modeVolume & 0x20U)
+				directOutput += filterBandPass;
+			if (modeVolume & 0x40U)
+				directOutput += highPass;
+		}
+	}
+
+	// Apply the master volume, then pull the result back to being centred on 0
+	const auto mixed{directOutput * static_cast<float>(modeVolume & 0x0fU)};
+	dcOutput = mixed - dcInput + (dcBlockCoefficient * dcOutput);
+	dcInput = mixed;
+	const auto sample{std::lround(dcOutput * outputScale)};
+	return static_cast<int16_t>(std::clamp<long>(sample, INT16_MIN, INT16_MAX));
+}
+
+bool mos6581_t::clockCycle() noexcept
+	{ return clockCycles(1U); }
+
+uint32_t mos6581_t::cyclesUntilEvent() const noexcept
+	{ return cyclesUntilFull; }
+
+bool mos6581_t::clockCycles(const uint32_t cycles) noexcept
+{
+	// The only event is the output buffer filling up, which these cycles are all before
+	if (cyclesUntilFull != UINT32_MAX)
+		cyclesUntilFull -= cycles;
+	auto remaining{cycles};
+	while (true)
+	{
+		// If the next sample isn't due in this block of cycles, just note how far through its period we now are
+		const auto untilSample{samplePeriod - sampleCycles};
+		if (untilSample > remaining)
+		{
+			sampleCycles += remaining;
+			break;
+		}
+		remaining -= untilSample;
+		sampleCycles = samplePeriod;
+		catchUpVoices();
+
+		const auto sample{generateSample()};
+		if (outputPosition < output.size())
+			output[outputPosition++] = sample;
+		// Having generated a sample, start the next sample period
+		static_cast<void>(clockManager.advanceCycles(samplePeriod));
+		samplePeriod = clockManager.cyclesUntil(1U);
+		sampleCycles = 0U;
+		voiceCycles = 0U;
+	}
+	if (outputFull())
+		cyclesUntilFull = UINT32_MAX;
+	return true;
+}
+
+void mos6581_t::outputTo(const substrate::span<int16_t> buffer) noexcept
+{
+	output = buffer;
+	outputPosition = 0U;
+	// Work out which cycle will generate the last sample the buffer has space for
+	if (outputFull())
+		cyclesUntilFull = UINT32_MAX;
+	else
+		cyclesUntilFull = clockManager.cyclesUntil(static_cast<uint32_t>(output.size())) - sampleCycles;
+}
+
+namespace mos6581
+{
+	// How many cycles pass between steps of the envelope counter for each of the rate settings
+	constexpr static std::array<uint16_t, 16U> ratePeriods
+	{{
+		9U, 32U, 63U, 95U, 149U, 220U, 267U, 313U, 392U, 977U, 1954U, 3126U, 3907U, 11720U, 19532U, 31251U
+	}};
+
+	void voice_t::writeControl(const uint8_t value) noexcept
+	{
+		// Changes to the gate bit start the attack or release phases of the envelope
+		if ((value ^ control) & 0x01U)
+			envelope.gate(value & 0x01U);
+		// The test bit holds the oscillator and noise generator in reset
+		if (value & 0x08U)
+		{
+			accumulator = 0U;
+			noiseLFSR = 0x7fffffU;
+		}
+		control = value;
+	}
+
+	uint32_t voice_t::advance(const uint32_t cycles) noexcept
+	{
+		if (control & 0x08U)
+			return 0U;
+		const auto total{accumulator + (uint32_t{frequency} * cycles)};
+		// The noise generator is clocked each time bit 19 of the accumulator goes high
+		clockNoise(((total + 0x80000U) >> 20U) - ((accumulator + 0x80000U) >> 20U));
+		accumulator = total & 0xffffffU;
+		return total;
+	}
+
+	void voice_t::clockNoise(const uint32_t clocks) noexcept
+	{
+		for (uint32_t clock{0U}; clock < clocks; ++clock)
+		{
+			const auto feedback{((noiseLFSR >> 22U) ^ (noiseLFSR >> 17U)) & 1U};
+			noiseLFSR = ((noiseLFSR << 1U) | feedback) & 0x7fffffU;
+		}
+	}
+
+	uint16_t voice_t::waveform(const voice_t &ringSource) const noexcept
+	{
+		const auto selection{control >> 4U};
+		if (!selection)
+			return 0U;
+		// Selecting multiple waveforms at once combines them, which is approximated by ANDing them together
+		uint32_t result{0xfffU};
+		if (selection & 0x1U)
+		{
+			// Ring modulation replaces the triangle's MSB with it XOR'd with the source oscillator's
+			const auto msb{(control & 0x04U ? accumulator ^ ringSource.accumulator : accumulator) & 0x800000U};
+			result &= ((msb ? ~accumulator : accumulator) >> 11U) & 0xfffU;
+		}
+		if (selection & 0x2U)
+			result &= accumulator >> 12U;
+		if (selection & 0x4U)
+			result &= (control & 0x08U) || (accumulator >> 12U) >= pulseWidth ? 0xfffU : 0x000U;
+		if (selection & 0x8U)
+		{
+			result &= ((noiseLFSR >> 9U) & 0x800U) | ((noiseLFSR >> 8U) & 0x400U) | ((noiseLFSR >> 5U) & 0x200U) |
+				((noiseLFSR >> 3U) & 0x100U) | ((noiseLFSR >> 2U) & 0x080U) | ((noiseLFSR << 1U) & 0x040U) |
+				((noiseLFSR << 3U) & 0x020U) | ((noiseLFSR << 4U) & 0x010U);
+		}
+		return static_cast<uint16_t>(result);
+	}
+
+	void envelope_t::updateRatePeriod() noexcept
+	{
+		switch (state)
+		{
+			case envelopeState_t::attack:
+				ratePeriod = ratePeriods[attackDecay >> 4U];
+				break;
+			case envelopeState_t::decaySustain:
+				ratePeriod = ratePeriods[attackDecay & 0x0fU];
+				break;
+			case envelopeState_t::release:
+				ratePeriod = ratePeriods[sustainRelease & 0x0fU];
+				break;
+		}
+	}
+
+	void envelope_t::gate(const bool gateOn) noexcept
+	{
+		if (gateOn)
+		{
+			state = envelopeState_t::attack;
+			holdZero = false;
+		}
+		else
+			state = envelopeState_t::release;
+		updateRatePeriod();
+	}
+
+	void envelope_t::writeAttackDecay(const uint8_t value) noexcept
+	{
+		attackDecay = value;
+		updateRatePeriod();
+	}
+
+	void envelope_t::writeSustainRelease(const uint8_t value) noexcept
+	{
+		sustainRelease = value;
+		updateRatePeriod();
+	}
+
+	void envelope_t::tick() noexcept
+	{
+		// Outside of attack, the steps are divided down further to approximate an exponential decay
+		if (state != envelopeState_t::attack && ++exponentialCounter != exponentialPeriod)
+			return;
+		exponentialCounter = 0U;
+		if (holdZero)
+			return;
+
+		switch (state)
+		{
+			case envelopeState_t::attack:
+				if (++counter == 0xffU)
+				{
+					state = envelopeState_t::decaySustain;
+					updateRatePeriod();
+				}
+				break;
+			case envelopeState_t::decaySustain:
+				if (counter != (sustainRelease >> 4U) * 0x11U)
+					--counter;
+				break;
+			case envelopeState_t::release:
+				--counter;
+				break;
+		}
+
+		switch (counter)
+		{
+			case 0xffU:
+				exponentialPeriod = 1U;
+				break;
+			case 0x5dU:
+				exponentialPeriod = 2U;
+				break;
+			case 0x36U:
+				exponentialPeriod = 4U;
+				break;
+			case 0x1aU:
+				exponentialPeriod = 8U;
+				break;
+			case 0x0eU:
+				exponentialPeriod = 16U;
+				break;
+			case 0x06U:
+				exponentialPeriod = 30U;
+				break;
+			case 0x00U:
+				// Once the envelope hits 0 it stays there till the next attack
+				exponentialPeriod = 1U;
+				holdZero = true;
+				break;
+		}
+	}
+
+	void envelope_t::clockCycles(const uint32_t cycles) noexcept
+	{
+		// If the envelope is frozen, either at 0 or at the sustain level, none of the rate ticks can change
+		// anything - so just work out where the rate counter ends up
+		const bool frozen{(holdZero && state != envelopeState_t::attack) ||
+			(state == envelopeState_t::decaySustain && counter == (sustainRelease >> 4U) * 0x11U)};
+
+		auto remaining{cycles};
+		while (true)
+		{
+			// Find how long until the rate counter reaches the period, having to wrap all the way round if it's past it
+			const uint32_t untilTick
+				{rateCounter < ratePeriod ? ratePeriod - rateCounter : 0x8000U - rateCounter + ratePeriod};
+			if (untilTick > remaining)
+			{
+				rateCounter = static_cast<uint16_t>((rateCounter + remaining) & 0x7fffU);
+				return;
+			}
+			remaining -= untilTick;
+			if (frozen)
+			{
+				rateCounter = static_cast<uint16_t>(remaining % ratePeriod);
+				return;
+			}
+			rateCounter = 0U;
+			tick();
+		}
+	}
+} // namespace mos6581
@@ -0,0 +1,130 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef EMULATOR_SOUND_MOS6581_HXX
+#define EMULATOR_SOUND_MOS6581_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <substrate/span>
+#include "../memoryMap.hxx"
+
+enum class sidModel_t
+{
+	mos6581,
+	mos8580,
+};
+
+namespace mos6581
+{
+	enum class envelopeState_t : uint8_t
+	{
+		attack,
+		decaySustain,
+		release,
+	};
+
+	struct envelope_t final
+	{
+	private:
+		envelopeState_t state{envelopeState_t::release};
+		uint16_t rateCounter{0U};
+		uint16_t ratePeriod{9U};
+		uint8_t exponentialCounter{0U};
+		uint8_t exponentialPeriod{1U};
+		uint8_t counter{0U};
+		bool holdZero{true};
+		uint8_t attackDecay{0U};
+		uint8_t sustainRelease{0U};
+
+		void updateRatePeriod() noexcept;
+		void tick() noexcept;
+
+	public:
+		void gate(bool gateOn) noexcept;
+		void writeAttackDecay(uint8_t value) noexcept;
+		void writeSustainRelease(uint8_t value) noexcept;
+		void clockCycles(uint32_t cycles) noexcept;
+		[[nodiscard]] uint8_t level() const noexcept { return counter; }
+	};
+
+	struct voice_t final
+	{
+		uint32_t accumulator{0U};
+		uint32_t noiseLFSR{0x7fffffU};
+		uint16_t frequency{0U};
+		uint16_t pulseWidth{0U};
+		uint8_t control{0U};
+		envelope_t envelope{};
+
+		void writeControl(uint8_t value) noexcept;
+		// Advances the oscillator, returning the accumulator value it would have had without being wrapped
+		[[nodiscard]] uint32_t advance(uint32_t cycles) noexcept;
+		void clockNoise(uint32_t clocks) noexcept;
+		// Computes the 12-bit waveform generator output, given the oscillator ring modulating this one
+		[[nodiscard]] uint16_t waveform(const voice_t &ringSource) const noexcept;
+	};
+} // namespace mos6581
+
+/*
+ * A 6581/8580 SID. The oscillators and envelope generators are only brought up to date when a sample is due or
+ * a register gets written, rather than cycle by cycle, and the output is generated straight into a block of
+ * samples handed over via outputTo() - so a whole buffer's worth of audio is produced in a single tight loop
+ * between register writes.
+ */
+struct mos6581_t final : public clockedPeripheral_t<uint32_t>
+{
+private:
+	sidModel_t model;
+	std::array<mos6581::voice_t, 3U> voices{};
+	uint16_t filterCutoff{0U};
+	uint8_t filterResonance{0U};
+	uint8_t filterRouting{0U};
+	uint8_t modeVolume{0U};
+
+	// Filter state and the coefficients derived from the cutoff and resonance registers
+	float filterLowPass{0.0F};
+	float filterBandPass{0.0F};
+	float filterFrequency{0.0F};
+	float filterDamping{1.0F};
+	// DC blocking filter state
+	float dcBlockCoefficient;
+	float dcInput{0.0F};
+	float dcOutput{0.0F};
+
+	uint32_t sampleRate;
+	clockManager_t clockManager;
+	// How many cycles long the current sample period is, how far through it we are, and how far the voices are
+	uint32_t samplePeriod;
+	uint32_t sampleCycles{0U};
+	uint32_t voiceCycles{0U};
+	substrate::span<int16_t> output{};
+	size_t outputPosition{0U};
+	uint32_t cyclesUntilFull{UINT32_MAX};
+
+	void readAddress(uint32_t address, substrate::span<uint8_t> data) const noexcept final;
+	void writeAddress(uint32_t address, const substrate::span<uint8_t> &data) noexcept final;
+
+	void updateFilter() noexcept;
+	void advanceVoices(uint32_t cycles) noexcept;
+	void catchUpVoices() noexcept;
+	[[nodiscard]] int16_t generateSample() noexcept;
+
+public:
+	mos6581_t(uint32_t clockFrequency, uint32_t sampleFrequency, sidModel_t chipModel) noexcept;
+	mos6581_t(const mos6581_t &) noexcept = delete;
+	mos6581_t(mos6581_t &&) noexcept = delete;
+	mos6581_t &operator =(const mos6581_t &) noexcept = delete;
+	mos6581_t &operator =(mos6581_t &&) noexcept = delete;
+	~mos6581_t() noexcept final = default;
+
+	[[nodiscard]] bool clockCycle() noexcept final;
+	[[nodiscard]] uint32_t cyclesUntilEvent() const noexcept final;
+	[[nodiscard]] bool clockCycles(uint32_t cycles) noexcept final;
+
+	// Sets the buffer the next samples generated are written into - any generated while no space remains are dropped
+	void outputTo(substrate::span<int16_t> buffer) noexcept;
+	[[nodiscard]] bool outputFull() const noexcept { return outputPosition == output.size(); }
+};
+
+#endif /*EMULATOR_SOUND_MOS6581_HXX*/
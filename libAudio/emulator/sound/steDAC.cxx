@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
 #include <cstdint>
+#include <algorithm>
 #include <tuple>
 #include <substrate/span>
 #include <substrate/index_sequence>
@@ -168,21 +169,9 @@ bool steDAC_t::clockCycle() noexcept
 	if ((control & (1U << 0U)) == 0x00U)
 		return true;
 
-	// Calculate the current sample rate tick count to hit the required play rate
-	const auto sampleRateTicks
-	{
-		[&]()
-		{
-			const auto ticks{(1U << sampleRateDivider)};
-			if (sampleMono)
-				return ticks;
-			// Stero playback requires us stretch the tick rate to half to get the correct cadence
-			return ticks << 1U;
-		}()
-	};
 	// Something's playing, great.. step the rate counter to see if we should do something
 	// in this cycle, and check if the counter overflowed
-	if (++sampleRateCounter == sampleRateTicks)
+	if (++sampleRateCounter == sampleRateTicks())
 		// Yes, so reset it
 		sampleRateCounter = 0U;
 	else
@@ -207,6 +196,54 @@ bool steDAC_t::clockCycle() noexcept
 	return true;
 }
 
+// Calculate the current sample rate tick count to hit the required play rate
+uint32_t steDAC_t::sampleRateTicks() const noexcept
+{
+	const auto ticks{(1U << sampleRateDivider)};
+	if (sampleMono)
+		return ticks;
+	// Stero playback requires us stretch the tick rate to half to get the correct cadence
+	return ticks << 1U;
+}
+
+uint32_t steDAC_t::cyclesUntilEvent() const noexcept
+{
+	// If nothing's playing, nothing will happen
+	if ((control & (1U << 0U)) == 0x00U)
+		return UINT32_MAX;
+	// Work out how many sample steps it'll be till the sample address hits the end address
+	const auto step{sampleMono ? 1U : 2U};
+	const auto distance{static_cast<uint32_t>(endAddress) - static_cast<uint32_t>(sampleAddress)};
+	if (distance == 0U || distance % step != 0U)
+		return UINT32_MAX;
+	// Now turn that into cycles, noting the rate counter is 8-bit and might first need to wrap around to hit the tick count
+	const auto ticks{sampleRateTicks()};
+	const auto firstStep{static_cast<uint8_t>(ticks - sampleRateCounter - 1U) + 1U};
+	const auto cycles{firstStep + ((uint64_t{distance / step} - 1U) * ticks)};
+	return static_cast<uint32_t>(std::min<uint64_t>(cycles, UINT32_MAX));
+}
+
+bool steDAC_t::clockCycles(const uint32_t cycles) noexcept
+{
+	// Check if there's anything playing or not, and if not then exit early
+	if ((control & (1U << 0U)) == 0x00U)
+		return true;
+
+	// Work out how many sample steps happen in these cycles, and where that leaves the rate counter
+	const auto ticks{sampleRateTicks()};
+	const auto firstStep{static_cast<uint8_t>(ticks - sampleRateCounter - 1U) + 1U};
+	if (cycles < firstStep)
+	{
+		sampleRateCounter += static_cast<uint8_t>(cycles);
+		return true;
+	}
+	const auto steps{((cycles - firstStep) / ticks) + 1U};
+	sampleRateCounter = static_cast<uint8_t>((cycles - firstStep) % ticks);
+	// Step the sample counter, which can't reach the end address in these cycles
+	sampleAddress += steps * (sampleMono ? 1U : 2U);
+	return true;
+}
+
 void steDAC_t::runMicrowireTransaction() noexcept
 {
 	// Every microwire transaction is 16 cycles
@@ -291,6 +328,20 @@ int16_t steDAC_t::sample(const memoryMap_t<uint32_t, 0x00ffffffU> &memoryMap) co
 	return 0;
 }
 
+// Sound DMA can only fetch from ST RAM, so this variant lets the caller hand that over to read from directly
+int16_t steDAC_t::sample(const substrate::span<const uint8_t> memory) const noexcept
+{
+	// If the DMA engine is currently active, and the frame to play is in RAM, grab it back and mix down to mono
+	if (control & 0x01U && sampleAddress + (sampleMono ? 0U : 1U) < memory.size())
+	{
+		const int16_t left{static_cast<int8_t>(memory[sampleAddress])};
+		const int16_t right{sampleMono ? left : int16_t{static_cast<int8_t>(memory[sampleAddress + 1U])}};
+		// Sum the result and scale to get the correct output level
+		return (left + right) * 32;
+	}
+	return 0;
+}
+
 namespace steDAC
 {
 	void register24b_t::writeByte(const uint8_t position, const uint8_t byte) noexcept
@@ -51,6 +51,7 @@ private:
 
 	void runMicrowireTransaction() noexcept;
 	[[nodiscard]] uint16_t microwireCycle() const noexcept;
+	[[nodiscard]] uint32_t sampleRateTicks() const noexcept;
 
 public:
 	steDAC_t(uint32_t clockFrequency, mc68901_t &mfp) noexcept;
@@ -61,8 +62,11 @@ public:
 	~steDAC_t() noexcept final = default;
 
 	[[nodiscard]] bool clockCycle() noexcept final;
+	[[nodiscard]] uint32_t cyclesUntilEvent() const noexcept final;
+	[[nodiscard]] bool clockCycles(uint32_t cycles) noexcept final;
 	[[nodiscard]] uint8_t outputLevel() const noexcept { return mainVolume; }
 	[[nodiscard]] int16_t sample(const memoryMap_t<uint32_t, 0x00ffffffU> &memoryMap) const noexcept;
+	[[nodiscard]] int16_t sample(substrate::span<const uint8_t> memory) const noexcept;
 };
 
 #endif /*EMULATOR_SOUND_STEDAC_HXX*/
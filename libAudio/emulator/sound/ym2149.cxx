@@ -192,6 +192,32 @@ bool ym2149_t::clockCycle() noexcept
 	return true;
 }
 
+// The next event is the next sample becoming ready
+uint32_t ym2149_t::cyclesUntilEvent() const noexcept
+	{ return clockManager.cyclesUntil(1U); }
+
+bool ym2149_t::clockCycles(const uint32_t cycles) noexcept
+{
+	if (cycles == 0U)
+		return true;
+	// Reset the channel states if ready was true, as the first of these cycles would
+	if (ready)
+	{
+		read = false;
+		for (auto &state : channelState)
+			state = false;
+	}
+	// No samples become ready in these cycles
+	ready = false;
+	static_cast<void>(clockManager.advanceCycles(cycles));
+
+	// Run the FSM for each of the cycles in which it would update, the first of which is when cyclesTillUpdate wraps
+	for (uint64_t cycle{(8U - cyclesTillUpdate) & 7U}; cycle < cycles; cycle += 8U)
+		updateFSM();
+	cyclesTillUpdate = static_cast<uint8_t>((cyclesTillUpdate + cycles) & 7U);
+	return true;
+}
+
 void ym2149_t::updateFSM() noexcept
 {
 	// Update the channel states to reflect the current chip state
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
 #include <cstdint>
+#include <algorithm>
 #include <substrate/span>
 #include <substrate/index_sequence>
 #include "mc68901.hxx"
@@ -309,6 +310,26 @@ bool mc68901_t::clockCycle() noexcept
 	return true;
 }
 
+uint32_t mc68901_t::cyclesUntilEvent() const noexcept
+{
+	// If there are IRQs pending, the next cycle will (re-)request handling by the CPU
+	if (itrPending & itrMask)
+		return 1U;
+	// Otherwise, it's however long it is till the first of the timers fires
+	uint32_t cycles{UINT32_MAX};
+	for (const auto &timer : timers)
+		cycles = std::min(cycles, timer.cyclesUntilInterrupt());
+	return cycles;
+}
+
+bool mc68901_t::clockCycles(const uint32_t cycles) noexcept
+{
+	// None of the timers fire in these cycles, so just step them all forward
+	for (auto &timer : timers)
+		timer.clockCycles(cycles);
+	return true;
+}
+
 void mc68901_t::fireDMAEvent() noexcept
 {
 	// Try to mark timer A for external event
@@ -427,6 +448,32 @@ namespace mc68901
 		return false;
 	}
 
+	uint32_t timer_t::cyclesUntilInterrupt() const noexcept
+	{
+		// Check if the timer is stopped
+		if ((control & 0x0fU) == 0U)
+			return UINT32_MAX;
+		// Check if the timer is in a counting mode, in which case it fires when the counter next reaches 0
+		if ((control & 0x08U) == 0U)
+			return clockManager.cyclesUntil(counter == 0U ? 256U : counter);
+		// If the timer is in event count mode, it can only fire on the next timer cycle, and only with an event pending
+		if ((control & 0x0fU) == 0x08U && externalEvent)
+			return clockManager.cyclesUntil(1U);
+		return UINT32_MAX;
+	}
+
+	void timer_t::clockCycles(const uint32_t cycles) noexcept
+	{
+		// Check if the timer is stopped
+		if ((control & 0x0fU) == 0U)
+			return;
+		const auto timerCycles{clockManager.advanceCycles(cycles)};
+		// If the timer is in a counting mode, apply the clock pulses to the counter - which can't reach 0 in them
+		if ((control & 0x08U) == 0U)
+			counter -= static_cast<uint8_t>(timerCycles);
+		// In event count mode there was no event to process in the cycles, and we don't support the PWM modes
+	}
+
 	uint32_t timer_t::prescalingFor(const uint8_t mode) noexcept
 	{
 		switch (mode)
@@ -30,6 +30,8 @@ namespace mc68901
 		void markExternalEvent() noexcept;
 
 		[[nodiscard]] bool clockCycle() noexcept;
+		[[nodiscard]] uint32_t cyclesUntilInterrupt() const noexcept;
+		void clockCycles(uint32_t cycles) noexcept;
 
 		[[nodiscard]] static uint32_t prescalingFor(uint8_t mode) noexcept;
 	};
@@ -67,6 +69,8 @@ public:
 	~mc68901_t() noexcept final = default;
 
 	[[nodiscard]] bool clockCycle() noexcept final;
+	[[nodiscard]] uint32_t cyclesUntilEvent() const noexcept final;
+	[[nodiscard]] bool clockCycles(uint32_t cycles) noexcept final;
 	void fireDMAEvent() noexcept;
 
 	void configureTimer(size_t timerIndex, uint8_t reloadValue, uint8_t mode) noexcept;
@@ -0,0 +1,204 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <algorithm>
+#include <substrate/span>
+#include <substrate/indexed_iterator>
+#include "mos6526.hxx"
+
+mos6526_t::mos6526_t(const uint32_t clockFrequency) noexcept :
+	clockedPeripheral_t<uint32_t>{clockFrequency}, mos6502::irqRequester_t{} { }
+
+void mos6526_t::readAddress(const uint32_t address, substrate::span<uint8_t> data) const noexcept
+{
+	for (auto [idx, value] : substrate::indexedIterator_t{data})
+	{
+		// The 16 registers repeat through the whole of the chip's address range
+		const auto reg{(address + idx) & 0x0fU};
+		switch (reg)
+		{
+			case 0x0U:
+			case 0x1U:
+				// Nothing drives the port pins, so inputs read high
+				value = port[reg] | static_cast<uint8_t>(~dataDirection[reg]);
+				break;
+			case 0x2U:
+			case 0x3U:
+				value = dataDirection[reg - 2U];
+				break;
+			case 0x4U:
+			case 0x6U:
+				value = static_cast<uint8_t>(timers[(reg - 4U) >> 1U].count());
+				break;
+			case 0x5U:
+			case 0x7U:
+				value = static_cast<uint8_t>(timers[(reg - 5U) >> 1U].count() >> 8U);
+				break;
+			case 0x8U:
+			case 0x9U:
+			case 0xaU:
+			case 0xbU:
+				value = timeOfDay[reg - 8U];
+				break;
+			case 0xcU:
+				value = serialData;
+				break;
+			case 0xdU:
+				// Reading the interrupt flags also acknowledges them all
+				value = itrFlags | (itrFlags & itrMask ? 0x80U : 0x00U);
+				itrFlags = 0U;
+				break;
+			case 0xeU:
+			case 0xfU:
+				value = timers[reg - 0xeU].ctrl();
+				break;
+		}
+	}
+}
+
+void mos6526_t::writeAddress(const uint32_t address, const substrate::span<uint8_t> &data) noexcept
+{
+	for (const auto &[idx, value] : substrate::indexedIterator_t{data})
+	{
+		const auto reg{(address + idx) & 0x0fU};
+		switch (reg)
+		{
+			case 0x0U:
+			case 0x1U:
+				port[reg] = value;
+				break;
+			case 0x2U:
+			case 0x3U:
+				dataDirection[reg - 2U] = value;
+				break;
+			case 0x4U:
+			case 0x6U:
+				timers[(reg - 4U) >> 1U].latchLow(value);
+				break;
+			case 0x5U:
+			case 0x7U:
+				timers[(reg - 5U) >> 1U].latchHigh(value);
+				break;
+			case 0x8U:
+			case 0x9U:
+			case 0xaU:
+			case 0xbU:
+				timeOfDay[reg - 8U] = value;
+				break;
+			case 0xcU:
+				serialData = value;
+				break;
+			case 0xdU:
+				// Bit 7 selects whether the other set bits get enabled or disabled
+				if (value & 0x80U)
+					itrMask |= value & 0x1fU;
+				else
+					itrMask &= ~value & 0x1fU;
+				break;
+			case 0xeU:
+			case 0xfU:
+				timers[reg - 0xeU].ctrl(value);
+				break;
+		}
+	}
+}
+
+bool mos6526_t::clockCycle() noexcept
+{
+	// Timer A counts system clock cycles
+	const auto underflowA{timers[0].count(timers[0].countsCycles(false))};
+	// Timer B counts either cycles or timer A underflows
+	const auto pulseB{timers[1].countsCycles(true) || ((timers[1].ctrl() & 0x40U) && underflowA)};
+	const auto underflowB{timers[1].count(pulseB)};
+
+	if (underflowA)
+	{
+		itrFlags |= 0x01U;
+		timerAUnderflowed = true;
+	}
+	if (underflowB)
+		itrFlags |= 0x02U;
+	return true;
+}
+
+uint32_t mos6526_t::cyclesUntilEvent() const noexcept
+{
+	// The next thing to happen is one of the timers underflowing, so find which is soonest
+	return std::min(timers[0].cyclesUntilUnderflow(false), timers[1].cyclesUntilUnderflow(true));
+}
+
+bool mos6526_t::clockCycles(const uint32_t cycles) noexcept
+{
+	// Neither timer underflows in these cycles, so just count them both down
+	timers[0].clockCycles(false, cycles);
+	timers[1].clockCycles(true, cycles);
+	return true;
+}
+
+bool mos6526_t::consumeTimerAUnderflow() noexcept
+{
+	const auto underflowed{timerAUnderflowed};
+	timerAUnderflowed = false;
+	return underflowed;
+}
+
+namespace mos6526
+{
+	void timer_t::ctrl(const uint8_t value) noexcept
+	{
+		// The force load bit is a strobe, so gets acted on here and not stored
+		if (value & 0x10U)
+			counter = latch;
+		control = value & 0xefU;
+	}
+
+	void timer_t::latchLow(const uint8_t value) noexcept
+		{ latch = static_cast<uint16_t>((latch & 0xff00U) | value); }
+
+	void timer_t::latchHigh(const uint8_t value) noexcept
+	{
+		latch = static_cast<uint16_t>((latch & 0x00ffU) | (value << 8U));
+		// Writing the high byte of the latch while the timer is stopped also loads the counter
+		if (!running())
+			counter = latch;
+	}
+
+	bool timer_t::countsCycles(const bool timerB) const noexcept
+	{
+		// Timer A can otherwise count CNT pulses and timer B CNT pulses or timer A underflows,
+		// but there's nothing attached to CNT to generate any
+		if (timerB)
+			return (control & 0x60U) == 0U;
+		return (control & 0x20U) == 0U;
+	}
+
+	bool timer_t::count(const bool pulse) noexcept
+	{
+		if (!running() || !pulse)
+			return false;
+		// The timer underflows on the pulse after reaching 0, reloading from the latch
+		if (counter == 0U)
+		{
+			counter = latch;
+			// In one-shot mode, the timer then stops
+			if (control & 0x08U)
+				control &= 0xfeU;
+			return true;
+		}
+		--counter;
+		return false;
+	}
+
+	uint32_t timer_t::cyclesUntilUnderflow(const bool timerB) const noexcept
+	{
+		if (!running() || !countsCycles(timerB))
+			return UINT32_MAX;
+		return counter + 1U;
+	}
+
+	void timer_t::clockCycles(const bool timerB, const uint32_t cycles) noexcept
+	{
+		if (running() && countsCycles(timerB))
+			counter -= static_cast<uint16_t>(cycles);
+	}
+} // namespace mos6526
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef EMULATOR_TIMING_MOS6526_HXX
+#define EMULATOR_TIMING_MOS6526_HXX
+
+#include <cstdint>
+#include <array>
+#include <substrate/span>
+#include "../memoryMap.hxx"
+#include "../cpu/mos6502.hxx"
+
+namespace mos6526
+{
+	struct timer_t final
+	{
+	private:
+		uint8_t control{0U};
+		uint16_t counter{0xffffU};
+		uint16_t latch{0xffffU};
+
+	public:
+		[[nodiscard]] uint8_t ctrl() const noexcept { return control; }
+		void ctrl(uint8_t value) noexcept;
+		[[nodiscard]] uint16_t count() const noexcept { return counter; }
+		void latchLow(uint8_t value) noexcept;
+		void latchHigh(uint8_t value) noexcept;
+
+		[[nodiscard]] bool running() const noexcept { return control & 0x01U; }
+		// Whether the timer counts system clock cycles (as opposed to the underflows of timer A, for timer B)
+		[[nodiscard]] bool countsCycles(bool timerB) const noexcept;
+		// Runs a single count pulse through the timer, returning true if it underflowed
+		[[nodiscard]] bool count(bool pulse) noexcept;
+		[[nodiscard]] uint32_t cyclesUntilUnderflow(bool timerB) const noexcept;
+		void clockCycles(bool timerB, uint32_t cycles) noexcept;
+	};
+} // namespace mos6526
+
+/*
+ * A 6526 CIA, as found twice in the C64. Only the interval timers and interrupt control are modelled -
+ * the I/O ports read back as if nothing were driving them and the TOD clock and serial port are plain storage.
+ */
+struct mos6526_t final : public clockedPeripheral_t<uint32_t>, mos6502::irqRequester_t
+{
+private:
+	void readAddress(uint32_t address, substrate::span<uint8_t> data) const noexcept final;
+	void writeAddress(uint32_t address, const substrate::span<uint8_t> &data) noexcept final;
+
+	std::array<uint8_t, 2U> port{};
+	std::array<uint8_t, 2U> dataDirection{};
+	std::array<uint8_t, 4U> timeOfDay{};
+	uint8_t serialData{0U};
+	// Reading the interrupt control register acknowledges the interrupts, so this is mutable
+	mutable uint8_t itrFlags{0U};
+	uint8_t itrMask{0U};
+	bool timerAUnderflowed{false};
+
+	std::array<mos6526::timer_t, 2U> timers{};
+
+public:
+	mos6526_t(uint32_t clockFrequency) noexcept;
+	mos6526_t(const mos6526_t &) noexcept = delete;
+	mos6526_t(mos6526_t &&) noexcept = delete;
+	mos6526_t &operator =(const mos6526_t &) noexcept = delete;
+	mos6526_t &operator =(mos6526_t &&) noexcept = delete;
+	~mos6526_t() noexcept final = default;
+
+	[[nodiscard]] bool clockCycle() noexcept final;
+	[[nodiscard]] uint32_t cyclesUntilEvent() const noexcept final;
+	[[nodiscard]] bool clockCycles(uint32_t cycles) noexcept final;
+	[[nodiscard]] bool irqAsserted() const noexcept final { return itrFlags & itrMask; }
+
+	// Returns whether timer A has underflowed since the last call, for driving things off its rate
+	[[nodiscard]] bool consumeTimerAUnderflow() noexcept;
+};
+
+#endif /*EMULATOR_TIMING_MOS6526_HXX*/
@@ -14,6 +14,7 @@ void fileInfo_t::operator =(const fileInfo_t &info) noexcept
 		return;
 	_totalTime = info._totalTime;
 	_bitsPerSample = info._bitsPerSample;
+	_sampleFormat = info._sampleFormat;
 	_bitRate = info._bitRate;
 	_channels = info._channels;
 }
@@ -25,7 +26,11 @@ void fileInfo_t::totalTime(const uint64_t totalTime) noexcept
 uint8_t fileInfo_t::bitsPerSample() const noexcept
 	{ return _bitsPerSample; }
 void fileInfo_t::bitsPerSample(const uint8_t bitsPerSample) noexcept
-	{ _bitsPerSample = bitsPerSample; }
+{
+	_bitsPerSample = bitsPerSample;
+	// Decoders that have not been told otherwise produce 8-bit samples for 8-bit sources and 16-bit for all else
+	_sampleFormat = bitsPerSample == 8U ? sampleFormat_t::int8 : sampleFormat_t::int16;
+}
 uint32_t fileInfo_t::bitRate() const noexcept
 	{ return _bitRate; }
 void fileInfo_t::bitRate(const uint32_t bitRate) noexcept
@@ -35,6 +40,43 @@ uint8_t fileInfo_t::channels() const noexcept
 void fileInfo_t::channels(const uint8_t channels) noexcept
 	{ _channels = channels; }
 
+sampleFormat_t fileInfo_t::sampleFormat() const noexcept
+	{ return _sampleFormat; }
+void fileInfo_t::sampleFormat(const sampleFormat_t sampleFormat) noexcept
+{
+	_sampleFormat = sampleFormat;
+	switch (sampleFormat)
+	{
+		case sampleFormat_t::int8:
+			_bitsPerSample = 8U;
+			break;
+		case sampleFormat_t::int16:
+			_bitsPerSample = 16U;
+			break;
+		case sampleFormat_t::int24:
+			_bitsPerSample = 24U;
+			break;
+		case sampleFormat_t::int32:
+		case sampleFormat_t::float32:
+			_bitsPerSample = 32U;
+			break;
+	}
+}
+
+// Gives how large each sample's container is, which differs from bitsPerSample() for 24-bit samples
+uint8_t fileInfo_t::bytesPerSample() const noexcept
+{
+	switch (_sampleFormat)
+	{
+		case sampleFormat_t::int8:
+			return 1U;
+		case sampleFormat_t::int16:
+			return 2U;
+		default:
+			return 4U;
+	}
+}
+
 const char *fileInfo_t::title() const noexcept
 	{ return _title.get(); }
 std::unique_ptr<char []> &fileInfo_t::titlePtr() noexcept
@@ -82,6 +124,13 @@ uint32_t audioFileBitsPerSample(const fileInfo_t *const fileInfo)
 	return fileInfo->bitsPerSample();
 }
 
+uint8_t audioFileSampleFormat(const fileInfo_t *const fileInfo)
+{
+	if (!fileInfo)
+		return 0U;
+	return static_cast<uint8_t>(fileInfo->sampleFormat());
+}
+
 uint32_t audioFileBitRate(const fileInfo_t *const fileInfo)
 {
 	if (!fileInfo)
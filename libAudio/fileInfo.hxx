@@ -14,6 +14,24 @@
 #pragma warning(disable:4251)
 #endif
 
+/*!
+ * The interleaved sample formats a decoder can be asked to produce its output in
+ */
+enum class sampleFormat_t : uint8_t
+{
+	int8 = AUDIO_SAMPLE_INT8,
+	int16 = AUDIO_SAMPLE_INT16,
+	/*!
+	 * 24-bit samples, sign extended into 32-bit containers
+	 */
+	int24 = AUDIO_SAMPLE_INT24,
+	int32 = AUDIO_SAMPLE_INT32,
+	/*!
+	 * Floating point samples normalised to the range [-1, 1]
+	 */
+	float32 = AUDIO_SAMPLE_FLOAT32
+};
+
 struct libAUDIO_CLS_API fileInfo_t final
 {
 private:
@@ -21,6 +39,7 @@ private:
 	uint32_t _bitRate{0U};
 	uint8_t _bitsPerSample{0U};
 	uint8_t _channels{0U};
+	sampleFormat_t _sampleFormat{sampleFormat_t::int16};
 
 	std::unique_ptr<char []> _title{};
 	std::unique_ptr<char []> _artist{};
@@ -40,7 +59,18 @@ public:
 	[[nodiscard]] uint64_t totalTime() const noexcept;
 	void totalTime(uint64_t totalTime) noexcept;
 	[[nodiscard]] uint8_t bitsPerSample() const noexcept;
+	/*!
+	 * Sets the bit depth of the audio. This also resets sampleFormat() to what the decoders produce
+	 * unless told otherwise - int8 for 8-bit audio and int16 for everything else, including 24 and
+	 * 32-bit audio - so any other format must be set with sampleFormat() after calling this
+	 */
 	void bitsPerSample(uint8_t bitsPerSample) noexcept;
+	[[nodiscard]] sampleFormat_t sampleFormat() const noexcept;
+	/*!
+	 * Sets the format samples are decoded to, which also sets bitsPerSample() to match it
+	 */
+	void sampleFormat(sampleFormat_t sampleFormat) noexcept;
+	[[nodiscard]] uint8_t bytesPerSample() const noexcept;
 	[[nodiscard]] uint32_t bitRate() const noexcept;
 	void bitRate(uint32_t bitRate) noexcept;
 	[[nodiscard]] uint8_t channels() const noexcept;
@@ -23,23 +23,28 @@ struct flac_t::decoderContext_t final
 	FLAC__StreamDecoder *streamDecoder;
 	/*!
 	 * @internal
-	 * The internal decoded data buffer
+	 * The internal decoded data buffer, holding interleaved samples left justified in 32 bits
 	 */
-	std::unique_ptr<uint8_t []> buffer;
+	std::unique_ptr<int32_t []> buffer;
 	uint32_t bufferLen;
 	uint8_t playbackBuffer[16384];
 	/*!
 	 * @internal
-	 * The amount to shift the sample data by to convert it
+	 * The amount to shift the sample data by to left justify it
 	 */
 	uint8_t sampleShift;
 	/*!
 	 * @internal
-	 * The count of the number of bytes left to process
-	 * (also thinkable as the number of bytes left to read)
+	 * The count of the number of samples left to process
+	 * (also thinkable as the number of samples left to read)
 	 */
-	uint32_t bytesRemain;
-	uint32_t bytesAvail;
+	uint32_t samplesRemain;
+	uint32_t samplesAvail;
+	/*!
+	 * @internal
+	 * The sample frame number of the first sample in the internal decoded data buffer
+	 */
+	uint64_t frameSample;
 
 	decoderContext_t() noexcept;
 	~decoderContext_t() noexcept;
@@ -1,11 +1,13 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2012-2023 Rachel Mant <git@dragonmux.network>
 #include "genericModule.h"
+#include "../moduleMixer/mixerPool.hxx"
 
 using substrate::make_unique_nothrow;
 
-moduleFile_t::moduleFile_t(audioType_t type, fd_t &&fd) noexcept : audioFile_t{type, std::move(fd)},
+moduleFile_t::moduleFile_t(audioType_t type, inputSource_t &&source) noexcept : audioFile_t{type, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
+moduleFile_t::~moduleFile_t() noexcept = default;
 
 void moduleFile_t::ensurePlayable() noexcept
 {
@@ -19,16 +21,90 @@ void moduleFile_t::ensurePlayable() noexcept
 		ctx.mod->InitMixer(info);
 }
 
+/*!
+ * Opts in to (or back out of) mixing the module's channels across multiple threads.
+ * The rendered audio is bit-identical to that produced by the serial mixer
+ * @param threads The total number of threads to mix with - 0 or 1 selects the serial mixer
+ * @return \c true if the mixer could be configured as requested, otherwise \c false
+ */
+bool moduleFile_t::mixerThreads(const uint32_t threads) noexcept
+{
+	auto *const ctx{context()};
+	if (!ctx || !ctx->mod)
+		return false;
+	return ctx->mod->mixerThreads(threads);
+}
+
+uint32_t moduleFile_t::mixerThreads() const noexcept
+{
+	const auto *const ctx{context()};
+	if (!ctx || !ctx->mod)
+		return 0U;
+	return ctx->mod->mixerThreads();
+}
+
+/*!
+ * Selects the interpolation used to resample the module's samples to the output sample rate,
+ * trading quality against CPU cost. Modules start out using nearest-neighbour resampling
+ * @param mode The interpolation to use
+ * @return \c true if the mode was valid and has been selected, otherwise \c false
+ */
+bool moduleFile_t::resampling(const moduleResampling_t mode) noexcept
+{
+	auto *const ctx{context()};
+	if (!ctx || !ctx->mod)
+		return false;
+	return ctx->mod->resampling(mode);
+}
+
+moduleResampling_t moduleFile_t::resampling() const noexcept
+{
+	const auto *const ctx{context()};
+	if (!ctx || !ctx->mod)
+		return moduleResampling_t::nearest;
+	return ctx->mod->resampling();
+}
+
+/*!
+ * @internal
+ * Reads the information for the module of type \p T in \p source, including how long it plays for,
+ * without loading any of the module's sample data or setting up its mixer
+ * @return \c true if the module could be read, otherwise \c false
+ */
+template<typename T> bool moduleFile_t::readInfo(inputSource_t &&source, fileInfo_t &info) noexcept try
+{
+	const std::unique_ptr<T> file{T::openR(std::move(source), true)};
+	if (!file)
+		return false;
+	file->context()->mod->scanLength(file->fileInfo());
+	info = std::move(file->fileInfo());
+	return true;
+}
+catch (const std::exception &)
+	{ return false; }
+
+template bool moduleFile_t::readInfo<modMOD_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+template bool moduleFile_t::readInfo<modS3M_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+template bool moduleFile_t::readInfo<modSTM_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+#ifdef ENABLE_AON
+template bool moduleFile_t::readInfo<modAON_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+#endif
+#ifdef ENABLE_FC1x
+template bool moduleFile_t::readInfo<modFC1x_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+#endif
+template bool moduleFile_t::readInfo<modIT_t>(inputSource_t &&source, fileInfo_t &info) noexcept;
+
 constexpr ModuleFile::ModuleFile(const uint8_t moduleType) noexcept : ModuleType{moduleType}, p_Header{nullptr},
 	p_Samples{nullptr}, p_Patterns{nullptr}, p_Instruments{nullptr}, p_PCM{nullptr}, lengthPCM{}, nPCM{},
 	MixSampleRate{}, MixBitsPerSample{}, TickCount{}, SamplesToMix{}, MinPeriod{}, MaxPeriod{}, MixChannels{},
 	Row{}, NextRow{}, Rows{}, MusicSpeed{}, MusicTempo{}, Pattern{}, currentOrder{}, nextOrder{}, RowsPerBeat{},
 	SamplesPerTick{}, Channels{}, nMixerChannels{}, MixerChannels{}, globalVolume{},
-	globalVolumeSlide{}, PatternDelay{}, FrameDelay{}, MixBuffer{}, DCOffsR{}, DCOffsL{} { }
+	globalVolumeSlide{}, PatternDelay{}, FrameDelay{}, MixBuffer{}, DCOffsR{}, DCOffsL{}, mixerPool{},
+	resamplingMode{moduleResampling_t::nearest} { }
 
-ModuleFile::ModuleFile(const modMOD_t &file) : ModuleFile{MODULE_MOD}
+ModuleFile::ModuleFile(const modMOD_t &file, const bool loadPCM) : ModuleFile{MODULE_MOD}
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 	if (fd.seek(20, SEEK_SET) != 20)
@@ -53,14 +129,15 @@ ModuleFile::ModuleFile(const modMOD_t &file) : ModuleFile{MODULE_MOD}
 	for (uint16_t i = 0; i < p_Header->nPatterns; i++)
 		p_Patterns[i] = new pattern_t(file, p_Header->nChannels);
 
-	modLoadPCM(fd);
+	if (loadPCM)
+		modLoadPCM(fd);
 	MinPeriod = 56;
 	MaxPeriod = 7040;
 }
 
-ModuleFile::ModuleFile(const modS3M_t &file) : ModuleFile{MODULE_S3M}
+ModuleFile::ModuleFile(const modS3M_t &file, const bool loadPCM) : ModuleFile{MODULE_S3M}
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 	p_Samples = new ModuleSample *[p_Header->nSamples];
@@ -96,14 +173,15 @@ ModuleFile::ModuleFile(const modS3M_t &file) : ModuleFile{MODULE_S3M}
 		p_Patterns[i] = new pattern_t(file, p_Header->nChannels);
 	}
 
-	s3mLoadPCM(fd);
+	if (loadPCM)
+		s3mLoadPCM(fd);
 	MinPeriod = 64;
 	MaxPeriod = 32767;
 }
 
-ModuleFile::ModuleFile(const modSTM_t &file) : ModuleFile{MODULE_STM}
+ModuleFile::ModuleFile(const modSTM_t &file, const bool loadPCM) : ModuleFile{MODULE_STM}
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 	p_Samples = new ModuleSample *[p_Header->nSamples];
@@ -120,7 +198,8 @@ ModuleFile::ModuleFile(const modSTM_t &file) : ModuleFile{MODULE_STM}
 	if (fd.seek(pcmOffset, SEEK_SET) != pcmOffset)
 		throw ModuleLoaderError{E_BAD_STM};
 
-	stmLoadPCM(fd);
+	if (loadPCM)
+		stmLoadPCM(fd);
 	MinPeriod = 64;
 	MaxPeriod = 32767;
 }
@@ -129,13 +208,13 @@ ModuleFile::ModuleFile(const modSTM_t &file) : ModuleFile{MODULE_STM}
 // http://eab.abime.net/showthread.php?t=21516
 // ftp://ftp.modland.com/pub/documents/format_documentation/Art%20Of%20Noise%20(.aon).txt
 #ifdef ENABLE_AON
-ModuleFile::ModuleFile(const modAON_t &file) : ModuleFile{MODULE_AON}
+ModuleFile::ModuleFile(const modAON_t &file, const bool loadPCM) : ModuleFile{MODULE_AON}
 {
 	std::array<char, 4> blockName{};
 	uint32_t blockLen = 0;
 	uint32_t i, SampleLengths;
 	uint8_t ChannelMul;
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 
@@ -204,24 +283,25 @@ ModuleFile::ModuleFile(const modAON_t &file) : ModuleFile{MODULE_AON}
 		blockLen != SampleLengths)
 		throw ModuleLoaderError{E_BAD_AON};
 
-	aonLoadPCM(fd);
+	if (loadPCM)
+		aonLoadPCM(fd);
 	MinPeriod = 56;
 	MaxPeriod = 7040;
 }
 #endif // ENABLE_AON
 
 #ifdef ENABLE_FC1x
-ModuleFile::ModuleFile(const modFC1x_t &file) : ModuleFile{MODULE_FC1x}
+ModuleFile::ModuleFile(const modFC1x_t &file, const bool) : ModuleFile{MODULE_FC1x}
 {
-//	const fd_t &fd = file.fd();
+//	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 }
 #endif
 
-ModuleFile::ModuleFile(const modIT_t &file) : ModuleFile{MODULE_IT}
+ModuleFile::ModuleFile(const modIT_t &file, const bool loadPCM) : ModuleFile{MODULE_IT}
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	p_Header = new ModuleHeader(file);
 	if (p_Header->nInstruments)
@@ -279,7 +359,8 @@ ModuleFile::ModuleFile(const modIT_t &file) : ModuleFile{MODULE_IT}
 		}
 	}
 
-	itLoadPCM(fd);
+	if (loadPCM)
+		itLoadPCM(fd);
 	MinPeriod = 8;
 	MaxPeriod = 61440;//32767;
 }
@@ -340,7 +421,7 @@ uint8_t ModuleFile::channels() const noexcept
 	return (p_Header->MasterVolume & 0x80) ? 2 : 1;
 }
 
-void ModuleFile::modLoadPCM(const fd_t &fd)
+void ModuleFile::modLoadPCM(const inputSource_t &fd)
 {
 	p_PCM = new uint8_t *[p_Header->nSamples];
 	memset(p_PCM, 0, sizeof(uint8_t *) * p_Header->nSamples);
@@ -384,7 +465,7 @@ void ModuleFile::modLoadPCM(const fd_t &fd)
 	}
 }
 
-void ModuleFile::s3mLoadPCM(const fd_t &fd)
+void ModuleFile::s3mLoadPCM(const inputSource_t &fd)
 {
 	p_PCM = new uint8_t *[p_Header->nSamples];
 	memset(p_PCM, 0, sizeof(uint8_t *) * p_Header->nSamples);
@@ -420,7 +501,7 @@ void ModuleFile::s3mLoadPCM(const fd_t &fd)
 	}
 }
 
-void ModuleFile::stmLoadPCM(const fd_t &fd)
+void ModuleFile::stmLoadPCM(const inputSource_t &fd)
 {
 	p_PCM = new uint8_t *[p_Header->nSamples];
 	memset(p_PCM, 0, sizeof(uint8_t *) * p_Header->nSamples);
@@ -439,7 +520,7 @@ void ModuleFile::stmLoadPCM(const fd_t &fd)
 	}
 }
 
-void ModuleFile::aonLoadPCM(const fd_t &fd)
+void ModuleFile::aonLoadPCM(const inputSource_t &fd)
 {
 	p_PCM = new uint8_t *[nPCM];
 	memset(p_PCM, 0, sizeof(uint8_t *) * nPCM);
@@ -457,33 +538,69 @@ void ModuleFile::aonLoadPCM(const fd_t &fd)
 	}
 }
 
-uint32_t itBitstreamRead(uint8_t &buff, uint8_t &buffLen, const fd_t &fd, size_t bits)
+/*!
+ * @internal
+ * Reads the bitstream of an IT compressed sample, taking its bytes straight out of
+ * the input source's data rather than reading them from the file one at a time
+ */
+struct itBitstream_t final
 {
-	uint32_t ret = 0;
-	if (bits > 0)
+private:
+	const inputSource_t &file;
+	substrate::span<const uint8_t> data{};
+	size_t used{0};
+	uint8_t buff{0};
+	uint8_t buffLen{0};
+
+	uint8_t nextByte()
 	{
+		if (used == data.size())
+		{
+			if (!file.seekRel(off_t(used)))
+				throw ModuleLoaderError{E_BAD_IT};
+			used = 0;
+			data = file.view(inputSource_t::windowSize);
+			if (data.empty())
+				throw ModuleLoaderError{E_BAD_IT};
+		}
+		return data[used++];
+	}
+
+public:
+	itBitstream_t(const inputSource_t &source) noexcept : file{source} { }
+	itBitstream_t(const itBitstream_t &) = delete;
+	itBitstream_t(itBitstream_t &&) = delete;
+	itBitstream_t &operator =(const itBitstream_t &) = delete;
+	itBitstream_t &operator =(itBitstream_t &&) = delete;
+	// Leave the file just past the bytes consumed so a following channel's data is read from the right place
+	~itBitstream_t() noexcept { file.seekRel(off_t(used)); }
+
+	bool isEOF() const noexcept { return file.isEOF(); }
+	void reset() noexcept { buffLen = 0; }
+
+	uint32_t read(const size_t bits)
+	{
+		uint32_t ret = 0;
 		for (size_t i = 0; i < bits; ++i)
 		{
 			if (buffLen == 0)
 			{
-				if (!fd.read(buff))
-					throw ModuleLoaderError{E_BAD_IT};
+				buff = nextByte();
 				buffLen = 8;
 			}
 			ret |= (buff & 1U) << i;
 			buff >>= 1U;
 			buffLen--;
 		}
+		return ret;
 	}
-	return ret;
-}
+};
 
-template<typename T> void itUnpackPCM(ModuleSample *sample, T *PCM, const fd_t &fd, bool deltaComp);
+template<typename T> void itUnpackPCM(ModuleSample *sample, T *PCM, const inputSource_t &fd, bool deltaComp);
 
-template<> void itUnpackPCM<uint8_t>(ModuleSample *sample, uint8_t *PCM, const fd_t &fd, const bool deltaComp)
+template<> void itUnpackPCM<uint8_t>(ModuleSample *sample, uint8_t *PCM, const inputSource_t &fd, const bool deltaComp)
 {
-	uint8_t buff = 0;
-	uint8_t buffLen = 0;
+	itBitstream_t stream{fd};
 	uint8_t bitWidth = 9;
 	int8_t delta = 0;
 	int8_t adjDelta = 0;
@@ -495,9 +612,9 @@ template<> void itUnpackPCM<uint8_t>(ModuleSample *sample, uint8_t *PCM, const f
 		if (blockLen == 0)
 		{
 			blockLen = 0x8000;
-			buffLen = 0;
+			stream.reset();
 			// First we ignore 16 bits..
-			itBitstreamRead(buff, buffLen, fd, 16);
+			stream.read(16);
 			bitWidth = 9;
 			delta = 0;
 			adjDelta = 0;
@@ -516,15 +633,15 @@ template<> void itUnpackPCM<uint8_t>(ModuleSample *sample, uint8_t *PCM, const f
 		uint32_t offs = 0;
 		do
 		{
-			auto bits = itBitstreamRead(buff, buffLen, fd, bitWidth) & 0x0000FFFFU;
-			if (fd.isEOF())
+			auto bits = stream.read(bitWidth) & 0x0000FFFFU;
+			if (stream.isEOF())
 				return;
 			if (bitWidth < 7)
 			{
 				uint16_t special = 1U << (bitWidth - 1U);
 				if (bits == special)
 				{
-					const auto specialBits = static_cast<uint8_t>(itBitstreamRead(buff, buffLen, fd, 3) + 1U);
+					const auto specialBits = static_cast<uint8_t>(stream.read(3) + 1U);
 					if (specialBits < bitWidth)
 						bitWidth = specialBits;
 					else
@@ -575,10 +692,9 @@ template<> void itUnpackPCM<uint8_t>(ModuleSample *sample, uint8_t *PCM, const f
 	}
 }
 
-template<> void itUnpackPCM<uint16_t>(ModuleSample *sample, uint16_t *PCM, const fd_t &fd, const bool deltaComp)
+template<> void itUnpackPCM<uint16_t>(ModuleSample *sample, uint16_t *PCM, const inputSource_t &fd, const bool deltaComp)
 {
-	uint8_t buff = 0;
-	uint8_t buffLen = 0;
+	itBitstream_t stream{fd};
 	uint8_t bitWidth = 17;
 	int16_t delta = 0;
 	int16_t adjDelta = 0;
@@ -590,9 +706,9 @@ template<> void itUnpackPCM<uint16_t>(ModuleSample *sample, uint16_t *PCM, const
 		if (blockLen == 0)
 		{
 			blockLen = 0x4000;
-			buffLen = 0;
+			stream.reset();
 			// First we ignore 16 bits
-			itBitstreamRead(buff, buffLen, fd, 16);
+			stream.read(16);
 			bitWidth = 17;
 			delta = 0;
 			adjDelta = 0;
@@ -611,15 +727,15 @@ template<> void itUnpackPCM<uint16_t>(ModuleSample *sample, uint16_t *PCM, const
 		uint32_t offs = 0;
 		do
 		{
-			if (fd.isEOF())
+			if (stream.isEOF())
 				return;
-			auto bits = itBitstreamRead(buff, buffLen, fd, bitWidth);
+			auto bits = stream.read(bitWidth);
 			if (bitWidth < 7)
 			{
 				uint32_t special = 1U << (bitWidth - 1U);
 				if (bits == special)
 				{
-					const auto specialBits = static_cast<uint8_t>(itBitstreamRead(buff, buffLen, fd, 4) + 1U);
+					const auto specialBits = static_cast<uint8_t>(stream.read(4) + 1U);
 					if (specialBits < bitWidth)
 						bitWidth = specialBits;
 					else
@@ -693,7 +809,7 @@ template<typename T> void stereoInterleave(T *pcmIn, T *pcmOut, const size_t len
 	}
 }
 
-template<typename T> void ModuleFile::itLoadPCMSample(const fd_t &fd, const uint32_t i)
+template<typename T> void ModuleFile::itLoadPCMSample(const inputSource_t &fd, const uint32_t i)
 {
 	auto *const Sample = dynamic_cast<ModuleSampleNative *>(p_Samples[i]);
 	const size_t Length = p_Samples[i]->GetLength() << (Sample->GetStereo() ? 1U : 0U);
@@ -725,7 +841,7 @@ template<typename T> void ModuleFile::itLoadPCMSample(const fd_t &fd, const uint
 		p_PCM[i] = reinterpret_cast<uint8_t *>(pcm.release());
 }
 
-void ModuleFile::itLoadPCM(const fd_t &fd)
+void ModuleFile::itLoadPCM(const inputSource_t &fd)
 {
 	p_PCM = new uint8_t *[p_Header->nSamples];
 	memset(p_PCM, 0, sizeof(uint8_t *) * p_Header->nSamples);
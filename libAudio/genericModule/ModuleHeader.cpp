@@ -14,7 +14,7 @@ ModuleHeader::ModuleHeader(const modMOD_t &file) : ModuleHeader{}
 	std::array<char, 4> magic{};
 	uint8_t orders_{};
 	uint8_t restartPos_{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	Name = make_unique<char []>(21);
 	Orders = make_unique<uint8_t []>(128);
@@ -74,7 +74,7 @@ ModuleHeader::ModuleHeader(const modS3M_t &file) : ModuleHeader{}
 	uint8_t Const{};
 	uint16_t Special{};
 	uint16_t rawFlags{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	Name = make_unique<char []>(29);
 	if (!Name ||
@@ -144,7 +144,7 @@ ModuleHeader::ModuleHeader(const modSTM_t &file) : ModuleHeader{}
 	std::array<char, 9> magic{};
 	std::array<char, 13> reserved{};
 	uint8_t patternCount_{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	nOrders = 128;
 	Name = make_unique<char []>(21);
@@ -186,7 +186,7 @@ ModuleHeader::ModuleHeader(const modAON_t &file) : ModuleHeader{}
 	std::array<char, 42> magic2{};
 	uint32_t blockLen = 0;
 	uint8_t Const{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(magic1) ||
 		!fd.read(magic2) ||
@@ -286,7 +286,7 @@ ModuleHeader::ModuleHeader(const modAON_t &file) : ModuleHeader{}
 ModuleHeader::ModuleHeader(const modFC1x_t &file) : ModuleHeader{}
 {
 	std::array<char, 4> fc1xMagic;
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(fc1xMagic) ||
 		(memcmp(fc1xMagic.data(), "SMOD", 4) != 0 &&
@@ -311,7 +311,7 @@ ModuleHeader::ModuleHeader(const modIT_t &file) : ModuleHeader{}
 	uint16_t msgLength{};
 	uint16_t songFlags{};
 	uint8_t Const{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(magic) ||
 		strncmp(magic.data(), "IMPM", 4) != 0)
@@ -43,7 +43,7 @@ ModuleOldInstrument::ModuleOldInstrument(const modIT_t &file, const uint32_t i)
 	uint8_t Const{};
 	std::array<char, 6> DontCare{};
 	std::array<char, 4> magic{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(magic) ||
 		strncmp(magic.data(), "IMPI", 4) != 0)
@@ -108,7 +108,7 @@ ModuleNewInstrument::ModuleNewInstrument(const modIT_t &file, const uint32_t i)
 	uint8_t Const{};
 	std::array<char, 6> DontCare{};
 	std::array<char, 4> magic{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(magic) || magic != itInstrumentMagic)
 		throw ModuleLoaderError{E_BAD_IT};
@@ -187,7 +187,7 @@ ModuleEnvelope &ModuleNewInstrument::GetEnvelope(const envelopeType_t env) const
 
 ModuleEnvelope::ModuleEnvelope(const modIT_t &file, const envelopeType_t env) : Type{env}
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	uint8_t DontCare{};
 
 	if (!fd.read(Flags) ||
@@ -25,7 +25,7 @@ pattern_t::pattern_t(const uint32_t _channels, const uint16_t rows, const uint32
 
 pattern_t::pattern_t(const modMOD_t &file, const uint32_t channels) : pattern_t{channels, 64, E_BAD_MOD}
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 	for (size_t row = 0; row < _rows; ++row)
 	{
 		for (size_t channel = 0; channel < channels; ++channel)
@@ -53,7 +53,7 @@ pattern_t::pattern_t(const modMOD_t &file, const uint32_t channels) : pattern_t{
 pattern_t::pattern_t(const modS3M_t &file, const uint32_t channels) : pattern_t{channels, 64, E_BAD_S3M}
 {
 	uint32_t length{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	for (uint32_t i = 0; i < channels; ++i)
 	{
@@ -118,7 +118,7 @@ pattern_t::pattern_t(const modS3M_t &file, const uint32_t channels) : pattern_t{
 
 pattern_t::pattern_t(const modSTM_t &file) : pattern_t(4, 64, E_BAD_STM)
 {
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	for (size_t row{}; row < _rows; ++row)
 	{
@@ -156,7 +156,7 @@ pattern_t::pattern_t(const modSTM_t &file) : pattern_t(4, 64, E_BAD_STM)
 pattern_t::pattern_t(const modAON_t &file, const uint32_t channels) : pattern_t{channels, 64, E_BAD_AON}
 {
 	using arithUInt = substrate::promoted_type_t<uint8_t>;
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 	for (size_t row{}; row < _rows; ++row)
 	{
 		for (size_t channel{}; channel < channels; ++channel)
@@ -186,7 +186,7 @@ pattern_t::pattern_t(const modAON_t &file, const uint32_t channels) : pattern_t{
 }
 #endif
 
-inline bool readInc(uint8_t &var, uint16_t &i, const uint16_t len, const fd_t &fd) noexcept
+inline bool readInc(uint8_t &var, uint16_t &i, const uint16_t len, const inputSource_t &fd) noexcept
 {
 	if (i > len || !fd.read(var))
 		return true;
@@ -200,7 +200,7 @@ pattern_t::pattern_t(const modIT_t &file, const uint32_t channels) : Channels{ch
 	std::array<uint8_t, 64> channelMask{};
 	uint16_t len{};
 	std::array<command_t, 64> lastCmd{};
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	_commands = fixedVector_t<commandPtr_t>(channels);
 	if (!_commands.valid() ||
@@ -13,7 +13,7 @@ ModuleSample *ModuleSample::LoadSample(const modMOD_t &file, const uint32_t i)
 
 ModuleSample *ModuleSample::LoadSample(const modS3M_t &file, const uint32_t i)
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	uint8_t type{};
 
 	if (!fd.read(type))
@@ -40,7 +40,7 @@ ModuleSampleNative::ModuleSampleNative(const modMOD_t &file, const uint32_t i) :
 	SamplePos{}, Packing{}, Flags{}, SampleFlags{}, C4Speed{8363U}, DefaultPan{}, VibratoSpeed{},
 	VibratoDepth{}, VibratoType{}, VibratoRate{}, SusLoopBegin{}, SusLoopEnd{}
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	uint16_t length16{};
 	uint16_t loopStart16{};
 	uint16_t loopEnd16{};
@@ -68,7 +68,7 @@ ModuleSampleNative::ModuleSampleNative(const modMOD_t &file, const uint32_t i) :
 		SampleFlags |= SAMPLE_FLAGS_LOOP;
 }
 
-bool readLE24b(const fd_t &fd, uint32_t &dest) noexcept
+bool readLE24b(const inputSource_t &fd, uint32_t &dest) noexcept
 {
 	std::array<uint8_t, 3> data{};
 	if (!fd.read(data))
@@ -83,7 +83,7 @@ ModuleSampleNative::ModuleSampleNative(const modS3M_t &file, const uint32_t i, c
 	FileName{make_unique_nothrow<char []>(13)}, SampleFlags{}, DefaultPan{}, VibratoSpeed{},
 	VibratoDepth{}, VibratoType{}, VibratoRate{}, SusLoopBegin{}, SusLoopEnd{}
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	std::array<uint8_t, 12> dontCare{};
 	std::array<char, 4> magic{};
 
@@ -128,7 +128,7 @@ ModuleSampleNative::ModuleSampleNative(const modSTM_t &file, const uint32_t i) :
 	Flags{}, SampleFlags{}, DefaultPan{}, VibratoSpeed{}, VibratoDepth{}, VibratoType{}, VibratoRate{},
 	SusLoopBegin{}, SusLoopEnd{}
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	uint8_t id{};
 	uint8_t disk{};
 	uint8_t reserved2{};
@@ -178,7 +178,7 @@ ModuleSampleNative::ModuleSampleNative(const modSTM_t &file, const uint32_t i) :
 ModuleSampleNative::ModuleSampleNative(const modAON_t &file, const uint32_t i, char *name, const uint32_t *const pcmLengths) : ModuleSample(i, 1), Name(name)
 {
 	uint8_t Type, ID;
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	if (!fd.read(Type) ||
 		!fd.read(Volume) ||
@@ -296,7 +296,7 @@ ModuleSampleNative::ModuleSampleNative(const modIT_t &file, const uint32_t i) :
 	Name{make_unique_nothrow<char []>(27)}, FineTune{}, FileName{make_unique_nothrow<char []>(13)},
 	SampleFlags{}
 {
-	const auto &fd{file.fd()};
+	const auto &fd{file.source()};
 	uint8_t _const{};
 	std::array<char, 4> magic{};
 
@@ -380,7 +380,7 @@ ModuleSampleAdlib::ModuleSampleAdlib(const modS3M_t &file, const uint32_t i, con
 	std::array<char, 4> magic;
 	std::array<uint8_t, 12> dontCare;
 	uint32_t zero;
-	const fd_t &fd = file.fd();
+	const inputSource_t &fd = file.source();
 
 	Name = new char[29];
 	FileName = new char[13];
@@ -28,6 +28,7 @@ struct ModuleFile;
 struct channel_t;
 struct ModuleSample;
 struct pattern_t;
+struct mixerPool_t;
 
 using stringPtr_t = std::unique_ptr<char []>;
 
@@ -656,6 +657,8 @@ private:
 	uint8_t PatternDelay, FrameDelay;
 	int32_t MixBuffer[mixBufferSize * 2];
 	int DCOffsR, DCOffsL;
+	std::unique_ptr<mixerPool_t> mixerPool;
+	moduleResampling_t resamplingMode;
 
 	constexpr ModuleFile(uint8_t moduleType) noexcept;
 
@@ -683,35 +686,38 @@ private:
 	// Mixing functions
 	inline void FixDCOffset(int *p_DCOffsL, int *p_DCOffsR, int *buff, uint32_t samples);
 	void DCFixingFill(uint32_t samples);
+	[[nodiscard]] uint32_t resamplingFlags() const noexcept;
 	void CreateStereoMix(uint32_t count);
+	void mixChannel(channel_t &channel, int32_t *buff, uint32_t count, int &dcOffsL, int &dcOffsR);
 	inline void MonoFromStereo(uint32_t count);
 
 private:
-	void modLoadPCM(const fd_t &fd);
-	void s3mLoadPCM(const fd_t &fd);
-	void stmLoadPCM(const fd_t &fd);
-	void aonLoadPCM(const fd_t &fd);
-	void itLoadPCM(const fd_t &fd);
+	void modLoadPCM(const inputSource_t &fd);
+	void s3mLoadPCM(const inputSource_t &fd);
+	void stmLoadPCM(const inputSource_t &fd);
+	void aonLoadPCM(const inputSource_t &fd);
+	void itLoadPCM(const inputSource_t &fd);
 	friend struct channel_t;
+	friend struct mixerPool_t;
 
 	// Scans through the track looking for loops, and makes the position jump/pattern break instructions
 	// that cause them disabled, so they don't play a role in the played tune. Additionally calculates track
 	// run length because why not while we're already doing all that work?
 	void loopScanPatterns(fileInfo_t &info);
 
-	template<typename T> void itLoadPCMSample(const fd_t &fd, uint32_t i);
+	template<typename T> void itLoadPCMSample(const inputSource_t &fd, uint32_t i);
 
 public:
-	ModuleFile(const modMOD_t &file);
-	ModuleFile(const modS3M_t &file);
-	ModuleFile(const modSTM_t &file);
+	ModuleFile(const modMOD_t &file, bool loadPCM = true);
+	ModuleFile(const modS3M_t &file, bool loadPCM = true);
+	ModuleFile(const modSTM_t &file, bool loadPCM = true);
 #ifdef ENABLE_AON
-	ModuleFile(const modAON_t &file);
+	ModuleFile(const modAON_t &file, bool loadPCM = true);
 #endif
 #ifdef ENABLE_FC1x
-	ModuleFile(const modFC1x_t &file);
+	ModuleFile(const modFC1x_t &file, bool loadPCM = true);
 #endif
-	ModuleFile(const modIT_t &file);
+	ModuleFile(const modIT_t &file, bool loadPCM = true);
 	ModuleFile(const ModuleFile &) noexcept = delete;
 	ModuleFile(ModuleFile &&) noexcept = default;
 	virtual ~ModuleFile();
@@ -723,8 +729,13 @@ public:
 	[[nodiscard]] stringPtr_t remark() const noexcept;
 	[[nodiscard]] uint8_t channels() const noexcept;
 	void InitMixer(fileInfo_t &info);
+	void scanLength(fileInfo_t &info);
 	[[nodiscard]] bool isMixerInitialised() const noexcept { return Channels != nullptr && MixerChannels != nullptr; }
 	[[nodiscard]] int32_t Mix(uint8_t *Buffer, uint32_t BuffLen);
+	bool mixerThreads(uint32_t threads) noexcept;
+	[[nodiscard]] uint32_t mixerThreads() const noexcept;
+	bool resampling(moduleResampling_t mode) noexcept;
+	[[nodiscard]] moduleResampling_t resampling() const noexcept { return resamplingMode; }
 
 	[[nodiscard]] uint32_t ticks() const noexcept { return TickCount; }
 	[[nodiscard]] uint32_t speed() const noexcept { return MusicSpeed; }
@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <utility>
+#ifndef _WINDOWS
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+#include <substrate/utility>
+#include "inputSource.hxx"
+
+/*!
+ * @internal
+ * @file inputSource.cxx
+ * @brief The implementation of the mapped, buffered, in-memory and callbacks decoder input sources
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using substrate::fd_t;
+using substrate::span;
+using substrate::make_unique_nothrow;
+
+/*!
+ * @internal
+ * Sets up a source reading from \p file, mapping it into memory if the platform and file allow
+ * that and falling back to buffered reads if not
+ */
+inputSource_t::inputSource_t(fd_t &&file) noexcept : inputSource_t{std::move(file), backend_t::mapped}
+{
+	if (!valid() && _file.valid())
+		_backend = backend_t::buffered;
+}
+
+/*!
+ * @internal
+ * Sets up a source reading from \p file using exactly the backend given, which is left
+ * invalid if that backend can't be used for the file
+ */
+inputSource_t::inputSource_t(fd_t &&file, const backend_t backend) noexcept : _file{std::move(file)}
+{
+	if (!_file.valid())
+		return;
+	_length = _file.length();
+	if (_length == -1)
+	{
+		_length = 0;
+		return;
+	}
+	if (backend == backend_t::mapped && map())
+		_backend = backend_t::mapped;
+	else if (backend == backend_t::buffered)
+		_backend = backend_t::buffered;
+}
+
+/*!
+ * @internal
+ * Sets up a source over the \p length bytes at \p data, which must outlive the source
+ */
+inputSource_t::inputSource_t(const void *const data, const size_t length) noexcept :
+	_backend{data ? backend_t::memory : backend_t::none}, _data{static_cast<const uint8_t *>(data)},
+	_length{data ? off_t(length) : 0} { }
+
+/*!
+ * @internal
+ * Sets up a source that reads through the I/O operations in \p callbacks, which is left
+ * invalid if the required operations are missing or the length of the data can't be found
+ */
+inputSource_t::inputSource_t(const callbacks_t &callbacks) noexcept : _callbacks{callbacks}
+{
+	if (!_callbacks.read || !_callbacks.seek)
+		return;
+	_length = callbackLength();
+	if (_length < 0)
+	{
+		_length = 0;
+		return;
+	}
+	_backend = backend_t::callbacks;
+}
+
+inputSource_t::inputSource_t(inputSource_t &&source) noexcept : inputSource_t{}
+	{ *this = std::move(source); }
+
+inputSource_t::~inputSource_t() noexcept { unmap(); }
+
+inputSource_t &inputSource_t::operator =(inputSource_t &&source) noexcept
+{
+	// Swapping hands our old mapping (if any) to the other source to be cleaned up
+	std::swap(_file, source._file);
+	std::swap(_backend, source._backend);
+	std::swap(_data, source._data);
+	std::swap(_length, source._length);
+	std::swap(_offset, source._offset);
+	std::swap(_eof, source._eof);
+	std::swap(_window, source._window);
+	std::swap(_windowOffset, source._windowOffset);
+	std::swap(_windowLength, source._windowLength);
+	std::swap(_callbacks, source._callbacks);
+	return *this;
+}
+
+bool inputSource_t::map() noexcept
+{
+#ifndef _WINDOWS
+	if (_length <= 0)
+		return false;
+	auto *const data{mmap(nullptr, size_t(_length), PROT_READ, MAP_PRIVATE, _file, 0)};
+	if (data == MAP_FAILED)
+		return false;
+	// The decoders stream through their files, so ask for aggressive read-ahead
+	posix_madvise(data, size_t(_length), POSIX_MADV_SEQUENTIAL);
+	_data = static_cast<const uint8_t *>(data);
+	return true;
+#else
+	return false;
+#endif
+}
+
+void inputSource_t::unmap() noexcept
+{
+#ifndef _WINDOWS
+	if (_backend == backend_t::mapped && _data)
+		munmap(const_cast<uint8_t *>(_data), size_t(_length));
+#endif
+	_data = nullptr;
+}
+
+/*!
+ * @internal
+ * Works out the length of a callbacks-backed source's data, asking for it directly if
+ * possible, and otherwise by seeking to the end and then back to where the data started
+ * @return The length of the data, or -1 if it could not be determined
+ */
+off_t inputSource_t::callbackLength() const noexcept
+{
+	if (_callbacks.length)
+	{
+		// Any negative length is an error, not just the -1 the callback is documented to return
+		const auto length{_callbacks.length(_callbacks.user)};
+		return length < 0 ? -1 : off_t(length);
+	}
+	const auto start{_callbacks.tell ? _callbacks.tell(_callbacks.user) : 0};
+	const auto length{_callbacks.seek(_callbacks.user, 0, SEEK_END)};
+	if (start < 0 || length < 0 || _callbacks.seek(_callbacks.user, start, SEEK_SET) != start)
+		return -1;
+	return off_t(length);
+}
+
+/*!
+ * @internal
+ * Reads up to \p length bytes at \p offset in the data into \p buffer
+ * @return The number of bytes read, 0 at the end of the data, or -1 on error
+ */
+ssize_t inputSource_t::fillFrom(const off_t offset, uint8_t *const buffer, const size_t length) const noexcept
+{
+	if (_backend == backend_t::callbacks)
+	{
+		if (_callbacks.seek(_callbacks.user, offset, SEEK_SET) != offset)
+			return -1;
+		return ssize_t(_callbacks.read(_callbacks.user, buffer, length));
+	}
+#ifndef _WINDOWS
+	return pread(_file, buffer, length, offset);
+#else
+	return _file.seek(offset, SEEK_SET) == offset ? _file.read(buffer, length, nullptr) : -1;
+#endif
+}
+
+/*!
+ * @internal
+ * Refills the window with as much data as fits from the current possition
+ * @return \c true if any data could be read, otherwise \c false
+ */
+bool inputSource_t::fillWindow() const noexcept
+{
+	// Small files don't need a whole window's worth of memory
+	const auto capacity{std::min(windowSize, size_t(_length))};
+	if (!_window)
+	{
+		_window = make_unique_nothrow<uint8_t []>(capacity);
+		if (!_window)
+			return false;
+	}
+	const auto length{std::min(capacity, available())};
+	size_t filled{0U};
+	while (filled < length)
+	{
+		const auto result{fillFrom(_offset + off_t(filled), _window.get() + filled, length - filled)};
+		if (result <= 0)
+			break;
+		filled += size_t(result);
+	}
+	_windowOffset = _offset;
+	_windowLength = filled;
+	return filled != 0U;
+}
+
+/*!
+ * @internal
+ * Gets up to \p length bytes from the current possition without consuming them. For buffered
+ * and callbacks-backed sources the view is limited to the window size, so a shorter span than asked for does not
+ * mean the end of the data has been reached - only an empty one does.
+ * @return A span over the data, which remains valid until the next read from this source
+ */
+span<const uint8_t> inputSource_t::view(const size_t length) const noexcept
+{
+	const auto amount{std::min(length, available())};
+	if (!amount)
+		return {};
+	if (!windowed())
+		return {_data + _offset, amount};
+
+	const auto wanted{std::min(amount, windowSize)};
+	const auto windowEnd{_windowOffset + off_t(_windowLength)};
+	if ((_offset < _windowOffset || _offset + off_t(wanted) > windowEnd) && !fillWindow())
+		return {};
+	const auto start{size_t(_offset - _windowOffset)};
+	return {_window.get() + start, std::min(wanted, _windowLength - start)};
+}
+
+/*!
+ * @internal
+ * Gets up to \p length bytes from the current possition, consuming them
+ * @return A span over the data, which remains valid until the next read from this source
+ */
+span<const uint8_t> inputSource_t::take(const size_t length) const noexcept
+{
+	const auto data{view(length)};
+	_offset += off_t(data.size());
+	return data;
+}
+
+size_t inputSource_t::copy(void *const buffer, const size_t length) const noexcept
+{
+	auto *const result{static_cast<uint8_t *>(buffer)};
+	size_t copied{0U};
+	while (copied < length)
+	{
+		const auto data{take(length - copied)};
+		if (data.empty())
+			break;
+		std::memcpy(result + copied, data.data(), data.size());
+		copied += data.size();
+	}
+	return copied;
+}
+
+off_t inputSource_t::seek(const off_t offset, const int32_t whence) const noexcept
+{
+	if (!valid())
+	{
+		errno = EBADF;
+		return -1;
+	}
+	off_t position{offset};
+	if (whence == SEEK_CUR)
+		position += _offset;
+	else if (whence == SEEK_END)
+		position += _length;
+	else if (whence != SEEK_SET)
+		position = -1;
+	if (position < 0)
+	{
+		errno = EINVAL;
+		return -1;
+	}
+	_offset = position;
+	_eof = false;
+	return position;
+}
+
+/*!
+ * @internal
+ * Reads up to \p length bytes into \p buffer, as a read() on the file itself would
+ * @return The number of bytes read, 0 at the end of the data, or -1 if the source is invalid
+ */
+ssize_t inputSource_t::read(void *const buffer, const size_t length, std::nullptr_t) const noexcept
+{
+	if (!valid())
+		return -1;
+	const auto result{copy(buffer, length)};
+	if (!result && length)
+		_eof = true;
+	return ssize_t(result);
+}
+
+bool inputSource_t::read(void *const buffer, const size_t length, size_t &actualLength) const noexcept
+{
+	const auto result{read(buffer, length, nullptr)};
+	actualLength = result < 0 ? 0U : size_t(result);
+	return result >= 0;
+}
+
+bool inputSource_t::read(void *const buffer, const size_t length) const noexcept
+{
+	if (!valid())
+		return false;
+	const auto result{copy(buffer, length)};
+	if (result != length)
+		_eof = true;
+	return result == length;
+}
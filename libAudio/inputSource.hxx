@@ -0,0 +1,185 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef INPUT_SOURCE_HXX
+#define INPUT_SOURCE_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <memory>
+#include <type_traits>
+#include <substrate/fd>
+#include <substrate/managed_ptr>
+#include <substrate/span>
+#include <substrate/buffer_utils>
+#include "libAudio.h"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+//  needs to have dll-interface to be used by clients of struct 'inputSource_t'
+#pragma warning(disable:4251)
+#endif
+
+/*!
+ * @internal
+ * Where a decoder's data comes from. Files are memory mapped where possible, and otherwise read
+ * through a large window with pread() so that each refill costs one syscall. Data that is already
+ * in memory is used where it lies, and data that can only be got at through a set of I/O
+ * callbacks is read through the same window as for buffered files.
+ *
+ * The reading interface mirrors the read side of substrate::fd_t so the loaders' parsing is
+ * unchanged, while view() and take() hand out the data in place for the paths that consume
+ * it in bulk, so those need no buffers (or copies) of their own.
+ *
+ * It is exported as audioFile_t::openR() and audioFile_t::probeInfo() take sources made outside
+ * the library.
+ */
+struct libAUDIO_CLS_API inputSource_t final
+{
+public:
+	enum class backend_t : uint8_t
+	{
+		none,
+		mapped,
+		buffered,
+		memory,
+		callbacks
+	};
+
+	/*!
+	 * @internal
+	 * The I/O operations of a callbacks-backed source, which match the \c audioOpenRCallbacks() API.
+	 * \c read and \c seek are required, \c tell and \c length are optional.
+	 */
+	struct callbacks_t final
+	{
+		int64_t (*read)(void *user, void *buffer, size_t length){nullptr};
+		int64_t (*seek)(void *user, int64_t offset, int whence){nullptr};
+		int64_t (*tell)(void *user){nullptr};
+		int64_t (*length)(void *user){nullptr};
+		void *user{nullptr};
+	};
+
+	constexpr static size_t windowSize{1048576U};
+
+private:
+	substrate::fd_t _file{};
+	backend_t _backend{backend_t::none};
+	const uint8_t *_data{nullptr};
+	off_t _length{0};
+	mutable off_t _offset{0};
+	mutable bool _eof{false};
+	mutable std::unique_ptr<uint8_t []> _window{};
+	mutable off_t _windowOffset{0};
+	mutable size_t _windowLength{0U};
+	callbacks_t _callbacks{};
+
+	[[nodiscard]] bool map() noexcept;
+	[[nodiscard]] off_t callbackLength() const noexcept;
+	[[nodiscard]] bool windowed() const noexcept
+		{ return _backend == backend_t::buffered || _backend == backend_t::callbacks; }
+	[[nodiscard]] ssize_t fillFrom(off_t offset, uint8_t *buffer, size_t length) const noexcept;
+	void unmap() noexcept;
+	[[nodiscard]] bool fillWindow() const noexcept;
+	[[nodiscard]] size_t available() const noexcept
+		{ return _offset < _length ? size_t(_length - _offset) : 0U; }
+	[[nodiscard]] size_t copy(void *buffer, size_t length) const noexcept;
+
+	template<typename T> using integral_t = std::make_unsigned_t<
+		typename std::conditional_t<std::is_enum_v<T>, std::underlying_type<T>, std::enable_if<true, T>>::type>;
+
+public:
+	inputSource_t() noexcept = default;
+	// Deliberately implicit so an opened file can be handed straight to a loader
+	inputSource_t(substrate::fd_t &&file) noexcept; // NOLINT(google-explicit-constructor)
+	inputSource_t(substrate::fd_t &&file, backend_t backend) noexcept;
+	inputSource_t(const void *data, size_t length) noexcept;
+	explicit inputSource_t(const callbacks_t &callbacks) noexcept;
+	inputSource_t(inputSource_t &&source) noexcept;
+	~inputSource_t() noexcept;
+	inputSource_t &operator =(inputSource_t &&source) noexcept;
+	inputSource_t(const inputSource_t &) = delete;
+	inputSource_t &operator =(const inputSource_t &) = delete;
+
+	[[nodiscard]] bool valid() const noexcept { return _backend != backend_t::none; }
+	[[nodiscard]] backend_t backend() const noexcept { return _backend; }
+	[[nodiscard]] off_t length() const noexcept { return _length; }
+	[[nodiscard]] off_t tell() const noexcept { return _offset; }
+	[[nodiscard]] bool isEOF() const noexcept { return _eof; }
+	off_t seek(off_t offset, int32_t whence) const noexcept;
+	bool seekRel(const off_t offset) const noexcept { return seek(offset, SEEK_CUR) != -1; }
+	bool head() const noexcept { return seek(0, SEEK_SET) == 0; }
+
+	[[nodiscard]] substrate::span<const uint8_t> view(size_t length) const noexcept;
+	[[nodiscard]] substrate::span<const uint8_t> take(size_t length) const noexcept;
+
+	[[nodiscard]] ssize_t read(void *buffer, size_t length, std::nullptr_t) const noexcept;
+	[[nodiscard]] bool read(void *buffer, size_t length, size_t &actualLength) const noexcept;
+	[[nodiscard]] bool read(void *buffer, size_t length) const noexcept;
+
+	template<typename T> bool read(T &value) const noexcept
+	{
+		static_assert(std::is_trivially_copyable_v<T>, "Values must be plain data to be read");
+		return read(&value, sizeof(T));
+	}
+
+	template<typename T> bool read(const std::unique_ptr<T> &value, const size_t length) const noexcept
+		{ return read(value.get(), length); }
+	template<typename T> bool read(const std::unique_ptr<T []> &value, const size_t count) const noexcept
+		{ return read(value.get(), sizeof(T) * count); }
+	template<typename T> bool read(const substrate::managedPtr_t<T> &value, const size_t length) const noexcept
+		{ return read(value.get(), length); }
+	template<typename T, size_t N> bool read(std::array<T, N> &value) const noexcept
+		{ return read(value.data(), sizeof(T) * N); }
+	template<size_t length, typename T, size_t N> bool read(std::array<T, N> &value) const noexcept
+	{
+		static_assert(length <= N, "Can't read more than the array can hold");
+		return read(value.data(), sizeof(T) * length);
+	}
+	template<typename T> bool read(const substrate::span<T> &value) const noexcept
+		{ return read(value.data(), value.size_bytes()); }
+
+	template<typename T> bool readLE(T &value) const noexcept
+	{
+		std::array<uint8_t, sizeof(T)> data{};
+		if (!read(data))
+			return false;
+		value = static_cast<T>(substrate::buffer_utils::readLE<integral_t<T>>(data.data()));
+		return true;
+	}
+
+	template<typename T> bool readBE(T &value) const noexcept
+	{
+		std::array<uint8_t, sizeof(T)> data{};
+		if (!read(data))
+			return false;
+		value = static_cast<T>(substrate::buffer_utils::readBE<integral_t<T>>(data.data()));
+		return true;
+	}
+
+	template<typename T, size_t N> bool readLE(std::array<T, N> &value) const noexcept
+	{
+		for (auto &element : value)
+		{
+			if (!readLE(element))
+				return false;
+		}
+		return true;
+	}
+
+	template<typename T, size_t N> bool readBE(std::array<T, N> &value) const noexcept
+	{
+		for (auto &element : value)
+		{
+			if (!readBE(element))
+				return false;
+		}
+		return true;
+	}
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif /*INPUT_SOURCE_HXX*/
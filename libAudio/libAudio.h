@@ -84,6 +84,44 @@ inline std::make_signed_t<size_t> read(const int32_t fd, void *const buffer, con
 
 struct fileInfo_t;
 
+/*!
+ * Tuning for the encoders, to trade CPU time against output size and quality.
+ * Only the options whose AUDIO_OPTION_* bit is set in \c options are applied, so a zero
+ * initialised encoderOptions_t leaves an encoder on its defaults. Options a codec has no
+ * equivalent for are ignored.
+ */
+struct encoderOptions_t
+{
+	/*! Bitmask of AUDIO_OPTION_* values saying which of the following fields are set */
+	uint32_t options;
+	/*! Target quality for VBR encoding, from 0 (smallest) to 1 (best) */
+	float quality;
+	/*! Target bitrate in bits per second */
+	uint32_t bitRate;
+	/*! Codec-specific compression level, such as FLAC's 0-8 or LAME's -q 0-9 */
+	uint8_t compressionLevel;
+	/*! Codec-specific encoder complexity, such as Opus's 0-10 */
+	uint8_t complexity;
+	/*! How many threads the encoder may use, where the codec supports this */
+	uint8_t threads;
+};
+
+/*!
+ * I/O callbacks for decoding audio from somewhere other than a file, as used by \c audioOpenRCallbacks().
+ * Each is passed the \c user pointer given when the file was opened.
+ * read() returns how many bytes it read into \p buffer, 0 at the end of the data or -1 on error.
+ * seek() moves as \c lseek() would, and returns the new possition or -1 on error.
+ * tell() returns the current possition, and length() the total length of the data.
+ */
+// NOLINTNEXTLINE(modernize-use-using)
+typedef int64_t (*audioReadCallback_t)(void *user, void *buffer, size_t length);
+// NOLINTNEXTLINE(modernize-use-using)
+typedef int64_t (*audioSeekCallback_t)(void *user, int64_t offset, int whence);
+// NOLINTNEXTLINE(modernize-use-using)
+typedef int64_t (*audioTellCallback_t)(void *user);
+// NOLINTNEXTLINE(modernize-use-using)
+typedef int64_t (*audioLengthCallback_t)(void *user);
+
 #ifdef ENABLE_VORBIS
 // Ogg|Vorbis API
 libAUDIO_API bool isOggVorbis(const char *fileName);
@@ -204,8 +242,14 @@ libAUDIO_API int audioCloseFile(void *audioFile);
 
 // Read (Decode)
 libAUDIO_API void *audioOpenR(const char *fileName);
+libAUDIO_API void *audioOpenRMemory(const void *data, size_t length);
+libAUDIO_API void *audioOpenRCallbacks(audioReadCallback_t read, audioSeekCallback_t seek,
+	audioTellCallback_t tell, audioLengthCallback_t length, void *user);
 libAUDIO_API const fileInfo_t *audioGetFileInfo(void *audioFile);
 libAUDIO_API int64_t audioFillBuffer(void *audioFile, void *buffer, uint32_t length);
+libAUDIO_API bool audioOutputFormat(void *audioFile, uint8_t sampleFormat);
+libAUDIO_API bool audioSeek(void *audioFile, uint64_t sampleFrame);
+libAUDIO_API uint64_t audioTell(void *audioFile);
 
 // Playback
 libAUDIO_API void audioPlay(void *audioFile);
@@ -217,11 +261,13 @@ libAUDIO_API void audioDefaultLevel(float level);
 
 // Write (Encode)
 libAUDIO_API void *audioOpenW(const char *fileName, uint32_t audioType);
+libAUDIO_API void *audioOpenWOptions(const char *fileName, uint32_t audioType, const encoderOptions_t *options);
 libAUDIO_API bool audioSetFileInfo(void *audioFile, const fileInfo_t *fileInfo);
 libAUDIO_API int64_t audioWriteBuffer(void *audioFile, const void *buffer, int64_t length);
 
 libAUDIO_API uint64_t audioFileTotalTime(const fileInfo_t *fileInfo);
 libAUDIO_API uint32_t audioFileBitsPerSample(const fileInfo_t *fileInfo);
+libAUDIO_API uint8_t audioFileSampleFormat(const fileInfo_t *fileInfo);
 libAUDIO_API uint32_t audioFileBitRate(const fileInfo_t *fileInfo);
 libAUDIO_API uint8_t audioFileChannels(const fileInfo_t *fileInfo);
 libAUDIO_API const char *audioFileTitle(const fileInfo_t *fileInfo);
@@ -273,4 +319,32 @@ libAUDIO_API const char *audioFileOtherComment(const fileInfo_t *fileInfo, size_
 // NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
 #define AUDIO_SNDH			19
 
+// Output sample formats, all interleaved
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_SAMPLE_INT8		1
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_SAMPLE_INT16		2
+// 24-bit samples sign extended into 32-bit containers
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_SAMPLE_INT24		3
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_SAMPLE_INT32		4
+// Normalised to the range [-1, 1]
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_SAMPLE_FLOAT32	5
+
+// Encoder option selectors for encoderOptions_t::options
+
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_OPTION_QUALITY			0x01U
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_OPTION_BITRATE			0x02U
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_OPTION_COMPRESSION_LEVEL	0x04U
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_OPTION_COMPLEXITY			0x08U
+// NOLINTNEXTLINE(cppcoreguidelines-macro-usage)
+#define AUDIO_OPTION_THREADS			0x10U
+
 #endif /*LIB_AUDIO_H*/
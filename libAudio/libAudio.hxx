@@ -24,6 +24,7 @@
 #include <cstdint>
 #include <substrate/fd>
 #include "fileInfo.hxx"
+#include "inputSource.hxx"
 #include "playback.hxx"
 #include "libAudio.h"
 
@@ -39,6 +40,8 @@
 #endif
 
 using substrate::fd_t;
+struct audioProbe_t;
+struct audioFile_t;
 
 enum class audioType_t : uint8_t
 {
@@ -66,13 +69,19 @@ enum class audioType_t : uint8_t
 
 using fileIs_t = bool (*)(const char *);
 using fileOpenR_t = void *(*)(const char *);
-using fileOpenW_t = void *(*)(const char *);
+using fileOpenW_t = audioFile_t *(*)(const char *, const encoderOptions_t &);
 
 const fileInfo_t *audioFileInfo(void *audioFile);
 bool audioFileInfo(void *audioFile, const fileInfo_t *fileInfo);
 libAUDIO_CXX_API std::vector<std::string> audioOutputDevices();
 libAUDIO_CXX_API bool audioDefaultDevice(const std::string &device) noexcept;
 libAUDIO_CXX_API const std::string &audioDefaultDevice() noexcept;
+libAUDIO_CXX_API std::vector<std::string> audioPlaybackBackends();
+libAUDIO_CXX_API bool audioPlaybackBackend(const std::string &backend);
+libAUDIO_CXX_API std::string audioPlaybackBackend();
+libAUDIO_CXX_API bool audioReadInfo(const char *fileName, fileInfo_t &info) noexcept;
+libAUDIO_CXX_API bool audioModuleScanCache(const std::string &path);
+libAUDIO_CXX_API std::string audioModuleScanCache();
 
 struct audioModeRead_t { };
 struct audioModeWrite_t { };
@@ -84,18 +93,29 @@ protected:
 	audioType_t _type{};
 	fileInfo_t _fileInfo{};
 	fd_t _fd{};
+	inputSource_t _source{};
+	// The player's decoder thread works on the derived type's decoder state, so this
+	// has to be reset before that goes away, which playableFile_t takes care of
 	std::unique_ptr<playback_t> _player{};
+	encoderOptions_t _encoderOptions{};
 // NOLINTEND(cppcoreguidelines-non-private-member-variables-in-classes)
 
 	audioFile_t(audioType_t type, fd_t &&fd) noexcept : _type{type}, _fd{std::move(fd)} { }
+	audioFile_t(audioType_t type, inputSource_t &&source) noexcept : _type{type}, _source{std::move(source)} { }
 	virtual void ensurePlayable() noexcept = 0;
+	[[nodiscard]] virtual bool canOutput(sampleFormat_t) const noexcept { return false; }
+	[[nodiscard]] bool hasOption(const uint32_t option) const noexcept
+		{ return (_encoderOptions.options & option) == option; }
 
 public:
 	audioFile_t(audioFile_t &&) = default;
 	virtual ~audioFile_t() noexcept = default;
 	audioFile_t &operator =(audioFile_t &&) = default;
 	static audioFile_t *openR(const char *fileName) noexcept;
-	static audioFile_t *openW(const char *fileName) noexcept;
+	static audioFile_t *openR(inputSource_t &&source) noexcept;
+	static bool probeInfo(const char *fileName, fileInfo_t &info) noexcept;
+	static bool probeInfo(inputSource_t &&source, fileInfo_t &info) noexcept;
+	static audioFile_t *openW(const char *fileName, uint32_t audioType, const encoderOptions_t &options = {}) noexcept;
 	static bool isAudio(const char *fileName) noexcept;
 	static bool isAudio(int32_t fd) noexcept;
 	const fileInfo_t &fileInfo() const noexcept { return _fileInfo; }
@@ -103,23 +123,44 @@ public:
 	audioType_t type() const noexcept { return _type; }
 	const fd_t &fd() const noexcept { return _fd; }
 	void fd(fd_t &&fd) noexcept { _fd = std::move(fd); }
+	const inputSource_t &source() const noexcept { return _source; }
 	void player(std::unique_ptr<playback_t> &&player) noexcept { _player = std::move(player); }
+	const encoderOptions_t &encoderOptions() const noexcept { return _encoderOptions; }
 
 	libAUDIO_CLS_API virtual int64_t fillBuffer(void *buffer, uint32_t length) = 0;
 	libAUDIO_CLS_API virtual int64_t writeBuffer(const void *buffer, int64_t length);
 	libAUDIO_CLS_API virtual bool fileInfo(const fileInfo_t &fileInfo);
+	libAUDIO_CLS_API virtual bool seek(uint64_t sampleFrame);
+	libAUDIO_CLS_API virtual uint64_t tell() const noexcept;
+	libAUDIO_CLS_API bool outputFormat(sampleFormat_t format) noexcept;
 	libAUDIO_CLS_API bool playbackMode(playbackMode_t mode) noexcept;
+	libAUDIO_CLS_API bool playbackBuffers(uint32_t count, uint32_t length) noexcept;
+	libAUDIO_CLS_API bool playbackPrefill(uint32_t blocks) noexcept;
+	libAUDIO_CLS_API bool playbackBackend(const std::string &backend);
+	libAUDIO_CLS_API playbackStats_t playbackStats() const noexcept;
 	libAUDIO_CLS_API void playbackVolume(float level) noexcept;
 	libAUDIO_CLS_API void play();
 	libAUDIO_CLS_API void pause();
 	libAUDIO_CLS_API void stop();
+	libAUDIO_CLS_API void flushPlayback();
 
 	audioFile_t(const audioFile_t &) = delete;
 	audioFile_t &operator =(const audioFile_t &) = delete;
 };
 
+/*!
+ * The type decoders are actually made as when opened for reading. Only the most derived type's destructor
+ * runs before any of a decoder's state goes away, so this is where playback gets stopped, keeping the
+ * player's decoder thread from working on state that's being torn down under it
+ */
+template<typename T> struct playableFile_t final : public T
+{
+	using T::T;
+	~playableFile_t() noexcept final { this->_player.reset(); }
+};
+
 #ifdef ENABLE_VORBIS
-struct oggVorbis_t final : public audioFile_t
+struct oggVorbis_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -128,27 +169,33 @@ private:
 	std::unique_ptr<encoderContext_t> encoderCtx;
 
 	void ensurePlayable() noexcept override;
+	bool canOutput(sampleFormat_t format) const noexcept final;
 
 public:
-	oggVorbis_t(fd_t &&fd, audioModeRead_t) noexcept;
+	oggVorbis_t(inputSource_t &&source, audioModeRead_t) noexcept;
 	oggVorbis_t(fd_t &&fd, audioModeWrite_t) noexcept;
 	static oggVorbis_t *openR(const char *fileName) noexcept;
-	static oggVorbis_t *openW(const char *fileName) noexcept;
+	static oggVorbis_t *openR(inputSource_t &&source) noexcept;
+	static oggVorbis_t *openW(const char *fileName, const encoderOptions_t &options = {}) noexcept;
 	static bool isOggVorbis(const char *fileName) noexcept;
 	static bool isOggVorbis(int32_t fd) noexcept;
+	static bool isOggVorbis(const audioProbe_t &probe) noexcept;
 	decoderContext_t *decoderContext() const noexcept { return decoderCtx.get(); }
 	encoderContext_t *encoderContext() const noexcept { return encoderCtx.get(); }
-	bool valid() const noexcept { return (bool(decoderCtx) || bool(encoderCtx)) && _fd.valid(); }
+	bool valid() const noexcept
+		{ return (bool(decoderCtx) && _source.valid()) || (bool(encoderCtx) && _fd.valid()); }
 
 	using audioFile_t::fileInfo;
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 	int64_t writeBuffer(const void *buffer, int64_t length) final;
 	bool fileInfo(const fileInfo_t &fileInfo) final;
 };
 #endif // ENABLE_VORBIS
 
 #ifdef ENABLE_OPUS
-struct oggOpus_t final : public audioFile_t
+struct oggOpus_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -157,27 +204,33 @@ private:
 	std::unique_ptr<encoderContext_t> encoderCtx;
 
 	void ensurePlayable() noexcept override;
+	bool canOutput(sampleFormat_t format) const noexcept final;
 
 public:
-	oggOpus_t(fd_t &&fd, audioModeRead_t) noexcept;
+	oggOpus_t(inputSource_t &&source, audioModeRead_t) noexcept;
 	oggOpus_t(fd_t &&fd, audioModeWrite_t) noexcept;
 	static oggOpus_t *openR(const char *fileName) noexcept;
-	static oggOpus_t *openW(const char *fileName) noexcept;
+	static oggOpus_t *openR(inputSource_t &&source) noexcept;
+	static oggOpus_t *openW(const char *fileName, const encoderOptions_t &options = {}) noexcept;
 	static bool isOggOpus(const char *fileName) noexcept;
 	static bool isOggOpus(int32_t fd) noexcept;
+	static bool isOggOpus(const audioProbe_t &probe) noexcept;
 	decoderContext_t *decoderContext() const noexcept { return decoderCtx.get(); }
 	encoderContext_t *encoderContext() const noexcept { return encoderCtx.get(); }
-	bool valid() const noexcept { return (bool(decoderCtx) || bool(encoderCtx)) && _fd.valid(); }
+	bool valid() const noexcept
+		{ return (bool(decoderCtx) && _source.valid()) || (bool(encoderCtx) && _fd.valid()); }
 
 	using audioFile_t::fileInfo;
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 	int64_t writeBuffer(const void *buffer, int64_t length) final;
 	bool fileInfo(const fileInfo_t &fileInfo) final;
 };
 #endif // ENABLE_OPUS
 
 #ifdef ENABLE_FLAC
-struct flac_t final : public audioFile_t
+struct flac_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -186,50 +239,61 @@ private:
 	std::unique_ptr<encoderContext_t> encoderCtx;
 
 	void ensurePlayable() noexcept override;
+	bool canOutput(sampleFormat_t format) const noexcept final;
 
 public:
-	flac_t(fd_t &&fd, audioModeRead_t) noexcept;
+	flac_t(inputSource_t &&source, audioModeRead_t) noexcept;
 	flac_t(fd_t &&fd, audioModeWrite_t) noexcept;
 	static flac_t *openR(const char *fileName) noexcept;
-	static flac_t *openW(const char *fileName) noexcept;
+	static flac_t *openR(inputSource_t &&source) noexcept;
+	static flac_t *openW(const char *fileName, const encoderOptions_t &options = {}) noexcept;
 	static bool isFLAC(const char *fileName) noexcept;
 	static bool isFLAC(int32_t fd) noexcept;
+	static bool isFLAC(const audioProbe_t &probe) noexcept;
 	decoderContext_t *decoderContext() const noexcept { return decoderCtx.get(); }
 	encoderContext_t *encoderContext() const noexcept { return encoderCtx.get(); }
-	bool valid() const noexcept { return (bool(decoderCtx) || bool(encoderCtx)) && _fd.valid(); }
+	bool valid() const noexcept
+		{ return (bool(decoderCtx) && _source.valid()) || (bool(encoderCtx) && _fd.valid()); }
 
 	using audioFile_t::fileInfo;
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 	int64_t writeBuffer(const void *buffer, int64_t length) final;
 	bool fileInfo(const fileInfo_t &fileInfo) final;
 };
 #endif // ENABLE_FLAC
 
-struct wav_t final : public audioFile_t
+struct wav_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
 	std::unique_ptr<decoderContext_t> decoderCtx;
 
 	void ensurePlayable() noexcept override;
+	bool canOutput(sampleFormat_t format) const noexcept final;
 
 	bool skipToChunk(const std::array<char, 4> &chunkName) const noexcept;
 	bool readFormat() noexcept;
 
 public:
 	wav_t() noexcept;
-	wav_t(fd_t &&fd) noexcept;
+	wav_t(inputSource_t &&source) noexcept;
 	static wav_t *openR(const char *fileName) noexcept;
+	static wav_t *openR(inputSource_t &&source) noexcept;
 	static bool isWAV(const char *fileName) noexcept;
 	static bool isWAV(int32_t fd) noexcept;
+	static bool isWAV(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 };
 
 #ifdef ENABLE_M4A
-struct m4a_t final : public audioFile_t
+struct m4a_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -240,24 +304,29 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	m4a_t(fd_t &&fd, audioModeRead_t) noexcept;
+	m4a_t(inputSource_t &&source, audioModeRead_t) noexcept;
 	m4a_t(fd_t &&fd, audioModeWrite_t) noexcept;
 	static m4a_t *openR(const char *fileName) noexcept;
-	static m4a_t *openW(const char *fileName) noexcept;
+	static m4a_t *openR(inputSource_t &&source) noexcept;
+	static m4a_t *openW(const char *fileName, const encoderOptions_t &options = {}) noexcept;
 	static bool isM4A(const char *fileName) noexcept;
 	static bool isM4A(int32_t fd) noexcept;
+	static bool isM4A(const audioProbe_t &probe) noexcept;
 	decoderContext_t *decoderContext() const noexcept { return decoderCtx.get(); }
 	encoderContext_t *encoderContext() const noexcept { return encoderCtx.get(); }
-	bool valid() const noexcept { return (bool(decoderCtx) || bool(encoderCtx)) && _fd.valid(); }
+	bool valid() const noexcept
+		{ return (bool(decoderCtx) && _source.valid()) || (bool(encoderCtx) && _fd.valid()); }
 
 	using audioFile_t::fileInfo;
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 	int64_t writeBuffer(const void *buffer, int64_t length) final;
 	bool fileInfo(const fileInfo_t &fileInfo) final;
 	void fetchTags() noexcept;
 };
 
-struct aac_t final : public audioFile_t
+struct aac_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -268,19 +337,21 @@ private:
 	uint8_t *nextFrame() noexcept;
 
 public:
-	aac_t(fd_t &&fd) noexcept;
+	aac_t(inputSource_t &&source) noexcept;
 	static aac_t *openR(const char *fileName) noexcept;
+	static aac_t *openR(inputSource_t &&source) noexcept;
 	static bool isAAC(const char *fileName) noexcept;
 	static bool isAAC(int32_t fd) noexcept;
+	static bool isAAC(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 #endif // ENABLE_AAC
 
 #ifdef ENABLE_MP3
-struct mp3_t final : public audioFile_t
+struct mp3_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -289,27 +360,45 @@ private:
 	std::unique_ptr<encoderContext_t> encoderCtx;
 
 	void ensurePlayable() noexcept override;
+	bool canOutput(sampleFormat_t format) const noexcept final;
 
 	libAUDIO_NO_DISCARD(bool readMetadata() noexcept);
 
 public:
-	mp3_t(fd_t &&fd, audioModeRead_t) noexcept;
+	mp3_t(inputSource_t &&source, audioModeRead_t) noexcept;
 	mp3_t(fd_t &&fd, audioModeWrite_t) noexcept;
 	static mp3_t *openR(const char *fileName) noexcept;
-	static mp3_t *openW(const char *fileName) noexcept;
+	static mp3_t *openR(inputSource_t &&source) noexcept;
+	static mp3_t *openW(const char *fileName, const encoderOptions_t &options = {}) noexcept;
 	static bool isMP3(const char * fileName) noexcept;
 	static bool isMP3(int32_t fd) noexcept;
+	static bool isMP3(const audioProbe_t &probe) noexcept;
 	decoderContext_t *decoderContext() const noexcept { return decoderCtx.get(); }
 	encoderContext_t *encoderContext() const noexcept { return encoderCtx.get(); }
-	bool valid() const noexcept { return (bool(decoderCtx) || bool(encoderCtx)) && _fd.valid(); }
+	bool valid() const noexcept
+		{ return (bool(decoderCtx) && _source.valid()) || (bool(encoderCtx) && _fd.valid()); }
 
 	using audioFile_t::fileInfo;
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	bool seek(uint64_t sampleFrame) final;
+	uint64_t tell() const noexcept final;
 	int64_t writeBuffer(const void *buffer, int64_t length) final;
 	bool fileInfo(const fileInfo_t &fileInfo) final;
 };
 #endif // ENABLE_MP3
 
+/*!
+ * The interpolation used to resample a module's samples to the output sample rate,
+ * in order of increasing quality and CPU cost
+ */
+enum class moduleResampling_t : uint8_t
+{
+	nearest,
+	linear,
+	sinc4Tap,
+	sinc8Tap
+};
+
 struct moduleFile_t : public audioFile_t
 {
 protected:
@@ -318,77 +407,95 @@ protected:
 
 	void ensurePlayable() noexcept override;
 
-	moduleFile_t(audioType_t type, fd_t &&fd) noexcept;
+	moduleFile_t(audioType_t type, inputSource_t &&source) noexcept;
 
 public:
+	~moduleFile_t() noexcept override;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
+	template<typename T> static bool readInfo(inputSource_t &&source, fileInfo_t &info) noexcept;
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
+	libAUDIO_CLS_API bool mixerThreads(uint32_t threads) noexcept;
+	libAUDIO_CLS_API uint32_t mixerThreads() const noexcept;
+	libAUDIO_CLS_API bool resampling(moduleResampling_t mode) noexcept;
+	libAUDIO_CLS_API moduleResampling_t resampling() const noexcept;
 };
 
-struct modMOD_t final : public moduleFile_t
+struct modMOD_t : public moduleFile_t
 {
 public:
-	modMOD_t(fd_t &&fd) noexcept;
+	modMOD_t(inputSource_t &&source) noexcept;
 	static modMOD_t *openR(const char *fileName) noexcept;
+	static modMOD_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isMOD(const char *fileName) noexcept;
 	static bool isMOD(int32_t fd) noexcept;
+	static bool isMOD(const audioProbe_t &probe) noexcept;
 };
 
-struct modS3M_t final : public moduleFile_t
+struct modS3M_t : public moduleFile_t
 {
 public:
-	modS3M_t(fd_t &&fd) noexcept;
+	modS3M_t(inputSource_t &&source) noexcept;
 	static modS3M_t *openR(const char *fileName) noexcept;
+	static modS3M_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isS3M(const char *fileName) noexcept;
 	static bool isS3M(int32_t fd) noexcept;
+	static bool isS3M(const audioProbe_t &probe) noexcept;
 };
 
-struct modSTM_t final : public moduleFile_t
+struct modSTM_t : public moduleFile_t
 {
 public:
-	modSTM_t(fd_t &&fd) noexcept;
+	modSTM_t(inputSource_t &&source) noexcept;
 	static modSTM_t *openR(const char *fileName) noexcept;
+	static modSTM_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isSTM(const char *fileName) noexcept;
 	static bool isSTM(int32_t fd) noexcept;
+	static bool isSTM(const audioProbe_t &probe) noexcept;
 };
 
-struct modIT_t final : public moduleFile_t
+struct modIT_t : public moduleFile_t
 {
 public:
-	modIT_t(fd_t &&fd) noexcept;
+	modIT_t(inputSource_t &&source) noexcept;
 	static modIT_t *openR(const char *fileName) noexcept;
+	static modIT_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isIT(const char *fileName) noexcept;
 	static bool isIT(int32_t fd) noexcept;
+	static bool isIT(const audioProbe_t &probe) noexcept;
 };
 
 #ifdef ENABLE_AON
-struct modAON_t final : public moduleFile_t
+struct modAON_t : public moduleFile_t
 {
 public:
 	modAON_t() noexcept;
-	modAON_t(fd_t &&fd) noexcept;
+	modAON_t(inputSource_t &&source) noexcept;
 	static modAON_t *openR(const char *fileName) noexcept;
+	static modAON_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isAON(const char *fileName) noexcept;
 	static bool isAON(int32_t fd) noexcept;
+	static bool isAON(const audioProbe_t &probe) noexcept;
 };
 #endif
 
 #ifdef ENABLE_FC1x
-struct modFC1x_t final : public moduleFile_t
+struct modFC1x_t : public moduleFile_t
 {
 public:
 	modFC1x_t() noexcept;
-	modFC1x_t(fd_t &&fd) noexcept;
+	modFC1x_t(inputSource_t &&source) noexcept;
 	static modFC1x_t *openR(const char *fileName) noexcept;
+	static modFC1x_t *openR(inputSource_t &&source, bool infoOnly = false) noexcept;
 	static bool isFC1x(const char *fileName) noexcept;
 	static bool isFC1x(int32_t fd) noexcept;
+	static bool isFC1x(const audioProbe_t &probe) noexcept;
 };
 #endif
 
 #ifdef ENABLE_MUSEPACK
-struct mpc_t final : public audioFile_t
+struct mpc_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -397,19 +504,21 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	mpc_t(fd_t &&fd) noexcept;
+	mpc_t(inputSource_t &&source) noexcept;
 	static mpc_t *openR(const char *fileName) noexcept;
+	static mpc_t *openR(inputSource_t &&source) noexcept;
 	static bool isMPC(const char *fileName) noexcept;
 	static bool isMPC(int32_t fd) noexcept;
+	static bool isMPC(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 #endif // ENABLE_MUSEPACK
 
 #ifdef ENABLE_WAVPACK
-struct wavPack_t final : public audioFile_t
+struct wavPack_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -418,18 +527,20 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	wavPack_t(fd_t &&fd, const char *const fileName) noexcept;
+	wavPack_t(inputSource_t &&source, const char *const fileName) noexcept;
 	static wavPack_t *openR(const char *fileName) noexcept;
+	static wavPack_t *openR(inputSource_t &&source, const char *fileName = nullptr) noexcept;
 	static bool isWavPack(const char *fileName) noexcept;
 	static bool isWavPack(int32_t fd) noexcept;
+	static bool isWavPack(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 #endif // ENABLE_WAVPACK
 
-struct sndh_t final : public audioFile_t
+struct sndh_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -438,18 +549,21 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	sndh_t(fd_t &&fd) noexcept;
+	sndh_t(inputSource_t &&source);
 	static sndh_t *openR(const char *fileName) noexcept;
+	static sndh_t *openR(inputSource_t &&source) noexcept;
+	static bool readInfo(inputSource_t &&source, fileInfo_t &info) noexcept;
 	static bool isSNDH(const char *fileName) noexcept;
 	static bool isSNDH(int32_t fd) noexcept;
+	static bool isSNDH(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 
 #ifdef ENABLE_SID
-struct sid_t final : public audioFile_t
+struct sid_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -458,19 +572,22 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	sid_t(fd_t &&fd) noexcept;
+	sid_t(inputSource_t &&source) noexcept;
 	static sid_t *openR(const char *fileName) noexcept;
+	static sid_t *openR(inputSource_t &&source) noexcept;
+	static bool readInfo(inputSource_t &&source, fileInfo_t &info) noexcept;
 	static bool isSID(const char *fileName) noexcept;
 	static bool isSID(int32_t fd) noexcept;
+	static bool isSID(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 #endif // ENABLE_SID
 
 #ifdef ENABLE_OptimFROG
-struct optimFROG_t final : public audioFile_t
+struct optimFROG_t : public audioFile_t
 {
 private:
 	struct decoderContext_t;
@@ -479,15 +596,44 @@ private:
 	void ensurePlayable() noexcept override;
 
 public:
-	optimFROG_t(fd_t &&fd) noexcept;
+	optimFROG_t(inputSource_t &&source) noexcept;
 	static optimFROG_t *openR(const char *fileName) noexcept;
+	static optimFROG_t *openR(inputSource_t &&source) noexcept;
 	static bool isOptimFROG(const char *fileName) noexcept;
 	static bool isOptimFROG(int32_t fd) noexcept;
+	static bool isOptimFROG(const audioProbe_t &probe) noexcept;
 	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
-	bool valid() const noexcept { return bool(decoderCtx) && _fd.valid(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
 
 	int64_t fillBuffer(void *buffer, uint32_t length) final;
 };
 #endif // ENABLE_OptimFROG
 
+#ifdef ENABLE_WMA
+struct wma_t : public audioFile_t
+{
+private:
+	struct decoderContext_t;
+	std::unique_ptr<decoderContext_t> decoderCtx;
+
+	void ensurePlayable() noexcept override;
+
+	bool readPacket();
+	bool nextSuperframe();
+
+public:
+	wma_t(inputSource_t &&source) noexcept;
+	static wma_t *openR(const char *fileName) noexcept;
+	static wma_t *openR(inputSource_t &&source) noexcept;
+	static bool readInfo(inputSource_t &&source, fileInfo_t &info) noexcept;
+	static bool isWMA(const char *fileName) noexcept;
+	static bool isWMA(int32_t fd) noexcept;
+	static bool isWMA(const audioProbe_t &probe) noexcept;
+	decoderContext_t *context() const noexcept { return decoderCtx.get(); }
+	bool valid() const noexcept { return bool(decoderCtx) && _source.valid(); }
+
+	int64_t fillBuffer(void *buffer, uint32_t length) final;
+};
+#endif // ENABLE_WMA
+
 #endif /*LIBAUDIO_HXX*/
@@ -7,6 +7,7 @@
 
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -75,7 +76,7 @@ struct aac_t::decoderContext_t final
 	~decoderContext_t() noexcept;
 };
 
-aac_t::aac_t(fd_t &&fd) noexcept : audioFile_t{audioType_t::aac, std::move(fd)},
+aac_t::aac_t(inputSource_t &&source) noexcept : audioFile_t{audioType_t::aac, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 aac_t::decoderContext_t::decoderContext_t() : decoder{NeAACDecOpen()}, eof{false}, sampleCount{0},
 	samplesUsed{0}, decodeBuffer{nullptr}, playbackBuffer{} { }
@@ -88,13 +89,27 @@ aac_t::decoderContext_t::decoderContext_t() : decoder{NeAACDecOpen()}, eof{false
  */
 aac_t *aac_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<aac_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isAAC(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isAAC(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs an aac_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isAAC()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+aac_t *aac_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<aac_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
-	const fd_t &fd = file->fd();
+	const inputSource_t &fd = file->source();
 	std::array<uint8_t, ADTS_MAX_SIZE> frameHeader;
 
 	if (!fd.read(frameHeader) ||
@@ -215,7 +230,7 @@ using namespace libAudio;
 
 uint8_t *aac_t::nextFrame() noexcept
 {
-	const fd_t &file = fd();
+	const inputSource_t &file = source();
 	auto &ctx = *context();
 	std::array<uint8_t, ADTS_MAX_SIZE> frameHeader;
 	if (!file.read(frameHeader) ||
@@ -314,11 +329,19 @@ bool isAAC(const char *fileName) { return aac_t::isAAC(fileName); }
  * the file contents to see if it is a AAC file or not
  */
 bool aac_t::isAAC(const int32_t fd) noexcept
+	{ return isAAC(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents an AAC
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool aac_t::isAAC(const audioProbe_t &probe) noexcept
 {
 	std::array<uint8_t, 2> aacMagic{};
-	if (fd == -1 ||
-		static_cast<size_t>(read(fd, aacMagic.data(), aacMagic.size())) != aacMagic.size() ||
-		lseek(fd, 0, SEEK_SET) != 0)
+	if (!probe.read(0, aacMagic))
 		return false;
 	// Detect an ADTS header:
 	aacMagic[1] &= 0xF6;
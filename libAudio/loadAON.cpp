@@ -3,6 +3,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using substrate::make_unique_nothrow;
 
@@ -17,12 +18,20 @@ namespace libAudio::aon
 	}};
 }
 
-modAON_t::modAON_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleAON, std::move(fd)} { }
+modAON_t::modAON_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleAON, std::move(source)} { }
 
 modAON_t *modAON_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modAON_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isAON(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isAON(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modAON_t *modAON_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modAON_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -30,7 +39,7 @@ modAON_t *modAON_t::openR(const char *const fileName) noexcept
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
 	info.channels(2U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -50,17 +59,16 @@ void *aonOpenR(const char *fileName) { return modAON_t::openR(fileName); }
 bool isAON(const char *fileName) { return modAON_t::isAON(fileName); }
 
 bool modAON_t::isAON(const int32_t fd) noexcept
+	{ return isAON(audioProbe_t{fd}); }
+
+bool modAON_t::isAON(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> aonMagic1;
-	std::array<char, 42> aonMagic2;
+	std::array<char, 4> aonMagic1{};
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, aonMagic1.data(), aonMagic1.size())) == aonMagic1.size() &&
-		static_cast<size_t>(read(fd, aonMagic2.data(), aonMagic2.size())) == aonMagic2.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
+		probe.read(0, aonMagic1) &&
 		std::equal(libAudio::aon::magic1.begin(), libAudio::aon::magic1.end(), aonMagic1.cbegin()) &&
 		(aonMagic1[3] == '4' || aonMagic1[3] == '8') &&
-		aonMagic2 == libAudio::aon::magic2;
+		probe.matches(aonMagic1.size(), libAudio::aon::magic2);
 }
 
 bool modAON_t::isAON(const char *const fileName) noexcept
@@ -1,8 +1,10 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
-#include <map>
+#include <vector>
+#include <algorithm>
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -12,70 +14,215 @@
  * @date 2010-2020
  */
 
-const std::map<fileIs_t, fileOpenR_t> loaders
+/*!
+ * @internal
+ * Describes how to detect and open one of the formats supported by the library
+ */
+struct audioLoader_t final
+{
+	bool (*isAudio)(const audioProbe_t &probe) noexcept;
+	audioFile_t *(*openR)(audioProbe_t &probe) noexcept;
+	// How to read just the information for a file, for the formats where this is cheaper than opening it
+	bool (*readInfo)(audioProbe_t &probe, fileInfo_t &info) noexcept{nullptr};
+};
+
+/*!
+ * @internal
+ * Opens the file held by \p probe as a \p T, handing over the already open input source
+ */
+template<typename T> audioFile_t *openProbed(audioProbe_t &probe) noexcept
+	{ return T::openR(probe.takeSource()); }
+
+/*!
+ * @internal
+ * Opens the file held by \p probe as a \p T, handing over the already open input source along
+ * with the file's name (if it has one) for the formats that look for companion files alongside it
+ */
+template<typename T> audioFile_t *openNamed(audioProbe_t &probe) noexcept
+	{ return T::openR(probe.takeSource(), probe.fileName()); }
+
+/*!
+ * @internal
+ * Reads the information for the file held by \p probe as a \p T, without opening it for decoding
+ */
+template<typename T> bool readProbedInfo(audioProbe_t &probe, fileInfo_t &info) noexcept
+	{ return T::readInfo(probe.takeSource(), info); }
+
+/*!
+ * @internal
+ * Reads the information for the module held by \p probe as a \p T, skipping its sample data
+ */
+template<typename T> bool readModuleInfo(audioProbe_t &probe, fileInfo_t &info) noexcept
+	{ return moduleFile_t::readInfo<T>(probe.takeSource(), info); }
+
+const std::vector<audioLoader_t> loaders
 {
 #ifdef ENABLE_VORBIS
-	{isOggVorbis, oggVorbisOpenR},
+	{oggVorbis_t::isOggVorbis, openProbed<oggVorbis_t>},
 #endif
 #ifdef ENABLE_FLAC
-	{isFLAC, flacOpenR},
+	{flac_t::isFLAC, openProbed<flac_t>},
 #endif
-	{isWAV, wavOpenR},
+	{wav_t::isWAV, openProbed<wav_t>},
 #ifdef ENABLE_M4A
-	{isM4A, m4aOpenR},
+	{m4a_t::isM4A, openProbed<m4a_t>},
 #endif
 #ifdef ENABLE_AAC
-	{isAAC, aacOpenR},
+	{aac_t::isAAC, openProbed<aac_t>},
 #endif
 #ifdef ENABLE_MP3
-	{isMP3, mp3OpenR},
+	{mp3_t::isMP3, openProbed<mp3_t>},
 #endif
-	{isIT, itOpenR},
-	{isMOD, modOpenR},
-	{isS3M, s3mOpenR},
-	{isSTM, stmOpenR},
+	{modIT_t::isIT, openProbed<modIT_t>, readModuleInfo<modIT_t>},
+	{modMOD_t::isMOD, openProbed<modMOD_t>, readModuleInfo<modMOD_t>},
+	{modS3M_t::isS3M, openProbed<modS3M_t>, readModuleInfo<modS3M_t>},
+	{modSTM_t::isSTM, openProbed<modSTM_t>, readModuleInfo<modSTM_t>},
 #ifdef ENABLE_AON
-	{isAON, aonOpenR},
+	{modAON_t::isAON, openProbed<modAON_t>, readModuleInfo<modAON_t>},
 #endif
 #ifdef ENABLE_FC1x
-	{isFC1x, fc1xOpenR},
+	{modFC1x_t::isFC1x, openProbed<modFC1x_t>, readModuleInfo<modFC1x_t>},
 #endif
 #ifdef ENABLE_OptimFROG
-	{isOptimFROG, optimFROGOpenR},
+	{optimFROG_t::isOptimFROG, openProbed<optimFROG_t>},
 #endif
 #ifdef ENABLE_WMA
-	{isWMA, wmaOpenR},
+	{wma_t::isWMA, openProbed<wma_t>, readProbedInfo<wma_t>},
 #endif
 #ifdef ENABLE_MUSEPACK
-	{isMPC, mpcOpenR},
+	{mpc_t::isMPC, openProbed<mpc_t>},
 #endif
 #ifdef ENABLE_WAVPACK
-	{isWavPack, wavPackOpenR},
+	{wavPack_t::isWavPack, openNamed<wavPack_t>},
 #endif
 #ifdef ENABLE_OPUS
-	{isOggOpus, oggOpusOpenR},
+	{oggOpus_t::isOggOpus, openProbed<oggOpus_t>},
 #endif
-	{isSNDH, sndhOpenR},
+	{sndh_t::isSNDH, openProbed<sndh_t>, readProbedInfo<sndh_t>},
 #ifdef ENABLE_SID
-	{isSID, sidOpenR},
+	{sid_t::isSID, openProbed<sid_t>, readProbedInfo<sid_t>},
 #endif
 };
 
+/*!
+ * @internal
+ * Runs each format's detection logic against the file prefix held by \p probe
+ * @return The loader for the first format to recognise the file, or \c nullptr
+ */
+static const audioLoader_t *findLoader(const audioProbe_t &probe) noexcept
+{
+	if (!probe.valid())
+		return nullptr;
+	const auto loader{std::find_if(loaders.begin(), loaders.end(),
+		[&](const audioLoader_t &candidate) { return candidate.isAudio(probe); })};
+	return loader == loaders.end() ? nullptr : &*loader;
+}
+
+/*!
+ * Opens the file given by \c fileName for reading and playback, detecting which format it is in.
+ * The file is opened and its prefix read exactly once, with the result handed on to the loader
+ * for the detected format
+ * @param fileName The name of the file to open
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+audioFile_t *audioFile_t::openR(const char *const fileName) noexcept
+{
+	audioProbe_t probe{fileName};
+	const auto *const loader{findLoader(probe)};
+	if (!loader)
+		return nullptr;
+	return loader->openR(probe);
+}
+
+/*!
+ * Opens the data read through \c source for reading and playback, detecting which format it is in
+ * @param source The source of the data to decode
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+audioFile_t *audioFile_t::openR(inputSource_t &&source) noexcept
+{
+	audioProbe_t probe{std::move(source)};
+	const auto *const loader{findLoader(probe)};
+	if (!loader)
+		return nullptr;
+	return loader->openR(probe);
+}
+
+/*!
+ * Reads the information (length, sample rate, channels and tags) for the audio read through \c source,
+ * detecting which format it is in. Where the format allows, only the headers and tags are read -
+ * the decoder is not set up and no sample data is loaded
+ * @param source The source of the data to read the information for
+ * @param info The fileInfo_t to fill out
+ * @return \c true if the information could be read, otherwise \c false
+ */
+bool audioFile_t::probeInfo(inputSource_t &&source, fileInfo_t &info) noexcept
+{
+	audioProbe_t probe{std::move(source)};
+	const auto *const loader{findLoader(probe)};
+	if (!loader)
+		return false;
+	if (loader->readInfo)
+		return loader->readInfo(probe, info);
+	const std::unique_ptr<audioFile_t> file{loader->openR(probe)};
+	if (!file)
+		return false;
+	info = std::move(file->fileInfo());
+	return true;
+}
+
+/*!
+ * Reads the information for the file given by \c fileName, detecting which format it is in
+ * @param fileName The name of the file to read the information for
+ * @param info The fileInfo_t to fill out
+ * @return \c true if the information could be read, otherwise \c false
+ */
+bool audioFile_t::probeInfo(const char *const fileName, fileInfo_t &info) noexcept
+	{ return probeInfo(fd_t{fileName, O_RDONLY | O_NOCTTY}, info); }
+
 /*!
  * This function opens the file given by \c fileName for reading and playback and returns a pointer
  * to the context of the opened file which must be used only by Audio_* functions
  * @param fileName The name of the file to open
  * @return A void pointer to the context of the opened file, or \c nullptr if there was an error
  */
-void *audioOpenR(const char *const fileName)
-{
-	for (const auto &loader : loaders)
-	{
-		if (loader.first(fileName))
-			return loader.second(fileName);
-	}
-	return nullptr;
-}
+void *audioOpenR(const char *const fileName) { return audioFile_t::openR(fileName); }
+
+/*!
+ * This function reads the information for the file given by \c fileName without opening it for
+ * decoding, so is much cheaper than \c audioOpenR() for indexing large numbers of files
+ * @param fileName The name of the file to read the information for
+ * @param info The fileInfo_t to fill out
+ * @return \c true if the information could be read, otherwise \c false
+ */
+bool audioReadInfo(const char *const fileName, fileInfo_t &info) noexcept
+	{ return audioFile_t::probeInfo(fileName, info); }
+
+/*!
+ * This function opens the \c length bytes of audio at \c data for reading and playback and returns
+ * a pointer to the context of the opened file which must be used only by Audio_* functions.
+ * The data is decoded in place, so must not be freed or changed until the file is closed.
+ * @param data The audio data to decode
+ * @param length How long the data is in bytes
+ * @return A void pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+void *audioOpenRMemory(const void *const data, const size_t length)
+	{ return audioFile_t::openR(inputSource_t{data, length}); }
+
+/*!
+ * This function opens the audio read through the given I/O callbacks for reading and playback and returns
+ * a pointer to the context of the opened file which must be used only by Audio_* functions.
+ * The callbacks must remain usable until the file is closed.
+ * @param read The callback to read data with
+ * @param seek The callback to seek through the data with
+ * @param tell The callback to get the current possition in the data with, or \c nullptr
+ * @param length The callback to get the length of the data with, or \c nullptr to find the length by seeking
+ * @param user The pointer passed to each of the callbacks
+ * @return A void pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+void *audioOpenRCallbacks(const audioReadCallback_t read, const audioSeekCallback_t seek,
+	const audioTellCallback_t tell, const audioLengthCallback_t length, void *const user)
+	{ return audioFile_t::openR(inputSource_t{inputSource_t::callbacks_t{read, seek, tell, length, user}}); }
 
 /*!
  * This function gets the \c fileInfo_t structure for an opened file
@@ -106,15 +253,93 @@ const fileInfo_t *audioGetFileInfo(void *audioFile) { return audioFileInfo(audio
  * @param length An integer giving how long the output buffer is as a maximum fill-length
  * @return Either a negative value when an error condition is entered,
  * or the number of bytes written to the buffer
+ * @note This stops any playback of the file, and the next \c audioPlay() carries on from
+ * wherever this leaves the decoding position
  */
 int64_t audioFillBuffer(void *audioFile, void *const buffer, const uint32_t length)
 {
 	const auto file = static_cast<audioFile_t *>(audioFile);
 	if (!file)
 		return 0;
+	file->flushPlayback();
 	return file->fillBuffer(buffer, length);
 }
 
+/*!
+ * Requests that subsequent calls to \c audioFillBuffer() produce their output in the
+ * sample format given, so that no intermediate conversion through 16-bit is done
+ * @param audioFile A pointer to a file opened with \c audioOpenR(), or \c nullptr for a no-operation
+ * @param sampleFormat One of the \c AUDIO_SAMPLE_* values giving the format to produce
+ * @return \c true if the decoder is now producing the requested format, otherwise \c false
+ * @note Not all decoders are able to produce all formats. A decoder which cannot produce
+ * the requested format continues to produce the format given by \c audioFileSampleFormat()
+ */
+bool audioOutputFormat(void *audioFile, const uint8_t sampleFormat)
+{
+	const auto file = static_cast<audioFile_t *>(audioFile);
+	if (!file || sampleFormat < AUDIO_SAMPLE_INT8 || sampleFormat > AUDIO_SAMPLE_FLOAT32)
+		return false;
+	return file->outputFormat(static_cast<sampleFormat_t>(sampleFormat));
+}
+
+bool audioFile_t::outputFormat(const sampleFormat_t format) noexcept
+{
+	if (format == _fileInfo.sampleFormat())
+		return true;
+	// Once playback has been set up the player relies on the format not changing underneath it
+	if (_player || !canOutput(format))
+		return false;
+	_fileInfo.sampleFormat(format);
+	return true;
+}
+
+/*!
+ * Repositions decoding of an opened file such that the next call to \c audioFillBuffer()
+ * starts returning audio from the sample frame given
+ * @param audioFile A pointer to a file opened with \c audioOpenR(), or \c nullptr for a no-operation
+ * @param sampleFrame The sample frame (sample index in a single channel) to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ * @note Formats which do not support seeking always return \c false, leaving
+ * the decoding position untouched
+ * @note Seeking stops any playback of the file, and the next \c audioPlay() carries on
+ * from the new position
+ */
+bool audioSeek(void *audioFile, const uint64_t sampleFrame)
+{
+	const auto file = static_cast<audioFile_t *>(audioFile);
+	if (!file)
+		return false;
+	return file->seek(sampleFrame);
+}
+
+/*!
+ * Gets the sample frame that the next call to \c audioFillBuffer() will start returning audio from
+ * @param audioFile A pointer to a file opened with \c audioOpenR(), or \c nullptr for a no-operation
+ * @return The current decoding position in sample frames
+ */
+uint64_t audioTell(void *audioFile)
+{
+	const auto file = static_cast<const audioFile_t *>(audioFile);
+	if (!file)
+		return 0;
+	return file->tell();
+}
+
+bool audioFile_t::seek(const uint64_t) { return false; }
+
+/*!
+ * Stops any playback of the file and discards the audio its decoder thread had decoded ahead,
+ * for when the file is about to be decoded directly through \c fillBuffer(). Seeking and
+ * \c audioFillBuffer() do this automatically.
+ */
+void audioFile_t::flushPlayback()
+{
+	// The decoder thread must not touch _player, as the file may be in the middle of stopping it
+	if (!playback_t::onDecoderThread() && _player)
+		_player->flush();
+}
+uint64_t audioFile_t::tell() const noexcept { return 0; }
+
 /*!
  * Closes an opened audio file
  * @param audioFile A pointer to a file opened with \c audioOpenR(), or \c nullptr for a no-operation
@@ -137,6 +362,64 @@ bool audioFile_t::playbackMode(const playbackMode_t mode) noexcept
 	return false;
 }
 
+/*!
+ * Sets how many buffers playback keeps queued on the output and how long each is in bytes,
+ * trading latency against resilience to the decoder stalling. This must be done before
+ * playback is first started.
+ * @param count The number of buffers to keep queued
+ * @param length The length of each buffer, which must be a whole number of sample frames
+ * @return \c true if the configuration was accepted, otherwise \c false
+ */
+bool audioFile_t::playbackBuffers(const uint32_t count, const uint32_t length) noexcept
+{
+	ensurePlayable();
+	if (_player)
+		return _player->buffers(count, length);
+	return false;
+}
+
+/*!
+ * Sets how many blocks of audio playback decodes ahead of the output on its decoder thread,
+ * which lets playback ride out the decoder stalling for up to that many buffers' worth of time.
+ * This must be done before playback is first started.
+ * @param blocks The number of blocks to decode ahead by, which must be a power of 2
+ * @return \c true if the depth was accepted, otherwise \c false
+ */
+bool audioFile_t::playbackPrefill(const uint32_t blocks) noexcept
+{
+	ensurePlayable();
+	if (_player)
+		return _player->prefill(blocks);
+	return false;
+}
+
+/*!
+ * Switches playback of this file over to another backend, such as "null" to discard the audio
+ * in realtime, "null:fast" to discard it as fast as it decodes, or "wav:fileName" to write it
+ * out to a WAV file. This must be done before playback is first started.
+ * @param backend The backend to use, in the form "name[:argument]"
+ * @return \c true if the backend was switched, otherwise \c false
+ */
+bool audioFile_t::playbackBackend(const std::string &backend)
+{
+	ensurePlayable();
+	if (_player)
+		return _player->backend(backend);
+	return false;
+}
+
+/*!
+ * Gets the counts of the times playback of this file failed to keep up with the output,
+ * along with how full the ring between the decoder thread and the output is
+ * @return The playback counters, all zero if the file has never been played
+ */
+playbackStats_t audioFile_t::playbackStats() const noexcept
+{
+	if (_player)
+		return _player->stats();
+	return {};
+}
+
 void audioFile_t::playbackVolume(const float level) noexcept
 {
 	if (_player)
@@ -219,12 +502,16 @@ void audioFile_t::stop()
  * @note This function does not check the file extension, but rather
  * the file contents to see if it is audio or not
  */
-bool isAudio(const char *fileName)
+bool isAudio(const char *fileName) { return audioFile_t::isAudio(fileName); }
+
+bool audioFile_t::isAudio(const char *const fileName) noexcept
 {
-	for (const auto &loader : loaders)
-	{
-		if (loader.first(fileName))
-			return true;
-	}
-	return false;
+	const audioProbe_t probe{fileName};
+	return findLoader(probe) != nullptr;
+}
+
+bool audioFile_t::isAudio(const int32_t fd) noexcept
+{
+	const audioProbe_t probe{fd};
+	return findLoader(probe) != nullptr;
 }
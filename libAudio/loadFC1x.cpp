@@ -3,6 +3,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using substrate::make_unique_nothrow;
 
@@ -12,19 +13,27 @@ namespace libAudio::fc1x
 	constexpr static std::array<char, 4> magicFC14{{'F', 'C', '1', '4'}};
 }
 
-modFC1x_t::modFC1x_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleFC1x, std::move(fd)} { }
+modFC1x_t::modFC1x_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleFC1x, std::move(source)} { }
 
 modFC1x_t *modFC1x_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modFC1x_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isFC1x(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isFC1x(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modFC1x_t *modFC1x_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modFC1x_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
 
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -40,13 +49,13 @@ void *fc1xOpenR(const char *fileName) { return modFC1x_t::openR(fileName); }
 bool isFC1x(const char *fileName) { return modFC1x_t::isFC1x(fileName); }
 
 bool modFC1x_t::isFC1x(const int32_t fd) noexcept
+	{ return isFC1x(audioProbe_t{fd}); }
+
+bool modFC1x_t::isFC1x(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> fc1xMagic;
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, fc1xMagic.data(), fc1xMagic.size())) == fc1xMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		(fc1xMagic == libAudio::fc1x::magicSMOD || fc1xMagic == libAudio::fc1x::magicFC14);
+		probe.matches(0, libAudio::fc1x::magicSMOD) ||
+		probe.matches(0, libAudio::fc1x::magicFC14);
 }
 
 bool modFC1x_t::isFC1x(const char *const fileName) noexcept
@@ -5,6 +5,8 @@
 #include "flac.hxx"
 #include "string.hxx"
 #include "oggCommon.hxx"
+#include "probe.hxx"
+#include "sampleConversion.hxx"
 
 /*!
  * @internal
@@ -15,6 +17,7 @@
  */
 
 using substrate::make_unique_nothrow;
+using namespace libAudio::sampleConversion;
 
 namespace libAudio::flac
 {
@@ -29,7 +32,7 @@ namespace libAudio::flac
 	 */
 	FLAC__StreamDecoderReadStatus read(const FLAC__StreamDecoder *, uint8_t *buffer, size_t *bytes, void *ctx)
 	{
-		const fd_t &fd = static_cast<audioFile_t *>(ctx)->fd();
+		const inputSource_t &fd = static_cast<audioFile_t *>(ctx)->source();
 		if (*bytes > 0)
 		{
 			const bool result = fd.read(buffer, *bytes, *bytes);
@@ -54,7 +57,7 @@ namespace libAudio::flac
 	 */
 	FLAC__StreamDecoderSeekStatus seek(const FLAC__StreamDecoder *, uint64_t offset, void *ctx)
 	{
-		const fd_t &fd = static_cast<audioFile_t *>(ctx)->fd();
+		const inputSource_t &fd = static_cast<audioFile_t *>(ctx)->source();
 		const auto result = fd.seek(offset, SEEK_SET);
 		if (result == -1 || uint64_t(result) != offset)
 			return FLAC__STREAM_DECODER_SEEK_STATUS_ERROR;
@@ -72,7 +75,7 @@ namespace libAudio::flac
 	 */
 	FLAC__StreamDecoderTellStatus tell(const FLAC__StreamDecoder *, uint64_t *offset, void *ctx)
 	{
-		const fd_t &fd = static_cast<audioFile_t *>(ctx)->fd();
+		const inputSource_t &fd = static_cast<audioFile_t *>(ctx)->source();
 		const auto pos = fd.tell();
 		if (pos == -1)
 			return FLAC__STREAM_DECODER_TELL_STATUS_ERROR;
@@ -90,7 +93,7 @@ namespace libAudio::flac
 	 */
 	FLAC__StreamDecoderLengthStatus length(const FLAC__StreamDecoder *, uint64_t *len, void *ctx)
 	{
-		const fd_t &fd = static_cast<audioFile_t *>(ctx)->fd();
+		const inputSource_t &fd = static_cast<audioFile_t *>(ctx)->source();
 		const auto length = fd.length();
 		if (length == -1)
 			return FLAC__STREAM_DECODER_LENGTH_STATUS_ERROR;
@@ -107,7 +110,7 @@ namespace libAudio::flac
 	 */
 	int eof(const FLAC__StreamDecoder *, void *ctx)
 	{
-		const fd_t &fd = static_cast<audioFile_t *>(ctx)->fd();
+		const inputSource_t &fd = static_cast<audioFile_t *>(ctx)->source();
 		return fd.isEOF() ? 1 : 0;
 	}
 
@@ -123,7 +126,7 @@ namespace libAudio::flac
 	{
 		const flac_t &file = *static_cast<flac_t *>(audioFile);
 		auto &ctx = *file.decoderContext();
-		int16_t *PCM = reinterpret_cast<int16_t *>(ctx.buffer.get());
+		int32_t *const PCM = ctx.buffer.get();
 		const uint8_t channels = file.fileInfo().channels();
 		if (!channels)
 			return FLAC__STREAM_DECODER_WRITE_STATUS_ABORT;
@@ -132,13 +135,16 @@ namespace libAudio::flac
 		if (len > (ctx.bufferLen / channels))
 			len = ctx.bufferLen / channels;
 
+		// Interleave the channels, keeping the samples at full precision so fillBuffer() can convert to any format
 		for (uint32_t i = 0; i < len; i++)
 		{
 			for (uint8_t j = 0; j < channels; j++)
-				PCM[(i * channels) + j] = int16_t(buffers[j][i] >> sampleShift);
+				PCM[(i * channels) + j] = int32_t(uint32_t(buffers[j][i]) << sampleShift);
 		}
-		ctx.bytesAvail = len * channels * (file.fileInfo().bitsPerSample() / 8U);
-		ctx.bytesRemain = ctx.bytesAvail;
+		ctx.samplesAvail = len * channels;
+		ctx.samplesRemain = ctx.samplesAvail;
+		// libFLAC always hands us frames numbered by sample in this callback
+		ctx.frameSample = frame->header.number.sample_number;
 
 		return FLAC__STREAM_DECODER_WRITE_STATUS_CONTINUE;
 	}
@@ -165,16 +171,11 @@ namespace libAudio::flac
 				const FLAC__StreamMetadata_StreamInfo &streamInfo = metadata->data.stream_info;
 				info.channels(static_cast<uint8_t>(streamInfo.channels));
 				info.bitRate(streamInfo.sample_rate);
-				info.bitsPerSample(static_cast<uint8_t>(streamInfo.bits_per_sample));
-				if (info.bitsPerSample() == 24U)
-				{
-					info.bitsPerSample(16U);
-					ctx.sampleShift = 8;
-				}
-				else
-					ctx.sampleShift = 0;
+				// Unless asked for something else, we produce 8-bit output for 8-bit streams and 16-bit for all others
+				info.bitsPerSample(streamInfo.bits_per_sample == 8U ? 8U : 16U);
+				ctx.sampleShift = static_cast<uint8_t>(32U - streamInfo.bits_per_sample);
 				ctx.bufferLen = streamInfo.channels * streamInfo.max_blocksize;
-				ctx.buffer = make_unique_nothrow<uint8_t []>(ctx.bufferLen * (streamInfo.bits_per_sample / 8));
+				ctx.buffer = make_unique_nothrow<int32_t []>(ctx.bufferLen);
 				info.totalTime(streamInfo.total_samples / streamInfo.sample_rate);
 				break;
 			}
@@ -222,10 +223,10 @@ namespace libAudio::flac
 
 using namespace libAudio;
 
-flac_t::flac_t(fd_t &&fd, audioModeRead_t) noexcept : audioFile_t{audioType_t::flac, std::move(fd)},
+flac_t::flac_t(inputSource_t &&source, audioModeRead_t) noexcept : audioFile_t{audioType_t::flac, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 flac_t::decoderContext_t::decoderContext_t() noexcept : streamDecoder{FLAC__stream_decoder_new()},
-	buffer{}, bufferLen{0}, playbackBuffer{}, sampleShift{0}, bytesRemain{0}, bytesAvail{0} { }
+	buffer{}, bufferLen{0}, playbackBuffer{}, sampleShift{0}, samplesRemain{0}, samplesAvail{0}, frameSample{0} { }
 
 /*!
  * Constructs a flac_t using the file given by \c fileName for reading and playback
@@ -235,10 +236,24 @@ flac_t::decoderContext_t::decoderContext_t() noexcept : streamDecoder{FLAC__stre
  */
 flac_t *flac_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<flac_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, audioModeRead_t{})};
-	if (!file || !file->valid() || !isFLAC(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isFLAC(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs a flac_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isFLAC()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+flac_t *flac_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<flac_t>>(std::move(source), audioModeRead_t{})};
+	if (!file || !file->valid())
 		return nullptr;
-	const fd_t &fd = file->fd();
+	const inputSource_t &fd = file->source();
 	auto &ctx = *file->decoderContext();
 
 	FLAC__stream_decoder_set_metadata_ignore_all(ctx.streamDecoder);
@@ -310,32 +325,78 @@ FLAC__StreamDecoderState flac_t::decoderContext_t::nextFrame() noexcept
  */
 int64_t flac_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 {
-	auto *const buffer = static_cast<char *>(bufferPtr);
-	uint32_t filled = 0;
 	auto &ctx = *decoderContext();
-	while (filled < length)
+	return withSampleFormat(fileInfo().sampleFormat(), [&](const auto format) -> int64_t
 	{
-		if (ctx.bytesRemain == 0)
+		constexpr auto outputFormat{decltype(format)::value};
+		using outputSample_t = sample_t<outputFormat>;
+		auto *const buffer = static_cast<outputSample_t *>(bufferPtr);
+		const uint32_t samples = length / sizeof(outputSample_t);
+		uint32_t filled = 0;
+		while (filled < samples)
 		{
-			const FLAC__StreamDecoderState state = ctx.nextFrame();
-			if (state == FLAC__STREAM_DECODER_END_OF_STREAM || state == FLAC__STREAM_DECODER_ABORTED)
+			if (ctx.samplesRemain == 0)
 			{
-				ctx.bytesRemain = 0;
-				if (filled == 0)
-					return -2;
-				break;
+				const FLAC__StreamDecoderState state = ctx.nextFrame();
+				if (state == FLAC__STREAM_DECODER_END_OF_STREAM || state == FLAC__STREAM_DECODER_ABORTED)
+				{
+					ctx.samplesRemain = 0;
+					if (filled == 0)
+						return -2;
+					break;
+				}
 			}
+			const uint32_t count = std::min(ctx.samplesRemain, samples - filled);
+			const int32_t *const source = ctx.buffer.get() + (ctx.samplesAvail - ctx.samplesRemain);
+			for (uint32_t i = 0; i < count; ++i)
+				buffer[filled + i] = fromInt32<outputFormat>(source[i]);
+			filled += count;
+			ctx.samplesRemain -= count;
 		}
-		uint32_t len = ctx.bytesRemain;
-		if (len > (length - filled))
-			len = length - filled;
-		memcpy(buffer + filled, ctx.buffer.get() + (ctx.bytesAvail - ctx.bytesRemain), len);
-		filled += len;
-		ctx.bytesRemain -= len;
+		return filled * sizeof(outputSample_t);
+	});
+}
+
+/*!
+ * Seeks the decoder to the sample frame given so that the next call to \c fillBuffer()
+ * starts returning audio from exactly that sample
+ * @param sampleFrame The sample frame to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool flac_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *decoderContext();
+	// Throw away whatever is left of the current frame, the seek delivers the new one via flac::data()
+	ctx.samplesRemain = 0;
+	if (!FLAC__stream_decoder_seek_absolute(ctx.streamDecoder, sampleFrame))
+	{
+		// A failed seek leaves the decoder in FLAC__STREAM_DECODER_SEEK_ERROR and must be flushed to recover
+		if (FLAC__stream_decoder_get_state(ctx.streamDecoder) == FLAC__STREAM_DECODER_SEEK_ERROR)
+			FLAC__stream_decoder_flush(ctx.streamDecoder);
+		return false;
 	}
-	return filled;
+	return true;
+}
+
+uint64_t flac_t::tell() const noexcept
+{
+	const auto &ctx = *decoderContext();
+	const auto channels{fileInfo().channels()};
+	if (!channels)
+		return 0;
+	const auto samplesUsed{ctx.samplesAvail - ctx.samplesRemain};
+	return ctx.frameSample + (samplesUsed / channels);
 }
 
+/*!
+ * @internal
+ * The decoded samples can be converted to any of the output formats directly,
+ * though 8-bit output is only offered for 8-bit streams
+ */
+bool flac_t::canOutput(const sampleFormat_t format) const noexcept
+	{ return format != sampleFormat_t::int8 || decoderContext()->sampleShift == 24U; }
+
 /*!
  * Checks the file given by \p fileName for whether it is an FLAC
  * file recognised by this library or not
@@ -357,18 +418,23 @@ bool isFLAC(const char *fileName) { return flac_t::isFLAC(fileName); }
  * the file contents to see if it is a FLAC file or not
  */
 bool flac_t::isFLAC(const int32_t fd) noexcept
+	{ return isFLAC(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a FLAC
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool flac_t::isFLAC(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> flacMagic{};
-	if (fd == -1 ||
-		static_cast<size_t>(read(fd, flacMagic.data(), flacMagic.size())) != flacMagic.size() ||
-		lseek(fd, 0, SEEK_SET) != 0)
-		return false;
-	if (flacMagic == libAudio::flac::oggMagic)
+	if (probe.matches(0, libAudio::flac::oggMagic))
 	{
 		ogg_packet header;
-		return isOgg(fd, header) && ::isFLAC(header);
+		return isOgg(probe, header) && ::isFLAC(header);
 	}
-	return flacMagic == libAudio::flac::flacMagic;
+	return probe.matches(0, libAudio::flac::flacMagic);
 }
 
 /*!
@@ -3,6 +3,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using substrate::make_unique_nothrow;
 
@@ -11,12 +12,20 @@ namespace libAudio::it
 	constexpr static std::array<char, 4> magic{{'I', 'M', 'P', 'M'}};
 }
 
-modIT_t::modIT_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleIT, std::move(fd)} { }
+modIT_t::modIT_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleIT, std::move(source)} { }
 
 modIT_t *modIT_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modIT_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isIT(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isIT(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modIT_t *modIT_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modIT_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -24,7 +33,7 @@ modIT_t *modIT_t::openR(const char *const fileName) noexcept
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
 	info.channels(2U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -40,13 +49,11 @@ void *itOpenR(const char *fileName) { return modIT_t::openR(fileName); }
 bool isIT(const char *fileName) { return modIT_t::isIT(fileName); }
 
 bool modIT_t::isIT(const int32_t fd) noexcept
+	{ return isIT(audioProbe_t{fd}); }
+
+bool modIT_t::isIT(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> itMagic{};
-	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, itMagic.data(), itMagic.size())) == itMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		itMagic == libAudio::it::magic;
+	return probe.matches(0, libAudio::it::magic);
 }
 
 bool modIT_t::isIT(const char *const fileName) noexcept
@@ -1,9 +1,10 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
-#include <cstdio>
+#include <cstdint>
 #include <algorithm>
 
 #include "m4a.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -19,49 +20,41 @@ namespace libAudio::loadM4A
 {
 	/*!
 	 * @internal
-	 * Internal function used to open the MP4 file for reading
-	 * @param fileName The name of the file to open
-	 * @param mode The \c MP4FileMode in which to open the file. We ensure this has
-	 *    to be FILEMODE_CREATE for our purposes
+	 * Internal function used to get the length of the MP4 file, which MP4v2 needs
+	 * to know where the top level atoms stop
+	 * @param filePtr \c inputSource_t for the MP4 file as a void pointer
 	 */
-	void *openR(const char *fileName, MP4FileMode mode)
+	int64_t size(void *filePtr)
 	{
-		if (mode != FILEMODE_READ)
-			return nullptr;
-		return fopen(fileName, "rb");
+		const auto &file = *static_cast<const inputSource_t *>(filePtr);
+		return file.length();
 	}
 
 	/*!
 	 * @internal
 	 * Internal function used to seek in the MP4 file
-	 * @param file \c FILE handle for the MP4 file as a void pointer
+	 * @param filePtr \c inputSource_t for the MP4 file as a void pointer
 	 * @param pos Possition into the file to which to seek to
 	 */
 	int seek(void *filePtr, int64_t pos)
 	{
-		auto *const file = static_cast<FILE *>(filePtr);
-#if defined(_WIN32)
-		return (_fseeki64(file, pos, SEEK_SET) == 0 ? FALSE : TRUE);
-#elif defined(HAVE_FSEEKO64)
-		return (fseeko64(file, pos, SEEK_SET) == 0 ? FALSE : TRUE);
-#else
-		return fseeko(file, pos, SEEK_SET) == 0 ? FALSE : TRUE;
-#endif
+		const auto &file = *static_cast<const inputSource_t *>(filePtr);
+		return file.seek(pos, SEEK_SET) == pos ? FALSE : TRUE;
 	}
 
 	/*!
 	 * @internal
 	 * Internal function used to read from the MP4 file
-	 * @param file \c FILE handle for the MP4 file as a void pointer
+	 * @param filePtr \c inputSource_t for the MP4 file as a void pointer
 	 * @param buffer A typeless buffer to which the read data should be written
 	 * @param bufferLen A 64-bit integer giving how much data should be read from the file
 	 * @param read A 64-bit integer count returning how much data was actually read
 	 */
-	int read(void *filePtr, void *buffer, int64_t bufferLen, int64_t *read, int64_t)
+	int read(void *filePtr, void *buffer, int64_t bufferLen, int64_t *read)
 	{
-		auto *const file = static_cast<FILE *>(filePtr);
-		size_t ret = fread(buffer, 1, size_t(bufferLen), file);
-		if (ret == 0 && bufferLen != 0)
+		const auto &file = *static_cast<const inputSource_t *>(filePtr);
+		const auto ret = file.read(buffer, size_t(bufferLen), nullptr);
+		if (ret <= 0 && bufferLen != 0)
 			return TRUE;
 		*read = ret;
 		return FALSE;
@@ -69,41 +62,18 @@ namespace libAudio::loadM4A
 
 	/*!
 	 * @internal
-	 * Internal function used to write data to the MP4 file
-	 * @param file \c FILE handle for the MP4 file as a void pointer
-	 * @param buffer A typeless buffer holding the data to be written, which must also not become modified
-	 * @param bufferLen A 64-bit integer giving how much data is to be written to the file
-	 * @param written A 64-bit integer count returning how much data was actually written
-	 */
-	int write(void *filePtr, const void *buffer, int64_t bufferLen, int64_t *written, int64_t)
-	{
-		auto *const file = static_cast<FILE *>(filePtr);
-		if (fwrite(buffer, 1, size_t(bufferLen), file) != size_t(bufferLen))
-			return TRUE;
-		*written = bufferLen;
-		return FALSE;
-	}
-
-	/*!
-	 * @internal
-	 * Internal function used to close the MP4 file after I/O is complete
-	 * @param file \c FILE handle for the MP4 file as a void pointer
-	 */
-	int close(void *file) { return fclose(static_cast<FILE *>(file)) != 0; }
-
-	/*!
-	 * @internal
-	 * Structure holding pointers to the \c MP4Dec* functions given in this file.
+	 * Structure holding pointers to the I/O functions given in this file.
 	 * Used in the initialising of the MP4v2 file reader as a set of callbacks so
-	 * as to prevent run-time issues on Windows.
+	 * as to prevent run-time issues on Windows. The file is only ever read,
+	 * so there are no write or truncate operations.
 	 */
-	constexpr static MP4FileProvider ioFunctions =
+	constexpr static MP4IOCallbacks ioFunctions =
 	{
-		openR,
+		size,
 		seek,
 		read,
-		write,
-		close
+		nullptr,
+		nullptr
 	};
 
 	constexpr static std::array<char, 4> typeMagic{{'f', 't', 'y', 'p'}};
@@ -113,11 +83,11 @@ namespace libAudio::loadM4A
 
 using namespace libAudio;
 
-m4a_t::m4a_t(fd_t &&fd, audioModeRead_t) noexcept : audioFile_t{audioType_t::m4a, std::move(fd)},
+m4a_t::m4a_t(inputSource_t &&source, audioModeRead_t) noexcept : audioFile_t{audioType_t::m4a, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 m4a_t::decoderContext_t::decoderContext_t() : decoder{NeAACDecOpen()}, mp4Stream{nullptr},
 	track{MP4_INVALID_TRACK_ID}, frameCount{0}, currentFrame{0}, sampleCount{0}, samplesUsed{0},
-	samples{nullptr}, eof{false}, playbackBuffer{} { }
+	samplePosition{0}, bytesToSkip{0}, samples{nullptr}, eof{false}, playbackBuffer{} { }
 
 /*!
  * @internal
@@ -186,15 +156,32 @@ void m4a_t::fetchTags() noexcept
  */
 m4a_t *m4a_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<m4a_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, audioModeRead_t{})};
-	if (!file || !file->valid() || !isM4A(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isM4A(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs a m4a_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isM4A()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+m4a_t *m4a_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<m4a_t>>(std::move(source), audioModeRead_t{})};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->decoderContext();
 	fileInfo_t &info = file->fileInfo();
 
-	ctx.mp4Stream = MP4ReadProvider(fileName, &loadM4A::ioFunctions);
+	// MP4v2 only ever reads through the handle, but its callbacks API takes it non-const
+	ctx.mp4Stream = MP4ReadCallbacks(&loadM4A::ioFunctions, const_cast<inputSource_t *>(&file->source()));
+	if (ctx.mp4Stream == MP4_INVALID_FILE_HANDLE)
+		return nullptr;
 	ctx.aacTrack(info);
-	if (!ctx.decoder)
+	if (!ctx.decoder || ctx.track == MP4_INVALID_TRACK_ID)
 		return nullptr;
 	file->fetchTags();
 
@@ -270,6 +257,10 @@ int64_t m4a_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 					ctx.sampleCount = 0;
 					continue;
 				}
+				// If we just seeked, discard the decoded audio prior to the requested sample
+				const auto skip{std::min(ctx.bytesToSkip, ctx.sampleCount)};
+				ctx.samplesUsed += skip;
+				ctx.bytesToSkip -= skip;
 			}
 			else if (ctx.currentFrame == ctx.frameCount)
 				return -1;
@@ -280,11 +271,48 @@ int64_t m4a_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 		memcpy(buffer + offset, ctx.samples + ctx.samplesUsed, sampleCount);
 		offset += sampleCount;
 		ctx.samplesUsed += sampleCount;
+		ctx.samplePosition += sampleCount / (fileInfo().channels() * sizeof(int16_t));
 	}
 
 	return offset;
 }
 
+/*!
+ * Seeks the decoder to the sample frame given so that the next call to \c fillBuffer()
+ * starts returning audio from that sample. The MP4 sample tables are used to locate
+ * the AAC frame holding the sample, with any audio before it in the frame discarded
+ * @param sampleFrame The sample frame to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool m4a_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *decoderContext();
+	const fileInfo_t &info = fileInfo();
+	const uint32_t timescale = MP4GetTrackTimeScale(ctx.mp4Stream, ctx.track);
+	if (!timescale || !info.bitRate() || !info.channels())
+		return false;
+	// Convert from sample frames to the track's timescale and find the AAC frame covering that time
+	const MP4Timestamp when{(sampleFrame * timescale) / info.bitRate()};
+	const MP4SampleId sampleID = MP4GetSampleIdFromTime(ctx.mp4Stream, ctx.track, when, false);
+	if (sampleID == MP4_INVALID_SAMPLE_ID || sampleID > ctx.frameCount)
+		return false;
+	const MP4Timestamp sampleTime = MP4GetSampleTime(ctx.mp4Stream, ctx.track, sampleID);
+	const uint64_t framesToSkip{((when - sampleTime) * info.bitRate()) / timescale};
+
+	NeAACDecPostSeekReset(ctx.decoder, long(sampleID));
+	// fillBuffer() pre-increments this, so the next frame read will be sampleID
+	ctx.currentFrame = sampleID - 1U;
+	ctx.sampleCount = 0;
+	ctx.samplesUsed = 0;
+	ctx.bytesToSkip = framesToSkip * info.channels() * sizeof(int16_t);
+	ctx.samplePosition = sampleFrame;
+	ctx.eof = false;
+	return true;
+}
+
+uint64_t m4a_t::tell() const noexcept { return decoderContext()->samplePosition; }
+
 // Standard "ftyp" Atom for a MOV based MP4 AAC file:
 // 00 00 00 20 66 74 79 70 4D 34 41 20
 // .  .  .     f  t  y  p  M  4  A
@@ -310,17 +338,21 @@ bool isM4A(const char *fileName) { return m4a_t::isM4A(fileName); }
  * the file contents to see if it is a MP4/M4A file or not
  */
 bool m4a_t::isM4A(const int32_t fd) noexcept
+	{ return isM4A(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a MP4/M4A
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool m4a_t::isM4A(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> length{};
-	std::array<char, 4> typeMagic{};
 	std::array<char, 4> fileMagic{};
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, length.data(), length.size())) == length.size() &&
-		static_cast<size_t>(read(fd, typeMagic.data(), typeMagic.size())) == typeMagic.size() &&
-		static_cast<size_t>(read(fd, fileMagic.data(), fileMagic.size())) == fileMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		typeMagic == libAudio::loadM4A::typeMagic &&
+		probe.matches(4, libAudio::loadM4A::typeMagic) &&
+		probe.read(8, fileMagic) &&
 		(fileMagic == libAudio::loadM4A::m4aMagic || fileMagic == libAudio::loadM4A::mp4Magic);
 }
 
@@ -5,6 +5,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using namespace std::literals::string_view_literals;
 using substrate::make_unique_nothrow;
@@ -25,12 +26,20 @@ namespace libAudio::mod
 	constexpr static std::array<char, 4> modMagic32Channel{{'3', '2', 'C', 'N'}};
 } // namespace libAudio::mod
 
-modMOD_t::modMOD_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleIT, std::move(fd)} { }
+modMOD_t::modMOD_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleIT, std::move(source)} { }
 
 modMOD_t *modMOD_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modMOD_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isMOD(file->_fd) || file->_fd.seek(0, SEEK_SET))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isMOD(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modMOD_t *modMOD_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modMOD_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -38,7 +47,7 @@ modMOD_t *modMOD_t::openR(const char *const fileName) noexcept
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
 	info.channels(2U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -53,13 +62,13 @@ void *modOpenR(const char *fileName) { return modMOD_t::openR(fileName); }
 bool isMOD(const char *fileName) { return modMOD_t::isMOD(fileName); }
 
 bool modMOD_t::isMOD(const int32_t fd) noexcept
+	{ return isMOD(audioProbe_t{fd}); }
+
+bool modMOD_t::isMOD(const audioProbe_t &probe) noexcept
 {
 	constexpr const uint32_t seekOffset = (30 * 31) + 150;
-	std::array<char, 4> modMagic;
-	if (fd == -1 ||
-		lseek(fd, seekOffset, SEEK_SET) != seekOffset ||
-		static_cast<size_t>(read(fd, modMagic.data(), modMagic.size())) != modMagic.size() ||
-		lseek(fd, 0, SEEK_SET) != 0)
+	std::array<char, 4> modMagic{};
+	if (!probe.read(seekOffset, modMagic))
 		return false;
 	return
 		modMagic == libAudio::mod::modMagicMKOrig ||
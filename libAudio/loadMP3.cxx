@@ -1,9 +1,11 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
-#include <limits>
+#include <algorithm>
 
 #include "mp3.hxx"
 #include "string.hxx"
+#include "probe.hxx"
+#include "sampleConversion.hxx"
 
 /*!
  * @internal
@@ -14,28 +16,24 @@
  */
 
 using substrate::make_unique_nothrow;
+using namespace libAudio::sampleConversion;
 
 namespace libAudio::mp3
 {
 	/*!
 	 * @internal
 	 * This function applies a simple conversion algorithm to convert the input
-	 * fixed-point MAD sample to a short for playback
+	 * fixed-point MAD sample to the output sample format
 	 * @param value The fixed point sample to convert
 	 * @return The converted fixed point sample
 	 * @bug This function applies no noise shaping or dithering
 	 *   So the output is sub-par to what it could be. FIXME!
 	 */
-	inline int16_t fixedToInt16(mad_fixed_t value)
+	template<sampleFormat_t format> inline sample_t<format> fixedTo(const mad_fixed_t value) noexcept
 	{
-		using limits = std::numeric_limits<int16_t>;
-		if (value >= MAD_F_ONE)
-			return limits::max();
-		if (value <= -MAD_F_ONE)
-			return limits::min();
-
-		value = value >> (MAD_F_FRACBITS - 15U);
-		return int16_t(value);
+		// Clip to [-1, 1) and then left justify the sample (which has 3 integer bits above the fraction)
+		const auto sample{std::clamp<mad_fixed_t>(value, -MAD_F_ONE, MAD_F_ONE - 1)};
+		return fromInt32<format>(int32_t(uint32_t(sample) << (31U - MAD_F_FRACBITS)));
 	}
 
 	constexpr static std::array<char, 3> id3Magic{{'I', 'D', '3'}};
@@ -43,10 +41,10 @@ namespace libAudio::mp3
 
 using namespace libAudio;
 
-mp3_t::mp3_t(fd_t &&fd, audioModeRead_t) noexcept : audioFile_t{audioType_t::mp3, std::move(fd)},
+mp3_t::mp3_t(inputSource_t &&source, audioModeRead_t) noexcept : audioFile_t{audioType_t::mp3, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
-mp3_t::decoderContext_t::decoderContext_t() noexcept : stream{}, frame{}, synth{}, inputBuffer{}, playbackBuffer{},
-	initialFrame{true}, samplesUsed{0}, eof{false}
+mp3_t::decoderContext_t::decoderContext_t() noexcept : stream{}, frame{}, synth{}, finalData{}, playbackBuffer{},
+	initialFrame{true}, samplesUsed{0}, finalBlock{false}, eof{false}, dataOffset{0}, samplePosition{0}, totalSamples{0}
 {
 	mad_stream_init(&stream);
 	mad_frame_init(&frame);
@@ -56,6 +54,12 @@ mp3_t::decoderContext_t::decoderContext_t() noexcept : stream{}, frame{}, synth{
 constexpr uint32_t mp3Xing = ('X' << 24) | ('i' << 16) | ('n' << 8) | 'g';
 constexpr uint32_t mp3Info = ('I' << 24) | ('n' << 16) | ('f' << 8) | 'o';
 constexpr uint32_t mp3XingFrames = 0x00000001;
+/*!
+ * @internal
+ * How many frames before the one being seeked to are decoded and thrown away, to rebuild
+ * libMAD's bit reservoir, overlap and synthesis filter state before the output is used
+ */
+constexpr uint32_t mp3SeekPreroll{12U};
 
 struct freeDelete final { void operator ()(void *ptr) noexcept { free(ptr); } };
 
@@ -151,37 +155,51 @@ uint64_t decodeIntTag(const id3_tag *tags, const char *tag) noexcept
 	return id3_ucs4_getnumber(str);
 }
 
+/*!
+ * @internal
+ * Parses the ID3 tag at the current possition in \p file, if there is one there
+ * @return The length of the tag in bytes, or 0 if there is no tag
+ */
+size_t parseTag(const inputSource_t &file, std::unique_ptr<id3_tag, void (*)(id3_tag *)> &tags) noexcept
+{
+	const auto header{file.view(ID3_TAG_QUERYSIZE)};
+	if (header.size() != ID3_TAG_QUERYSIZE)
+		return 0U;
+	const auto length{id3_tag_query(header.data(), header.size())};
+	if (length <= 0)
+		return 0U;
+	const auto data{file.view(size_t(length))};
+	if (data.size() != size_t(length))
+		return 0U;
+	tags.reset(id3_tag_parse(data.data(), data.size()));
+	return tags ? data.size() : 0U;
+}
+
 bool mp3_t::readMetadata() noexcept
 {
-	fd_t fileDesc = fd().dup();
+	const inputSource_t &file = source();
 	auto &ctx = *decoderContext();
 	fileInfo_t &info = fileInfo();
-	id3_file *const file = id3_file_fdopen(fileDesc, ID3_FILE_MODE_READONLY);
-	const id3_tag *const tags = id3_file_tag(file);
-
-	info.totalTime(decodeIntTag(tags, "TLEN") / 1000U);
-	info.album(copyTag(tags, ID3_FRAME_ALBUM));
-	info.artist(copyTag(tags, ID3_FRAME_ARTIST));
-	info.title(copyTag(tags, ID3_FRAME_TITLE));
-	cloneComments(tags, ID3_FRAME_COMMENT, info);
-
-	int64_t seekOffset = tags->paddedsize;
-	id3_file_close(file);
-	fileDesc.invalidate();
-	if (fd().seek(seekOffset, SEEK_SET) != seekOffset)
+	// Parse the tags straight out of the input source - an ID3v2 tag at the start
+	// of the file, or failing that an ID3v1 tag at the end
+	std::unique_ptr<id3_tag, void (*)(id3_tag *)> tags{nullptr, id3_tag_delete};
+	const auto seekOffset{off_t(parseTag(file, tags))};
+	if (!tags && file.seek(-128, SEEK_END) != -1)
+		static_cast<void>(parseTag(file, tags));
+	if (!tags)
+		tags.reset(id3_tag_new());
+	if (!tags)
 		return false;
 
-	const uint32_t offset = uint32_t(!ctx.stream.buffer ? 0 : ctx.stream.bufend - ctx.stream.next_frame);
-	if (!fd().read(ctx.inputBuffer.data() + offset, ctx.inputBuffer.size() - offset))
-		return false;
-	mad_stream_buffer(&ctx.stream, ctx.inputBuffer.data(), static_cast<uint32_t>(ctx.inputBuffer.size()));
-	ctx.initialFrame = false;
+	info.totalTime(decodeIntTag(tags.get(), "TLEN") / 1000U);
+	info.album(copyTag(tags.get(), ID3_FRAME_ALBUM));
+	info.artist(copyTag(tags.get(), ID3_FRAME_ARTIST));
+	info.title(copyTag(tags.get(), ID3_FRAME_TITLE));
+	cloneComments(tags.get(), ID3_FRAME_COMMENT, info);
 
-	while (!ctx.frame.header.bitrate || !ctx.frame.header.samplerate)
-	{
-		if (ctx.decodeFrame(fd()) < 0)
-			return false;
-	}
+	ctx.dataOffset = seekOffset;
+	if (!ctx.restart(file))
+		return false;
 
 	const uint32_t frameCount = ctx.parseXingHeader();
 	if (frameCount != 0)
@@ -195,6 +213,9 @@ bool mp3_t::readMetadata() noexcept
 	info.bitRate(ctx.frame.header.samplerate);
 	info.bitsPerSample(16U);
 	info.channels(ctx.frame.header.mode == MAD_MODE_SINGLE_CHANNEL ? 1U : 2U);
+	// Work out how long the stream is in sample frames, preferring the exact Xing frame count
+	ctx.totalSamples = frameCount ? uint64_t{frameCount} * 32U * MAD_NSBSAMPLES(&ctx.frame.header) :
+		info.totalTime() * info.bitRate();
 
 	return true;
 }
@@ -207,8 +228,22 @@ bool mp3_t::readMetadata() noexcept
  */
 mp3_t *mp3_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<mp3_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, audioModeRead_t{})};
-	if (!file || !file->valid() || !isMP3(file->_fd) || !file->readMetadata())
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isMP3(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs a mp3_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isMP3()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+mp3_t *mp3_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<mp3_t>>(std::move(source), audioModeRead_t{})};
+	if (!file || !file->valid() || !file->readMetadata())
 		return nullptr;
 
 	return file.release();
@@ -241,34 +276,46 @@ mp3_t::decoderContext_t::~decoderContext_t() noexcept
 
 /*!
  * @internal
- * Gets the next buffer of MP3 data from the MP3 file
- * @param fd The file to read data from
+ * Hands libMAD the next span of MP3 data from the MP3 file. libMAD decodes straight out of
+ * the input source's data, other than for the final partial span which has to be copied out
+ * so it can be followed by the MAD_BUFFER_GUARD bytes of padding libMAD needs to decode the last frame
+ * @param file The file to read data from
  */
-bool mp3_t::decoderContext_t::readData(const fd_t &fd) noexcept
+bool mp3_t::decoderContext_t::readData(const inputSource_t &file) noexcept
 {
-	const size_t rem = !stream.buffer ? 0 : stream.bufend - stream.next_frame;
-
-	if (stream.next_frame)
-		memmove(inputBuffer.data(), stream.next_frame, rem);
-
-	const size_t count = inputBuffer.size() - rem;
-	if (!fd.read(inputBuffer.data() + rem, count))
+	// If the padded final span has been used up, there's nothing more to decode
+	if (finalBlock)
+	{
+		eof = true;
+		return true;
+	}
+	// Step back over the data libMAD hasn't consumed yet so it's handed over again with what follows it
+	const size_t rem = !stream.buffer || !stream.next_frame ? 0 : stream.bufend - stream.next_frame;
+	if (rem && !file.seekRel(-off_t(rem)))
 		return false;
-	eof = fd.isEOF();
 
-	/*if (*eof)
-		memset(p_MF->inbuff + (2 * 8192), 0x00, 8);*/
+	// So long as there is new data, libMAD decodes the span in place until it runs short of a whole frame
+	const auto data{file.take(inputSource_t::windowSize)};
+	if (data.size() > rem)
+	{
+		mad_stream_buffer(&stream, data.data(), static_cast<unsigned long>(data.size()));
+		return true;
+	}
 
-	mad_stream_buffer(&stream, inputBuffer.data(), static_cast<uint32_t>(inputBuffer.size()));
+	const auto length{std::min(data.size(), finalData.size() - MAD_BUFFER_GUARD)};
+	std::copy_n(data.begin(), length, finalData.begin());
+	std::fill_n(finalData.begin() + length, MAD_BUFFER_GUARD, uint8_t{});
+	mad_stream_buffer(&stream, finalData.data(), static_cast<unsigned long>(length + MAD_BUFFER_GUARD));
+	finalBlock = true;
 	return true;
 }
 
 /*!
  * @internal
  * Loads the next frame of audio from the MP3 file
- * @param fd The file to decode a frame from
+ * @param file The file to decode a frame from
  */
-int32_t mp3_t::decoderContext_t::decodeFrame(const fd_t &fd) noexcept
+int32_t mp3_t::decoderContext_t::decodeFrame(const inputSource_t &file) noexcept
 {
 	if (!initialFrame &&
 		mad_frame_decode(&frame, &stream) &&
@@ -276,9 +323,9 @@ int32_t mp3_t::decoderContext_t::decodeFrame(const fd_t &fd) noexcept
 	{
 		if (stream.error == MAD_ERROR_BUFLEN)
 		{
-			if (!readData(fd) || eof)
+			if (!readData(file) || eof)
 				return -2;
-			return decodeFrame(fd);
+			return decodeFrame(file);
 		}
 		else
 		{
@@ -290,6 +337,63 @@ int32_t mp3_t::decoderContext_t::decodeFrame(const fd_t &fd) noexcept
 	return 0;
 }
 
+/*!
+ * @internal
+ * Skips over the next frame of the MP3 file, only decoding its header
+ * @param file The file to skip a frame of
+ * @return The number of sample frames in the frame skipped, or a negative value on error
+ */
+int32_t mp3_t::decoderContext_t::skipFrame(const inputSource_t &file) noexcept
+{
+	// Decoded into its own header so the frame the next decodeFrame() call decodes is the one after this
+	mad_header header;
+	mad_header_init(&header);
+	if (mad_header_decode(&header, &stream) && !MAD_RECOVERABLE(stream.error))
+	{
+		if (stream.error == MAD_ERROR_BUFLEN)
+		{
+			if (!readData(file) || eof)
+				return -2;
+			return skipFrame(file);
+		}
+		return -1;
+	}
+	// As with decodeFrame(), a recoverable error still counts as a frame as it would still have been synthesised
+	return int32_t(32U * MAD_NSBSAMPLES(&header));
+}
+
+/*!
+ * @internal
+ * Puts libMAD back to how it was having just decoded the first frame of the MP3 data, where readMetadata()
+ * leaves it, so the next frame decoded is the one holding sample frame 0
+ * @param file The file to decode from
+ */
+bool mp3_t::decoderContext_t::restart(const inputSource_t &file) noexcept
+{
+	if (file.seek(dataOffset, SEEK_SET) != dataOffset)
+		return false;
+	mad_synth_finish(&synth);
+	mad_frame_finish(&frame);
+	mad_stream_finish(&stream);
+	mad_stream_init(&stream);
+	mad_frame_init(&frame);
+	mad_synth_init(&synth);
+	samplesUsed = 0;
+	finalBlock = false;
+	eof = false;
+	samplePosition = 0;
+
+	if (!readData(file))
+		return false;
+	initialFrame = false;
+	while (!frame.header.bitrate || !frame.header.samplerate)
+	{
+		if (decodeFrame(file) < 0)
+			return false;
+	}
+	return true;
+}
+
 /*!
  * If using external playback or not using playback at all but rather wanting
  * to get PCM data, this function will do that by filling a buffer of any given length
@@ -299,28 +403,25 @@ int32_t mp3_t::decoderContext_t::decodeFrame(const fd_t &fd) noexcept
  * @return Either a negative value when an error condition is entered,
  * or the number of bytes written to the buffer
  */
-int64_t mp3_t::fillBuffer(void *const bufferPtr, const uint32_t length)
+int64_t mp3_t::fillBuffer(void *const buffer, const uint32_t length)
 {
-	const auto buffer = static_cast<uint8_t *>(bufferPtr);
-	uint32_t offset = 0;
 	const fileInfo_t &info = fileInfo();
 	auto &ctx = *decoderContext();
+	const uint32_t frameBytes = info.bytesPerSample() * info.channels();
+	uint32_t offset = 0;
 
-	while (offset < length && !ctx.eof)
+	while (offset + frameBytes <= length && !ctx.eof)
 	{
-		int16_t *playbackBuffer = reinterpret_cast<int16_t *>(ctx.playbackBuffer + offset);
-		uint32_t count = 0;
-
 		if (!ctx.samplesUsed)
 		{
 			int ret = -1;
 			// Get input if needed, get the stream buffer part of libMAD to process that input.
 			if ((!ctx.stream.buffer || ctx.stream.error == MAD_ERROR_BUFLEN) &&
-				!ctx.readData(fd()))
+				!ctx.readData(source()))
 				return ret;
 
 			// Decode a frame:
-			ret = ctx.decodeFrame(fd());
+			ret = ctx.decodeFrame(source());
 			if (ret)
 				return ret;
 
@@ -331,32 +432,87 @@ int64_t mp3_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 			mad_synth_frame(&ctx.synth, &ctx.frame);
 		}
 
-		// copy the PCM to our output buffer
-		for (uint16_t index = 0, i = ctx.samplesUsed; i < ctx.synth.pcm.length; ++i)
+		// Convert as much of the PCM as will fit directly into the output buffer
+		const uint32_t frames = std::min<uint32_t>((length - offset) / frameBytes,
+			ctx.synth.pcm.length - ctx.samplesUsed);
+		withSampleFormat(info.sampleFormat(), [&](const auto format)
 		{
-			playbackBuffer[index++] = mp3::fixedToInt16(ctx.synth.pcm.samples[0][i]);
-			if (info.channels() == 2)
-				playbackBuffer[index++] = mp3::fixedToInt16(ctx.synth.pcm.samples[1][i]);
-			count += sizeof(int16_t) * info.channels();
-
-			if ((offset + count) >= length)
+			constexpr auto outputFormat{decltype(format)::value};
+			auto *const samples{reinterpret_cast<sample_t<outputFormat> *>(static_cast<uint8_t *>(buffer) + offset)};
+			const auto &pcm{ctx.synth.pcm.samples};
+			for (uint32_t i = 0, index = 0; i < frames; ++i)
 			{
-				ctx.samplesUsed = ++i;
-				break;
+				samples[index++] = mp3::fixedTo<outputFormat>(pcm[0][ctx.samplesUsed + i]);
+				if (info.channels() == 2)
+					samples[index++] = mp3::fixedTo<outputFormat>(pcm[1][ctx.samplesUsed + i]);
 			}
-		}
+		});
 
-		if ((offset + count) < length)
+		ctx.samplesUsed += frames;
+		if (ctx.samplesUsed == ctx.synth.pcm.length)
 			ctx.samplesUsed = 0;
-
-		if (buffer != ctx.playbackBuffer)
-			memcpy(buffer + offset, playbackBuffer, count);
-		offset += count;
+		offset += frames * frameBytes;
+		ctx.samplePosition += frames;
 	}
 
 	return offset;
 }
 
+/*!
+ * @internal
+ * libMAD produces fixed point samples with more precision than 16-bit, so
+ * can supply any of the output formats save 8-bit
+ */
+bool mp3_t::canOutput(const sampleFormat_t format) const noexcept
+	{ return format != sampleFormat_t::int8; }
+
+/*!
+ * Seeks the decoder to the sample frame given. As MP3 has no sample-accurate index and each frame depends
+ * on those before it, this restarts from the first frame, skips whole frames up to a few before the one
+ * holding the target, and decodes and discards from there so decoding picks up exactly at \p sampleFrame
+ * @param sampleFrame The sample frame to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool mp3_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *decoderContext();
+	const inputSource_t &file = source();
+	if (!ctx.totalSamples || sampleFrame > ctx.totalSamples || !ctx.restart(file))
+		return false;
+
+	// Every frame in the stream is the same length, so the frame holding the target is known up front
+	const uint64_t frameLength{32U * MAD_NSBSAMPLES(&ctx.frame.header)};
+	const uint64_t targetFrame{sampleFrame / frameLength};
+	uint64_t position{0U};
+	for (uint64_t frame{0U}; frame + mp3SeekPreroll < targetFrame; ++frame)
+	{
+		const auto samples{ctx.skipFrame(file)};
+		if (samples < 0)
+			return false;
+		position += uint64_t(samples);
+	}
+
+	// Decode the frames left before the target, and the one holding it if it isn't on a frame boundary
+	while (position < sampleFrame)
+	{
+		if (ctx.decodeFrame(file))
+			return false;
+		mad_synth_frame(&ctx.synth, &ctx.frame);
+		const uint64_t samples{ctx.synth.pcm.length};
+		if (position + samples > sampleFrame)
+		{
+			ctx.samplesUsed = uint16_t(sampleFrame - position);
+			break;
+		}
+		position += samples;
+	}
+	ctx.samplePosition = sampleFrame;
+	return true;
+}
+
+uint64_t mp3_t::tell() const noexcept { return decoderContext()->samplePosition; }
+
 /*!
  * Checks the file given by \p fileName for whether it is an MP3
  * file recognised by this library or not
@@ -381,16 +537,21 @@ inline uint16_t asUint16(const std::array<uint8_t, 2> &value) noexcept
  * the file contents to see if it is a MP3 file or not
  */
 bool mp3_t::isMP3(const int32_t fd) noexcept
+	{ return isMP3(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a MP3
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool mp3_t::isMP3(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 3> id3Magic{};
 	std::array<uint8_t, 2> mp3Magic{};
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, id3Magic.data(), id3Magic.size())) == id3Magic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		static_cast<size_t>(read(fd, mp3Magic.data(), mp3Magic.size())) == mp3Magic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		(id3Magic == libAudio::mp3::id3Magic || asUint16(mp3Magic) == 0xFFFB);
+		probe.matches(0, libAudio::mp3::id3Magic) ||
+		(probe.read(0, mp3Magic) && asUint16(mp3Magic) == 0xFFFB);
 }
 
 /*!
@@ -7,6 +7,7 @@
 
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -96,7 +97,7 @@ namespace libAudio::mpc
 	int32_t read(mpc_reader *reader, void *buffer, int bufferLen)
 	{
 		const auto file = static_cast<mpc_t *>(reader->data);
-		return int32_t(file->fd().read(buffer, bufferLen, nullptr));
+		return int32_t(file->source().read(buffer, bufferLen, nullptr));
 	}
 
 	/*!
@@ -111,7 +112,7 @@ namespace libAudio::mpc
 	uint8_t seek(mpc_reader *reader, int offset)
 	{
 		const auto file = static_cast<mpc_t *>(reader->data);
-		return file->fd().seek(offset, SEEK_SET) == offset;
+		return file->source().seek(offset, SEEK_SET) == offset;
 	}
 
 	/*!
@@ -125,7 +126,7 @@ namespace libAudio::mpc
 	int32_t tell(mpc_reader *reader)
 	{
 		const auto file = static_cast<mpc_t *>(reader->data);
-		return int32_t(file->fd().tell());
+		return int32_t(file->source().tell());
 	}
 
 	/*!
@@ -139,7 +140,7 @@ namespace libAudio::mpc
 	int32_t length(mpc_reader *reader)
 	{
 		const auto file = static_cast<mpc_t *>(reader->data);
-		return int32_t(file->fd().length());
+		return int32_t(file->source().length());
 	}
 
 	/*!
@@ -156,7 +157,7 @@ namespace libAudio::mpc
 	uint8_t canSeek(mpc_reader *reader)
 	{
 		const auto file = static_cast<mpc_t *>(reader->data);
-		return file->fd().tell() != -1;
+		return file->source().tell() != -1;
 	}
 
 	constexpr static std::array<char, 3> mpcMagic{{'M', 'P', 'C'}};
@@ -165,7 +166,7 @@ namespace libAudio::mpc
 
 using namespace libAudio;
 
-mpc_t::mpc_t(fd_t &&fd) noexcept : audioFile_t{audioType_t::musePack, std::move(fd)},
+mpc_t::mpc_t(inputSource_t &&source) noexcept : audioFile_t{audioType_t::musePack, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 mpc_t::decoderContext_t::decoderContext_t() noexcept : demuxer{nullptr}, streamInfo{}, frameInfo{}, playbackBuffer{},
 	samplesUsed{0}, callbacks{mpc::read, mpc::seek, mpc::tell, mpc::length, mpc::canSeek, nullptr} { }
@@ -178,8 +179,22 @@ mpc_t::decoderContext_t::decoderContext_t() noexcept : demuxer{nullptr}, streamI
  */
 mpc_t *mpc_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<mpc_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isMPC(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isMPC(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs a mpc_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isMPC()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+mpc_t *mpc_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<mpc_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -294,13 +309,20 @@ bool isMPC(const char *fileName) { return mpc_t::isMPC(fileName); }
  * the file contents to see if it is a MPC file or not
  */
 bool mpc_t::isMPC(const int32_t fd) noexcept
+	{ return isMPC(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a MPC
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool mpc_t::isMPC(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 3> mpcMagic{};
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, mpcMagic.data(), mpcMagic.size())) == mpcMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		(mpcMagic == libAudio::mpc::mpPlusMagic || mpcMagic == libAudio::mpc::mpcMagic);
+		probe.matches(0, libAudio::mpc::mpPlusMagic) ||
+		probe.matches(0, libAudio::mpc::mpcMagic);
 }
 
 /*!
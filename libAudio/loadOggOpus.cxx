@@ -1,8 +1,12 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2019-2023 Rachel Mant <git@dragonmux.network>
+#include <cstring>
+
 #include "libAudio.h"
 #include "libAudio.hxx"
 #include "oggOpus.hxx"
+#include "probe.hxx"
+#include "sampleConversion.hxx"
 
 /*!
  * @internal
@@ -13,6 +17,7 @@
  */
 
 using substrate::make_unique_nothrow;
+using namespace libAudio::sampleConversion;
 
 namespace libAudio::oggOpus
 {
@@ -20,7 +25,7 @@ namespace libAudio::oggOpus
 	{
 		const auto *const file{static_cast<const oggOpus_t *>(filePtr)};
 		size_t bytes{0};
-		if (file->fd().read(buffer, bufferLen, bytes))
+		if (file->source().read(buffer, bufferLen, bytes))
 			return int(bytes);
 		return -1;
 	}
@@ -28,13 +33,13 @@ namespace libAudio::oggOpus
 	int seek(void *const filePtr, const opus_int64 offset, const int whence)
 	{
 		const auto *const file{static_cast<const oggOpus_t *>(filePtr)};
-		return file->fd().seek(offset, whence) >= 0 ? 0 : -1;
+		return file->source().seek(offset, whence) >= 0 ? 0 : -1;
 	}
 
 	opus_int64 tell(void *const filePtr)
 	{
 		const auto *const file{static_cast<const oggOpus_t *>(filePtr)};
-		return file->fd().tell();
+		return file->source().tell();
 	}
 
 	constexpr static OpusFileCallbacks callbacks
@@ -48,7 +53,7 @@ namespace libAudio::oggOpus
 
 using namespace libAudio;
 
-oggOpus_t::oggOpus_t(fd_t &&fd, audioModeRead_t) noexcept : audioFile_t{audioType_t::oggOpus, std::move(fd)},
+oggOpus_t::oggOpus_t(inputSource_t &&source, audioModeRead_t) noexcept : audioFile_t{audioType_t::oggOpus, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 oggOpus_t::decoderContext_t::decoderContext_t() noexcept : decoder{}, playbackBuffer{}, eof{false} { }
 
@@ -60,8 +65,22 @@ oggOpus_t::decoderContext_t::decoderContext_t() noexcept : decoder{}, playbackBu
  */
 oggOpus_t *oggOpus_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<oggOpus_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, audioModeRead_t{})};
-	if (!file || !file->valid() || !isOggOpus(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isOggOpus(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs an oggOpus_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isOggOpus()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+oggOpus_t *oggOpus_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<oggOpus_t>>(std::move(source), audioModeRead_t{})};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->decoderContext();
 	fileInfo_t &info = file->fileInfo();
@@ -110,16 +129,35 @@ void *oggOpusOpenR(const char *fileName) { return oggOpus_t::openR(fileName); }
  */
 int64_t oggOpus_t::fillBuffer(void *const bufferPtr, const uint32_t bufferLen)
 {
-	const auto buffer = static_cast<int16_t *>(bufferPtr);
-	const uint32_t length = bufferLen >> 1;
-	uint32_t offset = 0;
 	auto &ctx = *decoderContext();
-
 	if (ctx.eof)
 		return -2;
+	// 16-bit output is libopusfile's native format, so is best handled by it directly
+	if (fileInfo().sampleFormat() == sampleFormat_t::int16)
+	{
+		const auto buffer = static_cast<int16_t *>(bufferPtr);
+		const uint32_t length = bufferLen >> 1;
+		uint32_t offset = 0;
+		while (offset < length && !ctx.eof)
+		{
+			const int result = op_read_stereo(ctx.decoder, buffer + offset, length - offset);
+			if (result > 0)
+				offset += uint32_t(result) << 1;
+			else if (result == OP_HOLE || result == OP_EBADLINK)
+				return -1;
+			else if (result == 0)
+				ctx.eof = true;
+		}
+		return offset << 1;
+	}
+
+	// Otherwise decode to float, which for the 24- and 32-bit formats is then converted in place
+	const auto buffer = static_cast<float *>(bufferPtr);
+	const uint32_t length = bufferLen >> 2;
+	uint32_t offset = 0;
 	while (offset < length && !ctx.eof)
 	{
-		const int result = op_read_stereo(ctx.decoder, buffer + offset, length - offset);
+		const int result = op_read_float_stereo(ctx.decoder, buffer + offset, length - offset);
 		if (result > 0)
 			offset += uint32_t(result) << 1;
 		else if (result == OP_HOLE || result == OP_EBADLINK)
@@ -127,7 +165,52 @@ int64_t oggOpus_t::fillBuffer(void *const bufferPtr, const uint32_t bufferLen)
 		else if (result == 0)
 			ctx.eof = true;
 	}
-	return offset << 1;
+	withSampleFormat(fileInfo().sampleFormat(), [&](const auto format)
+	{
+		constexpr auto outputFormat{decltype(format)::value};
+		if constexpr (outputFormat == sampleFormat_t::int24 || outputFormat == sampleFormat_t::int32)
+		{
+			auto *const samples{static_cast<int32_t *>(bufferPtr)};
+			for (uint32_t i = 0; i < offset; ++i)
+			{
+				float sample{};
+				std::memcpy(&sample, samples + i, sizeof(float));
+				samples[i] = fromFloat<outputFormat>(sample);
+			}
+		}
+	});
+	return offset << 2;
+}
+
+/*!
+ * @internal
+ * libopusfile decodes to floating point internally so
+ * can supply any of the output formats save 8-bit
+ */
+bool oggOpus_t::canOutput(const sampleFormat_t format) const noexcept
+	{ return format != sampleFormat_t::int8; }
+
+/*!
+ * Seeks the decoder to the sample frame given so that the next call to \c fillBuffer()
+ * starts returning audio from exactly that sample
+ * @param sampleFrame The sample frame (at 48kHz) to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool oggOpus_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *decoderContext();
+	if (!op_seekable(ctx.decoder) || op_pcm_seek(ctx.decoder, ogg_int64_t(sampleFrame)))
+		return false;
+	ctx.eof = false;
+	return true;
+}
+
+uint64_t oggOpus_t::tell() const noexcept
+{
+	const auto &ctx = *decoderContext();
+	const auto position{op_pcm_tell(ctx.decoder)};
+	return position < 0 ? 0U : uint64_t(position);
 }
 
 oggOpus_t::decoderContext_t::~decoderContext_t() noexcept { op_free(decoder); }
@@ -153,9 +236,19 @@ bool isOggOpus(const char *fileName) { return oggOpus_t::isOggOpus(fileName); }
  * the file contents to see if it is a Ogg|Opus file or not
  */
 bool oggOpus_t::isOggOpus(const int32_t fd) noexcept
+	{ return isOggOpus(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents an Ogg|Opus
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool oggOpus_t::isOggOpus(const audioProbe_t &probe) noexcept
 {
 	ogg_packet header;
-	return isOgg(fd, header) && isOpus(header);
+	return isOgg(probe, header) && isOpus(header);
 }
 
 /*!
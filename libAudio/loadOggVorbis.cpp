@@ -4,9 +4,12 @@
 
 #include "oggVorbis.hxx"
 #include "string.hxx"
+#include "probe.hxx"
+#include "sampleConversion.hxx"
 
 using namespace std::literals::string_view_literals;
 using substrate::make_unique_nothrow;
+using namespace libAudio::sampleConversion;
 
 /*!
  * @internal
@@ -22,7 +25,7 @@ namespace libAudio::oggVorbis
 	{
 		const auto file = static_cast<const oggVorbis_t *>(filePtr);
 		size_t bytes = 0;
-		const bool result = file->fd().read(buffer, size * count, bytes);
+		const bool result = file->source().read(buffer, size * count, bytes);
 		if (result)
 			return bytes;
 		return 0;
@@ -31,13 +34,13 @@ namespace libAudio::oggVorbis
 	int seek(void *filePtr, int64_t offset, int whence)
 	{
 		const auto file = static_cast<const oggVorbis_t *>(filePtr);
-		return int(file->fd().seek(offset, whence));
+		return int(file->source().seek(offset, whence));
 	}
 
 	long tell(void *filePtr)
 	{
 		const auto file = static_cast<const oggVorbis_t *>(filePtr);
-		return long(file->fd().tell());
+		return long(file->source().tell());
 	}
 
 	constexpr static ov_callbacks callbacks
@@ -75,8 +78,8 @@ namespace libAudio::oggVorbis
 
 using namespace libAudio;
 
-oggVorbis_t::oggVorbis_t(fd_t &&fd, audioModeRead_t) noexcept :
-	audioFile_t{audioType_t::oggVorbis, std::move(fd)},
+oggVorbis_t::oggVorbis_t(inputSource_t &&source, audioModeRead_t) noexcept :
+	audioFile_t{audioType_t::oggVorbis, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 oggVorbis_t::decoderContext_t::decoderContext_t() noexcept : decoder{}, playbackBuffer{}, eof{false} { }
 
@@ -88,8 +91,22 @@ oggVorbis_t::decoderContext_t::decoderContext_t() noexcept : decoder{}, playback
  */
 oggVorbis_t *oggVorbis_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<oggVorbis_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, audioModeRead_t{})};
-	if (!file || !file->valid() || !isOggVorbis(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isOggVorbis(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs an oggVorbis_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isOggVorbis()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+oggVorbis_t *oggVorbis_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<oggVorbis_t>>(std::move(source), audioModeRead_t{})};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->decoderContext();
 	fileInfo_t &info = file->fileInfo();
@@ -145,18 +162,80 @@ int64_t oggVorbis_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 
 	if (ctx.eof)
 		return -2;
-	while (offset < length && !ctx.eof)
+	// 16-bit output is libvorbisfile's native format, so is best handled by it directly
+	if (info.sampleFormat() == sampleFormat_t::int16)
 	{
-		const long result = ov_read(&ctx.decoder, buffer + offset, length - offset,
-			0, info.bitsPerSample() / 8U, 1, nullptr);
-		if (result > 0)
-			offset += uint32_t(result);
-		else if (result == OV_HOLE || result == OV_EBADLINK)
-			return -1;
-		else if (result == 0)
-			ctx.eof = true;
+		while (offset < length && !ctx.eof)
+		{
+			const long result = ov_read(&ctx.decoder, buffer + offset, length - offset,
+				0, info.bitsPerSample() / 8U, 1, nullptr);
+			if (result > 0)
+				offset += uint32_t(result);
+			else if (result == OV_HOLE || result == OV_EBADLINK)
+				return -1;
+			else if (result == 0)
+				ctx.eof = true;
+		}
+		return offset;
 	}
-	return offset;
+
+	// For everything else, take the decoder's float output and interleave and convert it ourselves
+	const uint32_t frameBytes = info.bytesPerSample() * info.channels();
+	return withSampleFormat(info.sampleFormat(), [&](const auto format) -> int64_t
+	{
+		constexpr auto outputFormat{decltype(format)::value};
+		while (offset + frameBytes <= length && !ctx.eof)
+		{
+			float **pcm{nullptr};
+			const long result = ov_read_float(&ctx.decoder, &pcm, int((length - offset) / frameBytes), nullptr);
+			if (result > 0)
+			{
+				auto *const samples{reinterpret_cast<sample_t<outputFormat> *>(buffer + offset)};
+				for (long i = 0, index = 0; i < result; ++i)
+				{
+					for (uint8_t channel = 0; channel < info.channels(); ++channel)
+						samples[index++] = fromFloat<outputFormat>(pcm[channel][i]);
+				}
+				offset += uint32_t(result) * frameBytes;
+			}
+			else if (result == OV_HOLE || result == OV_EBADLINK)
+				return -1;
+			else if (result == 0)
+				ctx.eof = true;
+		}
+		return offset;
+	});
+}
+
+/*!
+ * @internal
+ * libvorbisfile decodes to floating point internally so
+ * can supply any of the output formats save 8-bit
+ */
+bool oggVorbis_t::canOutput(const sampleFormat_t format) const noexcept
+	{ return format != sampleFormat_t::int8; }
+
+/*!
+ * Seeks the decoder to the sample frame given so that the next call to \c fillBuffer()
+ * starts returning audio from exactly that sample
+ * @param sampleFrame The sample frame to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool oggVorbis_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *decoderContext();
+	if (!ov_seekable(&ctx.decoder) || ov_pcm_seek(&ctx.decoder, ogg_int64_t(sampleFrame)))
+		return false;
+	ctx.eof = false;
+	return true;
+}
+
+uint64_t oggVorbis_t::tell() const noexcept
+{
+	auto &ctx = *decoderContext();
+	const auto position{ov_pcm_tell(&ctx.decoder)};
+	return position < 0 ? 0U : uint64_t(position);
 }
 
 oggVorbis_t::decoderContext_t::~decoderContext_t() noexcept
@@ -183,9 +262,19 @@ bool isOggVorbis(const char *fileName) { return oggVorbis_t::isOggVorbis(fileNam
  * the file contents to see if it is a Ogg|Vorbis file or not
  */
 bool oggVorbis_t::isOggVorbis(const int32_t fd) noexcept
+	{ return isOggVorbis(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents an Ogg|Vorbis
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool oggVorbis_t::isOggVorbis(const audioProbe_t &probe) noexcept
 {
 	ogg_packet header;
-	return isOgg(fd, header) && isVorbis(header);
+	return isOgg(probe, header) && isVorbis(header);
 }
 
 /*!
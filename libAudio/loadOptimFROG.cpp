@@ -6,6 +6,7 @@
 
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -49,7 +50,7 @@ namespace libAudio::optimFROG
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
 		size_t bytes{0};
-		const auto result{file->fd().read(buffer, count, bytes)};
+		const auto result{file->source().read(buffer, count, bytes)};
 		if (result)
 			return static_cast<sInt32_t>(bytes);
 		return -1;
@@ -58,31 +59,31 @@ namespace libAudio::optimFROG
 	condition_t isEOF(void *const filePtr)
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
-		return file->fd().isEOF() ? C_TRUE : C_FALSE;
+		return file->source().isEOF() ? C_TRUE : C_FALSE;
 	}
 
 	condition_t seekable(void *const filePtr)
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
-		return file->fd().seek(0, SEEK_CUR) == -1 && errno == ESPIPE ? C_FALSE : C_TRUE;
+		return file->source().seek(0, SEEK_CUR) == -1 && errno == ESPIPE ? C_FALSE : C_TRUE;
 	}
 
 	sInt64_t length(void *const filePtr)
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
-		return file->fd().length();
+		return file->source().length();
 	}
 
 	sInt64_t tell(void *const filePtr)
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
-		return file->fd().tell();
+		return file->source().tell();
 	}
 
 	condition_t seek(void *const filePtr, const sInt64_t offset)
 	{
 		const auto *const file{static_cast<const optimFROG_t *>(filePtr)};
-		return file->fd().seek(offset, SEEK_SET) == offset ? C_TRUE : C_FALSE;
+		return file->source().seek(offset, SEEK_SET) == offset ? C_TRUE : C_FALSE;
 	}
 
 	// NOLINTNEXTLINE(cppcoreguidelines-avoid-non-const-global-variables)
@@ -102,15 +103,23 @@ namespace libAudio::optimFROG
 
 using namespace libAudio;
 
-optimFROG_t::optimFROG_t(fd_t &&fd) noexcept : audioFile_t{audioType_t::optimFROG, std::move(fd)},
+optimFROG_t::optimFROG_t(inputSource_t &&source) noexcept : audioFile_t{audioType_t::optimFROG, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 optimFROG_t::decoderContext_t::decoderContext_t() noexcept : decoder{OptimFROG_createInstance()},
 	playbackBuffer{}, eof{false} { }
 
 optimFROG_t *optimFROG_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<optimFROG_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isOptimFROG(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isOptimFROG(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+optimFROG_t *optimFROG_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<optimFROG_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -196,13 +205,11 @@ optimFROG_t::decoderContext_t::~decoderContext_t() noexcept
 bool isOptimFROG(const char *fileName) { return optimFROG_t::isOptimFROG(fileName); }
 
 bool optimFROG_t::isOptimFROG(const int32_t fd) noexcept
+	{ return isOptimFROG(audioProbe_t{fd}); }
+
+bool optimFROG_t::isOptimFROG(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> optimFrogMagic{};
-	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, optimFrogMagic.data(), optimFrogMagic.size())) == optimFrogMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		optimFrogMagic == libAudio::optimFROG::magic;
+	return probe.matches(0, libAudio::optimFROG::magic);
 }
 
 bool optimFROG_t::isOptimFROG(const char *const fileName) noexcept
@@ -3,6 +3,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using substrate::make_unique_nothrow;
 
@@ -12,19 +13,27 @@ namespace libAudio::s3m
 	constexpr static std::array<char, 4> s3mMagic2{{'S', 'C', 'R', 'M'}};
 }
 
-modS3M_t::modS3M_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleS3M, std::move(fd)} { }
+modS3M_t::modS3M_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleS3M, std::move(source)} { }
 
 modS3M_t *modS3M_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modS3M_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isS3M(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isS3M(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modS3M_t *modS3M_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modS3M_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
 
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -40,20 +49,17 @@ void *s3mOpenR(const char *fileName) { return modS3M_t::openR(fileName); }
 bool isS3M(const char *fileName) { return modS3M_t::isS3M(fileName); }
 
 bool modS3M_t::isS3M(const int32_t fd) noexcept
+	{ return isS3M(audioProbe_t{fd}); }
+
+bool modS3M_t::isS3M(const audioProbe_t &probe) noexcept
 {
-	constexpr static size_t seekOffset1 = 28;
-	constexpr static size_t seekOffset2 = seekOffset1 + 16;
-	char s3mMagic1;
-	std::array<char, 4> s3mMagic2;
+	constexpr static size_t offset1 = 28;
+	constexpr static size_t offset2 = offset1 + 16;
+	std::array<char, 1> s3mMagic1{};
 	return
-		fd != -1 &&
-		lseek(fd, seekOffset1, SEEK_SET) == seekOffset1 &&
-		read(fd, &s3mMagic1, 1U) == 1 &&
-		lseek(fd, seekOffset2, SEEK_SET) == seekOffset2 &&
-		static_cast<size_t>(read(fd, s3mMagic2.data(), s3mMagic2.size())) == s3mMagic2.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		s3mMagic1 == libAudio::s3m::s3mMagic1 &&
-		s3mMagic2 == libAudio::s3m::s3mMagic2;
+		probe.read(offset1, s3mMagic1) &&
+		s3mMagic1[0] == libAudio::s3m::s3mMagic1 &&
+		probe.matches(offset2, libAudio::s3m::s3mMagic2);
 }
 
 bool modS3M_t::isS3M(const char *const fileName) noexcept
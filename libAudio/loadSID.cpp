@@ -1,7 +1,23 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2012-2023 Rachel Mant <git@dragonmux.network>
+#include <substrate/utility>
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "console.hxx"
+#include "sid/loader.hxx"
+#include "emulator/commodore64.hxx"
+#include "probe.hxx"
+
+/*!
+ * @internal
+ * @file loadSID.cpp
+ * @brief The implementation of the SID decoder API
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2012-2026
+ */
+
+using namespace std::literals::string_view_literals;
+using substrate::make_unique_nothrow;
 
 /*!
  * @internal
@@ -9,44 +25,154 @@
  */
 struct sid_t::decoderContext_t final
 {
+	uint8_t playbackBuffer[8192];
+	// The machine depends on the SID model and video standard the tune asks for, so is made once those are known
+	std::unique_ptr<commodore64_t> emulator{};
+	// PSIDs carry no length information, so play for 3m (180s) of samples at the current sample rate
+	uint32_t totalPlaybackSamples{180U * commodore64_t::sampleRate};
+	uint32_t generatedSamples{0U};
+	bool eof{false};
 };
 
+using libAudio::console::asHex_t;
+
 namespace libAudio::sid
 {
 	constexpr static std::array<char, 4> psidMagic{{'P', 'S', 'I', 'D'}};
 }
 
-sid_t::sid_t(fd_t &&fd) noexcept : audioFile_t{audioType_t::sid, std::move(fd)} { }
+sid_t::sid_t(inputSource_t &&source) noexcept : audioFile_t{audioType_t::sid, std::move(source)},
+	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
+
+void loadFileInfo(fileInfo_t &info, sidMetadata_t &metadata) noexcept
+{
+	info.title(std::move(metadata.title));
+	info.artist(std::move(metadata.artist));
+	if (metadata.released)
+		info.addOtherComment(std::move(metadata.released));
+
+	// The playback engine is written to generate data in 16-bit, one channel
+	info.bitsPerSample(16U);
+	info.channels(1U);
+}
 
 sid_t *sid_t::openR(const char *const fileName) noexcept
 {
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isSID(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+sid_t *sid_t::openR(inputSource_t &&source) noexcept try
+{
+	std::unique_ptr<sid_t> file{make_unique_nothrow<playableFile_t<sid_t>>(std::move(source))};
+	if (!file || !file->valid())
+		return nullptr;
+	auto &ctx = *file->context();
+	fileInfo_t &info = file->fileInfo();
+	sidLoader_t loader{file->_source};
+
+	auto &metadata = loader.metadata();
+	const auto &entryPoints = loader.entryPoints();
+	const auto tune{metadata.defaultTune};
+	const auto ciaSpeed{loader.ciaSpeed(tune)};
+	console.debug("PSID metadata"sv);
+	console.debug(" -> load at "sv, asHex_t<4U, '0'>{entryPoints.load}, ", init at "sv,
+		asHex_t<4U, '0'>{entryPoints.init}, ", play at "sv, asHex_t<4U, '0'>{entryPoints.play});
+	console.debug(" -> playing tune "sv, tune, " of "sv, metadata.tuneCount, ciaSpeed ? " at CIA speed"sv : ""sv);
+
+	ctx.emulator = make_unique_nothrow<commodore64_t>(metadata.model, metadata.ntsc);
+	if (!ctx.emulator)
+		return nullptr;
+	// Copy the metadata for this PSID into the fileInfo_t, and then copy the tune into emulator memory
+	info.bitRate(commodore64_t::sampleRate);
+	loadFileInfo(info, metadata);
+	if (!loader.copyToRAM(*ctx.emulator) ||
+		// Having done this, set up to play the tune the file says to start with
+		!ctx.emulator->init(entryPoints.init, entryPoints.play, static_cast<uint8_t>(tune - 1U), ciaSpeed))
+	{
+		ctx.emulator->displayCPUState();
+		console.error("Error while setting up emulator for SID file"sv);
+		return nullptr;
+	}
+
+	return file.release();
+}
+catch (const std::exception &)
+{
+	console.error("Failed to load SID file"sv);
 	return nullptr;
 }
 
+/*!
+ * Reads the information for the SID file in \c source from its header, without booting the
+ * emulator or running any of the tune's code
+ * @param source The file to read from, which must already have been identified by \c isSID()
+ * @param info The fileInfo_t to fill out
+ * @return \c true if the file's information could be read, otherwise \c false
+ */
+bool sid_t::readInfo(inputSource_t &&source, fileInfo_t &info) noexcept try
+{
+	const inputSource_t file{std::move(source)};
+	if (!file.valid())
+		return false;
+	sidLoader_t loader{file};
+	info.bitRate(commodore64_t::sampleRate);
+	loadFileInfo(info, loader.metadata());
+	return true;
+}
+catch (const std::exception &)
+{
+	console.error("Failed to load SID file"sv);
+	return false;
+}
+
 void sid_t::ensurePlayable() noexcept
 {
 	if (!_player)
 	{
-		// auto &ctx = *decoderContext();
-		// const fileInfo_t &info = fileInfo();
-		// player(make_unique_nothrow<playback_t>(this, audioFillBuffer, ctx.playbackBuffer, 8192U, info));
+		auto &ctx = *context();
+		const fileInfo_t &info = fileInfo();
+		player(make_unique_nothrow<playback_t>(this, audioFillBuffer, ctx.playbackBuffer, 8192U, info));
 	}
 }
 
 void *sidOpenR(const char *fileName) { return sid_t::openR(fileName); }
 
-int64_t sid_t::fillBuffer(void *const, const uint32_t) { return -1; }
+int64_t sid_t::fillBuffer(void *const bufferPtr, const uint32_t length)
+{
+	const auto buffer = static_cast<int16_t *>(bufferPtr);
+	auto &ctx = *context();
+	if (ctx.eof)
+		return -2;
+	// Calculate how many samples should be filled in this buffer
+	const size_t samples = std::min(ctx.totalPlaybackSamples - ctx.generatedSamples, length / 2U);
+	// Run the machine for the whole block in one go, with the SID rendering straight into the buffer
+	if (!ctx.emulator->render({buffer, samples}))
+	{
+		// If something went wrong while emulating the machine, display the
+		// crash state to allow debugging
+		ctx.emulator->displayCPUState();
+		return -1;
+	}
+	// Update the total number of samples generated so far with how many more we made this call
+	ctx.generatedSamples += static_cast<uint32_t>(samples);
+	// If we've now generated all the samples this song calls for, mark us done
+	if (ctx.totalPlaybackSamples == ctx.generatedSamples)
+		ctx.eof = true;
+	// Return how much we filled the buffer by
+	return samples * 2U;
+}
 
 bool isSID(const char *fileName) { return sid_t::isSID(fileName); }
 
 bool sid_t::isSID(const int32_t fd) noexcept
+	{ return isSID(audioProbe_t{fd}); }
+
+bool sid_t::isSID(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> sidMagic;
-	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, sidMagic.data(), sidMagic.size())) == sidMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		sidMagic == libAudio::sid::psidMagic;
+	return probe.matches(0, libAudio::sid::psidMagic);
 }
 
 bool sid_t::isSID(const char *const fileName) noexcept
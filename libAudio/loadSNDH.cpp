@@ -6,6 +6,7 @@
 #include "console.hxx"
 #include "sndh/loader.hxx"
 #include "emulator/atariSTe.hxx"
+#include "probe.hxx"
 
 /*!
  * @internal
@@ -36,7 +37,7 @@ namespace libAudio::sndh
 	constexpr static std::array<char, 4> sndhMagic{{'S', 'N', 'D', 'H'}};
 }
 
-sndh_t::sndh_t(fd_t &&fd) noexcept : audioFile_t{audioType_t::sndh, std::move(fd)},
+sndh_t::sndh_t(inputSource_t &&source) : audioFile_t{audioType_t::sndh, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>()} { }
 
 void loadFileInfo(fileInfo_t &info, sndhMetadata_t &metadata) noexcept
@@ -55,14 +56,22 @@ void loadFileInfo(fileInfo_t &info, sndhMetadata_t &metadata) noexcept
 	info.channels(1U);
 }
 
-sndh_t *sndh_t::openR(const char *const fileName) noexcept try
+sndh_t *sndh_t::openR(const char *const fileName) noexcept
 {
-	std::unique_ptr<sndh_t> file{make_unique_nothrow<sndh_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isSNDH(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isSNDH(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+sndh_t *sndh_t::openR(inputSource_t &&source) noexcept try
+{
+	std::unique_ptr<sndh_t> file{make_unique_nothrow<playableFile_t<sndh_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
-	sndhLoader_t loader{file->_fd};
+	sndhLoader_t loader{file->_source};
 
 	auto &metadata = loader.metadata();
 	console.debug("SNDH metadata"sv);
@@ -105,6 +114,29 @@ catch (const std::exception &)
 	return nullptr;
 }
 
+/*!
+ * Reads the information for the SNDH file in \c source, decrunching it to get at its tags
+ * but without booting the emulator or running any of the tune's code
+ * @param source The file to read from, which must already have been identified by \c isSNDH()
+ * @param info The fileInfo_t to fill out
+ * @return \c true if the file's information could be read, otherwise \c false
+ */
+bool sndh_t::readInfo(inputSource_t &&source, fileInfo_t &info) noexcept try
+{
+	const inputSource_t file{std::move(source)};
+	if (!file.valid())
+		return false;
+	sndhLoader_t loader{file};
+	info.bitRate(atariSTe_t::sampleRate);
+	loadFileInfo(info, loader.metadata());
+	return true;
+}
+catch (const std::exception &)
+{
+	console.error("Failed to load SNDH file"sv);
+	return false;
+}
+
 void sndh_t::ensurePlayable() noexcept
 {
 	if (!_player)
@@ -125,21 +157,13 @@ int64_t sndh_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 		return -2;
 	// Calculate how many samples should be filled in this buffer
 	const size_t samples = std::min(ctx.totalPlaybackSamples - ctx.generatedSamples, length / 2U);
-	// Fill the sample buffer as much as we can
-	for (size_t offset = 0U; offset < samples; ++offset)
+	// Fill the sample buffer as much as we can, running the emulator for the whole block in one go
+	if (!ctx.emulator.render({buffer, samples}))
 	{
-		// Advance the emulator state till we get a new sample out
-		while (!ctx.emulator.sampleReady())
-		{
-			if (!ctx.emulator.advanceClock())
-			{
-				// If something went wrong while emulating the machine, display the
-				// crash state to allow debugging
-				ctx.emulator.displayCPUState();
-				return -1;
-			}
-		}
-		buffer[offset] = ctx.emulator.readSample();
+		// If something went wrong while emulating the machine, display the
+		// crash state to allow debugging
+		ctx.emulator.displayCPUState();
+		return -1;
 	}
 	// Update the total number of samples generated so far with how many more we made this call
 	ctx.generatedSamples += static_cast<uint32_t>(samples);
@@ -153,19 +177,16 @@ int64_t sndh_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 bool isSNDH(const char *fileName) { return sndh_t::isSNDH(fileName); }
 
 bool sndh_t::isSNDH(const int32_t fd) noexcept
+	{ return isSNDH(audioProbe_t{fd}); }
+
+bool sndh_t::isSNDH(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> icePackMagic;
-	std::array<char, 4> sndhMagic;
+	// All packed SNDH files begin with "ICE!" and this is the test
+	// that the Linux/Unix Magic Numbers system does too, so
+	// it will always work. All unpacked SNDH files start with 'SDNH' at offset 12.
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, icePackMagic.data(), icePackMagic.size())) == icePackMagic.size() &&
-		lseek(fd, 8, SEEK_CUR) == 12 &&
-		static_cast<size_t>(read(fd, sndhMagic.data(), sndhMagic.size())) == sndhMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		// All packed SNDH files begin with "ICE!" and this is the test
-		// that the Linux/Unix Magic Numbers system does too, so
-		// it will always work. All unpacked SNDH files start with 'SDNH' at offset 12.
-		(icePackMagic == libAudio::sndh::icePackMagic || sndhMagic == libAudio::sndh::sndhMagic);
+		probe.matches(0, libAudio::sndh::icePackMagic) ||
+		probe.matches(12, libAudio::sndh::sndhMagic);
 }
 
 bool sndh_t::isSNDH(const char *const fileName) noexcept
@@ -3,6 +3,7 @@
 #include "libAudio.h"
 #include "genericModule/genericModule.h"
 #include "console.hxx"
+#include "probe.hxx"
 
 using substrate::make_unique_nothrow;
 
@@ -11,12 +12,20 @@ namespace libAudio::stm
 	constexpr static std::array<char, 9> magic{{'!', 'S', 'c', 'r', 'e', 'a', 'm', '!', '\x1A'}};
 }
 
-modSTM_t::modSTM_t(fd_t &&fd) noexcept : moduleFile_t{audioType_t::moduleSTM, std::move(fd)} { }
+modSTM_t::modSTM_t(inputSource_t &&source) noexcept : moduleFile_t{audioType_t::moduleSTM, std::move(source)} { }
 
 modSTM_t *modSTM_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<modSTM_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isSTM(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isSTM(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+modSTM_t *modSTM_t::openR(inputSource_t &&source, const bool infoOnly) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<modSTM_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
@@ -24,7 +33,7 @@ modSTM_t *modSTM_t::openR(const char *const fileName) noexcept
 	info.bitRate(44100U);
 	info.bitsPerSample(16U);
 	info.channels(2U);
-	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file); }
+	try { ctx.mod = make_unique_nothrow<ModuleFile>(*file, !infoOnly); }
 	catch (const ModuleLoaderError &e)
 	{
 		console.error(e.error());
@@ -39,15 +48,12 @@ void *stmOpenR(const char *fileName) { return modSTM_t::openR(fileName); }
 bool isSTM(const char *fileName) { return modSTM_t::isSTM(fileName); }
 
 bool modSTM_t::isSTM(const int32_t fd) noexcept
+	{ return isSTM(audioProbe_t{fd}); }
+
+bool modSTM_t::isSTM(const audioProbe_t &probe) noexcept
 {
-	constexpr uint32_t offset = 20;
-	std::array<char, 9> stmMagic;
-	return
-		fd != -1 &&
-		lseek(fd, offset, SEEK_SET) == offset &&
-		static_cast<size_t>(read(fd, stmMagic.data(), stmMagic.size())) == stmMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		stmMagic == libAudio::stm::magic;
+	constexpr size_t offset = 20;
+	return probe.matches(offset, libAudio::stm::magic);
 }
 
 bool modSTM_t::isSTM(const char *const fileName) noexcept
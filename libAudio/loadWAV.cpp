@@ -5,6 +5,8 @@
 #include <substrate/utility>
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
+#include "sampleConversion.hxx"
 
 /*!
  * @internal
@@ -15,6 +17,7 @@
  */
 
 using substrate::make_unique_nothrow;
+using namespace libAudio::sampleConversion;
 
 /*!
  * @internal
@@ -22,13 +25,16 @@ using substrate::make_unique_nothrow;
  */
 struct wav_t::decoderContext_t final
 {
-	std::array<uint8_t, 8192> inputBuffer;
-	size_t bytesAvailable, bytesUsed;
 	/*!
 	 * @internal
 	 * The internal decoded data buffer
 	 */
 	uint8_t playbackBuffer[8192];
+	/*!
+	 * @internal
+	 * The byte possition where the first byte of the data chunk is in the file
+	 */
+	off_t offsetData;
 	/*!
 	 * @internal
 	 * The byte possition where the final byte of the data chunk should be in the file
@@ -48,18 +54,15 @@ struct wav_t::decoderContext_t final
 
 	decoderContext_t() noexcept;
 	~decoderContext_t() noexcept;
-	template<size_t N> bool copyDataTo(std::array<uint8_t, N> &buffer, const fd_t &file,
-		const size_t sampleByteCount) noexcept;
-
-private:
-	bool maybeReadData(const fd_t &file, const size_t sampleByteCount) noexcept;
+	size_t blockAlign(const fileInfo_t &info) const noexcept
+		{ return size_t{info.channels()} * (bitsPerSample / 8U); }
+	bool isNative(sampleFormat_t format) const noexcept;
 };
 
-wav_t::wav_t(fd_t &&fd) noexcept : audioFile_t(audioType_t::wave, std::move(fd)),
+wav_t::wav_t(inputSource_t &&source) noexcept : audioFile_t(audioType_t::wave, std::move(source)),
 	decoderCtx(make_unique_nothrow<decoderContext_t>()) { }
-wav_t::decoderContext_t::decoderContext_t() noexcept : inputBuffer{}, bytesAvailable{0},
-	bytesUsed{0}, playbackBuffer{}, offsetDataLength{0}, compression{0}, bitsPerSample{0},
-	floatData{false} { }
+wav_t::decoderContext_t::decoderContext_t() noexcept : playbackBuffer{}, offsetData{0}, offsetDataLength{0},
+	compression{0}, bitsPerSample{0}, floatData{false} { }
 
 namespace libAudio::wave
 {
@@ -73,7 +76,7 @@ namespace libAudio::wave
 bool wav_t::skipToChunk(const std::array<char, 4> &chunkName) const noexcept
 {
 	std::array<char, 4> chunkTag;
-	const fd_t &file = fd();
+	const inputSource_t &file = source();
 	if (!file.read(chunkTag))
 		return false;
 
@@ -105,7 +108,7 @@ bool wav_t::readFormat() noexcept
 {
 	auto &ctx = *context();
 	fileInfo_t &info = fileInfo();
-	const fd_t &file = fd();
+	const inputSource_t &file = source();
 	std::array<char, 6> unused;
 	uint16_t channels;
 	uint32_t bitRate;
@@ -136,12 +139,26 @@ bool wav_t::readFormat() noexcept
  */
 wav_t *wav_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<wav_t>(fd_t{fileName, O_RDONLY | O_NOCTTY})};
-	if (!file || !file->valid() || !isWAV(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isWAV(fd))
+		return nullptr;
+	return openR(std::move(fd));
+}
+
+/*!
+ * Constructs a wav_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isWAV()
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+wav_t *wav_t::openR(inputSource_t &&source) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<wav_t>>(std::move(source))};
+	if (!file || !file->valid())
 		return nullptr;
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
-	const fd_t &fd = file->fd();
+	const inputSource_t &fd = file->source();
 	const off_t fileSize = fd.length();
 	uint32_t chunkLength = 0;
 
@@ -161,14 +178,8 @@ wav_t *wav_t::openR(const char *const fileName) noexcept
 		return nullptr;
 
 	// Currently we do not care if the file has extra data, we're only looking to work with PCM.
-	for (uint32_t i = 16; i < chunkLength; ++i)
-	{
-		char value = 0;
-		if (!fd.read(value))
-			return nullptr;
-	}
-
-	if (!file->skipToChunk(libAudio::wave::dataChunk) ||
+	if (!fd.seekRel(chunkLength - 16U) ||
+		!file->skipToChunk(libAudio::wave::dataChunk) ||
 		!fd.readLE(chunkLength) ||
 		(offset = fd.tell()) == -1 ||
 		chunkLength > (fileSize - offset) ||
@@ -184,7 +195,8 @@ wav_t *wav_t::openR(const char *const fileName) noexcept
 			return totalTime / info.bitRate();
 		}()
 	);
-	ctx.offsetDataLength = chunkLength + fd.tell();
+	ctx.offsetData = offset;
+	ctx.offsetDataLength = chunkLength + offset;
 
 	return file.release();
 }
@@ -208,16 +220,32 @@ void wav_t::ensurePlayable() noexcept
 void *wavOpenR(const char *fileName) { return wav_t::openR(fileName); }
 
 wav_t::decoderContext_t::~decoderContext_t() noexcept { }
-int8_t dataToSample(const std::array<uint8_t, 1> &data) noexcept
-	{ return int8_t(data[0] ^ 0x80U); }
-int16_t dataToSample(const std::array<uint8_t, 2> &data) noexcept
-	{ return int16_t((uint16_t(data[1]) << 8U) | data[0]); }
-int16_t dataToSample(const std::array<uint8_t, 3> &data) noexcept
-	{ return int16_t((uint16_t(data[2]) << 8U) | data[1]); }
-int16_t dataToSample(const std::array<uint8_t, 4> &data) noexcept
-	{ return int16_t((uint16_t(data[3]) << 8U) | data[2]); }
-
-float dataToFloat(const std::array<uint8_t, 4> &data) noexcept
+
+#if defined(__BYTE_ORDER__) && __BYTE_ORDER__ == __ORDER_BIG_ENDIAN__
+constexpr static bool hostIsLittleEndian{false};
+#else
+constexpr static bool hostIsLittleEndian{true};
+#endif
+
+/*!
+ * @internal
+ * Converts the \p N byte little endian sample at \p data to a sample left justified in 32 bits.
+ * 8-bit WAV data is unsigned so is re-biased as part of this.
+ */
+template<size_t N> inline int32_t dataToInt32(const uint8_t *const data) noexcept
+{
+	if constexpr (N == 1U)
+		return int32_t(uint32_t(data[0] ^ 0x80U) << 24U);
+	else
+	{
+		uint32_t value{0};
+		for (size_t i = 0; i < N; ++i)
+			value |= uint32_t(data[i]) << (8U * (i + 4U - N));
+		return int32_t(value);
+	}
+}
+
+inline float dataToFloat(const uint8_t *const data) noexcept
 {
 	const uint32_t value = (uint32_t(data[3]) << 24) |
 		(uint32_t(data[2]) << 16) | (uint32_t(data[1]) << 8) | data[0];
@@ -227,72 +255,79 @@ float dataToFloat(const std::array<uint8_t, 4> &data) noexcept
 	return result;
 }
 
-bool wav_t::decoderContext_t::maybeReadData(const fd_t &file, const size_t sampleByteCount) noexcept
+/*!
+ * @internal
+ * Block converter from the raw WAV data to the output format. This is kept as a simple
+ * counted loop over whole samples so the compiler is able to vectorise it.
+ */
+template<size_t N, bool floatData, sampleFormat_t format> void convertSamples(const uint8_t *const data,
+	sample_t<format> *const samples, const size_t count) noexcept
 {
-	if (bytesUsed == bytesAvailable)
+	for (size_t i = 0; i < count; ++i)
 	{
-		const auto amount = std::min(sampleByteCount, inputBuffer.size());
-		const auto result = file.read(inputBuffer.data(), amount, nullptr);
-		if (result <= 0)
-			return false;
+		if constexpr (floatData)
+			samples[i] = fromFloat<format>(dataToFloat(data + (i * N)));
 		else
-			bytesAvailable = size_t(result);
-		bytesUsed = 0;
+			samples[i] = fromInt32<format>(dataToInt32<N>(data + (i * N)));
 	}
-	return true;
 }
 
-template<size_t N> bool wav_t::decoderContext_t::copyDataTo(std::array<uint8_t, N> &buffer,
-	const fd_t &file, const size_t sampleByteCount) noexcept
-{
-	if (!maybeReadData(file, sampleByteCount))
-		return false;
-	const size_t amount = std::min(bytesAvailable - bytesUsed, buffer.size());
-	memcpy(buffer.data(), inputBuffer.data() + bytesUsed, amount);
-	bytesUsed += amount;
-	if (amount == buffer.size())
-		return true; // If we're done, exit early to avoid the expense of the second half of this function
-	else if (!maybeReadData(file, sampleByteCount))
-		return false;
-	memcpy(buffer.data() + amount, inputBuffer.data() + bytesUsed, buffer.size() - amount);
-	bytesUsed += buffer.size() - amount;
-	return true;
-}
-
-template<typename T, uint8_t N> uint32_t readIntSamples(wav_t &wavFile, void *buffer,
-	const uint32_t length, const size_t sampleByteCount)
+/*!
+ * @internal
+ * Fills \p buffer with up to \p samples samples decoded from the file, converting them with
+ * \p convert straight out of the input source's data as many samples at a time as it can provide
+ * @return The number of bytes written into \p buffer
+ */
+template<typename T, size_t N, void convert(const uint8_t *, T *, size_t) noexcept>
+	int64_t readSamples(const wav_t &wavFile, void *const buffer, const size_t samples)
 {
-	auto &ctx = *wavFile.context();
+	const inputSource_t &file = wavFile.source();
 	const auto playbackBuffer = static_cast<T *>(buffer);
-	uint32_t offset = 0;
-	for (uint32_t index = 0; offset < length && offset < sampleByteCount; ++index)
+	size_t offset = 0;
+	while (offset < samples)
 	{
-		std::array<uint8_t, N> data{};
-		if (!ctx.copyDataTo(data, wavFile.fd(), sampleByteCount - offset))
+		const auto data{file.view((samples - offset) * N)};
+		const auto count = data.size() / N;
+		if (!count)
 			break;
-		playbackBuffer[index] = dataToSample(data);
-		offset += sizeof(T);
+		convert(data.data(), playbackBuffer + offset, count);
+		if (!file.seekRel(off_t(count * N)))
+			return -1;
+		offset += count;
 	}
-	return offset;
+	return int64_t(offset * sizeof(T));
 }
 
-template<typename T, uint8_t N> uint32_t readFloatSamples(wav_t &wavFile, void *buffer,
-	const uint32_t length, const size_t sampleByteCount)
+/*!
+ * @internal
+ * Reads sample data that is already in the output format straight into \p buffer
+ * @return The number of bytes written into \p buffer
+ */
+template<typename T> int64_t readNativeSamples(const wav_t &wavFile, void *const buffer, const size_t samples)
 {
-	using limits = std::numeric_limits<T>;
-	auto &ctx = *wavFile.context();
-	const auto playbackBuffer = static_cast<T *>(buffer);
-	uint32_t offset = 0;
-	for (uint32_t index = 0; offset < length && offset < sampleByteCount; ++index)
-	{
-		std::array<uint8_t, N> data{};
-		if (!ctx.copyDataTo(data, wavFile.fd(), sampleByteCount - offset))
-			break;
-		const float sample = dataToFloat(data);
-		playbackBuffer[index] = T(sample * limits::max());
-		offset += sizeof(T);
-	}
-	return offset;
+	const inputSource_t &file = wavFile.source();
+	const auto result = file.read(buffer, samples * sizeof(T), nullptr);
+	if (result <= 0)
+		return 0;
+	// If we got a partial sample at the end of the read, give it back so the next call picks it up
+	const auto partial{off_t(size_t(result) % sizeof(T))};
+	if (partial && file.seek(-partial, SEEK_CUR) == -1)
+		return -1;
+	return int64_t(result) - partial;
+}
+
+/*!
+ * @internal
+ * Checks whether the WAV's data is already in the output format given, needing no conversion
+ */
+bool wav_t::decoderContext_t::isNative(const sampleFormat_t format) const noexcept
+{
+	if (!hostIsLittleEndian)
+		return false;
+	if (floatData)
+		return format == sampleFormat_t::float32;
+	return (bitsPerSample == 16U && format == sampleFormat_t::int16) ||
+		(bitsPerSample == 32U && format == sampleFormat_t::int32);
 }
 
 /*!
@@ -306,44 +341,87 @@ template<typename T, uint8_t N> uint32_t readFloatSamples(wav_t &wavFile, void *
  */
 int64_t wav_t::fillBuffer(void *const buffer, const uint32_t length)
 {
-	uint32_t offset = 0;
-	const fd_t &file = fd();
+	const inputSource_t &file = source();
 	auto &ctx = *context();
 
 	const off_t fileOffset = file.tell();
-	if (file.isEOF() || fileOffset == -1 || fileOffset >= ctx.offsetDataLength)
+	if (fileOffset == -1 || fileOffset > ctx.offsetDataLength)
 		return -2;
-	const size_t sampleByteCount = size_t(ctx.offsetDataLength - fileOffset);
-	// 8-bit char reader
-	if (!ctx.floatData && ctx.bitsPerSample == 8)
-		return readIntSamples<int8_t, 1>(*this, buffer, length, sampleByteCount);
-	// 16-bit short reader
-	else if (!ctx.floatData && ctx.bitsPerSample == 16)
-		return readIntSamples<int16_t, 2>(*this, buffer, length, sampleByteCount);
-	// 24-bit int reader
-	else if (!ctx.floatData && ctx.bitsPerSample == 24)
-		return readIntSamples<int16_t, 3>(*this, buffer, length, sampleByteCount);
-	// 32-bit int reader
-	else if (!ctx.floatData && ctx.bitsPerSample == 32)
-		return readIntSamples<int16_t, 4>(*this, buffer, length, sampleByteCount);
-	/*// 24-bit float reader
-	else if (ctx.floatData && info.bitsPerSample == 24)
+	// Work out how much sample data is left
+	const size_t bytesRemaining = size_t(ctx.offsetDataLength - fileOffset);
+	const size_t sampleBytes = ctx.bitsPerSample / 8U;
+	if (bytesRemaining < sampleBytes)
+		return -2;
+	const size_t samples = bytesRemaining / sampleBytes;
+
+	return withSampleFormat(fileInfo().sampleFormat(), [&](const auto format) -> int64_t
 	{
-		for (int i = 0; i < nOutBufferLen && ftell(f_WAV) < p_WF->DataEnd; i += 2)
-		{
-			float in;
-			fread(&in, 3, 1, f_WAV);
-			*((short *)(OutBuffer + ret)) = (short)(in * 65535.0F);
-			ret += 2;
-		}
-	}*/
-	// 32-bit float reader
-	else if (ctx.floatData && ctx.bitsPerSample == 32)
-		return readFloatSamples<int16_t, 4>(*this, buffer, length, sampleByteCount);
-	else
+		constexpr auto outputFormat{decltype(format)::value};
+		using outputSample_t = sample_t<outputFormat>;
+		const auto count = std::min<size_t>(length / sizeof(outputSample_t), samples);
+		// If the data needs no conversion, read it directly into the output buffer
+		if (ctx.isNative(outputFormat))
+			return readNativeSamples<outputSample_t>(*this, buffer, count);
+		// 8-bit char reader
+		if (!ctx.floatData && ctx.bitsPerSample == 8)
+			return readSamples<outputSample_t, 1, convertSamples<1, false, outputFormat>>(*this, buffer,
+				count);
+		// 16-bit short reader
+		else if (!ctx.floatData && ctx.bitsPerSample == 16)
+			return readSamples<outputSample_t, 2, convertSamples<2, false, outputFormat>>(*this, buffer,
+				count);
+		// 24-bit int reader
+		else if (!ctx.floatData && ctx.bitsPerSample == 24)
+			return readSamples<outputSample_t, 3, convertSamples<3, false, outputFormat>>(*this, buffer,
+				count);
+		// 32-bit int reader
+		else if (!ctx.floatData && ctx.bitsPerSample == 32)
+			return readSamples<outputSample_t, 4, convertSamples<4, false, outputFormat>>(*this, buffer,
+				count);
+		// 32-bit float reader
+		else if (ctx.floatData && ctx.bitsPerSample == 32)
+			return readSamples<outputSample_t, 4, convertSamples<4, true, outputFormat>>(*this, buffer,
+				count);
 		return -1;
+	});
+}
+
+/*!
+ * @internal
+ * WAV data can be converted to any of the output formats directly,
+ * though 8-bit output is only offered for 8-bit data
+ */
+bool wav_t::canOutput(const sampleFormat_t format) const noexcept
+	{ return format != sampleFormat_t::int8 || context()->bitsPerSample == 8U; }
 
-	return offset;
+/*!
+ * Seeks the decoder to the sample frame given so that the next call to \c fillBuffer()
+ * starts returning audio from exactly that sample
+ * @param sampleFrame The sample frame to seek to
+ * @return \c true if the seek succeeded, otherwise \c false
+ */
+bool wav_t::seek(const uint64_t sampleFrame)
+{
+	flushPlayback();
+	auto &ctx = *context();
+	const inputSource_t &file = source();
+	const auto dataLength{uint64_t(ctx.offsetDataLength - ctx.offsetData)};
+	const uint64_t byteOffset{sampleFrame * ctx.blockAlign(fileInfo())};
+	if (byteOffset > dataLength)
+		return false;
+	const auto offset{off_t(ctx.offsetData + off_t(byteOffset))};
+	return file.seek(offset, SEEK_SET) == offset;
+}
+
+uint64_t wav_t::tell() const noexcept
+{
+	const auto &ctx = *context();
+	const off_t fileOffset = source().tell();
+	const auto blockAlign{ctx.blockAlign(fileInfo())};
+	if (fileOffset == -1 || !blockAlign)
+		return 0;
+	const auto offset{fileOffset - ctx.offsetData};
+	return offset < 0 ? 0U : uint64_t(offset) / blockAlign;
 }
 
 /*!
@@ -367,17 +445,20 @@ bool isWAV(const char *fileName) { return wav_t::isWAV(fileName); }
  * the file contents to see if it is a WAV file or not
  */
 bool wav_t::isWAV(const int32_t fd) noexcept
+	{ return isWAV(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a WAV
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool wav_t::isWAV(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> riffMagic{};
-	std::array<char, 4> waveMagic{};
 	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, riffMagic.data(), riffMagic.size())) == riffMagic.size() &&
-		lseek(fd, 4, SEEK_CUR) == 8 &&
-		static_cast<size_t>(read(fd, waveMagic.data(), waveMagic.size())) == waveMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		riffMagic == libAudio::wave::riffMagic &&
-		waveMagic == libAudio::wave::waveMagic;
+		probe.matches(0, libAudio::wave::riffMagic) &&
+		probe.matches(8, libAudio::wave::waveMagic);
 }
 
 /*!
@@ -6,6 +6,7 @@
 
 #include "libAudio.h"
 #include "libAudio.hxx"
+#include "probe.hxx"
 
 #ifdef USE_MESON_WAVPACK
 #include <wavpack.h>
@@ -58,19 +59,19 @@ struct wavPack_t::decoderContext_t final
 	 * @internal
 	 * The WavPack Corrections file to decode
 	 */
-	fd_t wvcFileFD;
+	inputSource_t wvcSource;
 	/*!
 	 * @internal
 	 * The WavPack callbacks/reader information handle
 	 */
 	WavpackStreamReader64 callbacks;
 
-	decoderContext_t(std::string fileName) noexcept;
+	decoderContext_t(const char *fileName) noexcept;
 	~decoderContext_t() noexcept;
 	std::unique_ptr<char []> readTag(const char *const tag) noexcept;
 	void nextFrame(const uint8_t channels) noexcept;
-	libAUDIO_NO_DISCARD(void *wvcFile() noexcept) { return wvcFileFD.valid() ? &wvcFileFD : nullptr; }
-	static fd_t wvcFile(std::string &fileName) noexcept;
+	libAUDIO_NO_DISCARD(void *wvcFile() noexcept) { return wvcSource.valid() ? &wvcSource : nullptr; }
+	static inputSource_t wvcFile(const char *fileName) noexcept;
 };
 
 namespace libAudio::wavPack
@@ -79,14 +80,14 @@ namespace libAudio::wavPack
 	 * @internal
 	 * \c read() is the internal read callback for WavPack file decoding.
 	 * This prevents nasty things from happening on Windows thanks to the run-time mess there.
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @param buffer The buffer to read into
 	 * @param length The number of bytes to read into the buffer
 	 * @return The return result of \c read()
 	 */
 	int32_t read(void *filePtr, void *buffer, int32_t length)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return int32_t(file.read(buffer, length, nullptr));
 	}
 
@@ -94,12 +95,12 @@ namespace libAudio::wavPack
 	 * @internal
 	 * \c tell() is the internal read possition callback for WavPack file decoding.
 	 * This prevents nasty things from happening on Windows thanks to the run-time mess there.
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @return An integer giving the read possition of the file in bytes
 	 */
 	int64_t tell(void *filePtr)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return file.tell();
 	}
 
@@ -107,13 +108,13 @@ namespace libAudio::wavPack
 	 * @internal
 	 * \c seekAbs() is the internal absolute seek callback for WavPack file decoding.
 	 * This prevents nasty things from happening on Windows thanks to the run-time mess there.
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @param offset The offset through the file to which to seek to
 	 * @return A truth value giving if the seek succeeded or not
 	 */
 	int seekAbs(void *filePtr, int64_t offset)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return file.seek(offset, SEEK_SET) != offset;
 	}
 
@@ -121,20 +122,20 @@ namespace libAudio::wavPack
 	 * @internal
 	 * \c seekRel() is the internal any-place (relative) seek callback for WavPack file decoding.
 	 * This prevents nasty things from happening on Windows thanks to the run-time mess there.
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @param offset The offset through the file to which to seek to
 	 * @param mode The mode (location in the file) identifier to base the seek on
 	 * @return A truth value giving if the seek succeeded or not
 	 */
 	int seekRel(void *filePtr, int64_t offset, int mode)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return file.seek(offset, mode) == -1;
 	}
 
 	int ungetc(void *filePtr, int)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return int(file.seek(-1, SEEK_CUR));
 	}
 
@@ -142,12 +143,12 @@ namespace libAudio::wavPack
 	 * @internal
 	 * \c len() is the internal file length callback for WavPack file decoding.
 	 * This prevents nasty things from happening on Windows thanks to the run-time mess there.
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @return An integer giving the length of the file in bytes
 	 */
 	int64_t length(void *filePtr)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return file.length();
 	}
 
@@ -156,14 +157,14 @@ namespace libAudio::wavPack
 	 * \c canSeek() is the internal callback for determining if a WavPack file being
 	 * decoded can be seeked on or not. \n This does two things: \n
 	 * - It prevents nasty things from happening on Windows thanks to the run-time mess there
-	 * - It uses \c lseek() as a no-operation to determine if we can seek or not.
+	 * - It uses \c tell() to determine if we can seek or not.
 	 *
-	 * @param filePtr \c FILE handle for the WavPack file as a void pointer
+	 * @param filePtr The \c inputSource_t for the WavPack file as a void pointer
 	 * @return A truth value giving if seeking can work or not
 	 */
 	int canSeek(void *filePtr)
 	{
-		const fd_t &file = *static_cast<fd_t *>(filePtr);
+		const inputSource_t &file = *static_cast<inputSource_t *>(filePtr);
 		return file.tell() != -1;
 	}
 
@@ -172,17 +173,25 @@ namespace libAudio::wavPack
 
 using namespace libAudio;
 
-wavPack_t::wavPack_t(fd_t &&fd, const char *const fileName) noexcept : audioFile_t{audioType_t::wavPack, std::move(fd)},
+wavPack_t::wavPack_t(inputSource_t &&source, const char *const fileName) noexcept :
+	audioFile_t{audioType_t::wavPack, std::move(source)},
 	decoderCtx{make_unique_nothrow<decoderContext_t>(fileName)} { }
-wavPack_t::decoderContext_t::decoderContext_t(std::string fileName) noexcept : decoder{nullptr}, playbackBuffer{},
-	decodeBuffer{}, sampleCount{0}, samplesUsed{0}, eof{false}, wvcFileFD{wvcFile(fileName)}, callbacks{wavPack::read,
+wavPack_t::decoderContext_t::decoderContext_t(const char *const fileName) noexcept : decoder{nullptr}, playbackBuffer{},
+	decodeBuffer{}, sampleCount{0}, samplesUsed{0}, eof{false}, wvcSource{wvcFile(fileName)}, callbacks{wavPack::read,
 		nullptr, wavPack::tell, wavPack::seekAbs, wavPack::seekRel, wavPack::ungetc, wavPack::length, wavPack::canSeek,
 		nullptr, nullptr} { }
 
-fd_t wavPack_t::decoderContext_t::wvcFile(std::string &fileName) noexcept
+/*!
+ * @internal
+ * Opens the WavPack Corrections file that goes with the file given by \p fileName, if there is one.
+ * Data not read from a named file has no corrections to go with it.
+ */
+inputSource_t wavPack_t::decoderContext_t::wvcFile(const char *const fileName) noexcept
 {
-	fileName += 'c';
-	return {fileName.data(), O_RDONLY | O_NOCTTY};
+	if (!fileName)
+		return {};
+	const auto wvcName{std::string{fileName} + 'c'};
+	return fd_t{wvcName.data(), O_RDONLY | O_NOCTTY};
 }
 
 std::unique_ptr<char []> wavPack_t::decoderContext_t::readTag(const char *const tag) noexcept
@@ -207,14 +216,29 @@ std::unique_ptr<char []> wavPack_t::decoderContext_t::readTag(const char *const
  */
 wavPack_t *wavPack_t::openR(const char *const fileName) noexcept
 {
-	auto file{make_unique_nothrow<wavPack_t>(fd_t{fileName, O_RDONLY | O_NOCTTY}, fileName)};
-	if (!file || !file->valid() || !isWavPack(file->_fd))
+	fd_t fd{fileName, O_RDONLY | O_NOCTTY};
+	if (!fd.valid() || !isWavPack(fd))
+		return nullptr;
+	return openR(std::move(fd), fileName);
+}
+
+/*!
+ * Constructs a wavPack_t using the already opened file given by \c source for reading and playback
+ * and returns a pointer to the context of the opened file
+ * @param source The file to read from, which must already have been identified by \c isWavPack()
+ * @param fileName The name of the file, used to find its corrections file, or \c nullptr if it has none
+ * @return A pointer to the context of the opened file, or \c nullptr if there was an error
+ */
+wavPack_t *wavPack_t::openR(inputSource_t &&source, const char *const fileName) noexcept
+{
+	auto file{make_unique_nothrow<playableFile_t<wavPack_t>>(std::move(source), fileName)};
+	if (!file || !file->valid())
 		return nullptr;
-	fd_t &fileDesc = const_cast<fd_t &>(file->fd());
+	auto &fileSource = const_cast<inputSource_t &>(file->source());
 	auto &ctx = *file->context();
 	fileInfo_t &info = file->fileInfo();
 
-	ctx.decoder = WavpackOpenFileInputEx64(&ctx.callbacks, &fileDesc,
+	ctx.decoder = WavpackOpenFileInputEx64(&ctx.callbacks, &fileSource,
 		ctx.wvcFile(), nullptr, OPEN_NORMALIZE | OPEN_TAGS, 15);
 
 	info.channels(static_cast<uint8_t>(WavpackGetNumChannels(ctx.decoder)));
@@ -314,13 +338,18 @@ bool isWavPack(const char *fileName) { return wavPack_t::isWavPack(fileName); }
  * the file contents to see if it is a WavPack file or not
  */
 bool wavPack_t::isWavPack(const int32_t fd) noexcept
+	{ return isWavPack(audioProbe_t{fd}); }
+
+/*!
+ * Checks the prefix of the file held by \p probe for whether it represents a WavPack
+ * file recognised by this library or not
+ * @param probe The probe holding the prefix of the file to check
+ * @return \c true if the file can be utilised by the library,
+ * otherwise \c false
+ */
+bool wavPack_t::isWavPack(const audioProbe_t &probe) noexcept
 {
-	std::array<char, 4> wavPackMagic{};
-	return
-		fd != -1 &&
-		static_cast<size_t>(read(fd, wavPackMagic.data(), wavPackMagic.size())) == wavPackMagic.size() &&
-		lseek(fd, 0, SEEK_SET) == 0 &&
-		wavPackMagic == libAudio::wavPack::magic;
+	return probe.matches(0, libAudio::wavPack::magic);
 }
 
 /*!
@@ -46,6 +46,15 @@ struct m4a_t::decoderContext_t final
 	 */
 	uint32_t frameCount, currentFrame;
 	uint64_t sampleCount, samplesUsed;
+	/*!
+	 * @internal
+	 * @var uint64_t samplePosition
+	 * The sample frame that the next byte of output corresponds to
+	 * @var uint64_t bytesToSkip
+	 * The number of bytes of decoded audio to discard after a seek
+	 * to reach the requested sample frame within an AAC frame
+	 */
+	uint64_t samplePosition, bytesToSkip;
 	/*!
 	 * @internal
 	 * Pointer to the static return result of the call to \c NeAACDecDecode()
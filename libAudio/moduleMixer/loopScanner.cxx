@@ -1,11 +1,14 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2010-2023 Rachel Mant <git@dragonmux.network>
+#include <new>
 #include <optional>
+#include <vector>
 #include <substrate/span>
 #include <substrate/indexed_iterator>
 #include <substrate/index_sequence>
 #include "../libAudio.hxx"
 #include "../genericModule/genericModule.h"
+#include "scanCache.hxx"
 
 /* If the row in the pattern has been visited */
 #define ROW_VISITED 0x01U
@@ -61,6 +64,10 @@ struct scanState_t final
 	uint16_t nextRow{};
 	uint16_t currentRow{};
 	uint16_t rowsInPattern{};
+	/* The navigation effects disabled so far, so they can be recorded in the scan cache */
+	std::vector<disabledEffect_t> disabledEffects{};
+	/* Cleared if recording a disabled effect failed, so the incomplete record must not be cached */
+	bool cacheable{true};
 
 	scanState_t(uint8_t modType, size_t patternCount, size_t channelCount, substrate::span<pattern_t *>patternList,
 		substrate::span<uint8_t> orderList, uint32_t musicSpeed, uint32_t musicTempo, uint32_t mixSampleRate);
@@ -71,22 +78,98 @@ struct scanState_t final
 	void handleNavigationEffects(std::optional<uint16_t> patternLoopRow, std::optional<uint16_t> breakRow,
 		std::optional<uint8_t> positionJump) noexcept;
 	void disableJumpEffect() noexcept;
+	void recordDisabledEffect(uint16_t channel) noexcept;
 
 	template<uint32_t type> [[nodiscard]] bool typeIs() const noexcept { return moduleType == type; }
 	template<uint32_t type, uint32_t... types> [[nodiscard]] typename std::enable_if<sizeof...(types) != 0, bool>::type
 		typeIs() const noexcept { return typeIs<type>() || typeIs<types...>(); }
 };
 
+/*
+ * The version of the loop scanner's results, which is part of every scan cache key.
+ * Bump this whenever a change to the scanner would change the results it produces,
+ * so results cached by older versions are no longer found.
+ */
+constexpr static uint32_t scanVersion{1U};
+
+/* Hashes everything the loop scan depends on, to key the scan cache */
+static uint64_t scanKey(const uint8_t moduleType, const uint32_t channelCount,
+	const substrate::span<pattern_t *> patternList, const substrate::span<uint8_t> orderList,
+	const uint32_t musicSpeed, const uint32_t musicTempo, const uint32_t sampleRate) noexcept
+{
+	scanHash_t hash{};
+	hash.update(scanVersion);
+	hash.update(moduleType);
+	hash.update(sampleRate);
+	hash.update(musicSpeed);
+	hash.update(musicTempo);
+	hash.update(channelCount);
+	hash.update(uint32_t(orderList.size()));
+	for (const auto order : orderList)
+		hash.update(order);
+	hash.update(uint32_t(patternList.size()));
+	for (const auto *const pattern : patternList)
+	{
+		/* Sentinel patterns end the song, so they have to be part of the key too */
+		if (!pattern)
+		{
+			hash.update(uint32_t{0xffffffffU});
+			continue;
+		}
+		hash.update(pattern->rows());
+		for (const auto channel : substrate::indexSequence_t{channelCount})
+		{
+			for (const auto row : substrate::indexSequence_t{pattern->rows()})
+			{
+				const auto [effect, param]{pattern->commands()[channel][row].effect()};
+				hash.update(effect);
+				hash.update(param);
+			}
+		}
+	}
+	return hash.value();
+}
+
+/* Re-applies a cached scan's disabled effects, ignoring any that don't fit this module */
+static void disableEffects(const substrate::span<pattern_t *> patternList, const uint32_t channelCount,
+	const std::vector<disabledEffect_t> &disabledEffects) noexcept
+{
+	for (const auto &[patternIndex, row, channel] : disabledEffects)
+	{
+		if (patternIndex >= patternList.size() || !patternList[patternIndex] || channel >= channelCount)
+			continue;
+		const auto &pattern{*patternList[patternIndex]};
+		if (row < pattern.rows())
+			pattern.commands()[channel][row].disableEffect();
+	}
+}
+
 void ModuleFile::loopScanPatterns(fileInfo_t &info)
 {
-	/* State tracker for the scan */
-	scanState_t state{ModuleType, p_Header->nPatterns, p_Header->nChannels, {p_Patterns, p_Header->nPatterns},
-		{p_Header->Orders.get(), p_Header->nOrders}, MusicSpeed, MusicTempo, info.bitRate()};
-	/* Ask the scanner to do its job across the patterns in the order specified by the tune */
-	state.scan();
+	const substrate::span<pattern_t *> patterns{p_Patterns, p_Header->nPatterns};
+	const substrate::span<uint8_t> orders{p_Header->Orders.get(), p_Header->nOrders};
+	/* If the scan cache is in use, see if this module has been scanned before */
+	auto &cache{scanCache()};
+	std::optional<uint64_t> key{};
+	if (cache.enabled())
+		key = scanKey(ModuleType, p_Header->nChannels, patterns, orders, MusicSpeed, MusicTempo, info.bitRate());
+	auto result{key ? cache.find(*key) : std::nullopt};
+	if (result)
+		disableEffects(patterns, p_Header->nChannels, result->disabledEffects);
+	else
+	{
+		/* State tracker for the scan */
+		scanState_t state{ModuleType, p_Header->nPatterns, p_Header->nChannels, patterns, orders,
+			MusicSpeed, MusicTempo, info.bitRate()};
+		/* Ask the scanner to do its job across the patterns in the order specified by the tune */
+		state.scan();
+		result = {state.samplesProduced, std::move(state.disabledEffects)};
+		if (key && state.cacheable)
+			cache.store(*key, *result);
+	}
 	/* Extract the final number of samples produced and stuff it into the info, converting to seconds */
-	const uint64_t timeSeconds{state.samplesProduced / info.bitRate()};
-	const bool timeRemainder{(state.samplesProduced % info.bitRate()) != 0U};
+	const uint64_t timeSeconds{result->samplesProduced / info.bitRate()};
+	const bool timeRemainder{(result->samplesProduced % info.bitRate()) != 0U};
 	info.totalTime(timeSeconds + (timeRemainder ? 1U : 0U));
 }
 
@@ -350,10 +433,18 @@ void scanState_t::disableJumpEffect() noexcept
 		const auto [effect, param]{command.effect()};
 		/* If this command is either a pattern jump or position jump, mark it disabled */
 		if (effect == CMD_PATTERNBREAK || effect == CMD_POSITIONJUMP)
+		{
 			command.disableEffect();
+			recordDisabledEffect(uint16_t(idx));
+		}
 	}
 }
 
+void scanState_t::recordDisabledEffect(const uint16_t channel) noexcept try
+	{ disabledEffects.push_back({currentPattern, currentRow, channel}); }
+catch (const std::bad_alloc &)
+	{ cacheable = false; }
+
 std::optional<uint16_t> channelState_t::patternLoop(const uint8_t param, const uint16_t row) noexcept
 {
 	/* Figure out where the pattern loop is to */
@@ -379,3 +470,13 @@ std::optional<uint16_t> channelState_t::patternLoop(const uint8_t param, const u
 		patternLoopStart = row;
 	return {};
 }
+
+/*!
+ * Sets the file in which the lengths of the modules opened from now on are cached, so that
+ * opening the same module again doesn't have to scan through its entire song. The cache is off
+ * by default, and an empty path turns it back off.
+ * @param path The cache file to use, which is created if it does not exist
+ * @return \c true if the cache file is usable, otherwise \c false and the cache setting is left unchanged
+ */
+bool audioModuleScanCache(const std::string &path) { return scanCache().path(path); }
+std::string audioModuleScanCache() { return scanCache().path(); }
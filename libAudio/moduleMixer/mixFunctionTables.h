@@ -4,46 +4,45 @@
 #define LIBAUDIO_MODULEMIXER_MIXFUNCTIONTABLES_H
 
 #include "mixFunctions.h"
+#include "mixKernels.hxx"
 
-#define MIX_NOSRC		0x00
-#define MIX_RAMP		0x01
-#define MIX_LINEARSRC	0x02
-#define MIX_HQSRC		0x04
-#define MIX_FILTER		0x08
-#define MIX_STEREO		0x10
-#define MIX_16BIT		0x20
-
+/*
+ * Indexed by the MIX_* flags for the channel being mixed. Within each group of 8, the entries
+ * are ordered nearest, linear, 4-tap (HQ) sinc and 8-tap windowed sinc interpolation, each
+ * first without and then with volume ramping.
+ */
 const std::array<MixInterface, 64> MixFunctionTable
 {{
 	//// 8-bit ////
 	// Mono
 	// Non filtering functions
 	Mono8BitMix, Mono8BitRampMix, Mono8BitLinearMix, Mono8BitLinearRampMix,
-	Mono8BitHQMix, Mono8BitHQRampMix, NULL, NULL,
+	Mono8BitHQMix, Mono8BitHQRampMix, Mono8BitSincMix, Mono8BitSincRampMix,
 	// Filtering functions
 	FilterMono8BitMix, FilterMono8BitRampMix, FilterMono8BitLinearMix, FilterMono8BitLinearRampMix,
-	FilterMono8BitHQMix, FilterMono8BitHQRampMix, NULL, NULL,
+	FilterMono8BitHQMix, FilterMono8BitHQRampMix, FilterMono8BitSincMix, FilterMono8BitSincRampMix,
 	// Stereo
 	// Non filtering functions
-	Stereo8BitMix, Stereo8BitRampMix, NULL, NULL,
-	NULL, NULL, NULL, NULL,
+	Stereo8BitMix, Stereo8BitRampMix, Stereo8BitLinearMix, Stereo8BitLinearRampMix,
+	Stereo8BitHQMix, Stereo8BitHQRampMix, Stereo8BitSincMix, Stereo8BitSincRampMix,
 	// Filtering functions
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
+	FilterStereo8BitMix, FilterStereo8BitRampMix, FilterStereo8BitLinearMix, FilterStereo8BitLinearRampMix,
+	FilterStereo8BitHQMix, FilterStereo8BitHQRampMix, FilterStereo8BitSincMix, FilterStereo8BitSincRampMix,
 	//// 16-bit ////
+	// Mono
 	// Non filtering functions
 	Mono16BitMix, Mono16BitRampMix, Mono16BitLinearMix, Mono16BitLinearRampMix,
-	Mono16BitHQMix, Mono16BitHQRampMix, NULL, NULL,
+	Mono16BitHQMix, Mono16BitHQRampMix, Mono16BitSincMix, Mono16BitSincRampMix,
 	// Filtering functions
 	FilterMono16BitMix, FilterMono16BitRampMix, FilterMono16BitLinearMix, FilterMono16BitLinearRampMix,
-	FilterMono16BitHQMix, FilterMono16BitHQRampMix, NULL, NULL,
+	FilterMono16BitHQMix, FilterMono16BitHQRampMix, FilterMono16BitSincMix, FilterMono16BitSincRampMix,
 	// Stereo
 	// Non filtering functions
-	Stereo16BitMix, Stereo16BitRampMix, NULL, NULL,
-	NULL, NULL, NULL, NULL,
+	Stereo16BitMix, Stereo16BitRampMix, Stereo16BitLinearMix, Stereo16BitLinearRampMix,
+	Stereo16BitHQMix, Stereo16BitHQRampMix, Stereo16BitSincMix, Stereo16BitSincRampMix,
 	// Filtering functions
-	NULL, NULL, NULL, NULL,
-	NULL, NULL, NULL, NULL,
+	FilterStereo16BitMix, FilterStereo16BitRampMix, FilterStereo16BitLinearMix, FilterStereo16BitLinearRampMix,
+	FilterStereo16BitHQMix, FilterStereo16BitHQRampMix, FilterStereo16BitSincMix, FilterStereo16BitSincRampMix,
 }};
 
 #endif /*LIBAUDIO_MODULEMIXER_MIXFUNCTIONTABLES_H*/
@@ -5,8 +5,11 @@
 #define LIBAUDIO_MODULEMIXER_MIXFUNCTIONS_H 1
 
 #include <cstdint>
+#include <cmath>
+#include <algorithm>
 #include <array>
 #include <utility>
+#include "mixKernels.hxx"
 
 typedef void (*MixInterface)(channel_t *, int *, int *);
 
@@ -80,7 +83,8 @@ const std::array<int16_t, 1024> FastSinc
    -1,   135, 16374,  -124,    -1,   100, 16378,   -93,     0,    65, 16381,   -63,     0,    32, 16383,   -31,
 }};
 
-double zero(double y)
+// Zeroth order modified Bessel function of the first kind, used to build the Kaiser window
+inline double besselI0(const double y) noexcept
 {
 	double s = 1;
 	double ds = 1;
@@ -96,110 +100,157 @@ double zero(double y)
 	return s;
 }
 
-void getsinc(short **p_Sinc, double Beta, double LowPassFactor)
+/*!
+ * @internal
+ * Gets the table of Kaiser windowed sinc coefficients used by the 8-tap interpolator, building it
+ * the first time it's asked for. The table holds syncPhases sets of 8 coefficients, one set per
+ * fractional sample position, where 16384 represents unity just as it does in FastSinc. Tap n of a
+ * set weights the sample n - 3 frames from the whole sample position.
+ */
+inline const std::array<int16_t, syncPhases * 8U> &windowedSinc() noexcept
 {
-	double ZeroBeta = zero(Beta);
-	double LPAt = 4.0 * atan(1.0) * LowPassFactor;
-	short *Sinc = *p_Sinc = (short *)malloc(sizeof(short) * syncPhases * 8);
-	for (uint32_t i = 0; i < 8U * syncPhases; i++)
+	static const auto table{[]() noexcept
 	{
-		double FSinc;
-		int x = 7U - (i & 7U), n;
-		x = (x * syncPhases) + (i >> 3U);
-		if (x == 4 * syncPhases)
-			FSinc = 1.0;
-		else
+		constexpr double beta{9.6377};
+		constexpr double lowPassFactor{0.97};
+		const double zeroBeta{besselI0(beta)};
+		const double lowPassAt{4.0 * std::atan(1.0) * lowPassFactor};
+		std::array<int16_t, syncPhases * 8U> sinc{};
+		for (uint32_t i{0U}; i < sinc.size(); ++i)
 		{
-			double y = (x - (4 * syncPhases)) * (1.0 / syncPhases);
-			FSinc = sin(y * LPAt) * zero(Beta * sqrt(1 - y * y * (1.0 / 16.0))) / (ZeroBeta * y * LPAt);
+			const auto x{static_cast<int32_t>(((7U - (i & 7U)) * syncPhases) + (i >> 3U))};
+			double value{1.0};
+			if (x != 4 * int32_t{syncPhases})
+			{
+				const double y{(x - (4.0 * syncPhases)) / syncPhases};
+				value = std::sin(y * lowPassAt) * besselI0(beta * std::sqrt(1.0 - y * y / 16.0)) /
+					(zeroBeta * y * lowPassAt);
+			}
+			const auto coefficient{static_cast<int32_t>(value * lowPassFactor * (16384 * 256))};
+			sinc[i] = static_cast<int16_t>((coefficient + 0x80) >> 8);
 		}
-		n = (int)(FSinc * LowPassFactor * (16384 * 256));
-		*Sinc = static_cast<short>((n + 0x80U) >> 8U);
-		Sinc++;
-	}
+		return sinc;
+	}()};
+	return table;
 }
 
+/*!
+ * @internal
+ * The sample data being mixed, offset to the channel's current whole sample position, along
+ * with the range of frames either side of that position that may be read. Interpolators that
+ * need taps from beyond either end of the sample get the first or last frame repeated instead.
+ */
+template<typename T> struct sampleView_t final
+{
+	const T *data;
+	int32_t first;
+	int32_t last;
+
+	[[nodiscard]] int32_t frame(const int32_t index) const noexcept { return std::min(std::max(index, first), last); }
+};
+
 using samplePair_t = std::pair<int16_t, int16_t>;
-template<typename T> using sampleFn_t = samplePair_t(const T *const, const uint32_t);
+template<typename T> using sampleFn_t = samplePair_t(const sampleView_t<T> &, const int32_t);
 using storeFn_t = void(const channel_t &, int32_t *const , const int16_t, const int16_t,
 	uint32_t &, uint32_t &);
 
-inline samplePair_t monoSample(const int8_t *const buffer, const uint32_t position) noexcept
+// Scales a raw sample value to 16-bit
+template<typename T> inline int16_t scaleSample(const T sample) noexcept
 {
-	const int16_t sample = static_cast<uint16_t>(buffer[position >> 16U]) << 8U;
-	return {sample, sample};
+	if constexpr (sizeof(T) == 1U)
+		return static_cast<int16_t>(sample * 256);
+	else
+		return sample;
 }
 
-inline samplePair_t monoSample(const int16_t *const buffer, const uint32_t position) noexcept
+inline int16_t clipSample(const int32_t sample) noexcept
+	{ return static_cast<int16_t>(std::min(std::max(sample, int32_t{INT16_MIN}), int32_t{INT16_MAX})); }
+
+// Reads one channel of the frame \p frame frames from the whole sample position, as a 16-bit value
+template<size_t channels, typename T> inline int32_t sampleTap(const sampleView_t<T> &sample,
+	const int32_t frame, const size_t channel) noexcept
+	{ return scaleSample(sample.data[(sample.frame(frame) * int32_t{channels}) + channel]); }
+
+template<size_t channels, typename T> inline int16_t nearestSample(const sampleView_t<T> &sample,
+	const int32_t position, const size_t channel) noexcept
+	{ return scaleSample(sample.data[((position >> 16) * int32_t{channels}) + channel]); }
+
+template<size_t channels, typename T> inline int16_t linearSample(const sampleView_t<T> &sample,
+	const int32_t position, const size_t channel) noexcept
 {
-	const int16_t sample{buffer[position >> 16U]};
-	return {sample, sample};
+	const auto frame{position >> 16};
+	const auto fraction{(position >> 8) & 0xFF};
+	const auto first{sampleTap<channels>(sample, frame, channel)};
+	const auto second{sampleTap<channels>(sample, frame + 1, channel)};
+	return static_cast<int16_t>(first + ((fraction * (second - first)) >> 8));
 }
 
-inline samplePair_t monoLinearSample(const int8_t *const buffer, const uint32_t position) noexcept
+// 4-tap interpolation using the cubic spline approximation to sinc in FastSinc
+template<size_t channels, typename T> inline int16_t highQualitySample(const sampleView_t<T> &sample,
+	const int32_t position, const size_t channel) noexcept
 {
-	const auto positionLow{uint8_t(position >> 8U)};
-	const auto firstSample{monoSample(buffer, position).first};
-	const auto secondSample{monoSample(buffer, position + (1U << 16U)).first};
-	const auto sample{static_cast<int16_t>((firstSample << 7U) + (positionLow * (secondSample - firstSample)))};
-	return {sample, sample};
+	const auto frame{position >> 16};
+	const auto *const coefficients{FastSinc.data() + ((position >> 6) & 0x03FC)};
+	int32_t result{0};
+	for (int32_t tap{0}; tap < 4; ++tap)
+		result += coefficients[tap] * sampleTap<channels>(sample, frame + tap - 1, channel);
+	return clipSample(result >> 14);
 }
 
-inline samplePair_t monoLinearSample(const int16_t *const buffer, const uint32_t position) noexcept
+// 8-tap interpolation using the Kaiser windowed sinc from windowedSinc()
+template<size_t channels, typename T> inline int16_t sincSample(const sampleView_t<T> &sample,
+	const int32_t position, const size_t channel) noexcept
 {
-	const auto positionLow{uint8_t(position >> 8U)};
-	const auto firstSample{monoSample(buffer, position).first};
-	const auto secondSample{monoSample(buffer, position + (1U << 16U)).first};
-	const auto sample{static_cast<int16_t>(firstSample + ((positionLow * (secondSample - firstSample)) >> 9U))};
-	return {sample, sample};
+	const auto frame{position >> 16};
+	const auto *const coefficients{windowedSinc().data() + (((position >> 4) & 0x0FFF) * 8)};
+	int32_t result{0};
+	for (int32_t tap{0}; tap < 8; ++tap)
+		result += coefficients[tap] * sampleTap<channels>(sample, frame + tap - 3, channel);
+	return clipSample(result >> 14);
 }
 
-inline samplePair_t monoHighQualitySample(const int8_t *const buffer, const uint32_t position) noexcept
+template<typename T> inline samplePair_t monoSample(const sampleView_t<T> &sample, const int32_t position) noexcept
 {
-	const auto positionHigh{uint16_t(position >> 16U)};
-	const auto positionLow{uint16_t((position >> 6U) & 0x03FCU)};
-	const auto sample
-	{
-		FastSinc[positionLow]      * buffer[positionHigh - 1U] +
-		FastSinc[positionLow + 1U] * buffer[positionHigh]      +
-		FastSinc[positionLow + 2U] * buffer[positionHigh + 1U] +
-		FastSinc[positionLow + 3U] * buffer[positionHigh + 2U]
-	};
-	return {static_cast<int16_t>(sample >> 7U), static_cast<int16_t>(sample >> 7U)};
+	const auto value{nearestSample<1U>(sample, position, 0U)};
+	return {value, value};
 }
 
-inline samplePair_t monoHighQualitySample(const int16_t *const buffer, const uint32_t position) noexcept
+template<typename T> inline samplePair_t monoLinearSample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
 {
-	const auto positionHigh{uint16_t(position >> 16U)};
-	const auto positionLow{uint16_t((position >> 6U) & 0x03FCU)};
-	const auto sample
-	{
-		FastSinc[positionLow]      * buffer[positionHigh - 1U] +
-		FastSinc[positionLow + 1U] * buffer[positionHigh]      +
-		FastSinc[positionLow + 2U] * buffer[positionHigh + 1U] +
-		FastSinc[positionLow + 3U] * buffer[positionHigh + 2U]
-	};
-	return {static_cast<int16_t>(sample >> 15U), static_cast<int16_t>(sample >> 15U)};
+	const auto value{linearSample<1U>(sample, position, 0U)};
+	return {value, value};
 }
 
-inline samplePair_t stereoSample(const int8_t *const buffer, const uint32_t position) noexcept
+template<typename T> inline samplePair_t monoHighQualitySample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
 {
-	const auto shiftedPosition{(position >> 16U) << 1U};
-	return {
-		static_cast<int16_t>(buffer[shiftedPosition + 0] << 8U),
-		static_cast<int16_t>(buffer[shiftedPosition + 1] << 8U),
-	};
+	const auto value{highQualitySample<1U>(sample, position, 0U)};
+	return {value, value};
 }
 
-inline samplePair_t stereoSample(const int16_t *const buffer, const uint32_t position) noexcept
+template<typename T> inline samplePair_t monoSincSample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
 {
-	const auto shiftedPosition{(position >> 16U) << 1U};
-	return {
-		buffer[shiftedPosition + 0],
-		buffer[shiftedPosition + 1],
-	};
+	const auto value{sincSample<1U>(sample, position, 0U)};
+	return {value, value};
 }
 
+template<typename T> inline samplePair_t stereoSample(const sampleView_t<T> &sample, const int32_t position) noexcept
+	{ return {nearestSample<2U>(sample, position, 0U), nearestSample<2U>(sample, position, 1U)}; }
+
+template<typename T> inline samplePair_t stereoLinearSample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
+	{ return {linearSample<2U>(sample, position, 0U), linearSample<2U>(sample, position, 1U)}; }
+
+template<typename T> inline samplePair_t stereoHighQualitySample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
+	{ return {highQualitySample<2U>(sample, position, 0U), highQualitySample<2U>(sample, position, 1U)}; }
+
+template<typename T> inline samplePair_t stereoSincSample(const sampleView_t<T> &sample,
+	const int32_t position) noexcept
+	{ return {sincSample<2U>(sample, position, 0U), sincSample<2U>(sample, position, 1U)}; }
+
 inline void storeMono(const channel_t &, int32_t *const buffer,
 	const int16_t sampleL, const int16_t sampleR, uint32_t &leftVol, uint32_t &rightVol) noexcept
 {
@@ -230,14 +281,34 @@ inline void rampStereo(const channel_t &channel, int32_t *const buffer,
 	storeStereo(channel, buffer, sampleL, sampleR, leftVol, rightVol);
 }
 
+template<typename T> inline sampleView_t<T> sampleView(const channel_t &channel) noexcept
+{
+	const auto channels{channel.Sample->GetStereo() ? 2U : 1U};
+	const auto position{static_cast<int32_t>(channel.Pos)};
+	return
+	{
+		reinterpret_cast<const T *>(channel.SampleData) + (channel.Pos * channels),
+		-position, static_cast<int32_t>(channel.Length) - 1 - position
+	};
+}
+
+/*!
+ * @internal
+ * Moves the channel on by the signed 16.16 \p position accumulated while mixing. The position
+ * is signed so that ping-pong loops, which mix with a negative increment, step backwards.
+ */
+inline void advancePosition(channel_t &channel, const int32_t position) noexcept
+{
+	channel.Pos += static_cast<uint32_t>(position >> 16);
+	channel.PosLo = static_cast<uint32_t>(position) & 0xFFFFU;
+}
+
 template<typename T> inline void sampleLoop(channel_t &channel, int32_t *begin, const int32_t *const end,
 	sampleFn_t<T> sample, storeFn_t store) noexcept
 {
-	auto position{channel.PosLo};
+	auto position{static_cast<int32_t>(channel.PosLo)};
 	const auto increment{channel.increment.iValue};
-	const auto *sampleData = reinterpret_cast<T *>(channel.SampleData) + channel.Pos;
-	if (channel.Sample->GetStereo())
-		sampleData += channel.Pos;
+	const auto sampleData{sampleView<T>(channel)};
 	uint32_t leftVol{channel.leftVol};
 	uint32_t rightVol{channel.rightVol};
 	do
@@ -248,49 +319,93 @@ template<typename T> inline void sampleLoop(channel_t &channel, int32_t *begin,
 		position += increment;
 	}
 	while (begin < end);
-	channel.Pos += position >> 16U;
-	channel.PosLo = position & 0xFFFFU;
+	advancePosition(channel, position);
 	channel.leftVol = static_cast<uint8_t>(leftVol);
 	channel.rightVol = static_cast<uint8_t>(rightVol);
 }
 
+// Runs the resonant filter over one channel's worth of sample, updating that channel's filter history
+inline int16_t filterSample(const channel_t &channel, const int16_t sample, int &fltY1, int &fltY2) noexcept
+{
+	/*
+	 * Impulse Tracker's two-pole resonant filter, a direct form I recurrence with 13 fractional bits:
+	 * y[n] = A0 * x[n] + B0 * y[n - 1] + B1 * y[n - 2]. For high-pass filters Filter_HP is all ones,
+	 * which takes the input back out of the fed back value, and it is 0 for low-pass ones.
+	 */
+	const auto fltY
+	{
+		(sample * channel.Filter_A0 + fltY1 * channel.Filter_B0 + fltY2 * channel.Filter_B1 + 4096) >> 13U
+	};
+
+	fltY2 = fltY1;
+	fltY1 = fltY - (sample & channel.Filter_HP);
+	return clipSample(fltY);
+}
+
 template<typename T> inline void sampleFilterLoop(channel_t &channel, int32_t *begin, const int32_t *const end,
 	sampleFn_t<T> sample, storeFn_t store) noexcept
 {
-	auto position{channel.PosLo};
+	auto position{static_cast<int32_t>(channel.PosLo)};
 	const auto increment{channel.increment.iValue};
-	const auto *sampleData = reinterpret_cast<T *>(channel.SampleData) + channel.Pos;
-	if (channel.Sample->GetStereo())
-		sampleData += channel.Pos;
+	const auto sampleData{sampleView<T>(channel)};
+	const bool stereo{channel.Sample->GetStereo()};
 	uint32_t leftVol{channel.leftVol};
 	uint32_t rightVol{channel.rightVol};
+	// Mono samples only use the first pair of filter history values, stereo uses the second for the right channel
 	auto fltY1{channel.Filter_Y1};
 	auto fltY2{channel.Filter_Y2};
+	auto fltY3{channel.Filter_Y3};
+	auto fltY4{channel.Filter_Y4};
 	do
 	{
 		auto samples{sample(sampleData, position)};
-
-		// TODO: Figure out how this is actually supposed to work and fix it up as this is terrible.
-		auto fltY
-		{
-			(samples.first * channel.Filter_A0 + fltY1 * channel.Filter_B0 + fltY2 * channel.Filter_B1 + 4096) >> 13U
-		};
-
-		fltY2 = fltY1;
-		fltY1 = fltY - (samples.first & channel.Filter_HP);
-		samples = {static_cast<T>(fltY), static_cast<T>(fltY)};
+		samples.first = filterSample(channel, samples.first, fltY1, fltY2);
+		if (stereo)
+			samples.second = filterSample(channel, samples.second, fltY3, fltY4);
+		else
+			samples.second = samples.first;
 
 		store(channel, begin, samples.first, samples.second, leftVol, rightVol);
 		begin += 2U;
 		position += increment;
 	}
 	while (begin < end);
-	channel.Pos += position >> 16U;
-	channel.PosLo = position & 0xFFFFU;
+	advancePosition(channel, position);
 	channel.leftVol = static_cast<uint8_t>(leftVol);
 	channel.rightVol = static_cast<uint8_t>(rightVol);
 	channel.Filter_Y1 = fltY1;
 	channel.Filter_Y2 = fltY2;
+	channel.Filter_Y3 = fltY3;
+	channel.Filter_Y4 = fltY4;
+}
+
+// Picks the coefficient table the kernel for a mixing mode interpolates with
+inline const int16_t *sincTable(const uint32_t mixMode) noexcept
+{
+	if ((mixMode & MIX_SINCSRC) == MIX_SINCSRC)
+		return windowedSinc().data();
+	return FastSinc.data();
+}
+
+/*!
+ * @internal
+ * Mixes a channel using one of the vectorised kernels from mixKernels(), which are exact
+ * equivalents of the sampleLoop()-based mixers below
+ */
+template<typename T> inline void kernelLoop(channel_t &channel, int32_t *begin, const int32_t *const end,
+	const uint32_t mixMode, const mixKernel_t kernel) noexcept
+{
+	const auto sampleData{sampleView<T>(channel)};
+	mixKernelState_t state
+	{
+		sampleData.data, sincTable(mixMode), sampleData.first, sampleData.last,
+		static_cast<int32_t>(channel.PosLo), channel.increment.iValue,
+		channel.leftVol, channel.rightVol, channel.LeftRamp, channel.RightRamp
+	};
+	kernel(state, begin, end);
+	advancePosition(channel, state.position);
+	channel.leftVol = static_cast<uint8_t>(state.leftVol);
+	channel.rightVol = static_cast<uint8_t>(state.rightVol);
 }
 
 // Interfaces
@@ -310,6 +425,11 @@ static void Mono8BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 static void Mono8BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, monoHighQualitySample, rampMono); }
 
+static void Mono8BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, monoSincSample, storeMono); }
+static void Mono8BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, monoSincSample, rampMono); }
+
 // Mono 16-bit
 static void Mono16BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, monoSample, storeMono); }
@@ -326,6 +446,53 @@ static void Mono16BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 static void Mono16BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, monoHighQualitySample, rampMono); }
 
+static void Mono16BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, monoSincSample, storeMono); }
+static void Mono16BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, monoSincSample, rampMono); }
+
+// Stereo 8-bit
+static void Stereo8BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
+static void Stereo8BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+
+static void Stereo8BitLinearMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoLinearSample, storeStereo); }
+static void Stereo8BitLinearRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoLinearSample, rampStereo); }
+
+static void Stereo8BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoHighQualitySample, storeStereo); }
+static void Stereo8BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoHighQualitySample, rampStereo); }
+
+static void Stereo8BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSincSample, storeStereo); }
+static void Stereo8BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSincSample, rampStereo); }
+
+// Stereo 16-bit
+static void Stereo16BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
+static void Stereo16BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+
+static void Stereo16BitLinearMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoLinearSample, storeStereo); }
+static void Stereo16BitLinearRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoLinearSample, rampStereo); }
+
+static void Stereo16BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoHighQualitySample, storeStereo); }
+static void Stereo16BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoHighQualitySample, rampStereo); }
+
+static void Stereo16BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSincSample, storeStereo); }
+static void Stereo16BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSincSample, rampStereo); }
+
 // Filter Interfaces
 // Mono 8-bit
 static void FilterMono8BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
@@ -343,6 +510,11 @@ static void FilterMono8BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcep
 static void FilterMono8BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, monoHighQualitySample, rampMono); }
 
+static void FilterMono8BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, monoSincSample, storeMono); }
+static void FilterMono8BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, monoSincSample, rampMono); }
+
 // Mono 16-bit
 static void FilterMono16BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, monoSample, storeMono); }
@@ -359,16 +531,51 @@ static void FilterMono16BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexce
 static void FilterMono16BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
 	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, monoHighQualitySample, rampMono); }
 
+static void FilterMono16BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, monoSincSample, storeMono); }
+static void FilterMono16BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, monoSincSample, rampMono); }
+
 // Stereo 8-bit
-static void Stereo8BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
-	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
-static void Stereo8BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
-	{ sampleLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+static void FilterStereo8BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
+static void FilterStereo8BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+
+static void FilterStereo8BitLinearMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoLinearSample, storeStereo); }
+static void FilterStereo8BitLinearRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoLinearSample, rampStereo); }
+
+static void FilterStereo8BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoHighQualitySample, storeStereo); }
+static void FilterStereo8BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoHighQualitySample, rampStereo); }
+
+static void FilterStereo8BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoSincSample, storeStereo); }
+static void FilterStereo8BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int8_t>(*chn, Buff, BuffMax, stereoSincSample, rampStereo); }
 
 // Stereo 16-bit
-static void Stereo16BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
-	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
-static void Stereo16BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
-	{ sampleLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+static void FilterStereo16BitMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, storeStereo); }
+static void FilterStereo16BitRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoSample, rampStereo); }
+
+static void FilterStereo16BitLinearMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoLinearSample, storeStereo); }
+static void FilterStereo16BitLinearRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoLinearSample, rampStereo); }
+
+static void FilterStereo16BitHQMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoHighQualitySample, storeStereo); }
+static void FilterStereo16BitHQRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoHighQualitySample, rampStereo); }
+
+static void FilterStereo16BitSincMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoSincSample, storeStereo); }
+static void FilterStereo16BitSincRampMix(channel_t *chn, int *Buff, int *BuffMax) noexcept
+	{ sampleFilterLoop<int16_t>(*chn, Buff, BuffMax, stereoSincSample, rampStereo); }
 
 #endif /*LIBAUDIO_MODULEMIXER_MIXFUNCTIONS_H*/
@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include "mixKernels.hxx"
+#include "../cpuFeatures.hxx"
+
+/*!
+ * @internal
+ * Gets the table of vectorised mixing kernels for this machine, indexed like MixFunctionTable.
+ * Entries are \c nullptr for mixing modes that have no vectorised kernel, and on machines with
+ * no supported vector unit the whole table is empty, leaving the scalar mixers to be used.
+ */
+const mixKernelTable_t &mixKernels() noexcept
+{
+	static const mixKernelTable_t kernels{[]() noexcept
+	{
+		mixKernelTable_t table{};
+		switch (cpuISA())
+		{
+#if defined(CPU_FEATURES_X86)
+			case cpuISA_t::avx2:
+				avx2MixKernels(table);
+				break;
+			case cpuISA_t::sse2:
+				sse2MixKernels(table);
+				break;
+#elif defined(CPU_FEATURES_NEON)
+			case cpuISA_t::neon:
+				neonMixKernels(table);
+				break;
+#endif
+			default:
+				break;
+		}
+		return table;
+	}()};
+	return kernels;
+}
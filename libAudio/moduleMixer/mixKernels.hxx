@@ -0,0 +1,62 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+// Vectorised mixing kernels, selected at runtime by CPU feature detection
+#ifndef LIBAUDIO_MODULEMIXER_MIXKERNELS_HXX
+#define LIBAUDIO_MODULEMIXER_MIXKERNELS_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+
+#define MIX_NOSRC		0x00
+#define MIX_RAMP		0x01
+#define MIX_LINEARSRC	0x02
+#define MIX_HQSRC		0x04
+#define MIX_FILTER		0x08
+#define MIX_STEREO		0x10
+#define MIX_16BIT		0x20
+// Linear and HQ together select the 8-tap windowed sinc interpolator
+#define MIX_SINCSRC		(MIX_LINEARSRC | MIX_HQSRC)
+
+/*!
+ * @internal
+ * The subset of a channel's state that a mixing kernel needs to mix it, lifted out of
+ * channel_t so the kernels can be compiled without knowledge of the module structures
+ */
+struct mixKernelState_t final
+{
+	/*!
+	 * @internal
+	 * The sample data to mix, already offset to the channel's current whole sample position
+	 */
+	const void *sampleData;
+	/*!
+	 * @internal
+	 * The interpolation coefficients for the mode being mixed - FastSinc or windowedSinc()
+	 */
+	const int16_t *sinc;
+	/*!
+	 * @internal
+	 * The first and last frames, relative to sampleData, that interpolation taps may read
+	 */
+	int32_t firstFrame;
+	int32_t lastFrame;
+	int32_t position;
+	int32_t increment;
+	uint32_t leftVol;
+	uint32_t rightVol;
+	int32_t leftRamp;
+	int32_t rightRamp;
+};
+
+using mixKernel_t = void (*)(mixKernelState_t &state, int32_t *begin, const int32_t *end) noexcept;
+// Indexed by the same MIX_* flag combinations as MixFunctionTable
+using mixKernelTable_t = std::array<mixKernel_t, 64>;
+
+void sse2MixKernels(mixKernelTable_t &kernels) noexcept;
+void avx2MixKernels(mixKernelTable_t &kernels) noexcept;
+void neonMixKernels(mixKernelTable_t &kernels) noexcept;
+
+[[nodiscard]] const mixKernelTable_t &mixKernels() noexcept;
+
+#endif /*LIBAUDIO_MODULEMIXER_MIXKERNELS_HXX*/
@@ -0,0 +1,58 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <immintrin.h>
+
+// The rest of the library is built for the baseline of the target, so only these kernels get AVX2
+#if defined(__GNUC__) || defined(__clang__)
+#define MIX_KERNEL_TARGET __attribute__((target("avx2")))
+#endif
+
+#include "mixKernelsImpl.hxx"
+
+namespace
+{
+	struct avx2Vec_t final
+	{
+		using type = __m256i;
+		constexpr static size_t width{8U};
+
+		MIX_KERNEL_TARGET static inline type load(const int32_t *const value) noexcept
+			{ return _mm256_load_si256(reinterpret_cast<const __m256i *>(value)); }
+		MIX_KERNEL_TARGET static inline type set1(const int32_t value) noexcept { return _mm256_set1_epi32(value); }
+		MIX_KERNEL_TARGET static inline type add(const type a, const type b) noexcept
+			{ return _mm256_add_epi32(a, b); }
+		MIX_KERNEL_TARGET static inline type sub(const type a, const type b) noexcept
+			{ return _mm256_sub_epi32(a, b); }
+		MIX_KERNEL_TARGET static inline type mullo(const type a, const type b) noexcept
+			{ return _mm256_mullo_epi32(a, b); }
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type slli(const type a) noexcept
+			{ return _mm256_slli_epi32(a, shift); }
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type srai(const type a) noexcept
+			{ return _mm256_srai_epi32(a, shift); }
+		MIX_KERNEL_TARGET static inline type clamp16(const type a) noexcept
+			{ return _mm256_min_epi32(_mm256_max_epi32(a, set1(INT16_MIN)), set1(INT16_MAX)); }
+
+		MIX_KERNEL_TARGET static inline type ramp(const uint32_t base, const int32_t step) noexcept
+		{
+			return add(set1(static_cast<int32_t>(base)),
+				mullo(set1(step), _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 8)));
+		}
+
+		MIX_KERNEL_TARGET static inline void accumulate(int32_t *const buffer, const type right,
+			const type left) noexcept
+		{
+			// The unpacks work within each 128-bit half, so put the halves back in frame order afterwards
+			const auto low{_mm256_unpacklo_epi32(right, left)};
+			const auto high{_mm256_unpackhi_epi32(right, left)};
+			auto *const result{reinterpret_cast<__m256i *>(buffer)};
+			_mm256_storeu_si256(result + 0, _mm256_add_epi32(_mm256_loadu_si256(result + 0),
+				_mm256_permute2x128_si256(low, high, 0x20)));
+			_mm256_storeu_si256(result + 1, _mm256_add_epi32(_mm256_loadu_si256(result + 1),
+				_mm256_permute2x128_si256(low, high, 0x31)));
+		}
+	};
+} // namespace
+
+void avx2MixKernels(mixKernelTable_t &kernels) noexcept { fillMixKernels<avx2Vec_t>(kernels); }
+#endif
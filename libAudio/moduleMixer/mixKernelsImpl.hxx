@@ -0,0 +1,244 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+// Generic implementation of the vectorised mixing kernels, parameterised on a vector policy
+#ifndef LIBAUDIO_MODULEMIXER_MIXKERNELSIMPL_HXX
+#define LIBAUDIO_MODULEMIXER_MIXKERNELSIMPL_HXX
+
+#include <algorithm>
+#include "mixKernels.hxx"
+
+/*
+ * This header must only be included by the per-instruction set kernel translation units, each of which
+ * defines MIX_KERNEL_TARGET to the attribute that enables its instruction set before including this.
+ * Everything here lives in an anonymous namespace so that each of those translation units gets its own
+ * copy compiled for its own instruction set - otherwise the linker would be free to pick, say, the AVX2
+ * build of the scalar tail loop for use by the SSE2 kernels.
+ *
+ * The kernels replicate the arithmetic in mixFunctions.h exactly, including the clipping to 16-bit,
+ * the clamping of interpolation taps to the ends of the sample and the modulo-2^32 volume arithmetic,
+ * so they produce output identical to the scalar mixers. The filtering modes have no kernels as the
+ * filter is a recurrence over consecutive output frames.
+ */
+#ifndef MIX_KERNEL_TARGET
+#define MIX_KERNEL_TARGET
+#endif
+
+namespace
+{
+	enum class mixInterp_t
+	{
+		nearest,
+		linear,
+		highQuality,
+		sinc
+	};
+
+	// How many sample frames each interpolator reads to compute one output frame
+	constexpr size_t tapCount(const mixInterp_t interp) noexcept
+	{
+		switch (interp)
+		{
+			case mixInterp_t::linear:
+				return 2U;
+			case mixInterp_t::highQuality:
+				return 4U;
+			case mixInterp_t::sinc:
+				return 8U;
+			default:
+				return 1U;
+		}
+	}
+
+	// Handles the samples left over once no whole vector's worth remains
+	struct scalarVec_t final
+	{
+		using type = int32_t;
+		constexpr static size_t width{1U};
+
+		MIX_KERNEL_TARGET static inline type load(const int32_t *const value) noexcept { return *value; }
+		MIX_KERNEL_TARGET static inline type set1(const int32_t value) noexcept { return value; }
+		MIX_KERNEL_TARGET static inline type add(const type a, const type b) noexcept
+			{ return static_cast<int32_t>(static_cast<uint32_t>(a) + static_cast<uint32_t>(b)); }
+		MIX_KERNEL_TARGET static inline type sub(const type a, const type b) noexcept
+			{ return static_cast<int32_t>(static_cast<uint32_t>(a) - static_cast<uint32_t>(b)); }
+		MIX_KERNEL_TARGET static inline type mullo(const type a, const type b) noexcept
+			{ return static_cast<int32_t>(static_cast<uint32_t>(a) * static_cast<uint32_t>(b)); }
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type slli(const type a) noexcept
+			{ return static_cast<int32_t>(static_cast<uint32_t>(a) << shift); }
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type srai(const type a) noexcept
+			{ return a >> shift; }
+		MIX_KERNEL_TARGET static inline type clamp16(const type a) noexcept
+			{ return std::min(std::max(a, int32_t{INT16_MIN}), int32_t{INT16_MAX}); }
+
+		MIX_KERNEL_TARGET static inline type ramp(const uint32_t base, const int32_t step) noexcept
+			{ return static_cast<int32_t>(base + static_cast<uint32_t>(step)); }
+
+		MIX_KERNEL_TARGET static inline void accumulate(int32_t *const buffer, const type right,
+			const type left) noexcept
+		{
+			buffer[0] = add(buffer[0], right);
+			buffer[1] = add(buffer[1], left);
+		}
+	};
+
+	// Scales a raw sample value to 16-bit, as scaleSample() in mixFunctions.h does
+	template<typename T> MIX_KERNEL_TARGET inline int32_t scaleSample(const T sample) noexcept
+	{
+		if constexpr (sizeof(T) == 1U)
+			return sample * 256;
+		else
+			return sample;
+	}
+
+	/*
+	 * Computes the (16-bit) samples of one channel for vec_t::width frames starting at position.
+	 * The sample taps for each lane are read with scalar loads as the positions are data dependent
+	 * and the samples are 8 or 16-bit, which hardware gathers can't help with - the interpolation
+	 * arithmetic is then done across all the lanes at once.
+	 */
+	template<typename vec_t, typename T, mixInterp_t interp, size_t channels> MIX_KERNEL_TARGET inline
+		typename vec_t::type channelBlock(const mixKernelState_t &state, const T *const buffer,
+			const uint32_t position, const uint32_t increment, const size_t channel) noexcept
+	{
+		constexpr auto width{vec_t::width};
+		constexpr auto taps{tapCount(interp)};
+		alignas(32) int32_t samples[taps][width];
+		alignas(32) int32_t coefficients[taps][width];
+		const auto tap
+		{
+			[&](const int32_t frame) noexcept
+			{
+				const auto index{std::min(std::max(frame, state.firstFrame), state.lastFrame)};
+				return scaleSample(buffer[(index * int32_t{channels}) + channel]);
+			}
+		};
+
+		for (size_t lane{0U}; lane < width; ++lane)
+		{
+			const auto lanePosition{static_cast<int32_t>(position + (static_cast<uint32_t>(lane) * increment))};
+			const auto frame{lanePosition >> 16};
+			if constexpr (interp == mixInterp_t::nearest)
+				samples[0][lane] = scaleSample(buffer[(frame * int32_t{channels}) + channel]);
+			else if constexpr (interp == mixInterp_t::linear)
+			{
+				samples[0][lane] = tap(frame);
+				samples[1][lane] = tap(frame + 1);
+				coefficients[0][lane] = (lanePosition >> 8) & 0xFF;
+			}
+			else if constexpr (interp == mixInterp_t::highQuality)
+			{
+				const auto *const sinc{state.sinc + ((lanePosition >> 6) & 0x03FC)};
+				for (size_t i{0U}; i < taps; ++i)
+				{
+					samples[i][lane] = tap(frame + static_cast<int32_t>(i) - 1);
+					coefficients[i][lane] = sinc[i];
+				}
+			}
+			else
+			{
+				const auto *const sinc{state.sinc + (((lanePosition >> 4) & 0x0FFF) * 8)};
+				for (size_t i{0U}; i < taps; ++i)
+				{
+					samples[i][lane] = tap(frame + static_cast<int32_t>(i) - 3);
+					coefficients[i][lane] = sinc[i];
+				}
+			}
+		}
+
+		if constexpr (interp == mixInterp_t::nearest)
+			return vec_t::load(samples[0]);
+		else if constexpr (interp == mixInterp_t::linear)
+		{
+			const auto first{vec_t::load(samples[0])};
+			const auto delta{vec_t::sub(vec_t::load(samples[1]), first)};
+			return vec_t::add(first, vec_t::template srai<8U>(vec_t::mullo(vec_t::load(coefficients[0]), delta)));
+		}
+		else
+		{
+			auto result{vec_t::mullo(vec_t::load(coefficients[0]), vec_t::load(samples[0]))};
+			for (size_t i{1U}; i < taps; ++i)
+				result = vec_t::add(result, vec_t::mullo(vec_t::load(coefficients[i]), vec_t::load(samples[i])));
+			return vec_t::clamp16(vec_t::template srai<14U>(result));
+		}
+	}
+
+	// Mixes vec_t::width frames into buffer, advancing the position and volumes past them
+	template<typename vec_t, typename T, mixInterp_t interp, bool ramp, bool stereo> MIX_KERNEL_TARGET inline void
+		mixBlock(const mixKernelState_t &state, const T *const sampleData, int32_t *const buffer,
+			uint32_t &position, uint32_t &leftVol, uint32_t &rightVol) noexcept
+	{
+		// storeStereo() and storeMono() scale the volumes differently
+		constexpr uint8_t volumeShift{stereo ? 3U : 4U};
+		constexpr size_t channels{stereo ? 2U : 1U};
+		const auto increment{static_cast<uint32_t>(state.increment)};
+		const auto left{channelBlock<vec_t, T, interp, channels>(state, sampleData, position, increment, 0U)};
+		auto right{left};
+		if constexpr (stereo)
+			right = channelBlock<vec_t, T, interp, channels>(state, sampleData, position, increment, 1U);
+
+		typename vec_t::type leftVolume{};
+		typename vec_t::type rightVolume{};
+		if constexpr (ramp)
+		{
+			leftVolume = vec_t::template slli<volumeShift>(vec_t::ramp(leftVol, state.leftRamp));
+			rightVolume = vec_t::template slli<volumeShift>(vec_t::ramp(rightVol, state.rightRamp));
+			leftVol += static_cast<uint32_t>(state.leftRamp) * static_cast<uint32_t>(vec_t::width);
+			rightVol += static_cast<uint32_t>(state.rightRamp) * static_cast<uint32_t>(vec_t::width);
+		}
+		else
+		{
+			leftVolume = vec_t::set1(static_cast<int32_t>(leftVol << volumeShift));
+			rightVolume = vec_t::set1(static_cast<int32_t>(rightVol << volumeShift));
+		}
+		vec_t::accumulate(buffer, vec_t::mullo(right, rightVolume), vec_t::mullo(left, leftVolume));
+		position += increment * static_cast<uint32_t>(vec_t::width);
+	}
+
+	template<typename vec_t, typename T, mixInterp_t interp, bool ramp, bool stereo> MIX_KERNEL_TARGET void
+		mixKernel(mixKernelState_t &state, int32_t *const begin, const int32_t *const end) noexcept
+	{
+		const auto *const sampleData{static_cast<const T *>(state.sampleData)};
+		const auto frames{static_cast<size_t>(end - begin) / 2U};
+		auto position{static_cast<uint32_t>(state.position)};
+		auto leftVol{state.leftVol};
+		auto rightVol{state.rightVol};
+
+		size_t frame{0U};
+		for (; frame + vec_t::width <= frames; frame += vec_t::width)
+			mixBlock<vec_t, T, interp, ramp, stereo>(state, sampleData, begin + (frame * 2U),
+				position, leftVol, rightVol);
+		for (; frame < frames; ++frame)
+			mixBlock<scalarVec_t, T, interp, ramp, stereo>(state, sampleData, begin + (frame * 2U),
+				position, leftVol, rightVol);
+
+		state.position = static_cast<int32_t>(position);
+		state.leftVol = leftVol;
+		state.rightVol = rightVol;
+	}
+
+	// Installs the kernels for every interpolator and volume ramp combination of one sample format
+	template<typename vec_t, typename T, bool stereo> void fillFormatKernels(mixKernelTable_t &kernels,
+		const uint32_t format) noexcept
+	{
+		using interp_t = mixInterp_t;
+		kernels[format | MIX_NOSRC] = mixKernel<vec_t, T, interp_t::nearest, false, stereo>;
+		kernels[format | MIX_NOSRC | MIX_RAMP] = mixKernel<vec_t, T, interp_t::nearest, true, stereo>;
+		kernels[format | MIX_LINEARSRC] = mixKernel<vec_t, T, interp_t::linear, false, stereo>;
+		kernels[format | MIX_LINEARSRC | MIX_RAMP] = mixKernel<vec_t, T, interp_t::linear, true, stereo>;
+		kernels[format | MIX_HQSRC] = mixKernel<vec_t, T, interp_t::highQuality, false, stereo>;
+		kernels[format | MIX_HQSRC | MIX_RAMP] = mixKernel<vec_t, T, interp_t::highQuality, true, stereo>;
+		kernels[format | MIX_SINCSRC] = mixKernel<vec_t, T, interp_t::sinc, false, stereo>;
+		kernels[format | MIX_SINCSRC | MIX_RAMP] = mixKernel<vec_t, T, interp_t::sinc, true, stereo>;
+	}
+
+	// Installs the kernels built on vec_t for every mixing mode they implement
+	template<typename vec_t> void fillMixKernels(mixKernelTable_t &kernels) noexcept
+	{
+		fillFormatKernels<vec_t, int8_t, false>(kernels, 0U);
+		fillFormatKernels<vec_t, int8_t, true>(kernels, MIX_STEREO);
+		fillFormatKernels<vec_t, int16_t, false>(kernels, MIX_16BIT);
+		fillFormatKernels<vec_t, int16_t, true>(kernels, MIX_16BIT | MIX_STEREO);
+	}
+} // namespace
+
+#endif /*LIBAUDIO_MODULEMIXER_MIXKERNELSIMPL_HXX*/
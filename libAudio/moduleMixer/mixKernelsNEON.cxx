@@ -0,0 +1,40 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#include "mixKernelsImpl.hxx"
+
+namespace
+{
+	struct neonVec_t final
+	{
+		using type = int32x4_t;
+		constexpr static size_t width{4U};
+
+		static inline type load(const int32_t *const value) noexcept { return vld1q_s32(value); }
+		static inline type set1(const int32_t value) noexcept { return vdupq_n_s32(value); }
+		static inline type add(const type a, const type b) noexcept { return vaddq_s32(a, b); }
+		static inline type sub(const type a, const type b) noexcept { return vsubq_s32(a, b); }
+		static inline type mullo(const type a, const type b) noexcept { return vmulq_s32(a, b); }
+		template<uint8_t shift> static inline type slli(const type a) noexcept { return vshlq_n_s32(a, shift); }
+		template<uint8_t shift> static inline type srai(const type a) noexcept { return vshrq_n_s32(a, shift); }
+		static inline type clamp16(const type a) noexcept
+			{ return vminq_s32(vmaxq_s32(a, set1(INT16_MIN)), set1(INT16_MAX)); }
+
+		static inline type ramp(const uint32_t base, const int32_t step) noexcept
+		{
+			alignas(16) constexpr int32_t lanes[4]{1, 2, 3, 4};
+			return vmlaq_s32(set1(static_cast<int32_t>(base)), set1(step), vld1q_s32(lanes));
+		}
+
+		static inline void accumulate(int32_t *const buffer, const type right, const type left) noexcept
+		{
+			const auto frames{vzipq_s32(right, left)};
+			vst1q_s32(buffer + 0, vaddq_s32(vld1q_s32(buffer + 0), frames.val[0]));
+			vst1q_s32(buffer + 4, vaddq_s32(vld1q_s32(buffer + 4), frames.val[1]));
+		}
+	};
+} // namespace
+
+void neonMixKernels(mixKernelTable_t &kernels) noexcept { fillMixKernels<neonVec_t>(kernels); }
+#endif
@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <emmintrin.h>
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__SSE2__)
+#define MIX_KERNEL_TARGET __attribute__((target("sse2")))
+#endif
+
+#include "mixKernelsImpl.hxx"
+
+namespace
+{
+	struct sse2Vec_t final
+	{
+		using type = __m128i;
+		constexpr static size_t width{4U};
+
+		MIX_KERNEL_TARGET static inline type load(const int32_t *const value) noexcept
+			{ return _mm_load_si128(reinterpret_cast<const __m128i *>(value)); }
+		MIX_KERNEL_TARGET static inline type set1(const int32_t value) noexcept { return _mm_set1_epi32(value); }
+		MIX_KERNEL_TARGET static inline type add(const type a, const type b) noexcept { return _mm_add_epi32(a, b); }
+		MIX_KERNEL_TARGET static inline type sub(const type a, const type b) noexcept { return _mm_sub_epi32(a, b); }
+
+		// SSE2 has no 32-bit low multiply, so build one from the two 32x32->64 multiplies it does have
+		MIX_KERNEL_TARGET static inline type mullo(const type a, const type b) noexcept
+		{
+			const auto even{_mm_mul_epu32(a, b)};
+			const auto odd{_mm_mul_epu32(_mm_srli_epi64(a, 32), _mm_srli_epi64(b, 32))};
+			return _mm_unpacklo_epi32
+			(
+				_mm_shuffle_epi32(even, _MM_SHUFFLE(0, 0, 2, 0)),
+				_mm_shuffle_epi32(odd, _MM_SHUFFLE(0, 0, 2, 0))
+			);
+		}
+
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type slli(const type a) noexcept
+			{ return _mm_slli_epi32(a, shift); }
+		template<uint8_t shift> MIX_KERNEL_TARGET static inline type srai(const type a) noexcept
+			{ return _mm_srai_epi32(a, shift); }
+
+		// SSE2 has no 32-bit min/max, so saturate through a pack to 16-bit and sign extend back out
+		MIX_KERNEL_TARGET static inline type clamp16(const type a) noexcept
+			{ return _mm_srai_epi32(_mm_unpacklo_epi16(_mm_setzero_si128(), _mm_packs_epi32(a, a)), 16); }
+
+		MIX_KERNEL_TARGET static inline type ramp(const uint32_t base, const int32_t step) noexcept
+		{
+			return add(set1(static_cast<int32_t>(base)),
+				mullo(set1(step), _mm_setr_epi32(1, 2, 3, 4)));
+		}
+
+		MIX_KERNEL_TARGET static inline void accumulate(int32_t *const buffer, const type right,
+			const type left) noexcept
+		{
+			auto *const result{reinterpret_cast<__m128i *>(buffer)};
+			_mm_storeu_si128(result + 0, _mm_add_epi32(_mm_loadu_si128(result + 0), _mm_unpacklo_epi32(right, left)));
+			_mm_storeu_si128(result + 1, _mm_add_epi32(_mm_loadu_si128(result + 1), _mm_unpackhi_epi32(right, left)));
+		}
+	};
+} // namespace
+
+void sse2MixKernels(mixKernelTable_t &kernels) noexcept { fillMixKernels<sse2Vec_t>(kernels); }
+#endif
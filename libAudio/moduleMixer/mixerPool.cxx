@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <substrate/utility>
+#include "mixerPool.hxx"
+
+using substrate::make_unique_nothrow;
+
+/*!
+ * @internal
+ * Constructs a pool that mixes using \p threadCount threads in total. The thread
+ * that calls \c mix() always takes part, so \p threadCount - 1 background threads are started
+ * @param threadCount The total number of threads to mix with
+ */
+mixerPool_t::mixerPool_t(const size_t threadCount) : workers{make_unique_nothrow<worker_t []>(threadCount)},
+	workerCount{workers ? threadCount : 0U}
+{
+	if (!workers)
+		return;
+	try
+	{
+		threads.reserve(workerCount - 1U);
+		for (size_t i{1U}; i < workerCount; ++i)
+			threads.emplace_back([this, i]() noexcept { workerThread(workers[i]); });
+	}
+	catch (...)
+	{
+		// Make sure any threads that did start are stopped before we unwind
+		shutdown();
+		throw;
+	}
+}
+
+mixerPool_t::~mixerPool_t() noexcept { shutdown(); }
+
+void mixerPool_t::shutdown() noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard{lock};
+		terminate = true;
+	}
+	workReady.notify_all();
+	for (auto &thread : threads)
+		thread.join();
+	threads.clear();
+}
+
+void mixerPool_t::workerThread(worker_t &worker) noexcept
+{
+	uint64_t lastGeneration{0U};
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> guard{lock};
+			workReady.wait(guard, [&]() noexcept { return terminate || generation != lastGeneration; });
+			if (terminate)
+				return;
+			lastGeneration = generation;
+		}
+		runJob(worker);
+		{
+			std::lock_guard<std::mutex> guard{lock};
+			--pending;
+		}
+		workDone.notify_one();
+	}
+}
+
+/*!
+ * @internal
+ * Claims channels from the shared queue one at a time until none are left,
+ * mixing each into the worker's private buffer
+ */
+void mixerPool_t::runJob(worker_t &worker) noexcept
+{
+	worker.dcOffsL = 0;
+	worker.dcOffsR = 0;
+	worker.mixed = false;
+	auto &mod{*module};
+	for (auto i{nextChannel.fetch_add(1U, std::memory_order_relaxed)}; i < mod.nMixerChannels;
+		i = nextChannel.fetch_add(1U, std::memory_order_relaxed))
+	{
+		auto &channel{mod.Channels[mod.MixerChannels[i]]};
+		if (channel.SampleData == nullptr)
+			continue;
+		if (!worker.mixed)
+		{
+			std::fill_n(worker.buffer.begin(), count * 2U, 0);
+			worker.mixed = true;
+		}
+		mod.mixChannel(channel, worker.buffer.data(), count, worker.dcOffsL, worker.dcOffsR);
+	}
+}
+
+/*!
+ * @internal
+ * Mixes \p samples samples of all the active channels of \p mod, adding the result
+ * into the module's mix buffer exactly as \c ModuleFile::CreateStereoMix() would
+ */
+void mixerPool_t::mix(ModuleFile &mod, const uint32_t samples) noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard{lock};
+		module = &mod;
+		count = samples;
+		nextChannel.store(0U, std::memory_order_relaxed);
+		pending = threads.size();
+		++generation;
+	}
+	workReady.notify_all();
+	// Take part in the mixing on this thread too, rather than just sleeping till the workers are done
+	runJob(workers[0]);
+	{
+		std::unique_lock<std::mutex> guard{lock};
+		workDone.wait(guard, [this]() noexcept { return pending == 0U; });
+	}
+
+	// Reduce the private buffers into the module's. Written as a plain elementwise
+	// loop so the compiler is free to vectorise it.
+	auto *const mixBuffer{mod.MixBuffer};
+	const size_t length{samples * 2U};
+	for (size_t i{0U}; i < workerCount; ++i)
+	{
+		const auto &worker{workers[i]};
+		if (!worker.mixed)
+			continue;
+		const auto *const buffer{worker.buffer.data()};
+		for (size_t j{0U}; j < length; ++j)
+			mixBuffer[j] += buffer[j];
+		mod.DCOffsL += worker.dcOffsL;
+		mod.DCOffsR += worker.dcOffsR;
+	}
+}
@@ -0,0 +1,70 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef LIBAUDIO_MODULEMIXER_MIXERPOOL_HXX
+#define LIBAUDIO_MODULEMIXER_MIXERPOOL_HXX
+
+#include <cstdint>
+#include <array>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "../genericModule/genericModule.h"
+
+/*!
+ * @internal
+ * A small pool of worker threads used to split a module's active mixer channels across cores.
+ * Each worker mixes the channels it claims into its own private accumulation buffer, and the
+ * results are then summed into the module's mix buffer. As the mixing functions are purely
+ * additive, the result is bit-identical to mixing all the channels serially.
+ */
+struct mixerPool_t final
+{
+public:
+	/*!
+	 * @internal
+	 * The private accumulation state for a single worker
+	 */
+	struct worker_t final
+	{
+		std::array<int32_t, mixBufferSize * 2U> buffer{};
+		int32_t dcOffsL{0};
+		int32_t dcOffsR{0};
+		bool mixed{false};
+	};
+
+private:
+	std::vector<std::thread> threads{};
+	std::unique_ptr<worker_t []> workers;
+	size_t workerCount;
+
+	std::mutex lock{};
+	std::condition_variable workReady{};
+	std::condition_variable workDone{};
+	uint64_t generation{0U};
+	size_t pending{0U};
+	bool terminate{false};
+
+	ModuleFile *module{nullptr};
+	uint32_t count{0U};
+	std::atomic<uint32_t> nextChannel{0U};
+
+	void shutdown() noexcept;
+	void workerThread(worker_t &worker) noexcept;
+	void runJob(worker_t &worker) noexcept;
+
+public:
+	mixerPool_t(size_t threadCount);
+	mixerPool_t(const mixerPool_t &) = delete;
+	mixerPool_t(mixerPool_t &&) = delete;
+	~mixerPool_t() noexcept;
+	mixerPool_t &operator =(const mixerPool_t &) = delete;
+	mixerPool_t &operator =(mixerPool_t &&) = delete;
+
+	[[nodiscard]] size_t threadCount() const noexcept { return workerCount; }
+	void mix(ModuleFile &mod, uint32_t samples) noexcept;
+};
+
+#endif /*LIBAUDIO_MODULEMIXER_MIXERPOOL_HXX*/
@@ -11,6 +11,7 @@
 #include "../console.hxx"
 
 #include "moduleMixer.h"
+#include "mixerPool.hxx"
 #include "mixFunctions.h"
 #include "mixFunctionTables.h"
 #include "frequencyTables.h"
@@ -34,6 +35,9 @@ uint32_t Convert32to16(void *_out, int32_t *_in, uint32_t SampleCount)
 int64_t moduleFile_t::fillBuffer(void *const bufferPtr, const uint32_t length)
 {
 	const auto buffer = static_cast<uint8_t *>(bufferPtr);
+	// Decoding without going through playback must still get the mixer set up
+	if (!decoderCtx->mod->isMixerInitialised())
+		decoderCtx->mod->InitMixer(fileInfo());
 	return decoderCtx->mod->Mix(buffer, length);
 }
 
@@ -75,6 +79,21 @@ void ModuleFile::InitMixer(fileInfo_t &info)
 	loopScanPatterns(info);
 }
 
+/*!
+ * @internal
+ * Works out how long the module plays for without setting up the mixer, for when
+ * only the module's information is wanted
+ */
+void ModuleFile::scanLength(fileInfo_t &info)
+{
+	// Formats that have yet to have their patterns loaded have nothing to scan
+	if (!p_Patterns)
+		return;
+	MusicSpeed = p_Header->InitialSpeed;
+	MusicTempo = p_Header->InitialTempo;
+	loopScanPatterns(info);
+}
+
 channel_t::channel_t() noexcept : SampleData{nullptr}, NewSampleData{nullptr}, Note{}, RampLength{},
 	NewNote{}, NewSample{}, LoopStart{}, LoopEnd{}, Length{}, RawVolume{}, volume{},
 	_sampleVolumeSlide{}, _fineSampleVolumeSlide{}, channelVolume{64}, sampleVolume{},
@@ -1539,69 +1558,154 @@ inline void ModuleFile::DCFixingFill(uint32_t samples)
 	FixDCOffset(&DCOffsL, &DCOffsR, MixBuffer, samples);
 }
 
+bool ModuleFile::resampling(const moduleResampling_t mode) noexcept
+{
+	switch (mode)
+	{
+		case moduleResampling_t::nearest:
+		case moduleResampling_t::linear:
+		case moduleResampling_t::sinc4Tap:
+		case moduleResampling_t::sinc8Tap:
+			resamplingMode = mode;
+			return true;
+	}
+	return false;
+}
+
+/*!
+ * @internal
+ * Gets the MIX_* flags that select the mixing functions for the current resampling mode
+ */
+uint32_t ModuleFile::resamplingFlags() const noexcept
+{
+	switch (resamplingMode)
+	{
+		case moduleResampling_t::linear:
+			return MIX_LINEARSRC;
+		case moduleResampling_t::sinc4Tap:
+			return MIX_HQSRC;
+		case moduleResampling_t::sinc8Tap:
+			return MIX_SINCSRC;
+		default:
+			return MIX_NOSRC;
+	}
+}
+
 void ModuleFile::CreateStereoMix(uint32_t count)
 {
-	/*uint32_t Flags;*/
 	if (count == 0)
 		return;
-	/*Flags = GetResamplingFlag();*/
+	// If there's a worker pool available and there's more than one channel to share
+	// between the workers, fan the mixing out. Otherwise mix everything here.
+	if (mixerPool && nMixerChannels > 1U)
+	{
+		mixerPool->mix(*this, count);
+		return;
+	}
 	for (uint32_t i = 0; i < nMixerChannels; i++)
 	{
-		uint32_t samples = count;
-		int32_t *buff = MixBuffer;
-		channel_t * const channel = &Channels[MixerChannels[i]];
-		if (channel->SampleData == nullptr)
+		channel_t &channel = Channels[MixerChannels[i]];
+		if (channel.SampleData == nullptr)
 			continue;
-		do
+		mixChannel(channel, MixBuffer, count, DCOffsL, DCOffsR);
+	}
+}
+
+/*!
+ * @internal
+ * Mixes \p count samples of a single channel into \p buff, accumulating the DC offset
+ * left behind by the channel should it finish playing into \p dcOffsL and \p dcOffsR.
+ * The channel's contribution is purely added in to \p buff, so channels may be mixed
+ * into separate buffers and summed afterwards without changing the result.
+ */
+void ModuleFile::mixChannel(channel_t &channel, int32_t *buff, uint32_t count, int &dcOffsL, int &dcOffsR)
+{
+	uint32_t samples = count;
+	do
+	{
+		auto rampSamples = samples;
+		if (channel.RampLength > 0)
 		{
-			auto rampSamples = samples;
-			if (channel->RampLength > 0)
-			{
-				if (rampSamples > channel->RampLength)
-					rampSamples = channel->RampLength;
-			}
-			const auto SampleCount = channel->GetSampleCount(rampSamples);
-			if (SampleCount <= 0)
+			if (rampSamples > channel.RampLength)
+				rampSamples = channel.RampLength;
+		}
+		const auto SampleCount = channel.GetSampleCount(rampSamples);
+		if (SampleCount <= 0)
+		{
+			FixDCOffset(&channel.DCOffsL, &channel.DCOffsR, buff, samples);
+			dcOffsL += channel.DCOffsL;
+			dcOffsR += channel.DCOffsR;
+			channel.DCOffsL = channel.DCOffsR = 0;
+			samples = 0;
+			continue;
+		}
+		if (channel.RampLength == 0 && (channel.leftVol | channel.rightVol) == 0)
+			buff += SampleCount * 2;
+		else
+		{
+			const auto mixMode{resamplingFlags() | (channel.RampLength ? MIX_RAMP : 0U) |
+				(channel.Sample->Get16Bit() ? MIX_16BIT : 0U) | (channel.Sample->GetStereo() ? MIX_STEREO : 0U)};
+			int *BuffMax = buff + (SampleCount * 2U);
+			channel.DCOffsR = -((BuffMax - 2U)[0]);
+			channel.DCOffsL = -((BuffMax - 2U)[1]);
+			// Prefer the vectorised kernel for this mode if this machine has one
+			if (const auto kernel{mixKernels()[mixMode]}; kernel)
 			{
-				FixDCOffset(&channel->DCOffsL, &channel->DCOffsR, buff, samples);
-				DCOffsL += channel->DCOffsL;
-				DCOffsR += channel->DCOffsR;
-				channel->DCOffsL = channel->DCOffsR = 0;
-				samples = 0;
-				continue;
+				if (mixMode & MIX_16BIT)
+					kernelLoop<int16_t>(channel, buff, BuffMax, mixMode, kernel);
+				else
+					kernelLoop<int8_t>(channel, buff, BuffMax, mixMode, kernel);
 			}
-			if (channel->RampLength == 0 && (channel->leftVol | channel->rightVol) == 0)
-				buff += SampleCount * 2;
 			else
+				MixFunctionTable[mixMode](&channel, buff, BuffMax);
+			channel.DCOffsR += ((BuffMax - 2U)[0]);
+			channel.DCOffsL += ((BuffMax - 2U)[1]);
+			buff = BuffMax;
+		}
+		samples -= SampleCount;
+		if (channel.RampLength != 0)
+		{
+			channel.RampLength -= static_cast<uint8_t>(SampleCount);
+			if (channel.RampLength <= 0)
 			{
-				MixInterface MixFunc = MixFunctionTable[/*Flags*/MIX_NOSRC | (channel->RampLength ? MIX_RAMP : 0) |
-					(channel->Sample->Get16Bit() ? MIX_16BIT : 0) | (channel->Sample->GetStereo() ? MIX_STEREO : 0)];
-				int *BuffMax = buff + (SampleCount * 2U);
-				channel->DCOffsR = -((BuffMax - 2U)[0]);
-				channel->DCOffsL = -((BuffMax - 2U)[1]);
-				MixFunc(channel, buff, BuffMax);
-				channel->DCOffsR += ((BuffMax - 2U)[0]);
-				channel->DCOffsL += ((BuffMax - 2U)[1]);
-				buff = BuffMax;
-			}
-			samples -= SampleCount;
-			if (channel->RampLength != 0)
-			{
-				channel->RampLength -= static_cast<uint8_t>(SampleCount);
-				if (channel->RampLength <= 0)
-				{
-					channel->RampLength = 0;
-					channel->leftVol = channel->NewLeftVol;
-					channel->rightVol = channel->NewRightVol;
-					channel->LeftRamp = channel->RightRamp = 0;
-					channel->Flags &= ~(CHN_FASTVOLRAMP | CHN_VOLUMERAMP);
-				}
+				channel.RampLength = 0;
+				channel.leftVol = channel.NewLeftVol;
+				channel.rightVol = channel.NewRightVol;
+				channel.LeftRamp = channel.RightRamp = 0;
+				channel.Flags &= ~(CHN_FASTVOLRAMP | CHN_VOLUMERAMP);
 			}
 		}
-		while (samples > 0);
 	}
+	while (samples > 0);
 }
 
+/*!
+ * @internal
+ * Sets how many threads the mixer should use to mix this module's channels.
+ * Passing 0 or 1 returns the mixer to mixing all channels serially on the calling thread.
+ * The output is bit-identical regardless of the number of threads used.
+ * @param threads The total number of threads to mix with, including the calling thread
+ * @return \c true if the requested mode could be set up, otherwise \c false
+ * (in which case the mixer falls back to serial mixing)
+ */
+bool ModuleFile::mixerThreads(const uint32_t threads) noexcept
+{
+	mixerPool.reset();
+	if (threads <= 1U)
+		return true;
+	try { mixerPool = std::make_unique<mixerPool_t>(threads); }
+	catch (const std::exception &) { return false; }
+	if (!mixerPool->threadCount())
+	{
+		mixerPool.reset();
+		return false;
+	}
+	return true;
+}
+
+uint32_t ModuleFile::mixerThreads() const noexcept
+	{ return mixerPool ? static_cast<uint32_t>(mixerPool->threadCount()) : 1U; }
+
 inline void ModuleFile::MonoFromStereo(uint32_t count)
 {
 	for (uint32_t i = 0; i < count; i++)
@@ -0,0 +1,191 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <limits>
+#include <fcntl.h>
+#include <substrate/fd>
+#include <substrate/buffer_utils>
+#include "scanCache.hxx"
+#include "../inputSource.hxx"
+
+/*!
+ * @internal
+ * @file moduleMixer/scanCache.cxx
+ * @brief The implementation of the on-disk module loop scan result cache
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using substrate::fd_t;
+using substrate::buffer_utils::writeLE;
+
+namespace libAudio::scanCache
+{
+	constexpr std::array<char, 8> cacheMagic{{'L', 'A', 'M', 'O', 'D', 'L', 'E', 'N'}};
+	// Each record is the key, the sample count, the effect count and then the effects themselves
+	constexpr size_t recordHeaderLength{sizeof(uint64_t) + sizeof(uint64_t) + sizeof(uint32_t)};
+	constexpr size_t effectLength{sizeof(uint16_t) * 3U};
+
+	// Checks that the file at path is a scan cache, or is empty and so can become one
+	bool validCache(const fd_t &file) noexcept
+	{
+		if (!file.valid())
+			return false;
+		const auto length{file.length()};
+		if (length == 0)
+			return true;
+		std::array<char, 8> magic{};
+		return length != -1 && file.read(magic) && magic == cacheMagic;
+	}
+}
+
+using namespace libAudio::scanCache;
+
+/*!
+ * @internal
+ * Sets the file the cache lives in, creating it if necessary. An empty path turns the cache off.
+ * @return \c true if the cache was set up, otherwise \c false and the previous setting is kept
+ */
+bool scanCache_t::path(const std::string_view path)
+{
+	if (!path.empty())
+	{
+		const fd_t file{std::string{path}.c_str(), O_RDWR | O_CREAT, substrate::normalMode};
+		if (!validCache(file))
+			return false;
+	}
+	std::lock_guard<std::mutex> guard{lock};
+	_path = path;
+	index.reset();
+	return true;
+}
+
+std::string scanCache_t::path()
+{
+	std::lock_guard<std::mutex> guard{lock};
+	return _path;
+}
+
+bool scanCache_t::enabled()
+{
+	std::lock_guard<std::mutex> guard{lock};
+	return !_path.empty();
+}
+
+/*!
+ * @internal
+ * Walks the records in the cache, noting where each key's record starts, stopping at the first
+ * damaged or truncated record. Must be called with the lock held.
+ */
+void scanCache_t::buildIndex()
+{
+	auto &records{index.emplace()};
+	const inputSource_t file{fd_t{_path.c_str(), O_RDONLY | O_NOCTTY}};
+	std::array<char, 8> magic{};
+	if (!file.read(magic) || magic != cacheMagic)
+		return;
+
+	while (true)
+	{
+		const auto offset{file.tell()};
+		uint64_t key{};
+		uint64_t samplesProduced{};
+		uint32_t effectCount{};
+		if (!file.readLE(key) || !file.readLE(samplesProduced) || !file.readLE(effectCount) ||
+			uint64_t{effectCount} * effectLength > uint64_t(file.length() - file.tell()))
+			return;
+		// Keep the first record for a key, the same as a straight search of the file would find
+		records.emplace(key, offset);
+		file.seekRel(off_t(effectCount * effectLength));
+	}
+}
+
+/*!
+ * @internal
+ * Looks up the scan result stored under \p key
+ * @return The stored result, or \c std::nullopt if there is none
+ */
+std::optional<scanResult_t> scanCache_t::find(const uint64_t key)
+{
+	std::lock_guard<std::mutex> guard{lock};
+	if (_path.empty())
+		return std::nullopt;
+	if (!index)
+		buildIndex();
+	const auto record{index->find(key)};
+	if (record == index->end())
+		return std::nullopt;
+
+	const fd_t file{_path.c_str(), O_RDONLY | O_NOCTTY};
+	uint64_t recordKey{};
+	uint64_t samplesProduced{};
+	uint32_t effectCount{};
+	// The file could have been damaged since it was indexed, so check the record is still intact
+	if (file.seek(record->second, SEEK_SET) != record->second || !file.readLE(recordKey) ||
+		!file.readLE(samplesProduced) || !file.readLE(effectCount) || recordKey != key ||
+		uint64_t{effectCount} * effectLength > uint64_t(file.length() - file.tell()))
+		return std::nullopt;
+
+	scanResult_t result{samplesProduced, {}};
+	result.disabledEffects.reserve(effectCount);
+	for (uint32_t i{0U}; i < effectCount; ++i)
+	{
+		disabledEffect_t effect{};
+		if (!file.readLE(effect.pattern) || !file.readLE(effect.row) || !file.readLE(effect.channel))
+			return std::nullopt;
+		result.disabledEffects.emplace_back(effect);
+	}
+	return result;
+}
+
+/*!
+ * @internal
+ * Appends \p result to the cache under \p key. The record is written in one go so a
+ * failure part way through can at worst leave a truncated record at the end of the file.
+ * @return \c true if the result was stored, otherwise \c false
+ */
+bool scanCache_t::store(const uint64_t key, const scanResult_t &result)
+{
+	const auto effectCount{result.disabledEffects.size()};
+	if (effectCount > std::numeric_limits<uint32_t>::max())
+		return false;
+	std::vector<uint8_t> record(recordHeaderLength + (effectCount * effectLength));
+	auto *data{record.data()};
+	writeLE(key, data);
+	writeLE(result.samplesProduced, data + 8U);
+	writeLE(uint32_t(effectCount), data + 16U);
+	data += recordHeaderLength;
+	for (const auto &effect : result.disabledEffects)
+	{
+		writeLE(effect.pattern, data);
+		writeLE(effect.row, data + 2U);
+		writeLE(effect.channel, data + 4U);
+		data += effectLength;
+	}
+
+	// Hold the lock while writing so records from concurrent opens can't interleave
+	std::lock_guard<std::mutex> guard{lock};
+	if (_path.empty())
+		return false;
+	const fd_t file{_path.c_str(), O_WRONLY | O_CREAT | O_APPEND, substrate::normalMode};
+	if (!file.valid())
+		return false;
+	if (file.length() == 0 && !file.write(cacheMagic))
+		return false;
+	if (!file.write(record.data(), record.size()))
+		return false;
+	// Appending leaves the file positioned just after the record, wherever that turned out to be
+	if (index)
+		index->emplace(key, file.tell() - off_t(record.size()));
+	return true;
+}
+
+/*!
+ * @internal
+ * The process-wide scan cache, which is off until given a path to use
+ */
+scanCache_t &scanCache() noexcept
+{
+	static scanCache_t cache{};
+	return cache;
+}
@@ -0,0 +1,92 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef LIBAUDIO_MODULEMIXER_SCANCACHE_HXX
+#define LIBAUDIO_MODULEMIXER_SCANCACHE_HXX
+
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <string_view>
+#include <type_traits>
+#include <unordered_map>
+#include <vector>
+#include <sys/types.h>
+
+/*!
+ * @internal
+ * A navigation effect (pattern break or position jump) that the loop scanner disabled,
+ * identified by where it lives in the pattern data
+ */
+struct disabledEffect_t final
+{
+	uint16_t pattern;
+	uint16_t row;
+	uint16_t channel;
+};
+
+/*!
+ * @internal
+ * The result of scanning a module for loops - how long it plays for, and which of its
+ * navigation effects have to be disabled to stop it looping
+ */
+struct scanResult_t final
+{
+	uint64_t samplesProduced{};
+	std::vector<disabledEffect_t> disabledEffects{};
+};
+
+/*!
+ * @internal
+ * 64-bit FNV-1a, used to key the scan cache on all the data the loop scan depends on
+ */
+struct scanHash_t final
+{
+private:
+	uint64_t _value{0xcbf29ce484222325U};
+
+public:
+	template<typename T> void update(const T value) noexcept
+	{
+		static_assert(std::is_integral_v<T>, "Only integers can be hashed");
+		auto data{static_cast<std::make_unsigned_t<T>>(value)};
+		// Hash the value in little endian byte order so keys are the same on every platform
+		for (size_t i{0U}; i < sizeof(T); ++i)
+		{
+			_value = (_value ^ uint8_t(data)) * 0x100000001b3U;
+			data = static_cast<decltype(data)>(data >> 8U);
+		}
+	}
+
+	[[nodiscard]] uint64_t value() const noexcept { return _value; }
+};
+
+/*!
+ * @internal
+ * An optional on-disk cache of loop scan results, so modules that have been opened before
+ * don't have to have their entire song simulated again just to find out how long they are.
+ *
+ * The cache is an append-only file of little endian records, each holding the key, the
+ * length in samples and the list of disabled effects. The first lookup indexes where each
+ * key's record is, and records this cache stores are added to that index as they're written.
+ */
+struct scanCache_t final
+{
+private:
+	std::mutex lock{};
+	std::string _path{};
+	std::optional<std::unordered_map<uint64_t, off_t>> index{};
+
+	void buildIndex();
+
+public:
+	[[nodiscard]] bool path(std::string_view path);
+	[[nodiscard]] std::string path();
+	[[nodiscard]] bool enabled();
+	[[nodiscard]] std::optional<scanResult_t> find(uint64_t key);
+	bool store(uint64_t key, const scanResult_t &result);
+};
+
+scanCache_t &scanCache() noexcept;
+
+#endif /*LIBAUDIO_MODULEMIXER_SCANCACHE_HXX*/
@@ -35,9 +35,9 @@ struct mp3_t::decoderContext_t final
 	mad_synth synth;
 	/*!
 	 * @internal
-	 * The internal input data buffer
+	 * The final partial span of MP3 data, copied out of the file so it can be padded for libMAD
 	 */
-	std::array<uint8_t, 8192> inputBuffer;
+	std::array<uint8_t, 8192 + MAD_BUFFER_GUARD> finalData;
 	/*!
 	 * @internal
 	 * The internal decoded data buffer
@@ -54,17 +54,36 @@ struct mp3_t::decoderContext_t final
 	 * the current values stored in buffer
 	 */
 	uint16_t samplesUsed;
+	/*!
+	 * @internal
+	 * A flag indicating if libMAD has been handed the final, padded, span of data
+	 */
+	bool finalBlock;
 	/*!
 	 * @internal
 	 * The end-of-file flag
 	 */
 	bool eof;
-
+	/*!
+	 * @internal
+	 * The byte offset of the first MP3 frame in the file (just past any ID3 tag)
+	 */
+	substrate::off_t dataOffset;
+	/*!
+	 * @internal
+	 * @var uint64_t samplePosition
+	 * The sample frame that the next sample output corresponds to
+	 * @var uint64_t totalSamples
+	 * The total number of sample frames in the stream, or an estimate of it
+	 */
+	uint64_t samplePosition, totalSamples;
 	decoderContext_t() noexcept;
 	~decoderContext_t() noexcept;
-	libAUDIO_NO_DISCARD(bool readData(const fd_t &fd) noexcept);
-	libAUDIO_NO_DISCARD(int32_t decodeFrame(const fd_t &fd) noexcept);
+	libAUDIO_NO_DISCARD(bool readData(const inputSource_t &file) noexcept);
+	libAUDIO_NO_DISCARD(int32_t decodeFrame(const inputSource_t &file) noexcept);
+	libAUDIO_NO_DISCARD(int32_t skipFrame(const inputSource_t &file) noexcept);
 	libAUDIO_NO_DISCARD(uint32_t parseXingHeader() noexcept);
+	libAUDIO_NO_DISCARD(bool restart(const inputSource_t &file) noexcept);
 };
 
 /*!
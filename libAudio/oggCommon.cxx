@@ -34,11 +34,12 @@ inline bool oggCleanup(ogg_sync_state &syncState, ogg_stream_state &streamState)
 }
 
 bool isOgg(const int32_t fd, ogg_packet &headerPacket) noexcept
+	{ return isOgg(audioProbe_t{fd}, headerPacket); }
+
+bool isOgg(const audioProbe_t &probe, ogg_packet &headerPacket) noexcept
 {
 	std::array<unsigned char, 79> header{};
-	if (fd == -1 ||
-		static_cast<size_t>(read(fd, header.data(), uint32_t(header.size()))) != header.size() ||
-		lseek(fd, 0, SEEK_SET) != 0 ||
+	if (!probe.read(0, header) ||
 		!std::equal(oggMagic.begin(), oggMagic.end(), header.cbegin()))
 		return false;
 	// The following rash of call puke pulls apart the first Ogg page we
@@ -4,8 +4,10 @@
 #define OGG_COMMON_HXX
 
 #include <ogg/ogg.h>
+#include "probe.hxx"
 
 bool isOgg(const int32_t fd, ogg_packet &headerPacket) noexcept;
+bool isOgg(const audioProbe_t &probe, ogg_packet &headerPacket) noexcept;
 bool isVorbis(ogg_packet &headerPacket) noexcept;
 bool isFLAC(ogg_packet &headerPacket) noexcept;
 bool isOpus(ogg_packet &headerPacket) noexcept;
@@ -114,6 +114,13 @@ int alSource_t::queuedBuffers() const noexcept
 	return result;
 }
 
+int alSource_t::sampleOffset() const noexcept
+{
+	int result = 0;
+	al::alGetSourcei(source, AL_SAMPLE_OFFSET, &result);
+	return result;
+}
+
 int alSource_t::state() const noexcept
 {
 	int result = 0;
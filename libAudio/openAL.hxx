@@ -66,6 +66,7 @@ public:
 	void stop() const noexcept;
 	int processedBuffers() const noexcept;
 	int queuedBuffers() const noexcept;
+	int sampleOffset() const noexcept;
 	int state() const noexcept;
 	void level(const float gain) const noexcept;
 
@@ -7,12 +7,15 @@
 #include "openALPlayback.hxx"
 
 openALPlayback_t::openALPlayback_t(playback_t &_player) : audioPlayer_t{_player},
-	context{alContext_t::ensure()}, source{}, buffers{{}}, bufferFormat{format()},
-	eof{false}, playerThread{} { }
+	context{alContext_t::ensure()}, source{}, buffers{}, bufferFormat{format()},
+	eof{false}, starved{false}, playerThread{}, stateChanged{} { }
 
 openALPlayback_t::~openALPlayback_t()
 {
 	stop();
+	// If playback ran to the end on its own in async mode, the thread still needs reaping
+	if (playerThread.joinable())
+		playerThread.join();
 	auto queued = std::count_if(buffers.begin(), buffers.end(),
 		[](const alBuffer_t &buffer) { return buffer.isQueued(); });
 	while (queued--)
@@ -21,37 +24,47 @@ openALPlayback_t::~openALPlayback_t()
 
 bool openALPlayback_t::fillBuffer(alBuffer_t &_buffer) noexcept
 {
-	const int64_t result = refillBuffer();
-	if (result > 0)
+	const auto *const block{nextBlock()};
+	if (!block)
 	{
-		_buffer.fill(buffer(), uint32_t(result), bufferFormat, bitRate());
-		source.queue(_buffer);
-		eof = uint32_t(result) < bufferLength();
+		// The decoder thread has fallen behind, count this once per stall and try again next time round
+		if (!starved)
+			decoderUnderrun();
+		starved = true;
+		return false;
 	}
-	else
+	starved = false;
+	// Leave the end-of-stream block in the ring so any later play() also sees it
+	if (block->length <= 0)
+	{
 		eof = true;
-	return result > 0;
+		return false;
+	}
+	_buffer.fill(block->data.get(), uint32_t(block->length), bufferFormat, bitRate());
+	releaseBlock();
+	source.queue(_buffer);
+	return true;
 }
 
 ALenum openALPlayback_t::format() const noexcept
 {
-	const uint8_t bits = bitsPerSample();
 	const uint8_t _channels = channels();
-	if (bits == 8)
-	{
-		if (_channels == 1)
-			return AL_FORMAT_MONO8;
-		else if (_channels == 2)
-			return AL_FORMAT_STEREO8;
-	}
-	else if (bits == 16)
+	if (_channels != 1 && _channels != 2)
+		return 0;
+	switch (sampleFormat())
 	{
-		if (_channels == 1)
-			return AL_FORMAT_MONO16;
-		else if (_channels == 2)
-			return AL_FORMAT_STEREO16;
+		case sampleFormat_t::int8:
+			return _channels == 1 ? AL_FORMAT_MONO8 : AL_FORMAT_STEREO8;
+		case sampleFormat_t::int16:
+			return _channels == 1 ? AL_FORMAT_MONO16 : AL_FORMAT_STEREO16;
+		// Float output needs the AL_EXT_FLOAT32 extension, whose enumerations have to be looked up at runtime
+		case sampleFormat_t::float32:
+			if (!alIsExtensionPresent("AL_EXT_FLOAT32"))
+				return 0;
+			return alGetEnumValue(_channels == 1 ? "AL_FORMAT_MONO_FLOAT32" : "AL_FORMAT_STEREO_FLOAT32");
+		default:
+			return 0;
 	}
-	return 0;
 }
 
 bool openALPlayback_t::haveQueued() const noexcept
@@ -62,6 +75,13 @@ bool openALPlayback_t::haveQueued() const noexcept
 
 void openALPlayback_t::refill() noexcept
 {
+	// Take back the buffers the source has finished with..
+	for (auto processed{source.processedBuffers()}; processed > 0; --processed) try
+		{ find(source.dequeueOne()).isQueued(false); }
+	catch (std::invalid_argument &error)
+		{ puts(error.what()); }
+
+	// ..and then refill and requeue as many of them as the decoder has audio ready for
 	for (alBuffer_t &buffer : buffers)
 	{
 		if (buffer.isQueued())
@@ -71,21 +91,6 @@ void openALPlayback_t::refill() noexcept
 	}
 }
 
-void openALPlayback_t::refill(const uint32_t count) noexcept
-{
-	for (uint32_t i = 0; i < count; ++i) try
-	{
-		ALuint _buffer = source.dequeueOne();
-		alBuffer_t &buffer = find(_buffer);
-		if (eof)
-			buffer.isQueued(false);
-		else
-			buffer.isQueued(fillBuffer(buffer));
-	}
-	catch (std::invalid_argument &error)
-		{ puts(error.what()); }
-}
-
 alBuffer_t &openALPlayback_t::find(const ALuint _buffer)
 {
 	for (alBuffer_t &buffer : buffers)
@@ -101,6 +106,10 @@ void openALPlayback_t::play()
 	std::unique_lock<std::mutex> lock{stateMutex};
 	if (!isPlaying())
 	{
+		if (playerThread.joinable())
+			playerThread.join();
+		// Mark us playing up front so a stop() or pause() that races the thread starting isn't lost
+		state = playState_t::playing;
 		playerThread = std::thread{[this]() noexcept { player(); }};
 		lock.unlock();
 		if (mode() == playbackMode_t::wait)
@@ -115,8 +124,8 @@ void openALPlayback_t::pause()
 	{
 		state = playState_t::pause;
 		lock.unlock();
-		if (mode() == playbackMode_t::async)
-			playerThread.join();
+		stateChanged.notify_all();
+		waitStopped(lock);
 	}
 }
 
@@ -127,8 +136,8 @@ void openALPlayback_t::stop()
 	{
 		state = playState_t::stop;
 		lock.unlock();
-		if (mode() == playbackMode_t::async)
-			playerThread.join();
+		stateChanged.notify_all();
+		waitStopped(lock);
 	}
 }
 
@@ -141,32 +150,69 @@ void openALPlayback_t::volume(float level) noexcept
 	source.level(level);
 }
 
+/*!
+ * @internal
+ * Works out when the player thread next needs to run, which is half a buffer's worth of time
+ * before the audio queued on the source runs out
+ */
+std::chrono::nanoseconds openALPlayback_t::wakeTime() const noexcept
+{
+	const auto bufferTime{audioPlayer_t::bufferTime()};
+	// Having just refilled, every buffer still queued is yet to finish playing
+	const auto queuedTime{bufferTime * source.queuedBuffers()};
+	const auto rate{bitRate()};
+	const auto playedTime{rate ? std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::seconds{source.sampleOffset()}) / rate : std::chrono::nanoseconds{}};
+	const auto deadline{queuedTime - playedTime - (bufferTime / 2)};
+	// When the queue is all but dry (such as when the decoder is behind) come back round quickly
+	return std::max(deadline, bufferTime / 8);
+}
+
+/*!
+ * @internal
+ * Waits for the player thread to finish with the ring after being told to pause or stop. In wait mode
+ * play() is already joining the thread on another thread, so wait to be told it's done instead.
+ */
+void openALPlayback_t::waitStopped(std::unique_lock<std::mutex> &lock)
+{
+	if (mode() == playbackMode_t::async)
+		playerThread.join();
+	else
+	{
+		lock.lock();
+		stateChanged.wait(lock, [this]() { return state == playState_t::paused || state == playState_t::stopped; });
+	}
+}
+
 void openALPlayback_t::player() noexcept
 {
 	std::unique_lock<std::mutex> lock{stateMutex};
+	if (buffers.empty())
+		buffers = std::vector<alBuffer_t>(bufferCount());
+	// Give the decoder thread a moment to get its first block ready if it's only just started
+	for (uint32_t attempt{0U}; attempt < 8U && isPlaying() && !nextBlock(); ++attempt)
+		stateChanged.wait_for(lock, bufferTime() / 8);
 	refill();
 	if (haveQueued())
-	{
 		source.play();
-		state = playState_t::playing;
-	}
-	lock.unlock();
 
-	while (state == playState_t::playing)
+	while (isPlaying())
 	{
-		const int processed = source.processedBuffers();
-		refill(processed);
+		refill();
 		if (source.state() != AL_PLAYING)
 		{
+			// The source only stops by itself once it has played everything it was given
 			if (haveQueued())
+			{
+				underrun();
 				source.play();
-			else
+			}
+			else if (eof)
 				break;
 		}
-		std::this_thread::sleep_for(sleepTime());
+		stateChanged.wait_for(lock, wakeTime(), [this]() { return !isPlaying(); });
 	}
 
-	lock.lock();
 	if (state == playState_t::pause)
 	{
 		source.pause();
@@ -177,6 +223,7 @@ void openALPlayback_t::player() noexcept
 		source.stop();
 		state = playState_t::stopped;
 	}
+	stateChanged.notify_all();
 }
 
 void audioDefaultLevel(const float level)
@@ -3,8 +3,9 @@
 #ifndef OPEN_AL_PLAYBACK_HXX
 #define OPEN_AL_PLAYBACK_HXX
 
-#include <array>
+#include <vector>
 #include <thread>
+#include <condition_variable>
 #include "playback.hxx"
 #include "openAL.hxx"
 
@@ -13,17 +14,20 @@ struct openALPlayback_t final : audioPlayer_t
 private:
 	alContext_t *context;
 	alSource_t source;
-	std::array<alBuffer_t, 4> buffers;
+	std::vector<alBuffer_t> buffers;
 	ALenum bufferFormat;
 	bool eof;
+	bool starved;
 	std::thread playerThread;
+	std::condition_variable stateChanged;
 
 	bool fillBuffer(alBuffer_t &buffer) noexcept;
 	ALenum format() const noexcept;
 	bool haveQueued() const noexcept;
 	void refill() noexcept;
-	void refill(const uint32_t count) noexcept;
 	alBuffer_t &find(const ALuint buffer);
+	std::chrono::nanoseconds wakeTime() const noexcept;
+	void waitStopped(std::unique_lock<std::mutex> &lock);
 	void player() noexcept;
 
 public:
@@ -1,24 +1,204 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2019-2023 Rachel Mant <git@dragonmux.network>
+#include <map>
+#include "libAudio.hxx"
 #include "playback.hxx"
 #include "openALPlayback.hxx"
+#include "sinkPlayback.hxx"
 
-using player_t = openALPlayback_t;
+using namespace std::literals::string_view_literals;
+using substrate::make_unique_nothrow;
 
-playback_t::playback_t(void *const audioFile_, const fileFillBuffer_t fillBuffer_, uint8_t *const buffer_,
+namespace libAudio::playback
+{
+	std::unique_ptr<audioPlayer_t> openALBackend(playback_t &player, std::string_view)
+		{ return substrate::make_unique<openALPlayback_t>(player); }
+
+	/*!
+	 * @internal
+	 * The registered playback backends, and the specification of the one new players use
+	 */
+	struct backends_t final
+	{
+		std::mutex lock{};
+		std::map<std::string, playerFactory_t, std::less<>> factories
+		{
+			{"openal", openALBackend},
+			{"null", sinkPlayback_t::nullBackend},
+			{"wav", sinkPlayback_t::wavBackend},
+		};
+		std::string defaultBackend{"openal"};
+	};
+
+	// Whether this thread is a playback decoder thread
+	thread_local bool isDecoderThread{false};
+
+	backends_t &registry()
+	{
+		static backends_t backends{};
+		return backends;
+	}
+
+	// Splits a backend specification of the form "name[:argument]"
+	std::pair<std::string_view, std::string_view> splitBackend(const std::string_view backend) noexcept
+	{
+		const auto separator{backend.find(':')};
+		if (separator == std::string_view::npos)
+			return {backend, {}};
+		return {backend.substr(0, separator), backend.substr(separator + 1U)};
+	}
+}
+
+using namespace libAudio::playback;
+
+// The decoder's own buffer is no longer played from directly, only its length is used for sizing the blocks
+playback_t::playback_t(void *const audioFile_, const fileFillBuffer_t fillBuffer_, uint8_t *const,
 	const uint32_t bufferLength_, const fileInfo_t &fileInfo) : audioFile{audioFile_}, fillBuffer{fillBuffer_},
-	buffer{buffer_}, bufferLength{bufferLength_}, bitsPerSample(fileInfo.bitsPerSample()), bitRate{fileInfo.bitRate()},
-	channels{fileInfo.channels()}, sleepTime{}, playbackMode{playbackMode_t::wait},
-	player{substrate::make_unique<player_t>(*this)}
+	bufferLength{bufferLength_}, sampleFormat{fileInfo.sampleFormat()}, bitRate{fileInfo.bitRate()},
+	channels{fileInfo.channels()}, frameLength{uint32_t(channels * fileInfo.bytesPerSample())},
+	playbackMode{playbackMode_t::wait}, player{makePlayer(defaultBackend())} { }
+
+playback_t::~playback_t() noexcept
+{
+	// Stop the output first so nothing is consuming blocks when the decoder goes away
+	player.reset();
+	stopDecoder();
+}
+
+/*!
+ * @internal
+ * Allocates the blocks for the ring if this is the first call to play(), and (re)starts
+ * the decoder thread filling them if it isn't already running
+ * @return \c true if the decoder is running (or has already run to the end of the audio)
+ */
+bool playback_t::startDecoder()
+{
+	if (decoderThread.joinable())
+		return true;
+	// The ring and what's in it outlive the decoder thread being stopped, so only set it up the once
+	if (!ringReady)
+	{
+		if (!ring.resize(prefillBlocks))
+			return false;
+		resetLowWater();
+		for (auto &block : ring.slots())
+		{
+			block.data = make_unique_nothrow<uint8_t []>(bufferLength);
+			if (!block.data)
+				return false;
+		}
+		ringReady = true;
+	}
+	// Once the decoder has reached the end of the audio, there is nothing more for it to do
+	if (decoderDone)
+		return true;
+	decoderThread = std::thread{[this]() noexcept { decoder(); }};
+	return true;
+}
+
+/*!
+ * @internal
+ * Stops the decoder thread and waits for it to finish with the file. Anything
+ * it has already decoded is left in the ring for the output to play later.
+ */
+void playback_t::stopDecoder() noexcept
+{
+	{
+		std::lock_guard<std::mutex> lock{decoderMutex};
+		decoderExit = true;
+	}
+	decoderWake.notify_all();
+	if (decoderThread.joinable())
+		decoderThread.join();
+	decoderExit = false;
+}
+
+/*!
+ * @internal
+ * The decoder thread, which keeps the ring as full as it can until the audio runs out or it's stopped.
+ * The final block carries the end-of-stream (or error) result through to the output.
+ */
+void playback_t::decoder() noexcept
+{
+	isDecoderThread = true;
+	while (!decoderExit)
+	{
+		auto *block{ring.writeSlot()};
+		if (!block)
+		{
+			ringFilled.store(true, std::memory_order_relaxed);
+			producerStalls.fetch_add(1U, std::memory_order_relaxed);
+			std::unique_lock<std::mutex> lock{decoderMutex};
+			decoderWake.wait(lock, [&]() { return (block = ring.writeSlot()) != nullptr || decoderExit; });
+			if (!block)
+				return;
+		}
+		block->length = fillBuffer(audioFile, block->data.get(), bufferLength);
+		const bool done{block->length <= 0};
+		if (done)
+			decoderDone.store(true, std::memory_order_relaxed);
+		ring.commitWrite();
+		if (ring.occupancy() >= prefillBlocks)
+			ringFilled.store(true, std::memory_order_relaxed);
+		{
+			std::lock_guard<std::mutex> lock{decoderMutex};
+		}
+		blockReady.notify_all();
+		if (done)
+			return;
+	}
+}
+
+/*!
+ * @internal
+ * Puts the low water mark back to how it starts out, waiting for the decoder to fill the ring
+ */
+void playback_t::resetLowWater() noexcept
+{
+	ringFilled.store(false, std::memory_order_relaxed);
+	ringLowWater.store(prefillBlocks, std::memory_order_relaxed);
+}
+
+/*!
+ * @internal
+ * Hands the oldest block back to the decoder thread, waking it if it's waiting for space
+ */
+void playback_t::releaseBlock() noexcept
 {
-	std::chrono::seconds bufferSize{bufferLength};
-	bufferSize /= channels * (bitsPerSample / 8);
-	sleepTime = std::chrono::duration_cast<std::chrono::nanoseconds>(bufferSize) / bitRate;
+	ring.commitRead();
+	// The ring starts out empty and drains once the decoder hits the end of the audio, neither of which
+	// say anything about keeping up. Otherwise, only this side ever lowers the mark so it doesn't need a
+	// compare-exchange loop.
+	if (ringFilled.load(std::memory_order_relaxed) && !decoderDone.load(std::memory_order_relaxed))
+	{
+		const auto occupancy{uint32_t(ring.occupancy())};
+		if (occupancy < ringLowWater.load(std::memory_order_relaxed))
+			ringLowWater.store(occupancy, std::memory_order_relaxed);
+	}
+	{
+		std::lock_guard<std::mutex> lock{decoderMutex};
+	}
+	decoderWake.notify_one();
+}
+
+/*!
+ * @internal
+ * Waits up to \p timeout for the decoder thread to produce the next block
+ * @return The block, or \c nullptr if the decoder didn't manage one in time
+ */
+const playbackBlock_t *playback_t::waitForBlock(const std::chrono::nanoseconds timeout) noexcept
+{
+	if (const auto *const block{ring.readSlot()})
+		return block;
+	std::unique_lock<std::mutex> lock{decoderMutex};
+	const playbackBlock_t *block{nullptr};
+	blockReady.wait_for(lock, timeout, [&]() { return (block = ring.readSlot()) != nullptr; });
+	return block;
 }
 
 void playback_t::play()
 {
-	if (audioFile && player)
+	if (audioFile && player && startDecoder())
 		player->play();
 }
 
@@ -32,12 +212,27 @@ void playback_t::stop()
 {
 	if (player)
 		player->stop();
+	// Nothing plays what gets decoded from here on, so don't leave the decoder thread working on the file
+	stopDecoder();
+	// When restarted, the decoder has to fill the ring again before the output draining it says anything
+	resetLowWater();
+}
+
+/*!
+ * Stops playback and throws away whatever the decoder thread had decoded ahead of the output, for when
+ * the file is about to be decoded from elsewhere (such as after a seek). The next play() picks up from
+ * wherever the file's decoding position is by then.
+ */
+void playback_t::flush()
+{
+	stop();
+	// Both sides are stopped, so the ring can be safely emptied
+	ring.reset();
+	decoderDone = false;
 }
 
-int64_t audioPlayer_t::refillBuffer() const noexcept
-	{ return player.refillBuffer(); }
-int64_t playback_t::refillBuffer() noexcept
-	{ return fillBuffer(audioFile, buffer, bufferLength); }
+// Checks if the caller is a playback decoder thread, rather than something decoding a file directly
+bool playback_t::onDecoderThread() noexcept { return isDecoderThread; }
 
 bool playback_t::mode(const playbackMode_t _mode) noexcept
 {
@@ -46,20 +241,159 @@ bool playback_t::mode(const playbackMode_t _mode) noexcept
 	return false;
 }
 
+/*!
+ * Sets how many buffers the output keeps queued and how long each is in bytes.
+ * This can only be changed before playback is first started.
+ * @param count The number of buffers for the output to queue
+ * @param length The length of each buffer, which must be a whole number of sample frames
+ * @return \c true if the new configuration was accepted, otherwise \c false
+ */
+bool playback_t::buffers(const uint32_t count, const uint32_t length) noexcept
+{
+	if (ringReady || !count || !length || !frameLength || length % frameLength)
+		return false;
+	bufferCount = count;
+	bufferLength = length;
+	return true;
+}
+
+/*!
+ * Sets how many blocks of decoded audio the decoder thread may run ahead of the output by,
+ * trading memory against resilience to the decoder stalling. Each block is as long as the
+ * output's buffers. This can only be changed before playback is first started.
+ * @param blocks The depth of the ring between the decoder thread and the output, which must be a power of 2
+ * @return \c true if the new depth was accepted, otherwise \c false
+ */
+bool playback_t::prefill(const uint32_t blocks) noexcept
+{
+	if (ringReady || !blocks || (blocks & (blocks - 1U)))
+		return false;
+	prefillBlocks = blocks;
+	return true;
+}
+
+/*!
+ * @internal
+ * Constructs a player for the backend given by the specification \p backend
+ * @return The new player, or \c nullptr if the backend is unknown or failed to set up
+ */
+std::unique_ptr<audioPlayer_t> playback_t::makePlayer(const std::string_view backend)
+{
+	const auto [name, argument] = splitBackend(backend);
+	auto &backends{registry()};
+	std::unique_lock<std::mutex> lock{backends.lock};
+	const auto factory{backends.factories.find(name)};
+	if (factory == backends.factories.end())
+		return nullptr;
+	const auto makePlayer{factory->second};
+	lock.unlock();
+	return makePlayer(*this, argument);
+}
+
+/*!
+ * Switches this playback over to the backend given by \p backend, which takes the form "name[:argument]".
+ * This can only be changed before playback is first started.
+ * @return \c true if the backend was switched, otherwise \c false and the current backend is kept
+ */
+bool playback_t::backend(const std::string_view backend)
+{
+	if (ringReady)
+		return false;
+	auto newPlayer{makePlayer(backend)};
+	if (!newPlayer)
+		return false;
+	player = std::move(newPlayer);
+	return true;
+}
+
+/*!
+ * Registers (or replaces) the playback backend called \p name
+ * @return \c true if the backend was registered, otherwise \c false
+ */
+bool playback_t::registerBackend(const std::string_view name, const playerFactory_t factory)
+{
+	if (name.empty() || name.find(':') != std::string_view::npos || !factory)
+		return false;
+	auto &backends{registry()};
+	std::lock_guard<std::mutex> lock{backends.lock};
+	backends.factories.insert_or_assign(std::string{name}, factory);
+	return true;
+}
+
+std::vector<std::string> playback_t::backends()
+{
+	auto &backends{registry()};
+	std::lock_guard<std::mutex> lock{backends.lock};
+	std::vector<std::string> result{};
+	result.reserve(backends.factories.size());
+	for (const auto &backend : backends.factories)
+		result.emplace_back(backend.first);
+	return result;
+}
+
+/*!
+ * Sets the backend that playback uses from now on, in the form "name[:argument]". The "wav" backend
+ * is refused here as every file played would truncate and write the same WAV file - pick it per-file
+ * with playback_t::backend() instead.
+ * @return \c true if the backend is known, otherwise \c false and the default is left unchanged
+ */
+bool playback_t::defaultBackend(const std::string_view backend)
+{
+	const auto name{splitBackend(backend).first};
+	if (name == "wav"sv)
+		return false;
+	auto &backends{registry()};
+	std::lock_guard<std::mutex> lock{backends.lock};
+	if (backends.factories.find(name) == backends.factories.end())
+		return false;
+	backends.defaultBackend = backend;
+	return true;
+}
+
+std::string playback_t::defaultBackend()
+{
+	auto &backends{registry()};
+	std::lock_guard<std::mutex> lock{backends.lock};
+	return backends.defaultBackend;
+}
+
+playbackStats_t playback_t::stats() const noexcept
+{
+	return {underruns.load(std::memory_order_relaxed), decoderUnderruns.load(std::memory_order_relaxed),
+		producerStalls.load(std::memory_order_relaxed), prefillBlocks, uint32_t(ring.occupancy()),
+		ringLowWater.load(std::memory_order_relaxed)};
+}
+
 void playback_t::volume(const float level) noexcept
 {
 	if (player)
 		player->volume(level);
 }
 
-uint8_t *audioPlayer_t::buffer() const noexcept { return player.buffer; }
+// Gets the next block to play, or nullptr if the decoder has yet to produce one
+const playbackBlock_t *audioPlayer_t::nextBlock() const noexcept { return player.ring.readSlot(); }
+const playbackBlock_t *audioPlayer_t::waitForBlock(const std::chrono::nanoseconds timeout) const noexcept
+	{ return player.waitForBlock(timeout); }
+void audioPlayer_t::releaseBlock() const noexcept { player.releaseBlock(); }
+uint32_t audioPlayer_t::bufferCount() const noexcept { return player.bufferCount; }
 uint32_t audioPlayer_t::bufferLength() const noexcept { return player.bufferLength; }
-uint8_t audioPlayer_t::bitsPerSample() const noexcept { return player.bitsPerSample; }
+sampleFormat_t audioPlayer_t::sampleFormat() const noexcept { return player.sampleFormat; }
 uint32_t audioPlayer_t::bitRate() const noexcept { return player.bitRate; }
 uint8_t audioPlayer_t::channels() const noexcept { return player.channels; }
-std::chrono::nanoseconds audioPlayer_t::sleepTime() const noexcept { return player.sleepTime; }
 bool audioPlayer_t::isPlaying() const noexcept { return state == playState_t::playing; }
 playbackMode_t audioPlayer_t::mode() const noexcept { return player.playbackMode; }
+void audioPlayer_t::underrun() const noexcept { player.underruns.fetch_add(1U, std::memory_order_relaxed); }
+void audioPlayer_t::decoderUnderrun() const noexcept
+	{ player.decoderUnderruns.fetch_add(1U, std::memory_order_relaxed); }
+
+// How long a full buffer takes to play
+std::chrono::nanoseconds audioPlayer_t::bufferTime() const noexcept
+{
+	if (!player.frameLength || !player.bitRate)
+		return {};
+	const auto frames{player.bufferLength / player.frameLength};
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::seconds{frames}) / player.bitRate;
+}
 
 bool audioPlayer_t::mode(const playbackMode_t _mode) noexcept
 {
@@ -69,3 +403,17 @@ bool audioPlayer_t::mode(const playbackMode_t _mode) noexcept
 		player.playbackMode = _mode;
 	return result;
 }
+
+/*!
+ * Lists the names of the registered playback backends
+ */
+std::vector<std::string> audioPlaybackBackends() { return playback_t::backends(); }
+
+/*!
+ * Sets the backend that playback of subsequently opened files uses. "wav:fileName" is not accepted
+ * here, as every file would write to the same WAV file; use audioFile_t::playbackBackend() for it.
+ * @param backend The backend to use, in the form "name[:argument]"
+ * @return \c true if the backend is known, otherwise \c false and the default is left unchanged
+ */
+bool audioPlaybackBackend(const std::string &backend) { return playback_t::defaultBackend(backend); }
+std::string audioPlaybackBackend() { return playback_t::defaultBackend(); }
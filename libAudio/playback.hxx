@@ -4,10 +4,23 @@
 #define PLAYBACK_HXX
 
 #include <cstdint>
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
+#include <thread>
 #include <chrono>
+#include <string>
+#include <string_view>
+#include <vector>
 #include <substrate/utility>
 #include "fileInfo.hxx"
+#include "spscRing.hxx"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+//  needs to have dll-interface to be used by clients of struct 'playback_t'
+#pragma warning(disable:4251)
+#endif
 
 enum class playState_t : uint8_t
 {
@@ -23,8 +36,54 @@ enum class playbackMode_t : uint8_t
 
 using fileFillBuffer_t = int64_t (*)(void *audioFile, void *const buffer, const uint32_t length);
 
+/*!
+ * A block of decoded audio waiting to be played, along with the result of the fillBuffer() call
+ * that produced it. A block with a length <= 0 marks the end of the audio.
+ */
+struct playbackBlock_t final
+{
+	std::unique_ptr<uint8_t []> data{};
+	int64_t length{0};
+};
+
+/*!
+ * Counters for the times playback failed to keep up with the output, and for how
+ * well the decoder thread is staying ahead of it
+ */
+struct playbackStats_t final
+{
+	/*! How many times the output ran dry mid-playback, which is heard as a gap */
+	uint64_t underruns{0U};
+	/*! How many times a buffer was due a refill but the decoder had nothing ready for it */
+	uint64_t decoderUnderruns{0U};
+	/*!
+	 * How many times the decoder filled the ring and had to wait for the output to free up a block.
+	 * This climbing while the underrun counts stay at 0 is normal, and means the decoder is keeping ahead.
+	 */
+	uint64_t producerStalls{0U};
+	/*! How many blocks the decoder may run ahead of the output by */
+	uint32_t ringDepth{0U};
+	/*! How many decoded blocks are currently waiting to be played */
+	uint32_t ringOccupancy{0U};
+	/*!
+	 * The fewest decoded blocks left waiting after the output took one, since the decoder filled the ring
+	 * after playback started or was last stopped. Until then this is the ring's depth, so the startup
+	 * transient doesn't count against it.
+	 * This staying well above 0 means the ring could be made shallower without risking underruns.
+	 */
+	uint32_t ringLowWater{0U};
+};
+
 struct playback_t;
-struct audioPlayer_t
+struct audioPlayer_t;
+
+/*!
+ * Constructs a playback backend's player for \p player. \p argument is whatever followed
+ * the ':' in the backend specification, such as the file name for the "wav" backend.
+ */
+using playerFactory_t = std::unique_ptr<audioPlayer_t> (*)(playback_t &player, std::string_view argument);
+
+struct libAUDIO_CLS_API audioPlayer_t
 {
 private:
 	playback_t &player;
@@ -35,13 +94,17 @@ protected:
 
 	audioPlayer_t(playback_t &_player) noexcept : player{_player},
 		state{playState_t::stopped}, stateMutex{} { }
-	[[nodiscard]] int64_t refillBuffer() const noexcept;
-	[[nodiscard]] uint8_t *buffer() const noexcept;
+	[[nodiscard]] const playbackBlock_t *nextBlock() const noexcept;
+	[[nodiscard]] const playbackBlock_t *waitForBlock(std::chrono::nanoseconds timeout) const noexcept;
+	void releaseBlock() const noexcept;
+	[[nodiscard]] uint32_t bufferCount() const noexcept;
 	[[nodiscard]] uint32_t bufferLength() const noexcept;
-	[[nodiscard]] uint8_t bitsPerSample() const noexcept;
+	[[nodiscard]] sampleFormat_t sampleFormat() const noexcept;
 	[[nodiscard]] uint32_t bitRate() const noexcept;
 	[[nodiscard]] uint8_t channels() const noexcept;
-	[[nodiscard]] std::chrono::nanoseconds sleepTime() const noexcept;
+	[[nodiscard]] std::chrono::nanoseconds bufferTime() const noexcept;
+	void underrun() const noexcept;
+	void decoderUnderrun() const noexcept;
 	[[nodiscard]] playbackMode_t mode() const noexcept;
 	[[nodiscard]] bool isPlaying() const noexcept;
 
@@ -59,38 +122,76 @@ public:
 	audioPlayer_t &operator =(audioPlayer_t &&) noexcept = delete;
 };
 
-struct playback_t final
+struct libAUDIO_CLS_API playback_t final
 {
 private:
 	void *audioFile;
 	fileFillBuffer_t fillBuffer;
-	uint8_t *buffer;
+	uint32_t bufferCount{4U};
 	uint32_t bufferLength;
-	uint8_t bitsPerSample;
+	// How many blocks the decoder thread may run ahead of the output by
+	uint32_t prefillBlocks{16U};
+	sampleFormat_t sampleFormat;
 	uint32_t bitRate;
 	uint8_t channels;
-	std::chrono::nanoseconds sleepTime;
+	uint32_t frameLength;
 	playbackMode_t playbackMode;
+	spscRing_t<playbackBlock_t> ring{};
+	std::thread decoderThread{};
+	std::mutex decoderMutex{};
+	std::condition_variable decoderWake{};
+	std::condition_variable blockReady{};
+	std::atomic<bool> decoderExit{false};
+	std::atomic<bool> decoderDone{false};
+	std::atomic<uint64_t> underruns{0U};
+	std::atomic<uint64_t> decoderUnderruns{0U};
+	std::atomic<uint64_t> producerStalls{0U};
+	std::atomic<uint32_t> ringLowWater{0U};
+	// Set once the decoder has filled the ring, which is when tracking the low water mark starts
+	std::atomic<bool> ringFilled{false};
+	bool ringReady{false};
 	std::unique_ptr<audioPlayer_t> player;
 
+	bool startDecoder();
+	void stopDecoder() noexcept;
+	void decoder() noexcept;
+	void resetLowWater() noexcept;
+	[[nodiscard]] std::unique_ptr<audioPlayer_t> makePlayer(std::string_view backend);
+
 protected:
-	int64_t refillBuffer() noexcept;
+	[[nodiscard]] const playbackBlock_t *waitForBlock(std::chrono::nanoseconds timeout) noexcept;
+	void releaseBlock() noexcept;
 	friend struct audioPlayer_t;
 
 public:
 	playback_t(void *audioFile, fileFillBuffer_t fillBuffer, uint8_t *buffer,
 		uint32_t bufferLength, const fileInfo_t &fileInfo);
-	playback_t(playback_t &&) noexcept = default;
-	playback_t &operator =(playback_t &&) noexcept = default;
-	~playback_t() noexcept = default;
+	~playback_t() noexcept;
 	bool mode(playbackMode_t mode) noexcept;
+	bool buffers(uint32_t count, uint32_t length) noexcept;
+	bool prefill(uint32_t blocks) noexcept;
+	bool backend(std::string_view backend);
+	[[nodiscard]] playbackStats_t stats() const noexcept;
 	void play();
 	void pause();
 	void stop();
+	void flush();
 	void volume(float level) noexcept;
+	[[nodiscard]] static bool onDecoderThread() noexcept;
+
+	static bool registerBackend(std::string_view name, playerFactory_t factory);
+	[[nodiscard]] static std::vector<std::string> backends();
+	static bool defaultBackend(std::string_view backend);
+	[[nodiscard]] static std::string defaultBackend();
 
 	playback_t(const playback_t &) noexcept = delete;
+	playback_t(playback_t &&) noexcept = delete;
 	playback_t &operator =(const playback_t &) noexcept = delete;
+	playback_t &operator =(playback_t &&) noexcept = delete;
 };
 
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
 #endif /*PLAYBACK_HXX*/
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include "probe.hxx"
+
+/*!
+ * @internal
+ * @file probe.cxx
+ * @brief The implementation of the single-read format detection buffer
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+/*!
+ * @internal
+ * Opens the file given by \p fileName as an input source and views its prefix in place,
+ * retaining the source so it can be handed on to the format loader that recognises it
+ * @param fileName The name of the file to probe
+ */
+audioProbe_t::audioProbe_t(const char *const fileName) noexcept :
+	_source{fd_t{fileName, O_RDONLY | O_NOCTTY}}, _fileName{fileName}, _prefix{_source.view(prefixSize)} { }
+
+/*!
+ * @internal
+ * Views the prefix of the data in \p source in place, retaining the source so it can be
+ * handed on to the format loader that recognises it. Such data has no name to go with it.
+ * @param source The input source to probe
+ */
+audioProbe_t::audioProbe_t(inputSource_t &&source) noexcept : _source{std::move(source)}
+{
+	if (_source.head())
+		_prefix = _source.view(prefixSize);
+}
+
+/*!
+ * @internal
+ * Reads the prefix of the file described by \p fd without taking ownership of it.
+ * The file's possition is returned to the start of the file afterwards
+ * @param fd The descriptor of the file to probe
+ */
+audioProbe_t::audioProbe_t(const int32_t fd) noexcept
+{
+	if (fd == -1 || lseek(fd, 0, SEEK_SET) != 0)
+		return;
+	readPrefix(fd);
+	if (lseek(fd, 0, SEEK_SET) != 0)
+		_prefix = {};
+}
+
+void audioProbe_t::readPrefix(const int32_t fd) noexcept
+{
+	const auto result{::read(fd, _prefixData.data(), _prefixData.size())};
+	_prefix = {_prefixData.data(), result > 0 ? size_t(result) : 0U};
+}
+
+/*!
+ * @internal
+ * Hands the opened file's input source over to the caller, at the start of the file
+ * @return The source this probe was opened on, or an invalid \c inputSource_t if the
+ * probe was constructed without ownership
+ */
+inputSource_t audioProbe_t::takeSource() noexcept
+{
+	// The prefix may be a view into the source, so it goes with it
+	_prefix = {};
+	if (!_source.head())
+		return {};
+	return std::move(_source);
+}
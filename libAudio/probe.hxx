@@ -0,0 +1,77 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef PROBE_HXX
+#define PROBE_HXX
+
+#include <cstdint>
+#include <cstring>
+#include <array>
+#include <substrate/fd>
+#include <substrate/span>
+#include "inputSource.hxx"
+
+using substrate::fd_t;
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+//  needs to have dll-interface to be used by clients of struct 'audioProbe_t'
+#pragma warning(disable:4251)
+#endif
+
+/*!
+ * @internal
+ * Holds the opened file and a view of its leading bytes so that every format's
+ * detection logic can be run against the same in-memory prefix instead of each
+ * format opening, reading and seeking the file for itself
+ */
+struct libAUDIO_CLS_API audioProbe_t final
+{
+private:
+	constexpr static size_t prefixSize{4096U};
+
+	inputSource_t _source{};
+	const char *_fileName{nullptr};
+	std::array<uint8_t, prefixSize> _prefixData{};
+	substrate::span<const uint8_t> _prefix{};
+
+	void readPrefix(int32_t fd) noexcept;
+
+public:
+	explicit audioProbe_t(const char *fileName) noexcept;
+	explicit audioProbe_t(int32_t fd) noexcept;
+	explicit audioProbe_t(inputSource_t &&source) noexcept;
+	audioProbe_t(const audioProbe_t &) = delete;
+	audioProbe_t(audioProbe_t &&) = delete;
+	audioProbe_t &operator =(const audioProbe_t &) = delete;
+	audioProbe_t &operator =(audioProbe_t &&) = delete;
+	~audioProbe_t() noexcept = default;
+
+	[[nodiscard]] bool valid() const noexcept { return !_prefix.empty(); }
+	[[nodiscard]] const char *fileName() const noexcept { return _fileName; }
+	[[nodiscard]] size_t length() const noexcept { return _prefix.size(); }
+	[[nodiscard]] substrate::span<const uint8_t> prefix() const noexcept { return _prefix; }
+	[[nodiscard]] inputSource_t takeSource() noexcept;
+
+	template<typename T, size_t N> [[nodiscard]] bool read(const size_t offset,
+		std::array<T, N> &value) const noexcept
+	{
+		static_assert(sizeof(T) == 1, "Probe reads must be done in terms of bytes");
+		if (offset > _prefix.size() || N > _prefix.size() - offset)
+			return false;
+		std::memcpy(value.data(), _prefix.data() + offset, N);
+		return true;
+	}
+
+	template<typename T, size_t N> [[nodiscard]] bool matches(const size_t offset,
+		const std::array<T, N> &magic) const noexcept
+	{
+		std::array<T, N> value{};
+		return read(offset, value) && value == magic;
+	}
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif /*PROBE_HXX*/
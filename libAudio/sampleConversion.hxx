@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef SAMPLE_CONVERSION_HXX
+#define SAMPLE_CONVERSION_HXX
+
+#include <cstdint>
+#include <algorithm>
+#include <type_traits>
+#include "fileInfo.hxx"
+
+namespace libAudio::sampleConversion
+{
+	template<sampleFormat_t format> struct sampleType_t;
+	template<> struct sampleType_t<sampleFormat_t::int8> { using type = int8_t; };
+	template<> struct sampleType_t<sampleFormat_t::int16> { using type = int16_t; };
+	template<> struct sampleType_t<sampleFormat_t::int24> { using type = int32_t; };
+	template<> struct sampleType_t<sampleFormat_t::int32> { using type = int32_t; };
+	template<> struct sampleType_t<sampleFormat_t::float32> { using type = float; };
+
+	/*!
+	 * @internal
+	 * The type of a single sample in the given output format
+	 */
+	template<sampleFormat_t format> using sample_t = typename sampleType_t<format>::type;
+	template<sampleFormat_t format> using formatConstant_t = std::integral_constant<sampleFormat_t, format>;
+
+	/*!
+	 * @internal
+	 * Converts a sample left justified in a 32-bit integer to the output format given,
+	 * truncating it if the output format is narrower than that
+	 */
+	template<sampleFormat_t format> inline sample_t<format> fromInt32(const int32_t sample) noexcept
+	{
+		if constexpr (format == sampleFormat_t::int8)
+			return int8_t(sample >> 24);
+		else if constexpr (format == sampleFormat_t::int16)
+			return int16_t(sample >> 16);
+		else if constexpr (format == sampleFormat_t::int24)
+			return sample >> 8;
+		else if constexpr (format == sampleFormat_t::int32)
+			return sample;
+		else
+			return float(sample) * (1.0F / 2147483648.0F);
+	}
+
+	/*!
+	 * @internal
+	 * Converts a floating point sample normalised to [-1, 1] to the output format given,
+	 * clipping it to that range first if the output format is an integer one
+	 */
+	template<sampleFormat_t format> inline sample_t<format> fromFloat(const float sample) noexcept
+	{
+		if constexpr (format == sampleFormat_t::float32)
+			return sample;
+		else
+		{
+			const auto value{std::clamp(sample, -1.0F, 1.0F)};
+			if constexpr (format == sampleFormat_t::int8)
+				return int8_t(value * 127.0F);
+			else if constexpr (format == sampleFormat_t::int16)
+				return int16_t(value * 32767.0F);
+			else if constexpr (format == sampleFormat_t::int24)
+				return int32_t(value * 8388607.0F);
+			// INT32_MAX is not representable as a float and rounds up past it, so this has to be done in double
+			else
+				return int32_t(double{value} * 2147483647.0);
+		}
+	}
+
+	/*!
+	 * @internal
+	 * Converts a sample in the format given to floating point, normalised to [-1, 1)
+	 */
+	template<sampleFormat_t format> inline float toFloat(const sample_t<format> sample) noexcept
+	{
+		if constexpr (format == sampleFormat_t::int8)
+			return float(sample) * (1.0F / 128.0F);
+		else if constexpr (format == sampleFormat_t::int16)
+			return float(sample) * (1.0F / 32768.0F);
+		else if constexpr (format == sampleFormat_t::int24)
+			return float(sample) * (1.0F / 8388608.0F);
+		else if constexpr (format == sampleFormat_t::int32)
+			return float(sample) * (1.0F / 2147483648.0F);
+		else
+			return sample;
+	}
+
+	/*!
+	 * @internal
+	 * Calls \p function with a \c std::integral_constant holding the sample format given, which
+	 * lets the decoders select the output loop for the format once per call rather than per sample
+	 */
+	template<typename function_t> inline auto withSampleFormat(const sampleFormat_t format,
+		function_t &&function)
+	{
+		switch (format)
+		{
+			case sampleFormat_t::int8:
+				return function(formatConstant_t<sampleFormat_t::int8>{});
+			case sampleFormat_t::int24:
+				return function(formatConstant_t<sampleFormat_t::int24>{});
+			case sampleFormat_t::int32:
+				return function(formatConstant_t<sampleFormat_t::int32>{});
+			case sampleFormat_t::float32:
+				return function(formatConstant_t<sampleFormat_t::float32>{});
+			default:
+				return function(formatConstant_t<sampleFormat_t::int16>{});
+		}
+	}
+} // namespace libAudio::sampleConversion
+
+#endif /*SAMPLE_CONVERSION_HXX*/
@@ -12,22 +12,29 @@
  * @date 2010-2020
  */
 
+/*!
+ * @internal
+ * Adapts a codec's openW() so that all the writers share the fileOpenW_t signature
+ */
+template<typename file_t> audioFile_t *openWriter(const char *const fileName, const encoderOptions_t &options) noexcept
+	{ return file_t::openW(fileName, options); }
+
 const std::map<uint32_t, fileOpenW_t> writers
 {
 #ifdef ENABLE_VORBIS
-	{AUDIO_OGG_VORBIS, oggVorbisOpenW},
+	{AUDIO_OGG_VORBIS, openWriter<oggVorbis_t>},
 #endif
 #ifdef ENABLE_OPUS
-	{AUDIO_OGG_OPUS, oggOpusOpenW},
+	{AUDIO_OGG_OPUS, openWriter<oggOpus_t>},
 #endif
 #ifdef ENABLE_FLAC
-	{AUDIO_FLAC, flacOpenW},
+	{AUDIO_FLAC, openWriter<flac_t>},
 #endif
 #ifdef ENABLE_M4A
-	{AUDIO_MP4, m4aOpenW},
+	{AUDIO_MP4, openWriter<m4a_t>},
 #endif
 #ifdef ENABLE_MP3
-	{AUDIO_MP3, mp3OpenW},
+	{AUDIO_MP3, openWriter<mp3_t>},
 #endif
 };
 
@@ -41,11 +48,33 @@ const std::map<uint32_t, fileOpenW_t> writers
  * in following releases of the library.
  */
 void *audioOpenW(const char *fileName, uint32_t audioType)
+	{ return audioFile_t::openW(fileName, audioType); }
+
+/*!
+ * This function opens the file given by \c fileName for writing, as \c audioOpenW() does,
+ * but with the encoder tuned by \c options
+ * @param fileName The name of the file to open
+ * @param audioType One of the AUDIO_* constants describing what codec to use for the file
+ * @param options The encoder options to use, or \c NULL to use the encoder's defaults
+ * @return A void pointer to the context of the opened file, or \c NULL if there was an error
+ */
+void *audioOpenWOptions(const char *fileName, uint32_t audioType, const encoderOptions_t *const options)
+	{ return audioFile_t::openW(fileName, audioType, options ? *options : encoderOptions_t{}); }
+
+/*!
+ * Opens the file given by \c fileName for writing with the codec given by \c audioType
+ * @param fileName The name of the file to open
+ * @param audioType One of the AUDIO_* constants describing what codec to use for the file
+ * @param options The encoder options to use, where a default constructed set selects the encoder's defaults
+ * @return The opened file, or \c nullptr if there was an error
+ */
+audioFile_t *audioFile_t::openW(const char *const fileName, const uint32_t audioType,
+	const encoderOptions_t &options) noexcept
 {
 	const auto writer{writers.find(audioType)};
 	if (writer == writers.end())
 		return nullptr;
-	return writer->second(fileName);
+	return writer->second(fileName, options);
 }
 
 /*!
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
 #include "flac.hxx"
 
 /*!
@@ -81,16 +82,16 @@ flac_t::flac_t(fd_t &&fd, audioModeWrite_t) noexcept : audioFile_t{audioType_t::
 flac_t::encoderContext_t::encoderContext_t() noexcept : streamEncoder{FLAC__stream_encoder_new()},
 	encoderBuffer{}, metadata{}
 {
-	FLAC__stream_encoder_set_compression_level(streamEncoder, 4);
 	//FLAC__stream_encoder_set_loose_mid_side_stereo(streamEncoder, true);
 }
 
-flac_t *flac_t::openW(const char *const fileName) noexcept
+flac_t *flac_t::openW(const char *const fileName, const encoderOptions_t &options) noexcept
 {
 	auto file = make_unique_nothrow<flac_t>(fd_t{fileName, O_RDWR | O_CREAT | O_TRUNC, substrate::normalMode},
 		audioModeWrite_t{});
 	if (!file || !file->valid())
 		return nullptr;
+	file->_encoderOptions = options;
 	return file.release();
 }
 
@@ -125,6 +126,20 @@ bool flac_t::fileInfo(const fileInfo_t &info)
 	FLAC__stream_encoder_set_channels(ctx.streamEncoder, info.channels());
 	FLAC__stream_encoder_set_bits_per_sample(ctx.streamEncoder, info.bitsPerSample());
 	FLAC__stream_encoder_set_sample_rate(ctx.streamEncoder, info.bitRate());
+	// FLAC's compression levels run from 0 (fastest) to 8 (smallest)
+	FLAC__stream_encoder_set_compression_level(ctx.streamEncoder,
+		hasOption(AUDIO_OPTION_COMPRESSION_LEVEL) ? std::min<uint32_t>(_encoderOptions.compressionLevel, 8U) : 4U);
+#if FLAC_API_VERSION_CURRENT >= 14
+	// libFLAC 1.5 and newer can spread the frame encoding over several threads
+	if (hasOption(AUDIO_OPTION_THREADS))
+	{
+		const auto status{FLAC__stream_encoder_set_num_threads(ctx.streamEncoder, _encoderOptions.threads)};
+		// A libFLAC built without thread support just encodes on the one thread, but any other refusal is an error
+		if (status != FLAC__STREAM_ENCODER_SET_NUM_THREADS_OK &&
+			status != FLAC__STREAM_ENCODER_SET_NUM_THREADS_NOT_COMPILED_WITH_MULTITHREADING_ENABLED)
+			return false;
+	}
+#endif
 
 	ctx.metadata = {
 		FLAC__metadata_object_new(FLAC__METADATA_TYPE_VORBIS_COMMENT),
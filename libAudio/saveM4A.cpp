@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
 #include "m4a.hxx"
 
 /*!
@@ -111,7 +112,7 @@ m4a_t::m4a_t(fd_t &&fd, audioModeWrite_t) noexcept :
 m4a_t::encoderContext_t::encoderContext_t() : encoder{nullptr}, mp4Stream{nullptr}, track{MP4_INVALID_TRACK_ID},
 	inputSamples{}, outputBytes{}, valid{true} { }
 
-m4a_t *m4a_t::openW(const char *const fileName) noexcept
+m4a_t *m4a_t::openW(const char *const fileName, const encoderOptions_t &options) noexcept
 {
 	auto file
 	{
@@ -123,6 +124,7 @@ m4a_t *m4a_t::openW(const char *const fileName) noexcept
 	};
 	if (!file || !file->valid())
 		return nullptr;
+	file->_encoderOptions = options;
 	auto &ctx = *file->encoderContext();
 
 	ctx.mp4Stream = MP4CreateProvider(fileName, &saveM4A::ioFunctions);
@@ -150,6 +152,9 @@ void *m4aOpenW(const char *fileName) { return m4a_t::openW(fileName); }
 bool m4a_t::fileInfo(const fileInfo_t &info)
 {
 	auto &ctx = *encoderContext();
+	// The requested bitrate gets split across the channels, so there must be at least one
+	if (!info.channels())
+		return false;
 	const MP4Tags *tags = MP4TagsAlloc();
 	if (!tags || info.bitsPerSample() != 16U)
 		return false;
@@ -181,13 +186,23 @@ bool m4a_t::fileInfo(const fileInfo_t &info)
 		return ctx.valid = false;
 	config->inputFormat = FAAC_INPUT_16BIT;
 	config->mpegVersion = MPEG4;
-	config->bitRate = 128000;
+	// FAAC's bitrate is per channel, so split any requested total across the channels
+	if (hasOption(AUDIO_OPTION_BITRATE))
+		config->bitRate = _encoderOptions.bitRate / info.channels();
+	else if (hasOption(AUDIO_OPTION_QUALITY))
+		config->bitRate = 0;
+	else
+		config->bitRate = 128000;
 //	config->bitRate = 64000;
 	config->outputFormat = 0;
 	config->useLfe = config->useTns = config->allowMidside = 0;
 	config->aacObjectType = LOW;//MAIN;
 	config->bandWidth = 0;
-	config->quantqual = 100;
+	// Map quality onto FAAC's quantiser quality range of 10 to 500
+	if (hasOption(AUDIO_OPTION_QUALITY))
+		config->quantqual = 10U + static_cast<unsigned long>(std::clamp(_encoderOptions.quality, 0.F, 1.F) * 490.F);
+	else
+		config->quantqual = 100;
 	if (!faacEncSetConfiguration(ctx.encoder, config))
 		return ctx.valid = false;
 
@@ -1,5 +1,6 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2022-2023 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
 #include "mp3.hxx"
 
 /*!
@@ -14,12 +15,9 @@ using substrate::make_unique_nothrow;
 
 mp3_t::mp3_t(fd_t &&fd, audioModeWrite_t) noexcept : audioFile_t{audioType_t::mp3, std::move(fd)},
 	encoderCtx{make_unique_nothrow<encoderContext_t>()} { }
-mp3_t::encoderContext_t::encoderContext_t() noexcept : encoder{lame_init()}, lameFrameOffset{}
-{
-	lame_set_brate(encoder, 320);
-}
+mp3_t::encoderContext_t::encoderContext_t() noexcept : encoder{lame_init()}, lameFrameOffset{} { }
 
-mp3_t *mp3_t::openW(const char *const fileName) noexcept
+mp3_t *mp3_t::openW(const char *const fileName, const encoderOptions_t &options) noexcept
 {
 	auto file
 	{
@@ -31,6 +29,7 @@ mp3_t *mp3_t::openW(const char *const fileName) noexcept
 	};
 	if (!file || !file->valid())
 		return nullptr;
+	file->_encoderOptions = options;
 	return file.release();
 }
 
@@ -57,6 +56,18 @@ bool mp3_t::fileInfo(const fileInfo_t &info)
 		lame_set_mode(ctx.encoder, MPEG_mode::MONO);
 	else
 		lame_set_mode(ctx.encoder, MPEG_mode::JOINT_STEREO);
+	// Asking for a quality switches to VBR, where LAME's -V scale runs from 0 (best) to 9 (smallest)
+	if (hasOption(AUDIO_OPTION_QUALITY))
+	{
+		lame_set_VBR(ctx.encoder, vbr_default);
+		lame_set_VBR_quality(ctx.encoder, (1.F - std::clamp(_encoderOptions.quality, 0.F, 1.F)) * 9.F);
+	}
+	else
+		lame_set_brate(ctx.encoder, hasOption(AUDIO_OPTION_BITRATE) ?
+			static_cast<int>(_encoderOptions.bitRate / 1000U) : 320);
+	// LAME's -q runs from 0 (slowest, best) to 9 (fastest)
+	if (hasOption(AUDIO_OPTION_COMPRESSION_LEVEL))
+		lame_set_quality(ctx.encoder, std::min<int>(_encoderOptions.compressionLevel, 9));
 
 	id3tag_init(ctx.encoder);
 	if (info.title())
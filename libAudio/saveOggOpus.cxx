@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2021-2023 Rachel Mant <git@dragonmux.network>
 #include <random>
+#include <algorithm>
 #include <limits>
 #include "oggOpus.hxx"
 
@@ -55,12 +56,13 @@ oggOpus_t::oggOpus_t(fd_t &&fd, audioModeWrite_t) noexcept :
 	encoderCtx{make_unique_nothrow<encoderContext_t>()} { }
 oggOpus_t::encoderContext_t::encoderContext_t() noexcept : encoder{} { }
 
-oggOpus_t *oggOpus_t::openW(const char *const fileName) noexcept
+oggOpus_t *oggOpus_t::openW(const char *const fileName, const encoderOptions_t &options) noexcept
 {
 	auto file{make_unique_nothrow<oggOpus_t>(fd_t{fileName, O_RDWR | O_CREAT | O_TRUNC, substrate::normalMode},
 		audioModeWrite_t{})};
 	if (!file || !file->valid())
 		return nullptr;
+	file->_encoderOptions = options;
 	return file.release();
 }
 
@@ -97,6 +99,13 @@ bool oggOpus_t::fileInfo(const fileInfo_t &info)
 		ctx.encoder = nullptr;
 		return false;
 	}
+	if (hasOption(AUDIO_OPTION_BITRATE))
+		result = ope_encoder_ctl(ctx.encoder, OPUS_SET_BITRATE(static_cast<opus_int32>(_encoderOptions.bitRate)));
+	// Opus' complexity runs from 0 (fastest) to 10 (best)
+	if (result == OPE_OK && hasOption(AUDIO_OPTION_COMPLEXITY))
+		result = ope_encoder_ctl(ctx.encoder, OPUS_SET_COMPLEXITY(std::min<opus_int32>(_encoderOptions.complexity, 10)));
+	if (result != OPE_OK)
+		return false;
 	fileInfo() = info;
 	return true;
 }
@@ -1,6 +1,7 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2009-2023 Rachel Mant <git@dragonmux.network>
 #include <random>
+#include <algorithm>
 #include <limits>
 #include "oggVorbis.hxx"
 
@@ -25,7 +26,7 @@ oggVorbis_t::encoderContext_t::encoderContext_t() noexcept : encoderState{}, blo
 	ogg_stream_init(&streamState, randomDev());
 }
 
-oggVorbis_t *oggVorbis_t::openW(const char *const fileName) noexcept
+oggVorbis_t *oggVorbis_t::openW(const char *const fileName, const encoderOptions_t &options) noexcept
 {
 	auto file
 	{
@@ -37,6 +38,7 @@ oggVorbis_t *oggVorbis_t::openW(const char *const fileName) noexcept
 	};
 	if (!file || !file->valid())
 		return nullptr;
+	file->_encoderOptions = options;
 	return file.release();
 }
 
@@ -92,7 +94,19 @@ bool oggVorbis_t::fileInfo(const fileInfo_t &info)
 	auto &ctx = *encoderContext();
 	ogg_packet packetHeader, packetComments, packetMode;
 
-	vorbis_encode_init_vbr(&ctx.vorbisInfo, info.channels(), info.bitRate(), 0.75F);
+	// A bitrate on its own selects ABR, otherwise encode VBR at the requested (or default) quality
+	if (hasOption(AUDIO_OPTION_BITRATE) && !hasOption(AUDIO_OPTION_QUALITY))
+	{
+		if (vorbis_encode_init(&ctx.vorbisInfo, info.channels(), info.bitRate(), -1,
+			static_cast<long>(_encoderOptions.bitRate), -1))
+			return false;
+	}
+	else
+	{
+		const auto quality{hasOption(AUDIO_OPTION_QUALITY) ? std::clamp(_encoderOptions.quality, 0.F, 1.F) : 0.75F};
+		if (vorbis_encode_init_vbr(&ctx.vorbisInfo, info.channels(), info.bitRate(), quality))
+			return false;
+	}
 	vorbis_encode_setup_init(&ctx.vorbisInfo);
 
 	vorbis_analysis_init(&ctx.encoderState, &ctx.vorbisInfo);
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstring>
+#include <string>
+#include <algorithm>
+#include "loader.hxx"
+#include "../string.hxx"
+
+constexpr std::array<char, 4> typePSID{'P', 'S', 'I', 'D'};
+// Offsets of the tune data in v1 and v2+ headers
+constexpr uint16_t headerV1Length{0x76U};
+constexpr uint16_t headerV2Length{0x7cU};
+// The tune has to fit in the C64's memory, plus the optional load address in front of it
+constexpr size_t maxDataLength{65536U + 2U};
+
+// The string fields are Latin-1, so convert them to UTF-8 for the rest of libAudio
+static void readString(const inputSource_t &file, std::unique_ptr<char []> &dst)
+{
+	std::array<uint8_t, 32U> field{};
+	if (!file.read(field))
+		throw std::exception{};
+	std::string result{};
+	for (const auto value : field)
+	{
+		// The field is NUL terminated unless all 32 characters are used
+		if (!value)
+			break;
+		if (value < 0x80U)
+			result += static_cast<char>(value);
+		else
+		{
+			result += static_cast<char>(0xc0U | (value >> 6U));
+			result += static_cast<char>(0x80U | (value & 0x3fU));
+		}
+	}
+	if (!result.empty())
+		copyComment(dst, result.data());
+}
+
+sidLoader_t::sidLoader_t(const inputSource_t &file)
+{
+	std::array<char, 4> magic{};
+	uint16_t version{};
+	uint16_t dataOffset{};
+	if (!file.read(magic) ||
+		magic != typePSID ||
+		!file.readBE(version) ||
+		!file.readBE(dataOffset) ||
+		!file.readBE(_entryPoints.load) ||
+		!file.readBE(_entryPoints.init) ||
+		!file.readBE(_entryPoints.play) ||
+		!file.readBE(_metadata.tuneCount) ||
+		!file.readBE(_metadata.defaultTune) ||
+		!file.readBE(speedFlags) ||
+		version < 1U || version > 4U ||
+		dataOffset < (version == 1U ? headerV1Length : headerV2Length) ||
+		_metadata.tuneCount == 0U)
+		throw std::exception{};
+	readString(file, _metadata.title);
+	readString(file, _metadata.artist);
+	readString(file, _metadata.released);
+
+	_metadata.ntsc = false;
+	_metadata.model = sidModel_t::mos6581;
+	if (version >= 2U)
+	{
+		uint16_t flags{};
+		std::array<uint8_t, 4U> relocationAndSIDs{};
+		if (!file.readBE(flags) ||
+			!file.read(relocationAndSIDs) ||
+			// Bit 0 marks the data as being for Compute!'s Sidplayer rather than machine code
+			(flags & 0x0001U) ||
+			// Second and third SID addresses mean the tune needs more than one
+			relocationAndSIDs[2] || relocationAndSIDs[3])
+			throw std::exception{};
+		// Bits 2-3 give the video standard, and bits 4-5 the SID model the tune was written for
+		_metadata.ntsc = ((flags >> 2U) & 0x03U) == 0x02U;
+		if (((flags >> 4U) & 0x03U) == 0x02U)
+			_metadata.model = sidModel_t::mos8580;
+	}
+	if (_metadata.defaultTune == 0U || _metadata.defaultTune > _metadata.tuneCount)
+		_metadata.defaultTune = 1U;
+
+	// Having read the header, grab the tune data
+	if (file.seek(dataOffset, SEEK_SET) != dataOffset || file.length() <= dataOffset)
+		throw std::exception{};
+	const auto dataLength{static_cast<size_t>(file.length() - dataOffset)};
+	_data.resize(std::min(dataLength, maxDataLength));
+	if (!file.read(_data.data(), _data.size()))
+		throw std::exception{};
+	// A load address of 0 means the data starts with the real one, in little endian
+	if (!_entryPoints.load)
+	{
+		if (_data.size() < 3U)
+			throw std::exception{};
+		_entryPoints.load = static_cast<uint16_t>(_data[0] | (_data[1] << 8U));
+		_data.erase(_data.begin(), _data.begin() + 2);
+	}
+	// An init address of 0 means the tune starts with its init routine
+	if (!_entryPoints.init)
+		_entryPoints.init = _entryPoints.load;
+}
+
+bool sidLoader_t::ciaSpeed(const uint16_t tune) const noexcept
+{
+	// Each tune gets a bit, with tunes beyond 32 all sharing the last
+	const auto bit{std::min<uint16_t>(tune - 1U, 31U)};
+	return speedFlags & (1U << bit);
+}
+
+bool sidLoader_t::copyToRAM(commodore64_t &emulator) const noexcept
+	{ return emulator.copyToRAM(_entryPoints.load, _data); }
@@ -0,0 +1,53 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef SID_LOADER_HXX
+#define SID_LOADER_HXX
+
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include "../inputSource.hxx"
+#include "emulator/commodore64.hxx"
+
+struct sidEntryPoints_t final
+{
+	uint16_t load;
+	uint16_t init;
+	uint16_t play;
+};
+
+struct sidMetadata_t final
+{
+	std::unique_ptr<char []> title;
+	std::unique_ptr<char []> artist;
+	std::unique_ptr<char []> released;
+	uint16_t tuneCount;
+	uint16_t defaultTune;
+	bool ntsc;
+	sidModel_t model;
+};
+
+/*
+ * Reads a PSID file's header and tune data. Only single-SID tunes in 6502 machine code are supported -
+ * RSID tunes, which expect a complete C64 to run on, are not PSIDs and so never get here, while
+ * Compute!'s Sidplayer MUS data and tunes for multiple SIDs are rejected.
+ */
+struct sidLoader_t
+{
+private:
+	sidEntryPoints_t _entryPoints{};
+	sidMetadata_t _metadata{};
+	uint32_t speedFlags{0U};
+	std::vector<uint8_t> _data{};
+
+public:
+	sidLoader_t(const inputSource_t &file);
+	[[nodiscard]] const sidEntryPoints_t &entryPoints() const noexcept { return _entryPoints; }
+	[[nodiscard]] sidMetadata_t &metadata() noexcept { return _metadata; }
+	[[nodiscard]] const sidMetadata_t &metadata() const noexcept { return _metadata; }
+	// Whether the given (1-based) tune is played at the rate of CIA 1 timer A rather than once a frame
+	[[nodiscard]] bool ciaSpeed(uint16_t tune) const noexcept;
+	[[nodiscard]] bool copyToRAM(commodore64_t &emulator) const noexcept;
+};
+
+#endif /*SID_LOADER_HXX*/
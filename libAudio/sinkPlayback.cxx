@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <algorithm>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <fcntl.h>
+#include "sinkPlayback.hxx"
+
+/*!
+ * @internal
+ * @file sinkPlayback.cxx
+ * @brief The implementation of the null and WAV file playback backends
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using namespace std::literals::string_view_literals;
+using substrate::fd_t;
+using substrate::make_unique_nothrow;
+
+namespace libAudio::sinkPlayback
+{
+	constexpr uint32_t headerLength{44U};
+
+	// The size of a sample in the WAV file, where 24-bit samples keep their 32-bit containers
+	constexpr uint16_t sampleBytes(const sampleFormat_t format) noexcept
+	{
+		switch (format)
+		{
+			case sampleFormat_t::int8:
+				return 1U;
+			case sampleFormat_t::int16:
+				return 2U;
+			default:
+				return 4U;
+		}
+	}
+
+	template<typename T, typename convert_t> bool writeConverted(const fd_t &file, const uint8_t *const data,
+		const size_t length, const convert_t convert) noexcept
+	{
+		std::array<T, 1024> buffer{};
+		const auto count{length / sizeof(T)};
+		for (size_t offset{0}; offset < count; offset += buffer.size())
+		{
+			const auto amount{std::min(buffer.size(), count - offset)};
+			std::memcpy(buffer.data(), data + (offset * sizeof(T)), amount * sizeof(T));
+			std::transform(buffer.begin(), buffer.begin() + amount, buffer.begin(), convert);
+			if (!file.write(buffer.data(), amount * sizeof(T)))
+				return false;
+		}
+		return true;
+	}
+}
+
+using namespace libAudio::sinkPlayback;
+
+sinkPlayback_t::sinkPlayback_t(playback_t &_player, const bool _realtime) noexcept : audioPlayer_t{_player},
+	file{}, realtime{_realtime}, eof{false}, starved{false}, dataLength{0U}, playerThread{}, stateChanged{} { }
+
+sinkPlayback_t::sinkPlayback_t(playback_t &_player, fd_t &&_file) noexcept : audioPlayer_t{_player},
+	file{std::move(_file)}, realtime{false}, eof{false}, starved{false}, dataLength{0U}, playerThread{},
+	stateChanged{} { }
+
+sinkPlayback_t::~sinkPlayback_t()
+{
+	stop();
+	if (playerThread.joinable())
+		playerThread.join();
+}
+
+/*!
+ * @internal
+ * Makes a "null" backend player, which discards the audio in realtime, or as fast as
+ * it is decoded when given the argument "fast"
+ */
+std::unique_ptr<audioPlayer_t> sinkPlayback_t::nullBackend(playback_t &player, const std::string_view argument)
+{
+	if (!argument.empty() && argument != "fast"sv)
+		return nullptr;
+	return make_unique_nothrow<sinkPlayback_t>(player, argument.empty());
+}
+
+/*!
+ * @internal
+ * Makes a "wav" backend player, which writes the audio out to the WAV file named by the argument
+ * as fast as it is decoded
+ */
+std::unique_ptr<audioPlayer_t> sinkPlayback_t::wavBackend(playback_t &player, const std::string_view fileName)
+{
+	if (fileName.empty())
+		return nullptr;
+	fd_t file{std::string{fileName}.c_str(), O_WRONLY | O_CREAT | O_TRUNC, substrate::normalMode};
+	if (!file.valid())
+		return nullptr;
+	auto sink{make_unique_nothrow<sinkPlayback_t>(player, std::move(file))};
+	if (!sink || !sink->writeHeader())
+		return nullptr;
+	return sink;
+}
+
+/*!
+ * @internal
+ * Writes the WAV header for the audio written so far, leaving the file positioned at the end of the header
+ */
+bool sinkPlayback_t::writeHeader() const noexcept
+{
+	const auto format{sampleFormat()};
+	const uint16_t channelCount{channels()};
+	const auto blockAlign{uint16_t(channelCount * sampleBytes(format))};
+	const auto length{uint32_t(std::min<uint64_t>(dataLength,
+		std::numeric_limits<uint32_t>::max() - headerLength))};
+	// IEEE float data is format 3, everything else is integer PCM (format 1)
+	const uint16_t formatTag{format == sampleFormat_t::float32 ? uint16_t{3U} : uint16_t{1U}};
+	return file.seek(0, SEEK_SET) == 0 &&
+		file.write("RIFF", 4U) &&
+		file.writeLE(uint32_t(length + headerLength - 8U)) &&
+		file.write("WAVEfmt ", 8U) &&
+		file.writeLE(uint32_t{16U}) &&
+		file.writeLE(formatTag) &&
+		file.writeLE(channelCount) &&
+		file.writeLE(bitRate()) &&
+		file.writeLE(uint32_t(bitRate() * blockAlign)) &&
+		file.writeLE(blockAlign) &&
+		file.writeLE(uint16_t(sampleBytes(format) * 8U)) &&
+		file.write("data", 4U) &&
+		file.writeLE(length);
+}
+
+/*!
+ * @internal
+ * Writes a block of audio to the WAV file, converting it to WAV's representation where that differs
+ */
+bool sinkPlayback_t::write(const playbackBlock_t &block) noexcept
+{
+	const auto length{size_t(block.length)};
+	const auto *const data{block.data.get()};
+	dataLength += length;
+	switch (sampleFormat())
+	{
+		// WAV's 8-bit samples are unsigned
+		case sampleFormat_t::int8:
+			return writeConverted<uint8_t>(file, data, length,
+				[](const uint8_t sample) noexcept { return uint8_t(sample ^ 0x80U); });
+		// And there are no sign extended 24-bit samples, so make these proper 32-bit ones
+		case sampleFormat_t::int24:
+			return writeConverted<int32_t>(file, data, length,
+				[](const int32_t sample) noexcept { return int32_t(uint32_t(sample) << 8U); });
+		default:
+			return file.write(data, length);
+	}
+}
+
+/*!
+ * @internal
+ * Brings the WAV header up to date so the file is valid whenever playback stops
+ */
+void sinkPlayback_t::finalise() noexcept
+{
+	if (writeHeader())
+		file.seek(0, SEEK_END);
+}
+
+/*!
+ * @internal
+ * Gets the next block to consume, waiting a short while for the decoder if it has none ready
+ * @return The block, or \c nullptr if there is still none ready
+ */
+const playbackBlock_t *sinkPlayback_t::nextBlock(std::unique_lock<std::mutex> &lock) noexcept
+{
+	if (const auto *const block{audioPlayer_t::nextBlock()})
+		return block;
+	// Consuming as fast as possible means the decoder is always the bottleneck, so only count realtime stalls
+	if (realtime && !starved)
+	{
+		underrun();
+		decoderUnderrun();
+	}
+	starved = true;
+	// Don't hold the state lock while waiting so pause() and stop() can still get in
+	lock.unlock();
+	const auto *const block{waitForBlock(bufferTime() / 8)};
+	lock.lock();
+	return block;
+}
+
+void sinkPlayback_t::play()
+{
+	std::unique_lock<std::mutex> lock{stateMutex};
+	if (!isPlaying())
+	{
+		if (playerThread.joinable())
+			playerThread.join();
+		state = playState_t::playing;
+		playerThread = std::thread{[this]() noexcept { player(); }};
+		lock.unlock();
+		if (mode() == playbackMode_t::wait)
+			playerThread.join();
+	}
+}
+
+void sinkPlayback_t::pause()
+{
+	std::unique_lock<std::mutex> lock{stateMutex};
+	if (isPlaying())
+	{
+		state = playState_t::pause;
+		lock.unlock();
+		stateChanged.notify_all();
+		waitStopped(lock);
+	}
+}
+
+void sinkPlayback_t::stop()
+{
+	std::unique_lock<std::mutex> lock{stateMutex};
+	if (isPlaying())
+	{
+		state = playState_t::stop;
+		lock.unlock();
+		stateChanged.notify_all();
+		waitStopped(lock);
+	}
+}
+
+/*!
+ * @internal
+ * Waits for the player thread to finish with the ring after being told to pause or stop. In wait mode
+ * play() is already joining the thread on another thread, so wait to be told it's done instead.
+ */
+void sinkPlayback_t::waitStopped(std::unique_lock<std::mutex> &lock)
+{
+	if (mode() == playbackMode_t::async)
+		playerThread.join();
+	else
+	{
+		lock.lock();
+		stateChanged.wait(lock, [this]() { return state == playState_t::paused || state == playState_t::stopped; });
+	}
+}
+
+void sinkPlayback_t::player() noexcept
+{
+	std::unique_lock<std::mutex> lock{stateMutex};
+	// Waiting for the very first block is not a stall
+	starved = true;
+	auto deadline{std::chrono::steady_clock::now()};
+	while (isPlaying() && !eof)
+	{
+		const auto *const block{nextBlock(lock)};
+		if (!block)
+			continue;
+		// Leave the end-of-stream block in the ring so any later play() also sees it
+		if (block->length <= 0)
+		{
+			eof = true;
+			break;
+		}
+		if (file.valid() && !write(*block))
+			break;
+		const auto length{block->length};
+		releaseBlock();
+		if (!realtime)
+			continue;
+		// After a stall, carry on from now as a device would rather than trying to catch up
+		if (starved)
+			deadline = std::chrono::steady_clock::now();
+		starved = false;
+		deadline += bufferTime() * length / bufferLength();
+		stateChanged.wait_until(lock, deadline, [this]() { return !isPlaying(); });
+	}
+	starved = false;
+
+	if (state == playState_t::pause)
+		state = playState_t::paused;
+	else
+		state = playState_t::stopped;
+	if (file.valid())
+		finalise();
+	stateChanged.notify_all();
+}
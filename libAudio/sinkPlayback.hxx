@@ -0,0 +1,54 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef SINK_PLAYBACK_HXX
+#define SINK_PLAYBACK_HXX
+
+#include <thread>
+#include <condition_variable>
+#include <substrate/fd>
+#include "playback.hxx"
+
+/*!
+ * @internal
+ * A playback backend that needs no audio hardware. The audio is either thrown away
+ * (the "null" backend) or written out to a WAV file (the "wav" backend), and is consumed
+ * either in realtime, as a device would, or as fast as the decoder can produce it.
+ * This lets the playback machinery be benchmarked and soak tested on headless machines.
+ */
+struct sinkPlayback_t final : audioPlayer_t
+{
+private:
+	substrate::fd_t file;
+	bool realtime;
+	bool eof;
+	bool starved;
+	uint64_t dataLength;
+	std::thread playerThread;
+	std::condition_variable stateChanged;
+
+	bool writeHeader() const noexcept;
+	bool write(const playbackBlock_t &block) noexcept;
+	void finalise() noexcept;
+	[[nodiscard]] const playbackBlock_t *nextBlock(std::unique_lock<std::mutex> &lock) noexcept;
+	void waitStopped(std::unique_lock<std::mutex> &lock);
+	void player() noexcept;
+
+public:
+	sinkPlayback_t(playback_t &_player, bool realtime) noexcept;
+	sinkPlayback_t(playback_t &_player, substrate::fd_t &&file) noexcept;
+	~sinkPlayback_t() final;
+	void play() final;
+	void pause() final;
+	void stop() final;
+	void volume(float) noexcept final { }
+
+	static std::unique_ptr<audioPlayer_t> nullBackend(playback_t &player, std::string_view argument);
+	static std::unique_ptr<audioPlayer_t> wavBackend(playback_t &player, std::string_view fileName);
+
+	sinkPlayback_t(const sinkPlayback_t &) noexcept = delete;
+	sinkPlayback_t(sinkPlayback_t &&) noexcept = delete;
+	sinkPlayback_t &operator =(const sinkPlayback_t &) noexcept = delete;
+	sinkPlayback_t &operator =(sinkPlayback_t &&) noexcept = delete;
+};
+
+#endif /*SINK_PLAYBACK_HXX*/
@@ -54,7 +54,7 @@ private:
 	uint16_t workingData{};
 
 public:
-	decruncher_t(const fd_t &file, span<uint8_t> data) : crunchedData
+	decruncher_t(const inputSource_t &file, span<uint8_t> data) : crunchedData
 		{
 			[&]()
 			{
@@ -243,7 +243,7 @@ private:
 	}
 };
 
-sndhDecruncher_t::sndhDecruncher_t(const fd_t &file)
+sndhDecruncher_t::sndhDecruncher_t(const inputSource_t &file)
 {
 	std::array<char, 4> icePackMagic;
 	if (!file.read(icePackMagic))
@@ -279,7 +279,7 @@ sndhDecruncher_t::sndhDecruncher_t(const fd_t &file)
 	}
 }
 
-bool sndhDecruncher_t::depack(const fd_t &file) noexcept try
+bool sndhDecruncher_t::depack(const inputSource_t &file) noexcept try
 {
 	decruncher_t decruncher{file, {reinterpret_cast<uint8_t *>(_data.data()), _data.size()}};
 	decruncher.decrunch();
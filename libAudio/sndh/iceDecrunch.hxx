@@ -5,11 +5,10 @@
 
 #include <memory>
 #include <array>
-#include <substrate/fd>
 #include <substrate/fixed_vector>
 #include <substrate/span>
+#include "../inputSource.hxx"
 
-using substrate::fd_t;
 using substrate::fixedVector_t;
 
 struct sndhDecruncher_t final
@@ -18,10 +17,10 @@ private:
 	fixedVector_t<char> _data{};
 	size_t _offset{};
 
-	bool depack(const fd_t &file) noexcept;
+	bool depack(const inputSource_t &file) noexcept;
 
 public:
-	sndhDecruncher_t(const fd_t &file);
+	sndhDecruncher_t(const inputSource_t &file);
 	[[nodiscard]] bool valid() const noexcept { return _data.valid(); }
 
 	size_t seek(const off_t offset, const int32_t whence) noexcept
@@ -37,7 +37,7 @@ template<typename T, size_t sizeA, size_t sizeB> std::enable_if_t<sizeA < sizeB,
 	operator ==(const std::array<T, sizeA> &a, const std::array<T, sizeB> &b) noexcept
 	{ return std::equal(a.begin(), a.end(), b.begin()); }
 
-sndhLoader_t::sndhLoader_t(const fd_t &file) : _data{file}, _entryPoints{}, _metadata{}
+sndhLoader_t::sndhLoader_t(const inputSource_t &file) : _data{file}, _entryPoints{}, _metadata{}
 {
 	std::array<char, 4> magic{};
 	if (!_data.readBE(_entryPoints.init) ||
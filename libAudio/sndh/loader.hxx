@@ -6,12 +6,11 @@
 #include <cstdint>
 #include <memory>
 #include <vector>
-#include <substrate/fd>
 #include <substrate/fixed_vector>
+#include "../inputSource.hxx"
 #include "iceDecrunch.hxx"
 #include "emulator/atariSTe.hxx"
 
-using substrate::fd_t;
 using substrate::fixedVector_t;
 
 struct sndhEntryPoints_t final
@@ -47,7 +46,7 @@ private:
 	bool readMeta();
 
 public:
-	sndhLoader_t(const fd_t &file);
+	sndhLoader_t(const inputSource_t &file);
 	[[nodiscard]] const sndhEntryPoints_t &entryPoints() const noexcept { return _entryPoints; }
 	[[nodiscard]] sndhMetadata_t &metadata() noexcept { return _metadata; }
 	[[nodiscard]] const sndhMetadata_t &metadata() const noexcept { return _metadata; }
@@ -0,0 +1,181 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cmath>
+#include <utility>
+#include "fft.hxx"
+#include "../cpuFeatures.hxx"
+
+/*!
+ * @internal
+ * @file spectrum/fft.cxx
+ * @brief The split-complex real-input FFT used for spectrum analysis, its scalar kernels,
+ * and the runtime selection of the vectorised ones
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+namespace libAudio::spectrum
+{
+	namespace
+	{
+		constexpr double pi{3.14159265358979323846};
+
+		void window(float *const re, float *const im, const float *const samples, const float *const window,
+			const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+			{
+				re[i] = samples[(i * 2U) + 0U] * window[(i * 2U) + 0U];
+				im[i] = samples[(i * 2U) + 1U] * window[(i * 2U) + 1U];
+			}
+		}
+
+		void butterflies(float *const lowerRe, float *const lowerIm, float *const upperRe, float *const upperIm,
+			const float *const twiddleRe, const float *const twiddleIm, const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+			{
+				const float re{upperRe[i] * twiddleRe[i] - upperIm[i] * twiddleIm[i]};
+				const float im{upperRe[i] * twiddleIm[i] + upperIm[i] * twiddleRe[i]};
+				upperRe[i] = lowerRe[i] - re;
+				upperIm[i] = lowerIm[i] - im;
+				lowerRe[i] += re;
+				lowerIm[i] += im;
+			}
+		}
+
+		void power(float *const power, const float *const re, const float *const im, const float *const rotationRe,
+			const float *const rotationIm, const size_t length) noexcept
+		{
+			for (size_t i{1U}; i < length; ++i)
+			{
+				// Split bin i back into the transforms of the even and odd samples, twice over
+				const float evenRe{re[i] + re[length - i]};
+				const float evenIm{im[i] - im[length - i]};
+				const float oddRe{im[i] + im[length - i]};
+				const float oddIm{re[length - i] - re[i]};
+				// Then recombine them as the first pass of a full length transform would
+				const float resultRe{evenRe + oddRe * rotationRe[i] - oddIm * rotationIm[i]};
+				const float resultIm{evenIm + oddRe * rotationIm[i] + oddIm * rotationRe[i]};
+				power[i] = 0.25F * (resultRe * resultRe + resultIm * resultIm);
+			}
+		}
+	} // namespace
+
+	/*!
+	 * @internal
+	 * Gets the table of FFT kernels for this machine. This uses the shared CPU feature
+	 * detection, with AVX2 machines using the SSE2 kernels as the same goes for these as
+	 * for the WMA transform kernels.
+	 */
+	const fftDSP_t &fftDSP() noexcept
+	{
+		static const fftDSP_t dsp{[]() noexcept
+		{
+			fftDSP_t table{window, butterflies, power};
+			switch (cpuISA())
+			{
+#if defined(CPU_FEATURES_X86)
+				case cpuISA_t::avx2:
+				case cpuISA_t::sse2:
+					sse2FFTDSP(table);
+					break;
+#elif defined(CPU_FEATURES_NEON)
+				case cpuISA_t::neon:
+					neonFFTDSP(table);
+					break;
+#endif
+				default:
+					break;
+			}
+			return table;
+		}()};
+		return dsp;
+	}
+
+	realFFT_t::realFFT_t(const size_t fftLength) : length{fftLength}, halfLength{fftLength / 2U},
+		re(halfLength), im(halfLength), twiddleRe(halfLength), twiddleIm(halfLength), rotationRe(halfLength),
+		rotationIm(halfLength), dsp{fftDSP()}
+	{
+		size_t bits{0U};
+		while ((size_t{1U} << bits) < halfLength)
+			++bits;
+		for (size_t i{0U}; i < halfLength; ++i)
+		{
+			size_t reversed{0U};
+			for (size_t bit{0U}; bit < bits; ++bit)
+				reversed |= ((i >> bit) & 1U) << (bits - 1U - bit);
+			if (i < reversed)
+				swaps.emplace_back(uint32_t(i), uint32_t(reversed));
+		}
+
+		// The pass combining pairs of h points uses the h twiddles e^(-i * pi * k / h)
+		for (size_t half{1U}; half < halfLength; half <<= 1U)
+		{
+			for (size_t k{0U}; k < half; ++k)
+			{
+				const double angle{pi * double(k) / double(half)};
+				twiddleRe[half + k] = float(std::cos(angle));
+				twiddleIm[half + k] = float(-std::sin(angle));
+			}
+		}
+
+		for (size_t k{0U}; k < halfLength; ++k)
+		{
+			const double angle{2.0 * pi * double(k) / double(length)};
+			rotationRe[k] = float(std::cos(angle));
+			rotationIm[k] = float(-std::sin(angle));
+		}
+	}
+
+	void realFFT_t::transform(const float *const samples, const float *const window, float *const power) noexcept
+	{
+		// Treat the even samples as the real parts and odd ones as the imaginary of a half length signal
+		dsp.window(re.data(), im.data(), samples, window, halfLength);
+		for (const auto &[first, second] : swaps)
+		{
+			std::swap(re[first], re[second]);
+			std::swap(im[first], im[second]);
+		}
+
+		// The first two passes only twiddle by 1 and -i, so don't need any multiplies
+		for (size_t i{0U}; i < halfLength; i += 2U)
+		{
+			const float upperRe{re[i + 1U]};
+			const float upperIm{im[i + 1U]};
+			re[i + 1U] = re[i] - upperRe;
+			im[i + 1U] = im[i] - upperIm;
+			re[i] += upperRe;
+			im[i] += upperIm;
+		}
+		for (size_t i{0U}; i < halfLength; i += 4U)
+		{
+			const float upperRe{re[i + 2U]};
+			const float upperIm{im[i + 2U]};
+			re[i + 2U] = re[i] - upperRe;
+			im[i + 2U] = im[i] - upperIm;
+			re[i] += upperRe;
+			im[i] += upperIm;
+			// upper * -i swaps the halves over, negating the new imaginary part
+			const float rotatedRe{im[i + 3U]};
+			const float rotatedIm{-re[i + 3U]};
+			re[i + 3U] = re[i + 1U] - rotatedRe;
+			im[i + 3U] = im[i + 1U] - rotatedIm;
+			re[i + 1U] += rotatedRe;
+			im[i + 1U] += rotatedIm;
+		}
+		for (size_t half{4U}; half < halfLength; half <<= 1U)
+		{
+			for (size_t i{0U}; i < halfLength; i += half * 2U)
+				dsp.butterflies(re.data() + i, im.data() + i, re.data() + i + half, im.data() + i + half,
+					twiddleRe.data() + half, twiddleIm.data() + half, half);
+		}
+
+		// DC and Nyquist both come out of the first bin, and are purely real
+		const float dc{re[0U] + im[0U]};
+		const float nyquist{re[0U] - im[0U]};
+		power[0U] = dc * dc;
+		power[halfLength] = nyquist * nyquist;
+		dsp.power(power, re.data(), im.data(), rotationRe.data(), rotationIm.data(), halfLength);
+	}
+} // namespace libAudio::spectrum
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+// A real-input FFT over split-complex buffers, with vectorised kernels selected at runtime
+#ifndef LIBAUDIO_SPECTRUM_FFT_HXX
+#define LIBAUDIO_SPECTRUM_FFT_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace libAudio::spectrum
+{
+	/*!
+	 * @internal
+	 * The table of inner loops the FFT runs through. The data is kept split-complex - real and
+	 * imaginary parts in separate arrays - so each kernel is a straight run over contiguous floats.
+	 * Every kernel copes with any count, finishing off what its vector loop can't do with scalar code.
+	 */
+	struct fftDSP_t final
+	{
+		/*!
+		 * @internal
+		 * Windows \p count pairs of samples, splitting the even ones into \p re and the odd ones into \p im
+		 */
+		void (*window)(float *re, float *im, const float *samples, const float *window, size_t count) noexcept;
+		/*!
+		 * @internal
+		 * One radix-2 pass over \p count pairs: t = upper * twiddle, upper = lower - t, lower += t
+		 */
+		void (*butterflies)(float *lowerRe, float *lowerIm, float *upperRe, float *upperIm,
+			const float *twiddleRe, const float *twiddleIm, size_t count) noexcept;
+		/*!
+		 * @internal
+		 * Unpacks the half-length complex transform of a real signal and computes the power of bins
+		 * 1 through \p length - 1 of the real transform from it, where \p length is the complex length
+		 */
+		void (*power)(float *power, const float *re, const float *im, const float *rotationRe,
+			const float *rotationIm, size_t length) noexcept;
+	};
+
+	void sse2FFTDSP(fftDSP_t &dsp) noexcept;
+	void neonFFTDSP(fftDSP_t &dsp) noexcept;
+
+	[[nodiscard]] const fftDSP_t &fftDSP() noexcept;
+
+	/*!
+	 * @internal
+	 * A windowed FFT of real samples for a fixed power-of-two length. The samples are transformed
+	 * as a complex signal of half the length, which is then unpacked, so all the work is done in
+	 * half-length buffers which, along with the twiddle tables, are allocated once up front.
+	 */
+	struct realFFT_t final
+	{
+	private:
+		size_t length;
+		size_t halfLength;
+		std::vector<float> re;
+		std::vector<float> im;
+		// The pairs of indices the bit-reversal permutation swaps
+		std::vector<std::pair<uint32_t, uint32_t>> swaps{};
+		// The twiddles for the pass combining pairs of h points are found at [h, 2h)
+		std::vector<float> twiddleRe;
+		std::vector<float> twiddleIm;
+		// The rotations that unpack the half-length transform into the real one
+		std::vector<float> rotationRe;
+		std::vector<float> rotationIm;
+		const fftDSP_t &dsp;
+
+	public:
+		realFFT_t(size_t fftLength);
+
+		[[nodiscard]] size_t bins() const noexcept { return halfLength + 1U; }
+		// Transforms length samples multiplied by window, leaving the power in each of the bins() bins in power
+		void transform(const float *samples, const float *window, float *power) noexcept;
+	};
+
+	[[nodiscard]] constexpr inline bool isPowerOfTwo(const size_t value) noexcept
+		{ return value && !(value & (value - 1U)); }
+} // namespace libAudio::spectrum
+
+#endif /*LIBAUDIO_SPECTRUM_FFT_HXX*/
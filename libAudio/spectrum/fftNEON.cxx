@@ -0,0 +1,104 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#include "fft.hxx"
+
+namespace libAudio::spectrum
+{
+	namespace
+	{
+		void window(float *const re, float *const im, const float *const samples, const float *const window,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			// The structure loads split the even and odd samples out for us
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto values{vld2q_f32(samples + (i * 2U))};
+				const auto coefficients{vld2q_f32(window + (i * 2U))};
+				vst1q_f32(re + i, vmulq_f32(values.val[0], coefficients.val[0]));
+				vst1q_f32(im + i, vmulq_f32(values.val[1], coefficients.val[1]));
+			}
+			for (; i < count; ++i)
+			{
+				re[i] = samples[(i * 2U) + 0U] * window[(i * 2U) + 0U];
+				im[i] = samples[(i * 2U) + 1U] * window[(i * 2U) + 1U];
+			}
+		}
+
+		void butterflies(float *const lowerRe, float *const lowerIm, float *const upperRe, float *const upperIm,
+			const float *const twiddleRe, const float *const twiddleIm, const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto valueRe{vld1q_f32(upperRe + i)};
+				const auto valueIm{vld1q_f32(upperIm + i)};
+				const auto coefficientRe{vld1q_f32(twiddleRe + i)};
+				const auto coefficientIm{vld1q_f32(twiddleIm + i)};
+				const auto re{vmlsq_f32(vmulq_f32(valueRe, coefficientRe), valueIm, coefficientIm)};
+				const auto im{vmlaq_f32(vmulq_f32(valueRe, coefficientIm), valueIm, coefficientRe)};
+				const auto baseRe{vld1q_f32(lowerRe + i)};
+				const auto baseIm{vld1q_f32(lowerIm + i)};
+				vst1q_f32(upperRe + i, vsubq_f32(baseRe, re));
+				vst1q_f32(upperIm + i, vsubq_f32(baseIm, im));
+				vst1q_f32(lowerRe + i, vaddq_f32(baseRe, re));
+				vst1q_f32(lowerIm + i, vaddq_f32(baseIm, im));
+			}
+			for (; i < count; ++i)
+			{
+				const float re{upperRe[i] * twiddleRe[i] - upperIm[i] * twiddleIm[i]};
+				const float im{upperRe[i] * twiddleIm[i] + upperIm[i] * twiddleRe[i]};
+				upperRe[i] = lowerRe[i] - re;
+				upperIm[i] = lowerIm[i] - im;
+				lowerRe[i] += re;
+				lowerIm[i] += im;
+			}
+		}
+
+		// Loads the 4 values ending at the one given, in reverse order
+		inline float32x4_t loadReversed(const float *const values) noexcept
+		{
+			const auto result{vrev64q_f32(vld1q_f32(values - 3U))};
+			return vcombine_f32(vget_high_f32(result), vget_low_f32(result));
+		}
+
+		void power(float *const power, const float *const re, const float *const im, const float *const rotationRe,
+			const float *const rotationIm, const size_t length) noexcept
+		{
+			size_t i{1U};
+			for (; i + 4U <= length; i += 4U)
+			{
+				const auto forwardRe{vld1q_f32(re + i)};
+				const auto forwardIm{vld1q_f32(im + i)};
+				const auto reverseRe{loadReversed(re + length - i)};
+				const auto reverseIm{loadReversed(im + length - i)};
+				const auto evenRe{vaddq_f32(forwardRe, reverseRe)};
+				const auto evenIm{vsubq_f32(forwardIm, reverseIm)};
+				const auto oddRe{vaddq_f32(forwardIm, reverseIm)};
+				const auto oddIm{vsubq_f32(reverseRe, forwardRe)};
+				const auto coefficientRe{vld1q_f32(rotationRe + i)};
+				const auto coefficientIm{vld1q_f32(rotationIm + i)};
+				const auto resultRe{vmlsq_f32(vmlaq_f32(evenRe, oddRe, coefficientRe), oddIm, coefficientIm)};
+				const auto resultIm{vmlaq_f32(vmlaq_f32(evenIm, oddRe, coefficientIm), oddIm, coefficientRe)};
+				const auto magnitude{vmlaq_f32(vmulq_f32(resultRe, resultRe), resultIm, resultIm)};
+				vst1q_f32(power + i, vmulq_n_f32(magnitude, 0.25F));
+			}
+			for (; i < length; ++i)
+			{
+				const float evenRe{re[i] + re[length - i]};
+				const float evenIm{im[i] - im[length - i]};
+				const float oddRe{im[i] + im[length - i]};
+				const float oddIm{re[length - i] - re[i]};
+				const float resultRe{evenRe + oddRe * rotationRe[i] - oddIm * rotationIm[i]};
+				const float resultIm{evenIm + oddRe * rotationIm[i] + oddIm * rotationRe[i]};
+				power[i] = 0.25F * (resultRe * resultRe + resultIm * resultIm);
+			}
+		}
+	} // namespace
+
+	void neonFFTDSP(fftDSP_t &dsp) noexcept
+		{ dsp = {window, butterflies, power}; }
+} // namespace libAudio::spectrum
+#endif
@@ -0,0 +1,119 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <emmintrin.h>
+#include "fft.hxx"
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__SSE2__)
+#define FFT_DSP_TARGET __attribute__((target("sse2")))
+#else
+#define FFT_DSP_TARGET
+#endif
+
+namespace libAudio::spectrum
+{
+	namespace
+	{
+		FFT_DSP_TARGET void window(float *const re, float *const im, const float *const samples,
+			const float *const window, const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto first{_mm_mul_ps(_mm_loadu_ps(samples + (i * 2U)), _mm_loadu_ps(window + (i * 2U)))};
+				const auto second
+				{
+					_mm_mul_ps(_mm_loadu_ps(samples + (i * 2U) + 4U), _mm_loadu_ps(window + (i * 2U) + 4U))
+				};
+				_mm_storeu_ps(re + i, _mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0)));
+				_mm_storeu_ps(im + i, _mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1)));
+			}
+			for (; i < count; ++i)
+			{
+				re[i] = samples[(i * 2U) + 0U] * window[(i * 2U) + 0U];
+				im[i] = samples[(i * 2U) + 1U] * window[(i * 2U) + 1U];
+			}
+		}
+
+		FFT_DSP_TARGET void butterflies(float *const lowerRe, float *const lowerIm, float *const upperRe,
+			float *const upperIm, const float *const twiddleRe, const float *const twiddleIm, const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto valueRe{_mm_loadu_ps(upperRe + i)};
+				const auto valueIm{_mm_loadu_ps(upperIm + i)};
+				const auto coefficientRe{_mm_loadu_ps(twiddleRe + i)};
+				const auto coefficientIm{_mm_loadu_ps(twiddleIm + i)};
+				const auto re{_mm_sub_ps(_mm_mul_ps(valueRe, coefficientRe), _mm_mul_ps(valueIm, coefficientIm))};
+				const auto im{_mm_add_ps(_mm_mul_ps(valueRe, coefficientIm), _mm_mul_ps(valueIm, coefficientRe))};
+				const auto baseRe{_mm_loadu_ps(lowerRe + i)};
+				const auto baseIm{_mm_loadu_ps(lowerIm + i)};
+				_mm_storeu_ps(upperRe + i, _mm_sub_ps(baseRe, re));
+				_mm_storeu_ps(upperIm + i, _mm_sub_ps(baseIm, im));
+				_mm_storeu_ps(lowerRe + i, _mm_add_ps(baseRe, re));
+				_mm_storeu_ps(lowerIm + i, _mm_add_ps(baseIm, im));
+			}
+			for (; i < count; ++i)
+			{
+				const float re{upperRe[i] * twiddleRe[i] - upperIm[i] * twiddleIm[i]};
+				const float im{upperRe[i] * twiddleIm[i] + upperIm[i] * twiddleRe[i]};
+				upperRe[i] = lowerRe[i] - re;
+				upperIm[i] = lowerIm[i] - im;
+				lowerRe[i] += re;
+				lowerIm[i] += im;
+			}
+		}
+
+		// Loads the 4 values ending at the one given, in reverse order
+		FFT_DSP_TARGET inline __m128 loadReversed(const float *const values) noexcept
+		{
+			const auto result{_mm_loadu_ps(values - 3U)};
+			return _mm_shuffle_ps(result, result, _MM_SHUFFLE(0, 1, 2, 3));
+		}
+
+		FFT_DSP_TARGET void power(float *const power, const float *const re, const float *const im,
+			const float *const rotationRe, const float *const rotationIm, const size_t length) noexcept
+		{
+			const auto quarter{_mm_set1_ps(0.25F)};
+			size_t i{1U};
+			for (; i + 4U <= length; i += 4U)
+			{
+				const auto forwardRe{_mm_loadu_ps(re + i)};
+				const auto forwardIm{_mm_loadu_ps(im + i)};
+				const auto reverseRe{loadReversed(re + length - i)};
+				const auto reverseIm{loadReversed(im + length - i)};
+				const auto evenRe{_mm_add_ps(forwardRe, reverseRe)};
+				const auto evenIm{_mm_sub_ps(forwardIm, reverseIm)};
+				const auto oddRe{_mm_add_ps(forwardIm, reverseIm)};
+				const auto oddIm{_mm_sub_ps(reverseRe, forwardRe)};
+				const auto coefficientRe{_mm_loadu_ps(rotationRe + i)};
+				const auto coefficientIm{_mm_loadu_ps(rotationIm + i)};
+				const auto resultRe
+				{
+					_mm_add_ps(evenRe, _mm_sub_ps(_mm_mul_ps(oddRe, coefficientRe), _mm_mul_ps(oddIm, coefficientIm)))
+				};
+				const auto resultIm
+				{
+					_mm_add_ps(evenIm, _mm_add_ps(_mm_mul_ps(oddRe, coefficientIm), _mm_mul_ps(oddIm, coefficientRe)))
+				};
+				const auto magnitude{_mm_add_ps(_mm_mul_ps(resultRe, resultRe), _mm_mul_ps(resultIm, resultIm))};
+				_mm_storeu_ps(power + i, _mm_mul_ps(magnitude, quarter));
+			}
+			for (; i < length; ++i)
+			{
+				const float evenRe{re[i] + re[length - i]};
+				const float evenIm{im[i] - im[length - i]};
+				const float oddRe{im[i] + im[length - i]};
+				const float oddIm{re[length - i] - re[i]};
+				const float resultRe{evenRe + oddRe * rotationRe[i] - oddIm * rotationIm[i]};
+				const float resultIm{evenIm + oddRe * rotationIm[i] + oddIm * rotationRe[i]};
+				power[i] = 0.25F * (resultRe * resultRe + resultIm * resultIm);
+			}
+		}
+	} // namespace
+
+	void sse2FFTDSP(fftDSP_t &dsp) noexcept
+		{ dsp = {window, butterflies, power}; }
+} // namespace libAudio::spectrum
+#endif
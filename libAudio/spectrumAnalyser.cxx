@@ -0,0 +1,171 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <cmath>
+#include "spectrumAnalyser.hxx"
+#include "spectrum/fft.hxx"
+#include "sampleConversion.hxx"
+
+/*!
+ * @internal
+ * @file spectrumAnalyser.cxx
+ * @brief The implementation of the streaming spectrum and VU level analyser
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using libAudio::spectrum::realFFT_t;
+using libAudio::spectrum::isPowerOfTwo;
+using namespace libAudio::sampleConversion;
+
+namespace
+{
+	constexpr double pi{3.14159265358979323846};
+	// The smallest power reported, which puts the floor for all the levels at -200dBFS
+	constexpr float minimumPower{1e-20F};
+
+	constexpr uint32_t minimumFFTLength{64U};
+	constexpr uint32_t maximumFFTLength{65536U};
+
+	float toDecibels(const float power) noexcept
+		{ return 10.0F * std::log10(std::max(power, minimumPower)); }
+} // namespace
+
+/*!
+ * Sets up an analyser for PCM in the format described by \p info
+ * @param info The file information describing the sample format, channel count and sample rate of the PCM
+ * @param transformLength The number of samples in each analysis window, which must be a power of two from 64 to 65536
+ * @param hop The number of samples each window starts after the last, which must be from 1 to \p transformLength
+ */
+spectrumAnalyser_t::spectrumAnalyser_t(const fileInfo_t &info, const uint32_t transformLength,
+	const uint32_t hop) : format{info.sampleFormat()}, channels{info.channels()}, sampleRate{info.bitRate()},
+	fftLength{transformLength}, hopLength{hop}
+{
+	if (!isPowerOfTwo(fftLength) || fftLength < minimumFFTLength || fftLength > maximumFFTLength ||
+		!hopLength || hopLength > fftLength || !channels)
+		return;
+
+	// A periodic Hann window, which has a gain of 1/2 that the power scale undoes
+	window.resize(fftLength);
+	double windowSum{0.0};
+	for (size_t i{0U}; i < fftLength; ++i)
+	{
+		window[i] = float(0.5 - (0.5 * std::cos(2.0 * pi * double(i) / double(fftLength))));
+		windowSum += window[i];
+	}
+	// A sine's power is split evenly between its positive and negative frequency bins
+	const double scale{2.0 / windowSum};
+	powerScale = float(scale * scale);
+
+	samples.resize(fftLength);
+	power.resize(bins());
+	magnitudes.resize(bins());
+	peakLevels.resize(channels);
+	sumSquares.resize(channels);
+	peak.resize(channels);
+	rms.resize(channels);
+	block.resize(size_t{hopLength} * channels * info.bytesPerSample());
+	fft = std::make_unique<realFFT_t>(fftLength);
+}
+
+spectrumAnalyser_t::~spectrumAnalyser_t() noexcept = default;
+
+/*!
+ * Checks that the parameters the analyser was set up with were usable
+ * @return \c true if the analyser is ready to accept PCM, otherwise \c false
+ */
+bool spectrumAnalyser_t::valid() const noexcept
+	{ return bool{fft}; }
+
+/*!
+ * Feeds PCM into the analyser, calling \p handler with each frame of analysis it completes
+ * @param pcm The PCM to analyse, interleaved and in the sample format the analyser was set up for
+ * @param length The number of bytes of PCM given, any partial sample frame at the end of which is ignored
+ * @param handler The function to hand each completed frame to
+ */
+void spectrumAnalyser_t::write(const void *const pcm, const size_t length, const frameHandler_t &handler) noexcept
+{
+	if (!valid())
+		return;
+	withSampleFormat(format, [&](const auto sampleFormat)
+	{
+		constexpr auto inputFormat{decltype(sampleFormat)::value};
+		using inputSample_t = sample_t<inputFormat>;
+		const auto *input{static_cast<const inputSample_t *>(pcm)};
+		const size_t frames{length / (sizeof(inputSample_t) * channels)};
+		const float mixScale{1.0F / float(channels)};
+
+		for (size_t frame{0U}; frame < frames; ++frame)
+		{
+			float mix{0.0F};
+			for (uint8_t channel{0U}; channel < channels; ++channel)
+			{
+				const auto sample{toFloat<inputFormat>(*input++)};
+				mix += sample;
+				peakLevels[channel] = std::max(peakLevels[channel], std::fabs(sample));
+				sumSquares[channel] += double{sample} * sample;
+			}
+			samples[filled++] = mix * mixScale;
+			++levelSamples;
+			if (filled == fftLength)
+				analyse(handler);
+		}
+	});
+}
+
+/*!
+ * @internal
+ * Runs the FFT over the now full window, hands the result off, and then slides the window
+ * along by the hop length, keeping the overlap for the next frame
+ */
+void spectrumAnalyser_t::analyse(const frameHandler_t &handler) noexcept
+{
+	fft->transform(samples.data(), window.data(), power.data());
+	for (size_t bin{0U}; bin < power.size(); ++bin)
+		magnitudes[bin] = toDecibels(power[bin] * powerScale);
+	for (size_t channel{0U}; channel < channels; ++channel)
+	{
+		peak[channel] = toDecibels(peakLevels[channel] * peakLevels[channel]);
+		rms[channel] = toDecibels(float(sumSquares[channel] / levelSamples));
+		peakLevels[channel] = 0.0F;
+		sumSquares[channel] = 0.0;
+	}
+
+	if (handler)
+		handler(spectrumFrame_t{magnitudes.data(), magnitudes.size(), peak.data(), rms.data(), channels, position});
+
+	std::copy(samples.begin() + hopLength, samples.end(), samples.begin());
+	filled = fftLength - hopLength;
+	levelSamples = 0U;
+	position += hopLength;
+}
+
+/*!
+ * Decodes the next block of PCM from \p file and feeds it through the analyser. The file must be
+ * decoding to the same sample format and channel count the analyser was set up for.
+ * @param file The file to read from
+ * @param handler The function to hand each completed frame to
+ * @return The result of the fillBuffer() call on \p file, or -1 if the file does not match the analyser
+ */
+int64_t spectrumAnalyser_t::fill(audioFile_t &file, const frameHandler_t &handler)
+{
+	const auto &info{file.fileInfo()};
+	if (!valid() || info.sampleFormat() != format || info.channels() != channels)
+		return -1;
+	const auto result{file.fillBuffer(block.data(), uint32_t(block.size()))};
+	if (result > 0)
+		write(block.data(), size_t(result), handler);
+	return result;
+}
+
+/*!
+ * Discards any partially filled window and the level history, as for after seeking
+ */
+void spectrumAnalyser_t::reset() noexcept
+{
+	filled = 0U;
+	levelSamples = 0U;
+	position = 0U;
+	std::fill(peakLevels.begin(), peakLevels.end(), 0.0F);
+	std::fill(sumSquares.begin(), sumSquares.end(), 0.0);
+}
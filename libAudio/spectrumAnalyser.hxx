@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef SPECTRUM_ANALYSER_HXX
+#define SPECTRUM_ANALYSER_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <vector>
+#include "libAudio.hxx"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+//  needs to have dll-interface to be used by clients of struct 'spectrumAnalyser_t'
+#pragma warning(disable:4251)
+#endif
+
+namespace libAudio::spectrum
+{
+	struct realFFT_t;
+} // namespace libAudio::spectrum
+
+/*!
+ * One frame of analysis. The levels are all in dBFS, where a full scale sine reads as 0dB
+ * in the bin its frequency falls in and as -3dB RMS. The arrays belong to the analyser and
+ * are only valid for the duration of the call they are handed out in.
+ */
+struct spectrumFrame_t final
+{
+	/*!
+	 * The level in each frequency bin, of which there are \c bins, with the first being DC and the last
+	 * half the sample rate
+	 */
+	const float *magnitudes;
+	size_t bins;
+	/*!
+	 * The peak and RMS level of each channel over the samples given since the previous frame
+	 */
+	const float *peak;
+	const float *rms;
+	uint8_t channels;
+	/*!
+	 * The sample the window for this frame starts at, counting from the first given to the analyser
+	 */
+	uint64_t position;
+};
+
+/*!
+ * Streams PCM from a file into a windowed FFT, producing frequency spectra and VU levels for
+ * display. The channels are mixed down to mono for the spectrum, and consecutive windows
+ * overlap by the FFT length less the hop length. All the buffers the analysis needs are
+ * allocated up front, so feeding it PCM never allocates.
+ */
+struct libAUDIO_CLS_API spectrumAnalyser_t final
+{
+public:
+	/*!
+	 * Called with each frame of analysis as soon as enough PCM has been given to complete it
+	 */
+	using frameHandler_t = std::function<void (const spectrumFrame_t &frame)>;
+
+private:
+	sampleFormat_t format;
+	uint8_t channels;
+	uint32_t sampleRate;
+	uint32_t fftLength;
+	uint32_t hopLength;
+	std::unique_ptr<libAudio::spectrum::realFFT_t> fft{};
+	std::vector<float> window{};
+	std::vector<float> samples{};
+	std::vector<float> power{};
+	std::vector<float> magnitudes{};
+	std::vector<float> peakLevels{};
+	std::vector<double> sumSquares{};
+	std::vector<float> peak{};
+	std::vector<float> rms{};
+	std::vector<uint8_t> block{};
+	// Corrects the power in each bin for the window's gain, so a full scale sine reads as 0dB
+	float powerScale{0.0F};
+	size_t filled{0U};
+	uint32_t levelSamples{0U};
+	uint64_t position{0U};
+
+	void analyse(const frameHandler_t &handler) noexcept;
+
+public:
+	spectrumAnalyser_t(const fileInfo_t &info, uint32_t transformLength = 2048U, uint32_t hop = 1024U);
+	spectrumAnalyser_t(const spectrumAnalyser_t &) = delete;
+	spectrumAnalyser_t(spectrumAnalyser_t &&) = delete;
+	~spectrumAnalyser_t() noexcept;
+	spectrumAnalyser_t &operator =(const spectrumAnalyser_t &) = delete;
+	spectrumAnalyser_t &operator =(spectrumAnalyser_t &&) = delete;
+
+	[[nodiscard]] bool valid() const noexcept;
+	void write(const void *pcm, size_t length, const frameHandler_t &handler) noexcept;
+	int64_t fill(audioFile_t &file, const frameHandler_t &handler);
+	void reset() noexcept;
+	[[nodiscard]] size_t bins() const noexcept { return (fftLength / 2U) + 1U; }
+	[[nodiscard]] float binWidth() const noexcept { return float(sampleRate) / float(fftLength); }
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif /*SPECTRUM_ANALYSER_HXX*/
@@ -0,0 +1,120 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef SPSC_RING_HXX
+#define SPSC_RING_HXX
+
+#include <cstddef>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <type_traits>
+#include <substrate/span>
+#include <substrate/utility>
+
+/*!
+ * @internal
+ * The capacity to give spscRing_t when the number of entries is only known at runtime,
+ * in which case the ring is empty until resize() is called
+ */
+constexpr inline size_t dynamicCapacity{0U};
+
+/*!
+ * @internal
+ * A bounded, lock-free, single producer single consumer ring of \p capacity entries.
+ * Rather than copying entries in and out, the producer fills in the next free slot in place
+ * and then publishes it, and the consumer works on the oldest published slot in place and then
+ * releases it. This lets the slots own large buffers that get reused rather than reallocated.
+ * The head and tail indices run freely and are only reduced modulo the capacity on access,
+ * which is why the capacity must be a power of 2.
+ */
+template<typename T, size_t capacity = dynamicCapacity> struct spscRing_t final
+{
+private:
+	constexpr static bool dynamic{capacity == dynamicCapacity};
+	static_assert(dynamic || !(capacity & (capacity - 1U)), "spscRing_t capacity must be a power of 2");
+	// Keep the two indices on separate cache lines so the producer and consumer don't fight over one
+	constexpr static size_t cacheLineSize{64U};
+	using storage_t = std::conditional_t<dynamic, std::unique_ptr<T []>, std::array<T, capacity>>;
+
+	storage_t entries{};
+	size_t entryCount{capacity};
+	alignas(cacheLineSize) std::atomic<size_t> head{0U};
+	alignas(cacheLineSize) std::atomic<size_t> tail{0U};
+
+public:
+	// Gives access to the slots, for setting them up before the ring is in use
+	[[nodiscard]] auto slots() noexcept
+	{
+		if constexpr (dynamic)
+			return substrate::span<T>{entries.get(), entryCount};
+		else
+			return substrate::span<T>{entries.data(), entries.size()};
+	}
+	[[nodiscard]] auto slots() const noexcept
+	{
+		if constexpr (dynamic)
+			return substrate::span<const T>{entries.get(), entryCount};
+		else
+			return substrate::span<const T>{entries.data(), entries.size()};
+	}
+
+	[[nodiscard]] size_t size() const noexcept { return entryCount; }
+
+	/*!
+	 * Replaces the slots of a runtime sized ring with \p count new ones, emptying it. This is
+	 * only safe while neither side is using the ring.
+	 * @return \c true if \p count is a power of 2 and the slots could be allocated, otherwise \c false
+	 */
+	template<bool isDynamic = dynamic, typename = std::enable_if_t<isDynamic>> bool resize(const size_t count) noexcept
+	{
+		if (!count || (count & (count - 1U)))
+			return false;
+		auto newEntries{substrate::make_unique_nothrow<T []>(count)};
+		if (!newEntries)
+			return false;
+		entries = std::move(newEntries);
+		entryCount = count;
+		reset();
+		return true;
+	}
+
+	// Producer side: the next free slot, or nullptr if the ring is full
+	[[nodiscard]] T *writeSlot() noexcept
+	{
+		const auto index{tail.load(std::memory_order_relaxed)};
+		if (index - head.load(std::memory_order_acquire) == entryCount)
+			return nullptr;
+		return &entries[index & (entryCount - 1U)];
+	}
+
+	// Producer side: publishes the slot returned by writeSlot() to the consumer
+	void commitWrite() noexcept { tail.fetch_add(1U, std::memory_order_release); }
+
+	// Consumer side: the oldest published slot, or nullptr if the ring is empty
+	[[nodiscard]] T *readSlot() noexcept
+	{
+		const auto index{head.load(std::memory_order_relaxed)};
+		if (index == tail.load(std::memory_order_acquire))
+			return nullptr;
+		return &entries[index & (entryCount - 1U)];
+	}
+
+	// Consumer side: hands the slot returned by readSlot() back to the producer
+	void commitRead() noexcept { head.fetch_add(1U, std::memory_order_release); }
+
+	[[nodiscard]] bool empty() const noexcept
+		{ return head.load(std::memory_order_acquire) == tail.load(std::memory_order_acquire); }
+	[[nodiscard]] bool full() const noexcept
+		{ return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire) == entryCount; }
+	// How many slots are published and waiting for the consumer, which is only a snapshot if either side is active
+	[[nodiscard]] size_t occupancy() const noexcept
+		{ return tail.load(std::memory_order_acquire) - head.load(std::memory_order_acquire); }
+	// Forgets everything in the ring, which is only safe while neither side is using it
+	void reset() noexcept
+	{
+		head.store(0U, std::memory_order_relaxed);
+		tail.store(0U, std::memory_order_relaxed);
+	}
+};
+
+#endif /*SPSC_RING_HXX*/
@@ -0,0 +1,166 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <thread>
+#include <system_error>
+#include <substrate/utility>
+#include "transcodePipeline.hxx"
+
+/*!
+ * @internal
+ * @file transcodePipeline.cxx
+ * @brief The implementation of the two stage decode/encode transcode pipeline
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using substrate::make_unique_nothrow;
+
+// fillBuffer() ends the stream with either 0 or -2, so any other negative result is a decoding error
+constexpr static bool decodeFailed(const int64_t result) noexcept { return result < 0 && result != -2; }
+
+transcodePipeline_t::transcodePipeline_t(audioFile_t &inputFile, audioFile_t &outputFile,
+	const uint32_t bufferLength) : input{inputFile}, output{outputFile}, blockLength{bufferLength}
+{
+	for (auto &block : ring.slots())
+		block.data = make_unique_nothrow<uint8_t []>(blockLength);
+}
+
+/*!
+ * Checks that all the PCM blocks needed by the pipeline were allocated
+ * @return \c true if the pipeline is ready to run, otherwise \c false
+ */
+bool transcodePipeline_t::valid() const noexcept
+{
+	for (const auto &block : ring.slots())
+	{
+		if (!block.data)
+			return false;
+	}
+	return blockLength != 0U;
+}
+
+/*!
+ * @internal
+ * Wakes the other side of the pipeline if it is parked waiting on the ring. The lock is taken
+ * so a notification can't slip in between the waiter checking the ring and going to sleep.
+ */
+void transcodePipeline_t::wake() noexcept
+{
+	{
+		std::lock_guard<std::mutex> guard{parkLock};
+	}
+	parked.notify_all();
+}
+
+/*!
+ * @internal
+ * Gets a slot from the ring using \p slot, parking until one is available
+ * @return The slot, or \c nullptr if the pipeline was aborted while waiting
+ */
+template<typename slot_t> transcodePipeline_t::block_t *transcodePipeline_t::waitFor(const slot_t slot) noexcept
+{
+	// Fast path - most of the time there is a slot ready and we never touch the lock
+	if (auto *const block{slot()})
+		return block;
+	std::unique_lock<std::mutex> lock{parkLock};
+	block_t *block{nullptr};
+	parked.wait(lock, [&]() { return (block = slot()) != nullptr || abort.load(std::memory_order_acquire); });
+	return block;
+}
+
+/*!
+ * @internal
+ * The decoder stage, which fills blocks until the input runs out. The final block
+ * carries the input's end-of-stream (or error) result through to the encoder stage.
+ */
+void transcodePipeline_t::decode() noexcept
+{
+	while (!abort.load(std::memory_order_acquire))
+	{
+		auto *const block{waitFor([this]() { return ring.writeSlot(); })};
+		if (!block)
+			return;
+		block->length = input.fillBuffer(block->data.get(), blockLength);
+		const bool done{block->length <= 0};
+		ring.commitWrite();
+		wake();
+		if (done)
+			return;
+	}
+}
+
+/*!
+ * @internal
+ * The encoder stage, which writes out blocks as they become available
+ * @return \c true if the encoder took all the audio, \c false if either side failed part way
+ */
+bool transcodePipeline_t::encode(const progress_t &progress) noexcept
+{
+	while (true)
+	{
+		auto *const block{waitFor([this]() { return ring.readSlot(); })};
+		if (!block)
+			return false;
+		const auto length{block->length};
+		// Pass the end-of-stream result on just as the lockstep loop always has
+		const auto result{output.writeBuffer(block->data.get(), length)};
+		ring.commitRead();
+		wake();
+		if (length <= 0)
+			return !decodeFailed(length);
+		if (result < 0)
+		{
+			// Stop the decoder so it doesn't sit waiting on a ring that will never drain
+			abort.store(true, std::memory_order_release);
+			wake();
+			return false;
+		}
+		bytesTranscoded += uint64_t(length);
+		if (progress)
+			progress(bytesTranscoded);
+	}
+}
+
+/*!
+ * @internal
+ * Runs the transcode in lockstep on the calling thread, for when the decoder thread can't be started
+ */
+bool transcodePipeline_t::runSerial(const progress_t &progress) noexcept
+{
+	auto &block{ring.slots()[0]};
+	while (true)
+	{
+		const auto length{input.fillBuffer(block.data.get(), blockLength)};
+		const auto result{output.writeBuffer(block.data.get(), length)};
+		if (length <= 0)
+			return !decodeFailed(length);
+		if (result < 0)
+			return false;
+		bytesTranscoded += uint64_t(length);
+		if (progress)
+			progress(bytesTranscoded);
+	}
+}
+
+/*!
+ * Runs the transcode to completion, with the decoder on a new thread and the encoder on the calling one
+ * @param progress An optional callback to report progress through, which is run on the calling thread
+ * @return \c true if all the audio was transcoded, otherwise \c false
+ */
+bool transcodePipeline_t::run(const progress_t &progress) noexcept
+{
+	if (!valid())
+		return false;
+	ring.reset();
+	abort.store(false, std::memory_order_relaxed);
+	bytesTranscoded = 0U;
+
+	std::thread decoder{};
+	try
+		{ decoder = std::thread{[this]() { decode(); }}; }
+	catch (const std::system_error &)
+		{ return runSerial(progress); }
+	const bool result{encode(progress)};
+	decoder.join();
+	return result;
+}
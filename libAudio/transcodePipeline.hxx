@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef TRANSCODE_PIPELINE_HXX
+#define TRANSCODE_PIPELINE_HXX
+
+#include <cstdint>
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include "libAudio.hxx"
+#include "spscRing.hxx"
+
+#if defined(_MSC_VER)
+#pragma warning(push)
+//  needs to have dll-interface to be used by clients of struct 'transcodePipeline_t'
+#pragma warning(disable:4251)
+#endif
+
+/*!
+ * Moves all the audio from a file opened for reading into a file opened for writing, decoding
+ * on one thread and encoding on another so the two overlap rather than running in lockstep.
+ * The decoded PCM is handed from one to the other in blocks through a bounded ring, so the
+ * decoder can run at most a few blocks ahead of the encoder.
+ */
+struct libAUDIO_CLS_API transcodePipeline_t final
+{
+public:
+	/*!
+	 * Called from the encoding side after each block is written, with the number of bytes of PCM transcoded so far
+	 */
+	using progress_t = std::function<void (uint64_t bytes)>;
+
+private:
+	/*!
+	 * @internal
+	 * A single block of decoded PCM, and the result of the fillBuffer() call that produced it
+	 */
+	struct block_t final
+	{
+		std::unique_ptr<uint8_t []> data{};
+		int64_t length{0};
+	};
+
+	constexpr static size_t blockCount{8U};
+
+	audioFile_t &input;
+	audioFile_t &output;
+	uint32_t blockLength;
+	spscRing_t<block_t, blockCount> ring{};
+
+	// The ring itself is lock-free; this is only used to sleep a side that has nothing to do
+	std::mutex parkLock{};
+	std::condition_variable parked{};
+	std::atomic<bool> abort{false};
+	uint64_t bytesTranscoded{0U};
+
+	void wake() noexcept;
+	template<typename slot_t> block_t *waitFor(slot_t slot) noexcept;
+	void decode() noexcept;
+	bool encode(const progress_t &progress) noexcept;
+	bool runSerial(const progress_t &progress) noexcept;
+
+public:
+	transcodePipeline_t(audioFile_t &inputFile, audioFile_t &outputFile, uint32_t bufferLength = 16384U);
+	transcodePipeline_t(const transcodePipeline_t &) = delete;
+	transcodePipeline_t(transcodePipeline_t &&) = delete;
+	~transcodePipeline_t() noexcept = default;
+	transcodePipeline_t &operator =(const transcodePipeline_t &) = delete;
+	transcodePipeline_t &operator =(transcodePipeline_t &&) = delete;
+
+	[[nodiscard]] bool valid() const noexcept;
+	bool run(const progress_t &progress = {}) noexcept;
+	[[nodiscard]] uint64_t bytes() const noexcept { return bytesTranscoded; }
+};
+
+#if defined(_MSC_VER)
+#pragma warning(pop)
+#endif
+
+#endif /*TRANSCODE_PIPELINE_HXX*/
@@ -0,0 +1,1058 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <cmath>
+#include <cstring>
+#include <substrate/buffer_utils>
+#include "decoder.hxx"
+#include "tables.hxx"
+
+/*!
+ * @internal
+ * @file wma/decoder.cxx
+ * @brief The implementation of the Windows Media Audio v1 and v2 decoder
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+using substrate::span;
+using substrate::buffer_utils::readLE;
+
+namespace libAudio::wma
+{
+	namespace
+	{
+		constexpr float pi{3.14159265358979323846F};
+		constexpr uint8_t coefficientVLCBits{9U};
+		constexpr uint8_t highGainVLCBits{9U};
+		constexpr uint8_t exponentVLCBits{8U};
+		// The exponent VLC codes a delta from the last exponent, with this as the zero point
+		constexpr int32_t exponentDeltaBias{60};
+		constexpr int32_t highGainDeltaBias{18};
+
+		/*!
+		 * @internal
+		 * The Huffman tables and other constant data shared by every decoder, built the first
+		 * time a decoder is made and never modified after
+		 */
+		struct sharedTables_t final
+		{
+			vlc_t highGain{highGainVLCBits, hgain_huffcodes, hgain_huffbits};
+			vlc_t exponent{exponentVLCBits, scale_huffcodes, scale_huffbits};
+			std::array<coefficientVLC_t, coefficientTables.size()> coefficients{};
+			// 10^(n / 16) for the exponents, offset by exponentDeltaBias
+			std::array<float, 144U> exponentPowers{};
+
+			sharedTables_t()
+			{
+				for (size_t i{0U}; i < coefficients.size(); ++i)
+				{
+					const auto &table{coefficientTables[i]};
+					auto &coefficient{coefficients[i]};
+					const auto count{table.codes.size()};
+					coefficient.vlc = {coefficientVLCBits, table.codes, table.lengths};
+					coefficient.runs.resize(count);
+					coefficient.levels.resize(count);
+					// Symbol 0 is the escape code and 1 the end of block; the rest are runs of each level in turn
+					size_t symbol{2U};
+					float level{1.0F};
+					for (size_t j{0U}; symbol < count && j < table.levels.size(); ++j, level += 1.0F)
+					{
+						for (uint16_t run{0U}; run < table.levels[j] && symbol < count; ++run, ++symbol)
+						{
+							coefficient.runs[symbol] = run;
+							coefficient.levels[symbol] = level;
+						}
+					}
+				}
+				for (size_t i{0U}; i < exponentPowers.size(); ++i)
+					exponentPowers[i] = std::pow(10.0F, float(int32_t(i) - exponentDeltaBias) / 16.0F);
+			}
+		};
+
+		const sharedTables_t &sharedTables()
+		{
+			static const sharedTables_t tables{};
+			return tables;
+		}
+
+		uint8_t ilog2(uint32_t value) noexcept
+		{
+			uint8_t result{0U};
+			while (value >>= 1U)
+				++result;
+			return result;
+		}
+
+		uint8_t frameLengthBitsFor(const uint32_t sampleRate, const uint8_t version) noexcept
+		{
+			if (sampleRate <= 16000U)
+				return 9U;
+			if (sampleRate <= 22050U || (sampleRate <= 32000U && version == 1U))
+				return 10U;
+			return 11U;
+		}
+
+		uint8_t totalGainToBits(const int32_t totalGain) noexcept
+		{
+			if (totalGain < 15)
+				return 13U;
+			if (totalGain < 32)
+				return 12U;
+			if (totalGain < 40)
+				return 11U;
+			if (totalGain < 45)
+				return 10U;
+			return 9U;
+		}
+	} // namespace
+
+	vlc_t::vlc_t(const uint8_t bits, const span<const uint32_t> codes, const span<const uint8_t> lengths) : _bits{bits}
+	{
+		std::vector<code_t> entries{};
+		entries.reserve(codes.size());
+		for (size_t i{0U}; i < codes.size(); ++i)
+		{
+			if (lengths[i])
+				entries.push_back({codes[i], lengths[i], uint16_t(i)});
+		}
+		build(entries, 0U, 0U, bits);
+	}
+
+	/*!
+	 * @internal
+	 * Builds the table for all the codes starting with the \p prefixLength bits in \p prefix,
+	 * recursing to build subtables for codes too long to fit in a \p tableBits bit table
+	 * @return The offset of the new table
+	 */
+	size_t vlc_t::build(const std::vector<code_t> &codes, const uint32_t prefix, const uint8_t prefixLength,
+		const uint8_t tableBits)
+	{
+		const size_t offset{_table.size()};
+		const size_t tableSize{size_t{1U} << tableBits};
+		_table.resize(offset + tableSize, entry_t{0, 0});
+		// How many bits past the end of this table the longest code under each entry runs
+		std::vector<uint8_t> subtableBits(tableSize, 0U);
+		for (const auto &code : codes)
+		{
+			if (code.length <= prefixLength || (code.code >> (code.length - prefixLength)) != prefix)
+				continue;
+			const auto remaining{uint8_t(code.length - prefixLength)};
+			const uint32_t suffix{code.code & ((1U << remaining) - 1U)};
+			if (remaining <= tableBits)
+			{
+				// Short codes fill every entry whose leading bits match them
+				const size_t start{size_t{suffix} << (tableBits - remaining)};
+				const size_t fill{size_t{1U} << (tableBits - remaining)};
+				for (size_t i{0U}; i < fill; ++i)
+					_table[offset + start + i] = {code.symbol, int8_t(remaining)};
+			}
+			else
+			{
+				const size_t index{suffix >> (remaining - tableBits)};
+				subtableBits[index] = std::max(subtableBits[index], uint8_t(remaining - tableBits));
+			}
+		}
+		for (size_t index{0U}; index < tableSize; ++index)
+		{
+			if (!subtableBits[index])
+				continue;
+			const auto bits{std::min(subtableBits[index], _bits)};
+			const auto subtable{build(codes, (prefix << tableBits) | uint32_t(index), uint8_t(prefixLength + tableBits),
+				bits)};
+			_table[offset + index] = {int32_t(subtable), int8_t(-bits)};
+		}
+		return offset;
+	}
+
+	/*!
+	 * @internal
+	 * Sets up an inverse MDCT producing 2^bits samples per block
+	 */
+	mdct_t::mdct_t(const uint8_t bits) : _length{size_t{1U} << bits}
+	{
+		const size_t n4{_length / 4U};
+		const auto fftBits{uint8_t(bits - 2U)};
+		_cos.resize(n4);
+		_sin.resize(n4);
+		for (size_t i{0U}; i < n4; ++i)
+		{
+			const auto alpha{2.0 * double(pi) * (double(i) + 0.125) / double(_length)};
+			_cos[i] = float(-std::cos(alpha));
+			_sin[i] = float(-std::sin(alpha));
+		}
+
+		_bitReverse.resize(n4);
+		for (size_t i{0U}; i < n4; ++i)
+		{
+			size_t reversed{0U};
+			for (uint8_t bit{0U}; bit < fftBits; ++bit)
+				reversed |= ((i >> bit) & 1U) << (fftBits - 1U - bit);
+			_bitReverse[i] = uint16_t(reversed);
+		}
+
+		// The first two passes are done by hand, so only store twiddles from the 8 point pass on
+		for (size_t half{4U}; half < n4; half <<= 1U)
+		{
+			for (size_t k{0U}; k < half; ++k)
+			{
+				const auto angle{double(pi) * double(k) / double(half)};
+				_twiddles.push_back({float(std::cos(angle)), float(std::sin(angle))});
+			}
+		}
+		_scratch.resize(n4);
+	}
+
+	/*!
+	 * @internal
+	 * Runs the inverse complex FFT over the bit-reversed data in _scratch, leaving the result in natural order
+	 */
+	void mdct_t::fft(const wmaDSP_t &dsp) noexcept
+	{
+		auto *const values{_scratch.data()};
+		const size_t count{_scratch.size()};
+		// The 2 and 4 point passes, whose twiddles are 1 and i
+		for (size_t i{0U}; i + 3U < count; i += 4U)
+		{
+			const auto a{values[i + 0U]};
+			const auto b{values[i + 1U]};
+			const auto c{values[i + 2U]};
+			const auto d{values[i + 3U]};
+			const fftComplex_t ab0{a.re + b.re, a.im + b.im};
+			const fftComplex_t ab1{a.re - b.re, a.im - b.im};
+			const fftComplex_t cd0{c.re + d.re, c.im + d.im};
+			const fftComplex_t cd1{c.re - d.re, c.im - d.im};
+			values[i + 0U] = {ab0.re + cd0.re, ab0.im + cd0.im};
+			values[i + 2U] = {ab0.re - cd0.re, ab0.im - cd0.im};
+			values[i + 1U] = {ab1.re - cd1.im, ab1.im + cd1.re};
+			values[i + 3U] = {ab1.re + cd1.im, ab1.im - cd1.re};
+		}
+
+		const auto *twiddles{_twiddles.data()};
+		for (size_t half{4U}; half < count; half <<= 1U)
+		{
+			for (size_t start{0U}; start < count; start += half * 2U)
+				dsp.butterflies(values + start, values + start + half, twiddles, half);
+			twiddles += half;
+		}
+	}
+
+	void mdct_t::inverse(float *const output, const float *const input, const wmaDSP_t &dsp) noexcept
+	{
+		const size_t n2{_length / 2U};
+		const size_t n4{_length / 4U};
+		auto *const values{_scratch.data()};
+
+		// Pre-rotation, which also puts the data in bit-reversed order for the FFT
+		for (size_t k{0U}; k < n4; ++k)
+		{
+			const float even{input[2U * k]};
+			const float odd{input[n2 - 1U - (2U * k)]};
+			values[_bitReverse[k]] = {odd * _cos[k] - even * _sin[k], odd * _sin[k] + even * _cos[k]};
+		}
+		fft(dsp);
+		dsp.rotate(values, _cos.data(), _sin.data(), n4);
+
+		// Unpack the middle half of the output, pairing each value with its mirror image
+		auto *const half{output + n4};
+		for (size_t k{0U}; k < n4; ++k)
+		{
+			half[2U * k] = values[k].re;
+			half[(2U * k) + 1U] = values[n4 - 1U - k].im;
+		}
+		// And then build the outer quarters from its symmetries
+		for (size_t k{0U}; k < n4; ++k)
+		{
+			output[k] = -output[n2 - k - 1U];
+			output[_length - k - 1U] = output[n2 + k];
+		}
+	}
+
+	/*!
+	 * @internal
+	 * Sets up a decoder for the stream described by \p info, which is left invalid if the
+	 * stream is not WMA v1 or v2 or has parameters out of the range the format allows
+	 */
+	decoder_t::decoder_t(const streamInfo_t &info) : dsp{wmaDSP()}, channels{uint8_t(info.channels)},
+		sampleRate{info.sampleRate}, blockAlign{info.blockAlign}
+	{
+		if (info.formatTag == 0x0160U)
+			version = 1U;
+		else if (info.formatTag == 0x0161U)
+			version = 2U;
+		if (!version || !sampleRate || sampleRate > 50000U || !channels || channels > maxChannels ||
+			!info.bitRate || !blockAlign || blockAlign > maxCodedSuperframeSize)
+			return;
+
+		uint16_t flags{0U};
+		if (version == 1U && info.extraData.size() >= 4U)
+			flags = readLE<uint16_t>(info.extraData.data() + 2U);
+		else if (version == 2U && info.extraData.size() >= 6U)
+			flags = readLE<uint16_t>(info.extraData.data() + 4U);
+		useExpVLC = flags & 0x0001U;
+		useBitReservoir = flags & 0x0002U;
+		useVariableBlockLength = flags & 0x0004U;
+		// Some v2 encoders set the variable block length flag on streams that don't use it
+		if (version == 2U && info.extraData.size() >= 8U && flags == 0x000dU)
+			useVariableBlockLength = false;
+
+		frameLengthBits = frameLengthBitsFor(sampleRate, version);
+		frameLength = size_t{1U} << frameLengthBits;
+		prevBlockLengthBits = blockLengthBits = nextBlockLengthBits = frameLengthBits;
+		if (useVariableBlockLength)
+		{
+			uint8_t count = uint8_t(((flags >> 3U) & 3U) + 1U);
+			if (info.bitRate / channels >= 32000U)
+				count += 2U;
+			blockSizeCount = uint8_t(std::min<uint8_t>(count, frameLengthBits - blockMinBits) + 1U);
+		}
+		else
+			blockSizeCount = 1U;
+
+		// Version 2 normalises the sample rate for picking the coding parameters
+		uint32_t normalisedRate{sampleRate};
+		if (version == 2U)
+		{
+			for (const uint32_t rate : {44100U, 22050U, 16000U, 11025U, 8000U})
+			{
+				if (normalisedRate >= rate)
+				{
+					normalisedRate = rate;
+					break;
+				}
+			}
+		}
+
+		const float bitsPerSample{float(info.bitRate) / float(channels * sampleRate)};
+		byteOffsetBits = uint8_t(ilog2(uint32_t(bitsPerSample * float(frameLength) / 8.0F + 0.5F)) + 2U);
+		// The bit offset into a superframe must fit in a single bit read
+		if (byteOffsetBits + 3U > 25U)
+			return;
+
+		// Work out where the high frequencies start and whether noise coding is in use
+		const float stereoBitsPerSample{channels == 2U ? bitsPerSample * 1.6F : bitsPerSample};
+		float highFrequency{float(sampleRate) * 0.5F};
+		useNoiseCoding = true;
+		if (normalisedRate == 44100U)
+		{
+			if (stereoBitsPerSample >= 0.61F)
+				useNoiseCoding = false;
+			else
+				highFrequency *= 0.4F;
+		}
+		else if (normalisedRate == 22050U)
+		{
+			if (stereoBitsPerSample >= 1.16F)
+				useNoiseCoding = false;
+			else if (stereoBitsPerSample >= 0.72F)
+				highFrequency *= 0.7F;
+			else
+				highFrequency *= 0.6F;
+		}
+		else if (normalisedRate == 16000U)
+			highFrequency *= bitsPerSample > 0.5F ? 0.5F : 0.3F;
+		else if (normalisedRate == 11025U)
+			highFrequency *= 0.7F;
+		else if (normalisedRate == 8000U)
+		{
+			if (bitsPerSample <= 0.625F)
+				highFrequency *= 0.5F;
+			else if (bitsPerSample > 0.75F)
+				useNoiseCoding = false;
+			else
+				highFrequency *= 0.65F;
+		}
+		else if (bitsPerSample >= 0.8F)
+			highFrequency *= 0.75F;
+		else if (bitsPerSample >= 0.6F)
+			highFrequency *= 0.6F;
+		else
+			highFrequency *= 0.5F;
+		setupBands(highFrequency);
+
+		// Sine windows and transforms for each block size
+		for (size_t i{0U}; i < blockSizeCount; ++i)
+		{
+			const size_t length{frameLength >> i};
+			auto &window{windows[i]};
+			window.resize(length);
+			for (size_t j{0U}; j < length; ++j)
+				window[j] = float(std::sin((double(j) + 0.5) * (double(pi) / (2.0 * double(length)))));
+			transforms[i] = mdct_t{uint8_t(frameLengthBits - i + 1U)};
+		}
+
+		if (useNoiseCoding)
+		{
+			noiseMultiplier = useExpVLC ? 0.02F : 0.04F;
+			noiseTable.resize(noiseTableSize);
+			const float norm{float((1.0 / double(1ULL << 31U)) * std::sqrt(3.0) * double(noiseMultiplier))};
+			uint32_t seed{1U};
+			for (auto &noise : noiseTable)
+			{
+				seed = (seed * 314159U) + 1U;
+				noise = float(int32_t(seed)) * norm;
+			}
+		}
+
+		if (!useExpVLC)
+		{
+			lspCosTable.resize(frameLength);
+			const double step{double(pi) / double(frameLength)};
+			for (size_t i{0U}; i < frameLength; ++i)
+				lspCosTable[i] = float(2.0 * std::cos(step * double(i)));
+		}
+
+		// Choose the coefficient tables, with the second of each pair used for M/S stereo's side channel
+		size_t coefficientTable{2U};
+		if (sampleRate >= 32000U)
+		{
+			if (stereoBitsPerSample < 0.72F)
+				coefficientTable = 0U;
+			else if (stereoBitsPerSample < 1.16F)
+				coefficientTable = 1U;
+		}
+		const auto &tables{sharedTables()};
+		coefficientVLCs[0] = &tables.coefficients[coefficientTable * 2U];
+		coefficientVLCs[1] = &tables.coefficients[(coefficientTable * 2U) + 1U];
+
+		maxExponent.fill(1.0F);
+		lastSuperframe.resize(maxCodedSuperframeSize);
+		_valid = true;
+	}
+
+	/*!
+	 * @internal
+	 * Computes the exponent (scale factor) bands and high frequency bands for each block size
+	 */
+	void decoder_t::setupBands(const float highFrequency) noexcept
+	{
+		coefficientsStart = version == 1U ? 3U : 0U;
+		for (size_t k{0U}; k < blockSizeCount; ++k)
+		{
+			const size_t blockLength{frameLength >> k};
+			auto &bands{exponentBands[k]};
+			if (version == 1U)
+			{
+				size_t lastPosition{0U};
+				size_t i{0U};
+				while (i < bands.size())
+				{
+					const size_t position{std::min(((blockLength * 2U * wma_critical_freqs[i]) + (sampleRate >> 1U)) /
+						sampleRate, blockLength)};
+					bands[i++] = uint16_t(position - lastPosition);
+					if (position >= blockLength)
+						break;
+					lastPosition = position;
+				}
+				exponentSizes[k] = i;
+			}
+			else
+			{
+				const uint8_t *table{nullptr};
+				const size_t index{frameLengthBits - blockMinBits - k};
+				if (index < 3U)
+				{
+					if (sampleRate >= 44100U)
+						table = exponent_band_44100[index];
+					else if (sampleRate >= 32000U)
+						table = exponent_band_32000[index];
+					else if (sampleRate >= 22050U)
+						table = exponent_band_22050[index];
+				}
+				if (table)
+				{
+					// The first entry in each hardcoded table is the number of bands in it
+					exponentSizes[k] = table[0];
+					std::copy_n(table + 1U, table[0], bands.begin());
+				}
+				else
+				{
+					size_t count{0U};
+					size_t lastPosition{0U};
+					for (const auto frequency : wma_critical_freqs)
+					{
+						size_t position{((blockLength * 2U * frequency) + (sampleRate << 1U)) / (4U * sampleRate)};
+						position = std::min(position << 2U, blockLength);
+						if (position > lastPosition)
+							bands[count++] = uint16_t(position - lastPosition);
+						if (position >= blockLength)
+							break;
+						lastPosition = position;
+					}
+					exponentSizes[k] = count;
+				}
+			}
+
+			coefficientsEnd[k] = (frameLength - ((frameLength * 9U) / 100U)) >> k;
+			highBandStart[k] = size_t((float(blockLength * 2U) * highFrequency) / float(sampleRate) + 0.5F);
+			size_t count{0U};
+			size_t position{0U};
+			for (size_t i{0U}; i < exponentSizes[k]; ++i)
+			{
+				const size_t start{std::max(position, highBandStart[k])};
+				position += bands[i];
+				const size_t end{std::min(position, coefficientsEnd[k])};
+				if (end > start && count < highBandMaxSize)
+					exponentHighBands[k][count++] = uint16_t(end - start);
+			}
+			exponentHighSizes[k] = count;
+		}
+	}
+
+	float decoder_t::noise() noexcept
+	{
+		const auto value{noiseTable[noiseIndex]};
+		noiseIndex = (noiseIndex + 1U) & (noiseTableSize - 1U);
+		return value;
+	}
+
+	/*!
+	 * @internal
+	 * Reads which high frequency bands of each channel are noise coded, and their gains,
+	 * taking the bands that are out of the count of coefficients to be read for the channel
+	 */
+	bool decoder_t::decodeHighBands(const uint8_t blockSize, std::array<size_t, maxChannels> &coefficientCount) noexcept
+	{
+		const auto bandCount{exponentHighSizes[blockSize]};
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			if (!channelCoded[channel])
+				continue;
+			for (size_t band{0U}; band < bandCount; ++band)
+			{
+				highBandCoded[channel][band] = stream.readBit();
+				if (highBandCoded[channel][band])
+					coefficientCount[channel] -= exponentHighBands[blockSize][band];
+			}
+		}
+
+		const auto &highGain{sharedTables().highGain};
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			if (!channelCoded[channel])
+				continue;
+			bool first{true};
+			int32_t value{0};
+			for (size_t band{0U}; band < bandCount; ++band)
+			{
+				if (!highBandCoded[channel][band])
+					continue;
+				// The first gain is sent as is, and the rest as deltas from the one before
+				if (first)
+				{
+					value = int32_t(stream.read(7U)) - 19;
+					first = false;
+				}
+				else
+				{
+					const auto delta{highGain.read(stream)};
+					if (delta < 0)
+						return false;
+					value += delta - highGainDeltaBias;
+				}
+				highBandValues[channel][band] = value;
+			}
+		}
+		return true;
+	}
+
+	bool decoder_t::decodeExponentsVLC(const size_t channel) noexcept
+	{
+		const auto &tables{sharedTables()};
+		const auto &bands{exponentBands[frameLengthBits - blockLengthBits]};
+		auto *exponent{exponents[channel].data()};
+		auto *const end{exponent + blockLength};
+		size_t band{0U};
+		float maxScale{0.0F};
+		int32_t lastExponent{36};
+
+		const auto fillBand{[&](const float value) noexcept
+		{
+			const auto count{std::min<size_t>(bands[band++], size_t(end - exponent))};
+			exponent = std::fill_n(exponent, count, value);
+		}};
+
+		if (version == 1U)
+		{
+			lastExponent = int32_t(stream.read(5U)) + 10;
+			maxScale = tables.exponentPowers[size_t(lastExponent + exponentDeltaBias)];
+			fillBand(maxScale);
+		}
+		while (exponent < end)
+		{
+			const auto code{tables.exponent.read(stream)};
+			if (code < 0 || band >= bands.size())
+				return false;
+			lastExponent += code - exponentDeltaBias;
+			const auto index{lastExponent + exponentDeltaBias};
+			if (index < 0 || size_t(index) >= tables.exponentPowers.size())
+				return false;
+			const auto value{tables.exponentPowers[size_t(index)]};
+			maxScale = std::max(maxScale, value);
+			fillBand(value);
+		}
+		maxExponent[channel] = maxScale;
+		return true;
+	}
+
+	/*!
+	 * @internal
+	 * Decodes the line spectral pairs for a channel and turns them into its spectral envelope
+	 */
+	void decoder_t::decodeExponentsLSP(const size_t channel) noexcept
+	{
+		std::array<float, lspCoefficients> lsp{};
+		for (size_t i{0U}; i < lspCoefficients; ++i)
+			lsp[i] = lsp_codebook[i][stream.read(i == 0U || i >= 8U ? 3U : 4U)];
+
+		float maxValue{0.0F};
+		auto &exponent{exponents[channel]};
+		for (size_t i{0U}; i < blockLength; ++i)
+		{
+			float p{0.5F};
+			float q{0.5F};
+			const float w{lspCosTable[i]};
+			for (size_t j{1U}; j < lspCoefficients; j += 2U)
+			{
+				q *= w - lsp[j - 1U];
+				p *= w - lsp[j];
+			}
+			p *= p * (2.0F - w);
+			q *= q * (2.0F + w);
+			const float value{1.0F / std::sqrt(std::sqrt(p + q))};
+			maxValue = std::max(maxValue, value);
+			exponent[i] = value;
+		}
+		maxExponent[channel] = maxValue;
+	}
+
+	/*!
+	 * @internal
+	 * Decodes the run-length coded spectral coefficients for a channel
+	 */
+	bool decoder_t::decodeCoefficients(const size_t channel, const size_t count, const uint8_t coefficientBits) noexcept
+	{
+		// The side channel of M/S stereo has less energy, so gets its own table
+		const auto &table{*coefficientVLCs[channel == 1U && msStereo ? 1U : 0U]};
+		auto &values{quantised[channel]};
+		std::fill_n(values.begin(), blockLength, 0.0F);
+		const size_t mask{blockLength - 1U};
+		size_t offset{0U};
+		for (; offset < count; ++offset)
+		{
+			const auto code{table.vlc.read(stream)};
+			if (code < 0)
+				return false;
+			float level{};
+			if (code > 1)
+			{
+				offset += table.runs[size_t(code)];
+				level = table.levels[size_t(code)];
+			}
+			else if (code == 1)
+				break;
+			else
+			{
+				// Escaped levels are sent raw along with the run up to them
+				level = float(stream.read(coefficientBits));
+				offset += stream.read(frameLengthBits);
+			}
+			values[offset & mask] = stream.readBit() ? level : -level;
+		}
+		return offset <= count;
+	}
+
+	/*!
+	 * @internal
+	 * Turns the decoded spectral data for each coded channel into MDCT coefficients, scaling
+	 * by the spectral envelope and filling the noise coded bands from the noise table
+	 */
+	void decoder_t::computeCoefficients(const uint8_t blockSize, const int32_t totalGain,
+		const std::array<size_t, maxChannels> &coefficientCount) noexcept
+	{
+		const size_t n4{blockLength / 2U};
+		float mdctNorm{1.0F / float(n4)};
+		if (version == 1U)
+			mdctNorm *= std::sqrt(float(n4));
+
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			if (!channelCoded[channel])
+				continue;
+			const auto exponentSize{exponentsBlockSize[channel]};
+			// Maps an index at this block's size to one into exponents decoded at another block size
+			const auto scale{[=](const size_t index) noexcept { return (index << blockSize) >> exponentSize; }};
+			const auto *levels{quantised[channel].data()};
+			const auto *exponent{exponents[channel].data()};
+			auto *coefficient{coefficients[channel].data()};
+			const float multiplier{std::pow(10.0F, float(totalGain) * 0.05F) / maxExponent[channel] * mdctNorm};
+
+			if (!useNoiseCoding)
+			{
+				coefficient = std::fill_n(coefficient, coefficientsStart, 0.0F);
+				for (size_t i{0U}; i < coefficientCount[channel]; ++i)
+					*coefficient++ = levels[i] * exponent[scale(i)] * multiplier;
+				std::fill_n(coefficient, blockLength - coefficientsEnd[blockSize], 0.0F);
+				continue;
+			}
+
+			// The very lowest frequencies are noise
+			for (size_t i{0U}; i < coefficientsStart; ++i)
+				*coefficient++ = noise() * exponent[scale(i)] * multiplier;
+
+			// Work out the power in each of the noise coded high bands
+			const auto highBands{exponentHighSizes[blockSize]};
+			const auto &highBandSizes{exponentHighBands[blockSize]};
+			std::array<float, highBandMaxSize> exponentPower{};
+			size_t lastHighBand{0U};
+			const auto *bandExponent{exponent + scale(highBandStart[blockSize])};
+			for (size_t band{0U}; band < highBands; ++band)
+			{
+				const size_t count{highBandSizes[band]};
+				if (highBandCoded[channel][band])
+				{
+					float power{0.0F};
+					for (size_t i{0U}; i < count; ++i)
+					{
+						const auto value{bandExponent[scale(i)]};
+						power += value * value;
+					}
+					exponentPower[band] = power / float(count);
+					lastHighBand = band;
+				}
+				bandExponent += scale(count);
+			}
+
+			// Then fill in the coded main bands and the noise coded high bands
+			bandExponent = exponent + scale(coefficientsStart);
+			for (size_t band{0U}; band <= highBands; ++band)
+			{
+				// The first pass covers everything below the high bands
+				const bool lowBand{band == 0U};
+				const size_t highBand{band - 1U};
+				const size_t count{lowBand ?
+					highBandStart[blockSize] - std::min(coefficientsStart, highBandStart[blockSize]) :
+					highBandSizes[highBand]};
+				if (!lowBand && highBandCoded[channel][highBand])
+				{
+					const float bandMultiplier
+					{
+						std::sqrt(exponentPower[highBand] / exponentPower[lastHighBand]) *
+						std::pow(10.0F, float(highBandValues[channel][highBand]) * 0.05F) /
+						(maxExponent[channel] * noiseMultiplier) * mdctNorm
+					};
+					for (size_t i{0U}; i < count; ++i)
+						*coefficient++ = noise() * bandExponent[scale(i)] * bandMultiplier;
+				}
+				else
+				{
+					for (size_t i{0U}; i < count; ++i)
+						*coefficient++ = (*levels++ + noise()) * bandExponent[scale(i)] * multiplier;
+				}
+				bandExponent += scale(count);
+			}
+
+			// And the very highest frequencies are noise at the level of the last exponent
+			const ptrdiff_t lastExponent{exponentSize <= blockSize ? -(ptrdiff_t{1} << (blockSize - exponentSize)) : -1};
+			const float highMultiplier{multiplier * bandExponent[lastExponent]};
+			for (size_t i{coefficientsEnd[blockSize]}; i < blockLength; ++i)
+				*coefficient++ = noise() * highMultiplier;
+		}
+	}
+
+	/*!
+	 * @internal
+	 * Windows the transformed block in output onto the frame at \p out, using the shorter of this
+	 * block's length and each neighbour's length for the overlap with that neighbour
+	 */
+	void decoder_t::applyWindow(float *out) const noexcept
+	{
+		const float *in{output.data()};
+		if (blockLengthBits <= prevBlockLengthBits)
+			dsp.windowAdd(out, in, windows[frameLengthBits - blockLengthBits].data(), blockLength);
+		else
+		{
+			const size_t length{size_t{1U} << prevBlockLengthBits};
+			const size_t offset{(blockLength - length) / 2U};
+			dsp.windowAdd(out + offset, in + offset, windows[frameLengthBits - prevBlockLengthBits].data(), length);
+			std::memcpy(out + offset + length, in + offset + length, offset * sizeof(float));
+		}
+
+		out += blockLength;
+		in += blockLength;
+		if (blockLengthBits <= nextBlockLengthBits)
+			dsp.windowReverse(out, in, windows[frameLengthBits - blockLengthBits].data(), blockLength);
+		else
+		{
+			const size_t length{size_t{1U} << nextBlockLengthBits};
+			const size_t offset{(blockLength - length) / 2U};
+			std::memcpy(out, in, offset * sizeof(float));
+			dsp.windowReverse(out + offset, in + offset, windows[frameLengthBits - nextBlockLengthBits].data(), length);
+			std::fill_n(out + offset + length, offset, 0.0F);
+		}
+	}
+
+	/*!
+	 * @internal
+	 * Decodes one block of a frame into frameOutput
+	 * @return 1 if this was the last block of the frame, 0 if there are more, or -1 on error
+	 */
+	int32_t decoder_t::decodeBlock() noexcept
+	{
+		if (useVariableBlockLength)
+		{
+			const auto bits{uint8_t(ilog2(blockSizeCount - 1U) + 1U)};
+			const auto readBlockLength{[&](uint8_t &lengthBits) noexcept
+			{
+				const auto value{stream.read(bits)};
+				if (value >= blockSizeCount)
+					return false;
+				lengthBits = uint8_t(frameLengthBits - value);
+				return true;
+			}};
+			if (resetBlockLengths)
+			{
+				resetBlockLengths = false;
+				if (!readBlockLength(prevBlockLengthBits) || !readBlockLength(blockLengthBits))
+					return -1;
+			}
+			else
+			{
+				prevBlockLengthBits = blockLengthBits;
+				blockLengthBits = nextBlockLengthBits;
+			}
+			if (!readBlockLength(nextBlockLengthBits))
+				return -1;
+		}
+		else
+			prevBlockLengthBits = blockLengthBits = nextBlockLengthBits = frameLengthBits;
+
+		const auto blockSize{uint8_t(frameLengthBits - blockLengthBits)};
+		blockLength = size_t{1U} << blockLengthBits;
+		if (blockSize >= blockSizeCount || blockPosition + blockLength > frameLength)
+			return -1;
+
+		msStereo = channels == 2U && stream.readBit();
+		bool anyCoded{false};
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			channelCoded[channel] = stream.readBit();
+			anyCoded |= channelCoded[channel];
+		}
+
+		if (anyCoded)
+		{
+			int32_t totalGain{1};
+			while (true)
+			{
+				if (stream.remaining() < 7U)
+					return -1;
+				const auto gain{int32_t(stream.read(7U))};
+				totalGain += gain;
+				if (gain != 127)
+					break;
+			}
+			const auto coefficientBits{totalGainToBits(totalGain)};
+
+			std::array<size_t, maxChannels> coefficientCount{};
+			coefficientCount.fill(coefficientsEnd[blockSize] - coefficientsStart);
+			if (useNoiseCoding && !decodeHighBands(blockSize, coefficientCount))
+				return -1;
+
+			// Short blocks can reuse the exponents from the block before
+			if (blockLengthBits == frameLengthBits || stream.readBit())
+			{
+				for (size_t channel{0U}; channel < channels; ++channel)
+				{
+					if (!channelCoded[channel])
+						continue;
+					if (useExpVLC)
+					{
+						if (!decodeExponentsVLC(channel))
+							return -1;
+					}
+					else
+						decodeExponentsLSP(channel);
+					exponentsBlockSize[channel] = blockSize;
+					exponentsInitialised[channel] = true;
+				}
+			}
+
+			for (size_t channel{0U}; channel < channels; ++channel)
+			{
+				if (channelCoded[channel] &&
+					(!exponentsInitialised[channel] || !decodeCoefficients(channel, coefficientCount[channel], coefficientBits)))
+					return -1;
+				if (version == 1U && channels >= 2U)
+					stream.align();
+			}
+
+			computeCoefficients(blockSize, totalGain, coefficientCount);
+
+			if (msStereo && channelCoded[1])
+			{
+				// Mid/side stereo is undone before the transform
+				auto &mid{coefficients[0]};
+				auto &side{coefficients[1]};
+				if (!channelCoded[0])
+				{
+					std::fill_n(mid.begin(), blockLength, 0.0F);
+					channelCoded[0] = true;
+				}
+				for (size_t i{0U}; i < blockLength; ++i)
+				{
+					const float difference{mid[i] - side[i]};
+					mid[i] += side[i];
+					side[i] = difference;
+				}
+			}
+		}
+
+		auto &transform{transforms[blockSize]};
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			if (channelCoded[channel])
+				transform.inverse(output.data(), coefficients[channel].data(), dsp);
+			else if (!(msStereo && channel == 1U))
+				output.fill(0.0F);
+			applyWindow(frameOutput[channel].data() + (frameLength / 2U) + blockPosition - (blockLength / 2U));
+		}
+
+		blockPosition += blockLength;
+		return blockPosition >= frameLength ? 1 : 0;
+	}
+
+	/*!
+	 * @internal
+	 * Decodes one frame, writing frameLength samples per channel of interleaved PCM to \p samples
+	 */
+	bool decoder_t::decodeFrame(int16_t *const samples) noexcept
+	{
+		blockPosition = 0U;
+		while (true)
+		{
+			const auto result{decodeBlock()};
+			if (result < 0)
+				return false;
+			if (result)
+				break;
+		}
+
+		dsp.toInt16(samples, frameOutput[0].data(), channels == 2U ? frameOutput[1].data() : nullptr, frameLength);
+		// The second half of each channel's output is the overlap for the next frame
+		for (size_t channel{0U}; channel < channels; ++channel)
+		{
+			auto &frame{frameOutput[channel]};
+			std::memmove(frame.data(), frame.data() + frameLength, frameLength * sizeof(float));
+		}
+		return true;
+	}
+
+	/*!
+	 * @internal
+	 * Decodes a superframe, which is superframeLength() bytes long, into interleaved 16-bit PCM.
+	 * When the stream uses the bit reservoir, frames may span superframe boundaries, with the
+	 * start of such a frame kept until the next superframe completes it.
+	 * @return The number of samples per channel decoded (which may be 0), or -1 on error
+	 */
+	int64_t decoder_t::decodeSuperframe(const span<const uint8_t> data, int16_t *const samples) noexcept
+	{
+		if (data.size() < blockAlign)
+			return -1;
+		const size_t length{blockAlign};
+		stream = {data.data(), length * 8U};
+
+		size_t frameCount{1U};
+		if (useBitReservoir)
+		{
+			// Skip the superframe index
+			stream.skip(4U);
+			const auto frames{int32_t(stream.read(4U)) - (lastSuperframeLength ? 0 : 1)};
+			if (frames <= 0)
+			{
+				// This superframe is entirely part of a frame that continues into the next one
+				if (lastSuperframeLength + length - 1U > maxCodedSuperframeSize)
+				{
+					resetReservoir();
+					return -1;
+				}
+				std::memcpy(lastSuperframe.data() + lastSuperframeLength, data.data() + 1U, length - 1U);
+				lastSuperframeLength += length - 1U;
+				return 0;
+			}
+			frameCount = size_t(frames);
+		}
+		else
+		{
+			if (!decodeFrame(samples))
+				return -1;
+			return int64_t(frameLength);
+		}
+
+		const size_t bitOffset{stream.read(uint8_t(byteOffsetBits + 3U))};
+		if (bitOffset > stream.remaining())
+		{
+			resetReservoir();
+			return -1;
+		}
+
+		size_t samplesDecoded{0U};
+		if (lastSuperframeLength)
+		{
+			// Complete the frame started in the last superframe with the first bitOffset bits of this one
+			if (lastSuperframeLength + ((bitOffset + 7U) >> 3U) > maxCodedSuperframeSize)
+			{
+				resetReservoir();
+				return -1;
+			}
+			auto *tail{lastSuperframe.data() + lastSuperframeLength};
+			size_t bits{bitOffset};
+			for (; bits > 7U; bits -= 8U)
+				*tail++ = uint8_t(stream.read(8U));
+			if (bits)
+				*tail++ = uint8_t(stream.read(uint8_t(bits)) << (8U - bits));
+
+			stream = {lastSuperframe.data(), (lastSuperframeLength * 8U) + bitOffset};
+			stream.skip(lastBitOffset);
+			if (!decodeFrame(samples))
+			{
+				resetReservoir();
+				return -1;
+			}
+			samplesDecoded += frameLength;
+			--frameCount;
+		}
+
+		// The rest of the frames start bitOffset bits after the superframe header
+		const size_t start{bitOffset + 4U + 4U + byteOffsetBits + 3U};
+		if (start > length * 8U)
+		{
+			resetReservoir();
+			return -1;
+		}
+		stream = {data.data() + (start >> 3U), (length - (start >> 3U)) * 8U};
+		stream.skip(start & 7U);
+		resetBlockLengths = true;
+		for (size_t frame{0U}; frame < frameCount; ++frame)
+		{
+			if (!decodeFrame(samples + (samplesDecoded * channels)))
+			{
+				resetReservoir();
+				return -1;
+			}
+			samplesDecoded += frameLength;
+		}
+
+		// Keep whatever is left over as the start of the next superframe's first frame
+		const size_t end{stream.position() + (start & ~size_t{7U})};
+		lastBitOffset = end & 7U;
+		if ((end >> 3U) > length)
+		{
+			resetReservoir();
+			return -1;
+		}
+		lastSuperframeLength = length - (end >> 3U);
+		std::memcpy(lastSuperframe.data(), data.data() + (end >> 3U), lastSuperframeLength);
+		return int64_t(samplesDecoded);
+	}
+} // namespace libAudio::wma
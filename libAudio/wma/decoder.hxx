@@ -0,0 +1,275 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef LIBAUDIO_WMA_DECODER_HXX
+#define LIBAUDIO_WMA_DECODER_HXX
+
+#include <cstdint>
+#include <cstddef>
+#include <array>
+#include <vector>
+#include <substrate/span>
+#include "dsp.hxx"
+
+namespace libAudio::wma
+{
+	constexpr size_t maxChannels{2U};
+	constexpr uint8_t blockMinBits{7U};
+	constexpr uint8_t blockMaxBits{11U};
+	constexpr size_t blockMaxSize{1U << blockMaxBits};
+	constexpr size_t blockSizes{blockMaxBits - blockMinBits + 1U};
+	constexpr size_t highBandMaxSize{16U};
+	constexpr size_t noiseTableSize{8192U};
+	constexpr size_t maxCodedSuperframeSize{32768U};
+	constexpr size_t lspCoefficients{10U};
+	// The frame count in a superframe header is 4 bits
+	constexpr size_t maxSuperframeFrames{15U};
+
+	/*!
+	 * @internal
+	 * A most significant bit first reader over a block of WMA data. Reads past the end of
+	 * the data produce zeros rather than touching memory beyond it.
+	 */
+	struct bitStream_t final
+	{
+	private:
+		const uint8_t *_data{nullptr};
+		size_t _length{0U};
+		size_t _position{0U};
+
+	public:
+		bitStream_t() noexcept = default;
+		bitStream_t(const uint8_t *const data, const size_t lengthBits) noexcept :
+			_data{data}, _length{lengthBits} { }
+
+		// Gets the next bitCount bits (up to 32) without consuming them
+		[[nodiscard]] uint32_t peek(const uint8_t bitCount) const noexcept
+		{
+			if (!bitCount)
+				return 0U;
+			const size_t byte{_position >> 3U};
+			const size_t bytes{(_length + 7U) >> 3U};
+			uint64_t value{0U};
+			for (size_t i{0U}; i < 5U; ++i)
+				value = (value << 8U) | (byte + i < bytes ? _data[byte + i] : 0U);
+			const auto shift{40U - (_position & 7U) - bitCount};
+			return uint32_t((value >> shift) & ((uint64_t{1U} << bitCount) - 1U));
+		}
+
+		uint32_t read(const uint8_t bitCount) noexcept
+		{
+			const auto value{peek(bitCount)};
+			_position += bitCount;
+			return value;
+		}
+
+		bool readBit() noexcept { return read(1U); }
+		void skip(const size_t bitCount) noexcept { _position += bitCount; }
+		void align() noexcept { _position = (_position + 7U) & ~size_t{7U}; }
+		[[nodiscard]] size_t position() const noexcept { return _position; }
+		[[nodiscard]] size_t remaining() const noexcept { return _position < _length ? _length - _position : 0U; }
+	};
+
+	/*!
+	 * @internal
+	 * A variable length code lookup table, built to the same multi-level layout as ffmpeg's so
+	 * that most codes decode with a single lookup and the long tail with one or two more
+	 */
+	struct vlc_t final
+	{
+	private:
+		/*!
+		 * @internal
+		 * A positive length is a code of that many bits decoding to value, a negative one a
+		 * subtable of -length bits starting at value, and a zero one an invalid code
+		 */
+		struct entry_t final
+		{
+			int32_t value;
+			int8_t length;
+		};
+
+		struct code_t final
+		{
+			uint32_t code;
+			uint8_t length;
+			uint16_t symbol;
+		};
+
+		uint8_t _bits{0U};
+		std::vector<entry_t> _table{};
+
+		size_t build(const std::vector<code_t> &codes, uint32_t prefix, uint8_t prefixLength, uint8_t tableBits);
+
+	public:
+		vlc_t() noexcept = default;
+		vlc_t(uint8_t bits, substrate::span<const uint32_t> codes, substrate::span<const uint8_t> lengths);
+
+		// Decodes the next code, returning its symbol or -1 if the data holds no valid code
+		[[nodiscard]] int32_t read(bitStream_t &stream) const noexcept
+		{
+			size_t offset{0U};
+			auto bits{_bits};
+			while (true)
+			{
+				const auto &entry{_table[offset + stream.peek(bits)]};
+				if (entry.length > 0)
+				{
+					stream.skip(uint8_t(entry.length));
+					return entry.value;
+				}
+				if (!entry.length)
+					return -1;
+				stream.skip(bits);
+				offset = size_t(entry.value);
+				bits = uint8_t(-entry.length);
+			}
+		}
+	};
+
+	/*!
+	 * @internal
+	 * A coefficient VLC along with the run and level each of its symbols stands for
+	 */
+	struct coefficientVLC_t final
+	{
+		vlc_t vlc{};
+		std::vector<uint16_t> runs{};
+		std::vector<float> levels{};
+	};
+
+	/*!
+	 * @internal
+	 * A full inverse MDCT for one block size, computed through an n/4 point complex FFT. The
+	 * FFT runs iteratively over bit-reversed input, with its twiddles stored per pass so
+	 * that the vectorised butterfly kernels can stream straight through them.
+	 */
+	struct mdct_t final
+	{
+	private:
+		size_t _length{0U};
+		std::vector<float> _cos{};
+		std::vector<float> _sin{};
+		std::vector<uint16_t> _bitReverse{};
+		std::vector<fftComplex_t> _twiddles{};
+		std::vector<fftComplex_t> _scratch{};
+
+		void fft(const wmaDSP_t &dsp) noexcept;
+
+	public:
+		mdct_t() noexcept = default;
+		mdct_t(uint8_t bits);
+
+		// Computes _length output samples from _length / 2 coefficients
+		void inverse(float *output, const float *input, const wmaDSP_t &dsp) noexcept;
+	};
+
+	/*!
+	 * @internal
+	 * The format parameters of a WMA stream, as given by its container
+	 */
+	struct streamInfo_t final
+	{
+		uint16_t formatTag;
+		uint16_t channels;
+		uint32_t sampleRate;
+		uint32_t bitRate;
+		uint16_t blockAlign;
+		substrate::span<const uint8_t> extraData;
+	};
+
+	/*!
+	 * @internal
+	 * A decoder for Windows Media Audio versions 1 and 2. Every piece of decoding state lives
+	 * in the decoder_t, so any number of streams can be decoded at once on different threads;
+	 * the only shared data are the Huffman tables, which are built once and never modified.
+	 */
+	struct decoder_t final
+	{
+	private:
+		const wmaDSP_t &dsp;
+		uint8_t version{0U};
+		uint8_t channels{0U};
+		uint32_t sampleRate{0U};
+		uint16_t blockAlign{0U};
+		bool _valid{false};
+
+		bool useExpVLC{false};
+		bool useBitReservoir{false};
+		bool useVariableBlockLength{false};
+		bool useNoiseCoding{false};
+
+		uint8_t frameLengthBits{0U};
+		size_t frameLength{0U};
+		uint8_t blockSizeCount{0U};
+		uint8_t byteOffsetBits{0U};
+		uint8_t prevBlockLengthBits{0U};
+		uint8_t blockLengthBits{0U};
+		uint8_t nextBlockLengthBits{0U};
+		size_t blockLength{0U};
+		size_t blockPosition{0U};
+		bool resetBlockLengths{true};
+
+		size_t coefficientsStart{0U};
+		std::array<size_t, blockSizes> coefficientsEnd{};
+		std::array<std::array<uint16_t, 25U>, blockSizes> exponentBands{};
+		std::array<size_t, blockSizes> exponentSizes{};
+		std::array<size_t, blockSizes> highBandStart{};
+		std::array<std::array<uint16_t, highBandMaxSize>, blockSizes> exponentHighBands{};
+		std::array<size_t, blockSizes> exponentHighSizes{};
+
+		std::array<const coefficientVLC_t *, 2> coefficientVLCs{};
+		std::array<std::vector<float>, blockSizes> windows{};
+		std::array<mdct_t, blockSizes> transforms{};
+
+		float noiseMultiplier{0.0F};
+		std::vector<float> noiseTable{};
+		size_t noiseIndex{0U};
+		std::vector<float> lspCosTable{};
+
+		bool msStereo{false};
+		std::array<bool, maxChannels> channelCoded{};
+		std::array<std::array<bool, highBandMaxSize>, maxChannels> highBandCoded{};
+		std::array<std::array<int32_t, highBandMaxSize>, maxChannels> highBandValues{};
+		std::array<bool, maxChannels> exponentsInitialised{};
+		std::array<uint8_t, maxChannels> exponentsBlockSize{};
+		std::array<float, maxChannels> maxExponent{};
+		std::array<std::array<float, blockMaxSize>, maxChannels> exponents{};
+		std::array<std::array<float, blockMaxSize>, maxChannels> quantised{};
+		std::array<std::array<float, blockMaxSize>, maxChannels> coefficients{};
+		std::array<float, blockMaxSize * 2U> output{};
+		std::array<std::array<float, blockMaxSize * 2U>, maxChannels> frameOutput{};
+
+		bitStream_t stream{};
+		std::vector<uint8_t> lastSuperframe{};
+		size_t lastSuperframeLength{0U};
+		size_t lastBitOffset{0U};
+
+		void setupBands(float highFrequency) noexcept;
+		[[nodiscard]] float noise() noexcept;
+		[[nodiscard]] bool decodeHighBands(uint8_t blockSize, std::array<size_t, maxChannels> &coefficientCount) noexcept;
+		[[nodiscard]] bool decodeExponentsVLC(size_t channel) noexcept;
+		void decodeExponentsLSP(size_t channel) noexcept;
+		[[nodiscard]] bool decodeCoefficients(size_t channel, size_t count, uint8_t coefficientBits) noexcept;
+		void computeCoefficients(uint8_t blockSize, int32_t totalGain,
+			const std::array<size_t, maxChannels> &coefficientCount) noexcept;
+		void applyWindow(float *out) const noexcept;
+		[[nodiscard]] int32_t decodeBlock() noexcept;
+		[[nodiscard]] bool decodeFrame(int16_t *samples) noexcept;
+		void resetReservoir() noexcept { lastSuperframeLength = 0U; }
+
+	public:
+		decoder_t(const streamInfo_t &info);
+		decoder_t(const decoder_t &) = delete;
+		decoder_t(decoder_t &&) = delete;
+		decoder_t &operator =(const decoder_t &) = delete;
+		decoder_t &operator =(decoder_t &&) = delete;
+
+		[[nodiscard]] bool valid() const noexcept { return _valid; }
+		[[nodiscard]] size_t samplesPerFrame() const noexcept { return frameLength; }
+		[[nodiscard]] size_t maxSamples() const noexcept { return frameLength * channels * maxSuperframeFrames; }
+		[[nodiscard]] size_t superframeLength() const noexcept { return blockAlign; }
+		int64_t decodeSuperframe(substrate::span<const uint8_t> data, int16_t *samples) noexcept;
+	};
+} // namespace libAudio::wma
+
+#endif /*LIBAUDIO_WMA_DECODER_HXX*/
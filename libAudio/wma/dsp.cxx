@@ -0,0 +1,109 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <algorithm>
+#include <cmath>
+#include "dsp.hxx"
+#include "../cpuFeatures.hxx"
+
+/*!
+ * @internal
+ * @file wma/dsp.cxx
+ * @brief The scalar WMA transform and windowing kernels, and the runtime selection of the vectorised ones
+ * @author Rachel Mant <git@dragonmux.network>
+ * @date 2026
+ */
+
+namespace libAudio::wma
+{
+	namespace
+	{
+		void butterflies(fftComplex_t *const lower, fftComplex_t *const upper, const fftComplex_t *const twiddles,
+			const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+			{
+				const auto &twiddle{twiddles[i]};
+				const float re{upper[i].re * twiddle.re - upper[i].im * twiddle.im};
+				const float im{upper[i].re * twiddle.im + upper[i].im * twiddle.re};
+				upper[i] = {lower[i].re - re, lower[i].im - im};
+				lower[i] = {lower[i].re + re, lower[i].im + im};
+			}
+		}
+
+		void rotate(fftComplex_t *const values, const float *const cos, const float *const sin,
+			const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+			{
+				const auto value{values[i]};
+				values[i] = {value.im * sin[i] - value.re * cos[i], value.im * cos[i] + value.re * sin[i]};
+			}
+		}
+
+		void windowAdd(float *const out, const float *const in, const float *const window, const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+				out[i] += in[i] * window[i];
+		}
+
+		void windowReverse(float *const out, const float *const in, const float *const window,
+			const size_t count) noexcept
+		{
+			for (size_t i{0U}; i < count; ++i)
+				out[i] = in[i] * window[count - 1U - i];
+		}
+
+		int16_t clampSample(const float sample) noexcept
+			{ return int16_t(std::clamp<long>(std::lrint(sample), INT16_MIN, INT16_MAX)); }
+
+		void toInt16(int16_t *const out, const float *const left, const float *const right, const size_t count) noexcept
+		{
+			if (!right)
+			{
+				for (size_t i{0U}; i < count; ++i)
+					out[i] = clampSample(left[i]);
+				return;
+			}
+			for (size_t i{0U}; i < count; ++i)
+			{
+				out[(i * 2U) + 0U] = clampSample(left[i]);
+				out[(i * 2U) + 1U] = clampSample(right[i]);
+			}
+		}
+	} // namespace
+
+	void scalarWMADSP(wmaDSP_t &dsp) noexcept
+		{ dsp = {butterflies, rotate, windowAdd, windowReverse, toInt16}; }
+
+	/*!
+	 * @internal
+	 * Gets the table of WMA DSP kernels for this machine. This uses the shared CPU feature
+	 * detection, with AVX2 machines using the SSE2 kernels as the transforms are too short
+	 * for the wider vectors to pay for their setup.
+	 */
+	const wmaDSP_t &wmaDSP() noexcept
+	{
+		static const wmaDSP_t dsp{[]() noexcept
+		{
+			wmaDSP_t table{};
+			scalarWMADSP(table);
+			switch (cpuISA())
+			{
+#if defined(CPU_FEATURES_X86)
+				case cpuISA_t::avx2:
+				case cpuISA_t::sse2:
+					sse2WMADSP(table);
+					break;
+#elif defined(CPU_FEATURES_NEON)
+				case cpuISA_t::neon:
+					neonWMADSP(table);
+					break;
+#endif
+				default:
+					break;
+			}
+			return table;
+		}()};
+		return dsp;
+	}
+} // namespace libAudio::wma
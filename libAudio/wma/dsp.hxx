@@ -0,0 +1,61 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+// Vectorised transform and windowing kernels for the WMA decoder, selected at runtime
+#ifndef LIBAUDIO_WMA_DSP_HXX
+#define LIBAUDIO_WMA_DSP_HXX
+
+#include <cstdint>
+#include <cstddef>
+
+namespace libAudio::wma
+{
+	struct fftComplex_t final
+	{
+		float re;
+		float im;
+	};
+
+	/*!
+	 * @internal
+	 * The table of inner loops the WMA decoder's IMDCT and windowing run through. Every kernel
+	 * copes with any count, running its vector loop over as much of the data as it can and
+	 * finishing the rest off with scalar code, so the decoder need not care which it got.
+	 */
+	struct wmaDSP_t final
+	{
+		/*!
+		 * @internal
+		 * One radix-2 FFT pass over \p count pairs: t = upper * twiddle, upper = lower - t, lower += t
+		 */
+		void (*butterflies)(fftComplex_t *lower, fftComplex_t *upper, const fftComplex_t *twiddles,
+			size_t count) noexcept;
+		/*!
+		 * @internal
+		 * The IMDCT post-rotation: value = (im * sin - re * cos, im * cos + re * sin)
+		 */
+		void (*rotate)(fftComplex_t *values, const float *cos, const float *sin, size_t count) noexcept;
+		/*!
+		 * @internal
+		 * Windows the rising edge of a block onto the tail of the last: out = in * window + out
+		 */
+		void (*windowAdd)(float *out, const float *in, const float *window, size_t count) noexcept;
+		/*!
+		 * @internal
+		 * Windows the falling edge of a block: out[i] = in[i] * window[count - 1 - i]
+		 */
+		void (*windowReverse)(float *out, const float *in, const float *window, size_t count) noexcept;
+		/*!
+		 * @internal
+		 * Rounds, saturates and interleaves one or (if \p right is not \c nullptr) two channels to 16-bit PCM
+		 */
+		void (*toInt16)(int16_t *out, const float *left, const float *right, size_t count) noexcept;
+	};
+
+	void scalarWMADSP(wmaDSP_t &dsp) noexcept;
+	void sse2WMADSP(wmaDSP_t &dsp) noexcept;
+	void neonWMADSP(wmaDSP_t &dsp) noexcept;
+
+	[[nodiscard]] const wmaDSP_t &wmaDSP() noexcept;
+} // namespace libAudio::wma
+
+#endif /*LIBAUDIO_WMA_DSP_HXX*/
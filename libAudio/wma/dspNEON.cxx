@@ -0,0 +1,124 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__ARM_NEON) || defined(__aarch64__) || defined(_M_ARM64)
+#include <arm_neon.h>
+#include "dsp.hxx"
+
+namespace libAudio::wma
+{
+	namespace
+	{
+		void butterflies(fftComplex_t *const lower, fftComplex_t *const upper, const fftComplex_t *const twiddles,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			// The structure loads split the real and imaginary halves out for us
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto value{vld2q_f32(&upper[i].re)};
+				const auto twiddle{vld2q_f32(&twiddles[i].re)};
+				const auto base{vld2q_f32(&lower[i].re)};
+				const auto re{vmlsq_f32(vmulq_f32(value.val[0], twiddle.val[0]), value.val[1], twiddle.val[1])};
+				const auto im{vmlaq_f32(vmulq_f32(value.val[0], twiddle.val[1]), value.val[1], twiddle.val[0])};
+				vst2q_f32(&upper[i].re, float32x4x2_t{{vsubq_f32(base.val[0], re), vsubq_f32(base.val[1], im)}});
+				vst2q_f32(&lower[i].re, float32x4x2_t{{vaddq_f32(base.val[0], re), vaddq_f32(base.val[1], im)}});
+			}
+			for (; i < count; ++i)
+			{
+				const auto &twiddle{twiddles[i]};
+				const float re{upper[i].re * twiddle.re - upper[i].im * twiddle.im};
+				const float im{upper[i].re * twiddle.im + upper[i].im * twiddle.re};
+				upper[i] = {lower[i].re - re, lower[i].im - im};
+				lower[i] = {lower[i].re + re, lower[i].im + im};
+			}
+		}
+
+		void rotate(fftComplex_t *const values, const float *const cos, const float *const sin,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto value{vld2q_f32(&values[i].re)};
+				const auto cosine{vld1q_f32(cos + i)};
+				const auto sine{vld1q_f32(sin + i)};
+				const auto re{vmlsq_f32(vmulq_f32(value.val[1], sine), value.val[0], cosine)};
+				const auto im{vmlaq_f32(vmulq_f32(value.val[1], cosine), value.val[0], sine)};
+				vst2q_f32(&values[i].re, float32x4x2_t{{re, im}});
+			}
+			for (; i < count; ++i)
+			{
+				const auto value{values[i]};
+				values[i] = {value.im * sin[i] - value.re * cos[i], value.im * cos[i] + value.re * sin[i]};
+			}
+		}
+
+		void windowAdd(float *const out, const float *const in, const float *const window, const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+				vst1q_f32(out + i, vmlaq_f32(vld1q_f32(out + i), vld1q_f32(in + i), vld1q_f32(window + i)));
+			for (; i < count; ++i)
+				out[i] += in[i] * window[i];
+		}
+
+		void windowReverse(float *const out, const float *const in, const float *const window,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				// Reverse within each half, then swap the halves over
+				const auto reversed{vrev64q_f32(vld1q_f32(window + count - 4U - i))};
+				const auto coefficients{vcombine_f32(vget_high_f32(reversed), vget_low_f32(reversed))};
+				vst1q_f32(out + i, vmulq_f32(vld1q_f32(in + i), coefficients));
+			}
+			for (; i < count; ++i)
+				out[i] = in[i] * window[count - 1U - i];
+		}
+
+#if defined(__aarch64__) || defined(_M_ARM64)
+		// Converts 8 samples, rounding to nearest as lrint() would and saturating in the narrow
+		inline int16x8_t toInt16x8(const float *const samples) noexcept
+		{
+			return vcombine_s16(vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(samples))),
+				vqmovn_s32(vcvtnq_s32_f32(vld1q_f32(samples + 4U))));
+		}
+
+		void toInt16(int16_t *const out, const float *const left, const float *const right, const size_t count) noexcept
+		{
+			const auto clampSample{[](const float sample) noexcept
+				{ return vget_lane_s16(vqmovn_s32(vcvtnq_s32_f32(vdupq_n_f32(sample))), 0); }};
+			size_t i{0U};
+			if (!right)
+			{
+				for (; i + 8U <= count; i += 8U)
+					vst1q_s16(out + i, toInt16x8(left + i));
+				for (; i < count; ++i)
+					out[i] = clampSample(left[i]);
+				return;
+			}
+			for (; i + 8U <= count; i += 8U)
+				vst2q_s16(out + (i * 2U), int16x8x2_t{{toInt16x8(left + i), toInt16x8(right + i)}});
+			for (; i < count; ++i)
+			{
+				out[(i * 2U) + 0U] = clampSample(left[i]);
+				out[(i * 2U) + 1U] = clampSample(right[i]);
+			}
+		}
+#endif
+	} // namespace
+
+	void neonWMADSP(wmaDSP_t &dsp) noexcept
+	{
+		dsp.butterflies = butterflies;
+		dsp.rotate = rotate;
+		dsp.windowAdd = windowAdd;
+		dsp.windowReverse = windowReverse;
+		// 32-bit NEON has no round-to-nearest conversion, so keeps the scalar conversion
+#if defined(__aarch64__) || defined(_M_ARM64)
+		dsp.toInt16 = toInt16;
+#endif
+	}
+} // namespace libAudio::wma
+#endif
@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#include <algorithm>
+#include <cmath>
+#include <emmintrin.h>
+#include "dsp.hxx"
+
+#if (defined(__GNUC__) || defined(__clang__)) && !defined(__SSE2__)
+#define WMA_DSP_TARGET __attribute__((target("sse2")))
+#else
+#define WMA_DSP_TARGET
+#endif
+
+namespace libAudio::wma
+{
+	namespace
+	{
+		WMA_DSP_TARGET void butterflies(fftComplex_t *const lower, fftComplex_t *const upper,
+			const fftComplex_t *const twiddles, const size_t count) noexcept
+		{
+			// Flips the sign of the real half of each complex value
+			const auto negateReal{_mm_setr_ps(-0.0F, 0.0F, -0.0F, 0.0F)};
+			size_t i{0U};
+			for (; i + 2U <= count; i += 2U)
+			{
+				const auto value{_mm_loadu_ps(&upper[i].re)};
+				const auto twiddle{_mm_loadu_ps(&twiddles[i].re)};
+				const auto twiddleRe{_mm_shuffle_ps(twiddle, twiddle, _MM_SHUFFLE(2, 2, 0, 0))};
+				const auto twiddleIm{_mm_shuffle_ps(twiddle, twiddle, _MM_SHUFFLE(3, 3, 1, 1))};
+				const auto swapped{_mm_shuffle_ps(value, value, _MM_SHUFFLE(2, 3, 0, 1))};
+				const auto product
+				{
+					_mm_add_ps(_mm_mul_ps(value, twiddleRe),
+						_mm_xor_ps(_mm_mul_ps(swapped, twiddleIm), negateReal))
+				};
+				const auto base{_mm_loadu_ps(&lower[i].re)};
+				_mm_storeu_ps(&upper[i].re, _mm_sub_ps(base, product));
+				_mm_storeu_ps(&lower[i].re, _mm_add_ps(base, product));
+			}
+			for (; i < count; ++i)
+			{
+				const auto &twiddle{twiddles[i]};
+				const float re{upper[i].re * twiddle.re - upper[i].im * twiddle.im};
+				const float im{upper[i].re * twiddle.im + upper[i].im * twiddle.re};
+				upper[i] = {lower[i].re - re, lower[i].im - im};
+				lower[i] = {lower[i].re + re, lower[i].im + im};
+			}
+		}
+
+		WMA_DSP_TARGET void rotate(fftComplex_t *const values, const float *const cos, const float *const sin,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto first{_mm_loadu_ps(&values[i].re)};
+				const auto second{_mm_loadu_ps(&values[i + 2U].re)};
+				const auto re{_mm_shuffle_ps(first, second, _MM_SHUFFLE(2, 0, 2, 0))};
+				const auto im{_mm_shuffle_ps(first, second, _MM_SHUFFLE(3, 1, 3, 1))};
+				const auto cosine{_mm_loadu_ps(cos + i)};
+				const auto sine{_mm_loadu_ps(sin + i)};
+				const auto resultRe{_mm_sub_ps(_mm_mul_ps(im, sine), _mm_mul_ps(re, cosine))};
+				const auto resultIm{_mm_add_ps(_mm_mul_ps(im, cosine), _mm_mul_ps(re, sine))};
+				_mm_storeu_ps(&values[i].re, _mm_unpacklo_ps(resultRe, resultIm));
+				_mm_storeu_ps(&values[i + 2U].re, _mm_unpackhi_ps(resultRe, resultIm));
+			}
+			for (; i < count; ++i)
+			{
+				const auto value{values[i]};
+				values[i] = {value.im * sin[i] - value.re * cos[i], value.im * cos[i] + value.re * sin[i]};
+			}
+		}
+
+		WMA_DSP_TARGET void windowAdd(float *const out, const float *const in, const float *const window,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto product{_mm_mul_ps(_mm_loadu_ps(in + i), _mm_loadu_ps(window + i))};
+				_mm_storeu_ps(out + i, _mm_add_ps(_mm_loadu_ps(out + i), product));
+			}
+			for (; i < count; ++i)
+				out[i] += in[i] * window[i];
+		}
+
+		WMA_DSP_TARGET void windowReverse(float *const out, const float *const in, const float *const window,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			for (; i + 4U <= count; i += 4U)
+			{
+				const auto reversed{_mm_loadu_ps(window + count - 4U - i)};
+				const auto coefficients{_mm_shuffle_ps(reversed, reversed, _MM_SHUFFLE(0, 1, 2, 3))};
+				_mm_storeu_ps(out + i, _mm_mul_ps(_mm_loadu_ps(in + i), coefficients));
+			}
+			for (; i < count; ++i)
+				out[i] = in[i] * window[count - 1U - i];
+		}
+
+		// Converts 8 samples, clamping first as out of range conversions all come back as INT32_MIN
+		WMA_DSP_TARGET inline __m128i toInt16x8(const float *const samples) noexcept
+		{
+			const auto lowest{_mm_set1_ps(-32768.0F)};
+			const auto highest{_mm_set1_ps(32767.0F)};
+			const auto first{_mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples), lowest), highest)};
+			const auto second{_mm_min_ps(_mm_max_ps(_mm_loadu_ps(samples + 4U), lowest), highest)};
+			return _mm_packs_epi32(_mm_cvtps_epi32(first), _mm_cvtps_epi32(second));
+		}
+
+		int16_t clampSample(const float sample) noexcept
+			{ return int16_t(std::clamp<long>(std::lrint(sample), INT16_MIN, INT16_MAX)); }
+
+		WMA_DSP_TARGET void toInt16(int16_t *const out, const float *const left, const float *const right,
+			const size_t count) noexcept
+		{
+			size_t i{0U};
+			if (!right)
+			{
+				for (; i + 8U <= count; i += 8U)
+					_mm_storeu_si128(reinterpret_cast<__m128i *>(out + i), toInt16x8(left + i));
+				for (; i < count; ++i)
+					out[i] = clampSample(left[i]);
+				return;
+			}
+			for (; i + 8U <= count; i += 8U)
+			{
+				const auto leftSamples{toInt16x8(left + i)};
+				const auto rightSamples{toInt16x8(right + i)};
+				auto *const result{reinterpret_cast<__m128i *>(out + (i * 2U))};
+				_mm_storeu_si128(result + 0, _mm_unpacklo_epi16(leftSamples, rightSamples));
+				_mm_storeu_si128(result + 1, _mm_unpackhi_epi16(leftSamples, rightSamples));
+			}
+			for (; i < count; ++i)
+			{
+				out[(i * 2U) + 0U] = clampSample(left[i]);
+				out[(i * 2U) + 1U] = clampSample(right[i]);
+			}
+		}
+	} // namespace
+
+	void sse2WMADSP(wmaDSP_t &dsp) noexcept
+		{ dsp = {butterflies, rotate, windowAdd, windowReverse, toInt16}; }
+} // namespace libAudio::wma
+#endif
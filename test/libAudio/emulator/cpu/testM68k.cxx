@@ -20,6 +20,36 @@ private:
 		// Run through all 65536 possible instruction values and check they decode properly.
 		for (const auto &[insn, decodedOperation] : substrate::indexedIterator_t{instructionMap})
 			assertTrue(cpu.decodeInstruction(insn) == decodedOperation);
+		// Check that the pre-decoded table the CPU executes from agrees too
+		const auto &decodeTable{motorola68000_t::decodedOperations()};
+		for (const auto &[insn, decodedOperation] : substrate::indexedIterator_t{instructionMap})
+			assertTrue(decodeTable[insn] == decodedOperation);
+	}
+
+	void testSelfModifying()
+	{
+		// Set up a moveq #1, d0 followed by an rts, and run it so it winds up in the decoded instruction cache
+		writeAddress(0x000300U, uint16_t{0x7001U});
+		writeAddress(0x000302U, uint16_t{0x4e75U});
+		cpu.executeFrom(0x00000300U, 0x00800000U);
+		runStep();
+		assertEqual(cpu.readDataRegister(0U), 1U);
+		runStep();
+		assertEqual(cpu.readProgramCounter(), 0xffffffffU);
+		// Now rewrite the moveq to load 2 instead and check the modified instruction is what gets run
+		writeAddress(0x000300U, uint16_t{0x7002U});
+		cpu.executeFrom(0x00000300U, 0x00800000U);
+		runStep();
+		assertEqual(cpu.readDataRegister(0U), 2U);
+		runStep();
+		assertEqual(cpu.readProgramCounter(), 0xffffffffU);
+		// Finally, rewrite it with a long write straddling the previous page, and check that's picked up too
+		writeAddress(0x0002feU, uint32_t{0x4e717003U});
+		cpu.executeFrom(0x00000300U, 0x00800000U);
+		runStep();
+		assertEqual(cpu.readDataRegister(0U), 3U);
+		runStep();
+		assertEqual(cpu.readProgramCounter(), 0xffffffffU);
 	}
 
 	void runStep(const bool expectingTrap = false)
@@ -2743,7 +2773,7 @@ public:
 		assertEqual(cpu.readStatus(), 0x2000U);
 
 		// Register some memory for the tests to use
-		addressMap[{0x000000U, 0x800000U}] = std::make_unique<ram_t<uint32_t, 8_MiB>>();
+		mapPeripheral({0x000000U, 0x800000U}, std::make_unique<ram_t<uint32_t, 8_MiB>>());
 	}
 
 	void registerTests() final
@@ -2804,6 +2834,7 @@ public:
 		CXX_TEST(testSWAP)
 		CXX_TEST(testTRAP)
 		CXX_TEST(testTST)
+		CXX_TEST(testSelfModifying)
 		CXX_TEST(testDisplayRegs)
 	}
 };
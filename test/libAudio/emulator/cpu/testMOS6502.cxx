@@ -0,0 +1,238 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <memory>
+#include <crunch++.h>
+#include "emulator/cpu/mos6502.hxx"
+#include "emulator/ram.hxx"
+#include "emulator/unitsHelpers.hxx"
+
+struct interruptSource_t final : mos6502::irqRequester_t
+{
+	bool asserted{false};
+
+	[[nodiscard]] bool irqAsserted() const noexcept final { return asserted; }
+};
+
+class testMOS6502 final : public testsuite, mos6502MemoryMap_t
+{
+private:
+	mos6502_t cpu{*this};
+	interruptSource_t irqSource{};
+
+	template<size_t length> void writeCode(const uint16_t address, const std::array<uint8_t, length> &code)
+	{
+		for (size_t offset{0U}; offset < length; ++offset)
+			writeAddress(static_cast<uint16_t>(address + offset), code[offset]);
+	}
+
+	uint8_t runStep()
+	{
+		const auto result{cpu.step()};
+		assertTrue(result.validInsn);
+		return result.cyclesTaken;
+	}
+
+	void testADC()
+	{
+		// clc; lda #$50; adc #$50; rts - signed overflow into a negative result
+		writeCode(0x0200U, std::array<uint8_t, 6U>{{0x18U, 0xa9U, 0x50U, 0x69U, 0x50U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0xa0U);
+		assertEqual(cpu.readStatus() & 0xc3U, 0xc0U);
+		// sec; lda #$ff; adc #$00; rts - carry in wraps the result to 0, carrying out
+		writeCode(0x0200U, std::array<uint8_t, 6U>{{0x38U, 0xa9U, 0xffU, 0x69U, 0x00U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x00U);
+		assertEqual(cpu.readStatus() & 0xc3U, 0x03U);
+	}
+
+	void testSBC()
+	{
+		// sec; lda #$50; sbc #$f0; rts - borrows, and the signed result overflows
+		writeCode(0x0200U, std::array<uint8_t, 6U>{{0x38U, 0xa9U, 0x50U, 0xe9U, 0xf0U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x60U);
+		assertEqual(cpu.readStatus() & 0xc3U, 0x00U);
+		// clc; lda #$50; sbc #$b0; rts - the clear carry borrows one more, overflowing the other way
+		writeCode(0x0200U, std::array<uint8_t, 6U>{{0x18U, 0xa9U, 0x50U, 0xe9U, 0xb0U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x9fU);
+		assertEqual(cpu.readStatus() & 0xc3U, 0xc0U);
+	}
+
+	void testDecimal()
+	{
+		// sed; clc; lda #$19; adc #$28; cld; rts
+		writeCode(0x0200U, std::array<uint8_t, 8U>{{0xf8U, 0x18U, 0xa9U, 0x19U, 0x69U, 0x28U, 0xd8U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x47U);
+		assertFalse(cpu.readStatus() & 0x01U);
+		// sed; sec; lda #$99; adc #$01; cld; rts - carries out of the top digit
+		writeCode(0x0200U, std::array<uint8_t, 8U>{{0xf8U, 0x38U, 0xa9U, 0x99U, 0x69U, 0x01U, 0xd8U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x01U);
+		assertTrue(cpu.readStatus() & 0x01U);
+		// sed; sec; lda #$42; sbc #$13; cld; rts
+		writeCode(0x0200U, std::array<uint8_t, 8U>{{0xf8U, 0x38U, 0xa9U, 0x42U, 0xe9U, 0x13U, 0xd8U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readAccumulator(), 0x29U);
+		assertTrue(cpu.readStatus() & 0x01U);
+	}
+
+	void testBranches()
+	{
+		// ldx #$00; bne +$7f (not taken); beq (taken, crossing into the next page)
+		writeCode(0x02f0U, std::array<uint8_t, 6U>{{0xa2U, 0x00U, 0xd0U, 0x7fU, 0xf0U, 0x10U}});
+		// inx; bne -3 (taken, same page); rts
+		writeCode(0x0306U, std::array<uint8_t, 4U>{{0xe8U, 0xd0U, 0xfdU, 0x60U}});
+		cpu.call(0x02f0U);
+		assertEqual(runStep(), 2U);
+		// Not taken branches take 2 cycles
+		assertEqual(runStep(), 2U);
+		assertEqual(cpu.readProgramCounter(), 0x02f4U);
+		// Taken branches that cross a page take 4
+		assertEqual(runStep(), 4U);
+		assertEqual(cpu.readProgramCounter(), 0x0306U);
+		assertEqual(runStep(), 2U);
+		// And taken branches within the page take 3
+		assertEqual(runStep(), 3U);
+		assertEqual(cpu.readProgramCounter(), 0x0306U);
+		// Run the loop out, checking it went round the expected number of times
+		while (cpu.running())
+			runStep();
+		assertEqual(cpu.readIndexX(), 0x00U);
+		assertEqual(cpu.readProgramCounter(), 0x0000U);
+	}
+
+	void testCallReturn()
+	{
+		const auto stackPointer{cpu.readStackPointer()};
+		// jsr $0280; rts
+		writeCode(0x0200U, std::array<uint8_t, 4U>{{0x20U, 0x80U, 0x02U, 0x60U}});
+		// lda #$42; pha; pla; rts
+		writeCode(0x0280U, std::array<uint8_t, 5U>{{0xa9U, 0x42U, 0x48U, 0x68U, 0x60U}});
+		assertFalse(cpu.running());
+		cpu.call(0x0200U);
+		assertTrue(cpu.running());
+		assertEqual(runStep(), 6U);
+		assertEqual(cpu.readProgramCounter(), 0x0280U);
+		assertEqual(cpu.readStackPointer(), static_cast<uint8_t>(stackPointer - 4U));
+		assertEqual(runStep(), 2U);
+		assertEqual(runStep(), 3U);
+		assertEqual(runStep(), 4U);
+		assertEqual(runStep(), 6U);
+		assertEqual(cpu.readProgramCounter(), 0x0203U);
+		assertTrue(cpu.running());
+		// The final RTS lands back at the sentinel address, which idles the CPU
+		assertEqual(runStep(), 6U);
+		assertEqual(cpu.readProgramCounter(), 0x0000U);
+		assertEqual(cpu.readStackPointer(), stackPointer);
+		assertFalse(cpu.running());
+		// And while idle, each step burns a single cycle without running anything
+		assertEqual(runStep(), 1U);
+		assertEqual(cpu.readProgramCounter(), 0x0000U);
+		// A subroutine that never returns must fail once it runs out of cycles
+		writeCode(0x0200U, std::array<uint8_t, 3U>{{0x4cU, 0x00U, 0x02U}});
+		assertFalse(cpu.executeToReturn(0x0200U, 1000U));
+	}
+
+	void testJMPIndirect()
+	{
+		// jmp ($02ff) - the high byte of the target comes from $0200, not $0300
+		writeCode(0x0400U, std::array<uint8_t, 3U>{{0x6cU, 0xffU, 0x02U}});
+		writeAddress(0x02ffU, uint8_t{0x34U});
+		writeAddress(0x0200U, uint8_t{0x05U});
+		writeAddress(0x0300U, uint8_t{0x12U});
+		cpu.call(0x0400U);
+		assertEqual(runStep(), 5U);
+		assertEqual(cpu.readProgramCounter(), 0x0534U);
+	}
+
+	void testUndocumented()
+	{
+		// lax $80; sax $81 (with x modified by the lax, and a by the following lda); rts
+		writeAddress(0x0080U, uint8_t{0x5aU});
+		writeCode(0x0200U, std::array<uint8_t, 7U>{{0xa7U, 0x80U, 0xa9U, 0x0fU, 0x87U, 0x81U, 0x60U}});
+		assertTrue(cpu.executeToReturn(0x0200U, 100U));
+		assertEqual(cpu.readIndexX(), 0x5aU);
+		assertEqual(readAddress<uint8_t>(0x0081U), 0x0aU);
+		// A JAM opcode must stop the CPU as an invalid instruction
+		writeAddress(0x0200U, uint8_t{0x02U});
+		cpu.call(0x0200U);
+		const auto result{cpu.step()};
+		assertFalse(result.validInsn);
+		assertEqual(cpu.readProgramCounter(), 0x0200U);
+	}
+
+	void testInterrupts()
+	{
+		// The IRQ handler: inc $90; rti
+		writeCode(0x0500U, std::array<uint8_t, 3U>{{0xe6U, 0x90U, 0x40U}});
+		writeCode(mos6502::irqVectorAddress, std::array<uint8_t, 2U>{{0x00U, 0x05U}});
+		writeAddress(0x0090U, uint8_t{0x00U});
+		// cli; nop; sei; rts
+		writeCode(0x0200U, std::array<uint8_t, 4U>{{0x58U, 0xeaU, 0x78U, 0x60U}});
+		cpu.registerInterruptRequester(irqSource);
+		irqSource.asserted = true;
+		// Interrupts are disabled on entry to a call, until the code clears I
+		cpu.call(0x0200U);
+		assertFalse(cpu.hasPendingInterrupts());
+		assertEqual(runStep(), 2U);
+		assertEqual(cpu.readProgramCounter(), 0x0201U);
+		// Now the IRQ gets taken
+		assertEqual(runStep(), 7U);
+		assertEqual(cpu.readProgramCounter(), 0x0500U);
+		irqSource.asserted = false;
+		assertEqual(runStep(), 5U);
+		assertEqual(runStep(), 6U);
+		assertEqual(cpu.readProgramCounter(), 0x0201U);
+		assertEqual(readAddress<uint8_t>(0x0090U), 0x01U);
+		while (cpu.running())
+			runStep();
+		assertFalse(cpu.hasPendingInterrupts());
+	}
+
+	void testAdvanceClock()
+	{
+		// lda $1234,x (crossing a page); rts
+		writeCode(0x0200U, std::array<uint8_t, 4U>{{0xbdU, 0xffU, 0x12U, 0x60U}});
+		cpu.writeIndexX(0x01U);
+		cpu.call(0x0200U);
+		// The instruction runs on the first cycle, and then the CPU waits out the rest of the 5 it takes
+		assertTrue(cpu.advanceClock());
+		assertEqual(cpu.readProgramCounter(), 0x0203U);
+		assertEqual(cpu.cyclesUntilStep(), 5U);
+		cpu.skipCycles(4U);
+		assertEqual(cpu.cyclesUntilStep(), 1U);
+		assertTrue(cpu.advanceClock());
+		assertEqual(cpu.readProgramCounter(), 0x0000U);
+	}
+
+public:
+	testMOS6502() noexcept : testsuite{}, mos6502MemoryMap_t{}
+	{
+		// Check the CPU starts idle, with the stack empty
+		assertFalse(cpu.running());
+		assertEqual(cpu.readStackPointer(), 0xffU);
+		assertEqual(cpu.readProgramCounter(), 0x0000U);
+
+		// Register some memory for the tests to use
+		mapPeripheral({0x0000U, 0x10000U}, std::make_unique<ram_t<uint32_t, 64_KiB>>());
+	}
+
+	void registerTests() final
+	{
+		CXX_TEST(testADC)
+		CXX_TEST(testSBC)
+		CXX_TEST(testDecimal)
+		CXX_TEST(testBranches)
+		CXX_TEST(testCallReturn)
+		CXX_TEST(testJMPIndirect)
+		CXX_TEST(testUndocumented)
+		CXX_TEST(testInterrupts)
+		CXX_TEST(testAdvanceClock)
+	}
+};
+
+CRUNCHpp_TESTS(testMOS6502)
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <array>
+#include <algorithm>
+#include <crunch++.h>
+#include "emulator/memoryMap.hxx"
+#include "emulator/sound/mos6581.hxx"
+
+constexpr static uint32_t clockFrequency{985248U};
+constexpr static uint32_t sampleRate{48000U};
+
+void writeRegister(peripheral_t<uint32_t> &periph, const uint8_t reg, const uint8_t value) noexcept
+{
+	std::array<uint8_t, 1U> data{{value}};
+	periph.writeAddress(reg, data);
+}
+
+uint8_t readRegister(const peripheral_t<uint32_t> &periph, const uint8_t reg) noexcept
+{
+	std::array<uint8_t, 1U> result{};
+	periph.readAddress(reg, result);
+	return result[0U];
+}
+
+class testMOS6581 final : public testsuite
+{
+	void testRegisterIO()
+	{
+		mos6581_t sid{clockFrequency, sampleRate, sidModel_t::mos6581};
+		// The write-only registers all read as 0, and the paddles as if nothing were connected
+		writeRegister(sid, 0x00U, 0xffU);
+		writeRegister(sid, 0x18U, 0x0fU);
+		assertEqual(readRegister(sid, 0x00U), 0x00U);
+		assertEqual(readRegister(sid, 0x18U), 0x00U);
+		assertEqual(readRegister(sid, 0x19U), 0xffU);
+		assertEqual(readRegister(sid, 0x1aU), 0xffU);
+		// Voice 3 is silent until it's started
+		assertEqual(readRegister(sid, 0x1bU), 0x00U);
+		assertEqual(readRegister(sid, 0x1cU), 0x00U);
+		// With no buffer to fill, there should be no events coming
+		assertEqual(sid.cyclesUntilEvent(), UINT32_MAX);
+	}
+
+	void testEnvelope()
+	{
+		mos6581_t sid{clockFrequency, sampleRate, sidModel_t::mos6581};
+		// Set voice 3 up with the fastest attack, full sustain and a sawtooth, and gate it on
+		writeRegister(sid, 0x0eU, 0x00U);
+		writeRegister(sid, 0x0fU, 0x10U);
+		writeRegister(sid, 0x13U, 0x00U);
+		writeRegister(sid, 0x14U, 0xf0U);
+		writeRegister(sid, 0x12U, 0x21U);
+		// The fastest attack steps the envelope up every 9 cycles, so is part way through after 1000
+		assertTrue(sid.clockCycles(1000U));
+		const auto level{readRegister(sid, 0x1cU)};
+		assertNotEqual(level, 0x00U);
+		assertNotEqual(level, 0xffU);
+		// And the oscillator should be running too
+		assertNotEqual(readRegister(sid, 0x1bU), 0x00U);
+		// 255 steps take 2295 cycles, after which the envelope sits at the sustain level
+		assertTrue(sid.clockCycles(2000U));
+		assertEqual(readRegister(sid, 0x1cU), 0xffU);
+		assertTrue(sid.clockCycles(10000U));
+		assertEqual(readRegister(sid, 0x1cU), 0xffU);
+		// Releasing the gate then lets the envelope fall back to 0
+		writeRegister(sid, 0x12U, 0x20U);
+		assertTrue(sid.clockCycles(clockFrequency));
+		assertEqual(readRegister(sid, 0x1cU), 0x00U);
+	}
+
+	void testOutput()
+	{
+		mos6581_t sid{clockFrequency, sampleRate, sidModel_t::mos8580};
+		std::array<int16_t, 64U> buffer{};
+		sid.outputTo(buffer);
+		assertFalse(sid.outputFull());
+		// The event should be on the cycle that generates the last sample the buffer has room for
+		const auto cycles{sid.cyclesUntilEvent()};
+		assertEqual(cycles, clockFrequency * buffer.size() / sampleRate);
+		assertTrue(sid.clockCycles(cycles - 1U));
+		assertFalse(sid.outputFull());
+		assertEqual(sid.cyclesUntilEvent(), 1U);
+		assertTrue(sid.clockCycle());
+		assertTrue(sid.outputFull());
+		// With the chip silent, the samples should all be silent too
+		for (const auto &sample : buffer)
+			assertEqual(sample, 0);
+		// Once full, more cycles just drop their samples
+		assertEqual(sid.cyclesUntilEvent(), UINT32_MAX);
+		assertTrue(sid.clockCycles(1000U));
+		assertTrue(sid.outputFull());
+	}
+
+	void testSound()
+	{
+		mos6581_t sid{clockFrequency, sampleRate, sidModel_t::mos8580};
+		std::array<int16_t, 480U> buffer{};
+		// Play a full volume 1kHz pulse on voice 1 with an instant attack
+		writeRegister(sid, 0x00U, 0x89U);
+		writeRegister(sid, 0x01U, 0x10U);
+		writeRegister(sid, 0x02U, 0x00U);
+		writeRegister(sid, 0x03U, 0x08U);
+		writeRegister(sid, 0x05U, 0x00U);
+		writeRegister(sid, 0x06U, 0xf0U);
+		writeRegister(sid, 0x18U, 0x0fU);
+		writeRegister(sid, 0x04U, 0x41U);
+		sid.outputTo(buffer);
+		assertTrue(sid.clockCycles(sid.cyclesUntilEvent() - 1U));
+		assertTrue(sid.clockCycle());
+		assertTrue(sid.outputFull());
+		// The output should swing both sides of 0
+		int16_t minimum{0};
+		int16_t maximum{0};
+		for (const auto &sample : buffer)
+		{
+			minimum = std::min(minimum, sample);
+			maximum = std::max(maximum, sample);
+		}
+		assertTrue(minimum < -4096);
+		assertTrue(maximum > 4096);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testRegisterIO)
+		CXX_TEST(testEnvelope)
+		CXX_TEST(testOutput)
+		CXX_TEST(testSound)
+	}
+};
+
+CRUNCHpp_TESTS(testMOS6581)
@@ -37,6 +37,7 @@ class testSTeDAC final : public testsuite, m68kMemoryMap_t
 	motorola68000_t cpu{*this, 8_MHz};
 	mc68901_t mfp{2457600U, cpu, 6U};
 	steDAC_t dac{50_kHz + 66U, mfp};
+	ram_t<uint32_t, 2_KiB> *ram{nullptr};
 
 	void runMicrowireCycle(uint16_t mask)
 	{
@@ -245,12 +246,69 @@ class testSTeDAC final : public testsuite, m68kMemoryMap_t
 		}
 	}
 
+	void testBulkClocking()
+	{
+		// Set the DMA controller up to stream the first 254 bytes of RAM out, without looping,
+		// at 25033Hz (~25kHz), marked as stopped initially
+		writeRegister(dac, 0x01U, uint8_t{0x00U});
+		writeRegister(dac, 0x03U, uint8_t{0x00U});
+		writeRegister(dac, 0x05U, uint8_t{0x00U});
+		writeRegister(dac, 0x07U, uint8_t{0x00U});
+		writeRegister(dac, 0x0fU, uint8_t{0x00U});
+		writeRegister(dac, 0x11U, uint8_t{0x00U});
+		writeRegister(dac, 0x13U, uint8_t{0xfeU});
+		writeRegister(dac, 0x21U, uint8_t{0x82U});
+		// Nothing should be coming up while playback is stopped
+		assertEqual(dac.cyclesUntilEvent(), UINT32_MAX);
+		// Now enable playback, and check the end of the sample is 254 samples of 2 cycles each away
+		writeRegister(dac, 0x01U, uint8_t{0x01U});
+		assertEqual(dac.cyclesUntilEvent(), 508U);
+		// Run 300 of those cycles in bulk and check we're now 150 samples in
+		assertTrue(dac.clockCycles(300U));
+		assertEqual(dac.sample(*this), static_cast<int8_t>(151U) * 64);
+		assertEqual(dac.cyclesUntilEvent(), 208U);
+		// Run all but the last of the remaining cycles in bulk, and check the last sample is being played
+		assertTrue(dac.clockCycles(207U));
+		assertEqual(dac.sample(*this), static_cast<int8_t>(254U) * 64);
+		// The final cycle should then stop playback
+		assertTrue(dac.clockCycle());
+		assertEqual(dac.sample(*this), 0);
+		assertEqual(dac.cyclesUntilEvent(), UINT32_MAX);
+	}
+
+	void testDirectSample()
+	{
+		// Set the DMA controller up to stream the stereo data out from the upper 1KiB of RAM, looping,
+		// at the fastest playback rate (50066Hz, ~50kHz), and start playback
+		writeRegister(dac, 0x03U, uint8_t{0x00U});
+		writeRegister(dac, 0x05U, uint8_t{0x04U});
+		writeRegister(dac, 0x07U, uint8_t{0x00U});
+		writeRegister(dac, 0x0fU, uint8_t{0x00U});
+		writeRegister(dac, 0x11U, uint8_t{0x05U});
+		writeRegister(dac, 0x13U, uint8_t{0xfcU});
+		writeRegister(dac, 0x21U, uint8_t{0x03U});
+		writeRegister(dac, 0x01U, uint8_t{0x03U});
+		// Check that reading the samples straight from RAM gives the same results as going via the memory map
+		const auto memory{ram->directMemory()};
+		for ([[maybe_unused]] const auto &cycle : substrate::indexSequence_t{1024U})
+		{
+			assertEqual(dac.sample(memory), dac.sample(*this));
+			assertTrue(dac.clockCycle());
+		}
+		// If the sample being played lies outside the memory given, we should get silence back
+		assertNotEqual(dac.sample(memory), 0);
+		assertEqual(dac.sample(memory.subspan(0U, 0x400U)), 0);
+		// Likewise once playback is stopped
+		writeRegister(dac, 0x01U, uint8_t{0x00U});
+		assertEqual(dac.sample(memory), 0);
+	}
+
 public:
 	testSTeDAC() noexcept : testsuite{}, m68kMemoryMap_t{}
 	{
 		// Register some memory for the sample tests, and fill with a couple of patterns that make it easy to see
 		// if things are working right within the sampler
-		addressMap[{0x000000U, 0x000800U}] = std::make_unique<ram_t<uint32_t, 2_KiB>>();
+		ram = &mapPeripheral({0x000000U, 0x000800U}, std::make_unique<ram_t<uint32_t, 2_KiB>>());
 
 		// Write a mono stream to the first 254 bytes of RAM
 		for (const auto &sample : substrate::indexSequence_t{1U, 255U})
@@ -272,6 +330,8 @@ public:
 		CXX_TEST(test50kMonoSampleLoop)
 		CXX_TEST(test25kMonoSampleNoLoop)
 		CXX_TEST(test50kStereoSampleNoLoop)
+		CXX_TEST(testBulkClocking)
+		CXX_TEST(testDirectSample)
 	}
 };
 
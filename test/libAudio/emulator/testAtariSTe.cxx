@@ -1,5 +1,8 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2025 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <algorithm>
+#include <memory>
 #include <string_view>
 #include <crunch++.h>
 #include <substrate/fd>
@@ -8,6 +11,7 @@
 #include "emulator/atariSTe.hxx"
 
 using namespace std::literals::string_view_literals;
+using substrate::fd_t;
 
 using m68kMemoryMap_t = memoryMap_t<uint32_t, 0x00ffffffU>;
 
@@ -126,6 +130,45 @@ class testAtariSTe final : public testsuite
 		assertEqual(mmio.readAddress<uint8_t>(0x010096U), 0x83U);
 	}
 
+	void testRender()
+	{
+		// Having initialised the subtune, render a couple of 50Hz frames worth of samples
+		std::array<int16_t, 1920U> samples{};
+		assertTrue(emulator.render(samples));
+		// A PSG-only tune should have produced some non-silent output by now
+		assertTrue(std::any_of(samples.begin(), samples.end(), [](const int16_t sample) { return sample != 0; }));
+		// Rendering an empty block should do nothing and succeed
+		assertTrue(emulator.render({}));
+
+		// Two machines started from the same state must produce the same samples whether rendered
+		// a block at a time or stepped through and read out one sample at a time
+		const auto rendered{std::make_unique<atariSTe_t>()};
+		const auto stepped{std::make_unique<atariSTe_t>()};
+		assertTrue(rendered->copyToRAM(sndh));
+		assertTrue(rendered->init(1U));
+		assertTrue(stepped->copyToRAM(sndh));
+		assertTrue(stepped->init(1U));
+		std::array<int16_t, 4800U> renderedSamples{};
+		assertTrue(rendered->render(renderedSamples));
+		for (const auto &expected : renderedSamples)
+		{
+			while (!stepped->sampleReady())
+				assertTrue(stepped->advanceClock());
+			assertEqual(stepped->readSample(), expected);
+		}
+		// Which must leave both in the same place, so the next block still matches
+		std::array<int16_t, 960U> nextSamples{};
+		assertTrue(rendered->render(nextSamples));
+		for (const auto &expected : nextSamples)
+		{
+			while (!stepped->sampleReady())
+				assertTrue(stepped->advanceClock());
+			assertEqual(stepped->readSample(), expected);
+		}
+		assertTrue(std::any_of(renderedSamples.begin(), renderedSamples.end(),
+			[](const int16_t sample) { return sample != 0; }));
+	}
+
 public:
 	testAtariSTe() noexcept : testsuite{},
 		sndh
@@ -133,8 +176,8 @@ public:
 			[this]()
 			{
 				// Open the SNDH file of test data, and read it all into memory
-				const fd_t sndhFile{sndhFileName, O_RDONLY | O_NOCTTY};
-				assertNotEqual(sndhFile, -1);
+				const inputSource_t sndhFile{fd_t{sndhFileName, O_RDONLY | O_NOCTTY}};
+				assertTrue(sndhFile.valid());
 				assertGreaterThan(sndhFile.length(), 0);
 				// Use the decruncher to get something valid to use with copyToRAM() etc
 				return sndhDecruncher_t{sndhFile};
@@ -148,6 +191,7 @@ public:
 		CXX_TEST(testConfigureTimer)
 		CXX_TEST(testCopyToRAM)
 		CXX_TEST(testInit)
+		CXX_TEST(testRender)
 	}
 };
 
@@ -300,11 +300,11 @@ public:
 	testAtariSTeROMs() noexcept : testsuite{}, m68kMemoryMap_t{}
 	{
 		// Register some memory and the ROMs for the tests to use
-		addressMap[{0x000000U, 0x100000U}] = std::make_unique<ram_t<uint32_t, 1_MiB>>();
-		addressMap[{0x100000U, 0x200000U}] = std::make_unique<atariSTeROMs_t>
+		mapPeripheral({0x000000U, 0x100000U}, std::make_unique<ram_t<uint32_t, 1_MiB>>());
+		mapPeripheral({0x100000U, 0x200000U}, std::make_unique<atariSTeROMs_t>
 		(
 			cpu, static_cast<m68kMemoryMap_t &>(*this), heapBase, heapSize
-		);
+		));
 
 		// Set up the GEMDOS TRAP handler so we can use it in the tests
 		writeAddress(0x000084U, uint32_t{0x100000U + atariSTeROMs_t::handlerAddressGEMDOS});
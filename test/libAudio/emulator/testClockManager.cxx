@@ -42,11 +42,44 @@ class testClockManager final : public testsuite
 		}
 	}
 
+	void testBulkAdvance()
+	{
+		// Run a pair of managers for the same clocks, one a cycle at a time and one in bulk, checking they agree
+		clockManager_t singleCycles{8_MHz, 2457600};
+		clockManager_t bulkCycles{8_MHz, 2457600};
+		for (const auto step : substrate::indexSequence_t{1U, 200U})
+		{
+			// Check how far away the next few target cycles are, then step that many base cycles one at a time
+			const auto targetCycles{static_cast<uint32_t>((step % 5U) + 1U)};
+			const auto cycles{bulkCycles.cyclesUntil(targetCycles)};
+			uint32_t issued{0U};
+			for (const auto cycle : substrate::indexSequence_t{cycles})
+			{
+				if (singleCycles.advanceCycle())
+					++issued;
+				// The final target cycle must land on the last of the base cycles
+				assertEqual(issued == targetCycles, cycle == cycles - 1U);
+			}
+			// Now advance the bulk manager the same amount, and check it made the same number of target cycles
+			assertEqual(bulkCycles.advanceCycles(cycles), targetCycles);
+			// Finally, run both forward an amount that does not land on a target cycle and check they still agree
+			uint32_t singleIssued{0U};
+			for ([[maybe_unused]] const auto cycle : substrate::indexSequence_t{step})
+				singleIssued += singleCycles.advanceCycle() ? 1U : 0U;
+			assertEqual(bulkCycles.advanceCycles(static_cast<uint32_t>(step)), singleIssued);
+		}
+		// A manager with no clocks set up should never issue cycles
+		clockManager_t invalid{};
+		assertEqual(invalid.cyclesUntil(1U), UINT32_MAX);
+		assertEqual(invalid.advanceCycles(1000U), 0U);
+	}
+
 public:
 	void registerTests() final
 	{
 		CXX_TEST(testWholeRatio)
 		CXX_TEST(testFractionalRatio)
+		CXX_TEST(testBulkAdvance)
 	}
 };
 
@@ -0,0 +1,112 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <array>
+#include <crunch++.h>
+#include <substrate/indexed_iterator>
+#include "emulator/memoryMap.hxx"
+#include "emulator/ram.hxx"
+#include "emulator/unitsHelpers.hxx"
+
+using m68kMemoryMap_t = memoryMap_t<uint32_t, 0x00ffffffU>;
+
+// A small register file that can only be accessed through the virtual accessors
+struct registers_t final : public peripheral_t<uint32_t>
+{
+	std::array<uint8_t, 4U> registers{};
+	mutable uint32_t reads{0U};
+	uint32_t writes{0U};
+
+	void readAddress(const uint32_t address, substrate::span<uint8_t> data) const noexcept final
+	{
+		++reads;
+		for (auto [idx, byte] : substrate::indexedIterator_t{data})
+			byte = registers[(address + idx) & 3U];
+	}
+
+	void writeAddress(const uint32_t address, const substrate::span<uint8_t> &data) noexcept final
+	{
+		++writes;
+		for (const auto &[idx, byte] : substrate::indexedIterator_t{data})
+			registers[(address + idx) & 3U] = byte;
+	}
+};
+
+class testMemoryMap final : public testsuite, m68kMemoryMap_t
+{
+	ram_t<uint32_t, 2_KiB> *ram{nullptr};
+	registers_t *lowRegisters{nullptr};
+	registers_t *highRegisters{nullptr};
+
+	void testDirectRAM()
+	{
+		// Check that values are stored big endian in the RAM, without going through the peripheral
+		writeAddress(0x000100U, uint32_t{0x12345678U});
+		assertEqual(ram->subspan(0x100U, 4U)[0], 0x12U);
+		assertEqual(ram->subspan(0x100U, 4U)[3], 0x78U);
+		assertEqual(readAddress<uint32_t>(0x000100U), 0x12345678U);
+		assertEqual(readAddress<uint16_t>(0x000102U), 0x5678U);
+		assertEqual(readAddress<uint8_t>(0x000101U), 0x34U);
+		// Check signed values come back sign extended properly
+		writeAddress(0x000200U, int16_t{-2});
+		assertEqual(readAddress<int16_t>(0x000200U), int16_t{-2});
+		assertEqual(readAddress<int8_t>(0x000201U), int8_t{-2});
+		// Check the address bus mask is applied
+		assertEqual(readAddress<uint32_t>(0x01000100U), 0x12345678U);
+	}
+
+	void testUnmapped()
+	{
+		// The page just past the RAM is unmapped, as is most of the page the registers live in
+		assertEqual(readAddress<uint32_t>(0x000800U), 0U);
+		assertEqual(readAddress<uint8_t>(0xff8804U), 0U);
+		writeAddress(0xff8804U, uint8_t{0xaaU});
+		assertEqual(lowRegisters->writes, 0U);
+	}
+
+	void testPeripherals()
+	{
+		// Check that accesses to the register files go through their accessors
+		writeAddress(0xff8800U, uint16_t{0x1234U});
+		assertEqual(lowRegisters->writes, 1U);
+		assertEqual(lowRegisters->registers[0], 0x12U);
+		assertEqual(lowRegisters->registers[1], 0x34U);
+		assertEqual(readAddress<uint16_t>(0xff8800U), 0x1234U);
+		assertEqual(lowRegisters->reads, 1U);
+
+		// The second register file shares its page with the third, so check both decode properly
+		writeAddress(0xfffa00U, uint8_t{0x55U});
+		writeAddress(0xfffa10U, uint8_t{0xaaU});
+		assertEqual(readAddress<uint8_t>(0xfffa00U), 0x55U);
+		assertEqual(readAddress<uint8_t>(0xfffa10U), 0xaaU);
+		assertEqual(readAddress<uint8_t>(0xfffa08U), 0x00U);
+		assertEqual(highRegisters->registers[0], 0xaaU);
+	}
+
+	void testRAMBoundary()
+	{
+		// Check that accesses right up to the end of the RAM are handled properly
+		writeAddress(0x0007fcU, uint32_t{0xdeadbeefU});
+		assertEqual(readAddress<uint32_t>(0x0007fcU), 0xdeadbeefU);
+		assertEqual(readAddress<uint16_t>(0x0007feU), 0xbeefU);
+		assertEqual(readAddress<uint8_t>(0x0007ffU), 0xefU);
+	}
+
+public:
+	testMemoryMap() noexcept : testsuite{}, m68kMemoryMap_t{}
+	{
+		ram = &mapPeripheral({0x000000U, 0x000800U}, std::make_unique<ram_t<uint32_t, 2_KiB>>());
+		lowRegisters = &mapPeripheral({0xff8800U, 0xff8804U}, std::make_unique<registers_t>());
+		mapPeripheral({0xfffa00U, 0xfffa04U}, std::make_unique<registers_t>());
+		highRegisters = &mapPeripheral({0xfffa10U, 0xfffa14U}, std::make_unique<registers_t>());
+	}
+
+	void registerTests() final
+	{
+		CXX_TEST(testDirectRAM)
+		CXX_TEST(testUnmapped)
+		CXX_TEST(testPeripherals)
+		CXX_TEST(testRAMBoundary)
+	}
+};
+
+CRUNCHpp_TESTS(testMemoryMap)
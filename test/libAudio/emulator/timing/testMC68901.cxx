@@ -278,6 +278,34 @@ class testMC68901 final : public testsuite, m68kMemoryMap_t
 		assertEqual(mc68901::timer_t::prescalingFor(8U), UINT32_MAX);
 	}
 
+	void testBulkClocking()
+	{
+		// Stop all the timers and clear out any pending interrupts
+		for (const auto timer : substrate::indexSequence_t{4U})
+			mfp.configureTimer(timer, 0U, 0U);
+		writeRegister(mfp, 0x0bU, uint8_t{0x00U});
+		writeRegister(mfp, 0x0dU, uint8_t{0x00U});
+		// With nothing running, there should be no events coming up
+		assertEqual(mfp.cyclesUntilEvent(), UINT32_MAX);
+
+		// Enable timer C's IRQ, and set it to count down from 3 with the clock divided by 64
+		writeRegister(mfp, 0x09U, uint8_t{0x20U});
+		writeRegister(mfp, 0x15U, uint8_t{0x20U});
+		mfp.configureTimer(2U, 3U, 5U);
+		// The timer should then fire after 3 * 64 clock cycles
+		assertEqual(mfp.cyclesUntilEvent(), 192U);
+		// Run all but the last of those cycles in bulk, and check the timer counted down but did not fire
+		assertTrue(mfp.clockCycles(191U));
+		assertEqual(readRegister<uint8_t>(mfp, 0x23U), 0x01U);
+		assertEqual(readRegister<uint8_t>(mfp, 0x0dU), 0x00U);
+		assertEqual(mfp.cyclesUntilEvent(), 1U);
+		// Now run the last cycle and check the timer fires, after which the IRQ is re-requested every cycle
+		assertTrue(mfp.clockCycle());
+		assertEqual(readRegister<uint8_t>(mfp, 0x23U), 0x03U);
+		assertEqual(readRegister<uint8_t>(mfp, 0x0dU), 0x20U);
+		assertEqual(mfp.cyclesUntilEvent(), 1U);
+	}
+
 public:
 	testMC68901() noexcept : testsuite{}, m68kMemoryMap_t{} { }
 
@@ -289,6 +317,7 @@ public:
 		CXX_TEST(testIRQGeneration)
 		CXX_TEST(testGPIO7Events)
 		CXX_TEST(testTimerAEventCounting)
+		CXX_TEST(testBulkClocking)
 		CXX_TEST(testPrescalingMapping)
 	}
 };
@@ -0,0 +1,134 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <array>
+#include <crunch++.h>
+#include "emulator/memoryMap.hxx"
+#include "emulator/timing/mos6526.hxx"
+
+void writeRegister(peripheral_t<uint32_t> &periph, const uint8_t reg, const uint8_t value) noexcept
+{
+	std::array<uint8_t, 1U> data{{value}};
+	periph.writeAddress(reg, data);
+}
+
+uint8_t readRegister(const peripheral_t<uint32_t> &periph, const uint8_t reg) noexcept
+{
+	std::array<uint8_t, 1U> result{};
+	periph.readAddress(reg, result);
+	return result[0U];
+}
+
+class testMOS6526 final : public testsuite
+{
+	void testRegisterIO()
+	{
+		mos6526_t cia{985248U};
+		// With nothing driving the ports, the inputs read high and the outputs read back what was written
+		assertEqual(readRegister(cia, 0x00U), 0xffU);
+		writeRegister(cia, 0x02U, 0x0fU);
+		writeRegister(cia, 0x00U, 0x5aU);
+		assertEqual(readRegister(cia, 0x02U), 0x0fU);
+		assertEqual(readRegister(cia, 0x00U), 0xfaU);
+		// The registers repeat every 16 bytes
+		assertEqual(readRegister(cia, 0x12U), 0x0fU);
+		// Writing the timer latch while the timer is stopped loads the counter too
+		writeRegister(cia, 0x04U, 0x34U);
+		writeRegister(cia, 0x05U, 0x12U);
+		assertEqual(readRegister(cia, 0x04U), 0x34U);
+		assertEqual(readRegister(cia, 0x05U), 0x12U);
+		// The force load strobe doesn't read back
+		writeRegister(cia, 0x0eU, 0x10U);
+		assertEqual(readRegister(cia, 0x0eU), 0x00U);
+		// Nothing is running, so there should be no events coming
+		assertEqual(cia.cyclesUntilEvent(), UINT32_MAX);
+		assertFalse(cia.irqAsserted());
+	}
+
+	void testTimerUnderflow()
+	{
+		mos6526_t cia{985248U};
+		writeRegister(cia, 0x04U, 0x10U);
+		writeRegister(cia, 0x05U, 0x00U);
+		// Enable the timer A interrupt and start the timer in continuous mode
+		writeRegister(cia, 0x0dU, 0x81U);
+		writeRegister(cia, 0x0eU, 0x11U);
+		// The timer counts down through 0 and underflows on the cycle after
+		assertEqual(cia.cyclesUntilEvent(), 0x11U);
+		assertTrue(cia.clockCycles(0x10U));
+		assertEqual(readRegister(cia, 0x04U), 0x00U);
+		assertFalse(cia.irqAsserted());
+		assertEqual(cia.cyclesUntilEvent(), 1U);
+		assertTrue(cia.clockCycle());
+		assertTrue(cia.irqAsserted());
+		assertTrue(cia.consumeTimerAUnderflow());
+		assertFalse(cia.consumeTimerAUnderflow());
+		// Having underflowed, the timer reloads from the latch and keeps running
+		assertEqual(readRegister(cia, 0x04U), 0x10U);
+		assertEqual(cia.cyclesUntilEvent(), 0x11U);
+		// Reading the interrupt control register reports and acknowledges the interrupt
+		assertEqual(readRegister(cia, 0x0dU), 0x81U);
+		assertFalse(cia.irqAsserted());
+		assertEqual(readRegister(cia, 0x0dU), 0x00U);
+		// With the interrupt masked off, the flag is still raised but the IRQ line isn't
+		writeRegister(cia, 0x0dU, 0x01U);
+		assertTrue(cia.clockCycles(0x10U));
+		assertTrue(cia.clockCycle());
+		assertFalse(cia.irqAsserted());
+		assertEqual(readRegister(cia, 0x0dU), 0x01U);
+	}
+
+	void testOneShot()
+	{
+		mos6526_t cia{985248U};
+		writeRegister(cia, 0x06U, 0x04U);
+		writeRegister(cia, 0x07U, 0x00U);
+		writeRegister(cia, 0x0dU, 0x82U);
+		// Start timer B in one-shot mode
+		writeRegister(cia, 0x0fU, 0x19U);
+		assertEqual(cia.cyclesUntilEvent(), 5U);
+		assertTrue(cia.clockCycles(4U));
+		assertTrue(cia.clockCycle());
+		assertTrue(cia.irqAsserted());
+		// The timer should now have stopped, reloaded
+		assertEqual(readRegister(cia, 0x0fU), 0x08U);
+		assertEqual(readRegister(cia, 0x06U), 0x04U);
+		assertEqual(cia.cyclesUntilEvent(), UINT32_MAX);
+		assertEqual(readRegister(cia, 0x0dU), 0x82U);
+	}
+
+	void testCascade()
+	{
+		mos6526_t cia{985248U};
+		// Timer A underflows every 3 cycles, and timer B underflows on every second one of those
+		writeRegister(cia, 0x04U, 0x02U);
+		writeRegister(cia, 0x05U, 0x00U);
+		writeRegister(cia, 0x06U, 0x01U);
+		writeRegister(cia, 0x07U, 0x00U);
+		writeRegister(cia, 0x0dU, 0x82U);
+		writeRegister(cia, 0x0fU, 0x51U);
+		writeRegister(cia, 0x0eU, 0x11U);
+		assertEqual(cia.cyclesUntilEvent(), 3U);
+		assertTrue(cia.clockCycles(2U));
+		assertTrue(cia.clockCycle());
+		assertFalse(cia.irqAsserted());
+		assertEqual(readRegister(cia, 0x06U), 0x00U);
+		// Timer B underflows along with the second
+		assertEqual(cia.cyclesUntilEvent(), 3U);
+		assertTrue(cia.clockCycles(2U));
+		assertTrue(cia.clockCycle());
+		assertTrue(cia.irqAsserted());
+		assertEqual(readRegister(cia, 0x0dU), 0x83U);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testRegisterIO)
+		CXX_TEST(testTimerUnderflow)
+		CXX_TEST(testOneShot)
+		CXX_TEST(testCascade)
+	}
+};
+
+CRUNCHpp_TESTS(testMOS6526)
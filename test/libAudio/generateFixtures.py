@@ -0,0 +1,261 @@
+#!/usr/bin/env python3
+# SPDX-License-Identifier: BSD-3-Clause
+# SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+# Regenerates the small audio files the libAudio tests decode
+
+import math
+import struct
+from pathlib import Path
+
+fixturesDir = Path(__file__).resolve().parent
+
+def generateModule():
+	# One 4 channel ProTracker pattern playing a looped single cycle 8-bit sine well below
+	# its natural rate, so the resampler has plenty of work to do, with a pattern break on
+	# row 3 to end the song after 4 rows
+	cycle = [round(127 * math.sin(2 * math.pi * i / 32)) for i in range(32)]
+	# The loader zeroes the first 2 bytes of every sample, so lead in with silence and loop after it
+	pcm = bytes(4) + struct.pack('32b', *cycle)
+
+	header = b'libAudio test'.ljust(20, b'\0')
+	# Sample 1: name, length in words, finetune, volume, loop start and loop length in words
+	header += struct.pack('>22sHBBHH', b'sine', len(pcm) // 2, 0, 64, 2, 16)
+	for _ in range(30):
+		header += struct.pack('>22sHBBHH', b'', 0, 0, 0, 0, 1)
+	# Song length, restart position, order list and magic
+	header += struct.pack('BB', 1, 127) + bytes(128) + b'M.K.'
+
+	pattern = bytearray(64 * 4 * 4)
+	def note(row, channel, sample, period, effect = 0, param = 0):
+		cell = (row * 4 + channel) * 4
+		pattern[cell:cell + 4] = bytes([
+			(sample & 0xF0) | (period >> 8), period & 0xFF, ((sample & 0x0F) << 4) | effect, param
+		])
+	# C-1 on the left, and an octave up on the right
+	note(0, 0, 1, 856)
+	note(0, 1, 1, 428)
+	note(3, 0, 0, 0, 0xD, 0x00)
+	(fixturesDir / 'testModule.mod').write_bytes(header + pattern + pcm)
+
+def generateWAV():
+	# 1/10th of a second of 16-bit stereo at 22050Hz - a 441Hz sine on the left and silence on the right
+	rate = 22050
+	frames = rate // 10
+	samples = []
+	for i in range(frames):
+		samples += [round(16384 * math.sin(2 * math.pi * 441 * i / rate)), 0]
+	data = struct.pack(f'<{len(samples)}h', *samples)
+	fmt = struct.pack('<HHIIHH', 1, 2, rate, rate * 4, 4, 16)
+	body = b'WAVE' + b'fmt ' + struct.pack('<I', len(fmt)) + fmt + b'data' + struct.pack('<I', len(data)) + data
+	(fixturesDir / 'testWAV.wav').write_bytes(b'RIFF' + struct.pack('<I', len(body)) + body)
+
+def box(kind, *payload):
+	data = b''.join(payload)
+	return struct.pack('>I', len(data) + 8) + kind + data
+
+def fullBox(kind, *payload, version = 0, flags = 0):
+	return box(kind, struct.pack('>I', (version << 24) | flags), *payload)
+
+def descriptor(tag, *payload):
+	data = b''.join(payload)
+	return bytes([tag, len(data)]) + data
+
+def generateM4A():
+	# Just over a second of mono 22050Hz AAC-LC, with every frame the same single silent frame
+	rate = 22050
+	frames = 22
+	frame = bytes([0x00, 0xc8, 0x00, 0x80, 0x23, 0x80])
+	duration = frames * 1024
+	# AudioSpecificConfig: AAC-LC (2), sample rate index 7 (22050Hz), 1 channel
+	audioConfig = bytes([0x13, 0x88])
+	matrix = struct.pack('>9I', 0x00010000, 0, 0, 0, 0x00010000, 0, 0, 0, 0x40000000)
+
+	ftyp = box(b'ftyp', b'M4A ', struct.pack('>I', 0), b'M4A mp42isom')
+	mdat = box(b'mdat', frame * frames)
+	esds = fullBox(b'esds', descriptor(0x03, struct.pack('>HB', 1, 0),
+		descriptor(0x04, struct.pack('>BB', 0x40, 0x15), bytes(3), struct.pack('>II', 0, 0),
+			descriptor(0x05, audioConfig)),
+		descriptor(0x06, bytes([0x02]))))
+	mp4a = box(b'mp4a', bytes(6), struct.pack('>H', 1), bytes(8), struct.pack('>HHHHI', 1, 16, 0, 0, rate << 16), esds)
+	stbl = box(b'stbl',
+		fullBox(b'stsd', struct.pack('>I', 1), mp4a),
+		fullBox(b'stts', struct.pack('>III', 1, frames, 1024)),
+		fullBox(b'stsc', struct.pack('>IIII', 1, 1, frames, 1)),
+		fullBox(b'stsz', struct.pack('>II', len(frame), frames)),
+		# The one chunk is the mdat's payload, which directly follows the ftyp
+		fullBox(b'stco', struct.pack('>II', 1, len(ftyp) + 8)))
+	minf = box(b'minf',
+		fullBox(b'smhd', struct.pack('>HH', 0, 0)),
+		box(b'dinf', fullBox(b'dref', struct.pack('>I', 1), fullBox(b'url ', flags = 1))),
+		stbl)
+	mdia = box(b'mdia',
+		fullBox(b'mdhd', struct.pack('>IIIIHH', 0, 0, rate, duration, 0x55c4, 0)),
+		fullBox(b'hdlr', struct.pack('>I', 0), b'soun', bytes(12), b'SoundHandler\0'),
+		minf)
+	tkhd = fullBox(b'tkhd', struct.pack('>IIIII', 0, 0, 1, 0, duration), bytes(8),
+		struct.pack('>HHHH', 0, 0, 0x0100, 0), matrix, struct.pack('>II', 0, 0), flags = 7)
+	mvhd = fullBox(b'mvhd', struct.pack('>IIIIIH', 0, 0, rate, duration, 0x00010000, 0x0100), bytes(10),
+		matrix, bytes(24), struct.pack('>I', 2))
+	moov = box(b'moov', mvhd, box(b'trak', tkhd, mdia))
+	(fixturesDir / 'testM4A.m4a').write_bytes(ftyp + mdat + moov)
+
+def guid(data1, data2, data3, data4):
+	# ASF stores the first three fields of a GUID little endian, and the last 8 bytes as is
+	return struct.pack('<IHH', data1, data2, data3) + bytes.fromhex(data4)
+
+def asfObject(objectGUID, *payload):
+	data = b''.join(payload)
+	return objectGUID + struct.pack('<Q', len(data) + 24) + data
+
+class bitWriter:
+	def __init__(self):
+		self.bits = []
+
+	def write(self, value, count):
+		self.bits += [(value >> (count - 1 - i)) & 1 for i in range(count)]
+
+	def bytes(self, length):
+		bits = self.bits + [0] * (length * 8 - len(self.bits))
+		return bytes(int(''.join(map(str, bits[i:i + 8])), 2) for i in range(0, length * 8, 8))
+
+def generateWMA():
+	# Just over a second of mono 22050Hz WMA v2 at 32kbps, with no bit reservoir, so each superframe
+	# is one frame, and the spectral envelope sent as LSPs. Every frame codes the same single
+	# spectral line, making a tone at (92.5 / 1024) * (22050 / 2) = 996Hz
+	rate = 22050
+	frames = 22
+	blockAlign = 64
+	frame = bitWriter()
+	# Channel coded, and a total gain of 94
+	frame.write(1, 1)
+	frame.write(93, 7)
+	# LSP codebook indices, 3 bits for the first and last two and 4 bits for the rest
+	for index, bits in zip([3, 8, 8, 8, 8, 8, 8, 8, 4, 4], [3, 4, 4, 4, 4, 4, 4, 4, 3, 3]):
+		frame.write(index, bits)
+	# Coefficient 92 as an escape code (from coefficient table 4) giving the level, run and sign raw,
+	# followed by the end of block code
+	frame.write(0xf01, 12)
+	frame.write(96, 9)
+	frame.write(92, 10)
+	frame.write(1, 1)
+	frame.write(0x1e, 6)
+	superframe = frame.bytes(blockAlign)
+
+	headerGUID = guid(0x75B22630, 0x668E, 0x11CF, 'A6D900AA0062CE6C')
+	dataGUID = guid(0x75B22636, 0x668E, 0x11CF, 'A6D900AA0062CE6C')
+	filePropertiesGUID = guid(0x8CABDCA1, 0xA947, 0x11CF, '8EE400C00C205365')
+	streamPropertiesGUID = guid(0xB7DC0791, 0xA9B7, 0x11CF, '8EE600C00C205365')
+	contentDescriptionGUID = guid(0x75B22633, 0x668E, 0x11CF, 'A6D900AA0062CE6C')
+	audioMediaGUID = guid(0xF8699E40, 0x5B4D, 0x11CF, 'A8FD00805F5C442B')
+	noErrorCorrectionGUID = guid(0x20FB5700, 0x5B55, 0x11CF, 'A8FD00805F5C442B')
+	fileID = bytes(range(16))
+
+	# Single payload packets each holding one superframe, with a byte of padding length, one of
+	# media object number and replicated data length, and 4 of offset into the media object
+	packets = b''
+	for packet in range(frames):
+		sendTime = packet * 1024 * 1000 // rate
+		packets += struct.pack('<BBBIH', 0x08, 0x5D, 0, sendTime, 46) + \
+			struct.pack('<BBIB', 0x81, packet, 0, 8) + struct.pack('<II', blockAlign, sendTime) + superframe
+	packetSize = len(packets) // frames
+
+	# Play duration is in 100ns units
+	duration = frames * 1024 * 10000000 // rate
+	# WMA v2's extra data is the samples per block, the encoder options (the flags) and the superblock align
+	waveFormat = struct.pack('<HHIIHHH', 0x0161, 1, rate, 32000 // 8, blockAlign, 16, 10) + \
+		struct.pack('<IHI', 1024, 0, blockAlign)
+	def utf16(text):
+		return (text + '\0').encode('utf-16-le')
+	title = utf16('libAudio test')
+	artist = utf16('dragonmux')
+
+	headerObjects = [
+		asfObject(filePropertiesGUID, fileID, struct.pack('<QQQQQQIIII', 0, 0, frames, duration, duration, 0,
+			0x02, packetSize, packetSize, 32000)),
+		asfObject(streamPropertiesGUID, audioMediaGUID, noErrorCorrectionGUID,
+			struct.pack('<QIIHI', 0, len(waveFormat), 0, 1, 0), waveFormat),
+		asfObject(contentDescriptionGUID, struct.pack('<5H', len(title), len(artist), 0, 0, 0), title, artist),
+	]
+	header = asfObject(headerGUID, struct.pack('<IBB', len(headerObjects), 1, 2), *headerObjects)
+	data = asfObject(dataGUID, fileID, struct.pack('<QH', frames, 0x0101), packets)
+	(fixturesDir / 'testWMA.wma').write_bytes(header + data)
+
+def generateMP3():
+	# 24 frames (just under 0.9 of a second) of mono 32kHz MPEG-1 Layer III at 32kbps, after an Info frame
+	# giving the frame count. No frame uses the bit reservoir, and each granule codes the single spectral
+	# line 20 (in region 0, with Huffman table 1), with the gain stepping from frame to frame so that where
+	# in the stream decoding has got to can be told from the output
+	frames = 24
+	frameLength = 144
+	# Sync, MPEG-1, Layer III, no CRC, 32kbps, 32kHz, no padding, single channel
+	header = bytes([0xFF, 0xFB, 0x18, 0xC0])
+	sideInfoLength = 17
+
+	info = bitWriter()
+	info.write(0, sideInfoLength * 8)
+	# The Info tag, with only the frame count present
+	for value in b'Info':
+		info.write(value, 8)
+	info.write(1, 32)
+	info.write(frames, 32)
+	data = header + info.bytes(frameLength - len(header))
+
+	for frame in range(frames):
+		sideInfo = bitWriter()
+		# main_data_begin, private bits and scfsi
+		sideInfo.write(0, 9)
+		sideInfo.write(0, 5)
+		sideInfo.write(0, 4)
+		mainData = bitWriter()
+		for _ in range(2):
+			# 10 zero pairs (1 bit each), then the pair (1, 0) and the sign of the 1
+			mainData.write(0b1111111111, 10)
+			mainData.write(0b01, 2)
+			mainData.write(frame & 1, 1)
+			# part2_3_length, big_values, global_gain and scalefac_compress
+			sideInfo.write(13, 12)
+			sideInfo.write(11, 9)
+			sideInfo.write(196 + (frame % 8), 8)
+			sideInfo.write(0, 4)
+			# No window switching, Huffman table 1 for region 0, region0_count of 7 and region1_count of 0
+			sideInfo.write(0, 1)
+			sideInfo.write(1, 5)
+			sideInfo.write(0, 5)
+			sideInfo.write(0, 5)
+			sideInfo.write(7, 4)
+			sideInfo.write(0, 3)
+			# preflag, scalefac_scale and count1table_select
+			sideInfo.write(0, 3)
+		data += header + sideInfo.bytes(sideInfoLength) + mainData.bytes(frameLength - len(header) - sideInfoLength)
+	(fixturesDir / 'testMP3.mp3').write_bytes(data)
+
+def generateSID():
+	# A PSIDv2 tune for a PAL C64 with an 8580, whose init routine starts a sawtooth on voice 1 at full volume
+	# and whose play routine does nothing. The data begins with its load address of $1000, and 2 tunes are
+	# declared so the header says which to start with
+	init = bytes([
+		0xA9, 0x0F, 0x8D, 0x18, 0xD4, # LDA #$0F; STA $D418 - full volume
+		0xA9, 0x00, 0x8D, 0x05, 0xD4, # LDA #$00; STA $D405 - fastest attack and decay
+		0xA9, 0xF0, 0x8D, 0x06, 0xD4, # LDA #$F0; STA $D406 - full sustain, fastest release
+		0xA9, 0x00, 0x8D, 0x00, 0xD4, # LDA #$00; STA $D400 - frequency low byte
+		0xA9, 0x1C, 0x8D, 0x01, 0xD4, # LDA #$1C; STA $D401 - frequency high byte, for about 430Hz
+		0xA9, 0x21, 0x8D, 0x04, 0xD4, # LDA #$21; STA $D404 - sawtooth, gate on
+		0x60,                         # RTS, which doubles as the play routine
+	])
+	loadAddress = 0x1000
+	playAddress = loadAddress + len(init) - 1
+	# PAL in bits 2-3, and 8580 in bits 4-5
+	flags = (1 << 2) | (2 << 4)
+	header = b'PSID' + struct.pack('>HHHHHHHI', 2, 0x7C, 0, 0, playAddress, 2, 1, 0)
+	header += b'libAudio test'.ljust(32, b'\0') + b'dragonmux'.ljust(32, b'\0')
+	# Latin-1, to check it comes out as UTF-8
+	header += '2026 \u00a9 dragonmux'.encode('latin-1').ljust(32, b'\0')
+	header += struct.pack('>HBBBB', flags, 0, 0, 0, 0)
+	(fixturesDir / 'testSID.sid').write_bytes(header + struct.pack('<H', loadAddress) + init)
+
+generateModule()
+generateWAV()
+generateM4A()
+generateWMA()
+generateMP3()
+generateSID()
@@ -0,0 +1,283 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <cmath>
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <string_view>
+#include <vector>
+#ifndef _WINDOWS
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *outputFile{"testEncoderOptions.out"};
+constexpr static double pi{3.14159265358979323846};
+constexpr static uint32_t sampleRate{44100U};
+constexpr static uint8_t channels{2U};
+
+// One second of a 440Hz tone in 16-bit stereo, which is enough for the encoders to settle on their settings
+std::vector<int16_t> makeTone()
+{
+	std::vector<int16_t> samples(size_t{sampleRate} * channels);
+	for (size_t i{0U}; i < sampleRate; ++i)
+	{
+		const auto value{int16_t(std::sin(2.0 * pi * 440.0 * double(i) / double(sampleRate)) * 16384.0)};
+		samples[i * 2U] = value;
+		samples[(i * 2U) + 1U] = value;
+	}
+	return samples;
+}
+
+uint32_t readBE16(const uint8_t *const data) noexcept
+	{ return (uint32_t{data[0]} << 8U) | data[1]; }
+
+uint32_t readLE32(const uint8_t *const data) noexcept
+{
+	return uint32_t{data[0]} | (uint32_t{data[1]} << 8U) | (uint32_t{data[2]} << 16U) |
+		(uint32_t{data[3]} << 24U);
+}
+
+// Where the first occurrence of needle is in the first limit bytes of data, or data.size() if it isn't there
+size_t find(const std::vector<uint8_t> &data, const std::string_view needle, const size_t limit = SIZE_MAX)
+{
+	const auto end{data.begin() + ptrdiff_t(std::min(limit, data.size()))};
+	const auto match{std::search(data.begin(), end, needle.begin(), needle.end())};
+	return match == end ? data.size() : size_t(match - data.begin());
+}
+
+// The MPEG-1 Layer III frame headers in an MP3, skipping any ID3v2 tag at the front
+struct mp3Frame_t final
+{
+	size_t offset;
+	size_t length;
+	uint32_t bitRate;
+};
+
+std::vector<mp3Frame_t> mp3Frames(const std::vector<uint8_t> &data)
+{
+	constexpr std::array<uint32_t, 15> bitRates{0U, 32U, 40U, 48U, 56U, 64U, 80U, 96U, 112U, 128U, 160U, 192U,
+		224U, 256U, 320U};
+	constexpr std::array<uint32_t, 3> sampleRates{44100U, 48000U, 32000U};
+	size_t offset{0U};
+	if (data.size() >= 10U && std::memcmp(data.data(), "ID3", 3U) == 0)
+		offset = 10U + ((data[6] & 0x7FU) << 21U) + ((data[7] & 0x7FU) << 14U) + ((data[8] & 0x7FU) << 7U) +
+			(data[9] & 0x7FU);
+
+	std::vector<mp3Frame_t> frames{};
+	// Stop at anything that isn't an MPEG-1 Layer III frame, such as an ID3v1 tag on the end
+	while (offset + 4U <= data.size() && data[offset] == 0xFFU && (data[offset + 1U] & 0xFEU) == 0xFAU)
+	{
+		const auto bitRate{data[offset + 2U] >> 4U};
+		const auto rate{(data[offset + 2U] >> 2U) & 3U};
+		if (bitRate == 0U || bitRate == 15U || rate == 3U)
+			break;
+		const auto padding{(data[offset + 2U] >> 1U) & 1U};
+		const size_t length{((144000U * bitRates[bitRate]) / sampleRates[rate]) + padding};
+		frames.push_back({offset, length, bitRates[bitRate] * 1000U});
+		offset += length;
+	}
+	return frames;
+}
+
+class testEncoderOptions final : public testsuite
+{
+private:
+	std::vector<uint8_t> readOutput()
+	{
+		fd_t file{outputFile, O_RDONLY};
+		assertTrue(file.valid());
+		const auto length{file.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	// Encodes the tone through the C API with the given options, returning the encoded file
+	std::vector<uint8_t> encode(const uint32_t type, const encoderOptions_t *const options)
+	{
+		const auto samples{makeTone()};
+		fileInfo_t info{};
+		info.bitRate(sampleRate);
+		info.channels(channels);
+		info.sampleFormat(sampleFormat_t::int16);
+		void *const file{audioOpenWOptions(outputFile, type, options)};
+		assertNotNull(file);
+		assertTrue(audioSetFileInfo(file, &info));
+		const auto length{int64_t(samples.size() * sizeof(int16_t))};
+		assertEqual(audioWriteBuffer(file, samples.data(), length), length);
+		audioCloseFile(file);
+		return readOutput();
+	}
+
+	void testOptionsKept()
+	{
+		// Find any encoder that's built in, as they all keep the options the same way
+		uint32_t type{};
+#if defined(ENABLE_FLAC)
+		type = AUDIO_FLAC;
+#elif defined(ENABLE_VORBIS)
+		type = AUDIO_OGG_VORBIS;
+#elif defined(ENABLE_OPUS)
+		type = AUDIO_OGG_OPUS;
+#elif defined(ENABLE_MP3)
+		type = AUDIO_MP3;
+#elif defined(ENABLE_M4A)
+		type = AUDIO_MP4;
+#endif
+		if (!type)
+			skip("No encoders built");
+
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_QUALITY | AUDIO_OPTION_BITRATE | AUDIO_OPTION_COMPRESSION_LEVEL |
+			AUDIO_OPTION_COMPLEXITY | AUDIO_OPTION_THREADS;
+		options.quality = 0.25F;
+		options.bitRate = 96000U;
+		options.compressionLevel = 7U;
+		options.complexity = 5U;
+		options.threads = 2U;
+		std::unique_ptr<audioFile_t> file{audioFile_t::openW(outputFile, type, options)};
+		assertNotNull(file.get());
+		const auto &kept{file->encoderOptions()};
+		assertEqual(kept.options, options.options);
+		assertTrue(kept.quality == options.quality);
+		assertEqual(kept.bitRate, options.bitRate);
+		assertEqual(kept.compressionLevel, options.compressionLevel);
+		assertEqual(kept.complexity, options.complexity);
+		assertEqual(kept.threads, options.threads);
+
+		// Having no options through the C API must leave every one unset
+		file.reset(static_cast<audioFile_t *>(audioOpenWOptions(outputFile, type, nullptr)));
+		assertNotNull(file.get());
+		assertEqual(file->encoderOptions().options, 0U);
+		file.reset();
+		unlink(outputFile);
+	}
+
+	void testNoEncoder()
+	{
+		// WAV has no encoder, so asking for one fails whatever the options
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_BITRATE;
+		options.bitRate = 128000U;
+		assertNull(audioOpenWOptions(outputFile, AUDIO_WAVE, &options));
+		assertNull(audioOpenWOptions(outputFile, AUDIO_WAVE, nullptr));
+		unlink(outputFile);
+	}
+
+	void testMP3BitRate()
+	{
+#ifdef ENABLE_MP3
+		// Without options LAME encodes CBR at 320kbps..
+		auto frames{mp3Frames(encode(AUDIO_MP3, nullptr))};
+		assertTrue(frames.size() > 30U);
+		// (the first frame holds LAME's Info tag, so skip it)
+		for (size_t i{1U}; i < frames.size(); ++i)
+			assertEqual(frames[i].bitRate, 320000U);
+
+		// ..and a bitrate must come through as every frame's bitrate
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_BITRATE;
+		options.bitRate = 128000U;
+		frames = mp3Frames(encode(AUDIO_MP3, &options));
+		assertTrue(frames.size() > 30U);
+		for (size_t i{1U}; i < frames.size(); ++i)
+			assertEqual(frames[i].bitRate, 128000U);
+
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(outputFile)};
+		assertNotNull(file.get());
+		assertEqual(file->fileInfo().bitRate(), sampleRate);
+		assertEqual(file->fileInfo().channels(), channels);
+		file.reset();
+		unlink(outputFile);
+#else
+		skip("MP3 support not built");
+#endif
+	}
+
+	void testMP3Quality()
+	{
+#ifdef ENABLE_MP3
+		// A CBR stream's tag frame is marked "Info"..
+		auto data{encode(AUDIO_MP3, nullptr)};
+		auto frames{mp3Frames(data)};
+		assertFalse(frames.empty());
+		assertTrue(find(data, "Info", frames[0].offset + frames[0].length) < data.size());
+
+		// ..while asking for a quality switches to VBR, which marks it "Xing"
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_QUALITY;
+		options.quality = 0.5F;
+		data = encode(AUDIO_MP3, &options);
+		frames = mp3Frames(data);
+		assertFalse(frames.empty());
+		assertTrue(find(data, "Xing", frames[0].offset + frames[0].length) < data.size());
+		unlink(outputFile);
+#else
+		skip("MP3 support not built");
+#endif
+	}
+
+	void testFLACCompressionLevel()
+	{
+#ifdef ENABLE_FLAC
+		// The compression level picks the block size, which STREAMINFO records as its maximum block size -
+		// levels 0 through 2 use 1152 sample blocks, and the rest (including the default of 4) 4096
+		constexpr size_t maxBlockSizeOffset{4U + 4U + 2U};
+		auto data{encode(AUDIO_FLAC, nullptr)};
+		assertTrue(data.size() > maxBlockSizeOffset + 2U);
+		assertEqual(std::memcmp(data.data(), "fLaC", 4U), 0);
+		assertEqual(readBE16(data.data() + maxBlockSizeOffset), 4096U);
+
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_COMPRESSION_LEVEL;
+		options.compressionLevel = 0U;
+		data = encode(AUDIO_FLAC, &options);
+		assertTrue(data.size() > maxBlockSizeOffset + 2U);
+		assertEqual(readBE16(data.data() + maxBlockSizeOffset), 1152U);
+		unlink(outputFile);
+#else
+		skip("FLAC support not built");
+#endif
+	}
+
+	void testVorbisBitRate()
+	{
+#ifdef ENABLE_VORBIS
+		// The identification header holds the nominal bitrate after the version, channels, rate and maximum
+		constexpr size_t nominalOffset{7U + 4U + 1U + 4U + 4U};
+		encoderOptions_t options{};
+		options.options = AUDIO_OPTION_BITRATE;
+		options.bitRate = 96000U;
+		const auto data{encode(AUDIO_OGG_VORBIS, &options)};
+		const auto header{find(data, std::string_view{"\x01vorbis", 7U})};
+		assertTrue(header + nominalOffset + 4U <= data.size());
+		assertEqual(readLE32(data.data() + header + 12U), sampleRate);
+		assertEqual(readLE32(data.data() + header + nominalOffset), 96000U);
+		unlink(outputFile);
+#else
+		skip("Ogg/Vorbis support not built");
+#endif
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testOptionsKept)
+		CXX_TEST(testNoEncoder)
+		CXX_TEST(testMP3BitRate)
+		CXX_TEST(testMP3Quality)
+		CXX_TEST(testFLACCompressionLevel)
+		CXX_TEST(testVorbisBitRate)
+	}
+};
+
+CRUNCHpp_TESTS(testEncoderOptions)
@@ -107,11 +107,42 @@ private:
 		assertNull(audioFileOtherComment(&fileInfo, 1));
 	}
 
+	void testSampleFormat()
+	{
+		fileInfo_t fileInfo{};
+		assertEqual(audioFileSampleFormat(nullptr), 0U);
+		// Check that setting the bit depth picks the default output format for it
+		fileInfo.bitsPerSample(8U);
+		assertTrue(fileInfo.sampleFormat() == sampleFormat_t::int8);
+		assertEqual(fileInfo.bytesPerSample(), 1U);
+		fileInfo.bitsPerSample(24U);
+		assertTrue(fileInfo.sampleFormat() == sampleFormat_t::int16);
+		assertEqual(fileInfo.bytesPerSample(), 2U);
+		// And that setting the output format keeps the bit depth in step with it
+		fileInfo.sampleFormat(sampleFormat_t::int24);
+		assertEqual(fileInfo.bitsPerSample(), 24U);
+		assertEqual(fileInfo.bytesPerSample(), 4U);
+		fileInfo.sampleFormat(sampleFormat_t::float32);
+		assertEqual(fileInfo.bitsPerSample(), 32U);
+		assertEqual(fileInfo.bytesPerSample(), 4U);
+		assertEqual(audioFileSampleFormat(&fileInfo), AUDIO_SAMPLE_FLOAT32);
+
+		fileInfo_t copy{};
+		copy = fileInfo;
+		assertTrue(copy.sampleFormat() == sampleFormat_t::float32);
+
+		// Setting the bit depth afterwards puts the format back to the default, even for 32-bit audio
+		fileInfo.bitsPerSample(32U);
+		assertTrue(fileInfo.sampleFormat() == sampleFormat_t::int16);
+		assertEqual(fileInfo.bitsPerSample(), 32U);
+	}
+
 public:
 	void registerTests() final
 	{
 		CXX_TEST(testFileInfoCXX)
 		CXX_TEST(testFileInfoC)
+		CXX_TEST(testSampleFormat)
 	}
 };
 
@@ -0,0 +1,170 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <array>
+#include <vector>
+#ifndef _WINDOWS
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+#include <crunch++.h>
+#include <substrate/fd>
+#include <inputSource.hxx>
+
+using substrate::fd_t;
+using backend_t = inputSource_t::backend_t;
+
+constexpr static const char *testFile{"inputSource.test"};
+
+class testInputSource final : public testsuite
+{
+private:
+	std::vector<uint8_t> data{};
+	int64_t position{0};
+
+	static int64_t readCallback(void *const user, void *const buffer, const size_t length)
+	{
+		auto &suite{*static_cast<testInputSource *>(user)};
+		const auto amount{std::min<size_t>(length, suite.data.size() - size_t(suite.position))};
+		std::memcpy(buffer, suite.data.data() + suite.position, amount);
+		suite.position += int64_t(amount);
+		return int64_t(amount);
+	}
+
+	static int64_t seekCallback(void *const user, const int64_t offset, const int whence)
+	{
+		auto &suite{*static_cast<testInputSource *>(user)};
+		if (whence == SEEK_SET)
+			suite.position = offset;
+		else if (whence == SEEK_CUR)
+			suite.position += offset;
+		else
+			suite.position = int64_t(suite.data.size()) + offset;
+		return suite.position;
+	}
+
+	static int64_t tellCallback(void *const user) { return static_cast<testInputSource *>(user)->position; }
+	static int64_t badLengthCallback(void *) { return -2; }
+
+	inputSource_t openSource(const backend_t backend)
+	{
+		if (backend == backend_t::memory)
+			return {data.data(), data.size()};
+		if (backend == backend_t::callbacks)
+			return inputSource_t{inputSource_t::callbacks_t{readCallback, seekCallback, tellCallback, nullptr, this}};
+		return {fd_t{testFile, O_RDONLY}, backend};
+	}
+
+	void checkReads(const backend_t backend)
+	{
+		const auto source{openSource(backend)};
+		assertTrue(source.valid());
+		assertTrue(source.backend() == backend);
+		assertEqual(source.length(), off_t(data.size()));
+
+		std::array<uint8_t, 4> magic{};
+		assertTrue(source.read(magic));
+		assertEqual(magic[0], 0U);
+		assertEqual(magic[3], 3U);
+		uint16_t valueLE{};
+		uint16_t valueBE{};
+		assertTrue(source.readLE(valueLE));
+		assertEqual(valueLE, 0x0504U);
+		assertTrue(source.readBE(valueBE));
+		assertEqual(valueBE, 0x0607U);
+		assertEqual(source.tell(), 8);
+
+		// Read across the end of the first window's worth of data and check nothing got lost
+		assertTrue(source.seek(inputSource_t::windowSize - 2U, SEEK_SET) == off_t(inputSource_t::windowSize - 2U));
+		std::array<uint8_t, 4> straddle{};
+		assertTrue(source.read(straddle));
+		for (size_t i{0U}; i < straddle.size(); ++i)
+			assertEqual(straddle[i], uint8_t(inputSource_t::windowSize - 2U + i));
+
+		// Views never consume data, takes always do
+		const auto view{source.view(16U)};
+		assertEqual(view.size(), 16U);
+		assertEqual(view[0], uint8_t(inputSource_t::windowSize + 2U));
+		assertEqual(source.tell(), off_t(inputSource_t::windowSize + 2U));
+		const auto taken{source.take(16U)};
+		assertEqual(taken.size(), 16U);
+		assertEqual(source.tell(), off_t(inputSource_t::windowSize + 18U));
+
+		// Check the end of the data is reported just as a file would report it
+		assertTrue(source.seek(-2, SEEK_END) == off_t(data.size() - 2U));
+		assertFalse(source.read(magic));
+		assertTrue(source.isEOF());
+		assertEqual(source.read(magic.data(), magic.size(), nullptr), 0);
+		assertTrue(source.view(1U).empty());
+		assertTrue(source.head());
+		assertFalse(source.isEOF());
+		assertEqual(source.seek(-1, SEEK_SET), -1);
+		assertEqual(source.tell(), 0);
+	}
+
+	void testMapped() { checkReads(backend_t::mapped); }
+	void testBuffered() { checkReads(backend_t::buffered); }
+	void testMemory() { checkReads(backend_t::memory); }
+	void testCallbacks() { checkReads(backend_t::callbacks); }
+
+	void testInvalid()
+	{
+		inputSource_t source{fd_t{"inputSource.missing", O_RDONLY}};
+		assertFalse(source.valid());
+		std::array<uint8_t, 1> value{};
+		assertFalse(source.read(value));
+		assertEqual(source.seek(0, SEEK_SET), -1);
+		assertTrue(source.view(1U).empty());
+
+		// A callbacks source can't be read without both a read and a seek callback
+		const inputSource_t callbacks{inputSource_t::callbacks_t{readCallback, nullptr, nullptr, nullptr, this}};
+		assertFalse(callbacks.valid());
+		// Nor if the length callback fails, whichever negative value it fails with
+		const inputSource_t badLength{inputSource_t::callbacks_t{readCallback, seekCallback, tellCallback,
+			badLengthCallback, this}};
+		assertFalse(badLength.valid());
+		assertEqual(badLength.length(), 0);
+	}
+
+	void testMove()
+	{
+		inputSource_t source{fd_t{testFile, O_RDONLY}};
+		assertTrue(source.valid());
+		assertTrue(source.seekRel(4));
+		inputSource_t moved{std::move(source)};
+		assertFalse(source.valid());
+		assertTrue(moved.valid());
+		assertEqual(moved.tell(), 4);
+		uint8_t value{};
+		assertTrue(moved.read(value));
+		assertEqual(value, 4U);
+	}
+
+public:
+	testInputSource()
+	{
+		// Make the data more than a window long so the buffered backend has to refill
+		data.resize(inputSource_t::windowSize + 4096U);
+		for (size_t i{0U}; i < data.size(); ++i)
+			data[i] = uint8_t(i);
+		fd_t file{testFile, O_WRONLY | O_CREAT | O_TRUNC, substrate::normalMode};
+		file.write(data.data(), data.size());
+	}
+
+	~testInputSource() final { unlink(testFile); }
+
+	void registerTests() final
+	{
+		CXX_TEST(testMapped)
+		CXX_TEST(testBuffered)
+		CXX_TEST(testMemory)
+		CXX_TEST(testCallbacks)
+		CXX_TEST(testInvalid)
+		CXX_TEST(testMove)
+	}
+};
+
+CRUNCHpp_TESTS(testInputSource)
@@ -0,0 +1,68 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *m4aFile{"testM4A.m4a"};
+
+class testM4A final : public testsuite
+{
+private:
+	void checkInfo(const audioFile_t *const file)
+	{
+		assertNotNull(file);
+		assertTrue(file->type() == audioType_t::m4a);
+		const auto &info{file->fileInfo()};
+		assertEqual(info.bitRate(), 22050U);
+		assertEqual(info.channels(), 1U);
+		assertEqual(info.bitsPerSample(), 16U);
+		// 22 frames of 1024 samples each is just over a second
+		assertEqual(info.totalTime(), 1U);
+	}
+
+	void testOpen()
+	{
+#ifdef ENABLE_M4A
+		assertTrue(isM4A(m4aFile));
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(m4aFile)};
+		checkInfo(file.get());
+#else
+		skip("M4A support not built");
+#endif
+	}
+
+	void testOpenMemory()
+	{
+#ifdef ENABLE_M4A
+		// MP4v2 has to be told how long the data is, which for this has nothing to do with a file
+		fd_t fixture{m4aFile, O_RDONLY};
+		assertTrue(fixture.valid());
+		const auto length{fixture.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(fixture.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(fixture.read(data.data(), data.size()));
+
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(inputSource_t{data.data(), data.size()})};
+		checkInfo(file.get());
+		// And a truncated file must be rejected rather than opened with nothing in it
+		std::unique_ptr<audioFile_t> truncated{audioFile_t::openR(inputSource_t{data.data(), 64U})};
+		assertNull(truncated.get());
+#else
+		skip("M4A support not built");
+#endif
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testOpen)
+		CXX_TEST(testOpenMemory)
+	}
+};
+
+CRUNCHpp_TESTS(testM4A)
@@ -0,0 +1,260 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <algorithm>
+#include <vector>
+#include <crunch++.h>
+#include <moduleMixer/mixKernels.hxx>
+#include <cpuFeatures.hxx>
+
+constexpr static size_t sampleFrames{256U};
+// Enough coefficients for the largest (sinc) table, as the kernels only ever get a pointer to one
+constexpr static size_t sincLength{4096U * 8U};
+
+uint32_t nextRandom(uint32_t &state) noexcept
+{
+	state = (state * 1664525U) + 1013904223U;
+	return state;
+}
+
+/*
+ * A straight transliteration of sampleLoop() and the sample and store functions in mixFunctions.h,
+ * which can't be used directly here as they need the full module channel structures
+ */
+template<typename T> int32_t scaleSample(const T sample) noexcept
+{
+	if constexpr (sizeof(T) == 1U)
+		return int16_t(sample * 256);
+	else
+		return sample;
+}
+
+int32_t clipSample(const int32_t sample) noexcept
+	{ return std::min(std::max(sample, int32_t{INT16_MIN}), int32_t{INT16_MAX}); }
+
+template<typename T> int32_t referenceSample(const mixKernelState_t &state, const uint8_t mode,
+	const int32_t position, const size_t channel)
+{
+	const auto *const data{static_cast<const T *>(state.sampleData)};
+	const int32_t channels{mode & MIX_STEREO ? 2 : 1};
+	const auto tap
+	{
+		[&](const int32_t frame)
+		{
+			const auto index{std::min(std::max(frame, state.firstFrame), state.lastFrame)};
+			return scaleSample(data[(index * channels) + int32_t(channel)]);
+		}
+	};
+	const auto frame{position >> 16};
+	switch (mode & MIX_SINCSRC)
+	{
+		case MIX_LINEARSRC:
+		{
+			const auto fraction{(position >> 8) & 0xFF};
+			const auto first{tap(frame)};
+			return int16_t(first + ((fraction * (tap(frame + 1) - first)) >> 8));
+		}
+		case MIX_HQSRC:
+		{
+			const auto *const coefficients{state.sinc + ((position >> 6) & 0x03FC)};
+			int32_t result{0};
+			for (int32_t i{0}; i < 4; ++i)
+				result += coefficients[i] * tap(frame + i - 1);
+			return clipSample(result >> 14);
+		}
+		case MIX_SINCSRC:
+		{
+			const auto *const coefficients{state.sinc + (((position >> 4) & 0x0FFF) * 8)};
+			int32_t result{0};
+			for (int32_t i{0}; i < 8; ++i)
+				result += coefficients[i] * tap(frame + i - 3);
+			return clipSample(result >> 14);
+		}
+		default:
+			return scaleSample(data[(frame * channels) + int32_t(channel)]);
+	}
+}
+
+void referenceMix(mixKernelState_t &state, const uint8_t mode, int32_t *const begin, const int32_t *const end)
+{
+	const uint32_t shift{mode & MIX_STEREO ? 3U : 4U};
+	auto position{uint32_t(state.position)};
+	for (auto *buffer{begin}; buffer < end; buffer += 2)
+	{
+		int32_t left{};
+		int32_t right{};
+		if (mode & MIX_16BIT)
+			left = referenceSample<int16_t>(state, mode, int32_t(position), 0U);
+		else
+			left = referenceSample<int8_t>(state, mode, int32_t(position), 0U);
+		right = left;
+		if (mode & MIX_STEREO)
+		{
+			if (mode & MIX_16BIT)
+				right = referenceSample<int16_t>(state, mode, int32_t(position), 1U);
+			else
+				right = referenceSample<int8_t>(state, mode, int32_t(position), 1U);
+		}
+		if (mode & MIX_RAMP)
+		{
+			state.leftVol += uint32_t(state.leftRamp);
+			state.rightVol += uint32_t(state.rightRamp);
+		}
+		buffer[0] = int32_t(uint32_t(buffer[0]) + (uint32_t(right) * (state.rightVol << shift)));
+		buffer[1] = int32_t(uint32_t(buffer[1]) + (uint32_t(left) * (state.leftVol << shift)));
+		position += uint32_t(state.increment);
+	}
+	state.position = int32_t(position);
+}
+
+class testMixKernels final : public testsuite
+{
+private:
+	std::vector<int8_t> samples8{};
+	std::vector<int16_t> samples16{};
+	std::vector<int16_t> sinc{};
+
+	void fillData()
+	{
+		uint32_t state{0x2545F491U};
+		// Stereo frames, so the same data does for both channel layouts
+		samples8.resize(sampleFrames * 2U);
+		samples16.resize(sampleFrames * 2U);
+		for (auto &sample : samples8)
+			sample = int8_t(nextRandom(state) >> 24U);
+		for (auto &sample : samples16)
+			sample = int16_t(nextRandom(state) >> 16U);
+		// Make sure the extremes get mixed too
+		samples8[0] = INT8_MIN;
+		samples8[1] = INT8_MAX;
+		samples16[0] = INT16_MIN;
+		samples16[1] = INT16_MAX;
+		// Kept small enough that no sum of taps can overflow, but large enough to exercise the clipping
+		sinc.resize(sincLength);
+		for (auto &coefficient : sinc)
+			coefficient = int16_t(int32_t(nextRandom(state) >> 19U) - 4096);
+	}
+
+	void checkKernels(const mixKernelTable_t &kernels)
+	{
+		constexpr uint8_t formats[]{0U, MIX_STEREO, MIX_16BIT, MIX_16BIT | MIX_STEREO};
+		// Odd lengths so every vector width has a scalar tail to deal with, as well as ones shorter than a vector
+		constexpr size_t lengths[]{1U, 3U, 5U, 7U, 9U, 13U, 31U};
+		// Forwards, backwards (ping-pong loops), and upsampling by a non-integer ratio
+		constexpr int32_t increments[]{0x10000, 0x18A3C, -0x0C411, 0x0733D};
+		uint32_t random{0x9E3779B9U};
+
+		for (const auto format : formats)
+		{
+			for (uint8_t interp{0U}; interp < 8U; ++interp)
+			{
+				const uint8_t mode(format | interp);
+				const auto kernel{kernels[mode]};
+				assertNotNull(reinterpret_cast<const void *>(kernel));
+				const size_t channels{mode & MIX_STEREO ? 2U : 1U};
+				for (const auto length : lengths)
+				{
+					for (const auto increment : increments)
+					{
+						// Start far enough in that the sample position stays inside the sample whichever way it runs
+						const auto startFrame{int32_t(sampleFrames / 2U)};
+						const void *const data{mode & MIX_16BIT ?
+							static_cast<const void *>(samples16.data() + (startFrame * channels)) :
+							static_cast<const void *>(samples8.data() + (startFrame * channels))};
+						mixKernelState_t state
+						{
+							data, sinc.data(),
+							// Bring the ends of the sample in close so the interpolation taps have to be clamped
+							-2, 3,
+							int32_t(nextRandom(random) & 0xFFFFU), increment,
+							(nextRandom(random) >> 24U) + 1U, (nextRandom(random) >> 24U) + 1U,
+							mode & MIX_RAMP ? int32_t(nextRandom(random) >> 29U) - 4 : 0,
+							mode & MIX_RAMP ? int32_t(nextRandom(random) >> 29U) - 4 : 0,
+						};
+						auto expectedState{state};
+
+						std::vector<int32_t> buffer(length * 2U);
+						for (auto &value : buffer)
+							value = int32_t(nextRandom(random) >> 8U);
+						auto expected{buffer};
+
+						kernel(state, buffer.data(), buffer.data() + buffer.size());
+						referenceMix(expectedState, mode, expected.data(), expected.data() + expected.size());
+
+						for (size_t i{0U}; i < buffer.size(); ++i)
+							assertEqual(buffer[i], expected[i]);
+						assertEqual(state.position, expectedState.position);
+						assertEqual(state.leftVol, expectedState.leftVol);
+						assertEqual(state.rightVol, expectedState.rightVol);
+					}
+				}
+			}
+			// The filtering modes have no kernels and must be left to the scalar mixers
+			for (uint8_t interp{0U}; interp < 8U; ++interp)
+				assertNull(reinterpret_cast<const void *>(kernels[format | MIX_FILTER | interp]));
+		}
+	}
+
+	void testSSE2()
+	{
+#ifdef CPU_FEATURES_X86
+		const auto isa{cpuISA()};
+		if (isa != cpuISA_t::sse2 && isa != cpuISA_t::avx2)
+			skip("SSE2 not supported by this machine");
+		mixKernelTable_t kernels{};
+		sse2MixKernels(kernels);
+		checkKernels(kernels);
+#else
+		skip("SSE2 kernels not built for this machine");
+#endif
+	}
+
+	void testAVX2()
+	{
+#ifdef CPU_FEATURES_X86
+		if (cpuISA() != cpuISA_t::avx2)
+			skip("AVX2 not supported by this machine");
+		mixKernelTable_t kernels{};
+		avx2MixKernels(kernels);
+		checkKernels(kernels);
+#else
+		skip("AVX2 kernels not built for this machine");
+#endif
+	}
+
+	void testNEON()
+	{
+#ifdef CPU_FEATURES_NEON
+		mixKernelTable_t kernels{};
+		neonMixKernels(kernels);
+		checkKernels(kernels);
+#else
+		skip("NEON kernels not built for this machine");
+#endif
+	}
+
+	void testSelection()
+	{
+		// Whichever table got picked must be the one for the best instruction set available
+		const auto &kernels{mixKernels()};
+		if (cpuISA() == cpuISA_t::scalar)
+		{
+			for (const auto kernel : kernels)
+				assertNull(reinterpret_cast<const void *>(kernel));
+		}
+		else
+			checkKernels(kernels);
+	}
+
+public:
+	void registerTests() final
+	{
+		fillData();
+		CXX_TEST(testSSE2)
+		CXX_TEST(testAVX2)
+		CXX_TEST(testNEON)
+		CXX_TEST(testSelection)
+	}
+};
+
+CRUNCHpp_TESTS(testMixKernels)
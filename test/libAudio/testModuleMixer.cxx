@@ -0,0 +1,132 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cmath>
+#include <memory>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.hxx>
+
+constexpr static const char *moduleFile{"testModule.mod"};
+
+struct mixResult_t final
+{
+	std::vector<int16_t> pcm{};
+	double rms{0.0};
+	// The fraction of output frames that repeat the one before them
+	double repeats{0.0};
+	// How much energy is in the second differences, relative to the signal - a measure of how jagged it is
+	double roughness{0.0};
+};
+
+class testModuleMixer final : public testsuite
+{
+private:
+	mixResult_t mix(const moduleResampling_t mode)
+	{
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(moduleFile)};
+		assertNotNull(file.get());
+		const auto &info{file->fileInfo()};
+		assertEqual(info.channels(), 2U);
+		assertEqual(info.bitRate(), 44100U);
+		auto &module{static_cast<moduleFile_t &>(*file)};
+		assertTrue(module.resampling() == moduleResampling_t::nearest);
+		assertTrue(module.resampling(mode));
+		assertTrue(module.resampling() == mode);
+
+		mixResult_t result{};
+		std::vector<int16_t> buffer(4096U);
+		int64_t length{0};
+		while ((length = file->fillBuffer(buffer.data(), uint32_t(buffer.size() * sizeof(int16_t)))) > 0)
+			result.pcm.insert(result.pcm.end(), buffer.begin(), buffer.begin() + (length / sizeof(int16_t)));
+		assertTrue(result.pcm.size() > 8192U);
+
+		// Analyse the left channel, which has the sine playing furthest below its natural rate
+		double energy{0.0};
+		double differences{0.0};
+		size_t repeats{0U};
+		const size_t frames{result.pcm.size() / 2U};
+		for (size_t frame{2U}; frame < frames; ++frame)
+		{
+			const double sample{double(result.pcm[frame * 2U])};
+			const double previous{double(result.pcm[(frame - 1U) * 2U])};
+			const double difference{sample - (2.0 * previous) + result.pcm[(frame - 2U) * 2U]};
+			energy += sample * sample;
+			differences += difference * difference;
+			if (sample == previous)
+				++repeats;
+		}
+		result.rms = std::sqrt(energy / double(frames));
+		result.repeats = double(repeats) / double(frames);
+		result.roughness = differences / energy;
+		return result;
+	}
+
+	void testNearest()
+	{
+		const auto result{mix(moduleResampling_t::nearest)};
+		assertTrue(result.rms > 4096.0);
+		// Without interpolation, each sample is held for the ~10 output frames it takes to play it
+		assertTrue(result.repeats > 0.5);
+	}
+
+	void checkInterpolated(const mixResult_t &result, const mixResult_t &nearest)
+	{
+		// Interpolation must not change the level of the output..
+		assertTrue(std::fabs(result.rms - nearest.rms) < nearest.rms * 0.02);
+		// ..but must smooth out the steps between samples
+		assertTrue(result.repeats < 0.05);
+		assertTrue(result.roughness * 8.0 < nearest.roughness);
+	}
+
+	void testLinear()
+	{
+		const auto nearest{mix(moduleResampling_t::nearest)};
+		const auto result{mix(moduleResampling_t::linear)};
+		checkInterpolated(result, nearest);
+		assertEqual(result.pcm.size(), nearest.pcm.size());
+	}
+
+	void testSinc4Tap()
+	{
+		const auto nearest{mix(moduleResampling_t::nearest)};
+		const auto linear{mix(moduleResampling_t::linear)};
+		const auto result{mix(moduleResampling_t::sinc4Tap)};
+		checkInterpolated(result, nearest);
+		assertEqual(result.pcm.size(), nearest.pcm.size());
+		assertTrue(result.pcm != linear.pcm);
+	}
+
+	void testSinc8Tap()
+	{
+		const auto nearest{mix(moduleResampling_t::nearest)};
+		const auto linear{mix(moduleResampling_t::linear)};
+		const auto sinc4Tap{mix(moduleResampling_t::sinc4Tap)};
+		const auto result{mix(moduleResampling_t::sinc8Tap)};
+		checkInterpolated(result, nearest);
+		assertEqual(result.pcm.size(), nearest.pcm.size());
+		assertTrue(result.pcm != linear.pcm);
+		assertTrue(result.pcm != sinc4Tap.pcm);
+	}
+
+	void testInvalidMode()
+	{
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(moduleFile)};
+		assertNotNull(file.get());
+		auto &module{static_cast<moduleFile_t &>(*file)};
+		assertFalse(module.resampling(static_cast<moduleResampling_t>(4U)));
+		assertTrue(module.resampling() == moduleResampling_t::nearest);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testNearest)
+		CXX_TEST(testLinear)
+		CXX_TEST(testSinc4Tap)
+		CXX_TEST(testSinc8Tap)
+		CXX_TEST(testInvalidMode)
+	}
+};
+
+CRUNCHpp_TESTS(testModuleMixer)
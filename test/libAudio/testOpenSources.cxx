@@ -0,0 +1,140 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *moduleFile{"testModule.mod"};
+constexpr static const char *wavFile{"testWAV.wav"};
+
+// The data behind a set of I/O callbacks, standing in for wherever an application keeps its audio
+struct callbackData_t final
+{
+	std::vector<uint8_t> data{};
+	int64_t position{0};
+	int64_t length{0};
+};
+
+int64_t readCallback(void *const user, void *const buffer, const size_t length)
+{
+	auto &source{*static_cast<callbackData_t *>(user)};
+	const auto amount{std::min<size_t>(length, source.data.size() - size_t(source.position))};
+	std::memcpy(buffer, source.data.data() + source.position, amount);
+	source.position += int64_t(amount);
+	return int64_t(amount);
+}
+
+int64_t seekCallback(void *const user, const int64_t offset, const int whence)
+{
+	auto &source{*static_cast<callbackData_t *>(user)};
+	if (whence == SEEK_SET)
+		source.position = offset;
+	else if (whence == SEEK_CUR)
+		source.position += offset;
+	else
+		source.position = int64_t(source.data.size()) + offset;
+	return source.position;
+}
+
+int64_t tellCallback(void *const user) { return static_cast<callbackData_t *>(user)->position; }
+int64_t lengthCallback(void *const user) { return static_cast<callbackData_t *>(user)->length; }
+
+// Decodes the whole of the file through the C API, returning nothing if decoding fails part way
+std::vector<int16_t> decodeAll(void *const file)
+{
+	std::vector<int16_t> samples{};
+	std::vector<int16_t> buffer(4096U);
+	while (true)
+	{
+		const auto result{audioFillBuffer(file, buffer.data(), uint32_t(buffer.size() * sizeof(int16_t)))};
+		if (result == -2 || result == 0)
+			return samples;
+		if (result < 0)
+			return {};
+		samples.insert(samples.end(), buffer.begin(), buffer.begin() + (result / 2));
+	}
+}
+
+class testOpenSources final : public testsuite
+{
+private:
+	std::vector<uint8_t> readFixture(const char *const fileName)
+	{
+		fd_t file{fileName, O_RDONLY};
+		assertTrue(file.valid());
+		const auto length{file.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	// Decodes the file from memory and through callbacks, both with and without a length callback,
+	// and checks every way gives exactly what opening the file by name does
+	void checkSources(const char *const fileName)
+	{
+		std::unique_ptr<audioFile_t> file{static_cast<audioFile_t *>(audioOpenR(fileName))};
+		assertNotNull(file.get());
+		const auto expected{decodeAll(file.get())};
+		assertFalse(expected.empty());
+		const auto &info{file->fileInfo()};
+
+		callbackData_t source{readFixture(fileName)};
+		source.length = int64_t(source.data.size());
+		std::vector<std::unique_ptr<audioFile_t>> files{};
+		files.emplace_back(static_cast<audioFile_t *>(audioOpenRMemory(source.data.data(), source.data.size())));
+		files.emplace_back(static_cast<audioFile_t *>(audioOpenRCallbacks(readCallback, seekCallback,
+			tellCallback, lengthCallback, &source)));
+		for (auto &sourceFile : files)
+		{
+			assertNotNull(sourceFile.get());
+			assertTrue(sourceFile->type() == file->type());
+			assertTrue(decodeAll(sourceFile.get()) == expected);
+			const auto &sourceInfo{sourceFile->fileInfo()};
+			assertEqual(sourceInfo.bitRate(), info.bitRate());
+			assertEqual(sourceInfo.channels(), info.channels());
+			assertEqual(sourceInfo.totalTime(), info.totalTime());
+		}
+		files.clear();
+
+		// Without tell or length callbacks the length is found by seeking
+		source.position = 0;
+		file.reset(static_cast<audioFile_t *>(audioOpenRCallbacks(readCallback, seekCallback, nullptr, nullptr,
+			&source)));
+		assertNotNull(file.get());
+		assertTrue(decodeAll(file.get()) == expected);
+	}
+
+	void testWAV() { checkSources(wavFile); }
+	void testModule() { checkSources(moduleFile); }
+
+	void testBadLength()
+	{
+		callbackData_t source{readFixture(wavFile)};
+		// Any negative length is an error, not just -1
+		for (const auto length : {int64_t{-1}, int64_t{-2}, INT64_MIN})
+		{
+			source.position = 0;
+			source.length = length;
+			assertNull(audioOpenRCallbacks(readCallback, seekCallback, tellCallback, lengthCallback, &source));
+		}
+		assertNull(audioOpenRCallbacks(readCallback, nullptr, tellCallback, lengthCallback, &source));
+		assertNull(audioOpenRMemory(nullptr, 0U));
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testWAV)
+		CXX_TEST(testModule)
+		CXX_TEST(testBadLength)
+	}
+};
+
+CRUNCHpp_TESTS(testOpenSources)
@@ -0,0 +1,147 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <chrono>
+#include <memory>
+#include <thread>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+using namespace std::literals::chrono_literals;
+
+constexpr static const char *moduleFile{"testModule.mod"};
+constexpr static const char *wavFile{"testWAV.wav"};
+// Where the sample data starts in the WAV fixture
+constexpr static size_t wavDataOffset{44U};
+
+class testPlayback final : public testsuite
+{
+private:
+	std::unique_ptr<audioFile_t> openPlayer(const char *const fileName, const char *const backend,
+		const playbackMode_t mode)
+	{
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(fileName)};
+		assertNotNull(file.get());
+		assertTrue(file->playbackBackend(backend));
+		assertTrue(file->playbackMode(mode));
+		return file;
+	}
+
+	// Checks the decoder thread is no longer running by making sure the ring stays as it is
+	void checkDecoderStopped(const audioFile_t &file)
+	{
+		const auto before{file.playbackStats()};
+		std::this_thread::sleep_for(20ms);
+		const auto after{file.playbackStats()};
+		assertEqual(after.ringOccupancy, before.ringOccupancy);
+		assertEqual(after.producerStalls, before.producerStalls);
+	}
+
+	void testPlayWait()
+	{
+		auto file{openPlayer(moduleFile, "null:fast", playbackMode_t::wait)};
+		// Playing in wait mode runs to the end of the audio before returning
+		file->play();
+		const auto stats{file->playbackStats()};
+		assertEqual(stats.underruns, 0U);
+		assertEqual(stats.decoderUnderruns, 0U);
+		// Only the end-of-stream block is left in the ring
+		assertEqual(stats.ringOccupancy, 1U);
+		checkDecoderStopped(*file);
+		file.reset();
+	}
+
+	void testStopAsync()
+	{
+		auto file{openPlayer(moduleFile, "null", playbackMode_t::async)};
+		file->play();
+		std::this_thread::sleep_for(30ms);
+		file->stop();
+		// Stopping must stop the decoder thread as well as the output
+		checkDecoderStopped(*file);
+		// And playback must be able to start back up again afterwards
+		file->play();
+		std::this_thread::sleep_for(10ms);
+		file->stop();
+		checkDecoderStopped(*file);
+	}
+
+	void testCloseWhilePlaying()
+	{
+		// Closing a file with playback running must stop it before the decoder is torn down
+		auto file{openPlayer(moduleFile, "null", playbackMode_t::async)};
+		file->play();
+		std::this_thread::sleep_for(20ms);
+		file.reset();
+
+		// Likewise for a file that has been paused, leaving the decoder thread prefilling
+		file = openPlayer(wavFile, "null", playbackMode_t::async);
+		file->play();
+		std::this_thread::sleep_for(10ms);
+		file->pause();
+		file.reset();
+	}
+
+	void testStopFromAnotherThread()
+	{
+		// In wait mode, play() blocks, so stopping has to come from elsewhere
+		auto file{openPlayer(moduleFile, "null", playbackMode_t::wait)};
+		std::thread stopper{[&]()
+		{
+			std::this_thread::sleep_for(30ms);
+			file->stop();
+		}};
+		const auto start{std::chrono::steady_clock::now()};
+		file->play();
+		const auto elapsed{std::chrono::steady_clock::now() - start};
+		stopper.join();
+		// The module lasts the best part of half a second when played in realtime
+		assertTrue(elapsed < 300ms);
+		checkDecoderStopped(*file);
+	}
+
+	void testSeekWhilePaused()
+	{
+		auto file{openPlayer(wavFile, "null", playbackMode_t::async)};
+		file->play();
+		std::this_thread::sleep_for(10ms);
+		file->pause();
+		// Seeking must stop the decoder thread and throw away what it decoded ahead..
+		assertTrue(audioSeek(file.get(), 0U));
+		assertEqual(file->playbackStats().ringOccupancy, 0U);
+		checkDecoderStopped(*file);
+		// ..so decoding directly then carries on from the new position
+		std::vector<int16_t> samples(32U);
+		assertEqual(audioFillBuffer(file.get(), samples.data(), uint32_t(samples.size() * sizeof(int16_t))),
+			int64_t(samples.size() * sizeof(int16_t)));
+
+		fd_t wav{wavFile, O_RDONLY};
+		assertTrue(wav.valid());
+		assertTrue(wav.seek(wavDataOffset, SEEK_SET) == off_t(wavDataOffset));
+		std::vector<int16_t> expected(samples.size());
+		assertTrue(wav.read(expected.data(), expected.size() * sizeof(int16_t)));
+		for (size_t i{0U}; i < samples.size(); ++i)
+			assertEqual(samples[i], expected[i]);
+
+		// Playback then picks back up from wherever direct decoding left off
+		assertTrue(file->playbackMode(playbackMode_t::wait));
+		file->play();
+		assertEqual(file->playbackStats().ringOccupancy, 1U);
+	}
+
+public:
+	void registerTests() final
+	{
+		// Keep the tests from needing an audio device, even for the player made before the backend is switched
+		audioPlaybackBackend("null");
+		CXX_TEST(testPlayWait)
+		CXX_TEST(testStopAsync)
+		CXX_TEST(testCloseWhilePlaying)
+		CXX_TEST(testStopFromAnotherThread)
+		CXX_TEST(testSeekWhilePaused)
+	}
+};
+
+CRUNCHpp_TESTS(testPlayback)
@@ -0,0 +1,277 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <array>
+#include <string_view>
+#include <vector>
+#ifndef _WINDOWS
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+#include <probe.hxx>
+
+using namespace std::literals::string_view_literals;
+
+constexpr static const char *probeFile{"testProbe.tmp"};
+// How much of a file the probe reads
+constexpr static size_t prefixSize{4096U};
+
+std::vector<uint8_t> bytes(const std::string_view data) { return {data.begin(), data.end()}; }
+
+// Pads the data out to the given offset and places the magic there
+std::vector<uint8_t> bytes(std::vector<uint8_t> data, const size_t offset, const std::string_view magic)
+{
+	data.resize(offset, 0U);
+	data.insert(data.end(), magic.begin(), magic.end());
+	return data;
+}
+
+std::vector<uint8_t> bytes(const size_t offset, const std::string_view magic) { return bytes({}, offset, magic); }
+
+// The CRC-32 Ogg pages are checked with - MSB first over the polynomial 0x04c11db7, with no initial value or final XOR
+uint32_t oggCRC(const std::vector<uint8_t> &data) noexcept
+{
+	uint32_t crc{0U};
+	for (const auto byte : data)
+	{
+		crc ^= uint32_t{byte} << 24U;
+		for (size_t bit{0U}; bit < 8U; ++bit)
+			crc = (crc & 0x80000000U) ? (crc << 1U) ^ 0x04c11db7U : crc << 1U;
+	}
+	return crc;
+}
+
+// Builds the first page of an Ogg stream holding just the given packet, padded to the 79 bytes the probe reads
+std::vector<uint8_t> oggPage(const std::string_view packet)
+{
+	auto page{bytes("OggS\x00\x02"sv)};
+	// Granule position, stream serial number, page sequence number and CRC
+	page.resize(page.size() + 8U + 4U + 4U + 4U, 0U);
+	page[14] = 1U;
+	page.push_back(1U);
+	page.push_back(uint8_t(packet.size()));
+	page.insert(page.end(), packet.begin(), packet.end());
+	const auto crc{oggCRC(page)};
+	for (size_t i{0U}; i < 4U; ++i)
+		page[22U + i] = uint8_t(crc >> (i * 8U));
+	if (page.size() < 79U)
+		page.resize(79U, 0U);
+	return page;
+}
+
+// A format's C API detection function along with the shortest prefix it should recognise
+struct format_t final
+{
+	bool (*isFormat)(const char *fileName);
+	std::vector<uint8_t> prefix;
+};
+
+std::vector<format_t> formats()
+{
+	std::vector<format_t> result
+	{
+		{isWAV, bytes("RIFF\x24\x00\x00\x00WAVE"sv)},
+		{isMOD, bytes((30U * 31U) + 150U, "M.K."sv)},
+		{isMOD, bytes((30U * 31U) + 150U, "FLT8"sv)},
+		{isS3M, bytes(bytes(28U, "\x1a"sv), 44U, "SCRM"sv)},
+		{isSTM, bytes(20U, "!Scream!\x1a"sv)},
+		{isIT, bytes("IMPM"sv)},
+		{isSNDH, bytes("ICE!"sv)},
+		{isSNDH, bytes(12U, "SNDH"sv)},
+#ifdef ENABLE_AON
+		{isAON, bytes("AON4artofnoise by bastian spiegel(twice/lego)\x00"sv)},
+#endif
+#ifdef ENABLE_FC1x
+		{isFC1x, bytes("SMOD"sv)},
+		{isFC1x, bytes("FC14"sv)},
+#endif
+#ifdef ENABLE_VORBIS
+		{isOggVorbis, oggPage("\x01vorbis\x00\x00\x00\x00\x02\x44\xac\x00\x00\x00\x00\x00\x00"
+			"\x00\xf4\x01\x00\x00\x00\x00\x00\xb8\x01"sv)},
+#endif
+#ifdef ENABLE_OPUS
+		{isOggOpus, oggPage("OpusHead\x01\x02\x38\x01\x80\xbb\x00\x00\x00\x00\x00"sv)},
+#endif
+#ifdef ENABLE_FLAC
+		{isFLAC, bytes("fLaC"sv)},
+		{isFLAC, oggPage("\x7f" "FLAC\x01\x00\x00\x01" "fLaC"sv)},
+#endif
+#ifdef ENABLE_M4A
+		{isM4A, bytes("\x00\x00\x00\x1c" "ftypM4A "sv)},
+		{isM4A, bytes("\x00\x00\x00\x1c" "ftypmp42"sv)},
+#endif
+#ifdef ENABLE_AAC
+		{isAAC, bytes("\xff\xf1"sv)},
+#endif
+#ifdef ENABLE_MP3
+		{isMP3, bytes("ID3"sv)},
+		{isMP3, bytes("\xff\xfb"sv)},
+#endif
+#ifdef ENABLE_MUSEPACK
+		{isMPC, bytes("MP+"sv)},
+		{isMPC, bytes("MPC"sv)},
+#endif
+#ifdef ENABLE_WAVPACK
+		{isWavPack, bytes("wvpk"sv)},
+#endif
+#ifdef ENABLE_SID
+		{isSID, bytes("PSID"sv)},
+#endif
+#ifdef ENABLE_OptimFROG
+		{isOptimFROG, bytes("OFR "sv)},
+#endif
+#ifdef ENABLE_WMA
+		{isWMA, bytes("\x30\x26\xb2\x75\x8e\x66\xcf\x11\xa6\xd9\x00\xaa\x00\x62\xce\x6c"sv)},
+#endif
+	};
+	return result;
+}
+
+class testProbe final : public testsuite
+{
+private:
+	void writeFile(const std::vector<uint8_t> &data)
+	{
+		fd_t file{probeFile, O_WRONLY | O_CREAT | O_TRUNC, substrate::normalMode};
+		assertTrue(file.valid());
+		assertTrue(data.empty() || file.write(data.data(), data.size()));
+	}
+
+	// Checks the probe finds the format both from its C API and when detecting any format
+	void assertDetected(const format_t &format, const std::vector<uint8_t> &data)
+	{
+		writeFile(data);
+		assertTrue(format.isFormat(probeFile));
+		assertTrue(isAudio(probeFile));
+	}
+
+	void testDetect()
+	{
+		for (const auto &format : formats())
+		{
+			// Files that are no longer than the magic, so much shorter than the probe's prefix..
+			assertTrue(format.prefix.size() < prefixSize);
+			assertDetected(format, format.prefix);
+			// ..and files that are longer than the prefix
+			auto data{format.prefix};
+			data.resize(prefixSize * 2U, 0U);
+			assertDetected(format, data);
+		}
+	}
+
+	void testOtherFormats()
+	{
+		// Every format must turn down every other format's magic
+		const auto candidates{formats()};
+		for (const auto &format : candidates)
+		{
+			for (const auto &other : candidates)
+			{
+				if (other.isFormat == format.isFormat)
+					continue;
+				writeFile(other.prefix);
+				assertFalse(format.isFormat(probeFile));
+			}
+		}
+
+		// And nothing must be found in a prefix's worth of nothing
+		writeFile(std::vector<uint8_t>(prefixSize, 0U));
+		for (const auto &format : candidates)
+			assertFalse(format.isFormat(probeFile));
+		assertFalse(isAudio(probeFile));
+	}
+
+	void testTruncated()
+	{
+		// Files that stop part way through the magic must not be detected, even if what there is matches
+		for (const auto &format : formats())
+		{
+			for (const size_t length : {size_t{0U}, size_t{1U}, format.prefix.size() - 1U})
+			{
+				writeFile({format.prefix.begin(), format.prefix.begin() + ptrdiff_t(length)});
+				assertFalse(format.isFormat(probeFile));
+				assertFalse(isAudio(probeFile));
+			}
+		}
+	}
+
+	void testPrefix()
+	{
+		std::vector<uint8_t> data(prefixSize * 2U);
+		for (size_t i{0U}; i < data.size(); ++i)
+			data[i] = uint8_t(i);
+
+		// A source shorter than the prefix is probed in its entirety..
+		const audioProbe_t shortProbe{inputSource_t{data.data(), 100U}};
+		assertTrue(shortProbe.valid());
+		assertEqual(shortProbe.length(), 100U);
+		std::array<uint8_t, 4> value{};
+		assertTrue(shortProbe.read(96U, value));
+		assertEqual(value[3], 99U);
+		assertTrue(shortProbe.matches(96U, value));
+		// ..with reads off its end failing rather than returning what's past the end of the source
+		assertFalse(shortProbe.read(97U, value));
+		assertFalse(shortProbe.read(200U, value));
+
+		// A longer source is probed only as far as the prefix
+		const audioProbe_t longProbe{inputSource_t{data.data(), data.size()}};
+		assertTrue(longProbe.valid());
+		assertEqual(longProbe.length(), prefixSize);
+		assertTrue(longProbe.read(prefixSize - 4U, value));
+		assertFalse(longProbe.read(prefixSize - 3U, value));
+
+		// And an empty one can't be probed at all
+		const audioProbe_t emptyProbe{inputSource_t{data.data(), 0U}};
+		assertFalse(emptyProbe.valid());
+		assertFalse(emptyProbe.read(0U, value));
+	}
+
+	void testShortFile()
+	{
+		std::vector<uint8_t> data(100U);
+		for (size_t i{0U}; i < data.size(); ++i)
+			data[i] = uint8_t(i);
+		writeFile(data);
+
+		// Probing a file by name keeps the file open for the loader, at its start
+		audioProbe_t probe{probeFile};
+		assertTrue(probe.valid());
+		assertEqual(probe.length(), data.size());
+		assertTrue(std::string_view{probe.fileName()} == probeFile);
+		const auto source{probe.takeSource()};
+		assertTrue(source.valid());
+		assertEqual(source.length(), off_t(data.size()));
+		assertEqual(source.tell(), 0);
+		assertFalse(probe.valid());
+
+		// Probing by descriptor reads the prefix, and puts the file back to its start afterwards
+		const fd_t file{probeFile, O_RDONLY};
+		assertTrue(file.valid());
+		assertEqual(file.seek(10, SEEK_SET), 10);
+		const audioProbe_t fdProbe{int32_t{file}};
+		assertTrue(fdProbe.valid());
+		assertEqual(fdProbe.length(), data.size());
+		std::array<uint8_t, 2> value{};
+		assertTrue(fdProbe.read(0U, value));
+		assertEqual(value[1], 1U);
+		assertEqual(file.tell(), 0);
+	}
+
+public:
+	~testProbe() final { unlink(probeFile); }
+
+	void registerTests() final
+	{
+		CXX_TEST(testDetect)
+		CXX_TEST(testOtherFormats)
+		CXX_TEST(testTruncated)
+		CXX_TEST(testPrefix)
+		CXX_TEST(testShortFile)
+	}
+};
+
+CRUNCHpp_TESTS(testProbe)
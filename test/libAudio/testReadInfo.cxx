@@ -0,0 +1,107 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <memory>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *moduleFile{"testModule.mod"};
+constexpr static const char *wavFile{"testWAV.wav"};
+// The module fixture's header, sample table, order list and one pattern, which is everything but the sample data
+constexpr static size_t moduleHeaderLength{1084U + 1024U};
+
+class testReadInfo final : public testsuite
+{
+private:
+	std::vector<uint8_t> readFixture(const char *const fileName)
+	{
+		fd_t file{fileName, O_RDONLY};
+		assertTrue(file.valid());
+		const auto length{file.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	// Checks that reading just the information gets the same answers as opening the file fully
+	void checkMatchesOpen(const char *const fileName)
+	{
+		fileInfo_t info{};
+		assertTrue(audioReadInfo(fileName, info));
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(fileName)};
+		assertNotNull(file.get());
+		// Modules only work out how long they play for once they're set up to decode, so decode a little first
+		std::vector<int16_t> buffer(1024U);
+		assertTrue(file->fillBuffer(buffer.data(), uint32_t(buffer.size() * sizeof(int16_t))) > 0);
+		const auto &openInfo{file->fileInfo()};
+		assertEqual(info.totalTime(), openInfo.totalTime());
+		assertEqual(info.bitRate(), openInfo.bitRate());
+		assertEqual(info.channels(), openInfo.channels());
+		assertEqual(info.bitsPerSample(), openInfo.bitsPerSample());
+		assertTrue(info.sampleFormat() == openInfo.sampleFormat());
+	}
+
+	void testWAV()
+	{
+		checkMatchesOpen(wavFile);
+		fileInfo_t info{};
+		assertTrue(audioReadInfo(wavFile, info));
+		assertEqual(info.bitRate(), 22050U);
+		assertEqual(info.channels(), 2U);
+		assertEqual(info.bitsPerSample(), 16U);
+	}
+
+	void testModule()
+	{
+		checkMatchesOpen(moduleFile);
+		fileInfo_t info{};
+		assertTrue(audioReadInfo(moduleFile, info));
+		assertEqual(info.bitRate(), 44100U);
+		assertEqual(info.channels(), 2U);
+		// The 4 rows play for just under half a second, which rounds up
+		assertEqual(info.totalTime(), 1U);
+	}
+
+	void testModuleSkipsPCM()
+	{
+		const auto data{readFixture(moduleFile)};
+		assertTrue(data.size() > moduleHeaderLength);
+		fileInfo_t expected{};
+		assertTrue(audioReadInfo(moduleFile, expected));
+
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(inputSource_t{data.data(), data.size()})};
+		assertNotNull(file.get());
+		// With the sample data cut off, opening the module fails as it can't load the samples..
+		file.reset(audioFile_t::openR(inputSource_t{data.data(), moduleHeaderLength}));
+		assertNull(file.get());
+		// ..but reading just the information must still work, as that never needs them
+		fileInfo_t info{};
+		assertTrue(audioFile_t::probeInfo(inputSource_t{data.data(), moduleHeaderLength}, info));
+		assertEqual(info.totalTime(), expected.totalTime());
+		assertEqual(info.bitRate(), expected.bitRate());
+		assertEqual(info.channels(), expected.channels());
+	}
+
+	void testNotAudio()
+	{
+		const std::vector<uint8_t> data(256U, 0U);
+		fileInfo_t info{};
+		assertFalse(audioFile_t::probeInfo(inputSource_t{data.data(), data.size()}, info));
+		assertFalse(audioReadInfo("nonExistent.wav", info));
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testWAV)
+		CXX_TEST(testModule)
+		CXX_TEST(testModuleSkipsPCM)
+		CXX_TEST(testNotAudio)
+	}
+};
+
+CRUNCHpp_TESTS(testReadInfo)
@@ -0,0 +1,126 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <string_view>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *sidFile{"testSID.sid"};
+constexpr static const char *wavFile{"testWAV.wav"};
+// The fixture's header, which is everything but the tune
+constexpr static size_t headerLength{0x7cU};
+// 1/10th of a second at the emulator's 48kHz
+constexpr static size_t renderLength{4800U};
+
+class testSID final : public testsuite
+{
+private:
+	std::vector<uint8_t> readFixture()
+	{
+		fd_t file{sidFile, O_RDONLY};
+		assertTrue(file.valid());
+		const auto length{file.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	std::vector<int16_t> render(audioFile_t &file)
+	{
+		std::vector<int16_t> samples(renderLength);
+		assertEqual(file.fillBuffer(samples.data(), uint32_t(samples.size() * sizeof(int16_t))),
+			int64_t(samples.size() * sizeof(int16_t)));
+		return samples;
+	}
+
+	void testOpen()
+	{
+#ifdef ENABLE_SID
+		assertTrue(isSID(sidFile));
+		assertFalse(isSID(wavFile));
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(sidFile)};
+		assertNotNull(file.get());
+		assertTrue(file->type() == audioType_t::sid);
+		const auto &info{file->fileInfo()};
+		assertEqual(info.bitRate(), 48000U);
+		assertEqual(info.channels(), 1U);
+		assertEqual(info.bitsPerSample(), 16U);
+		assertTrue(std::string_view{info.title()} == "libAudio test");
+		assertTrue(std::string_view{info.artist()} == "dragonmux");
+		assertEqual(info.otherCommentsCount(), 1U);
+
+		// Reading just the information must agree with opening the file, without running the tune
+		fileInfo_t readInfo{};
+		assertTrue(audioReadInfo(sidFile, readInfo));
+		assertEqual(readInfo.bitRate(), info.bitRate());
+		assertEqual(readInfo.channels(), info.channels());
+		assertTrue(std::string_view{readInfo.title()} == "libAudio test");
+#else
+		skip("SID support not built");
+#endif
+	}
+
+	void testRender()
+	{
+#ifdef ENABLE_SID
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(sidFile)};
+		assertNotNull(file.get());
+		// The tune starts a full volume sawtooth, which must come out as neither silence nor a constant
+		const auto samples{render(*file)};
+		int32_t peak{0};
+		for (const auto value : samples)
+			peak = std::max(peak, std::abs(int32_t{value}));
+		assertTrue(peak > 1024);
+		const auto [minimum, maximum]{std::minmax_element(samples.begin(), samples.end())};
+		assertTrue(*maximum - *minimum > 2048);
+
+		// The machine is emulated exactly, so opening the tune afresh, even from memory, must play the same
+		const auto data{readFixture()};
+		std::unique_ptr<audioFile_t> memoryFile{audioFile_t::openR(inputSource_t{data.data(), data.size()})};
+		assertNotNull(memoryFile.get());
+		assertTrue(memoryFile->type() == audioType_t::sid);
+		assertTrue(render(*memoryFile) == samples);
+#else
+		skip("SID support not built");
+#endif
+	}
+
+	void testMalformed()
+	{
+#ifdef ENABLE_SID
+		auto data{readFixture()};
+		// A header with no tune after it can be read for its information, but not played
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(inputSource_t{data.data(), headerLength})};
+		assertNull(file.get());
+		fileInfo_t info{};
+		assertFalse(audioFile_t::probeInfo(inputSource_t{data.data(), headerLength}, info));
+		// A truncated header is rejected either way
+		file.reset(audioFile_t::openR(inputSource_t{data.data(), 0x40U}));
+		assertNull(file.get());
+		assertFalse(audioFile_t::probeInfo(inputSource_t{data.data(), 0x40U}, info));
+		// As is a tune that would load over the I/O area
+		data[headerLength + 1U] = 0xd0U;
+		file.reset(audioFile_t::openR(inputSource_t{data.data(), data.size()}));
+		assertNull(file.get());
+#else
+		skip("SID support not built");
+#endif
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testOpen)
+		CXX_TEST(testRender)
+		CXX_TEST(testMalformed)
+	}
+};
+
+CRUNCHpp_TESTS(testSID)
@@ -0,0 +1,209 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <exception>
+#include <string_view>
+#include <vector>
+#include <crunch++.h>
+#include <substrate/fd>
+#include <sid/loader.hxx>
+
+using substrate::fd_t;
+
+constexpr static const char *sidFile{"testSID.sid"};
+constexpr static uint16_t headerV1Length{0x76U};
+constexpr static uint16_t headerV2Length{0x7cU};
+
+void writeBE(std::vector<uint8_t> &data, const size_t offset, const uint16_t value)
+{
+	data[offset] = uint8_t(value >> 8U);
+	data[offset + 1U] = uint8_t(value);
+}
+
+void writeBE(std::vector<uint8_t> &data, const size_t offset, const uint32_t value)
+{
+	writeBE(data, offset, uint16_t(value >> 16U));
+	writeBE(data, offset + 2U, uint16_t(value));
+}
+
+// Builds a PSID with the given header fields, followed by 4 bytes of tune data
+std::vector<uint8_t> makePSID(const uint16_t version, const uint16_t load, const uint16_t tuneCount,
+	const uint16_t defaultTune, const uint32_t speed, const uint16_t flags = 0U)
+{
+	const uint16_t dataOffset{version == 1U ? headerV1Length : headerV2Length};
+	std::vector<uint8_t> data(dataOffset + 4U, 0U);
+	std::memcpy(data.data(), "PSID", 4U);
+	writeBE(data, 4U, version);
+	writeBE(data, 6U, dataOffset);
+	writeBE(data, 8U, load);
+	writeBE(data, 10U, uint16_t(load + 3U));
+	writeBE(data, 12U, uint16_t(load + 6U));
+	writeBE(data, 14U, tuneCount);
+	writeBE(data, 16U, defaultTune);
+	writeBE(data, 18U, speed);
+	std::memcpy(data.data() + 22U, "tune", 4U);
+	if (version >= 2U)
+		writeBE(data, 0x76U, flags);
+	// RTS, so the tune could be run
+	data[dataOffset] = 0x60U;
+	return data;
+}
+
+class testSIDLoader final : public testsuite
+{
+private:
+	std::vector<uint8_t> readFixture()
+	{
+		fd_t file{sidFile, O_RDONLY};
+		assertTrue(file.valid());
+		const auto length{file.seek(0, SEEK_END)};
+		assertTrue(length > 0);
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(length), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	void assertRejected(const std::vector<uint8_t> &data, const size_t length)
+	{
+		const inputSource_t source{data.data(), length};
+		bool rejected{false};
+		try
+			{ sidLoader_t loader{source}; }
+		catch (const std::exception &)
+			{ rejected = true; }
+		assertTrue(rejected);
+	}
+
+	void assertRejected(const std::vector<uint8_t> &data) { assertRejected(data, data.size()); }
+
+	void testV2()
+	{
+		// The fixture is a v2 header whose data starts with the load address, and which has no init address
+		const auto data{readFixture()};
+		const inputSource_t source{data.data(), data.size()};
+		sidLoader_t loader{source};
+		const auto &entryPoints{loader.entryPoints()};
+		assertEqual(entryPoints.load, 0x1000U);
+		assertEqual(entryPoints.init, 0x1000U);
+		assertEqual(entryPoints.play, 0x101eU);
+		const auto &metadata{loader.metadata()};
+		assertEqual(metadata.tuneCount, 2U);
+		assertEqual(metadata.defaultTune, 1U);
+		assertFalse(metadata.ntsc);
+		assertTrue(metadata.model == sidModel_t::mos8580);
+		assertFalse(loader.ciaSpeed(1U));
+		assertTrue(std::string_view{metadata.title.get()} == "libAudio test");
+		assertTrue(std::string_view{metadata.artist.get()} == "dragonmux");
+		// The copyright sign is Latin-1 in the file, and must come out as UTF-8
+		assertTrue(std::string_view{metadata.released.get()} == "2026 \xc2\xa9 dragonmux");
+
+		commodore64_t emulator{metadata.model, metadata.ntsc};
+		assertTrue(loader.copyToRAM(emulator));
+	}
+
+	void testV1()
+	{
+		// Version 1 headers have no flags, so are always PAL 6581 tunes
+		auto data{makePSID(1U, 0x2000U, 40U, 41U, 0x80000002U)};
+		const inputSource_t source{data.data(), data.size()};
+		sidLoader_t loader{source};
+		const auto &entryPoints{loader.entryPoints()};
+		assertEqual(entryPoints.load, 0x2000U);
+		assertEqual(entryPoints.init, 0x2003U);
+		assertEqual(entryPoints.play, 0x2006U);
+		const auto &metadata{loader.metadata()};
+		assertEqual(metadata.tuneCount, 40U);
+		// A default tune past the last one falls back to the first
+		assertEqual(metadata.defaultTune, 1U);
+		assertFalse(metadata.ntsc);
+		assertTrue(metadata.model == sidModel_t::mos6581);
+		assertTrue(std::string_view{metadata.title.get()} == "tune");
+		assertNull(metadata.artist.get());
+		// Each of the first 32 tunes has its own speed bit, with the rest sharing the last
+		assertFalse(loader.ciaSpeed(1U));
+		assertTrue(loader.ciaSpeed(2U));
+		assertFalse(loader.ciaSpeed(3U));
+		assertTrue(loader.ciaSpeed(32U));
+		assertTrue(loader.ciaSpeed(40U));
+
+		commodore64_t emulator{metadata.model, metadata.ntsc};
+		assertTrue(loader.copyToRAM(emulator));
+	}
+
+	void testV2Flags()
+	{
+		// NTSC in bits 2-3 and a 6581 in bits 4-5
+		auto data{makePSID(2U, 0x1000U, 1U, 1U, 0U, (2U << 2U) | (1U << 4U))};
+		const inputSource_t source{data.data(), data.size()};
+		sidLoader_t loader{source};
+		assertTrue(loader.metadata().ntsc);
+		assertTrue(loader.metadata().model == sidModel_t::mos6581);
+	}
+
+	void testMalformed()
+	{
+		const auto valid{makePSID(2U, 0x1000U, 1U, 1U, 0U)};
+		// Not a PSID at all - RSIDs included
+		auto data{valid};
+		std::memcpy(data.data(), "RSID", 4U);
+		assertRejected(data);
+		// Versions outside 1 through 4
+		data = valid;
+		writeBE(data, 4U, uint16_t{0U});
+		assertRejected(data);
+		writeBE(data, 4U, uint16_t{5U});
+		assertRejected(data);
+		// The data starting inside the header
+		data = valid;
+		writeBE(data, 6U, uint16_t(headerV2Length - 1U));
+		assertRejected(data);
+		data = makePSID(1U, 0x1000U, 1U, 1U, 0U);
+		writeBE(data, 6U, uint16_t(headerV1Length - 1U));
+		assertRejected(data);
+		// No tunes
+		data = valid;
+		writeBE(data, 14U, uint16_t{0U});
+		assertRejected(data);
+		// Compute!'s Sidplayer data rather than machine code
+		data = makePSID(2U, 0x1000U, 1U, 1U, 0U, 0x0001U);
+		assertRejected(data);
+		// Tunes for a second or third SID
+		data = valid;
+		data[0x7aU] = 0x42U;
+		assertRejected(data);
+		data = valid;
+		data[0x7bU] = 0x42U;
+		assertRejected(data);
+		// The data offset pointing past the end of the file
+		data = valid;
+		writeBE(data, 6U, uint16_t(data.size()));
+		assertRejected(data);
+		// A load address of 0 with nothing but the real load address after it
+		data = makePSID(2U, 0x0000U, 1U, 1U, 0U);
+		data.resize(headerV2Length + 2U);
+		assertRejected(data);
+	}
+
+	void testTruncated()
+	{
+		// Cutting the file off anywhere in the header, or before any of the tune data, must be refused
+		const auto data{readFixture()};
+		for (const size_t length : {size_t{0U}, size_t{3U}, size_t{4U}, size_t{21U}, size_t{22U}, size_t{0x55U},
+				size_t{headerV1Length}, size_t{0x79U}, size_t{headerV2Length}, size_t{headerV2Length + 2U}})
+			assertRejected(data, length);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testV2)
+		CXX_TEST(testV1)
+		CXX_TEST(testV2Flags)
+		CXX_TEST(testMalformed)
+		CXX_TEST(testTruncated)
+	}
+};
+
+CRUNCHpp_TESTS(testSIDLoader)
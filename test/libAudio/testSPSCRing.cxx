@@ -0,0 +1,146 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <thread>
+#include <crunch++.h>
+#include <spscRing.hxx>
+
+class testSPSCRing final : public testsuite
+{
+private:
+	void testEmptyFull()
+	{
+		spscRing_t<uint32_t, 4U> ring{};
+		assertTrue(ring.empty());
+		assertFalse(ring.full());
+		assertNull(ring.readSlot());
+
+		// Fill the ring, checking the slots are handed out in order
+		for (uint32_t i{0U}; i < 4U; ++i)
+		{
+			auto *const slot{ring.writeSlot()};
+			assertNotNull(slot);
+			assertTrue(slot == &ring.slots()[i]);
+			*slot = i;
+			ring.commitWrite();
+		}
+		assertTrue(ring.full());
+		assertNull(ring.writeSlot());
+
+		// Drain one and check that frees up exactly one slot for writing
+		auto *const slot{ring.readSlot()};
+		assertNotNull(slot);
+		assertEqual(*slot, 0U);
+		ring.commitRead();
+		assertFalse(ring.full());
+		assertTrue(ring.writeSlot() == &ring.slots()[0]);
+	}
+
+	void testWrapAround()
+	{
+		spscRing_t<uint32_t, 2U> ring{};
+		// Run the indices around the ring a good few times to check they wrap properly
+		for (uint32_t i{0U}; i < 9U; ++i)
+		{
+			auto *const writeSlot{ring.writeSlot()};
+			assertNotNull(writeSlot);
+			*writeSlot = i;
+			ring.commitWrite();
+			auto *const readSlot{ring.readSlot()};
+			assertNotNull(readSlot);
+			assertEqual(*readSlot, i);
+			ring.commitRead();
+			assertTrue(ring.empty());
+		}
+		ring.reset();
+		assertTrue(ring.empty());
+		assertTrue(ring.writeSlot() == &ring.slots()[0]);
+	}
+
+	void testDynamic()
+	{
+		spscRing_t<uint32_t> ring{};
+		// With no slots, the ring is both empty and full
+		assertEqual(ring.size(), 0U);
+		assertNull(ring.writeSlot());
+		assertNull(ring.readSlot());
+		assertFalse(ring.resize(0U));
+		assertFalse(ring.resize(3U));
+		assertTrue(ring.resize(4U));
+		assertEqual(ring.size(), 4U);
+		assertEqual(ring.slots().size(), 4U);
+
+		for (uint32_t i{0U}; i < 3U; ++i)
+		{
+			auto *const slot{ring.writeSlot()};
+			assertNotNull(slot);
+			*slot = i;
+			ring.commitWrite();
+			assertEqual(ring.occupancy(), i + 1U);
+		}
+		assertNotNull(ring.readSlot());
+		ring.commitRead();
+		assertEqual(ring.occupancy(), 2U);
+
+		// Resizing throws away whatever was in the ring
+		assertTrue(ring.resize(8U));
+		assertTrue(ring.empty());
+		assertEqual(ring.occupancy(), 0U);
+		for (uint32_t i{0U}; i < 8U; ++i)
+		{
+			auto *const slot{ring.writeSlot()};
+			assertNotNull(slot);
+			assertTrue(slot == &ring.slots()[i]);
+			ring.commitWrite();
+		}
+		assertTrue(ring.full());
+		assertNull(ring.writeSlot());
+	}
+
+	void testThreaded()
+	{
+		constexpr uint32_t count{100000U};
+		spscRing_t<uint32_t, 8U> ring{};
+		std::thread producer{[&]()
+		{
+			for (uint32_t i{0U}; i < count;)
+			{
+				if (auto *const slot{ring.writeSlot()})
+				{
+					*slot = i++;
+					ring.commitWrite();
+				}
+				else
+					std::this_thread::yield();
+			}
+		}};
+
+		// Check every value makes it through, and in order
+		uint32_t expected{0U};
+		bool inOrder{true};
+		while (expected < count)
+		{
+			if (auto *const slot{ring.readSlot()})
+			{
+				inOrder &= *slot == expected++;
+				ring.commitRead();
+			}
+			else
+				std::this_thread::yield();
+		}
+		producer.join();
+		assertTrue(inOrder);
+		assertTrue(ring.empty());
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testEmptyFull)
+		CXX_TEST(testWrapAround)
+		CXX_TEST(testDynamic)
+		CXX_TEST(testThreaded)
+	}
+};
+
+CRUNCHpp_TESTS(testSPSCRing)
@@ -0,0 +1,133 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <type_traits>
+#include <crunch++.h>
+#include <sampleConversion.hxx>
+
+using namespace libAudio::sampleConversion;
+
+class testSampleConversion final : public testsuite
+{
+private:
+	void testFromInt32()
+	{
+		// Full scale in both directions
+		assertEqual(fromInt32<sampleFormat_t::int8>(INT32_MAX), INT8_MAX);
+		assertEqual(fromInt32<sampleFormat_t::int8>(INT32_MIN), INT8_MIN);
+		assertEqual(fromInt32<sampleFormat_t::int16>(INT32_MAX), INT16_MAX);
+		assertEqual(fromInt32<sampleFormat_t::int16>(INT32_MIN), INT16_MIN);
+		assertEqual(fromInt32<sampleFormat_t::int24>(INT32_MAX), 8388607);
+		assertEqual(fromInt32<sampleFormat_t::int24>(INT32_MIN), -8388608);
+		assertEqual(fromInt32<sampleFormat_t::int32>(INT32_MAX), INT32_MAX);
+		assertEqual(fromInt32<sampleFormat_t::int32>(INT32_MIN), INT32_MIN);
+		assertTrue(fromInt32<sampleFormat_t::float32>(INT32_MIN) == -1.0F);
+		// INT32_MAX is not representable as a float, and rounds up to exactly 1
+		assertTrue(fromInt32<sampleFormat_t::float32>(INT32_MAX) == 1.0F);
+		assertTrue(fromInt32<sampleFormat_t::float32>(0) == 0.0F);
+		assertTrue(fromInt32<sampleFormat_t::float32>(0x40000000) == 0.5F);
+
+		// Narrowing drops the low bits, which rounds towards negative infinity
+		assertEqual(fromInt32<sampleFormat_t::int16>(0x0001ffff), 1);
+		assertEqual(fromInt32<sampleFormat_t::int16>(-1), -1);
+		assertEqual(fromInt32<sampleFormat_t::int16>(-0x00010000), -1);
+		assertEqual(fromInt32<sampleFormat_t::int16>(-0x00010001), -2);
+		assertEqual(fromInt32<sampleFormat_t::int8>(0x01ffffff), 1);
+		assertEqual(fromInt32<sampleFormat_t::int8>(-1), -1);
+
+		// 24-bit samples come out right justified and sign extended in their 32-bit containers
+		assertEqual(fromInt32<sampleFormat_t::int24>(0x12345678), 0x00123456);
+		assertEqual(fromInt32<sampleFormat_t::int24>(int32_t(0x87654321U)), int32_t(0xff876543U));
+		assertEqual(fromInt32<sampleFormat_t::int24>(0x000000ff), 0);
+		assertEqual(fromInt32<sampleFormat_t::int24>(-0x00000100), -1);
+	}
+
+	void testFromFloat()
+	{
+		// Full scale maps to the largest positive value in both directions, keeping the conversion symmetric
+		assertEqual(fromFloat<sampleFormat_t::int8>(1.0F), INT8_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int8>(-1.0F), -INT8_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int16>(1.0F), INT16_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int16>(-1.0F), -INT16_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int24>(1.0F), 8388607);
+		assertEqual(fromFloat<sampleFormat_t::int24>(-1.0F), -8388607);
+		assertEqual(fromFloat<sampleFormat_t::int32>(1.0F), INT32_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int32>(-1.0F), -INT32_MAX);
+
+		// Anything beyond full scale saturates rather than wrapping
+		assertEqual(fromFloat<sampleFormat_t::int8>(1.5F), INT8_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int8>(-8.0F), -INT8_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int16>(2.0F), INT16_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int16>(-2.0F), -INT16_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int24>(1.0001F), 8388607);
+		assertEqual(fromFloat<sampleFormat_t::int24>(-1.0001F), -8388607);
+		assertEqual(fromFloat<sampleFormat_t::int32>(3.0F), INT32_MAX);
+		assertEqual(fromFloat<sampleFormat_t::int32>(-3.0F), -INT32_MAX);
+		// Float output is passed through untouched, out of range values included
+		assertTrue(fromFloat<sampleFormat_t::float32>(1.5F) == 1.5F);
+		assertTrue(fromFloat<sampleFormat_t::float32>(-0.25F) == -0.25F);
+
+		// Values between steps are truncated towards zero, the same in both directions
+		assertEqual(fromFloat<sampleFormat_t::int16>(0.0F), 0);
+		assertEqual(fromFloat<sampleFormat_t::int16>(1.9F / 32767.0F), 1);
+		assertEqual(fromFloat<sampleFormat_t::int16>(-1.9F / 32767.0F), -1);
+		assertEqual(fromFloat<sampleFormat_t::int16>(0.5F), 16383);
+		assertEqual(fromFloat<sampleFormat_t::int16>(-0.5F), -16383);
+		assertEqual(fromFloat<sampleFormat_t::int8>(0.5F), 63);
+		assertEqual(fromFloat<sampleFormat_t::int8>(-0.5F), -63);
+		assertEqual(fromFloat<sampleFormat_t::int24>(0.5F), 4194303);
+		assertEqual(fromFloat<sampleFormat_t::int24>(-0.5F), -4194303);
+		assertEqual(fromFloat<sampleFormat_t::int32>(0.5F), 1073741823);
+		assertEqual(fromFloat<sampleFormat_t::int32>(-0.5F), -1073741823);
+	}
+
+	void testToFloat()
+	{
+		assertTrue(toFloat<sampleFormat_t::int8>(INT8_MIN) == -1.0F);
+		assertTrue(toFloat<sampleFormat_t::int8>(64) == 0.5F);
+		assertTrue(toFloat<sampleFormat_t::int16>(INT16_MIN) == -1.0F);
+		assertTrue(toFloat<sampleFormat_t::int16>(-16384) == -0.5F);
+		assertTrue(toFloat<sampleFormat_t::int24>(-8388608) == -1.0F);
+		assertTrue(toFloat<sampleFormat_t::int24>(4194304) == 0.5F);
+		assertTrue(toFloat<sampleFormat_t::int32>(INT32_MIN) == -1.0F);
+		assertTrue(toFloat<sampleFormat_t::float32>(0.75F) == 0.75F);
+		// Converting full scale down and back again gets back to where we started
+		assertTrue(toFloat<sampleFormat_t::int24>(fromInt32<sampleFormat_t::int24>(INT32_MIN)) == -1.0F);
+	}
+
+	void testWithSampleFormat()
+	{
+		for (const auto format : {sampleFormat_t::int8, sampleFormat_t::int16, sampleFormat_t::int24,
+			sampleFormat_t::int32, sampleFormat_t::float32})
+		{
+			const auto selected
+			{
+				withSampleFormat(format, [](const auto sampleFormat)
+				{
+					constexpr auto value{decltype(sampleFormat)::value};
+					// The sample type must match the format picked for it
+					static_assert(sizeof(sample_t<value>) == (value == sampleFormat_t::int8 ? 1U :
+						value == sampleFormat_t::int16 ? 2U : 4U));
+					static_assert(std::is_floating_point_v<sample_t<value>> == (value == sampleFormat_t::float32));
+					return value;
+				})
+			};
+			assertTrue(selected == format);
+		}
+		// Formats that aren't recognised get 16-bit, the same as the decoders default to
+		const auto fallback{withSampleFormat(static_cast<sampleFormat_t>(0xffU),
+			[](const auto sampleFormat) { return decltype(sampleFormat)::value; })};
+		assertTrue(fallback == sampleFormat_t::int16);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testFromInt32)
+		CXX_TEST(testFromFloat)
+		CXX_TEST(testToFloat)
+		CXX_TEST(testWithSampleFormat)
+	}
+};
+
+CRUNCHpp_TESTS(testSampleConversion)
@@ -0,0 +1,149 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#ifndef _WINDOWS
+#include <unistd.h>
+#else
+#include <io.h>
+#endif
+#include <crunch++.h>
+#include <substrate/fd>
+#include <moduleMixer/scanCache.hxx>
+
+using substrate::fd_t;
+
+constexpr static const char *cacheFile{"scanCache.test"};
+constexpr static const char *otherCacheFile{"scanCacheOther.test"};
+
+class testScanCache final : public testsuite
+{
+private:
+	void testDisabled()
+	{
+		scanCache_t cache{};
+		assertFalse(cache.enabled());
+		assertFalse(cache.store(1U, {}));
+		assertFalse(cache.find(1U).has_value());
+	}
+
+	void testRoundTrip()
+	{
+		scanCache_t cache{};
+		assertTrue(cache.path(cacheFile));
+		assertTrue(cache.enabled());
+		assertFalse(cache.find(0x0123456789abcdefU).has_value());
+
+		assertTrue(cache.store(0x0123456789abcdefU, {123456U, {{1U, 2U, 3U}, {4U, 63U, 31U}}}));
+		assertTrue(cache.store(42U, {789U, {}}));
+
+		// A fresh cache on the same file must see the records the first one wrote
+		scanCache_t reopened{};
+		assertTrue(reopened.path(cacheFile));
+		const auto first{reopened.find(0x0123456789abcdefU)};
+		assertTrue(first.has_value());
+		assertEqual(first->samplesProduced, 123456U);
+		assertEqual(first->disabledEffects.size(), 2U);
+		assertEqual(first->disabledEffects[1].pattern, 4U);
+		assertEqual(first->disabledEffects[1].row, 63U);
+		assertEqual(first->disabledEffects[1].channel, 31U);
+		const auto second{reopened.find(42U)};
+		assertTrue(second.has_value());
+		assertEqual(second->samplesProduced, 789U);
+		assertTrue(second->disabledEffects.empty());
+		assertFalse(reopened.find(43U).has_value());
+
+		assertTrue(cache.path({}));
+		assertFalse(cache.enabled());
+	}
+
+	void testIndex()
+	{
+		scanCache_t cache{};
+		assertTrue(cache.path(cacheFile));
+		for (uint64_t key{100U}; key < 200U; ++key)
+			assertTrue(cache.store(key, {key * 3U, {{uint16_t(key), 0U, 0U}}}));
+		// The first lookup indexes the file, and every record must be found through that index
+		for (uint64_t key{100U}; key < 200U; ++key)
+		{
+			const auto result{cache.find(key)};
+			assertTrue(result.has_value());
+			assertEqual(result->samplesProduced, key * 3U);
+			assertEqual(result->disabledEffects.size(), 1U);
+			assertEqual(result->disabledEffects[0].pattern, key);
+		}
+		assertFalse(cache.find(200U).has_value());
+
+		// Records stored once the index is built must be added to it
+		assertTrue(cache.store(200U, {600U, {}}));
+		const auto added{cache.find(200U)};
+		assertTrue(added.has_value());
+		assertEqual(added->samplesProduced, 600U);
+
+		// A key that's stored twice keeps its first result, whether or not the file has been indexed
+		assertTrue(cache.store(150U, {1U, {}}));
+		assertEqual(cache.find(150U)->samplesProduced, 450U);
+		scanCache_t reopened{};
+		assertTrue(reopened.path(cacheFile));
+		assertEqual(reopened.find(150U)->samplesProduced, 450U);
+		assertEqual(reopened.find(200U)->samplesProduced, 600U);
+
+		// Changing the path must throw the index away
+		{
+			const fd_t file{otherCacheFile, O_WRONLY | O_CREAT | O_TRUNC, substrate::normalMode};
+			assertTrue(file.valid());
+		}
+		assertTrue(cache.path(otherCacheFile));
+		assertFalse(cache.find(100U).has_value());
+		assertTrue(cache.store(100U, {9U, {}}));
+		assertEqual(cache.find(100U)->samplesProduced, 9U);
+	}
+
+	void testTruncated()
+	{
+		scanCache_t cache{};
+		assertTrue(cache.path(cacheFile));
+		assertTrue(cache.store(7U, {1U, {{0U, 0U, 0U}}}));
+		// Chop the last byte of the record off, as an interrupted write might
+		{
+			const fd_t file{cacheFile, O_RDWR};
+			assertTrue(file.valid());
+			assertTrue(file.resize(file.length() - 1));
+		}
+		assertFalse(cache.find(7U).has_value());
+	}
+
+	void testNotACache()
+	{
+		{
+			const fd_t file{cacheFile, O_WRONLY | O_CREAT | O_TRUNC, substrate::normalMode};
+			assertTrue(file.write("not a cache", 11U));
+		}
+		scanCache_t cache{};
+		assertFalse(cache.path(cacheFile));
+		assertFalse(cache.enabled());
+	}
+
+public:
+	testScanCache()
+	{
+		unlink(cacheFile);
+		unlink(otherCacheFile);
+	}
+
+	~testScanCache() final
+	{
+		unlink(cacheFile);
+		unlink(otherCacheFile);
+	}
+
+	void registerTests() final
+	{
+		CXX_TEST(testDisabled)
+		CXX_TEST(testRoundTrip)
+		CXX_TEST(testIndex)
+		CXX_TEST(testTruncated)
+		CXX_TEST(testNotACache)
+	}
+};
+
+CRUNCHpp_TESTS(testScanCache)
@@ -0,0 +1,122 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstdlib>
+#include <algorithm>
+#include <memory>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *wavFile{"testWAV.wav"};
+constexpr static const char *mp3File{"testMP3.mp3"};
+// 1/10th of a second of stereo at 22050Hz
+constexpr static uint64_t wavFrames{2205U};
+// 24 MPEG-1 Layer III frames of 1152 samples each, in mono
+constexpr static uint64_t mp3Frames{24U * 1152U};
+
+// Decodes the rest of file, returning nothing if decoding fails part way
+std::vector<int16_t> decodeAll(audioFile_t &file)
+{
+	std::vector<int16_t> samples{};
+	std::vector<int16_t> buffer(4096U);
+	while (true)
+	{
+		const auto result{file.fillBuffer(buffer.data(), uint32_t(buffer.size() * sizeof(int16_t)))};
+		if (result == -2 || result == 0)
+			return samples;
+		if (result < 0)
+			return {};
+		samples.insert(samples.end(), buffer.begin(), buffer.begin() + (result / 2));
+	}
+}
+
+class testSeek final : public testsuite
+{
+private:
+	/*
+	 * Checks that seeking to each of the targets puts decoding at exactly that sample frame, by decoding on
+	 * from there and comparing against the whole file decoded from the start. The targets are gone through
+	 * in order, so include seeks both back and forth from where the last left decoding.
+	 */
+	void checkSeeks(audioFile_t &file, const std::vector<int16_t> &expected, const uint64_t frames,
+		const std::vector<uint64_t> &targets)
+	{
+		const auto channels{file.fileInfo().channels()};
+		assertEqual(expected.size(), frames * channels);
+		for (const auto target : targets)
+		{
+			assertTrue(file.seek(target));
+			assertEqual(file.tell(), target);
+
+			// tell() must follow decoding on from wherever the seek left it
+			std::vector<int16_t> samples(100U * channels);
+			const auto result{file.fillBuffer(samples.data(), uint32_t(samples.size() * sizeof(int16_t)))};
+			const auto count{result > 0 ? size_t(result) / sizeof(int16_t) : 0U};
+			assertEqual(count, size_t(std::min<uint64_t>(100U, frames - target) * channels));
+			samples.resize(count);
+			assertEqual(file.tell(), target + (count / channels));
+
+			const auto rest{decodeAll(file)};
+			samples.insert(samples.end(), rest.begin(), rest.end());
+			assertEqual(samples.size(), size_t((frames - target) * channels));
+			assertTrue(std::equal(samples.begin(), samples.end(), expected.begin() + ptrdiff_t(target * channels)));
+			assertEqual(file.tell(), frames);
+		}
+		// Seeking past the end is refused
+		assertFalse(file.seek(frames + 1U));
+	}
+
+	void testWAV()
+	{
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(wavFile)};
+		assertNotNull(file.get());
+		assertEqual(file->tell(), 0U);
+		const auto expected{decodeAll(*file)};
+		assertEqual(file->tell(), wavFrames);
+		checkSeeks(*file, expected, wavFrames, {0U, 1U, 1000U, 999U, wavFrames - 1U, wavFrames, 0U, 1234U});
+
+		// The C API goes to the same place
+		assertTrue(audioSeek(file.get(), 441U));
+		assertEqual(audioTell(file.get()), 441U);
+		int16_t sample{};
+		assertEqual(audioFillBuffer(file.get(), &sample, sizeof(sample)), int64_t{sizeof(sample)});
+		assertEqual(sample, expected[441U * 2U]);
+	}
+
+	void testMP3()
+	{
+#ifdef ENABLE_MP3
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(mp3File)};
+		assertNotNull(file.get());
+		assertTrue(file->type() == audioType_t::mp3);
+		assertEqual(file->fileInfo().channels(), 1U);
+		assertEqual(file->fileInfo().bitRate(), 32000U);
+		assertEqual(file->tell(), 0U);
+		const auto expected{decodeAll(*file)};
+		assertEqual(file->tell(), mp3Frames);
+		// Comparing against silence would show nothing about where the seek landed
+		int32_t peak{0};
+		for (const auto value : expected)
+			peak = std::max(peak, std::abs(int32_t{value}));
+		assertTrue(peak > 256);
+
+		// Seeks that land within the first frame, on and either side of frame boundaries, and far enough in
+		// that decoding skips frames to get there - each of which must land on exactly the sample asked for
+		checkSeeks(*file, expected, mp3Frames, {0U, 1U, 1151U, 1152U, 1153U, 5000U, 20U * 1152U, 20000U,
+			mp3Frames - 1U, mp3Frames, 0U, 13U * 1152U + 7U, 2U * 1152U});
+#else
+		skip("MP3 support not built");
+#endif
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testWAV)
+		CXX_TEST(testMP3)
+	}
+};
+
+CRUNCHpp_TESTS(testSeek)
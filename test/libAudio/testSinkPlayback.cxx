@@ -0,0 +1,470 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+using namespace std::literals::chrono_literals;
+using substrate::make_unique_nothrow;
+
+constexpr static const char *outputFile{"testSinkOutput.wav"};
+constexpr static uint32_t sampleRate{48000U};
+// 1024 frames of 16-bit stereo, which is just over 21ms of audio
+constexpr static uint32_t blockLength{4096U};
+constexpr static uint32_t headerLength{44U};
+
+uint8_t patternByte(const uint64_t offset) noexcept { return uint8_t((offset * 13U) % 251U); }
+
+// A decoder that produces a known byte pattern, optionally taking its time over each block
+struct fakeSource_t final : public audioFile_t
+{
+	uint64_t length;
+	std::chrono::milliseconds delay;
+	std::atomic<uint64_t> offset{0U};
+
+	fakeSource_t(const uint64_t totalLength, const sampleFormat_t format,
+		const std::chrono::milliseconds blockDelay = 0ms) noexcept :
+		audioFile_t{audioType_t::wave, fd_t{}}, length{totalLength}, delay{blockDelay}
+	{
+		fileInfo().bitRate(sampleRate);
+		fileInfo().channels(2U);
+		fileInfo().sampleFormat(format);
+	}
+
+	~fakeSource_t() noexcept final { _player.reset(); }
+
+	int64_t fillBuffer(void *const buffer, const uint32_t bufferLength) final
+	{
+		if (offset == length)
+			return -2;
+		std::this_thread::sleep_for(delay);
+		const auto amount{std::min<uint64_t>(bufferLength, length - offset)};
+		auto *const data{static_cast<uint8_t *>(buffer)};
+		for (uint64_t i{0U}; i < amount; ++i)
+			data[i] = patternByte(offset + i);
+		offset += amount;
+		return int64_t(amount);
+	}
+
+	void ensurePlayable() noexcept final
+	{
+		if (!_player)
+			player(make_unique_nothrow<playback_t>(this, audioFillBuffer, nullptr, blockLength, fileInfo()));
+	}
+};
+
+// A decoder that only produces the blocks it's been let through to, so the test decides how far ahead it gets
+struct gatedSource_t final : public audioFile_t
+{
+	uint64_t length;
+	uint64_t offset{0U};
+	uint32_t allowed{0U};
+	uint32_t produced{0U};
+	std::mutex gateLock{};
+	std::condition_variable gate{};
+
+	gatedSource_t(const uint64_t totalLength) noexcept : audioFile_t{audioType_t::wave, fd_t{}}, length{totalLength}
+	{
+		fileInfo().bitRate(sampleRate);
+		fileInfo().channels(2U);
+		fileInfo().sampleFormat(sampleFormat_t::int16);
+	}
+
+	~gatedSource_t() noexcept final { _player.reset(); }
+
+	int64_t fillBuffer(void *const buffer, const uint32_t bufferLength) final
+	{
+		std::unique_lock<std::mutex> lock{gateLock};
+		if (offset == length)
+			return -2;
+		gate.wait(lock, [&]() { return produced < allowed; });
+		const auto amount{std::min<uint64_t>(bufferLength, length - offset)};
+		std::memset(buffer, 0, amount);
+		offset += amount;
+		++produced;
+		lock.unlock();
+		gate.notify_all();
+		return int64_t(amount);
+	}
+
+	// Lets the decoder produce another count blocks, and waits for it to have done so
+	void produce(const uint32_t count)
+	{
+		std::unique_lock<std::mutex> lock{gateLock};
+		allowed += count;
+		gate.notify_all();
+		gate.wait(lock, [&]() { return produced == allowed; });
+	}
+
+	// Opens the gate for good, to let the decoder run through to the end
+	void open()
+	{
+		std::lock_guard<std::mutex> lock{gateLock};
+		allowed = UINT32_MAX;
+		gate.notify_all();
+	}
+
+	// Waits for the decoder to have found the ring full, stalls times in total
+	void waitForStalls(const uint64_t stalls) const noexcept
+	{
+		while (playbackStats().producerStalls < stalls)
+			std::this_thread::yield();
+	}
+
+	void ensurePlayable() noexcept final
+	{
+		if (!_player)
+			player(make_unique_nothrow<playback_t>(this, audioFillBuffer, nullptr, blockLength, fileInfo()));
+	}
+};
+
+// A player that plays nothing by itself, only taking blocks from the ring when the test tells it to
+struct gatedPlayer_t final : public audioPlayer_t
+{
+	gatedPlayer_t(playback_t &player) noexcept : audioPlayer_t{player} { }
+
+	void play() final { state = playState_t::playing; }
+	void pause() final { state = playState_t::pause; }
+	void stop() final { state = playState_t::stopped; }
+	void volume(float) noexcept final { }
+
+	// Takes the next block from the ring, returning its length
+	int64_t take() const noexcept
+	{
+		const auto *const block{waitForBlock(std::chrono::seconds{10})};
+		if (!block)
+			return 0;
+		const auto length{block->length};
+		releaseBlock();
+		return length;
+	}
+};
+
+gatedPlayer_t *gatedPlayer{nullptr};
+
+std::unique_ptr<audioPlayer_t> gatedBackend(playback_t &player, std::string_view)
+{
+	auto result{make_unique_nothrow<gatedPlayer_t>(player)};
+	gatedPlayer = result.get();
+	return result;
+}
+
+// Rejects every request for a player, to check registering backends
+std::unique_ptr<audioPlayer_t> refuseBackend(playback_t &, std::string_view) { return nullptr; }
+
+class testSinkPlayback final : public testsuite
+{
+private:
+	std::vector<uint8_t> readOutput()
+	{
+		fd_t file{outputFile, O_RDONLY};
+		assertTrue(file.valid());
+		const auto size{file.seek(0, SEEK_END)};
+		assertTrue(size >= off_t(headerLength));
+		assertEqual(file.seek(0, SEEK_SET), 0);
+		std::vector<uint8_t> data(size_t(size), 0U);
+		assertTrue(file.read(data.data(), data.size()));
+		return data;
+	}
+
+	template<typename T> T readLE(const std::vector<uint8_t> &data, const size_t offset)
+	{
+		T value{};
+		for (size_t i{0U}; i < sizeof(T); ++i)
+			value |= T(T(data[offset + i]) << (i * 8U));
+		return value;
+	}
+
+	void checkHeader(const std::vector<uint8_t> &data, const uint16_t formatTag, const uint16_t bits)
+	{
+		const auto dataLength{uint32_t(data.size() - headerLength)};
+		const auto blockAlign{uint16_t(2U * (bits / 8U))};
+		assertEqual(std::memcmp(data.data(), "RIFF", 4U), 0);
+		assertEqual(readLE<uint32_t>(data, 4U), dataLength + headerLength - 8U);
+		assertEqual(std::memcmp(data.data() + 8U, "WAVEfmt ", 8U), 0);
+		assertEqual(readLE<uint32_t>(data, 16U), 16U);
+		assertEqual(readLE<uint16_t>(data, 20U), formatTag);
+		assertEqual(readLE<uint16_t>(data, 22U), 2U);
+		assertEqual(readLE<uint32_t>(data, 24U), sampleRate);
+		assertEqual(readLE<uint32_t>(data, 28U), sampleRate * blockAlign);
+		assertEqual(readLE<uint16_t>(data, 32U), blockAlign);
+		assertEqual(readLE<uint16_t>(data, 34U), bits);
+		assertEqual(std::memcmp(data.data() + 36U, "data", 4U), 0);
+		// The data chunk must cover exactly what was written, no more and no less
+		assertEqual(readLE<uint32_t>(data, 40U), dataLength);
+	}
+
+	void testRegistry()
+	{
+		const auto backends{audioPlaybackBackends()};
+		for (const auto *const name : {"openal", "null", "wav"})
+			assertTrue(std::find(backends.begin(), backends.end(), name) != backends.end());
+
+		// Unknown backends are refused, leaving the default as it was
+		assertTrue(audioPlaybackBackend("null:fast"));
+		assertTrue(audioPlaybackBackend() == "null:fast");
+		assertFalse(audioPlaybackBackend("bogus"));
+		assertFalse(audioPlaybackBackend(""));
+		// As is "wav", as every file played would write over the same WAV file
+		assertFalse(audioPlaybackBackend("wav:" + std::string{outputFile}));
+		assertTrue(audioPlaybackBackend() == "null:fast");
+
+		// Registering needs a name that can be told apart from the argument, and a factory
+		assertFalse(playback_t::registerBackend("", refuseBackend));
+		assertFalse(playback_t::registerBackend("bad:name", refuseBackend));
+		assertFalse(playback_t::registerBackend("refuse", nullptr));
+		assertTrue(playback_t::registerBackend("refuse", refuseBackend));
+		const auto registered{audioPlaybackBackends()};
+		assertTrue(std::find(registered.begin(), registered.end(), "refuse") != registered.end());
+
+		// Per-file selection looks the backend up and checks its argument, keeping the old player on failure
+		fakeSource_t file{blockLength, sampleFormat_t::int16};
+		assertFalse(file.playbackBackend("bogus"));
+		assertFalse(file.playbackBackend("refuse"));
+		assertFalse(file.playbackBackend("null:slow"));
+		assertFalse(file.playbackBackend("wav:"));
+		assertTrue(file.playbackBackend("null"));
+		assertTrue(file.playbackMode(playbackMode_t::wait));
+		file.play();
+		assertEqual(file.offset, file.length);
+		// Once playback has started, the backend is fixed
+		assertFalse(file.playbackBackend("null:fast"));
+	}
+
+	void testPlayPauseStop()
+	{
+		// Slow enough to decode that there is time to pause and stop it part way through
+		fakeSource_t file{blockLength * 64U, sampleFormat_t::int16, 2ms};
+		assertTrue(file.playbackBackend("null:fast"));
+		assertTrue(file.playbackMode(playbackMode_t::async));
+		file.play();
+		std::this_thread::sleep_for(20ms);
+		file.pause();
+		assertTrue(file.offset < file.length);
+
+		file.play();
+		std::this_thread::sleep_for(20ms);
+		file.stop();
+		const uint64_t stopped{file.offset};
+		assertTrue(stopped < file.length);
+		// Stopping stops the decoder thread too
+		std::this_thread::sleep_for(20ms);
+		assertEqual(file.offset, stopped);
+
+		// And playing again picks back up, running to the end
+		assertTrue(file.playbackMode(playbackMode_t::wait));
+		file.play();
+		assertEqual(file.offset, file.length);
+		const auto stats{file.playbackStats()};
+		// Consuming as fast as possible never counts a stall against the decoder
+		assertEqual(stats.underruns, 0U);
+		assertEqual(stats.decoderUnderruns, 0U);
+		assertEqual(stats.ringOccupancy, 1U);
+		// Stopping after the end is harmless
+		file.stop();
+	}
+
+	void testUnderrunCounters()
+	{
+		// A decoder that takes twice as long as a block lasts can't keep up with realtime output..
+		fakeSource_t slowFile{blockLength * 8U, sampleFormat_t::int16, 40ms};
+		assertTrue(slowFile.playbackBackend("null"));
+		assertTrue(slowFile.playbackPrefill(2U));
+		assertTrue(slowFile.playbackMode(playbackMode_t::wait));
+		slowFile.play();
+		const auto slowStats{slowFile.playbackStats()};
+		assertTrue(slowStats.decoderUnderruns > 0U);
+		// ..each of which is a gap in the output
+		assertEqual(slowStats.underruns, slowStats.decoderUnderruns);
+		// ..and waiting for the very first block doesn't count
+		assertTrue(slowStats.decoderUnderruns < 8U);
+
+		// Whereas the same decoder with fast output isn't counted, as the decoder is always the bottleneck then
+		fakeSource_t fastFile{blockLength * 8U, sampleFormat_t::int16, 40ms};
+		assertTrue(fastFile.playbackBackend("null:fast"));
+		assertTrue(fastFile.playbackPrefill(2U));
+		assertTrue(fastFile.playbackMode(playbackMode_t::wait));
+		fastFile.play();
+		const auto fastStats{fastFile.playbackStats()};
+		assertEqual(fastStats.underruns, 0U);
+		assertEqual(fastStats.decoderUnderruns, 0U);
+	}
+
+	void testPrefillStats()
+	{
+		// The decoder and output are both driven by hand here, so each state of the ring is reached on purpose
+		gatedSource_t file{blockLength * 32U};
+		assertTrue(playback_t::registerBackend("gated", gatedBackend));
+		assertTrue(file.playbackBackend("gated"));
+		// The ring's depth must be a power of 2
+		assertFalse(file.playbackPrefill(0U));
+		assertFalse(file.playbackPrefill(3U));
+		assertTrue(file.playbackPrefill(8U));
+		assertEqual(file.playbackStats().ringDepth, 8U);
+
+		file.play();
+		// Once playback has started, the depth is fixed
+		assertFalse(file.playbackPrefill(4U));
+		// The output taking blocks before the decoder has first filled the ring doesn't count against it..
+		file.produce(4U);
+		assertEqual(gatedPlayer->take(), blockLength);
+		assertEqual(gatedPlayer->take(), blockLength);
+		auto stats{file.playbackStats()};
+		assertEqual(stats.ringOccupancy, 2U);
+		assertEqual(stats.ringLowWater, 8U);
+		assertEqual(stats.producerStalls, 0U);
+
+		// ..so once it's full and the decoder has had to wait for space, the mark is still at the depth..
+		file.produce(6U);
+		file.waitForStalls(1U);
+		stats = file.playbackStats();
+		assertEqual(stats.ringDepth, 8U);
+		assertEqual(stats.ringOccupancy, 8U);
+		assertEqual(stats.ringLowWater, 8U);
+
+		// ..and from then on, it follows the ring down as the output takes blocks
+		for (size_t i{0U}; i < 3U; ++i)
+			assertEqual(gatedPlayer->take(), blockLength);
+		stats = file.playbackStats();
+		assertEqual(stats.ringOccupancy, 5U);
+		assertEqual(stats.ringLowWater, 5U);
+
+		// The decoder topping the ring back up doesn't raise it
+		file.produce(3U);
+		file.waitForStalls(2U);
+		stats = file.playbackStats();
+		assertEqual(stats.ringOccupancy, 8U);
+		assertEqual(stats.ringLowWater, 5U);
+		assertEqual(stats.underruns, 0U);
+		assertEqual(stats.decoderUnderruns, 0U);
+		assertEqual(stats.producerStalls, 2U);
+	}
+
+	void testFlushStats()
+	{
+		gatedSource_t file{blockLength * 32U};
+		assertTrue(playback_t::registerBackend("gated", gatedBackend));
+		assertTrue(file.playbackBackend("gated"));
+		assertTrue(file.playbackPrefill(8U));
+		file.play();
+		file.produce(8U);
+		file.waitForStalls(1U);
+		for (size_t i{0U}; i < 6U; ++i)
+			assertEqual(gatedPlayer->take(), blockLength);
+		// Refill the ring so the decoder is waiting on the ring, and not the gate, when the flush stops it
+		file.produce(6U);
+		file.waitForStalls(2U);
+		auto stats{file.playbackStats()};
+		assertEqual(stats.ringOccupancy, 8U);
+		assertEqual(stats.ringLowWater, 2U);
+
+		// Flushing empties the ring, and the decoder has to fill it again before the mark means anything
+		file.flushPlayback();
+		stats = file.playbackStats();
+		assertEqual(stats.ringOccupancy, 0U);
+		assertEqual(stats.ringLowWater, 8U);
+		// The decoder picks back up from where the flush left the file, and the output draining what
+		// little it gets before the ring fills again doesn't count against it
+		file.play();
+		file.produce(2U);
+		assertEqual(gatedPlayer->take(), blockLength);
+		assertEqual(gatedPlayer->take(), blockLength);
+		stats = file.playbackStats();
+		assertEqual(stats.ringOccupancy, 0U);
+		assertEqual(stats.ringLowWater, 8U);
+
+		// And the rest of the audio still plays through to the end
+		file.open();
+		while (gatedPlayer->take() > 0)
+			continue;
+		assertEqual(file.offset, file.length);
+		file.stop();
+	}
+
+	void testWAVOutput()
+	{
+		// Something that doesn't fill the last block, to check the length is kept exact
+		constexpr uint32_t length{(blockLength * 5U) + 1000U};
+		fakeSource_t file{length, sampleFormat_t::int16};
+		assertTrue(file.playbackBackend("wav:" + std::string{outputFile}));
+		assertTrue(file.playbackMode(playbackMode_t::wait));
+		file.play();
+
+		const auto data{readOutput()};
+		assertEqual(data.size(), size_t(headerLength + length));
+		checkHeader(data, 1U, 16U);
+		for (size_t i{0U}; i < length; ++i)
+			assertEqual(data[headerLength + i], patternByte(i));
+
+		// And the file must be one libAudio itself understands
+		std::unique_ptr<audioFile_t> wav{audioFile_t::openR(outputFile)};
+		assertNotNull(wav.get());
+		assertEqual(wav->fileInfo().bitRate(), sampleRate);
+		assertEqual(wav->fileInfo().channels(), 2U);
+		assertEqual(wav->fileInfo().bitsPerSample(), 16U);
+	}
+
+	void testWAVConversion()
+	{
+		// WAV's 8-bit samples are unsigned where libAudio's are signed
+		constexpr uint32_t length{blockLength * 2U};
+		fakeSource_t file{length, sampleFormat_t::int8};
+		assertTrue(file.playbackBackend("wav:" + std::string{outputFile}));
+		assertTrue(file.playbackMode(playbackMode_t::wait));
+		file.play();
+
+		const auto data{readOutput()};
+		assertEqual(data.size(), size_t(headerLength + length));
+		checkHeader(data, 1U, 8U);
+		for (size_t i{0U}; i < length; ++i)
+			assertEqual(data[headerLength + i], uint8_t(patternByte(i) ^ 0x80U));
+	}
+
+	void testWAVStopped()
+	{
+		// Stopping part way must still leave a valid file covering what was written
+		fakeSource_t file{blockLength * 64U, sampleFormat_t::int16, 2ms};
+		assertTrue(file.playbackBackend("wav:" + std::string{outputFile}));
+		assertTrue(file.playbackMode(playbackMode_t::async));
+		file.play();
+		std::this_thread::sleep_for(30ms);
+		file.stop();
+
+		const auto data{readOutput()};
+		assertTrue(data.size() < headerLength + file.length);
+		checkHeader(data, 1U, 16U);
+		for (size_t i{0U}; i < data.size() - headerLength; ++i)
+			assertEqual(data[headerLength + i], patternByte(i));
+	}
+
+public:
+	~testSinkPlayback() final { unlink(outputFile); }
+
+	void registerTests() final
+	{
+		// Keep the tests from needing an audio device, even for the player made before the backend is switched
+		audioPlaybackBackend("null");
+		CXX_TEST(testRegistry)
+		CXX_TEST(testPlayPauseStop)
+		CXX_TEST(testUnderrunCounters)
+		CXX_TEST(testPrefillStats)
+		CXX_TEST(testFlushStats)
+		CXX_TEST(testWAVOutput)
+		CXX_TEST(testWAVConversion)
+		CXX_TEST(testWAVStopped)
+	}
+};
+
+CRUNCHpp_TESTS(testSinkPlayback)
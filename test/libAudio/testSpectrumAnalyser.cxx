@@ -0,0 +1,178 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cmath>
+#include <vector>
+#include <crunch++.h>
+#include <spectrumAnalyser.hxx>
+#include <spectrum/fft.hxx>
+
+using libAudio::spectrum::realFFT_t;
+
+constexpr static double pi{3.14159265358979323846};
+constexpr static uint32_t sampleRate{48000U};
+
+fileInfo_t makeInfo(const sampleFormat_t format, const uint8_t channels)
+{
+	fileInfo_t info{};
+	info.bitRate(sampleRate);
+	info.channels(channels);
+	info.sampleFormat(format);
+	return info;
+}
+
+class testSpectrumAnalyser final : public testsuite
+{
+private:
+	void testFFT()
+	{
+		constexpr size_t length{256U};
+		realFFT_t fft{length};
+		assertEqual(fft.bins(), (length / 2U) + 1U);
+		// Transform something with energy everywhere, and check it against the DFT bin by bin
+		std::vector<float> samples(length);
+		std::vector<float> window(length, 1.0F);
+		uint32_t state{0x12345678U};
+		for (auto &sample : samples)
+		{
+			state = (state * 1664525U) + 1013904223U;
+			sample = float(int32_t(state)) / 2147483648.0F;
+		}
+		std::vector<float> power(fft.bins());
+		fft.transform(samples.data(), window.data(), power.data());
+		for (size_t bin{0U}; bin < fft.bins(); ++bin)
+		{
+			double re{0.0};
+			double im{0.0};
+			for (size_t i{0U}; i < length; ++i)
+			{
+				const double angle{2.0 * pi * double(bin * i) / double(length)};
+				re += samples[i] * std::cos(angle);
+				im -= samples[i] * std::sin(angle);
+			}
+			const double expected{(re * re) + (im * im)};
+			assertTrue(std::fabs(power[bin] - expected) <= 1e-3 * std::max(expected, 1.0));
+		}
+	}
+
+	void testInvalid()
+	{
+		const auto info{makeInfo(sampleFormat_t::int16, 2U)};
+		assertFalse(spectrumAnalyser_t(info, 1000U, 500U).valid());
+		assertFalse(spectrumAnalyser_t(info, 32U, 16U).valid());
+		assertFalse(spectrumAnalyser_t(info, 1024U, 0U).valid());
+		assertFalse(spectrumAnalyser_t(info, 1024U, 2048U).valid());
+		assertFalse(spectrumAnalyser_t(makeInfo(sampleFormat_t::int16, 0U), 1024U, 512U).valid());
+		assertTrue(spectrumAnalyser_t(info, 1024U, 1024U).valid());
+	}
+
+	void testSine()
+	{
+		constexpr uint32_t fftLength{1024U};
+		constexpr uint32_t hopLength{256U};
+		constexpr size_t sineBin{64U};
+		spectrumAnalyser_t analyser{makeInfo(sampleFormat_t::int16, 2U), fftLength, hopLength};
+		assertTrue(analyser.valid());
+		assertEqual(analyser.bins(), 513U);
+		assertTrue(std::fabs(analyser.binWidth() - 46.875F) < 1e-3F);
+
+		// A full scale sine on the left, centred on a bin, and silence on the right
+		constexpr size_t frames{4096U};
+		std::vector<int16_t> pcm(frames * 2U);
+		for (size_t i{0U}; i < frames; ++i)
+			pcm[i * 2U] = int16_t(std::lrint(32767.0 * std::sin(2.0 * pi * double(sineBin * i) / fftLength)));
+
+		size_t count{0U};
+		const auto handler{[&](const spectrumFrame_t &frame)
+		{
+			assertEqual(frame.position, count * hopLength);
+			assertEqual(frame.bins, analyser.bins());
+			assertEqual(frame.channels, 2U);
+			// The mix down halves the sine, so it should read as -6dB, with the main lobe only a bin either side
+			assertTrue(std::fabs(frame.magnitudes[sineBin] + 6.02F) < 0.1F);
+			assertTrue(std::fabs(frame.magnitudes[sineBin - 1U] + 12.04F) < 0.1F);
+			for (size_t bin{0U}; bin < frame.bins; ++bin)
+			{
+				if (bin + 2U < sineBin || bin > sineBin + 2U)
+					assertTrue(frame.magnitudes[bin] < -60.0F);
+			}
+			assertTrue(std::fabs(frame.peak[0U]) < 0.01F);
+			assertTrue(std::fabs(frame.rms[0U] + 3.01F) < 0.05F);
+			assertEqual(frame.peak[1U], -200.0F);
+			assertEqual(frame.rms[1U], -200.0F);
+			++count;
+		}};
+		// Feed the PCM in uneven pieces, which must not change where the frames fall
+		const auto *const data{reinterpret_cast<const uint8_t *>(pcm.data())};
+		size_t offset{0U};
+		for (const size_t piece : {1000U, 4U, 7000U, 12U, 5000U})
+		{
+			analyser.write(data + offset, piece, handler);
+			offset += piece;
+		}
+		analyser.write(data + offset, (pcm.size() * sizeof(int16_t)) - offset, handler);
+		assertEqual(count, ((frames - fftLength) / hopLength) + 1U);
+
+		// Resetting starts the windows over from scratch
+		count = 0U;
+		analyser.reset();
+		analyser.write(pcm.data(), fftLength * 4U, handler);
+		assertEqual(count, 1U);
+	}
+
+	void testFormats()
+	{
+		// A half scale square wave at half the sample rate reads the same whatever the format
+		for (const auto format : {sampleFormat_t::int8, sampleFormat_t::int16, sampleFormat_t::int24,
+			sampleFormat_t::int32, sampleFormat_t::float32})
+		{
+			const auto info{makeInfo(format, 1U)};
+			spectrumAnalyser_t analyser{info, 64U, 64U};
+			std::vector<uint8_t> pcm(64U * info.bytesPerSample());
+			for (size_t i{0U}; i < 64U; ++i)
+			{
+				const int sign{i & 1U ? -1 : 1};
+				switch (format)
+				{
+					case sampleFormat_t::int8:
+						pcm[i] = uint8_t(int8_t(sign * 64));
+						break;
+					case sampleFormat_t::int16:
+						reinterpret_cast<int16_t *>(pcm.data())[i] = int16_t(sign * 16384);
+						break;
+					case sampleFormat_t::int24:
+						reinterpret_cast<int32_t *>(pcm.data())[i] = sign * 4194304;
+						break;
+					case sampleFormat_t::int32:
+						reinterpret_cast<int32_t *>(pcm.data())[i] = sign * 1073741824;
+						break;
+					default:
+						reinterpret_cast<float *>(pcm.data())[i] = float(sign) * 0.5F;
+						break;
+				}
+			}
+			size_t count{0U};
+			analyser.write(pcm.data(), pcm.size(), [&](const spectrumFrame_t &frame)
+			{
+				assertTrue(std::fabs(frame.peak[0U] + 6.02F) < 0.01F);
+				assertTrue(std::fabs(frame.rms[0U] + 6.02F) < 0.01F);
+				// The window spreads the energy into the bin below Nyquist, but none of it reaches DC
+				assertTrue(frame.magnitudes[frame.bins - 2U] > -20.0F);
+				assertTrue(frame.magnitudes[0U] < -100.0F);
+				++count;
+			});
+			assertEqual(count, 1U);
+		}
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testFFT)
+		CXX_TEST(testInvalid)
+		CXX_TEST(testSine)
+		CXX_TEST(testFormats)
+	}
+};
+
+CRUNCHpp_TESTS(testSpectrumAnalyser)
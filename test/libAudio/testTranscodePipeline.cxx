@@ -0,0 +1,196 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstring>
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.hxx>
+#include <transcodePipeline.hxx>
+
+constexpr static uint32_t blockLength{4096U};
+
+uint8_t patternByte(const uint64_t offset) noexcept { return uint8_t((offset * 7U) % 251U); }
+
+// A decoder that produces a known byte pattern, then ends with the result it's told to
+struct fakeDecoder_t final : public audioFile_t
+{
+	uint64_t length;
+	int64_t endResult;
+	uint64_t offset{0U};
+	std::atomic<size_t> calls{0U};
+	std::atomic<size_t> callsAfterEnd{0U};
+	std::thread::id thread{};
+
+	fakeDecoder_t(const uint64_t totalLength, const int64_t result) noexcept :
+		audioFile_t{audioType_t::wave, fd_t{}}, length{totalLength}, endResult{result} { }
+
+	int64_t fillBuffer(void *const buffer, const uint32_t bufferLength) final
+	{
+		thread = std::this_thread::get_id();
+		++calls;
+		if (offset == length)
+		{
+			++callsAfterEnd;
+			return endResult;
+		}
+		// Hand out uneven amounts so the blocks don't all line up neatly
+		const auto amount{std::min<uint64_t>({bufferLength, length - offset, 1000U + ((calls * 317U) % 3000U)})};
+		auto *const data{static_cast<uint8_t *>(buffer)};
+		for (uint64_t i{0U}; i < amount; ++i)
+			data[i] = patternByte(offset + i);
+		offset += amount;
+		return int64_t(amount);
+	}
+
+	void ensurePlayable() noexcept final { }
+};
+
+// An encoder that keeps everything written to it, and can be told to fail part way
+struct fakeEncoder_t final : public audioFile_t
+{
+	size_t failAfter;
+	std::vector<uint8_t> data{};
+	std::vector<int64_t> writes{};
+	std::thread::id thread{};
+
+	fakeEncoder_t(const size_t failAfterWrites = SIZE_MAX) noexcept :
+		audioFile_t{audioType_t::wave, fd_t{}}, failAfter{failAfterWrites} { }
+
+	int64_t fillBuffer(void *, uint32_t) final { return -1; }
+
+	int64_t writeBuffer(const void *const buffer, const int64_t length) final
+	{
+		thread = std::this_thread::get_id();
+		writes.push_back(length);
+		if (writes.size() > failAfter)
+			return -1;
+		if (length > 0)
+		{
+			const auto *const bytes{static_cast<const uint8_t *>(buffer)};
+			data.insert(data.end(), bytes, bytes + length);
+		}
+		return length;
+	}
+
+	void ensurePlayable() noexcept final { }
+};
+
+class testTranscodePipeline final : public testsuite
+{
+private:
+	void checkData(const fakeEncoder_t &encoder, const uint64_t length)
+	{
+		assertEqual(encoder.data.size(), length);
+		bool matches{true};
+		for (uint64_t offset{0U}; offset < length; ++offset)
+			matches &= encoder.data[offset] == patternByte(offset);
+		assertTrue(matches);
+	}
+
+	void testHandoff()
+	{
+		constexpr uint64_t length{1048576U + 123U};
+		fakeDecoder_t decoder{length, -2};
+		fakeEncoder_t encoder{};
+		transcodePipeline_t pipeline{decoder, encoder, blockLength};
+		assertTrue(pipeline.valid());
+
+		std::vector<uint64_t> progress{};
+		bool progressOnCaller{true};
+		const auto caller{std::this_thread::get_id()};
+		assertTrue(pipeline.run([&](const uint64_t bytes)
+		{
+			progressOnCaller &= std::this_thread::get_id() == caller;
+			progress.push_back(bytes);
+		}));
+		// Decoding must happen on its own thread, and encoding on the one that ran the pipeline
+		assertTrue(encoder.thread == caller);
+		assertTrue(decoder.thread != caller);
+		assertTrue(progressOnCaller);
+		// All the data has to come through intact and in order
+		checkData(encoder, length);
+		assertEqual(pipeline.bytes(), length);
+		assertFalse(progress.empty());
+		assertTrue(std::is_sorted(progress.begin(), progress.end()));
+		assertEqual(progress.back(), length);
+	}
+
+	void checkEndOfStream(const int64_t endResult)
+	{
+		constexpr uint64_t length{65536U};
+		fakeDecoder_t decoder{length, endResult};
+		fakeEncoder_t encoder{};
+		transcodePipeline_t pipeline{decoder, encoder, blockLength};
+		assertTrue(pipeline.run());
+		checkData(encoder, length);
+		// The end of the stream must be passed through to the encoder exactly once, as the last write..
+		assertFalse(encoder.writes.empty());
+		assertEqual(encoder.writes.back(), endResult);
+		assertEqual(std::count_if(encoder.writes.begin(), encoder.writes.end(),
+			[](const int64_t result) { return result <= 0; }), 1);
+		// ..and the decoder must not be asked for any more audio once it has ended
+		assertEqual(decoder.callsAfterEnd, 1U);
+	}
+
+	void testEndOfStream()
+	{
+		checkEndOfStream(-2);
+		checkEndOfStream(0);
+	}
+
+	void testDecodeError()
+	{
+		constexpr uint64_t length{65536U};
+		fakeDecoder_t decoder{length, -1};
+		fakeEncoder_t encoder{};
+		transcodePipeline_t pipeline{decoder, encoder, blockLength};
+		// A decoding error must fail the transcode, but everything decoded before it still gets written
+		assertFalse(pipeline.run());
+		checkData(encoder, length);
+		assertEqual(pipeline.bytes(), length);
+		assertEqual(encoder.writes.back(), -1);
+		assertEqual(decoder.callsAfterEnd, 1U);
+	}
+
+	void testEncodeError()
+	{
+		constexpr uint64_t length{1048576U};
+		fakeDecoder_t decoder{length, -2};
+		fakeEncoder_t encoder{3U};
+		transcodePipeline_t pipeline{decoder, encoder, blockLength};
+		// An encoding error must fail the transcode, and stop the decoder rather than leaving it blocked
+		assertFalse(pipeline.run());
+		assertEqual(encoder.writes.size(), 4U);
+		checkData(encoder, encoder.data.size());
+		assertEqual(pipeline.bytes(), encoder.data.size());
+		// The decoder can have filled the ring before it saw the failure, but must go no further
+		assertTrue(decoder.calls <= encoder.writes.size() + 9U);
+		assertTrue(decoder.offset < length);
+	}
+
+	void testInvalid()
+	{
+		fakeDecoder_t decoder{4096U, -2};
+		fakeEncoder_t encoder{};
+		transcodePipeline_t pipeline{decoder, encoder, 0U};
+		assertFalse(pipeline.valid());
+		assertFalse(pipeline.run());
+		assertEqual(decoder.calls, 0U);
+		assertTrue(encoder.writes.empty());
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testHandoff)
+		CXX_TEST(testEndOfStream)
+		CXX_TEST(testDecodeError)
+		CXX_TEST(testEncodeError)
+		CXX_TEST(testInvalid)
+	}
+};
+
+CRUNCHpp_TESTS(testTranscodePipeline)
@@ -0,0 +1,145 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cstdlib>
+#include <cmath>
+#include <algorithm>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+#include <crunch++.h>
+#include <libAudio.h>
+#include <libAudio.hxx>
+
+constexpr static const char *wmaFile{"testWMA.wma"};
+constexpr static double pi{3.14159265358979323846};
+constexpr static uint32_t sampleRate{22050U};
+// 22 frames of 1024 samples each
+constexpr static size_t sampleCount{22U * 1024U};
+// The fixture codes spectral line 92 of 1024, which lies at (92.5 / 1024) * (22050 / 2)
+constexpr static double toneFrequency{996.2};
+
+// Decodes the whole of file, returning nothing if decoding fails part way
+std::vector<int16_t> decodeAll(audioFile_t &file)
+{
+	std::vector<int16_t> samples{};
+	std::vector<int16_t> buffer(4096U);
+	while (true)
+	{
+		const auto result{file.fillBuffer(buffer.data(), uint32_t(buffer.size() * sizeof(int16_t)))};
+		if (result == -2 || result == 0)
+			return samples;
+		if (result < 0)
+			return {};
+		samples.insert(samples.end(), buffer.begin(), buffer.begin() + (result / 2));
+	}
+}
+
+// The power of samples at frequency, by correlating against a sinusoid of that frequency
+double power(const std::vector<int16_t> &samples, const double frequency)
+{
+	double re{0.0};
+	double im{0.0};
+	for (size_t i{0U}; i < samples.size(); ++i)
+	{
+		const double angle{2.0 * pi * frequency * double(i) / double(sampleRate)};
+		re += samples[i] * std::cos(angle);
+		im += samples[i] * std::sin(angle);
+	}
+	return (re * re) + (im * im);
+}
+
+class testWMA final : public testsuite
+{
+private:
+	void testOpen()
+	{
+#ifdef ENABLE_WMA
+		assertTrue(isWMA(wmaFile));
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(wmaFile)};
+		assertNotNull(file.get());
+		assertTrue(file->type() == audioType_t::wma);
+		const auto &info{file->fileInfo()};
+		assertEqual(info.bitRate(), sampleRate);
+		assertEqual(info.channels(), 1U);
+		assertEqual(info.bitsPerSample(), 16U);
+		assertEqual(info.totalTime(), 1U);
+		assertTrue(std::string{info.title()} == "libAudio test");
+		assertTrue(std::string{info.artist()} == "dragonmux");
+
+		// Reading just the information must agree with opening the file
+		fileInfo_t readInfo{};
+		assertTrue(audioReadInfo(wmaFile, readInfo));
+		assertEqual(readInfo.bitRate(), info.bitRate());
+		assertEqual(readInfo.channels(), info.channels());
+		assertEqual(readInfo.totalTime(), info.totalTime());
+#else
+		skip("WMA support not built");
+#endif
+	}
+
+	void testDecode()
+	{
+#ifdef ENABLE_WMA
+		std::unique_ptr<audioFile_t> file{audioFile_t::openR(wmaFile)};
+		assertNotNull(file.get());
+		const auto samples{decodeAll(*file)};
+		assertEqual(samples.size(), sampleCount);
+		// Once finished, the decoder must keep saying so
+		int16_t sample{};
+		assertEqual(file->fillBuffer(&sample, sizeof(sample)), -2);
+
+		// The output must be a clean tone, well clear of both silence and clipping..
+		int32_t peak{0};
+		for (const auto value : samples)
+			peak = std::max(peak, std::abs(int32_t{value}));
+		assertTrue(peak > 4096);
+		assertTrue(peak < 16384);
+		// ..with its energy at the frequency coded and not spread out across the spectrum
+		const auto tone{power(samples, toneFrequency)};
+		assertTrue(tone > 1000.0 * power(samples, toneFrequency / 2.0));
+		assertTrue(tone > 1000.0 * power(samples, toneFrequency * 2.0));
+		assertTrue(tone > 1000.0 * power(samples, toneFrequency * 3.0));
+#else
+		skip("WMA support not built");
+#endif
+	}
+
+	void testConcurrentDecode()
+	{
+#ifdef ENABLE_WMA
+		// Every piece of decoder state is per-stream, so decoding two streams at once on different
+		// threads must give exactly what decoding either alone does
+		std::unique_ptr<audioFile_t> reference{audioFile_t::openR(wmaFile)};
+		assertNotNull(reference.get());
+		const auto expected{decodeAll(*reference)};
+		assertEqual(expected.size(), sampleCount);
+
+		std::unique_ptr<audioFile_t> first{audioFile_t::openR(wmaFile)};
+		std::unique_ptr<audioFile_t> second{audioFile_t::openR(wmaFile)};
+		assertNotNull(first.get());
+		assertNotNull(second.get());
+		std::vector<int16_t> firstSamples{};
+		std::vector<int16_t> secondSamples{};
+		std::thread firstThread{[&]() { firstSamples = decodeAll(*first); }};
+		std::thread secondThread{[&]() { secondSamples = decodeAll(*second); }};
+		firstThread.join();
+		secondThread.join();
+		assertTrue(firstSamples == expected);
+		assertTrue(secondSamples == expected);
+#else
+		skip("WMA support not built");
+#endif
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testOpen)
+		CXX_TEST(testDecode)
+		CXX_TEST(testConcurrentDecode)
+	}
+};
+
+CRUNCHpp_TESTS(testWMA)
@@ -0,0 +1,174 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <cmath>
+#include <algorithm>
+#include <type_traits>
+#include <vector>
+#include <crunch++.h>
+#include <wma/dsp.hxx>
+#include <cpuFeatures.hxx>
+
+using libAudio::wma::fftComplex_t;
+using libAudio::wma::wmaDSP_t;
+using libAudio::wma::scalarWMADSP;
+using libAudio::wma::wmaDSP;
+
+// Long enough for several trips round every vector loop, the longest being the full frame windowing
+constexpr static size_t maxCount{1024U};
+// The data is scaled to around +/-1000, and the vector kernels may fuse multiplies and adds, so allow a few ULPs
+constexpr static float tolerance{1e-2F};
+
+uint32_t nextRandom(uint32_t &state) noexcept
+{
+	state = (state * 1664525U) + 1013904223U;
+	return state;
+}
+
+float randomFloat(uint32_t &state, const float scale) noexcept
+	{ return float(int32_t(nextRandom(state))) / 2147483648.0F * scale; }
+
+class testWMADSP final : public testsuite
+{
+private:
+	wmaDSP_t scalar{};
+
+	void assertClose(const float value, const float expected)
+		{ assertTrue(std::fabs(value - expected) <= tolerance); }
+
+	void assertClose(const fftComplex_t &value, const fftComplex_t &expected)
+	{
+		assertClose(value.re, expected.re);
+		assertClose(value.im, expected.im);
+	}
+
+	template<typename T> std::vector<T> randomData(uint32_t &state, const float scale)
+	{
+		std::vector<T> data(maxCount);
+		for (auto &value : data)
+		{
+			if constexpr (std::is_same_v<T, fftComplex_t>)
+				value = {randomFloat(state, scale), randomFloat(state, scale)};
+			else
+				value = randomFloat(state, scale);
+		}
+		return data;
+	}
+
+	// Checks each kernel in dsp gives the same results as the scalar one, for every count up to past a vector
+	// and for a few long runs, so both the vector loops and the scalar tails get checked
+	void checkDSP(const wmaDSP_t &dsp)
+	{
+		std::vector<size_t> counts{};
+		for (size_t count{0U}; count <= 17U; ++count)
+			counts.push_back(count);
+		for (const size_t count : {size_t{63U}, size_t{64U}, size_t{255U}, size_t{512U}, maxCount})
+			counts.push_back(count);
+		uint32_t state{0x9E3779B9U};
+
+		for (const auto count : counts)
+		{
+			const auto twiddles{randomData<fftComplex_t>(state, 1.0F)};
+			auto lower{randomData<fftComplex_t>(state, 1000.0F)};
+			auto upper{randomData<fftComplex_t>(state, 1000.0F)};
+			auto expectedLower{lower};
+			auto expectedUpper{upper};
+			dsp.butterflies(lower.data(), upper.data(), twiddles.data(), count);
+			scalar.butterflies(expectedLower.data(), expectedUpper.data(), twiddles.data(), count);
+			for (size_t i{0U}; i < maxCount; ++i)
+			{
+				assertClose(lower[i], expectedLower[i]);
+				assertClose(upper[i], expectedUpper[i]);
+			}
+
+			const auto cos{randomData<float>(state, 1.0F)};
+			const auto sin{randomData<float>(state, 1.0F)};
+			auto values{randomData<fftComplex_t>(state, 1000.0F)};
+			auto expectedValues{values};
+			dsp.rotate(values.data(), cos.data(), sin.data(), count);
+			scalar.rotate(expectedValues.data(), cos.data(), sin.data(), count);
+			for (size_t i{0U}; i < maxCount; ++i)
+				assertClose(values[i], expectedValues[i]);
+
+			const auto window{randomData<float>(state, 1.0F)};
+			const auto in{randomData<float>(state, 1000.0F)};
+			auto out{randomData<float>(state, 1000.0F)};
+			auto expectedOut{out};
+			dsp.windowAdd(out.data(), in.data(), window.data(), count);
+			scalar.windowAdd(expectedOut.data(), in.data(), window.data(), count);
+			for (size_t i{0U}; i < maxCount; ++i)
+				assertClose(out[i], expectedOut[i]);
+			dsp.windowReverse(out.data(), in.data(), window.data(), count);
+			scalar.windowReverse(expectedOut.data(), in.data(), window.data(), count);
+			for (size_t i{0U}; i < maxCount; ++i)
+				assertClose(out[i], expectedOut[i]);
+
+			// Out past the 16-bit range, so the saturation gets checked as well as the rounding
+			auto left{randomData<float>(state, 40000.0F)};
+			auto right{randomData<float>(state, 40000.0F)};
+			// Including the halfway cases, which must round to even just like lrint() does
+			if (count >= 4U)
+			{
+				left[0] = 0.5F;
+				left[1] = 1.5F;
+				left[2] = -2.5F;
+				right[3] = 32767.5F;
+			}
+			std::vector<int16_t> pcm(maxCount * 2U, 0);
+			std::vector<int16_t> expectedPCM(maxCount * 2U, 0);
+			dsp.toInt16(pcm.data(), left.data(), nullptr, count);
+			scalar.toInt16(expectedPCM.data(), left.data(), nullptr, count);
+			for (size_t i{0U}; i < pcm.size(); ++i)
+				assertEqual(pcm[i], expectedPCM[i]);
+			dsp.toInt16(pcm.data(), left.data(), right.data(), count);
+			scalar.toInt16(expectedPCM.data(), left.data(), right.data(), count);
+			for (size_t i{0U}; i < pcm.size(); ++i)
+				assertEqual(pcm[i], expectedPCM[i]);
+		}
+	}
+
+	void testSSE2()
+	{
+#ifdef CPU_FEATURES_X86
+		const auto isa{cpuISA()};
+		if (isa != cpuISA_t::sse2 && isa != cpuISA_t::avx2)
+			skip("SSE2 not supported by this machine");
+		wmaDSP_t dsp{};
+		libAudio::wma::sse2WMADSP(dsp);
+		checkDSP(dsp);
+#else
+		skip("SSE2 kernels not built for this machine");
+#endif
+	}
+
+	void testNEON()
+	{
+#ifdef CPU_FEATURES_NEON
+		wmaDSP_t dsp{};
+		libAudio::wma::neonWMADSP(dsp);
+		checkDSP(dsp);
+#else
+		skip("NEON kernels not built for this machine");
+#endif
+	}
+
+	void testSelection()
+	{
+		// Whichever table got picked must agree with the scalar kernels, even if it is them
+		const auto &dsp{wmaDSP()};
+		if (cpuISA() == cpuISA_t::scalar)
+			assertTrue(dsp.butterflies == scalar.butterflies);
+		checkDSP(dsp);
+	}
+
+public:
+	void registerTests() final
+	{
+		scalarWMADSP(scalar);
+		CXX_TEST(testSSE2)
+		CXX_TEST(testNEON)
+		CXX_TEST(testSelection)
+	}
+};
+
+CRUNCHpp_TESTS(testWMADSP)
@@ -0,0 +1,141 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <cstdint>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include <crunch++.h>
+#include "jobPool.hxx"
+
+class testJobPool final : public testsuite
+{
+private:
+	void testWorkerClamping()
+	{
+		// Asking for no workers still gets one..
+		assertEqual(jobPool_t(0U, 4U).workers(), 1U);
+		// ..asking for more workers than there are jobs gets one per job..
+		assertEqual(jobPool_t(8U, 3U).workers(), 3U);
+		// ..and an empty pool still has a worker, which just has nothing to do
+		assertEqual(jobPool_t(4U, 0U).workers(), 1U);
+		assertEqual(jobPool_t(4U, 16U).workers(), 4U);
+
+		jobPool_t pool{4U, 0U};
+		size_t runs{0U};
+		pool.run([&](const size_t, const size_t) { ++runs; });
+		assertEqual(runs, 0U);
+	}
+
+	void testInlineOrdering()
+	{
+		// A single worker pool runs its jobs in order, on the calling thread
+		constexpr size_t jobs{16U};
+		jobPool_t pool{1U, jobs};
+		std::vector<size_t> order{};
+		const auto caller{std::this_thread::get_id()};
+		pool.run([&](const size_t worker, const size_t job)
+		{
+			assertEqual(worker, 0U);
+			assertTrue(std::this_thread::get_id() == caller);
+			order.push_back(job);
+		});
+		assertEqual(order.size(), jobs);
+		for (size_t job{0U}; job < jobs; ++job)
+			assertEqual(order[job], job);
+	}
+
+	void testParallelOrdering()
+	{
+		constexpr size_t workers{4U};
+		constexpr size_t jobs{64U};
+		jobPool_t pool{workers, jobs};
+		assertEqual(pool.workers(), workers);
+		std::mutex lock{};
+		std::vector<std::vector<size_t>> ran(workers);
+		std::vector<std::atomic<size_t>> runs(jobs);
+		pool.run([&](const size_t worker, const size_t job)
+		{
+			++runs[job];
+			std::lock_guard<std::mutex> guard{lock};
+			ran[worker].push_back(job);
+		});
+
+		// Every job must be run exactly once, whoever ends up running it
+		for (const auto &count : runs)
+			assertEqual(count, 1U);
+		for (size_t worker{0U}; worker < workers; ++worker)
+		{
+			// Workers take their own jobs from the front of their queues, and steal from the back of
+			// the others', so the jobs dealt to a worker that it runs itself must come out in order
+			size_t last{0U};
+			bool first{true};
+			for (const auto job : ran[worker])
+			{
+				if (job % workers != worker)
+					continue;
+				if (!first)
+					assertTrue(job > last);
+				last = job;
+				first = false;
+			}
+		}
+	}
+
+	void testCancelInline()
+	{
+		constexpr size_t jobs{16U};
+		jobPool_t pool{1U, jobs};
+		assertFalse(pool.wasCancelled());
+		std::vector<size_t> order{};
+		pool.run([&](const size_t, const size_t job)
+		{
+			order.push_back(job);
+			if (job == 4U)
+				pool.cancel();
+		});
+		assertTrue(pool.wasCancelled());
+		// The job that cancelled the pool gets to finish, but nothing after it is started
+		assertEqual(order.size(), 5U);
+		for (size_t job{0U}; job < order.size(); ++job)
+			assertEqual(order[job], job);
+	}
+
+	void testCancelParallel()
+	{
+		constexpr size_t workers{4U};
+		constexpr size_t jobs{1024U};
+		jobPool_t pool{workers, jobs};
+		std::atomic<size_t> started{0U};
+		std::atomic<size_t> startedAfterCancel{0U};
+		std::atomic<bool> cancelled{false};
+		pool.run([&](const size_t, const size_t)
+		{
+			if (cancelled)
+				++startedAfterCancel;
+			if (++started == 8U)
+			{
+				pool.cancel();
+				cancelled = true;
+			}
+			std::this_thread::yield();
+		});
+		assertTrue(pool.wasCancelled());
+		// Each of the other workers may have been handed one more job just before the pool was cancelled,
+		// but that's all they can have started once the cancellation was seen
+		assertTrue(startedAfterCancel <= workers - 1U);
+		assertTrue(started < jobs);
+	}
+
+public:
+	void registerTests() final
+	{
+		CXX_TEST(testWorkerClamping)
+		CXX_TEST(testInlineOrdering)
+		CXX_TEST(testParallelOrdering)
+		CXX_TEST(testCancelInline)
+		CXX_TEST(testCancelParallel)
+	}
+};
+
+CRUNCHpp_TESTS(testJobPool)
@@ -0,0 +1,76 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#include <thread>
+#include <vector>
+#include <algorithm>
+#include "jobPool.hxx"
+
+void jobQueue_t::push(const size_t job)
+{
+	std::lock_guard<std::mutex> guard{lock};
+	jobs.push_back(job);
+}
+
+// The owning worker takes jobs from the front of its queue..
+std::optional<size_t> jobQueue_t::pop() noexcept
+{
+	std::lock_guard<std::mutex> guard{lock};
+	if (jobs.empty())
+		return std::nullopt;
+	const auto job{jobs.front()};
+	jobs.pop_front();
+	return job;
+}
+
+// ..while thieves take them from the back, so the two mostly work on opposite ends
+std::optional<size_t> jobQueue_t::steal() noexcept
+{
+	std::lock_guard<std::mutex> guard{lock};
+	if (jobs.empty())
+		return std::nullopt;
+	const auto job{jobs.back()};
+	jobs.pop_back();
+	return job;
+}
+
+jobPool_t::jobPool_t(const size_t workers, const size_t jobs) :
+	workerCount{std::clamp<size_t>(workers, 1U, std::max<size_t>(jobs, 1U))},
+	queues{std::make_unique<jobQueue_t []>(workerCount)}
+{
+	for (size_t job{0}; job < jobs; ++job)
+		queues[job % workerCount].push(job);
+}
+
+std::optional<size_t> jobPool_t::nextJob(const size_t worker) noexcept
+{
+	if (cancelled)
+		return std::nullopt;
+	if (const auto job{queues[worker].pop()})
+		return job;
+	// Our own queue is dry, so go looking for work, starting with the next worker along
+	for (size_t offset{1}; offset < workerCount; ++offset)
+	{
+		if (const auto job{queues[(worker + offset) % workerCount].steal()})
+			return job;
+	}
+	// As no jobs are added once the pool is running, finding every queue empty means we're done
+	return std::nullopt;
+}
+
+void jobPool_t::runWorker(const size_t worker, const job_t &job) noexcept
+{
+	while (const auto index{nextJob(worker)})
+		job(worker, *index);
+}
+
+void jobPool_t::run(const job_t &job)
+{
+	// The calling thread acts as worker 0, so a single worker pool runs entirely in-line
+	std::vector<std::thread> threads{};
+	threads.reserve(workerCount - 1U);
+	for (size_t worker{1}; worker < workerCount; ++worker)
+		threads.emplace_back([this, worker, &job]() { runWorker(worker, job); });
+	runWorker(0, job);
+	for (auto &thread : threads)
+		thread.join();
+}
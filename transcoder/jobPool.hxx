@@ -0,0 +1,57 @@
+// SPDX-License-Identifier: BSD-3-Clause
+// SPDX-FileCopyrightText: 2026 Rachel Mant <git@dragonmux.network>
+#ifndef JOB_POOL_HXX
+#define JOB_POOL_HXX
+
+#include <cstddef>
+#include <cstdint>
+#include <atomic>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+
+// A queue of job indices owned by one worker, which other workers may steal from the back of
+struct jobQueue_t final
+{
+private:
+	std::mutex lock{};
+	std::deque<size_t> jobs{};
+
+public:
+	void push(size_t job);
+	[[nodiscard]] std::optional<size_t> pop() noexcept;
+	[[nodiscard]] std::optional<size_t> steal() noexcept;
+};
+
+/*
+ * Runs a fixed set of independent jobs across a number of worker threads. The jobs are dealt out
+ * round-robin to per-worker queues up front, and workers that run out steal from the others so
+ * that a few long jobs don't leave the rest of the workers idle at the end.
+ */
+struct jobPool_t final
+{
+public:
+	// Called with the index of the worker running the job and the index of the job to run
+	using job_t = std::function<void (size_t worker, size_t job)>;
+
+private:
+	size_t workerCount;
+	std::unique_ptr<jobQueue_t []> queues;
+	std::atomic<bool> cancelled{false};
+
+	[[nodiscard]] std::optional<size_t> nextJob(size_t worker) noexcept;
+	void runWorker(size_t worker, const job_t &job) noexcept;
+
+public:
+	jobPool_t(size_t workers, size_t jobs);
+	[[nodiscard]] size_t workers() const noexcept { return workerCount; }
+	void run(const job_t &job);
+	// Stops the workers picking up any more jobs - ones already running are left to finish.
+	// Safe to call from a job, another thread, or a signal handler.
+	void cancel() noexcept { cancelled = true; }
+	[[nodiscard]] bool wasCancelled() const noexcept { return cancelled; }
+};
+
+#endif /*JOB_POOL_HXX*/
@@ -1,20 +1,32 @@
 // SPDX-License-Identifier: BSD-3-Clause
 // SPDX-FileCopyrightText: 2019-2023 Rachel Mant <git@dragonmux.network>
 #include <cstdint>
+#include <cstdlib>
+#include <csignal>
 #include <map>
 #include <string>
 #include <array>
+#include <vector>
+#include <chrono>
+#include <mutex>
+#include <thread>
 #include <algorithm>
+#include <limits>
+#include <string_view>
 
 #include "libAudio.h"
 #include "libAudio.hxx"
 // XXX: This header actually needs installing and the current header mess figured out + fixed.
 #include "console.hxx"
+#include "transcodePipeline.hxx"
+#include "jobPool.hxx"
 
+using namespace std::literals::string_view_literals;
 using libAudio::console::operator ""_s;
 using libAudio::console::asTime_t;
-
-std::array<uint8_t, 8192> buffer;
+using libAudio::console::asInt_t;
+using libAudio::console::consoleStream_t;
+using libAudio::printable_t;
 
 struct audioClose_t final { void operator ()(void *ptr) noexcept { audioCloseFile(ptr); } };
 
@@ -44,13 +56,91 @@ audioType_t mapType(std::string typeName)
 	return entry->second;
 }
 
+// Prints a value given in hundredths as a fixed point decimal number
+struct asFixed_t final : public printable_t
+{
+private:
+	uint64_t value;
+
+public:
+	constexpr asFixed_t(const uint64_t _value) noexcept : value{_value} { }
+
+	void operator ()(const consoleStream_t &stream) const noexcept final
+	{
+		asInt_t<uint64_t>{value / 100U}(stream);
+		stream.write('.');
+		stream.write(char('0' + ((value / 10U) % 10U)));
+		stream.write(char('0' + (value % 10U)));
+	}
+};
+
+// How much audio a transcode got through, how long it took to do so, and whether it failed
+struct throughput_t final
+{
+	uint64_t bytes{0};
+	double audioSeconds{0.0};
+	std::chrono::duration<double> wallTime{};
+	bool failed{false};
+
+	throughput_t &operator +=(const throughput_t &other) noexcept
+	{
+		bytes += other.bytes;
+		audioSeconds += other.audioSeconds;
+		wallTime += other.wallTime;
+		return *this;
+	}
+
+	[[nodiscard]] asFixed_t realtimeFactor() const noexcept
+		{ return {wallTime.count() > 0.0 ? uint64_t(audioSeconds * 100.0 / wallTime.count()) : 0U}; }
+	[[nodiscard]] asFixed_t megabytesPerSecond() const noexcept
+		{ return {wallTime.count() > 0.0 ? uint64_t(double(bytes) / 10000.0 / wallTime.count()) : 0U}; }
+};
+
+// Serialises console output from the jobs so their lines don't get interleaved
+std::mutex consoleLock{};
+// The pool running the current batch, so an interrupt can stop it starting any more files
+jobPool_t *activePool{nullptr};
+
+extern "C" void interrupted(const int signal)
+{
+	// A second interrupt gets the default behaviour and kills the transcode outright
+	std::signal(signal, SIG_DFL);
+	if (activePool)
+		activePool->cancel();
+}
+
 int usage(const char *const program) noexcept
 {
 	console.info("Usage:"_s);
-	console.info(program, " <type> [fileIn fileOut] ... [fileIn fileOut]"_s);
+	console.info(program, " [options] <type> [fileIn fileOut] ... [fileIn fileOut]"_s);
+	console.info("Options:"_s);
+	console.info("\t--jobs N        Transcode up to N files at once (0 for one per CPU core), defaulting to 1"_s);
+	console.info("\t--quality Q     Encode VBR at quality Q, from 0 (smallest) to 1 (best)"_s);
+	console.info("\t--bitrate N     Encode at N bits per second"_s);
+	console.info("\t--level N       Use the encoder's compression level N (eg, FLAC's 0-8 or LAME's -q)"_s);
+	console.info("\t--complexity N  Use the encoder's complexity N (eg, Opus' 0-10)"_s);
+	console.info("\t--threads N     Allow the encoder to use up to N threads where it supports this"_s);
 	return -2;
 }
 
+// Parses an unsigned number for an option, checking it fits in the type it's destined for
+template<typename T> bool parseNumber(const char *const value, T &result) noexcept
+{
+	char *end{nullptr};
+	const auto number{std::strtoul(value, &end, 10)};
+	if (!end || *end || number > std::numeric_limits<T>::max())
+		return false;
+	result = static_cast<T>(number);
+	return true;
+}
+
+bool parseQuality(const char *const value, float &result) noexcept
+{
+	char *end{nullptr};
+	result = std::strtof(value, &end);
+	return end && !*end && result >= 0.F && result <= 1.F;
+}
+
 void printInfo(const char *const fileName, const fileInfo_t &info) noexcept
 {
 	console.info("Input file '", fileName, "', TotalTime: ", asTime_t{info.totalTime()},
@@ -58,49 +148,171 @@ void printInfo(const char *const fileName, const fileInfo_t &info) noexcept
 		", Album: ", info.album(), ", Channels: ", info.channels());
 }
 
-void printStatus(const uint32_t loops, const fileInfo_t &info) noexcept
+void printStatus(const uint64_t samples, const fileInfo_t &info) noexcept
+	{ console.info(samples / info.bitRate(), "s done\r"_s, nullptr); }
+
+void printThroughput(const throughput_t &throughput) noexcept
+{
+	console.output(" ("_s, asFixed_t{uint64_t(throughput.audioSeconds * 100.0)}, "s of audio in "_s,
+		asFixed_t{uint64_t(throughput.wallTime.count() * 100.0)}, "s, "_s, throughput.realtimeFactor(),
+		"x realtime, "_s, throughput.megabytesPerSecond(), "MB/s)"_s);
+}
+
+/*
+ * Transcodes a single file, decoding and encoding on separate threads through a transcodePipeline_t.
+ * Progress is only displayed when the transcode is the only one running as otherwise the lines
+ * from each of the jobs would just overwrite each other.
+ */
+throughput_t transcode(const char *const inputName, const char *const outputName, const uint8_t type,
+	const encoderOptions_t &options, const bool showProgress) noexcept
 {
-	const uint8_t bytesPerSample = info.channels() * (info.bitsPerSample() / 8U);
-	const uint64_t samples = (buffer.size() / bytesPerSample) * loops;
-	console.info(samples / info.bitRate(), "s done\r"_s, nullptr);
+	throughput_t throughput{};
+	const auto startTime{std::chrono::steady_clock::now()};
+	std::unique_ptr<void, audioClose_t> inFile{audioOpenR(inputName)};
+	std::unique_ptr<void, audioClose_t> outFile{audioOpenWOptions(outputName, type, &options)};
+
+	if (!inFile || !outFile)
+	{
+		throughput.failed = true;
+		std::lock_guard<std::mutex> guard{consoleLock};
+		if (!inFile)
+			console.error("Failed to open input file "_s, inputName);
+		if (!outFile)
+			console.error("Failed to open output file "_s, outputName);
+		return throughput;
+	}
+	const fileInfo_t *fileInfo{audioGetFileInfo(inFile.get())};
+	{
+		std::lock_guard<std::mutex> guard{consoleLock};
+		printInfo(inputName, *fileInfo);
+	}
+	if (!audioSetFileInfo(outFile.get(), fileInfo))
+	{
+		throughput.failed = true;
+		std::lock_guard<std::mutex> guard{consoleLock};
+		console.error("Failed to set file information for "_s, outputName);
+		return throughput;
+	}
+
+	const uint32_t bytesPerSample = fileInfo->channels() * fileInfo->bytesPerSample();
+	transcodePipeline_t pipeline{*static_cast<audioFile_t *>(inFile.get()), *static_cast<audioFile_t *>(outFile.get())};
+	const bool result{pipeline.run([&](const uint64_t bytes)
+	{
+		if (showProgress && bytesPerSample)
+			printStatus(bytes / bytesPerSample, *fileInfo);
+	})};
+	throughput.bytes = pipeline.bytes();
+	throughput.failed = !result;
+	// Make sure the output is fully flushed out before we stop the clock on this job
+	outFile.reset();
+	throughput.wallTime = std::chrono::steady_clock::now() - startTime;
+	if (bytesPerSample && fileInfo->bitRate())
+		throughput.audioSeconds = double(throughput.bytes / bytesPerSample) / fileInfo->bitRate();
+
+	std::lock_guard<std::mutex> guard{consoleLock};
+	if (throughput.failed)
+		console.error("Failed to transcode "_s, inputName, " to "_s, outputName);
+	else
+	{
+		console.info("Transcode to "_s, outputName, " complete"_s, nullptr);
+		printThroughput(throughput);
+	}
+	return throughput;
 }
 
 int main(int argc, char **argv)
 {
 	console = {stdout, stderr};
-	if (argc < 2)
-		return usage(argv[0]);
-	const auto type{static_cast<uint8_t>(mapType(argv[1]))};
-	argc -= argc % 2;
-	for (uint32_t i = 2; i < uint32_t(argc); i += 2)
+	const char *const program{argv[0]};
+	size_t jobs{1U};
+	encoderOptions_t options{};
+	// Consume the options, which all take a value, until we reach the output type
+	while (argc >= 3 && argv[1][0] == '-' && argv[1][1] == '-')
 	{
-		std::unique_ptr<void, audioClose_t> inFile{audioOpenR(argv[i])};
-		std::unique_ptr<void, audioClose_t> outFile{audioOpenW(argv[i + 1], type)};
-
-		if (!inFile || !outFile)
+		const std::string_view option{argv[1]};
+		const char *const value{argv[2]};
+		bool valid{false};
+		if (option == "--jobs"sv)
 		{
-			if (!inFile)
-				console.error("Failed to open input file "_s, argv[i]);
-			if (!outFile)
-				console.error("Failed to open output file "_s, argv[i + 1]);
-			continue;
+			valid = parseNumber(value, jobs);
+			if (!jobs)
+				jobs = std::max(std::thread::hardware_concurrency(), 1U);
 		}
-		const fileInfo_t *fileInfo{audioGetFileInfo(inFile.get())};
-		printInfo(argv[i], *fileInfo);
-		if (!audioSetFileInfo(outFile.get(), fileInfo))
+		else if (option == "--quality"sv)
 		{
-			console.error("Failed to set file information for "_s, argv[i + 1]);
-			continue;
+			valid = parseQuality(value, options.quality);
+			options.options |= AUDIO_OPTION_QUALITY;
 		}
-
-		uint32_t loops = 0;
-		for (int64_t result = 1; result > 0; ++loops)
+		else if (option == "--bitrate"sv)
+		{
+			valid = parseNumber(value, options.bitRate);
+			options.options |= AUDIO_OPTION_BITRATE;
+		}
+		else if (option == "--level"sv)
+		{
+			valid = parseNumber(value, options.compressionLevel);
+			options.options |= AUDIO_OPTION_COMPRESSION_LEVEL;
+		}
+		else if (option == "--complexity"sv)
 		{
-			result = audioFillBuffer(inFile.get(), buffer.data(), uint32_t(buffer.size()));
-			result = audioWriteBuffer(outFile.get(), buffer.data(), result);
-			printStatus(loops + 1, *fileInfo);
+			valid = parseNumber(value, options.complexity);
+			options.options |= AUDIO_OPTION_COMPLEXITY;
 		}
-		console.info("Transcode to "_s, argv[i + 1], " complete"_s);
+		else if (option == "--threads"sv)
+		{
+			valid = parseNumber(value, options.threads);
+			options.options |= AUDIO_OPTION_THREADS;
+		}
+		if (!valid)
+			return usage(program);
+		argc -= 2;
+		argv += 2;
+	}
+	if (argc < 2)
+		return usage(program);
+	const auto type{static_cast<uint8_t>(mapType(argv[1]))};
+	const size_t files{size_t(argc - 2) / 2U};
+
+	jobPool_t pool{jobs, files};
+	std::vector<throughput_t> results(files);
+	const bool showProgress{pool.workers() == 1U};
+
+	activePool = &pool;
+	std::signal(SIGINT, interrupted);
+	const auto startTime{std::chrono::steady_clock::now()};
+	pool.run([&](const size_t, const size_t job)
+	{
+		const auto arg{2U + (job * 2U)};
+		results[job] = transcode(argv[arg], argv[arg + 1U], type, options, showProgress);
+	});
+
+	std::signal(SIGINT, SIG_DFL);
+	activePool = nullptr;
+
+	throughput_t total{};
+	size_t failures{0U};
+	for (const auto &result : results)
+	{
+		total += result;
+		if (result.failed)
+			++failures;
+	}
+	// The aggregate is measured against the wall time of the whole batch, not the sum of the job times
+	total.wallTime = std::chrono::steady_clock::now() - startTime;
+	if (pool.wasCancelled())
+	{
+		console.error("Interrupted, not all files were transcoded"_s);
+		return 1;
+	}
+	if (files > 1U)
+	{
+		console.info("Transcoded "_s, files, " files using "_s, pool.workers(), " jobs"_s, nullptr);
+		printThroughput(total);
+	}
+	if (failures)
+	{
+		console.error(failures, " of "_s, files, " files failed to transcode"_s);
+		return 1;
 	}
 	return 0;
 }